@@ -0,0 +1,6 @@
+:: Math Test (build and run A3DM test once per instruction set)
+:: By Daniel S. Buckstein
+@echo off
+set ANIMAL3D_SDK=%~dp0
+call "%ANIMAL3D_SDK%\utility\win\dev\animal3d_win_test_math.bat"
+pause
@@ -48,6 +48,9 @@ extern "C"
 	//	a3buffer_index: store index data in an "index buffer object" (IBO), 
 	//		a.k.a. "element buffer object" (EBO)
 	//	a3buffer_uniform: store uniform data in a "uniform buffer object" (UBO)
+	//	a3buffer_pixelUnpack: stage texture data for upload in a "pixel 
+	//		buffer object" (PBO); while active, texture data pointers are 
+	//		treated as offsets into the buffer
 	//	NOTE: It is also possible for vertex and index data to coexist in the 
 	//		same buffer; use either a3buffer_vertex or a3buffer_index mode to 
 	//		achieve this; avoid using 'deactivate' function for shared buffer.
@@ -56,6 +59,7 @@ extern "C"
 		a3buffer_vertex,
 		a3buffer_index,
 		a3buffer_uniform,
+		a3buffer_pixelUnpack,
 	};
 
 
@@ -190,6 +194,25 @@ extern "C"
 	//	return: 0
 	a3ret a3bufferDeactivateType(const a3_BufferObjectType bufferType);
 
+	// A3: Map part of buffer into client memory for writing; the previous 
+	//	contents of the mapped range are discarded.
+	//	param buffer: non-null pointer to initialized buffer object
+	//	param offset: start of range to map in bytes
+	//	param size: non-zero size of range to map in bytes
+	//	param data_out: non-null pointer to receive address of mapped range; 
+	//		address may be written from any thread until buffer is unmapped
+	//	return: 1 if mapped
+	//	return: 0 if mapping failed
+	//	return: -1 if invalid params or buffer not initialized
+	a3ret a3bufferMap(const a3_BufferObject *buffer, const a3ui32 offset, const a3ui32 size, void **data_out);
+
+	// A3: Unmap buffer after writing so it can be used for rendering.
+	//	param buffer: non-null pointer to initialized, mapped buffer object
+	//	return: 1 if unmapped
+	//	return: 0 if data was lost while mapped (refill and try again)
+	//	return: -1 if invalid params or buffer not initialized
+	a3ret a3bufferUnmap(const a3_BufferObject *buffer);
+
 	// A3: Reference buffer object for use; call release when done with it.
 	//	param buffer: non-null pointer to initialized buffer object
 	//	return: reference count if success
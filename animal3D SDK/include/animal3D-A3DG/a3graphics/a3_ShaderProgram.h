@@ -166,6 +166,33 @@ extern "C"
 	//	return: -1 if invalid params or shader is already initialized
 	a3ret a3shaderCreateFromFileList(a3_Shader *shader_out, const a3byte name_opt[32], const a3_ShaderType type, const a3byte **filePathList, const a3ui32 count);
 
+	// A3: Enable driver-side parallel shader compilation, if supported 
+	//		(GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile).
+	//	param maxThreads: maximum number of compiler threads; pass 
+	//		0xFFFFFFFF to let the driver decide
+	//	return: 2 if enabled with GL_KHR_parallel_shader_compile
+	//	return: 1 if enabled with GL_ARB_parallel_shader_compile
+	//	return: 0 if not supported; asynchronous functions still work but 
+	//		finish the first time they are polled
+	a3ret a3shaderParallelCompileEnable(const a3ui32 maxThreads);
+
+	// A3: Create GLSL shader from multiple raw sources without waiting for 
+	//		the compile result; compile errors are reported when a program 
+	//		using the shader is polled (see a3shaderProgramLinkPoll).
+	//	params: same as a3shaderCreateFromSourceList
+	//	return: number of sources submitted if compile started
+	//	return: 0 if no valid strings
+	//	return: -1 if invalid params or shader is already initialized
+	a3ret a3shaderCreateFromSourceListAsync(a3_Shader *shader_out, const a3byte name_opt[32], const a3_ShaderType type, const a3byte **sourceList, const a3ui32 count);
+
+	// A3: Create GLSL shader from multiple text files without waiting for 
+	//		the compile result.
+	//	params: same as a3shaderCreateFromFileList
+	//	return: number of sources submitted if compile started
+	//	return: 0 if no valid strings
+	//	return: -1 if invalid params or shader is already initialized
+	a3ret a3shaderCreateFromFileListAsync(a3_Shader *shader_out, const a3byte name_opt[32], const a3_ShaderType type, const a3byte **filePathList, const a3ui32 count);
+
 	// A3: Reference shader.
 	//	param shader: non-null pointer to shader descriptor to be referenced
 	//	return: reference count if success
@@ -221,6 +248,22 @@ extern "C"
 	//	return: -1 if invalid param or internal handle is zero
 	a3ret a3shaderProgramLink(a3_ShaderProgram *program);
 
+	// A3: Start linking program without waiting for the result.
+	//	param program: non-null pointer to program descriptor
+	//	return: 1 if link started; poll until complete before use
+	//	return: 0 if already linked
+	//	return: -1 if invalid param or internal handle is zero
+	a3ret a3shaderProgramLinkAsync(a3_ShaderProgram *program);
+
+	// A3: Poll program started with a3shaderProgramLinkAsync; never blocks 
+	//		if parallel compilation is supported.
+	//	param program: non-null pointer to program descriptor
+	//	return: 1 if linked; program object cannot be changed
+	//	return: 0 if still compiling or linking
+	//	return: -1 if link failed (logs printed), invalid param or internal 
+	//		handle is zero
+	a3ret a3shaderProgramLinkPoll(a3_ShaderProgram *program);
+
 	// A3: Validate program; optional step after linking. This is used to 
 	//		identify hardware-specific problems that may occur with the 
 	//		attached shader objects.
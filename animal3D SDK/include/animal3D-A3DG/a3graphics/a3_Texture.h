@@ -108,6 +108,13 @@ extern "C"
 		a3tex_depth24,			// 24-bit depth
 		a3tex_depth32,			// 32-bit depth (a3i32)
 		a3tex_depth24_stencil8,	// 24-bit depth with 8-bit stencil
+
+		// block-compressed: each 4x4 block of pixels is stored in 8 or 16 
+		//	bytes; data must already be compressed (see mip data upload)
+		a3tex_bc1,				// rgb, 8 bytes per block (DXT1)
+		a3tex_bc3,				// rgba, 16 bytes per block (DXT5)
+		a3tex_bc4,				// red, 8 bytes per block (RGTC1)
+		a3tex_bc5,				// red-green, 16 bytes per block (RGTC2)
 	};
 
 	// A3: Texture unit for activating textures.
@@ -143,6 +150,8 @@ extern "C"
 	{
 		a3tex_filterNearest,	// magnified pixels clamp to nearest neighbor
 		a3tex_filterLinear,		// magnified pixels blend with neighbors
+		a3tex_filterLinearMipmap,	// same as linear, minified pixels blend 
+								//	between pre-generated mip levels
 	};
 
 	// A3: Texture setting options for repeating textures.
@@ -163,6 +172,19 @@ extern "C"
 	//	return: -1 if invalid params
 	a3ret a3textureCreatePixelFormatDescriptor(a3_TexturePixelFormatDescriptor *pixelFormat_out, const a3_TexturePixelType pixelType);
 
+	// A3: Get the size of one 4x4 block of a compressed pixel format.
+	//	param pixelFormat: non-null pointer to pixel descriptor
+	//	return: bytes per block if format is block-compressed
+	//	return: 0 if format is not compressed
+	//	return: -1 if invalid params
+	a3ret a3textureGetCompressedBlockSize(const a3_TexturePixelFormatDescriptor *pixelFormat);
+
+	// A3: Check whether the driver can sample block-compressed formats; 
+	//	must be called with a current rendering context.
+	//	return: 1 if all compressed pixel types are supported
+	//	return: 0 if not supported
+	a3ret a3textureCompressionSupported();
+
 	
 //-----------------------------------------------------------------------------
 
@@ -194,6 +216,42 @@ extern "C"
 	//	return: -1 if invalid params or already initialized
 	a3ret a3textureCreateFromData(a3_Texture *texture_out, const a3byte name_opt[32], const a3_TexturePixelFormatDescriptor *pixelFormat, const a3ui32 width, const a3ui32 height, const void *data_opt, a3boolean dataFlipped);
 
+	// A3: Create texture with a full chain of pre-generated mip levels.
+	//	param texture_out: non-null pointer to uninitialized texture
+	//	param name_opt: optional cstring for short name/description; max 31 
+	//		chars + null terminator; pass null for default name
+	//	param pixelFormat: non-null pointer to pixel format to use for texture
+	//	params width, height: positive dimensions of base level
+	//	param levelCount: positive number of levels; each level is half the 
+	//		size of the previous (at least 1 pixel), bottom row first
+	//	param levelData: non-null array of pointers to data for each level; 
+	//		if a pixel buffer is active, these are offsets into the buffer; 
+	//		for compressed formats each level is a row-major array of blocks
+	//	return: 1 if successful creation
+	//	return: 0 if creation failed
+	//	return: -1 if invalid params or already initialized
+	a3ret a3textureCreateFromMipData(a3_Texture *texture_out, const a3byte name_opt[32], const a3_TexturePixelFormatDescriptor *pixelFormat, const a3ui32 width, const a3ui32 height, const a3ui32 levelCount, const void *const *levelData);
+
+	// A3: Decode image file into memory without creating a texture; may be 
+	//	called from any thread (decoding is serialized internally), but the 
+	//	image library should be initialized on the main thread first.
+	//	param data_out: non-null pointer to receive decoded pixels, bottom 
+	//		row first; release with a3textureReleaseDecodedData
+	//	params width_out, height_out: non-null pointers to receive dimensions
+	//	param pixelType_out: non-null pointer to receive pixel type; one of 
+	//		rgb8, rgb16, rgba8 or rgba16, same as a3textureCreateFromFile
+	//	param filePath: non-null, valid cstring of file path to load from
+	//	return: 1 if successful decode
+	//	return: 0 if decode failed
+	//	return: -1 if invalid params
+	a3ret a3textureDecodeFile(void **data_out, a3ui32 *width_out, a3ui32 *height_out, a3_TexturePixelType *pixelType_out, const a3byte *filePath);
+
+	// A3: Release data decoded from image file.
+	//	param data: pointer to data from a3textureDecodeFile
+	//	return: 1 if released
+	//	return: -1 if invalid params
+	a3ret a3textureReleaseDecodedData(void *data);
+
 	// A3: Replace part of a texture with new data.
 	//	param texture: non-null pointer to initialized texture
 	//	params offsetWidth, offsetHeight: positive data start offset in image
@@ -123,6 +123,12 @@ extern "C"
 		a3attrib_dvec2,		// 2D double vector
 		a3attrib_dvec3,		// 3D double vector
 		a3attrib_dvec4,		// 4D double vector
+		a3attrib_hvec2,		// 2D half-float vector
+		a3attrib_hvec4,		// 4D half-float vector
+		a3attrib_unvec2,	// 2D 16-bit unsigned normalized vector, [0, 1] in shader
+		a3attrib_unvec4,	// 4D 16-bit unsigned normalized vector, [0, 1] in shader
+		a3attrib_snvec2,	// 2D 16-bit signed normalized vector, [-1, 1] in shader
+		a3attrib_snvec4,	// 4D 16-bit signed normalized vector, [-1, 1] in shader
 	};
 
 
@@ -29,6 +29,7 @@
 
 
 #include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
 #include "a3_VertexBuffer.h"
 
 
@@ -36,6 +37,7 @@
 extern "C"
 {
 #else	// !__cplusplus
+	typedef struct a3_VertexBounds			a3_VertexBounds;
 	typedef struct a3_VertexDrawable		a3_VertexDrawable;
 	typedef enum a3_VertexPrimitiveType		a3_VertexPrimitiveType;
 #endif	// __cplusplus
@@ -56,6 +58,16 @@ extern "C"
 	};
 
 
+	// A3: Bounding volumes of vertex positions, used to cull drawables.
+	//	members min, max: corners of axis-aligned bounding box
+	//	members center, radius: bounding sphere
+	struct a3_VertexBounds
+	{
+		a3f32 min[3], max[3];
+		a3f32 center[3], radius;
+	};
+
+
 	// A3: Descriptor for drawable object.
 	//	member first: the first vertex/index in the buffer section described 
 	//		by the VAO
@@ -66,6 +78,8 @@ extern "C"
 	//	member indexBuffer: pointer to index buffer (IBO) associated with 
 	//		this renderable object; optional
 	//	member vertexArray: VAO used to draw vertices; required
+	//	member bounds: object-space bounds of vertices drawn; zero unless 
+	//		set by the creator (e.g. from geometry data)
 	struct a3_VertexDrawable
 	{
 		a3ui32 first;
@@ -75,6 +89,7 @@ extern "C"
 		const void *indexing;
 		a3_IndexBuffer *indexBuffer;
 		a3_VertexArrayDescriptor *vertexArray;
+		a3_VertexBounds bounds[1];
 	};
 
 
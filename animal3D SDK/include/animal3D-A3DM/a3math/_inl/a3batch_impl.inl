@@ -0,0 +1,723 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3batch_impl.inl
+	Implementations for batch vector, matrix, quaternion and trig functions.
+*/
+
+#ifdef __ANIMAL3D_A3DM_BATCH_H
+#ifndef __ANIMAL3D_A3DM_BATCH_IMPL_INL
+#define __ANIMAL3D_A3DM_BATCH_IMPL_INL
+
+
+#include "../a3sqrt.h"
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+// SIMD paths either run one item per iteration with columns in registers or
+//	whole groups of four transposed, then any remainder (or everything in
+//	scalar builds) runs one at a time; all inputs of an iteration are loaded
+//	before any of its outputs are stored, so outputs may alias inputs
+
+A3_INLINE a3mat4 *a3real4x4ProductBatch(a3mat4 *m_out, const a3mat4 *mL, const a3mat4 *mR, const a3count count)
+{
+	a3real4x4 tmp;
+	a3count i = 0;
+#ifdef A3_SIMD_MAT4
+	// product kernel already holds one column per register
+	for (; i < count; ++i)
+		a3real4x4ProductSIMD(m_out[i].m, mL[i].m, mR[i].m, a3false);
+#endif	// A3_SIMD_MAT4
+	for (; i < count; ++i)
+	{
+		a3real4x4Product(tmp, mL[i].m, mR[i].m);
+		a3real4x4SetReal4x4(m_out[i].m, tmp);
+	}
+	return m_out;
+}
+
+A3_INLINE a3mat4 *a3real4x4ProductBatchSharedL(a3mat4 *m_out, const a3real4x4p mL, const a3mat4 *mR, const a3count count)
+{
+	a3real4x4 tmp;
+	a3count i = 0;
+#ifdef A3_SIMD_MAT4
+	// left columns loaded once for the whole batch
+	const a3simd4 l0 = a3simd4Load(mL[0]), l1 = a3simd4Load(mL[1]), l2 = a3simd4Load(mL[2]), l3 = a3simd4Load(mL[3]);
+#if (A3_SIMD == A3_SIMD_AVX2)
+	const a3simd8 L0 = a3simd8Splat4(l0), L1 = a3simd8Splat4(l1), L2 = a3simd8Splat4(l2), L3 = a3simd8Splat4(l3);
+	a3simd8 r01, r23, p01, p23;
+	for (; i < count; ++i)
+	{
+		r01 = a3simd8Load(mR[i].m[0]);
+		r23 = a3simd8Load(mR[i].m[2]);
+		p01 = a3simd8Mul(L0, a3simd8Lane(r01, 0));				p23 = a3simd8Mul(L0, a3simd8Lane(r23, 0));
+		p01 = a3simd8MulAdd(L1, a3simd8Lane(r01, 1), p01);		p23 = a3simd8MulAdd(L1, a3simd8Lane(r23, 1), p23);
+		p01 = a3simd8MulAdd(L2, a3simd8Lane(r01, 2), p01);		p23 = a3simd8MulAdd(L2, a3simd8Lane(r23, 2), p23);
+		p01 = a3simd8MulAdd(L3, a3simd8Lane(r01, 3), p01);		p23 = a3simd8MulAdd(L3, a3simd8Lane(r23, 3), p23);
+		a3simd8Store(m_out[i].m[0], p01);
+		a3simd8Store(m_out[i].m[2], p23);
+	}
+#else	// !A3_SIMD_AVX2
+	a3simd4 p0, p1, p2, p3;
+	const a3real *r;
+	for (; i < count; ++i)
+	{
+		r = mR[i].mm;
+		p0 = a3simd4Mul(l0, a3simd4Splat(r[0]));				p1 = a3simd4Mul(l0, a3simd4Splat(r[4]));
+		p2 = a3simd4Mul(l0, a3simd4Splat(r[8]));				p3 = a3simd4Mul(l0, a3simd4Splat(r[12]));
+		p0 = a3simd4MulAdd(l1, a3simd4Splat(r[1]), p0);		p1 = a3simd4MulAdd(l1, a3simd4Splat(r[5]), p1);
+		p2 = a3simd4MulAdd(l1, a3simd4Splat(r[9]), p2);		p3 = a3simd4MulAdd(l1, a3simd4Splat(r[13]), p3);
+		p0 = a3simd4MulAdd(l2, a3simd4Splat(r[2]), p0);		p1 = a3simd4MulAdd(l2, a3simd4Splat(r[6]), p1);
+		p2 = a3simd4MulAdd(l2, a3simd4Splat(r[10]), p2);		p3 = a3simd4MulAdd(l2, a3simd4Splat(r[14]), p3);
+		p0 = a3simd4MulAdd(l3, a3simd4Splat(r[3]), p0);		p1 = a3simd4MulAdd(l3, a3simd4Splat(r[7]), p1);
+		p2 = a3simd4MulAdd(l3, a3simd4Splat(r[11]), p2);		p3 = a3simd4MulAdd(l3, a3simd4Splat(r[15]), p3);
+		a3simd4Store(m_out[i].m[0], p0);
+		a3simd4Store(m_out[i].m[1], p1);
+		a3simd4Store(m_out[i].m[2], p2);
+		a3simd4Store(m_out[i].m[3], p3);
+	}
+#endif	// A3_SIMD_AVX2
+#endif	// A3_SIMD_MAT4
+	for (; i < count; ++i)
+	{
+		a3real4x4Product(tmp, mL, mR[i].m);
+		a3real4x4SetReal4x4(m_out[i].m, tmp);
+	}
+	return m_out;
+}
+
+A3_INLINE a3vec4 *a3real4Real4x4ProductBatch(a3vec4 *v_out, const a3real4x4p m, const a3vec4 *v, const a3count count)
+{
+	a3count i = 0;
+#ifdef A3_SIMD_MAT4
+	// matrix columns loaded once; vector elements scale them
+	const a3simd4 m0 = a3simd4Load(m[0]), m1 = a3simd4Load(m[1]), m2 = a3simd4Load(m[2]), m3 = a3simd4Load(m[3]);
+	a3simd4 r;
+	for (; i < count; ++i)
+	{
+		r = a3simd4Mul(m0, a3simd4Splat(v[i].x));
+		r = a3simd4MulAdd(m1, a3simd4Splat(v[i].y), r);
+		r = a3simd4MulAdd(m2, a3simd4Splat(v[i].z), r);
+		r = a3simd4MulAdd(m3, a3simd4Splat(v[i].w), r);
+		a3simd4Store(v_out[i].v, r);
+	}
+#endif	// A3_SIMD_MAT4
+	for (; i < count; ++i)
+		a3real4Real4x4ProductR(v_out[i].v, m, v[i].v);
+	return v_out;
+}
+
+A3_INLINE a3vec3 *a3real3Real4x4TransformPointBatch(a3vec3 *p_out, const a3real4x4p m, const a3vec3 *p, const a3count count)
+{
+	a3real x, y, z;
+	a3count i = 0;
+#ifdef A3_SIMD_MAT4
+	// four points as one register per component, each matrix element splat
+	const a3simd4 m00 = a3simd4Splat(m[0][0]), m01 = a3simd4Splat(m[0][1]), m02 = a3simd4Splat(m[0][2]);
+	const a3simd4 m10 = a3simd4Splat(m[1][0]), m11 = a3simd4Splat(m[1][1]), m12 = a3simd4Splat(m[1][2]);
+	const a3simd4 m20 = a3simd4Splat(m[2][0]), m21 = a3simd4Splat(m[2][1]), m22 = a3simd4Splat(m[2][2]);
+	const a3simd4 m30 = a3simd4Splat(m[3][0]), m31 = a3simd4Splat(m[3][1]), m32 = a3simd4Splat(m[3][2]);
+	a3simd4 px, py, pz, rx, ry, rz;
+	for (; i + 4 <= count; i += 4)
+	{
+		a3simd4Load3x4(p[i].v, px, py, pz);
+		rx = a3simd4MulAdd(m20, pz, a3simd4MulAdd(m10, py, a3simd4Mul(m00, px)));
+		ry = a3simd4MulAdd(m21, pz, a3simd4MulAdd(m11, py, a3simd4Mul(m01, px)));
+		rz = a3simd4MulAdd(m22, pz, a3simd4MulAdd(m12, py, a3simd4Mul(m02, px)));
+		rx = a3simd4Add(rx, m30);
+		ry = a3simd4Add(ry, m31);
+		rz = a3simd4Add(rz, m32);
+		a3simd4Store3x4(p_out[i].v, rx, ry, rz);
+	}
+#endif	// A3_SIMD_MAT4
+	for (; i < count; ++i)
+	{
+		x = m[0][0] * p[i].x + m[1][0] * p[i].y + m[2][0] * p[i].z + m[3][0];
+		y = m[0][1] * p[i].x + m[1][1] * p[i].y + m[2][1] * p[i].z + m[3][1];
+		z = m[0][2] * p[i].x + m[1][2] * p[i].y + m[2][2] * p[i].z + m[3][2];
+		p_out[i].x = x;
+		p_out[i].y = y;
+		p_out[i].z = z;
+	}
+	return p_out;
+}
+
+A3_INLINE a3mat4 *a3real4x4TransformInverseBatch(a3mat4 *m_out, const a3mat4 *m, const a3count count)
+{
+	a3real4x4 tmp;
+	a3count i = 0;
+#ifdef A3_SIMD_MAT4
+	// transpose columns of four matrices so each register holds one element
+	//	of all four, e.g. 'e01' is [1] of column 0; then follow the scalar
+	//	steps of 'a3real4x4TransformInverse' four at a time
+	const a3simd4 zero = a3simd4Splat(a3real_zero), one = a3simd4Splat(a3real_one);
+	a3simd4 e00, e01, e02, e03, e10, e11, e12, e13, e20, e21, e22, e23, e30, e31, e32, e33;
+	a3simd4 sx2, sy2, sz2;
+	for (; i + 4 <= count; i += 4)
+	{
+		e00 = a3simd4Load(m[i].m[0]); e01 = a3simd4Load(m[i + 1].m[0]); e02 = a3simd4Load(m[i + 2].m[0]); e03 = a3simd4Load(m[i + 3].m[0]);
+		e10 = a3simd4Load(m[i].m[1]); e11 = a3simd4Load(m[i + 1].m[1]); e12 = a3simd4Load(m[i + 2].m[1]); e13 = a3simd4Load(m[i + 3].m[1]);
+		e20 = a3simd4Load(m[i].m[2]); e21 = a3simd4Load(m[i + 1].m[2]); e22 = a3simd4Load(m[i + 2].m[2]); e23 = a3simd4Load(m[i + 3].m[2]);
+		e30 = a3simd4Load(m[i].m[3]); e31 = a3simd4Load(m[i + 1].m[3]); e32 = a3simd4Load(m[i + 2].m[3]); e33 = a3simd4Load(m[i + 3].m[3]);
+		a3simd4Transpose(e00, e01, e02, e03);
+		a3simd4Transpose(e10, e11, e12, e13);
+		a3simd4Transpose(e20, e21, e22, e23);
+		a3simd4Transpose(e30, e31, e32, e33);
+
+		// divide each axis by its squared length, then transpose
+		sx2 = a3simd4Div(one, a3simd4MulAdd(e02, e02, a3simd4MulAdd(e01, e01, a3simd4Mul(e00, e00))));
+		sy2 = a3simd4Div(one, a3simd4MulAdd(e12, e12, a3simd4MulAdd(e11, e11, a3simd4Mul(e10, e10))));
+		sz2 = a3simd4Div(one, a3simd4MulAdd(e22, e22, a3simd4MulAdd(e21, e21, a3simd4Mul(e20, e20))));
+		e00 = a3simd4Mul(e00, sx2);	e01 = a3simd4Mul(e01, sx2);	e02 = a3simd4Mul(e02, sx2);
+		e10 = a3simd4Mul(e10, sy2);	e11 = a3simd4Mul(e11, sy2);	e12 = a3simd4Mul(e12, sy2);
+		e20 = a3simd4Mul(e20, sz2);	e21 = a3simd4Mul(e21, sz2);	e22 = a3simd4Mul(e22, sz2);
+
+		// negated translation multiplied by result; columns of the result
+		//	are now (e00, e10, e20), (e01, e11, e21), (e02, e12, e22)
+		sx2 = a3simd4Sub(zero, a3simd4MulAdd(e02, e32, a3simd4MulAdd(e01, e31, a3simd4Mul(e00, e30))));
+		sy2 = a3simd4Sub(zero, a3simd4MulAdd(e12, e32, a3simd4MulAdd(e11, e31, a3simd4Mul(e10, e30))));
+		sz2 = a3simd4Sub(zero, a3simd4MulAdd(e22, e32, a3simd4MulAdd(e21, e31, a3simd4Mul(e20, e30))));
+
+		// transpose back, one output column at a time
+		e03 = e13 = e23 = zero;
+		e30 = sx2;	e31 = sy2;	e32 = sz2;	e33 = one;
+		a3simd4Transpose(e00, e10, e20, e03);
+		a3simd4Transpose(e01, e11, e21, e13);
+		a3simd4Transpose(e02, e12, e22, e23);
+		a3simd4Transpose(e30, e31, e32, e33);
+		a3simd4Store(m_out[i].m[0], e00); a3simd4Store(m_out[i + 1].m[0], e10); a3simd4Store(m_out[i + 2].m[0], e20); a3simd4Store(m_out[i + 3].m[0], e03);
+		a3simd4Store(m_out[i].m[1], e01); a3simd4Store(m_out[i + 1].m[1], e11); a3simd4Store(m_out[i + 2].m[1], e21); a3simd4Store(m_out[i + 3].m[1], e13);
+		a3simd4Store(m_out[i].m[2], e02); a3simd4Store(m_out[i + 1].m[2], e12); a3simd4Store(m_out[i + 2].m[2], e22); a3simd4Store(m_out[i + 3].m[2], e23);
+		a3simd4Store(m_out[i].m[3], e30); a3simd4Store(m_out[i + 1].m[3], e31); a3simd4Store(m_out[i + 2].m[3], e32); a3simd4Store(m_out[i + 3].m[3], e33);
+	}
+#endif	// A3_SIMD_MAT4
+	for (; i < count; ++i)
+	{
+		a3real4x4TransformInverse(tmp, m[i].m);
+		a3real4x4SetReal4x4(m_out[i].m, tmp);
+	}
+	return m_out;
+}
+
+A3_INLINE a3vec3 *a3real3GetUnitBatch(a3vec3 *v_out, const a3vec3 *v, const a3count count)
+{
+	a3real lenInv;
+	a3count i = 0;
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	const a3simd4 one = a3simd4Splat(a3real_one);
+	a3simd4 x, y, z, lenSq;
+	for (; i + 4 <= count; i += 4)
+	{
+		a3simd4Load3x4(v[i].v, x, y, z);
+		lenSq = a3simd4MulAdd(z, z, a3simd4MulAdd(y, y, a3simd4Mul(x, x)));
+		lenSq = a3simd4MaskPositive(a3simd4Div(one, a3simd4Sqrt(lenSq)), lenSq);
+		x = a3simd4Mul(x, lenSq);
+		y = a3simd4Mul(y, lenSq);
+		z = a3simd4Mul(z, lenSq);
+		a3simd4Store3x4(v_out[i].v, x, y, z);
+	}
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+	for (; i < count; ++i)
+	{
+		lenInv = a3real3LengthSquared(v[i].v);
+		lenInv = a3sqrtSafeInverse(lenInv);
+		a3real3ProductS(v_out[i].v, v[i].v, lenInv);
+	}
+	return v_out;
+}
+
+A3_INLINE a3vec4 *a3real4GetUnitBatch(a3vec4 *v_out, const a3vec4 *v, const a3count count)
+{
+	a3real lenInv;
+	a3count i = 0;
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	const a3simd4 one = a3simd4Splat(a3real_one);
+	a3simd4 x, y, z, w, lenSq;
+	for (; i + 4 <= count; i += 4)
+	{
+		x = a3simd4Load(v[i].v);
+		y = a3simd4Load(v[i + 1].v);
+		z = a3simd4Load(v[i + 2].v);
+		w = a3simd4Load(v[i + 3].v);
+		a3simd4Transpose(x, y, z, w);
+		lenSq = a3simd4MulAdd(w, w, a3simd4MulAdd(z, z, a3simd4MulAdd(y, y, a3simd4Mul(x, x))));
+		lenSq = a3simd4MaskPositive(a3simd4Div(one, a3simd4Sqrt(lenSq)), lenSq);
+		x = a3simd4Mul(x, lenSq);
+		y = a3simd4Mul(y, lenSq);
+		z = a3simd4Mul(z, lenSq);
+		w = a3simd4Mul(w, lenSq);
+		a3simd4Transpose(x, y, z, w);
+		a3simd4Store(v_out[i].v, x);
+		a3simd4Store(v_out[i + 1].v, y);
+		a3simd4Store(v_out[i + 2].v, z);
+		a3simd4Store(v_out[i + 3].v, w);
+	}
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+	for (; i < count; ++i)
+	{
+		lenInv = a3real4LengthSquared(v[i].v);
+		lenInv = a3sqrtSafeInverse(lenInv);
+		a3real4ProductS(v_out[i].v, v[i].v, lenInv);
+	}
+	return v_out;
+}
+
+A3_INLINE a3vec3 *a3real3NormalizeBatch(a3vec3 *v_inout, const a3count count)
+{
+	a3real lenInv;
+	a3count i = 0;
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	a3simd4 x, y, z, lenSq;
+	for (; i + 4 <= count; i += 4)
+	{
+		a3simd4Load3x4(v_inout[i].v, x, y, z);
+		lenSq = a3simd4MulAdd(z, z, a3simd4MulAdd(y, y, a3simd4Mul(x, x)));
+		lenSq = a3sqrtfInverseFast4(lenSq);
+		x = a3simd4Mul(x, lenSq);
+		y = a3simd4Mul(y, lenSq);
+		z = a3simd4Mul(z, lenSq);
+		a3simd4Store3x4(v_inout[i].v, x, y, z);
+	}
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+	for (; i < count; ++i)
+	{
+		lenInv = (a3real)a3sqrtfInverseFast((a3f32)a3real3LengthSquared(v_inout[i].v));
+		a3real3MulS(v_inout[i].v, lenInv);
+	}
+	return v_inout;
+}
+
+A3_INLINE a3vec4 *a3real4NormalizeBatch(a3vec4 *v_inout, const a3count count)
+{
+	a3real lenInv;
+	a3count i = 0;
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	a3simd4 x, y, z, w, lenSq;
+	for (; i + 4 <= count; i += 4)
+	{
+		x = a3simd4Load(v_inout[i].v);
+		y = a3simd4Load(v_inout[i + 1].v);
+		z = a3simd4Load(v_inout[i + 2].v);
+		w = a3simd4Load(v_inout[i + 3].v);
+		a3simd4Transpose(x, y, z, w);
+		lenSq = a3simd4MulAdd(w, w, a3simd4MulAdd(z, z, a3simd4MulAdd(y, y, a3simd4Mul(x, x))));
+		lenSq = a3sqrtfInverseFast4(lenSq);
+		x = a3simd4Mul(x, lenSq);
+		y = a3simd4Mul(y, lenSq);
+		z = a3simd4Mul(z, lenSq);
+		w = a3simd4Mul(w, lenSq);
+		a3simd4Transpose(x, y, z, w);
+		a3simd4Store(v_inout[i].v, x);
+		a3simd4Store(v_inout[i + 1].v, y);
+		a3simd4Store(v_inout[i + 2].v, z);
+		a3simd4Store(v_inout[i + 3].v, w);
+	}
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+	for (; i < count; ++i)
+	{
+		lenInv = (a3real)a3sqrtfInverseFast((a3f32)a3real4LengthSquared(v_inout[i].v));
+		a3real4MulS(v_inout[i].v, lenInv);
+	}
+	return v_inout;
+}
+
+
+// quaternion to matrix with the same expansion as 'a3quatConvertToMat4'; 
+//	SIMD transposes four quaternions so each register holds one component 
+//	of all four, and transposes the results back one column at a time
+A3_INLINE a3mat4 *a3quatConvertToMat4TRSBatch(a3mat4 *m_out, const a3quat *q, const a3vec3 *translate, const a3vec3 *scale, const a3count count)
+{
+	a3count i = 0;
+#ifdef A3_SIMD_MAT4
+	const a3simd4 zero = a3simd4Splat(a3real_zero), one = a3simd4Splat(a3real_one);
+	a3simd4 x, y, z, w, x2, y2, z2, xx, yy, zz, ww, sx, sy, sz;
+	a3simd4 e00, e01, e02, e03, e10, e11, e12, e13, e20, e21, e22, e23, e30, e31, e32, e33;
+	for (; i + 4 <= count; i += 4)
+	{
+		x = a3simd4Load(q[i].q);
+		y = a3simd4Load(q[i + 1].q);
+		z = a3simd4Load(q[i + 2].q);
+		w = a3simd4Load(q[i + 3].q);
+		a3simd4Transpose(x, y, z, w);
+		x2 = a3simd4Add(x, x);
+		y2 = a3simd4Add(y, y);
+		z2 = a3simd4Add(z, z);
+		xx = a3simd4Mul(x, x);
+		yy = a3simd4Mul(y, y);
+		zz = a3simd4Mul(z, z);
+		ww = a3simd4Mul(w, w);
+
+		// 'eCR' is row R of column C
+		e00 = a3simd4Sub(a3simd4Add(ww, xx), a3simd4Add(yy, zz));
+		e11 = a3simd4Sub(a3simd4Add(ww, yy), a3simd4Add(xx, zz));
+		e22 = a3simd4Sub(a3simd4Add(ww, zz), a3simd4Add(xx, yy));
+		e01 = a3simd4MulAdd(w, z2, a3simd4Mul(x2, y));
+		e10 = a3simd4Sub(a3simd4Mul(x2, y), a3simd4Mul(w, z2));
+		e02 = a3simd4Sub(a3simd4Mul(x2, z), a3simd4Mul(w, y2));
+		e20 = a3simd4MulAdd(w, y2, a3simd4Mul(x2, z));
+		e12 = a3simd4MulAdd(w, x2, a3simd4Mul(y2, z));
+		e21 = a3simd4Sub(a3simd4Mul(y2, z), a3simd4Mul(w, x2));
+		if (scale)
+		{
+			a3simd4Load3x4(scale[i].v, sx, sy, sz);
+			e00 = a3simd4Mul(e00, sx);	e01 = a3simd4Mul(e01, sx);	e02 = a3simd4Mul(e02, sx);
+			e10 = a3simd4Mul(e10, sy);	e11 = a3simd4Mul(e11, sy);	e12 = a3simd4Mul(e12, sy);
+			e20 = a3simd4Mul(e20, sz);	e21 = a3simd4Mul(e21, sz);	e22 = a3simd4Mul(e22, sz);
+		}
+		a3simd4Load3x4(translate[i].v, e30, e31, e32);
+		e03 = e13 = e23 = zero;
+		e33 = one;
+		a3simd4Transpose(e00, e01, e02, e03);
+		a3simd4Transpose(e10, e11, e12, e13);
+		a3simd4Transpose(e20, e21, e22, e23);
+		a3simd4Transpose(e30, e31, e32, e33);
+		a3simd4Store(m_out[i].m[0], e00); a3simd4Store(m_out[i + 1].m[0], e01); a3simd4Store(m_out[i + 2].m[0], e02); a3simd4Store(m_out[i + 3].m[0], e03);
+		a3simd4Store(m_out[i].m[1], e10); a3simd4Store(m_out[i + 1].m[1], e11); a3simd4Store(m_out[i + 2].m[1], e12); a3simd4Store(m_out[i + 3].m[1], e13);
+		a3simd4Store(m_out[i].m[2], e20); a3simd4Store(m_out[i + 1].m[2], e21); a3simd4Store(m_out[i + 2].m[2], e22); a3simd4Store(m_out[i + 3].m[2], e23);
+		a3simd4Store(m_out[i].m[3], e30); a3simd4Store(m_out[i + 1].m[3], e31); a3simd4Store(m_out[i + 2].m[3], e32); a3simd4Store(m_out[i + 3].m[3], e33);
+	}
+#endif	// A3_SIMD_MAT4
+	for (; i < count; ++i)
+	{
+		a3quatConvertToMat4Translate(m_out[i].m, q[i].q, translate[i].v);
+		if (scale)
+		{
+			a3real3MulS(m_out[i].m[0], scale[i].x);
+			a3real3MulS(m_out[i].m[1], scale[i].y);
+			a3real3MulS(m_out[i].m[2], scale[i].z);
+		}
+	}
+	return m_out;
+}
+
+
+// trig batches evaluate the same polynomials as the scalar versions, with 
+//	branches replaced by selects; coefficients of the current tier are 
+//	splat once per call
+#if (A3_SIMD != A3_SIMD_SCALAR)
+A3_INLINE a3simd4 a3batchInternalHorner(const a3simd4 z, const a3simd4 *c, a3index n)
+{
+	a3simd4 p = *(c++);
+	while (--n)
+		p = a3simd4MulAdd(p, z, *(c++));
+	return p;
+}
+
+A3_INLINE a3index a3batchInternalSplat(a3simd4 *c_out, const a3real *c, const a3index width, const a3index n)
+{
+	a3index i;
+	for (i = 0, c += width - n; i < n; ++i)
+		c_out[i] = a3simd4Splat(c[i]);
+	return n;
+}
+
+// asin(s) on [0, 1/2] after the reduction used by 'a3asinrPoly'
+A3_INLINE a3simd4 a3batchInternalAsinHalf(const a3simd4 a, const a3simd4 big, const a3simd4 *c, const a3index n)
+{
+	const a3simd4 one = a3simd4Splat(a3real_one), half = a3simd4Splat(a3real_half);
+	const a3simd4 zBig = a3simd4Mul(a3simd4Sub(one, a), half);
+	const a3simd4 z = a3simd4Select(big, zBig, a3simd4Mul(a, a));
+	const a3simd4 s = a3simd4Select(big, a3simd4Sqrt(zBig), a);
+	return a3simd4MulAdd(a3simd4Mul(s, z), a3batchInternalHorner(z, c, n), s);
+}
+// sin(x) on [0, pi/2]: the sine polynomial up to pi/4, then the cosine 
+//	polynomial of the complement
+A3_INLINE a3simd4 a3batchInternalSinQuarter(const a3simd4 x, const a3simd4 *cs, const a3index ns, const a3simd4 *cc, const a3index nc)
+{
+	const a3simd4 one = a3simd4Splat(a3real_one);
+	const a3simd4 halfPi = a3simd4Splat(a3real_halfpi), quarterPi = a3simd4Splat(a3real_halfpi * a3real_half);
+	const a3simd4 big = a3simd4Greater(x, quarterPi);
+	const a3simd4 r = a3simd4Select(big, a3simd4Sub(halfPi, x), x);
+	const a3simd4 z = a3simd4Mul(r, r);
+	const a3simd4 s = a3simd4MulAdd(a3simd4Mul(r, z), a3batchInternalHorner(z, cs, ns), r);
+	const a3simd4 c = a3simd4MulAdd(z, a3batchInternalHorner(z, cc, nc), one);
+	return a3simd4Select(big, c, s);
+}
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+
+A3_INLINE a3real *a3realSinCosBatch(a3real *sin_out, a3real *cos_out, const a3real *x, const a3count count)
+{
+	a3count i = 0;
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	const a3index tier = a3_trigPolyTier;
+	const a3simd4 one = a3simd4Splat(a3real_one), signBit = a3simd4Splat(-a3real_zero);
+	const a3simd4 twoOverPi = a3simd4Splat(a3_trigPolyTwoOverPi);
+	const a3simd4 halfPiHi = a3simd4Splat(-a3_trigPolyHalfPiHi);
+	const a3simd4 halfPiMid = a3simd4Splat(-a3_trigPolyHalfPiMid);
+	const a3simd4 halfPiLo = a3simd4Splat(-a3_trigPolyHalfPiLo);
+	a3simd4 cs[3], cc[4], v, q, r, z, s, c, swap;
+	const a3index ns = a3batchInternalSplat(cs, a3_trigPolySin[tier], 3, a3_trigPolyTerms[tier][0]);
+	const a3index nc = a3batchInternalSplat(cc, a3_trigPolyCos[tier], 4, a3_trigPolyTerms[tier][1]);
+	for (; i + 4 <= count; i += 4)
+	{
+		// x = q*(pi/2) + r
+		v = a3simd4Load(x + i);
+		q = a3simd4Round(a3simd4Mul(v, twoOverPi));
+		r = a3simd4MulAdd(q, halfPiHi, v);
+		r = a3simd4MulAdd(q, halfPiMid, r);
+		r = a3simd4MulAdd(q, halfPiLo, r);
+		z = a3simd4Mul(r, r);
+		s = a3simd4MulAdd(a3simd4Mul(r, z), a3batchInternalHorner(z, cs, ns), r);
+		c = a3simd4MulAdd(z, a3batchInternalHorner(z, cc, nc), one);
+
+		// quadrant bits select and negate, as in the scalar version
+		swap = a3simd4BitMask(q, 1);
+		v = a3simd4Select(swap, c, s);
+		c = a3simd4Select(swap, s, c);
+		s = a3simd4Xor(v, a3simd4And(a3simd4BitMask(q, 2), signBit));
+		c = a3simd4Xor(c, a3simd4And(a3simd4BitMask(a3simd4Add(q, one), 2), signBit));
+		a3simd4Store(sin_out + i, s);
+		a3simd4Store(cos_out + i, c);
+	}
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+	for (; i < count; ++i)
+		a3trigPoly_sinr_cosr(x[i], sin_out + i, cos_out + i);
+	return sin_out;
+}
+
+A3_INLINE a3real *a3realAsinBatch(a3real *a_out, const a3real *x, const a3count count)
+{
+	a3count i = 0;
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	const a3index tier = a3_trigPolyTier;
+	const a3simd4 one = a3simd4Splat(a3real_one), half = a3simd4Splat(a3real_half);
+	const a3simd4 halfPi = a3simd4Splat(a3real_halfpi), signBit = a3simd4Splat(-a3real_zero);
+	a3simd4 ca[5], v, a, big, p;
+	const a3index na = a3batchInternalSplat(ca, a3_trigPolyAsin[tier], 5, a3_trigPolyTerms[tier][3]);
+	for (; i + 4 <= count; i += 4)
+	{
+		v = a3simd4Load(x + i);
+		a = a3simd4Min(a3simd4Abs(v), one);
+		big = a3simd4Greater(a, half);
+		p = a3batchInternalAsinHalf(a, big, ca, na);
+		p = a3simd4Select(big, a3simd4Sub(halfPi, a3simd4Add(p, p)), p);
+		a3simd4Store(a_out + i, a3simd4Xor(p, a3simd4And(v, signBit)));
+	}
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+	for (; i < count; ++i)
+		a_out[i] = a3asinrPoly(x[i]);
+	return a_out;
+}
+
+A3_INLINE a3real *a3realAcosBatch(a3real *a_out, const a3real *x, const a3count count)
+{
+	a3count i = 0;
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	const a3index tier = a3_trigPolyTier;
+	const a3simd4 one = a3simd4Splat(a3real_one), half = a3simd4Splat(a3real_half), zero = a3simd4Splat(a3real_zero);
+	const a3simd4 pi = a3simd4Splat(a3real_pi), halfPi = a3simd4Splat(a3real_halfpi), signBit = a3simd4Splat(-a3real_zero);
+	a3simd4 ca[5], v, a, big, p, p2;
+	const a3index na = a3batchInternalSplat(ca, a3_trigPolyAsin[tier], 5, a3_trigPolyTerms[tier][3]);
+	for (; i + 4 <= count; i += 4)
+	{
+		v = a3simd4Load(x + i);
+		a = a3simd4Min(a3simd4Abs(v), one);
+		big = a3simd4Greater(a, half);
+		p = a3batchInternalAsinHalf(a, big, ca, na);
+		p2 = a3simd4Add(p, p);
+		p2 = a3simd4Select(a3simd4Less(v, zero), a3simd4Sub(pi, p2), p2);
+		p = a3simd4Sub(halfPi, a3simd4Xor(p, a3simd4And(v, signBit)));
+		a3simd4Store(a_out + i, a3simd4Select(big, p2, p));
+	}
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+	for (; i < count; ++i)
+		a_out[i] = a3acosrPoly(x[i]);
+	return a_out;
+}
+
+A3_INLINE a3real *a3realAtan2Batch(a3real *a_out, const a3real *y, const a3real *x, const a3count count)
+{
+	a3count i = 0;
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	const a3index tier = a3_trigPolyTier;
+	const a3simd4 zero = a3simd4Splat(a3real_zero), signBit = a3simd4Splat(-a3real_zero);
+	const a3simd4 pi = a3simd4Splat(a3real_pi), halfPi = a3simd4Splat(a3real_halfpi);
+	a3simd4 ct[8], vy, vx, ay, ax, mx, t, r;
+	const a3index nt = a3batchInternalSplat(ct, a3_trigPolyAtan[tier], 8, a3_trigPolyTerms[tier][2]);
+	for (; i + 4 <= count; i += 4)
+	{
+		vy = a3simd4Load(y + i);
+		vx = a3simd4Load(x + i);
+		ay = a3simd4Abs(vy);
+		ax = a3simd4Abs(vx);
+
+		// smaller over larger, zero where both are zero
+		mx = a3simd4Max(ax, ay);
+		t = a3simd4MaskPositive(a3simd4Div(a3simd4Min(ax, ay), mx), mx);
+		r = a3simd4Mul(t, a3batchInternalHorner(a3simd4Mul(t, t), ct, nt));
+		r = a3simd4Select(a3simd4Greater(ay, ax), a3simd4Sub(halfPi, r), r);
+		r = a3simd4Select(a3simd4Less(vx, zero), a3simd4Sub(pi, r), r);
+		a3simd4Store(a_out + i, a3simd4Xor(r, a3simd4And(vy, signBit)));
+	}
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+	for (; i < count; ++i)
+		a_out[i] = a3atan2rPoly(y[i], x[i]);
+	return a_out;
+}
+
+
+// quaternion interpolation: inputs on opposite hemispheres are flipped to 
+//	take the shorter arc, then weights are blended and the results 
+//	normalized; SIMD transposes four quaternions per iteration
+A3_INLINE a3quat *a3quatSlerpBatch(a3quat *q_out, const a3quat *q0, const a3quat *q1, const a3real *param, const a3count count)
+{
+	// slerp weights lose precision as sin(angle) approaches zero
+	const a3real nearOne = (a3real)0.9995;
+	a3real d, t, a, s, sa, s0, s1, unused;
+	a3real4 r;
+	a3count i = 0;
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	const a3index tier = a3_trigPolyTier;
+	const a3simd4 one = a3simd4Splat(a3real_one), half = a3simd4Splat(a3real_half), near1 = a3simd4Splat(nearOne);
+	const a3simd4 halfPi = a3simd4Splat(a3real_halfpi), signBit = a3simd4Splat(-a3real_zero);
+	a3simd4 cs[3], cc[4], ca[5], x0, y0, z0, w0, x1, y1, z1, w1, t4, d4, flip, big, p, sinA, k0, k1;
+	const a3index ns = a3batchInternalSplat(cs, a3_trigPolySin[tier], 3, a3_trigPolyTerms[tier][0]);
+	const a3index nc = a3batchInternalSplat(cc, a3_trigPolyCos[tier], 4, a3_trigPolyTerms[tier][1]);
+	const a3index na = a3batchInternalSplat(ca, a3_trigPolyAsin[tier], 5, a3_trigPolyTerms[tier][3]);
+	for (; i + 4 <= count; i += 4)
+	{
+		x0 = a3simd4Load(q0[i].q); y0 = a3simd4Load(q0[i + 1].q); z0 = a3simd4Load(q0[i + 2].q); w0 = a3simd4Load(q0[i + 3].q);
+		x1 = a3simd4Load(q1[i].q); y1 = a3simd4Load(q1[i + 1].q); z1 = a3simd4Load(q1[i + 2].q); w1 = a3simd4Load(q1[i + 3].q);
+		a3simd4Transpose(x0, y0, z0, w0);
+		a3simd4Transpose(x1, y1, z1, w1);
+		t4 = a3simd4Load(param + i);
+
+		// shorter arc: flip q1 where the dot product is negative
+		d4 = a3simd4MulAdd(w0, w1, a3simd4MulAdd(z0, z1, a3simd4MulAdd(y0, y1, a3simd4Mul(x0, x1))));
+		flip = a3simd4And(d4, signBit);
+		d4 = a3simd4Min(a3simd4Abs(d4), one);
+
+		// angle = acos(d) for d in [0, 1], all sines taken on [0, pi/2]
+		big = a3simd4Greater(d4, half);
+		p = a3batchInternalAsinHalf(d4, big, ca, na);
+		p = a3simd4Select(big, a3simd4Add(p, p), a3simd4Sub(halfPi, p));
+		k1 = a3simd4Mul(t4, p);
+		k0 = a3simd4Sub(p, k1);
+		sinA = a3batchInternalSinQuarter(p, cs, ns, cc, nc);
+		k0 = a3simd4Div(a3batchInternalSinQuarter(k0, cs, ns, cc, nc), sinA);
+		k1 = a3simd4Div(a3batchInternalSinQuarter(k1, cs, ns, cc, nc), sinA);
+
+		// nearly parallel: lerp weights
+		big = a3simd4Greater(d4, near1);
+		k0 = a3simd4Select(big, a3simd4Sub(one, t4), k0);
+		k1 = a3simd4Xor(a3simd4Select(big, t4, k1), flip);
+		x0 = a3simd4MulAdd(x1, k1, a3simd4Mul(x0, k0));
+		y0 = a3simd4MulAdd(y1, k1, a3simd4Mul(y0, k0));
+		z0 = a3simd4MulAdd(z1, k1, a3simd4Mul(z0, k0));
+		w0 = a3simd4MulAdd(w1, k1, a3simd4Mul(w0, k0));
+		p = a3simd4MulAdd(w0, w0, a3simd4MulAdd(z0, z0, a3simd4MulAdd(y0, y0, a3simd4Mul(x0, x0))));
+		p = a3simd4MaskPositive(a3simd4Div(one, a3simd4Sqrt(p)), p);
+		x0 = a3simd4Mul(x0, p);
+		y0 = a3simd4Mul(y0, p);
+		z0 = a3simd4Mul(z0, p);
+		w0 = a3simd4Mul(w0, p);
+		a3simd4Transpose(x0, y0, z0, w0);
+		a3simd4Store(q_out[i].q, x0);
+		a3simd4Store(q_out[i + 1].q, y0);
+		a3simd4Store(q_out[i + 2].q, z0);
+		a3simd4Store(q_out[i + 3].q, w0);
+	}
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+	for (; i < count; ++i)
+	{
+		d = a3real4Dot(q0[i].q, q1[i].q);
+		s = d < a3real_zero ? -a3real_one : a3real_one;
+		d = a3minimum(d * s, a3real_one);
+		t = param[i];
+		if (d > nearOne)
+		{
+			s0 = a3real_one - t;
+			s1 = t;
+		}
+		else
+		{
+			a = a3acosrPoly(d);
+			a3trigPoly_sinr_cosr(a, &sa, &unused);
+			a3trigPoly_sinr_cosr(a - t * a, &s0, &unused);
+			a3trigPoly_sinr_cosr(t * a, &s1, &unused);
+			s0 /= sa;
+			s1 /= sa;
+		}
+		a3real4ProductS(r, q0[i].q, s0);
+		a3real4Add(r, a3real4ProductS(q_out[i].q, q1[i].q, s1 * s));
+		a3real4ProductS(q_out[i].q, r, a3sqrtSafeInverse(a3real4LengthSquared(r)));
+	}
+	return q_out;
+}
+
+A3_INLINE a3quat *a3quatNlerpBatch(a3quat *q_out, const a3quat *q0, const a3quat *q1, const a3real *param, const a3count count)
+{
+	a3real t, s;
+	a3real4 r;
+	a3count i = 0;
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	const a3simd4 one = a3simd4Splat(a3real_one), signBit = a3simd4Splat(-a3real_zero);
+	a3simd4 x0, y0, z0, w0, x1, y1, z1, w1, t4, sign, lenSq;
+	for (; i + 4 <= count; i += 4)
+	{
+		x0 = a3simd4Load(q0[i].q); y0 = a3simd4Load(q0[i + 1].q); z0 = a3simd4Load(q0[i + 2].q); w0 = a3simd4Load(q0[i + 3].q);
+		x1 = a3simd4Load(q1[i].q); y1 = a3simd4Load(q1[i + 1].q); z1 = a3simd4Load(q1[i + 2].q); w1 = a3simd4Load(q1[i + 3].q);
+		a3simd4Transpose(x0, y0, z0, w0);
+		a3simd4Transpose(x1, y1, z1, w1);
+		t4 = a3simd4Load(param + i);
+
+		// q0 + (+/-q1 - q0) * t
+		sign = a3simd4And(a3simd4MulAdd(w0, w1, a3simd4MulAdd(z0, z1, a3simd4MulAdd(y0, y1, a3simd4Mul(x0, x1)))), signBit);
+		x0 = a3simd4MulAdd(a3simd4Sub(a3simd4Xor(x1, sign), x0), t4, x0);
+		y0 = a3simd4MulAdd(a3simd4Sub(a3simd4Xor(y1, sign), y0), t4, y0);
+		z0 = a3simd4MulAdd(a3simd4Sub(a3simd4Xor(z1, sign), z0), t4, z0);
+		w0 = a3simd4MulAdd(a3simd4Sub(a3simd4Xor(w1, sign), w0), t4, w0);
+		lenSq = a3simd4MulAdd(w0, w0, a3simd4MulAdd(z0, z0, a3simd4MulAdd(y0, y0, a3simd4Mul(x0, x0))));
+		lenSq = a3simd4MaskPositive(a3simd4Div(one, a3simd4Sqrt(lenSq)), lenSq);
+		x0 = a3simd4Mul(x0, lenSq);
+		y0 = a3simd4Mul(y0, lenSq);
+		z0 = a3simd4Mul(z0, lenSq);
+		w0 = a3simd4Mul(w0, lenSq);
+		a3simd4Transpose(x0, y0, z0, w0);
+		a3simd4Store(q_out[i].q, x0);
+		a3simd4Store(q_out[i + 1].q, y0);
+		a3simd4Store(q_out[i + 2].q, z0);
+		a3simd4Store(q_out[i + 3].q, w0);
+	}
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+	for (; i < count; ++i)
+	{
+		t = param[i];
+		s = a3real4Dot(q0[i].q, q1[i].q) < a3real_zero ? -t : t;
+		a3real4ProductS(r, q0[i].q, a3real_one - t);
+		a3real4Add(r, a3real4ProductS(q_out[i].q, q1[i].q, s));
+		a3real4ProductS(q_out[i].q, r, a3sqrtSafeInverse(a3real4LengthSquared(r)));
+	}
+	return q_out;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_BATCH_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_BATCH_H
@@ -28,6 +28,10 @@
 #define __ANIMAL3D_A3DM_INTERPOLATION_IMPL_INL
 
 
+#include "../a3sqrt.h"
+#include "../a3simd.h"
+
+
 //-----------------------------------------------------------------------------
 // CUT FROM HEADER
 
@@ -797,6 +801,319 @@ A3_INLINE a3index a3sampleTableGenerateNumSamplesRequired(const a3index numDivis
 }
 
 
+// bisection search: same result as the increment search from zero, but the 
+//	number of steps grows with log of table size instead of table size
+A3_INLINE a3index a3sampleTableSearchIndex(const a3real paramTable[], const a3count numSamples, const a3real param, a3real *param_out)
+{
+	a3index i0 = 0, i1 = numSamples - 1, i;
+	a3real t0, t1;
+
+	if (numSamples >= 2 && paramTable)
+	{
+		// keep param in (t0, t1] until the interval is one sample wide; 
+		//	params beyond either end stay in the end interval
+		while (i1 - i0 > 1)
+		{
+			i = (i0 + i1) >> 1;
+			if (*(paramTable + i) < param)
+				i0 = i;
+			else
+				i1 = i;
+		}
+		if (param_out)
+		{
+			t0 = *(paramTable + i0);
+			t1 = *(paramTable + i1);
+			*param_out = t0 != t1 ? a3unlerp(t0, t1, param) : a3real_zero;
+			*param_out = a3clamp(a3real_zero, a3real_one, *param_out);
+		}
+		return i1;
+	}
+	return 0;
+}
+
+A3_INLINE a3real a3sampleTableLerpSearch(const a3real valueTable[], const a3real paramTable[], const a3count numSamples, const a3real param)
+{
+	a3real t, n0, n1, n = a3real_zero;
+	const a3index i = a3sampleTableSearchIndex(paramTable, numSamples, param, &t);
+	if (i)
+	{
+		n1 = *(valueTable + i);
+		n0 = *(valueTable + i - 1);
+		n = a3lerp(n0, n1, t);
+	}
+	return n;
+}
+
+
+// resample a table at evenly spaced parameters; the resampled parameters 
+//	increase, so each search resumes where the previous one ended and the 
+//	whole table is walked once
+A3_INLINE a3index a3sampleTableResampleUniform(a3real uniformTable_out[], const a3count numUniformDivisions, const a3real valueTable[], const a3real paramTable[], const a3count numSamples)
+{
+	a3real paramMin, paramMax, dp, p, t, t0, t1;
+	a3index i, j = 1;
+
+	if (numUniformDivisions && numSamples >= 2 && uniformTable_out && valueTable && paramTable)
+	{
+		paramMin = *paramTable;
+		paramMax = *(paramTable + numSamples - 1);
+		dp = (paramMax - paramMin) / (a3real)numUniformDivisions;
+		for (i = 0; i <= numUniformDivisions; ++i)
+		{
+			// last param exactly at end of table to avoid accumulated error
+			p = i < numUniformDivisions ? paramMin + dp * (a3real)i : paramMax;
+			while (j < numSamples - 1 && *(paramTable + j) < p)
+				++j;
+			t0 = *(paramTable + j - 1);
+			t1 = *(paramTable + j);
+			t = t0 != t1 ? a3unlerp(t0, t1, p) : a3real_zero;
+			*(uniformTable_out + i) = a3lerp(*(valueTable + j - 1), *(valueTable + j), t);
+		}
+		return i;
+	}
+	return 0;
+}
+
+
+// uniform table lookup: the interval is found by scaling the parameter, so 
+//	no search is needed; scale is (numUniformDivisions / parameter range)
+A3_INLINE a3real a3sampleTableInternalLerpUniform(const a3real uniformTable[], const a3count numUniformDivisions, const a3real paramMin, const a3real scale, const a3real param)
+{
+	const a3real x = (param - paramMin) * scale;
+	a3real t, n0, n1, n;
+	a3index i;
+
+	if (x <= a3real_zero)
+		n = *uniformTable;
+	else if (x >= (a3real)numUniformDivisions)
+		n = *(uniformTable + numUniformDivisions);
+	else
+	{
+		i = (a3index)x;
+		t = x - (a3real)i;
+		n0 = *(uniformTable + i);
+		n1 = *(uniformTable + i + 1);
+		n = a3lerp(n0, n1, t);
+	}
+	return n;
+}
+
+A3_INLINE a3real a3sampleTableLerpUniform(const a3real uniformTable[], const a3count numUniformDivisions, const a3real paramMin, const a3real paramMax, const a3real param)
+{
+	const a3real scale = (a3real)numUniformDivisions / (paramMax - paramMin);
+	const a3real n = a3sampleTableInternalLerpUniform(uniformTable, numUniformDivisions, paramMin, scale, param);
+	return n;
+}
+
+A3_INLINE a3real *a3sampleTableLerpUniformBatch(a3real value_out[], const a3real uniformTable[], const a3count numUniformDivisions, const a3real paramMin, const a3real paramMax, const a3real param[], const a3count count)
+{
+	const a3real scale = (a3real)numUniformDivisions / (paramMax - paramMin);
+	a3count i;
+	for (i = 0; i < count; ++i)
+		*(value_out + i) = a3sampleTableInternalLerpUniform(uniformTable, numUniformDivisions, paramMin, scale, *(param + i));
+	return value_out;
+}
+
+
+//-----------------------------------------------------------------------------
+// batch curve evaluation: each curve is rewritten as the cubic 
+//	c0 + t*(c1 + t*(c2 + t*c3)) per channel, with the same expansions as the 
+//	single value functions above; coefficients are indexed by power of t, 
+//	then by channel
+
+A3_INLINE void a3interpolationInternalCoeffCatmullRom(a3real c_out[4][4], const a3real nPrev[], const a3real n0[], const a3real n1[], const a3real nNext[], const a3count channels)
+{
+	a3count k;
+	for (k = 0; k < channels; ++k)
+	{
+		c_out[0][k] = n0[k];
+		c_out[1][k] = a3real_half*(n1[k] - nPrev[k]);
+		c_out[2][k] = a3real_half*(a3real_two*nPrev[k] - a3real_five*n0[k] + a3real_four*n1[k] - nNext[k]);
+		c_out[3][k] = a3real_half*(nNext[k] - nPrev[k] + a3real_three*n0[k] - a3real_three*n1[k]);
+	}
+}
+
+A3_INLINE void a3interpolationInternalCoeffHermiteControl(a3real c_out[4][4], const a3real n0[], const a3real n1[], const a3real nControl0[], const a3real nControl1[], const a3count channels)
+{
+	a3count k;
+	for (k = 0; k < channels; ++k)
+	{
+		c_out[0][k] = n0[k];
+		c_out[1][k] = nControl0[k] - n0[k];
+		c_out[2][k] = a3real_four*n1[k] - n0[k] - nControl1[k] - a3real_two*nControl0[k];
+		c_out[3][k] = nControl0[k] + nControl1[k] + n0[k] - a3real_three*n1[k];
+	}
+}
+
+A3_INLINE void a3interpolationInternalCoeffHermiteTangent(a3real c_out[4][4], const a3real n0[], const a3real n1[], const a3real nTangent0[], const a3real nTangent1[], const a3count channels)
+{
+	a3count k;
+	for (k = 0; k < channels; ++k)
+	{
+		c_out[0][k] = n0[k];
+		c_out[1][k] = nTangent0[k];
+		c_out[2][k] = a3real_three*n1[k] - a3real_three*n0[k] - nTangent1[k] - a3real_two*nTangent0[k];
+		c_out[3][k] = nTangent0[k] + nTangent1[k] + a3real_two*n0[k] - a3real_two*n1[k];
+	}
+}
+
+A3_INLINE void a3interpolationInternalCoeffBezier3(a3real c_out[4][4], const a3real n0[], const a3real n1[], const a3real n2[], const a3real n3[], const a3count channels)
+{
+	// Bernstein form expanded by power of t
+	a3count k;
+	for (k = 0; k < channels; ++k)
+	{
+		c_out[0][k] = n0[k];
+		c_out[1][k] = a3real_three*(n1[k] - n0[k]);
+		c_out[2][k] = a3real_three*(n0[k] - a3real_two*n1[k] + n2[k]);
+		c_out[3][k] = n3[k] - n0[k] + a3real_three*(n1[k] - n2[k]);
+	}
+}
+
+
+// 3 channels: SIMD evaluates four parameters per iteration with one register 
+//	per channel, then interleaves them into packed outputs
+A3_INLINE a3real *a3interpolationInternalCubicBatch3(a3real v_out[], a3real c[4][4], const a3real param[], const a3count count)
+{
+	a3real t;
+	a3count i = 0;
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	const a3simd4 cx0 = a3simd4Splat(c[0][0]), cx1 = a3simd4Splat(c[1][0]), cx2 = a3simd4Splat(c[2][0]), cx3 = a3simd4Splat(c[3][0]);
+	const a3simd4 cy0 = a3simd4Splat(c[0][1]), cy1 = a3simd4Splat(c[1][1]), cy2 = a3simd4Splat(c[2][1]), cy3 = a3simd4Splat(c[3][1]);
+	const a3simd4 cz0 = a3simd4Splat(c[0][2]), cz1 = a3simd4Splat(c[1][2]), cz2 = a3simd4Splat(c[2][2]), cz3 = a3simd4Splat(c[3][2]);
+	a3simd4 t4, x, y, z;
+	for (; i + 4 <= count; i += 4)
+	{
+		t4 = a3simd4Load(param + i);
+		x = a3simd4MulAdd(a3simd4MulAdd(a3simd4MulAdd(cx3, t4, cx2), t4, cx1), t4, cx0);
+		y = a3simd4MulAdd(a3simd4MulAdd(a3simd4MulAdd(cy3, t4, cy2), t4, cy1), t4, cy0);
+		z = a3simd4MulAdd(a3simd4MulAdd(a3simd4MulAdd(cz3, t4, cz2), t4, cz1), t4, cz0);
+		a3simd4Store3x4(v_out + i * 3, x, y, z);
+	}
+#endif	// !A3_SIMD_SCALAR
+	for (; i < count; ++i)
+	{
+		t = *(param + i);
+		v_out[i * 3 + 0] = c[0][0] + t*(c[1][0] + t*(c[2][0] + t*c[3][0]));
+		v_out[i * 3 + 1] = c[0][1] + t*(c[1][1] + t*(c[2][1] + t*c[3][1]));
+		v_out[i * 3 + 2] = c[0][2] + t*(c[1][2] + t*(c[2][2] + t*c[3][2]));
+	}
+	return v_out;
+}
+
+// 4 channels: one output per register, so SIMD evaluates one parameter at a 
+//	time with the same three multiply-adds
+A3_INLINE a3real *a3interpolationInternalCubicBatch4(a3real v_out[], a3real c[4][4], const a3real param[], const a3count count)
+{
+	a3real t;
+	a3count i = 0, k;
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	const a3simd4 c0 = a3simd4Load(c[0]), c1 = a3simd4Load(c[1]), c2 = a3simd4Load(c[2]), c3 = a3simd4Load(c[3]);
+	a3simd4 t4;
+	for (; i < count; ++i)
+	{
+		t4 = a3simd4Splat(*(param + i));
+		a3simd4Store(v_out + i * 4, a3simd4MulAdd(a3simd4MulAdd(a3simd4MulAdd(c3, t4, c2), t4, c1), t4, c0));
+	}
+#endif	// !A3_SIMD_SCALAR
+	for (; i < count; ++i)
+	{
+		t = *(param + i);
+		for (k = 0; k < 4; ++k)
+			v_out[i * 4 + k] = c[0][k] + t*(c[1][k] + t*(c[2][k] + t*c[3][k]));
+	}
+	return v_out;
+}
+
+
+A3_INLINE a3real *a3real3CatmullRomBatch(a3real v_out[], const a3real3p nPrev, const a3real3p n0, const a3real3p n1, const a3real3p nNext, const a3real param[], const a3count count)
+{
+	a3real c[4][4];
+	a3interpolationInternalCoeffCatmullRom(c, nPrev, n0, n1, nNext, 3);
+	return a3interpolationInternalCubicBatch3(v_out, c, param, count);
+}
+
+A3_INLINE a3real *a3real4CatmullRomBatch(a3real v_out[], const a3real4p nPrev, const a3real4p n0, const a3real4p n1, const a3real4p nNext, const a3real param[], const a3count count)
+{
+	a3real c[4][4];
+	a3interpolationInternalCoeffCatmullRom(c, nPrev, n0, n1, nNext, 4);
+	return a3interpolationInternalCubicBatch4(v_out, c, param, count);
+}
+
+A3_INLINE a3real *a3real3HermiteControlBatch(a3real v_out[], const a3real3p n0, const a3real3p n1, const a3real3p nControl0, const a3real3p nControl1, const a3real param[], const a3count count)
+{
+	a3real c[4][4];
+	a3interpolationInternalCoeffHermiteControl(c, n0, n1, nControl0, nControl1, 3);
+	return a3interpolationInternalCubicBatch3(v_out, c, param, count);
+}
+
+A3_INLINE a3real *a3real4HermiteControlBatch(a3real v_out[], const a3real4p n0, const a3real4p n1, const a3real4p nControl0, const a3real4p nControl1, const a3real param[], const a3count count)
+{
+	a3real c[4][4];
+	a3interpolationInternalCoeffHermiteControl(c, n0, n1, nControl0, nControl1, 4);
+	return a3interpolationInternalCubicBatch4(v_out, c, param, count);
+}
+
+A3_INLINE a3real *a3real3HermiteTangentBatch(a3real v_out[], const a3real3p n0, const a3real3p n1, const a3real3p nTangent0, const a3real3p nTangent1, const a3real param[], const a3count count)
+{
+	a3real c[4][4];
+	a3interpolationInternalCoeffHermiteTangent(c, n0, n1, nTangent0, nTangent1, 3);
+	return a3interpolationInternalCubicBatch3(v_out, c, param, count);
+}
+
+A3_INLINE a3real *a3real4HermiteTangentBatch(a3real v_out[], const a3real4p n0, const a3real4p n1, const a3real4p nTangent0, const a3real4p nTangent1, const a3real param[], const a3count count)
+{
+	a3real c[4][4];
+	a3interpolationInternalCoeffHermiteTangent(c, n0, n1, nTangent0, nTangent1, 4);
+	return a3interpolationInternalCubicBatch4(v_out, c, param, count);
+}
+
+A3_INLINE a3real *a3real3Bezier3Batch(a3real v_out[], const a3real3p n0, const a3real3p n1, const a3real3p n2, const a3real3p n3, const a3real param[], const a3count count)
+{
+	a3real c[4][4];
+	a3interpolationInternalCoeffBezier3(c, n0, n1, n2, n3, 3);
+	return a3interpolationInternalCubicBatch3(v_out, c, param, count);
+}
+
+A3_INLINE a3real *a3real4Bezier3Batch(a3real v_out[], const a3real4p n0, const a3real4p n1, const a3real4p n2, const a3real4p n3, const a3real param[], const a3count count)
+{
+	a3real c[4][4];
+	a3interpolationInternalCoeffBezier3(c, n0, n1, n2, n3, 4);
+	return a3interpolationInternalCubicBatch4(v_out, c, param, count);
+}
+
+
+// arc length through 3D samples: same as the single value calculators, with 
+//	distance instead of absolute difference
+A3_INLINE a3real a3calculateArcLengthSamples3(a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real sampleTable[])
+{
+	a3real *arclen_ptr = arclenTable_out;
+	a3real arclen = a3real_zero, arclen_inv, dx, dy, dz;
+	a3index i;
+
+	if (numDivisions && arclenTable_out && sampleTable)
+	{
+		*arclenTable_out = arclen;
+		for (i = 1; i <= numDivisions; ++i, sampleTable += 3)
+		{
+			dx = *(sampleTable + 3) - *(sampleTable + 0);
+			dy = *(sampleTable + 4) - *(sampleTable + 1);
+			dz = *(sampleTable + 5) - *(sampleTable + 2);
+			arclen += a3sqrt(dx*dx + dy*dy + dz*dz);
+			*(++arclenTable_out) = arclen;
+		}
+		if (autoNormalize)
+		{
+			arclen_inv = a3recipsafe(arclen);
+			for (i = 1; i <= numDivisions; ++i)
+				*(++arclen_ptr) *= arclen_inv;
+		}
+	}
+	return arclen;
+}
+
+
 //-----------------------------------------------------------------------------
 
 
@@ -45,6 +45,195 @@ A3_GLOBAL const a3mat4 a3mat4_identity = {
 };
 
 
+//-----------------------------------------------------------------------------
+
+// SIMD kernels shared by plain and aligned functions; the 'aligned' flag is 
+//	always a literal, so each caller keeps only one kind of load and store
+// all inputs are loaded before the first store, so outputs may alias inputs
+#if (A3_SIMD != A3_SIMD_SCALAR && !defined A3_MAT_ROWMAJOR)
+#define A3_SIMD_MAT4
+
+A3_INLINE a3real4r a3real4Real4x4ProductSIMD(a3real4p v_out, const a3real4x4p m, const a3real4p v, const a3boolean aligned)
+{
+	// columns scaled by vector elements, summed in the same order as scalar
+	a3simd4 r = a3simd4Mul(a3simd4LoadAs(m[0], aligned), a3simd4Splat(v[0]));
+	r = a3simd4MulAdd(a3simd4LoadAs(m[1], aligned), a3simd4Splat(v[1]), r);
+	r = a3simd4MulAdd(a3simd4LoadAs(m[2], aligned), a3simd4Splat(v[2]), r);
+	r = a3simd4MulAdd(a3simd4LoadAs(m[3], aligned), a3simd4Splat(v[3]), r);
+	a3simd4StoreAs(v_out, r, aligned);
+	return v_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4ProductSIMD(a3real4x4p m_out, const a3real4x4p mL, const a3real4x4p mR, const a3boolean aligned)
+{
+	const a3simd4 l0 = a3simd4LoadAs(mL[0], aligned), l1 = a3simd4LoadAs(mL[1], aligned), l2 = a3simd4LoadAs(mL[2], aligned), l3 = a3simd4LoadAs(mL[3], aligned);
+#if (A3_SIMD == A3_SIMD_AVX2)
+	// two output columns at once: each half is one column of right matrix
+	const a3simd8 L0 = a3simd8Splat4(l0), L1 = a3simd8Splat4(l1), L2 = a3simd8Splat4(l2), L3 = a3simd8Splat4(l3);
+	const a3simd8 r01 = a3simd8Load(mR[0]), r23 = a3simd8Load(mR[2]);
+	a3simd8 p01 = a3simd8Mul(L0, a3simd8Lane(r01, 0)), p23 = a3simd8Mul(L0, a3simd8Lane(r23, 0));
+	p01 = a3simd8MulAdd(L1, a3simd8Lane(r01, 1), p01);	p23 = a3simd8MulAdd(L1, a3simd8Lane(r23, 1), p23);
+	p01 = a3simd8MulAdd(L2, a3simd8Lane(r01, 2), p01);	p23 = a3simd8MulAdd(L2, a3simd8Lane(r23, 2), p23);
+	p01 = a3simd8MulAdd(L3, a3simd8Lane(r01, 3), p01);	p23 = a3simd8MulAdd(L3, a3simd8Lane(r23, 3), p23);
+	a3simd8Store(m_out[0], p01);
+	a3simd8Store(m_out[2], p23);
+#else	// !A3_SIMD_AVX2
+	a3simd4 p0 = a3simd4Mul(l0, a3simd4Splat(mR[0][0])), p1 = a3simd4Mul(l0, a3simd4Splat(mR[1][0])), p2 = a3simd4Mul(l0, a3simd4Splat(mR[2][0])), p3 = a3simd4Mul(l0, a3simd4Splat(mR[3][0]));
+	p0 = a3simd4MulAdd(l1, a3simd4Splat(mR[0][1]), p0);	p1 = a3simd4MulAdd(l1, a3simd4Splat(mR[1][1]), p1);	p2 = a3simd4MulAdd(l1, a3simd4Splat(mR[2][1]), p2);	p3 = a3simd4MulAdd(l1, a3simd4Splat(mR[3][1]), p3);
+	p0 = a3simd4MulAdd(l2, a3simd4Splat(mR[0][2]), p0);	p1 = a3simd4MulAdd(l2, a3simd4Splat(mR[1][2]), p1);	p2 = a3simd4MulAdd(l2, a3simd4Splat(mR[2][2]), p2);	p3 = a3simd4MulAdd(l2, a3simd4Splat(mR[3][2]), p3);
+	p0 = a3simd4MulAdd(l3, a3simd4Splat(mR[0][3]), p0);	p1 = a3simd4MulAdd(l3, a3simd4Splat(mR[1][3]), p1);	p2 = a3simd4MulAdd(l3, a3simd4Splat(mR[2][3]), p2);	p3 = a3simd4MulAdd(l3, a3simd4Splat(mR[3][3]), p3);
+	a3simd4StoreAs(m_out[0], p0, aligned);
+	a3simd4StoreAs(m_out[1], p1, aligned);
+	a3simd4StoreAs(m_out[2], p2, aligned);
+	a3simd4StoreAs(m_out[3], p3, aligned);
+#endif	// A3_SIMD_AVX2
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4GetTransposedSIMD(a3real4x4p m_out, const a3real4x4p m, const a3boolean aligned)
+{
+	a3simd4 m0 = a3simd4LoadAs(m[0], aligned), m1 = a3simd4LoadAs(m[1], aligned), m2 = a3simd4LoadAs(m[2], aligned), m3 = a3simd4LoadAs(m[3], aligned);
+	a3simd4Transpose(m0, m1, m2, m3);
+	a3simd4StoreAs(m_out[0], m0, aligned);
+	a3simd4StoreAs(m_out[1], m1, aligned);
+	a3simd4StoreAs(m_out[2], m2, aligned);
+	a3simd4StoreAs(m_out[3], m3, aligned);
+	return m_out;
+}
+
+A3_INLINE a3real4x4r a3real4x4TransformInverseSIMD(a3real4x4p m_out, const a3real4x4p m, const a3ui32 scaleMode)
+{
+	// rows of upper 3x3 become columns of inverse, each lane divided by the 
+	//	squared length of its axis: per axis if mode is 2, first axis if 1, 
+	//	none if 0; last lane of scale is zero, which also clears translation 
+	//	out of each row
+	const a3real4 axes = { a3real_one, a3real_one, a3real_one, a3real_zero };
+	const a3simd4 t0 = a3simd4Splat(m[3][0]), t1 = a3simd4Splat(m[3][1]), t2 = a3simd4Splat(m[3][2]);
+	const a3simd4 xyz = a3simd4Load(axes), one = a3simd4Splat(a3real_one);
+	a3simd4 r0 = a3simd4Load(m[0]), r1 = a3simd4Load(m[1]), r2 = a3simd4Load(m[2]), r3 = a3simd4Load(m[3]), s;
+	a3simd4Transpose(r0, r1, r2, r3);
+	if (scaleMode == 2)
+	{
+		s = a3simd4MulAdd(r2, r2, a3simd4MulAdd(r1, r1, a3simd4Mul(r0, r0)));
+		s = a3simd4MaskPositive(a3simd4Div(one, s), xyz);
+	}
+	else if (scaleMode == 1)
+		s = a3simd4Mul(a3simd4Splat(a3real3LengthSquaredInverse(m[0])), xyz);
+	else
+		s = xyz;
+	r0 = a3simd4Mul(r0, s);
+	r1 = a3simd4Mul(r1, s);
+	r2 = a3simd4Mul(r2, s);
+
+	// translation negated and multiplied by result, last lane one
+	r3 = a3simd4MulAdd(r2, t2, a3simd4MulAdd(r1, t1, a3simd4Mul(r0, t0)));
+	r3 = a3simd4Sub(a3simd4Sub(one, xyz), r3);
+	a3simd4Store(m_out[0], r0);
+	a3simd4Store(m_out[1], r1);
+	a3simd4Store(m_out[2], r2);
+	a3simd4Store(m_out[3], r3);
+	return m_out;
+}
+
+#if (A3_SIMD != A3_SIMD_NEON)
+// inverse by 2x2 blocks, each packed in one register as (x0, y0, x1, y1); 
+//	x86 only, NEON builds use the scalar inverse
+#define a3simd4Shuffle(a,b,x,y,z,w)	_mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+#define a3simd4Swizzle(v,x,y,z,w)	_mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x))
+
+// 2x2 product A*B
+A3_INLINE a3simd4 a3simd4Real2x2Product(const a3simd4 a, const a3simd4 b)
+{
+	return a3simd4Add(a3simd4Mul(a, a3simd4Swizzle(b, 0, 3, 0, 3)), a3simd4Mul(a3simd4Swizzle(a, 1, 0, 3, 2), a3simd4Swizzle(b, 2, 1, 2, 1)));
+}
+
+// 2x2 adjugate product adj(A)*B
+A3_INLINE a3simd4 a3simd4Real2x2AdjProduct(const a3simd4 a, const a3simd4 b)
+{
+	return a3simd4Sub(a3simd4Mul(a3simd4Swizzle(a, 3, 3, 0, 0), b), a3simd4Mul(a3simd4Swizzle(a, 1, 1, 2, 2), a3simd4Swizzle(b, 2, 3, 0, 1)));
+}
+
+// 2x2 product with adjugate A*adj(B)
+A3_INLINE a3simd4 a3simd4Real2x2ProductAdj(const a3simd4 a, const a3simd4 b)
+{
+	return a3simd4Sub(a3simd4Mul(a, a3simd4Swizzle(b, 3, 0, 3, 0)), a3simd4Mul(a3simd4Swizzle(a, 1, 0, 3, 2), a3simd4Swizzle(b, 2, 1, 2, 1)));
+}
+
+A3_INLINE a3real4x4r a3real4x4GetInverseSIMD(a3real4x4p m_out, const a3real4x4p m, const a3boolean aligned)
+{
+	// inverse of transpose is transpose of inverse, so the blocks may be 
+	//	taken from columns as if they were rows
+	const a3simd4 m0 = a3simd4LoadAs(m[0], aligned), m1 = a3simd4LoadAs(m[1], aligned), m2 = a3simd4LoadAs(m[2], aligned), m3 = a3simd4LoadAs(m[3], aligned);
+	const a3simd4 a = _mm_movelh_ps(m0, m1), b = _mm_movehl_ps(m1, m0), c = _mm_movelh_ps(m2, m3), d = _mm_movehl_ps(m3, m2);
+
+	// block determinants (|A|, |B|, |C|, |D|)
+	const a3simd4 det = a3simd4Sub(
+		a3simd4Mul(a3simd4Shuffle(m0, m2, 0, 2, 0, 2), a3simd4Shuffle(m1, m3, 1, 3, 1, 3)),
+		a3simd4Mul(a3simd4Shuffle(m0, m2, 1, 3, 1, 3), a3simd4Shuffle(m1, m3, 0, 2, 0, 2)));
+	const a3simd4 detA = a3simd4Swizzle(det, 0, 0, 0, 0), detB = a3simd4Swizzle(det, 1, 1, 1, 1), detC = a3simd4Swizzle(det, 2, 2, 2, 2), detD = a3simd4Swizzle(det, 3, 3, 3, 3);
+
+	// adjugate blocks of inverse (X Y, Z W), scaled by 1/|M| below
+	const a3simd4 dc = a3simd4Real2x2AdjProduct(d, c), ab = a3simd4Real2x2AdjProduct(a, b);
+	a3simd4 x = a3simd4Sub(a3simd4Mul(detD, a), a3simd4Real2x2Product(b, dc));
+	a3simd4 w = a3simd4Sub(a3simd4Mul(detA, d), a3simd4Real2x2Product(c, ab));
+	a3simd4 y = a3simd4Sub(a3simd4Mul(detB, c), a3simd4Real2x2ProductAdj(d, ab));
+	a3simd4 z = a3simd4Sub(a3simd4Mul(detC, b), a3simd4Real2x2ProductAdj(a, dc));
+
+	// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C), trace summed into all
+	a3simd4 tr = a3simd4Mul(ab, a3simd4Swizzle(dc, 0, 2, 1, 3)), detM;
+	tr = a3simd4Add(tr, a3simd4Swizzle(tr, 1, 0, 3, 2));
+	tr = a3simd4Add(tr, a3simd4Swizzle(tr, 2, 3, 0, 1));
+	detM = a3simd4Sub(a3simd4Add(a3simd4Mul(detA, detD), a3simd4Mul(detB, detC)), tr);
+	detM = _mm_div_ps(_mm_setr_ps(a3real_one, -a3real_one, -a3real_one, a3real_one), detM);
+	x = a3simd4Mul(x, detM);
+	y = a3simd4Mul(y, detM);
+	z = a3simd4Mul(z, detM);
+	w = a3simd4Mul(w, detM);
+
+	// adjugate shuffle combined with reassembly
+	a3simd4StoreAs(m_out[0], a3simd4Shuffle(x, y, 3, 1, 3, 1), aligned);
+	a3simd4StoreAs(m_out[1], a3simd4Shuffle(x, y, 2, 0, 2, 0), aligned);
+	a3simd4StoreAs(m_out[2], a3simd4Shuffle(z, w, 3, 1, 3, 1), aligned);
+	a3simd4StoreAs(m_out[3], a3simd4Shuffle(z, w, 2, 0, 2, 0), aligned);
+	return m_out;
+}
+A3_INLINE a3real4x4r a3real4x4TransformInverseAffineSIMD(a3real4x4p m_out, const a3real4x4p m)
+{
+	// with rows of upper 3x3 in registers, columns of inverse are cross 
+	//	products of the other two rows divided by the determinant; last lane 
+	//	is cleared first so it stays zero even if products are fused
+	const a3real4 axes = { a3real_one, a3real_one, a3real_one, a3real_zero };
+	const a3simd4 t0 = a3simd4Splat(m[3][0]), t1 = a3simd4Splat(m[3][1]), t2 = a3simd4Splat(m[3][2]);
+	const a3simd4 xyz = a3simd4Load(axes), one = a3simd4Splat(a3real_one);
+	a3simd4 r0 = a3simd4Load(m[0]), r1 = a3simd4Load(m[1]), r2 = a3simd4Load(m[2]), r3 = a3simd4Load(m[3]);
+	a3simd4 c0, c1, c2, dInv;
+	a3simd4Transpose(r0, r1, r2, r3);
+	r0 = a3simd4Mul(r0, xyz);
+	r1 = a3simd4Mul(r1, xyz);
+	r2 = a3simd4Mul(r2, xyz);
+	c0 = a3simd4Sub(a3simd4Mul(a3simd4Swizzle(r1, 1, 2, 0, 3), a3simd4Swizzle(r2, 2, 0, 1, 3)), a3simd4Mul(a3simd4Swizzle(r1, 2, 0, 1, 3), a3simd4Swizzle(r2, 1, 2, 0, 3)));
+	c1 = a3simd4Sub(a3simd4Mul(a3simd4Swizzle(r2, 1, 2, 0, 3), a3simd4Swizzle(r0, 2, 0, 1, 3)), a3simd4Mul(a3simd4Swizzle(r2, 2, 0, 1, 3), a3simd4Swizzle(r0, 1, 2, 0, 3)));
+	c2 = a3simd4Sub(a3simd4Mul(a3simd4Swizzle(r0, 1, 2, 0, 3), a3simd4Swizzle(r1, 2, 0, 1, 3)), a3simd4Mul(a3simd4Swizzle(r0, 2, 0, 1, 3), a3simd4Swizzle(r1, 1, 2, 0, 3)));
+	dInv = a3simd4Splat(a3recip(a3simd4Dot(r0, c0)));
+	c0 = a3simd4Mul(c0, dInv);
+	c1 = a3simd4Mul(c1, dInv);
+	c2 = a3simd4Mul(c2, dInv);
+
+	// translation negated and multiplied by result, last lane one
+	r3 = a3simd4MulAdd(c2, t2, a3simd4MulAdd(c1, t1, a3simd4Mul(c0, t0)));
+	r3 = a3simd4Sub(a3simd4Sub(one, xyz), r3);
+	a3simd4Store(m_out[0], c0);
+	a3simd4Store(m_out[1], c1);
+	a3simd4Store(m_out[2], c2);
+	a3simd4Store(m_out[3], r3);
+	return m_out;
+}
+#define A3_SIMD_MAT4_INVERSE
+#endif	// (A3_SIMD != A3_SIMD_NEON)
+
+#endif	// (A3_SIMD != A3_SIMD_SCALAR && !defined A3_MAT_ROWMAJOR)
+
+
 //-----------------------------------------------------------------------------
 
 // create 4x4 matrix
@@ -115,7 +304,12 @@ A3_INLINE a3real4x4r a3real4x4SetReal4x4(a3real4x4p m_out, const a3real4x4p m)
 ///
 A3_INLINE a3real a3real4x4Determinant(const a3real4x4p m)
 {
-	const a3real d = (m[0][0] * m[1][1] * m[2][2] * m[3][3] + m[1][0] * m[2][1] * m[3][2] * m[0][3] + m[2][0] * m[3][1] * m[0][2] * m[1][3] + m[3][0] * m[0][1] * m[1][2] * m[2][3]) - (m[3][0] * m[2][1] * m[1][2] * m[0][3] + m[2][0] * m[1][1] * m[0][2] * m[3][3] + m[1][0] * m[0][1] * m[3][2] * m[2][3] + m[0][0] * m[3][1] * m[2][2] * m[1][3]);
+	// expansion by 2x2 minors of the first two and last two majors
+	const a3real s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1], s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2], s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+	const a3real s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2], s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3], s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+	const a3real c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1], c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2], c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+	const a3real c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2], c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3], c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+	const a3real d = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
 	return d;
 }
 
@@ -136,15 +330,31 @@ A3_INLINE a3real4x4r a3real4x4GetNegative(a3real4x4p m_out, const a3real4x4p m)
 
 A3_INLINE a3real4x4r a3real4x4GetTransposed(a3real4x4p m_out, const a3real4x4p m)
 {
+#ifdef A3_SIMD_MAT4
+	a3real4x4GetTransposedSIMD(m_out, m, a3false);
+#else	// !A3_SIMD_MAT4
 	m_out[0][0] = m[0][0];			m_out[1][0] = m[0][1];			m_out[2][0] = m[0][2];			m_out[3][0] = m[0][3];
 	m_out[0][1] = m[1][0];			m_out[1][1] = m[1][1];			m_out[2][1] = m[1][2];			m_out[3][1] = m[1][3];
 	m_out[0][2] = m[2][0];			m_out[1][2] = m[2][1];			m_out[2][2] = m[2][2];			m_out[3][2] = m[2][3];
 	m_out[0][3] = m[3][0];			m_out[1][3] = m[3][1];			m_out[2][3] = m[3][2];			m_out[3][3] = m[3][3];
+#endif	// A3_SIMD_MAT4
 	return m_out;
 }
 
+A3_INLINE a3real4x4r a3real4x4GetTransposedAligned(a3real4x4p m_out, const a3real4x4p m)
+{
+#ifdef A3_SIMD_MAT4
+	return a3real4x4GetTransposedSIMD(m_out, m, a3true);
+#else	// !A3_SIMD_MAT4
+	return a3real4x4GetTransposed(m_out, m);
+#endif	// A3_SIMD_MAT4
+}
+
 A3_INLINE a3real4x4r a3real4x4GetInverse(a3real4x4p m_out, const a3real4x4p m)
 {
+#ifdef A3_SIMD_MAT4_INVERSE
+	a3real4x4GetInverseSIMD(m_out, m, a3false);
+#else	// !A3_SIMD_MAT4_INVERSE
 	const a3real dInv = a3real4x4DeterminantInverse(m);
 	a3real4x4Set(m_out,
 		dInv*((m[1][1] * m[2][2] * m[3][3] + m[2][1] * m[3][2] * m[1][3] + m[3][1] * m[1][2] * m[2][3]) - (m[1][1] * m[3][2] * m[2][3] + m[2][1] * m[1][2] * m[3][3] + m[3][1] * m[2][2] * m[1][3])),
@@ -163,9 +373,19 @@ A3_INLINE a3real4x4r a3real4x4GetInverse(a3real4x4p m_out, const a3real4x4p m)
 		dInv*((m[0][0] * m[2][1] * m[3][2] + m[2][0] * m[3][1] * m[0][2] + m[3][0] * m[0][1] * m[2][2]) - (m[0][0] * m[3][1] * m[2][2] + m[2][0] * m[0][1] * m[3][2] + m[3][0] * m[2][1] * m[0][2])),
 		dInv*((m[0][0] * m[3][1] * m[1][2] + m[1][0] * m[0][1] * m[3][2] + m[3][0] * m[1][1] * m[0][2]) - (m[0][0] * m[1][1] * m[3][2] + m[1][0] * m[3][1] * m[0][2] + m[3][0] * m[0][1] * m[1][2])),
 		dInv*((m[0][0] * m[1][1] * m[2][2] + m[1][0] * m[2][1] * m[0][2] + m[2][0] * m[0][1] * m[1][2]) - (m[0][0] * m[2][1] * m[1][2] + m[1][0] * m[0][1] * m[2][2] + m[2][0] * m[1][1] * m[0][2])));
+#endif	// A3_SIMD_MAT4_INVERSE
 	return m_out;
 }
 
+A3_INLINE a3real4x4r a3real4x4GetInverseAligned(a3real4x4p m_out, const a3real4x4p m)
+{
+#ifdef A3_SIMD_MAT4_INVERSE
+	return a3real4x4GetInverseSIMD(m_out, m, a3true);
+#else	// !A3_SIMD_MAT4_INVERSE
+	return a3real4x4GetInverse(m_out, m);
+#endif	// A3_SIMD_MAT4_INVERSE
+}
+
 A3_INLINE a3real4x4r a3real4x4Negate(a3real4x4p m_inout)
 {
 	m_inout[0][0] = -m_inout[0][0];	m_inout[1][0] = -m_inout[1][0];	m_inout[2][0] = -m_inout[2][0];	m_inout[3][0] = -m_inout[3][0];
@@ -201,28 +421,49 @@ A3_INLINE a3real4x4r a3real4x4Invert(a3real4x4p m_inout)
 ///
 A3_INLINE a3real4x4r a3real4x4Sum(a3real4x4p m_out, const a3real4x4p mL, const a3real4x4p mR)
 {
+#ifdef A3_SIMD_MAT4
+	a3real4Sum(m_out[0], mL[0], mR[0]);
+	a3real4Sum(m_out[1], mL[1], mR[1]);
+	a3real4Sum(m_out[2], mL[2], mR[2]);
+	a3real4Sum(m_out[3], mL[3], mR[3]);
+#else	// !A3_SIMD_MAT4
 	m_out[0][0] = mL[0][0] + mR[0][0];	m_out[1][0] = mL[1][0] + mR[1][0];	m_out[2][0] = mL[2][0] + mR[2][0];	m_out[3][0] = mL[3][0] + mR[3][0];
 	m_out[0][1] = mL[0][1] + mR[0][1];	m_out[1][1] = mL[1][1] + mR[1][1];	m_out[2][1] = mL[2][1] + mR[2][1];	m_out[3][1] = mL[3][1] + mR[3][1];
 	m_out[0][2] = mL[0][2] + mR[0][2];	m_out[1][2] = mL[1][2] + mR[1][2];	m_out[2][2] = mL[2][2] + mR[2][2];	m_out[3][2] = mL[3][2] + mR[3][2];
 	m_out[0][3] = mL[0][3] + mR[0][3];	m_out[1][3] = mL[1][3] + mR[1][3];	m_out[2][3] = mL[2][3] + mR[2][3];	m_out[3][3] = mL[3][3] + mR[3][3];
+#endif	// A3_SIMD_MAT4
 	return m_out;
 }
 
 A3_INLINE a3real4x4r a3real4x4Diff(a3real4x4p m_out, const a3real4x4p mL, const a3real4x4p mR)
 {
+#ifdef A3_SIMD_MAT4
+	a3real4Diff(m_out[0], mL[0], mR[0]);
+	a3real4Diff(m_out[1], mL[1], mR[1]);
+	a3real4Diff(m_out[2], mL[2], mR[2]);
+	a3real4Diff(m_out[3], mL[3], mR[3]);
+#else	// !A3_SIMD_MAT4
 	m_out[0][0] = mL[0][0] - mR[0][0];	m_out[1][0] = mL[1][0] - mR[1][0];	m_out[2][0] = mL[2][0] - mR[2][0];	m_out[3][0] = mL[3][0] - mR[3][0];
 	m_out[0][1] = mL[0][1] - mR[0][1];	m_out[1][1] = mL[1][1] - mR[1][1];	m_out[2][1] = mL[2][1] - mR[2][1];	m_out[3][1] = mL[3][1] - mR[3][1];
 	m_out[0][2] = mL[0][2] - mR[0][2];	m_out[1][2] = mL[1][2] - mR[1][2];	m_out[2][2] = mL[2][2] - mR[2][2];	m_out[3][2] = mL[3][2] - mR[3][2];
 	m_out[0][3] = mL[0][3] - mR[0][3];	m_out[1][3] = mL[1][3] - mR[1][3];	m_out[2][3] = mL[2][3] - mR[2][3];	m_out[3][3] = mL[3][3] - mR[3][3];
+#endif	// A3_SIMD_MAT4
 	return m_out;
 }
 
 A3_INLINE a3real4x4r a3real4x4ProductS(a3real4x4p m_out, const a3real4x4p m, const a3real s)
 {
+#ifdef A3_SIMD_MAT4
+	a3real4ProductS(m_out[0], m[0], s);
+	a3real4ProductS(m_out[1], m[1], s);
+	a3real4ProductS(m_out[2], m[2], s);
+	a3real4ProductS(m_out[3], m[3], s);
+#else	// !A3_SIMD_MAT4
 	m_out[0][0] = m[0][0] * s;			m_out[1][0] = m[1][0] * s;			m_out[2][0] = m[2][0] * s;			m_out[3][0] = m[3][0] * s;
 	m_out[0][1] = m[0][1] * s;			m_out[1][1] = m[1][1] * s;			m_out[2][1] = m[2][1] * s;			m_out[3][1] = m[3][1] * s;
 	m_out[0][2] = m[0][2] * s;			m_out[1][2] = m[1][2] * s;			m_out[2][2] = m[2][2] * s;			m_out[3][2] = m[3][2] * s;
 	m_out[0][3] = m[0][3] * s;			m_out[1][3] = m[1][3] * s;			m_out[2][3] = m[2][3] * s;			m_out[3][3] = m[3][3] * s;
+#endif	// A3_SIMD_MAT4
 	return m_out;
 }
 
@@ -238,28 +479,49 @@ A3_INLINE a3real4x4r a3real4x4QuotientS(a3real4x4p m_out, const a3real4x4p m, co
 
 A3_INLINE a3real4x4r a3real4x4Add(a3real4x4p mL_inout, const a3real4x4p mR)
 {
+#ifdef A3_SIMD_MAT4
+	a3real4Add(mL_inout[0], mR[0]);
+	a3real4Add(mL_inout[1], mR[1]);
+	a3real4Add(mL_inout[2], mR[2]);
+	a3real4Add(mL_inout[3], mR[3]);
+#else	// !A3_SIMD_MAT4
 	mL_inout[0][0] += mR[0][0];			mL_inout[1][0] += mR[1][0];			mL_inout[2][0] += mR[2][0];			mL_inout[3][0] += mR[3][0];
 	mL_inout[0][1] += mR[0][1];			mL_inout[1][1] += mR[1][1];			mL_inout[2][1] += mR[2][1];			mL_inout[3][1] += mR[3][1];
 	mL_inout[0][2] += mR[0][2];			mL_inout[1][2] += mR[1][2];			mL_inout[2][2] += mR[2][2];			mL_inout[3][2] += mR[3][2];
 	mL_inout[0][3] += mR[0][3];			mL_inout[1][3] += mR[1][3];			mL_inout[2][3] += mR[2][3];			mL_inout[3][3] += mR[3][3];
+#endif	// A3_SIMD_MAT4
 	return mL_inout;
 }
 
 A3_INLINE a3real4x4r a3real4x4Sub(a3real4x4p mL_inout, const a3real4x4p mR)
 {
+#ifdef A3_SIMD_MAT4
+	a3real4Sub(mL_inout[0], mR[0]);
+	a3real4Sub(mL_inout[1], mR[1]);
+	a3real4Sub(mL_inout[2], mR[2]);
+	a3real4Sub(mL_inout[3], mR[3]);
+#else	// !A3_SIMD_MAT4
 	mL_inout[0][0] -= mR[0][0];			mL_inout[1][0] -= mR[1][0];			mL_inout[2][0] -= mR[2][0];			mL_inout[3][0] -= mR[3][0];
 	mL_inout[0][1] -= mR[0][1];			mL_inout[1][1] -= mR[1][1];			mL_inout[2][1] -= mR[2][1];			mL_inout[3][1] -= mR[3][1];
 	mL_inout[0][2] -= mR[0][2];			mL_inout[1][2] -= mR[1][2];			mL_inout[2][2] -= mR[2][2];			mL_inout[3][2] -= mR[3][2];
 	mL_inout[0][3] -= mR[0][3];			mL_inout[1][3] -= mR[1][3];			mL_inout[2][3] -= mR[2][3];			mL_inout[3][3] -= mR[3][3];
+#endif	// A3_SIMD_MAT4
 	return mL_inout;
 }
 
 A3_INLINE a3real4x4r a3real4x4MulS(a3real4x4p m_inout, const a3real s)
 {
+#ifdef A3_SIMD_MAT4
+	a3real4MulS(m_inout[0], s);
+	a3real4MulS(m_inout[1], s);
+	a3real4MulS(m_inout[2], s);
+	a3real4MulS(m_inout[3], s);
+#else	// !A3_SIMD_MAT4
 	m_inout[0][0] *= s;					m_inout[1][0] *= s;					m_inout[2][0] *= s;					m_inout[3][0] *= s;
 	m_inout[0][1] *= s;					m_inout[1][1] *= s;					m_inout[2][1] *= s;					m_inout[3][1] *= s;
 	m_inout[0][2] *= s;					m_inout[1][2] *= s;					m_inout[2][2] *= s;					m_inout[3][2] *= s;
 	m_inout[0][3] *= s;					m_inout[1][3] *= s;					m_inout[2][3] *= s;					m_inout[3][3] *= s;
+#endif	// A3_SIMD_MAT4
 	return m_inout;
 }
 
@@ -278,6 +540,15 @@ A3_INLINE a3real4x4r a3real4x4DivS(a3real4x4p m_inout, const a3real s)
 ///
 A3_INLINE a3real4r a3real4Real4x4ProductL(a3real4p v_out, const a3real4p v, const a3real4x4p m)
 {
+#ifdef A3_SIMD_MAT4
+	a3simd4 m0 = a3simd4Load(m[0]), m1 = a3simd4Load(m[1]), m2 = a3simd4Load(m[2]), m3 = a3simd4Load(m[3]), r;
+	a3simd4Transpose(m0, m1, m2, m3);
+	r = a3simd4Mul(m0, a3simd4Splat(v[0]));
+	r = a3simd4MulAdd(m1, a3simd4Splat(v[1]), r);
+	r = a3simd4MulAdd(m2, a3simd4Splat(v[2]), r);
+	r = a3simd4MulAdd(m3, a3simd4Splat(v[3]), r);
+	a3simd4Store(v_out, r);
+#else	// !A3_SIMD_MAT4
 	a3real4 tmp;
 #ifndef A3_MAT_ROWMAJOR
 	tmp[0] = m[0][0] * v[0] + m[0][1] * v[1] + m[0][2] * v[2] + m[0][3] * v[3];
@@ -294,11 +565,15 @@ A3_INLINE a3real4r a3real4Real4x4ProductL(a3real4p v_out, const a3real4p v, cons
 	v_out[1] = tmp[1];
 	v_out[2] = tmp[2];
 	v_out[3] = tmp[3];
+#endif	// A3_SIMD_MAT4
 	return v_out;
 }
 
 A3_INLINE a3real4r a3real4Real4x4ProductR(a3real4p v_out, const a3real4x4p m, const a3real4p v)
 {
+#ifdef A3_SIMD_MAT4
+	a3real4Real4x4ProductSIMD(v_out, m, v, a3false);
+#else	// !A3_SIMD_MAT4
 	a3real4 tmp;
 #ifndef A3_MAT_ROWMAJOR
 	tmp[0] = m[0][0] * v[0] + m[1][0] * v[1] + m[2][0] * v[2] + m[3][0] * v[3];
@@ -315,9 +590,19 @@ A3_INLINE a3real4r a3real4Real4x4ProductR(a3real4p v_out, const a3real4x4p m, co
 	v_out[1] = tmp[1];
 	v_out[2] = tmp[2];
 	v_out[3] = tmp[3];
+#endif	// A3_SIMD_MAT4
 	return v_out;
 }
 
+A3_INLINE a3real4r a3real4Real4x4ProductRAligned(a3real4p v_out, const a3real4x4p m, const a3real4p v)
+{
+#ifdef A3_SIMD_MAT4
+	return a3real4Real4x4ProductSIMD(v_out, m, v, a3true);
+#else	// !A3_SIMD_MAT4
+	return a3real4Real4x4ProductR(v_out, m, v);
+#endif	// A3_SIMD_MAT4
+}
+
 A3_INLINE a3real4r a3real4Real4x4MulL(a3real4p v_inout, const a3real4x4p m)
 {
 	a3real4 tmp;
@@ -337,6 +622,9 @@ A3_INLINE a3real4r a3real4Real4x4MulR(const a3real4x4p m, a3real4p v_inout)
 
 A3_INLINE a3real4x4r a3real4x4Product(a3real4x4p m_out, const a3real4x4p mL, const a3real4x4p mR)
 {
+#ifdef A3_SIMD_MAT4
+	a3real4x4ProductSIMD(m_out, mL, mR, a3false);
+#else	// !A3_SIMD_MAT4
 #ifndef A3_MAT_ROWMAJOR
 	a3real4Real4x4Product(m_out[0], mL, mR[0]);
 	a3real4Real4x4Product(m_out[1], mL, mR[1]);
@@ -348,9 +636,19 @@ A3_INLINE a3real4x4r a3real4x4Product(a3real4x4p m_out, const a3real4x4p mL, con
 	a3real4Real4x4Product(m_out[2], mR, mL[2]);
 	a3real4Real4x4Product(m_out[3], mR, mL[3]);
 #endif	// !A3_MAT_ROWMAJOR
+#endif	// A3_SIMD_MAT4
 	return m_out;
 }
 
+A3_INLINE a3real4x4r a3real4x4ProductAligned(a3real4x4p m_out, const a3real4x4p mL, const a3real4x4p mR)
+{
+#ifdef A3_SIMD_MAT4
+	return a3real4x4ProductSIMD(m_out, mL, mR, a3true);
+#else	// !A3_SIMD_MAT4
+	return a3real4x4Product(m_out, mL, mR);
+#endif	// A3_SIMD_MAT4
+}
+
 A3_INLINE a3real4x4r a3real4x4ConcatL(a3real4x4p mL_inout, const a3real4x4p mR)
 {
 #ifndef A3_MAT_ROWMAJOR
@@ -583,6 +881,12 @@ A3_INLINE a3real4r a3real4ProductTransform(a3real4p v_out, const a3real4p v, con
 
 A3_INLINE a3real4r a3real4TransformProduct(a3real4p v_out, const a3real4x4p m, const a3real4p v)
 {
+#ifdef A3_SIMD_MAT4
+	// full product, then restore original w
+	const a3real w = v[3];
+	a3real4Real4x4ProductSIMD(v_out, m, v, a3false);
+	v_out[3] = w;
+#else	// !A3_SIMD_MAT4
 #ifndef A3_MAT_ROWMAJOR
 	const a3real x = m[0][0] * v[0] + m[1][0] * v[1] + m[2][0] * v[2] + m[3][0] * v[3];
 	const a3real y = m[0][1] * v[0] + m[1][1] * v[1] + m[2][1] * v[2] + m[3][1] * v[3];
@@ -596,6 +900,7 @@ A3_INLINE a3real4r a3real4TransformProduct(a3real4p v_out, const a3real4x4p m, c
 	v_out[1] = y;
 	v_out[2] = z;
 	v_out[3] = v[3];
+#endif	// A3_SIMD_MAT4
 	return v_out;
 }
 
@@ -657,6 +962,9 @@ A3_INLINE a3real4x4r a3real4x4TransformMul(const a3real4x4p mL, a3real4x4p mR_in
 ///
 A3_INLINE a3real4x4r a3real4x4TransformInverse(a3real4x4p m_out, const a3real4x4p m)
 {
+#ifdef A3_SIMD_MAT4
+	return a3real4x4TransformInverseSIMD(m_out, m, 2);
+#else	// !A3_SIMD_MAT4
 	// divide each part by its own squared length, then transpose
 	// translation part is negated and multiplied by result
 	const a3real sx2 = a3real3LengthSquaredInverse(m[0]);
@@ -674,10 +982,14 @@ A3_INLINE a3real4x4r a3real4x4TransformInverse(a3real4x4p m_out, const a3real4x4
 	m_out[0][3] = m_out[1][3] = m_out[2][3] = a3real_zero;
 	m_out[3][3] = a3real_one;
 	return m_out;
+#endif	// A3_SIMD_MAT4
 }
 
 A3_INLINE a3real4x4r a3real4x4TransformInverseIgnoreScale(a3real4x4p m_out, const a3real4x4p m)
 {
+#ifdef A3_SIMD_MAT4
+	return a3real4x4TransformInverseSIMD(m_out, m, 0);
+#else	// !A3_SIMD_MAT4
 	// similar to above but no scaling
 	m_out[0][0] = m[0][0];			m_out[1][0] = m[0][1];			m_out[2][0] = m[0][2];
 	m_out[0][1] = m[1][0];			m_out[1][1] = m[1][1];			m_out[2][1] = m[1][2];
@@ -690,10 +1002,14 @@ A3_INLINE a3real4x4r a3real4x4TransformInverseIgnoreScale(a3real4x4p m_out, cons
 	m_out[0][3] = m_out[1][3] = m_out[2][3] = a3real_zero;
 	m_out[3][3] = a3real_one;
 	return m_out;
+#endif	// A3_SIMD_MAT4
 }
 
 A3_INLINE a3real4x4r a3real4x4TransformInverseUniformScale(a3real4x4p m_out, const a3real4x4p m)
 {
+#ifdef A3_SIMD_MAT4
+	return a3real4x4TransformInverseSIMD(m_out, m, 1);
+#else	// !A3_SIMD_MAT4
 	// similar but only one scalar
 	const a3real s2 = a3real3LengthSquaredInverse(m[0]);
 
@@ -708,10 +1024,42 @@ A3_INLINE a3real4x4r a3real4x4TransformInverseUniformScale(a3real4x4p m_out, con
 	m_out[0][3] = m_out[1][3] = m_out[2][3] = a3real_zero;
 	m_out[3][3] = a3real_one;
 	return m_out;
+#endif	// A3_SIMD_MAT4
+}
+
+A3_INLINE a3real4x4r a3real4x4TransformInverseAffine(a3real4x4p m_out, const a3real4x4p m)
+{
+#ifdef A3_SIMD_MAT4_INVERSE
+	return a3real4x4TransformInverseAffineSIMD(m_out, m);
+#else	// !A3_SIMD_MAT4_INVERSE
+	// rows of upper 3x3 inverse are cross products of the other two axes 
+	//	divided by the determinant; translation as above
+	a3real3 r0, r1, r2;
+	a3real dInv;
+	a3real3Cross(r0, m[1], m[2]);
+	a3real3Cross(r1, m[2], m[0]);
+	a3real3Cross(r2, m[0], m[1]);
+	dInv = a3recip(a3real3Dot(m[0], r0));
+
+	m_out[0][0] = r0[0] * dInv;		m_out[1][0] = r0[1] * dInv;		m_out[2][0] = r0[2] * dInv;
+	m_out[0][1] = r1[0] * dInv;		m_out[1][1] = r1[1] * dInv;		m_out[2][1] = r1[2] * dInv;
+	m_out[0][2] = r2[0] * dInv;		m_out[1][2] = r2[1] * dInv;		m_out[2][2] = r2[2] * dInv;
+
+	m_out[3][0] = -(m_out[0][0] * m[3][0] + m_out[1][0] * m[3][1] + m_out[2][0] * m[3][2]);
+	m_out[3][1] = -(m_out[0][1] * m[3][0] + m_out[1][1] * m[3][1] + m_out[2][1] * m[3][2]);
+	m_out[3][2] = -(m_out[0][2] * m[3][0] + m_out[1][2] * m[3][1] + m_out[2][2] * m[3][2]);
+
+	m_out[0][3] = m_out[1][3] = m_out[2][3] = a3real_zero;
+	m_out[3][3] = a3real_one;
+	return m_out;
+#endif	// A3_SIMD_MAT4_INVERSE
 }
 
 A3_INLINE a3real4x4r a3real4x4TransformInvert(a3real4x4p m_inout)
 {
+#ifdef A3_SIMD_MAT4
+	return a3real4x4TransformInverseSIMD(m_inout, m_inout, 2);
+#else	// !A3_SIMD_MAT4
 	const a3real sx2 = a3real3LengthSquaredInverse(m_inout[0]);
 	const a3real sy2 = a3real3LengthSquaredInverse(m_inout[1]);
 	const a3real sz2 = a3real3LengthSquaredInverse(m_inout[2]);
@@ -730,10 +1078,14 @@ A3_INLINE a3real4x4r a3real4x4TransformInvert(a3real4x4p m_inout)
 	tmp2[2] = m_inout[0][2] * m_inout[3][0] + m_inout[1][2] * m_inout[3][1] + m_inout[2][2] * m_inout[3][2];
 	a3real3GetNegative(m_inout[3], tmp2);
 	return m_inout;
+#endif	// A3_SIMD_MAT4
 }
 
 A3_INLINE a3real4x4r a3real4x4TransformInvertIgnoreScale(a3real4x4p m_inout)
 {
+#ifdef A3_SIMD_MAT4
+	return a3real4x4TransformInverseSIMD(m_inout, m_inout, 0);
+#else	// !A3_SIMD_MAT4
 	a3real tmp;
 	a3real3 tmp2;
 
@@ -746,10 +1098,14 @@ A3_INLINE a3real4x4r a3real4x4TransformInvertIgnoreScale(a3real4x4p m_inout)
 	tmp2[2] = m_inout[0][2] * m_inout[3][0] + m_inout[1][2] * m_inout[3][1] + m_inout[2][2] * m_inout[3][2];
 	a3real3GetNegative(m_inout[3], tmp2);
 	return m_inout;
+#endif	// A3_SIMD_MAT4
 }
 
 A3_INLINE a3real4x4r a3real4x4TransformInvertUniformScale(a3real4x4p m_inout)
 {
+#ifdef A3_SIMD_MAT4
+	return a3real4x4TransformInverseSIMD(m_inout, m_inout, 1);
+#else	// !A3_SIMD_MAT4
 	const a3real s2 = a3real3LengthSquaredInverse(m_inout[0]);
 	a3real tmp;
 	a3real3 tmp2;
@@ -766,6 +1122,18 @@ A3_INLINE a3real4x4r a3real4x4TransformInvertUniformScale(a3real4x4p m_inout)
 	tmp2[2] = m_inout[0][2] * m_inout[3][0] + m_inout[1][2] * m_inout[3][1] + m_inout[2][2] * m_inout[3][2];
 	a3real3GetNegative(m_inout[3], tmp2);
 	return m_inout;
+#endif	// A3_SIMD_MAT4
+}
+
+A3_INLINE a3real4x4r a3real4x4TransformInvertAffine(a3real4x4p m_inout)
+{
+#ifdef A3_SIMD_MAT4_INVERSE
+	return a3real4x4TransformInverseAffineSIMD(m_inout, m_inout);
+#else	// !A3_SIMD_MAT4_INVERSE
+	a3real4x4 tmp;
+	a3real4x4TransformInverseAffine(tmp, m_inout);
+	return a3real4x4SetReal4x4(m_inout, tmp);
+#endif	// A3_SIMD_MAT4_INVERSE
 }
 
 
@@ -28,6 +28,11 @@
 #define __ANIMAL3D_A3DM_RANDOM_IMPL_INL
 
 
+#include "../a3sqrt.h"
+#include "../a3trig.h"
+#include "../a3simd.h"
+
+
 A3_BEGIN_IMPL
 
 
@@ -39,6 +44,15 @@ A3_GLOBAL a3integer a3_randseed = 1235;
 #define A3_RANDMAX		134456
 #define A3_RANDMAXINV	a3recip(A3_RANDMAX)
 
+// values for counter-based streams: Philox multipliers, key increments 
+//	per round, and scale from the top 24 bits of an integer to [0, 1)
+#define A3_PHILOX_M0		0xD2511F53u
+#define A3_PHILOX_M1		0xCD9E8D57u
+#define A3_PHILOX_W0		0x9E3779B9u
+#define A3_PHILOX_W1		0xBB67AE85u
+#define A3_PHILOX_ROUNDS	10
+#define A3_RANDUNIT			((a3real)5.9604644775390625e-8)
+
 
 //-----------------------------------------------------------------------------
 
@@ -120,9 +134,288 @@ A3_INLINE a3integer a3randomRangeInt(const a3integer nMin, const a3integer nMax)
 }
 
 
+//-----------------------------------------------------------------------------
+
+// Philox rounds: multiply two counter words, mix the products' high halves 
+//	into the other two words with the key, bump the key
+A3_INLINE a3ui32 *a3randomPhilox(a3ui32 values_out[4], const a3ui32 counter[4], const a3ui32 key[2])
+{
+	a3ui32 c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+	a3ui32 k0 = key[0], k1 = key[1];
+	a3ui64 p0, p1;
+	a3index i;
+	for (i = 0; i < A3_PHILOX_ROUNDS; ++i)
+	{
+		p0 = (a3ui64)A3_PHILOX_M0 * (a3ui64)c0;
+		p1 = (a3ui64)A3_PHILOX_M1 * (a3ui64)c2;
+		c0 = (a3ui32)(p1 >> 32) ^ c1 ^ k0;
+		c2 = (a3ui32)(p0 >> 32) ^ c3 ^ k1;
+		c1 = (a3ui32)p1;
+		c3 = (a3ui32)p0;
+		k0 += A3_PHILOX_W0;
+		k1 += A3_PHILOX_W1;
+	}
+	values_out[0] = c0;
+	values_out[1] = c1;
+	values_out[2] = c2;
+	values_out[3] = c3;
+	return values_out;
+}
+
+// stream value n is word (n % 4) of the block whose counter is n / 4
+A3_INLINE a3ui32 *a3randomStreamInternalBlock(a3ui32 values_out[4], const a3ui32 key[2], const a3ui64 block)
+{
+	a3ui32 counter[4];
+	counter[0] = (a3ui32)block;
+	counter[1] = (a3ui32)(block >> 32);
+	counter[2] = counter[3] = 0;
+	return a3randomPhilox(values_out, counter, key);
+}
+
+// natural log for x in (0, 1]: x = m * 2^e with m in [sqrt(1/2), sqrt(2)), 
+//	then ln(m) = 2 atanh(s) for s = (m - 1)/(m + 1), |s| < 0.172, as a series
+A3_INLINE a3real a3randomInternalLog(const a3real x)
+{
+	union { a3f32 f; a3ui32 i; } bits;
+	a3integer e;
+	a3real m, s, z;
+	bits.f = (a3f32)x;
+	e = (a3integer)((bits.i >> 23) & 0xff) - 127;
+	bits.i = (bits.i & 0x007fffff) | 0x3f800000;
+	m = (a3real)bits.f;
+	if (m > a3real_sqrttwo)
+	{
+		m *= a3real_half;
+		++e;
+	}
+	s = (m - a3real_one) / (m + a3real_one);
+	z = s * s;
+	return ((a3real)e * (a3real)0.69314718055994530942 + (s + s) * (a3real_one + z * ((a3real)(1.0 / 3.0) + 
+		z * ((a3real)(1.0 / 5.0) + z * ((a3real)(1.0 / 7.0) + z * (a3real)(1.0 / 9.0))))));
+}
+
+// direction in the xy plane from the next value, as cos and sin
+A3_INLINE void a3randomStreamInternalAzimuth(a3randstream *stream, a3real *c_out, a3real *s_out)
+{
+	a3trigPoly_sinr_cosr(a3randomStreamNext(stream) * a3real_twopi, s_out, c_out);
+}
+
+#if (A3_SIMD != A3_SIMD_SCALAR)
+// four consecutive blocks at once, one register per counter word
+A3_INLINE void a3randomStreamInternalBlock4(a3simd4i c_out[4], const a3ui32 key[2], const a3ui64 block)
+{
+	const a3simd4i m0 = a3simd4iSplat(A3_PHILOX_M0), m1 = a3simd4iSplat(A3_PHILOX_M1);
+	a3ui32 lo[4], hi[4], k0 = key[0], k1 = key[1];
+	a3simd4i c0, c1, c2, c3, hi0, lo0, hi1, lo1;
+	a3index i;
+	for (i = 0; i < 4; ++i)
+	{
+		lo[i] = (a3ui32)(block + i);
+		hi[i] = (a3ui32)((block + i) >> 32);
+	}
+	c0 = a3simd4iLoad(lo);
+	c1 = a3simd4iLoad(hi);
+	c2 = c3 = a3simd4iSplat(0);
+	for (i = 0; i < A3_PHILOX_ROUNDS; ++i)
+	{
+		a3simd4iMulHiLo(c0, m0, hi0, lo0);
+		a3simd4iMulHiLo(c2, m1, hi1, lo1);
+		c0 = a3simd4iXor(a3simd4iXor(hi1, c1), a3simd4iSplat(k0));
+		c2 = a3simd4iXor(a3simd4iXor(hi0, c3), a3simd4iSplat(k1));
+		c1 = lo1;
+		c3 = lo0;
+		k0 += A3_PHILOX_W0;
+		k1 += A3_PHILOX_W1;
+	}
+	c_out[0] = c0;
+	c_out[1] = c1;
+	c_out[2] = c2;
+	c_out[3] = c3;
+}
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+
+// fill integers or reals, whichever output is not null
+A3_INLINE void a3randomStreamInternalFill(a3ui32 *ints_out, a3real *reals_out, const a3randstream *stream, const a3ui64 first, const a3count count)
+{
+	const a3ui64 end = first + count;
+	a3ui64 n = first;
+	a3ui32 block[4];
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	const a3simd4 unit = a3simd4Splat(A3_RANDUNIT);
+	a3simd4i c[4];
+	a3simd4 v0, v1, v2, v3;
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+
+	// values before the first whole block
+	if (n & 3)
+	{
+		a3randomStreamInternalBlock(block, stream->key, n >> 2);
+		for (; (n & 3) && n < end; ++n)
+			if (ints_out)
+				*(ints_out++) = block[n & 3];
+			else
+				*(reals_out++) = (a3real)(block[n & 3] >> 8) * A3_RANDUNIT;
+	}
+
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	// transpose so each register holds one block, in order
+	for (; n + 16 <= end; n += 16)
+	{
+		a3randomStreamInternalBlock4(c, stream->key, n >> 2);
+		if (ints_out)
+		{
+			v0 = a3simd4iAsReal(c[0]);
+			v1 = a3simd4iAsReal(c[1]);
+			v2 = a3simd4iAsReal(c[2]);
+			v3 = a3simd4iAsReal(c[3]);
+			a3simd4Transpose(v0, v1, v2, v3);
+			a3simd4iStore(ints_out, a3simd4AsInt(v0));
+			a3simd4iStore(ints_out + 4, a3simd4AsInt(v1));
+			a3simd4iStore(ints_out + 8, a3simd4AsInt(v2));
+			a3simd4iStore(ints_out + 12, a3simd4AsInt(v3));
+			ints_out += 16;
+		}
+		else
+		{
+			v0 = a3simd4Mul(a3simd4iToReal(a3simd4iShiftRight(c[0], 8)), unit);
+			v1 = a3simd4Mul(a3simd4iToReal(a3simd4iShiftRight(c[1], 8)), unit);
+			v2 = a3simd4Mul(a3simd4iToReal(a3simd4iShiftRight(c[2], 8)), unit);
+			v3 = a3simd4Mul(a3simd4iToReal(a3simd4iShiftRight(c[3], 8)), unit);
+			a3simd4Transpose(v0, v1, v2, v3);
+			a3simd4Store(reals_out, v0);
+			a3simd4Store(reals_out + 4, v1);
+			a3simd4Store(reals_out + 8, v2);
+			a3simd4Store(reals_out + 12, v3);
+			reals_out += 16;
+		}
+	}
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+
+	// remaining blocks, the last possibly partial
+	while (n < end)
+	{
+		a3randomStreamInternalBlock(block, stream->key, n >> 2);
+		do
+		{
+			if (ints_out)
+				*(ints_out++) = block[n & 3];
+			else
+				*(reals_out++) = (a3real)(block[n & 3] >> 8) * A3_RANDUNIT;
+		} while ((++n & 3) && n < end);
+	}
+}
+
+
+A3_INLINE a3randstream *a3randomStreamInit(a3randstream *stream_out, const a3ui32 seed, const a3ui32 streamID)
+{
+	stream_out->key[0] = seed;
+	stream_out->key[1] = streamID;
+	stream_out->block[0] = stream_out->block[1] = stream_out->block[2] = stream_out->block[3] = 0;
+	stream_out->index = 0;
+	return stream_out;
+}
+
+A3_INLINE a3ui64 a3randomStreamGetIndex(const a3randstream *stream)
+{
+	return stream->index;
+}
+
+A3_INLINE a3ui64 a3randomStreamSetIndex(a3randstream *stream, const a3ui64 index)
+{
+	// block is calculated when its first value is drawn, so only a move 
+	//	into the middle of a block needs it now
+	const a3ui64 index_old = stream->index;
+	stream->index = index;
+	if (index & 3)
+		a3randomStreamInternalBlock(stream->block, stream->key, index >> 2);
+	return index_old;
+}
+
+A3_INLINE a3ui32 a3randomStreamNextInt(a3randstream *stream)
+{
+	if (!(stream->index & 3))
+		a3randomStreamInternalBlock(stream->block, stream->key, stream->index >> 2);
+	return stream->block[(stream->index++) & 3];
+}
+
+A3_INLINE a3real a3randomStreamNext(a3randstream *stream)
+{
+	return (a3real)(a3randomStreamNextInt(stream) >> 8) * A3_RANDUNIT;
+}
+
+
+// sampling: each helper uses a fixed number of values, so results only 
+//	depend on stream index
+A3_INLINE a3real a3randomStreamNormal(a3randstream *stream, const a3real mean, const a3real stdDev)
+{
+	// radius from a value in (0, 1] so the log is finite
+	const a3real u = (a3real)((a3randomStreamNextInt(stream) >> 8) + 1) * A3_RANDUNIT;
+	const a3real r = a3sqrt(-a3real_two * a3randomInternalLog(u));
+	a3real c, s;
+	a3randomStreamInternalAzimuth(stream, &c, &s);
+	return (mean + stdDev * r * c);
+}
+
+A3_INLINE a3real2r a3randomStreamDisc(a3real2p p_out, a3randstream *stream)
+{
+	// square root of radius keeps density uniform over area
+	const a3real r = a3sqrt(a3randomStreamNext(stream));
+	a3real c, s;
+	a3randomStreamInternalAzimuth(stream, &c, &s);
+	p_out[0] = r * c;
+	p_out[1] = r * s;
+	return p_out;
+}
+
+A3_INLINE a3real3r a3randomStreamHemisphere(a3real3p v_out, a3randstream *stream)
+{
+	// uniform z gives uniform area on a sphere (Archimedes)
+	const a3real z = a3randomStreamNext(stream);
+	const a3real r = a3sqrt(a3maximum(a3real_one - z * z, a3real_zero));
+	a3real c, s;
+	a3randomStreamInternalAzimuth(stream, &c, &s);
+	v_out[0] = r * c;
+	v_out[1] = r * s;
+	v_out[2] = z;
+	return v_out;
+}
+
+A3_INLINE a3real3r a3randomStreamHemisphereCosine(a3real3p v_out, a3randstream *stream)
+{
+	// uniform disc point lifted onto the hemisphere (Malley's method)
+	const a3real u = a3randomStreamNext(stream);
+	const a3real r = a3sqrt(u);
+	a3real c, s;
+	a3randomStreamInternalAzimuth(stream, &c, &s);
+	v_out[0] = r * c;
+	v_out[1] = r * s;
+	v_out[2] = a3sqrt(a3real_one - u);
+	return v_out;
+}
+
+
+A3_INLINE a3ui32 *a3randomStreamFillInt(a3ui32 *values_out, const a3randstream *stream, const a3ui64 first, const a3count count)
+{
+	a3randomStreamInternalFill(values_out, 0, stream, first, count);
+	return values_out;
+}
+
+A3_INLINE a3real *a3randomStreamFill(a3real *values_out, const a3randstream *stream, const a3ui64 first, const a3count count)
+{
+	a3randomStreamInternalFill(0, values_out, stream, first, count);
+	return values_out;
+}
+
+
 //-----------------------------------------------------------------------------
 
 #undef A3_RANDMAX
+#undef A3_PHILOX_M0
+#undef A3_PHILOX_M1
+#undef A3_PHILOX_W0
+#undef A3_PHILOX_W1
+#undef A3_PHILOX_ROUNDS
+#undef A3_RANDUNIT
 
 
 A3_END_IMPL
@@ -69,6 +69,88 @@ A3_INLINE a3f32 a3sqrtf0xInverse(const a3f32 x)
 }
 
 
+//-----------------------------------------------------------------------------
+
+// precision of fast inverse square roots
+A3_GLOBAL a3index a3_sqrtPrecision = a3sqrtPrecision_medium;
+
+
+A3_INLINE a3index a3sqrtSetPrecision(const a3index precision)
+{
+	const a3index oldPrecision = a3_sqrtPrecision;
+	a3_sqrtPrecision = precision < a3sqrtPrecision_high ? precision : a3sqrtPrecision_high;
+	return oldPrecision;
+}
+
+A3_INLINE a3index a3sqrtGetPrecision()
+{
+	return a3_sqrtPrecision;
+}
+
+
+// smallest normal float; the estimate is infinite below it, since the 
+//	hardware treats denormals as zero, and Quake's method is meaningless
+#define a3sqrtfInternalNormalMin	1.17549435e-38f
+
+// the estimate is zero where x is infinite and infinite where x is zero or 
+//	denormal, so such inputs are masked rather than refined
+#if (A3_SIMD != A3_SIMD_SCALAR)
+A3_INLINE a3simd4 a3sqrtfInverseFast4(const a3simd4 x)
+{
+	a3simd4 y;
+	switch (a3_sqrtPrecision)
+	{
+	case a3sqrtPrecision_low:
+		y = a3simd4SqrtInverseEstimate(x);
+		break;
+	case a3sqrtPrecision_medium:
+		y = a3simd4SqrtInverseEstimate(x);
+		y = a3simd4SqrtInverseStep(y, x);
+		break;
+	default:
+		y = a3simd4Div(a3simd4Splat(1.0f), a3simd4Sqrt(x));
+		break;
+	}
+	return a3simd4And(y, a3simd4Greater(x, a3simd4Splat(a3sqrtfInternalNormalMin)));
+}
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+
+A3_INLINE a3f32 a3sqrtfInverseFast(const a3f32 x)
+{
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	return a3simd4First(a3sqrtfInverseFast4(a3simd4Splat(x)));
+#else	// A3_SIMD_SCALAR
+	a3f32 y;
+	if (x > a3sqrtfInternalNormalMin)
+	{
+		switch (a3_sqrtPrecision)
+		{
+		case a3sqrtPrecision_low:
+			return a3sqrtf0xInverse(x);
+		case a3sqrtPrecision_medium:
+			y = a3sqrtf0xInverse(x);
+			return y * (__a3f32onehalf - __a3f32half*x*y*y);
+		default:
+			return 1.0f / a3sqrtf(x);
+		}
+	}
+	return 0.0f;
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+}
+
+A3_INLINE a3f32 *a3sqrtfInverseFastBatch(a3f32 *x_out, const a3f32 *x, const a3count count)
+{
+	a3count i = 0;
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	for (; i + 4 <= count; i += 4)
+		a3simd4Store(x_out + i, a3sqrtfInverseFast4(a3simd4Load(x + i)));
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+	for (; i < count; ++i)
+		x_out[i] = a3sqrtfInverseFast(x[i]);
+	return x_out;
+}
+
+
 /*
 #if A3_32_BIT
 #define A3_NAKED	__declspec(naked)
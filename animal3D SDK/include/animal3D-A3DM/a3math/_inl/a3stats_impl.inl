@@ -20,7 +20,8 @@
 	By Daniel S. Buckstein
 
 	a3stats_impl.inl
-	Implementations for miscellaneous statistical functions.
+	Implementations for miscellaneous statistical functions, selection and 
+		streaming statistics.
 */
 
 #ifdef __ANIMAL3D_A3DM_STATS_H
@@ -72,7 +73,7 @@ A3_INLINE a3real a3mean(const a3real data[], const a3count n)
 A3_INLINE a3real a3meanInt(const a3integer data[], const a3count n)
 {
 	a3integer sum = 0;
-	a3real sumf;
+	a3real sumf = a3real_zero;
 	if (n > 0)
 	{
 		a3index i;
@@ -94,6 +95,8 @@ A3_INLINE a3real a3variance(const a3real data[], const a3count n, a3real *mean_o
 		dv = data[i] - mean;
 		v += dv*dv;
 	}
+	if (n > 0)
+		v /= (a3real)n;
 	if (mean_out)
 		*mean_out = mean;
 	return v;
@@ -109,6 +112,8 @@ A3_INLINE a3real a3varianceInt(const a3integer data[], const a3count n, a3real *
 		dv = (a3real)data[i] - mean;
 		v += dv*dv;
 	}
+	if (n > 0)
+		v /= (a3real)n;
 	if (mean_out)
 		*mean_out = mean;
 	return v;
@@ -128,6 +133,215 @@ A3_INLINE a3real a3standardDeviationInt(const a3integer data[], const a3count n,
 }
 
 
+//-----------------------------------------------------------------------------
+// selection
+
+A3_INLINE a3index a3statsInternalMedian5(a3real data[], const a3count n)
+{
+	// insertion sort of a group of five or fewer; returns index of middle
+	a3real tmp;
+	a3index i, j;
+	for (i = 1; i < n; ++i)
+		for (j = i; j > 0 && data[j - 1] > data[j]; --j)
+		{
+			tmp = data[j];
+			data[j] = data[j - 1];
+			data[j - 1] = tmp;
+		}
+	return ((n - 1) / 2);
+}
+
+A3_INLINE a3real a3select(a3real data[], const a3count n, const a3index k)
+{
+	a3index lo = 0, hi = n - 1, lt, gt, i, j, m, depth = 0;
+	a3real pivot, tmp, a, b, c;
+	if (k >= n)
+		return a3real_zero;
+
+	// about two quickselect rounds per halving before switching to median 
+	//	of medians, which always discards at least 30% of the range
+	for (m = n; m; m >>= 1)
+		depth += 2;
+	while (lo < hi)
+	{
+		if (depth)
+		{
+			// median of first, middle and last
+			--depth;
+			a = data[lo];
+			b = data[lo + (hi - lo) / 2];
+			c = data[hi];
+			pivot = a3maximum(a3minimum(a, b), a3minimum(a3maximum(a, b), c));
+		}
+		else
+		{
+			// gather medians of groups of five at front and select theirs
+			for (i = lo, m = lo; i <= hi; i += 5, ++m)
+			{
+				j = i + a3statsInternalMedian5(data + i, a3minimum(5, hi + 1 - i));
+				tmp = data[m];
+				data[m] = data[j];
+				data[j] = tmp;
+			}
+			pivot = a3select(data + lo, m - lo, (m - lo) / 2);
+		}
+
+		// three-way partition: [lo, lt) less, [lt, gt] equal, (gt, hi] greater; 
+		//	equal values are never revisited, so repeated values are cheap
+		lt = i = lo;
+		gt = hi;
+		while (i <= gt)
+		{
+			if (data[i] < pivot)
+			{
+				tmp = data[lt];
+				data[lt++] = data[i];
+				data[i++] = tmp;
+			}
+			else if (data[i] > pivot)
+			{
+				tmp = data[gt];
+				data[gt--] = data[i];
+				data[i] = tmp;
+			}
+			else
+				++i;
+		}
+		if (k < lt)
+			hi = lt - 1;
+		else if (k > gt)
+			lo = gt + 1;
+		else
+			return pivot;
+	}
+	return data[k];
+}
+
+A3_INLINE a3index a3statsInternalMedian5Int(a3integer data[], const a3count n)
+{
+	a3integer tmp;
+	a3index i, j;
+	for (i = 1; i < n; ++i)
+		for (j = i; j > 0 && data[j - 1] > data[j]; --j)
+		{
+			tmp = data[j];
+			data[j] = data[j - 1];
+			data[j - 1] = tmp;
+		}
+	return ((n - 1) / 2);
+}
+
+A3_INLINE a3integer a3selectInt(a3integer data[], const a3count n, const a3index k)
+{
+	a3index lo = 0, hi = n - 1, lt, gt, i, j, m, depth = 0;
+	a3integer pivot, tmp, a, b, c;
+	if (k >= n)
+		return 0;
+
+	for (m = n; m; m >>= 1)
+		depth += 2;
+	while (lo < hi)
+	{
+		if (depth)
+		{
+			// median of first, middle and last
+			--depth;
+			a = data[lo];
+			b = data[lo + (hi - lo) / 2];
+			c = data[hi];
+			pivot = a3maximum(a3minimum(a, b), a3minimum(a3maximum(a, b), c));
+		}
+		else
+		{
+			// gather medians of groups of five at front and select theirs
+			for (i = lo, m = lo; i <= hi; i += 5, ++m)
+			{
+				j = i + a3statsInternalMedian5Int(data + i, a3minimum(5, hi + 1 - i));
+				tmp = data[m];
+				data[m] = data[j];
+				data[j] = tmp;
+			}
+			pivot = a3selectInt(data + lo, m - lo, (m - lo) / 2);
+		}
+
+		// three-way partition
+		lt = i = lo;
+		gt = hi;
+		while (i <= gt)
+		{
+			if (data[i] < pivot)
+			{
+				tmp = data[lt];
+				data[lt++] = data[i];
+				data[i++] = tmp;
+			}
+			else if (data[i] > pivot)
+			{
+				tmp = data[gt];
+				data[gt--] = data[i];
+				data[i] = tmp;
+			}
+			else
+				++i;
+		}
+		if (k < lt)
+			hi = lt - 1;
+		else if (k > gt)
+			lo = gt + 1;
+		else
+			return pivot;
+	}
+	return data[k];
+}
+
+
+A3_INLINE a3real a3percentile(a3real data[], const a3count n, const a3real p)
+{
+	a3real r, t, lo, hi;
+	a3index k, i;
+	if (n > 0)
+	{
+		r = a3clamp(a3real_zero, a3real_one, p) * (a3real)(n - 1);
+		k = (a3index)r;
+		t = r - (a3real)k;
+		lo = a3select(data, n, k);
+		if (t > a3real_zero && k + 1 < n)
+		{
+			// next rank is the smallest value after k
+			for (hi = data[k + 1], i = k + 2; i < n; ++i)
+				if (data[i] < hi)
+					hi = data[i];
+			return (lo + t * (hi - lo));
+		}
+		return lo;
+	}
+	return a3real_zero;
+}
+
+A3_INLINE a3real a3percentileInt(a3integer data[], const a3count n, const a3real p)
+{
+	a3real r, t;
+	a3integer lo, hi;
+	a3index k, i;
+	if (n > 0)
+	{
+		r = a3clamp(a3real_zero, a3real_one, p) * (a3real)(n - 1);
+		k = (a3index)r;
+		t = r - (a3real)k;
+		lo = a3selectInt(data, n, k);
+		if (t > a3real_zero && k + 1 < n)
+		{
+			for (hi = data[k + 1], i = k + 2; i < n; ++i)
+				if (data[i] < hi)
+					hi = data[i];
+			return ((a3real)lo + t * (a3real)(hi - lo));
+		}
+		return (a3real)lo;
+	}
+	return a3real_zero;
+}
+
+
 //-----------------------------------------------------------------------------
 // factorial, permutations and combinations
 
@@ -157,6 +371,194 @@ A3_INLINE a3biginteger a3combinations(const a3bigcount n, const a3bigindex k)
 }
 
 
+//-----------------------------------------------------------------------------
+// streaming statistics
+
+A3_INLINE a3statsRunning *a3statsRunningReset(a3statsRunning *stats_out)
+{
+	stats_out->count = 0;
+	stats_out->mean = stats_out->m2 = a3real_zero;
+	stats_out->minimum = stats_out->maximum = a3real_zero;
+	return stats_out;
+}
+
+A3_INLINE a3statsRunning *a3statsRunningAdd(a3statsRunning *stats, const a3real x)
+{
+	// update mean by offset, then sum of squares using offsets from the old 
+	//	and new means, which avoids cancellation of a plain sum of squares
+	const a3real d = x - stats->mean;
+	if (stats->count)
+	{
+		stats->minimum = a3minimum(stats->minimum, x);
+		stats->maximum = a3maximum(stats->maximum, x);
+	}
+	else
+		stats->minimum = stats->maximum = x;
+	++stats->count;
+	stats->mean += d / (a3real)stats->count;
+	stats->m2 += d * (x - stats->mean);
+	return stats;
+}
+
+A3_INLINE a3statsRunning *a3statsRunningMerge(a3statsRunning *stats, const a3statsRunning *other)
+{
+	const a3count count = stats->count + other->count;
+	const a3real d = other->mean - stats->mean;
+	a3real w;
+	if (!other->count)
+		return stats;
+	if (!stats->count)
+	{
+		*stats = *other;
+		return stats;
+	}
+	w = (a3real)other->count / (a3real)count;
+	stats->mean += d * w;
+	stats->m2 += other->m2 + d * d * (a3real)stats->count * w;
+	stats->minimum = a3minimum(stats->minimum, other->minimum);
+	stats->maximum = a3maximum(stats->maximum, other->maximum);
+	stats->count = count;
+	return stats;
+}
+
+A3_INLINE a3real a3statsRunningVariance(const a3statsRunning *stats)
+{
+	if (stats->count)
+		return (stats->m2 / (a3real)stats->count);
+	return a3real_zero;
+}
+
+A3_INLINE a3real a3statsRunningStandardDeviation(const a3statsRunning *stats)
+{
+	return a3sqrt(a3statsRunningVariance(stats));
+}
+
+
+A3_INLINE a3statsAverage *a3statsAverageInit(a3statsAverage *avg_out, const a3real alpha)
+{
+	avg_out->alpha = alpha;
+	avg_out->mean = avg_out->variance = a3real_zero;
+	avg_out->count = 0;
+	return avg_out;
+}
+
+A3_INLINE a3real a3statsAverageAdd(a3statsAverage *avg, const a3real x)
+{
+	a3real d, dMean;
+	if (avg->count++)
+	{
+		d = x - avg->mean;
+		dMean = avg->alpha * d;
+		avg->mean += dMean;
+		avg->variance = (a3real_one - avg->alpha) * (avg->variance + d * dMean);
+	}
+	else
+	{
+		avg->mean = x;
+		avg->variance = a3real_zero;
+	}
+	return avg->mean;
+}
+
+
+// histogram key: exponent and top mantissa bits of a float, which increase 
+//	with positive values; non-positive values go to key zero
+A3_INLINE a3ui32 a3statsInternalHistogramKey(const a3real x)
+{
+	union { a3f32 f; a3ui32 i; } bits;
+	if (x > a3real_zero)
+	{
+		bits.f = (a3f32)x;
+		return (bits.i >> (23 - a3statsHistogram_subBits));
+	}
+	return 0;
+}
+
+A3_INLINE a3statsHistogram *a3statsHistogramInit(a3statsHistogram *hist_out, const a3real lowest)
+{
+	a3index i;
+	for (i = 0; i < a3statsHistogram_bucketCount; ++i)
+		hist_out->bucket[i] = 0;
+	hist_out->base = a3statsInternalHistogramKey(lowest);
+	hist_out->count = 0;
+	hist_out->minimum = hist_out->maximum = a3real_zero;
+	return hist_out;
+}
+
+A3_INLINE a3statsHistogram *a3statsHistogramAdd(a3statsHistogram *hist, const a3real x)
+{
+	const a3ui32 key = a3statsInternalHistogramKey(x);
+	a3ui32 i = key > hist->base ? key - hist->base : 0;
+	if (i >= a3statsHistogram_bucketCount)
+		i = a3statsHistogram_bucketCount - 1;
+	++hist->bucket[i];
+	if (hist->count)
+	{
+		hist->minimum = a3minimum(hist->minimum, x);
+		hist->maximum = a3maximum(hist->maximum, x);
+	}
+	else
+		hist->minimum = hist->maximum = x;
+	++hist->count;
+	return hist;
+}
+
+A3_INLINE a3statsHistogram *a3statsHistogramMerge(a3statsHistogram *hist, const a3statsHistogram *other)
+{
+	a3index i;
+	if (hist->base != other->base)
+		return 0;
+	if (other->count)
+	{
+		for (i = 0; i < a3statsHistogram_bucketCount; ++i)
+			hist->bucket[i] += other->bucket[i];
+		if (hist->count)
+		{
+			hist->minimum = a3minimum(hist->minimum, other->minimum);
+			hist->maximum = a3maximum(hist->maximum, other->maximum);
+		}
+		else
+		{
+			hist->minimum = other->minimum;
+			hist->maximum = other->maximum;
+		}
+		hist->count += other->count;
+	}
+	return hist;
+}
+
+A3_INLINE a3real a3statsHistogramPercentile(const a3statsHistogram *hist, const a3real p)
+{
+	union { a3f32 f; a3ui32 i; } bits;
+	a3count rank, sum;
+	a3index i;
+	a3real r;
+	if (!hist->count)
+		return a3real_zero;
+	if (p <= a3real_zero)
+		return hist->minimum;
+	if (p >= a3real_one)
+		return hist->maximum;
+
+	// rank of sample, rounded up, then bucket holding it
+	r = p * (a3real)hist->count;
+	rank = (a3count)r;
+	if ((a3real)rank < r || !rank)
+		++rank;
+	for (i = 0, sum = 0; i < a3statsHistogram_bucketCount - 1; ++i)
+	{
+		sum += hist->bucket[i];
+		if (sum >= rank)
+			break;
+	}
+
+	// midpoint of bucket: its key followed by a half step of mantissa
+	bits.i = ((hist->base + i) << (23 - a3statsHistogram_subBits)) | (1 << (22 - a3statsHistogram_subBits));
+	r = (a3real)bits.f;
+	return a3clamp(hist->minimum, hist->maximum, r);
+}
+
+
 //-----------------------------------------------------------------------------
 
 
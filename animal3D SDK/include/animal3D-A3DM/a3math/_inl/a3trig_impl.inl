@@ -46,6 +46,54 @@ A3_GLOBAL const a3real *a3_trigCosSampleTablePtr = 0;
 A3_GLOBAL const a3index *a3_asinIndexTable = 0; //[768]
 A3_GLOBAL const a3index *a3_acosIndexTable = 0; //[768]
 
+// values for polynomial trig: minimax coefficients per tier, highest degree 
+//	first and aligned to the end of each row, so a tier with fewer terms 
+//	starts further in; terms per tier are listed for sin, cos, atan, asin
+A3_GLOBAL a3index a3_trigPolyTier = a3trigPoly_medium;
+A3_GLOBAL const a3index a3_trigPolyTerms[3][4] = {
+	{ 1, 2, 4, 2 },
+	{ 2, 3, 7, 3 },
+	{ 3, 4, 8, 5 },
+};
+
+// sin(r) = r + r^3 * P(r^2), |r| <= pi/4
+A3_GLOBAL const a3real a3_trigPolySin[3][3] = {
+	{ (a3real)0, (a3real)0, (a3real)-1.6225912821e-01 },
+	{ (a3real)0, (a3real)+8.1529923418e-03, (a3real)-1.6662833807e-01 },
+	{ (a3real)-1.9495636238e-04, (a3real)+8.3319786632e-03, (a3real)-1.6666650669e-01 },
+};
+
+// cos(r) = 1 + r^2 * P(r^2), |r| <= pi/4
+A3_GLOBAL const a3real a3_trigPolyCos[3][4] = {
+	{ (a3real)0, (a3real)0, (a3real)+4.0488935844e-02, (a3real)-4.9977630708e-01 },
+	{ (a3real)0, (a3real)-1.3597823112e-03, (a3real)+4.1656294578e-02, (a3real)-4.9999894781e-01 },
+	{ (a3real)+2.4390450736e-05, (a3real)-1.3886763795e-03, (a3real)+4.1666623324e-02, (a3real)-4.9999999725e-01 },
+};
+
+// atan(t) = t * P(t^2), 0 <= t <= 1
+A3_GLOBAL const a3real a3_trigPolyAtan[3][8] = {
+	{ (a3real)0, (a3real)0, (a3real)0, (a3real)0, 
+		(a3real)-4.5055345119e-02, (a3real)+1.5667075462e-01, (a3real)-3.2621724611e-01, (a3real)+9.9981047415e-01 },
+	{ (a3real)0, (a3real)+8.0069070057e-03, (a3real)-3.7442996269e-02, (a3real)+8.4354102863e-02, 
+		(a3real)-1.3512176177e-01, (a3real)+1.9887321178e-01, (a3real)-3.3327013348e-01, (a3real)+9.9999941663e-01 },
+	{ (a3real)-4.7804563590e-03, (a3real)+2.4557127574e-02, (a3real)-5.9904719141e-02, (a3real)+9.9427592782e-02, 
+		(a3real)-1.4029419782e-01, (a3real)+1.9971375149e-01, (a3real)-3.3332093513e-01, (a3real)+9.9999991141e-01 },
+};
+
+// asin(s) = s + s^3 * P(s^2), 0 <= s <= 1/2
+A3_GLOBAL const a3real a3_trigPolyAsin[3][5] = {
+	{ (a3real)0, (a3real)0, (a3real)0, (a3real)+9.4376733605e-02, (a3real)+1.6504153100e-01 },
+	{ (a3real)0, (a3real)0, (a3real)+6.4173472553e-02, (a3real)+7.1876688755e-02, (a3real)+1.6680305721e-01 },
+	{ (a3real)+4.2218568108e-02, (a3real)+2.4147600300e-02, (a3real)+4.5477098981e-02, (a3real)+7.4952417694e-02, (a3real)+1.6666753928e-01 },
+};
+
+// range reduction: x = q*(pi/2) + r, with pi/2 split in three parts whose 
+//	leading bits are exact in single precision, so r keeps its precision
+#define a3_trigPolyTwoOverPi	((a3real)0.63661977236758134308)
+#define a3_trigPolyHalfPiHi		((a3real)1.5703125)
+#define a3_trigPolyHalfPiMid	((a3real)4.837512969970703125e-4)
+#define a3_trigPolyHalfPiLo		((a3real)7.54978995489188216e-8)
+
 
 //-----------------------------------------------------------------------------
 
@@ -158,6 +206,8 @@ A3_INLINE a3index a3trigFree()
 		a3_trigParamTablePtr = 0;
 		a3_trigSinSampleTablePtr = 0;
 		a3_trigCosSampleTablePtr = 0;
+		a3_asinIndexTable = 0;
+		a3_acosIndexTable = 0;
 		return 1;
 	}
 	return 0;
@@ -207,8 +257,11 @@ A3_INLINE a3real a3trigValid_atan(a3real x)
 // compute more precise trig functions by using interpolation
 // sin, cos, tan assume input is [0, 360] degrees or [0, 2pi] radians, 
 //	return value in [-1, 1] for sin, cos and (-inf, inf) for tan
+// without tables, each function falls back to its polynomial version
 A3_INLINE a3real a3sind(const a3real x)
 {
+	if (!a3_trigParamTablePtr)
+		return a3sindPoly(x);
 	return a3sampleTableLerpIncrement(
 		a3_trigSinSampleTablePtr, a3_trigParamTablePtr, x, 
 		((a3integer)x + 360)*a3_trigSamplesPerDegree);
@@ -216,6 +269,8 @@ A3_INLINE a3real a3sind(const a3real x)
 
 A3_INLINE a3real a3cosd(const a3real x)
 {
+	if (!a3_trigParamTablePtr)
+		return a3cosdPoly(x);
 	return a3sampleTableLerpIncrement(
 		a3_trigCosSampleTablePtr, a3_trigParamTablePtr, x, 
 		((a3integer)x + 360)*a3_trigSamplesPerDegree);
@@ -224,16 +279,19 @@ A3_INLINE a3real a3cosd(const a3real x)
 A3_INLINE a3real a3tand(const a3real x)
 {
 	// tan = sin / cos
-	a3real t;
-	a3index i = a3sampleTableLerpIncrementIndex(
+	a3real t, n0s, n0c, n1s, n1c, s, c;
+	a3index i;
+	if (!a3_trigParamTablePtr)
+		return a3tandPoly(x);
+	i = a3sampleTableLerpIncrementIndex(
 		a3_trigParamTablePtr, x, 
 		((a3integer)x + 360)*a3_trigSamplesPerDegree, &t);
-	const a3real n1s = *(a3_trigSinSampleTablePtr + i);
-	const a3real n1c = *(a3_trigCosSampleTablePtr + i);
-	const a3real n0s = *(a3_trigSinSampleTablePtr + --i);
-	const a3real n0c = *(a3_trigCosSampleTablePtr + i);
-	const a3real s = a3lerp(n0s, n1s, t);
-	const a3real c = a3lerp(n0c, n1c, t);
+	n1s = *(a3_trigSinSampleTablePtr + i);
+	n1c = *(a3_trigCosSampleTablePtr + i);
+	n0s = *(a3_trigSinSampleTablePtr + --i);
+	n0c = *(a3_trigCosSampleTablePtr + i);
+	s = a3lerp(n0s, n1s, t);
+	c = a3lerp(n0c, n1c, t);
 	return (s / c);
 }
 
@@ -259,6 +317,8 @@ A3_INLINE a3real a3tanr(const a3real x)
 // arctan assumes input is (-inf, inf) and returns (-90, 90) degrees or (-pi/4, pi/4) radians
 A3_INLINE a3real a3asind(const a3real x)
 {
+	if (!a3_trigParamTablePtr)
+		return a3asindPoly(x);
 	return +a3sampleTableLerpIncrement(
 		a3_trigParamTablePtr, a3_trigSinSampleTablePtr, x, 
 		*(a3_asinIndexTable + 360 + (a3integer)(x*a3real_threesixty)));
@@ -266,6 +326,8 @@ A3_INLINE a3real a3asind(const a3real x)
 
 A3_INLINE a3real a3acosd(const a3real x)
 {
+	if (!a3_trigParamTablePtr)
+		return a3acosdPoly(x);
 	return -a3sampleTableLerpIncrement(
 		a3_trigParamTablePtr, a3_trigCosSampleTablePtr, x,
 		*(a3_acosIndexTable + 360 + (a3integer)(x*a3real_threesixty)));
@@ -273,7 +335,10 @@ A3_INLINE a3real a3acosd(const a3real x)
 
 A3_INLINE a3real a3atand(const a3real x)
 {
-	const a3real xx = a3sqrtInverse(x*x + a3real_one);
+	a3real xx;
+	if (!a3_trigParamTablePtr)
+		return a3atandPoly(x);
+	xx = a3sqrtInverse(x*x + a3real_one);
 
 	// atan as a function of acos: 
 	// atan = acos(1 / sqrt(x^2 + 1))
@@ -307,6 +372,8 @@ A3_INLINE a3real a3atanr(const a3real x)
 // cotangent (cot) is (1 / tan) or (cos / sin)
 A3_INLINE a3real a3cscd(const a3real x)
 {
+	if (!a3_trigParamTablePtr)
+		return a3recip(a3sindPoly(x));
 	return a3real_one / a3sampleTableLerpIncrement(
 		a3_trigSinSampleTablePtr, a3_trigParamTablePtr, x,
 		((a3integer)x + 360)*a3_trigSamplesPerDegree);
@@ -314,6 +381,8 @@ A3_INLINE a3real a3cscd(const a3real x)
 
 A3_INLINE a3real a3secd(const a3real x)
 {
+	if (!a3_trigParamTablePtr)
+		return a3recip(a3cosdPoly(x));
 	return a3real_one / a3sampleTableLerpIncrement(
 		a3_trigCosSampleTablePtr, a3_trigParamTablePtr, x,
 		((a3integer)x + 360)*a3_trigSamplesPerDegree);
@@ -322,16 +391,22 @@ A3_INLINE a3real a3secd(const a3real x)
 A3_INLINE a3real a3cotd(const a3real x)
 {
 	// cot = cos / sin
-	a3real t;
-	a3index i = a3sampleTableLerpIncrementIndex(
+	a3real t, n0s, n0c, n1s, n1c, s, c;
+	a3index i;
+	if (!a3_trigParamTablePtr)
+	{
+		a3trigPoly_sind_cosd(x, &s, &c);
+		return (c / s);
+	}
+	i = a3sampleTableLerpIncrementIndex(
 		a3_trigParamTablePtr, x,
 		((a3integer)x + 360)*a3_trigSamplesPerDegree, &t);
-	const a3real n1s = *(a3_trigSinSampleTablePtr + i);
-	const a3real n1c = *(a3_trigCosSampleTablePtr + i);
-	const a3real n0s = *(a3_trigSinSampleTablePtr + --i);
-	const a3real n0c = *(a3_trigCosSampleTablePtr + i);
-	const a3real s = a3lerp(n0s, n1s, t);
-	const a3real c = a3lerp(n0c, n1c, t);
+	n1s = *(a3_trigSinSampleTablePtr + i);
+	n1c = *(a3_trigCosSampleTablePtr + i);
+	n0s = *(a3_trigSinSampleTablePtr + --i);
+	n0c = *(a3_trigCosSampleTablePtr + i);
+	s = a3lerp(n0s, n1s, t);
+	c = a3lerp(n0c, n1c, t);
 	return (c / s);
 }
 
@@ -566,6 +641,237 @@ A3_INLINE a3real a3trigTaylor_sind_cosd(const a3real x, a3real *sin_out, a3real
 }
 
 
+//-----------------------------------------------------------------------------
+
+// perform trig functions using minimax polynomials: reduce the input to a 
+//	short interval where a few terms are enough, evaluate, then undo the 
+//	reduction with identities; no tables and no iteration count
+A3_INLINE a3index a3trigSetPolyTier(const a3index tier)
+{
+	const a3index oldTier = a3_trigPolyTier;
+	a3_trigPolyTier = tier < a3trigPoly_high ? tier : a3trigPoly_high;
+	return oldTier;
+}
+
+A3_INLINE a3index a3trigGetPolyTier()
+{
+	return a3_trigPolyTier;
+}
+
+
+// evaluate polynomial in z from coefficients, highest degree first
+A3_INLINE a3real a3trigPolyInternalHorner(const a3real z, const a3real *c, a3index n)
+{
+	a3real p = *(c++);
+	while (--n)
+		p = p * z + *(c++);
+	return p;
+}
+
+// sin(r) and cos(r) for |r| <= pi/4, given z = r^2
+A3_INLINE a3real a3trigPolyInternalSin(const a3real r, const a3real z, const a3index tier)
+{
+	const a3index n = a3_trigPolyTerms[tier][0];
+	return (r + r * z * a3trigPolyInternalHorner(z, a3_trigPolySin[tier] + 3 - n, n));
+}
+
+A3_INLINE a3real a3trigPolyInternalCos(const a3real z, const a3index tier)
+{
+	const a3index n = a3_trigPolyTerms[tier][1];
+	return (a3real_one + z * a3trigPolyInternalHorner(z, a3_trigPolyCos[tier] + 4 - n, n));
+}
+
+// atan(t) for 0 <= t <= 1
+A3_INLINE a3real a3trigPolyInternalAtan(const a3real t, const a3index tier)
+{
+	const a3index n = a3_trigPolyTerms[tier][2];
+	return (t * a3trigPolyInternalHorner(t * t, a3_trigPolyAtan[tier] + 8 - n, n));
+}
+
+// asin(s) for 0 <= s <= 1/2, given z = s^2
+A3_INLINE a3real a3trigPolyInternalAsin(const a3real s, const a3real z, const a3index tier)
+{
+	const a3index n = a3_trigPolyTerms[tier][3];
+	return (s + s * z * a3trigPolyInternalHorner(z, a3_trigPolyAsin[tier] + 5 - n, n));
+}
+
+// reduce x to r in [-pi/4, pi/4] and return quadrant q, x = q*(pi/2) + r; 
+//	bit 0 of q swaps sin and cos, bit 1 negates sin, bit 1 of q+1 negates cos
+A3_INLINE a3integer a3trigPolyInternalReduce(const a3real x, a3real *r_out)
+{
+	const a3real t = x * a3_trigPolyTwoOverPi;
+	const a3integer q = (a3integer)(t >= a3real_zero ? t + a3real_half : t - a3real_half);
+	const a3real qr = (a3real)q;
+	*r_out = x - qr * a3_trigPolyHalfPiHi - qr * a3_trigPolyHalfPiMid - qr * a3_trigPolyHalfPiLo;
+	return q;
+}
+
+// asin(a) for 0 <= a <= 1: beyond 1/2, use asin(a) = pi/2 - 2 asin(s), 
+//	where s = sqrt((1 - a)/2), which keeps the polynomial on [0, 1/2]; 
+//	returns the polynomial part so acos can use it without subtracting
+A3_INLINE a3real a3trigPolyInternalAsinHalf(const a3real a, a3boolean *big_out, const a3index tier)
+{
+	a3real z, s;
+	*big_out = (a > a3real_half);
+	if (*big_out)
+	{
+		z = (a3real_one - a) * a3real_half;
+		s = a3sqrt(z);
+	}
+	else
+	{
+		z = a * a;
+		s = a;
+	}
+	return a3trigPolyInternalAsin(s, z, tier);
+}
+
+
+A3_INLINE a3real a3sinrPoly(const a3real x)
+{
+	const a3index tier = a3_trigPolyTier;
+	a3real r, z, v;
+	const a3integer q = a3trigPolyInternalReduce(x, &r);
+	z = r * r;
+	v = (q & 1) ? a3trigPolyInternalCos(z, tier) : a3trigPolyInternalSin(r, z, tier);
+	return ((q & 2) ? -v : v);
+}
+
+A3_INLINE a3real a3cosrPoly(const a3real x)
+{
+	const a3index tier = a3_trigPolyTier;
+	a3real r, z, v;
+	const a3integer q = a3trigPolyInternalReduce(x, &r);
+	z = r * r;
+	v = (q & 1) ? a3trigPolyInternalSin(r, z, tier) : a3trigPolyInternalCos(z, tier);
+	return (((q + 1) & 2) ? -v : v);
+}
+
+A3_INLINE a3real a3tanrPoly(const a3real x)
+{
+	// tan = sin / cos
+	a3real s[1], c[1];
+	a3trigPoly_sinr_cosr(x, s, c);
+	return (*s / *c);
+}
+
+A3_INLINE a3real a3sindPoly(const a3real x)
+{
+	return a3sinrPoly(x * a3real_deg2rad);
+}
+
+A3_INLINE a3real a3cosdPoly(const a3real x)
+{
+	return a3cosrPoly(x * a3real_deg2rad);
+}
+
+A3_INLINE a3real a3tandPoly(const a3real x)
+{
+	return a3tanrPoly(x * a3real_deg2rad);
+}
+
+
+// calculate sin and cos at the same time
+A3_INLINE a3real a3trigPoly_sinr_cosr(const a3real x, a3real *sin_out, a3real *cos_out)
+{
+	const a3index tier = a3_trigPolyTier;
+	a3real r, z, s, c;
+	const a3integer q = a3trigPolyInternalReduce(x, &r);
+	z = r * r;
+	s = a3trigPolyInternalSin(r, z, tier);
+	c = a3trigPolyInternalCos(z, tier);
+	if (q & 1)
+	{
+		r = s;
+		s = c;
+		c = r;
+	}
+
+	// copy results to outputs
+	*sin_out = (q & 2) ? -s : s;
+	*cos_out = ((q + 1) & 2) ? -c : c;
+
+	// done, return param for reuse
+	return x;
+}
+
+A3_INLINE a3real a3trigPoly_sind_cosd(const a3real x, a3real *sin_out, a3real *cos_out)
+{
+	a3trigPoly_sinr_cosr((x * a3real_deg2rad), sin_out, cos_out);
+	return x;
+}
+
+
+// inverse functions work on magnitude and restore sign at the end
+A3_INLINE a3real a3asinrPoly(const a3real x)
+{
+	const a3real a = a3minimum(a3absolute(x), a3real_one);
+	a3boolean big;
+	a3real r = a3trigPolyInternalAsinHalf(a, &big, a3_trigPolyTier);
+	if (big)
+		r = a3real_halfpi - (r + r);
+	return (x < a3real_zero ? -r : r);
+}
+
+A3_INLINE a3real a3acosrPoly(const a3real x)
+{
+	// near +1 and -1, acos is 2 asin(s) and pi - 2 asin(s); in between, 
+	//	pi/2 - asin(x) loses nothing
+	const a3real a = a3minimum(a3absolute(x), a3real_one);
+	a3boolean big;
+	const a3real r = a3trigPolyInternalAsinHalf(a, &big, a3_trigPolyTier);
+	if (big)
+		return (x < a3real_zero ? a3real_pi - (r + r) : (r + r));
+	return (x < a3real_zero ? a3real_halfpi + r : a3real_halfpi - r);
+}
+
+A3_INLINE a3real a3atanrPoly(const a3real x)
+{
+	// beyond 1, atan(a) = pi/2 - atan(1/a)
+	const a3real a = a3absolute(x);
+	a3real r;
+	if (a > a3real_one)
+		r = a3real_halfpi - a3trigPolyInternalAtan(a3recip(a), a3_trigPolyTier);
+	else
+		r = a3trigPolyInternalAtan(a, a3_trigPolyTier);
+	return (x < a3real_zero ? -r : r);
+}
+
+A3_INLINE a3real a3atan2rPoly(const a3real y, const a3real x)
+{
+	// take atan of the smaller magnitude over the larger, then reflect 
+	//	across the diagonal, the y axis and the x axis as needed
+	const a3real ax = a3absolute(x), ay = a3absolute(y);
+	const a3real mn = a3minimum(ax, ay), mx = a3maximum(ax, ay);
+	a3real r = a3trigPolyInternalAtan(a3divide(mn, mx), a3_trigPolyTier);
+	if (ay > ax)
+		r = a3real_halfpi - r;
+	if (x < a3real_zero)
+		r = a3real_pi - r;
+	return (y < a3real_zero ? -r : r);
+}
+
+A3_INLINE a3real a3asindPoly(const a3real x)
+{
+	return a3asinrPoly(x) * a3real_rad2deg;
+}
+
+A3_INLINE a3real a3acosdPoly(const a3real x)
+{
+	return a3acosrPoly(x) * a3real_rad2deg;
+}
+
+A3_INLINE a3real a3atandPoly(const a3real x)
+{
+	return a3atanrPoly(x) * a3real_rad2deg;
+}
+
+A3_INLINE a3real a3atan2dPoly(const a3real y, const a3real x)
+{
+	return a3atan2rPoly(y, x) * a3real_rad2deg;
+}
+
+
 //-----------------------------------------------------------------------------
 // other trig-related operations
 
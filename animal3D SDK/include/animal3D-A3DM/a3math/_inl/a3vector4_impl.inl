@@ -199,7 +199,11 @@ A3_INLINE a3real4r a3real4Negate(a3real4p v_inout)
 ///
 A3_INLINE a3real a3real4Dot(const a3real4p vL, const a3real4p vR)
 {
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	const a3real d = a3simd4Dot(a3simd4Load(vL), a3simd4Load(vR));
+#else	// A3_SIMD_SCALAR
 	const a3real d = vL[0] * vR[0] + vL[1] * vR[1] + vL[2] * vR[2] + vL[3] * vR[3];
+#endif	// A3_SIMD
 	return d;
 }
 
@@ -249,28 +253,40 @@ A3_INLINE a3real4r a3real4ProjGetRatio(a3real4p v_inout, const a3real4p vBase, a
 
 A3_INLINE a3real4r a3real4Sum(a3real4p v_out, const a3real4p vL, const a3real4p vR)
 {
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	a3simd4Store(v_out, a3simd4Add(a3simd4Load(vL), a3simd4Load(vR)));
+#else	// A3_SIMD_SCALAR
 	v_out[0] = vL[0] + vR[0];
 	v_out[1] = vL[1] + vR[1];
 	v_out[2] = vL[2] + vR[2];
 	v_out[3] = vL[3] + vR[3];
+#endif	// A3_SIMD
 	return v_out;
 }
 
 A3_INLINE a3real4r a3real4Diff(a3real4p v_out, const a3real4p vL, const a3real4p vR)
 {
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	a3simd4Store(v_out, a3simd4Sub(a3simd4Load(vL), a3simd4Load(vR)));
+#else	// A3_SIMD_SCALAR
 	v_out[0] = vL[0] - vR[0];
 	v_out[1] = vL[1] - vR[1];
 	v_out[2] = vL[2] - vR[2];
 	v_out[3] = vL[3] - vR[3];
+#endif	// A3_SIMD
 	return v_out;
 }
 
 A3_INLINE a3real4r a3real4ProductS(a3real4p v_out, const a3real4p v, const a3real s)
 {
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	a3simd4Store(v_out, a3simd4Mul(a3simd4Load(v), a3simd4Splat(s)));
+#else	// A3_SIMD_SCALAR
 	v_out[0] = v[0] * s;
 	v_out[1] = v[1] * s;
 	v_out[2] = v[2] * s;
 	v_out[3] = v[3] * s;
+#endif	// A3_SIMD
 	return v_out;
 }
 
@@ -304,28 +320,40 @@ A3_INLINE a3real4r a3real4QuotientComp(a3real4p v_out, const a3real4p vL, const
 
 A3_INLINE a3real4r a3real4Add(a3real4p vL_inout, const a3real4p vR)
 {
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	a3simd4Store(vL_inout, a3simd4Add(a3simd4Load(vL_inout), a3simd4Load(vR)));
+#else	// A3_SIMD_SCALAR
 	vL_inout[0] += vR[0];
 	vL_inout[1] += vR[1];
 	vL_inout[2] += vR[2];
 	vL_inout[3] += vR[3];
+#endif	// A3_SIMD
 	return vL_inout;
 }
 
 A3_INLINE a3real4r a3real4Sub(a3real4p vL_inout, const a3real4p vR)
 {
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	a3simd4Store(vL_inout, a3simd4Sub(a3simd4Load(vL_inout), a3simd4Load(vR)));
+#else	// A3_SIMD_SCALAR
 	vL_inout[0] -= vR[0];
 	vL_inout[1] -= vR[1];
 	vL_inout[2] -= vR[2];
 	vL_inout[3] -= vR[3];
+#endif	// A3_SIMD
 	return vL_inout;
 }
 
 A3_INLINE a3real4r a3real4MulS(a3real4p v_inout, const a3real s)
 {
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	a3simd4Store(v_inout, a3simd4Mul(a3simd4Load(v_inout), a3simd4Splat(s)));
+#else	// A3_SIMD_SCALAR
 	v_inout[0] *= s;
 	v_inout[1] *= s;
 	v_inout[2] *= s;
 	v_inout[3] *= s;
+#endif	// A3_SIMD
 	return v_inout;
 }
 
@@ -362,10 +390,15 @@ A3_INLINE a3real4r a3real4DivComp(a3real4p vL_inout, const a3real4p vR)
 ///
 A3_INLINE a3real4r a3real4Lerp(a3real4p v_out, const a3real4p v0, const a3real4p v1, const a3real param)
 {
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	const a3simd4 s0 = a3simd4Load(v0);
+	a3simd4Store(v_out, a3simd4MulAdd(a3simd4Sub(a3simd4Load(v1), s0), a3simd4Splat(param), s0));
+#else	// A3_SIMD_SCALAR
 	v_out[0] = a3lerp(v0[0], v1[0], param);
 	v_out[1] = a3lerp(v0[1], v1[1], param);
 	v_out[2] = a3lerp(v0[2], v1[2], param);
 	v_out[3] = a3lerp(v0[3], v1[3], param);
+#endif	// A3_SIMD
 	return v_out;
 }
 
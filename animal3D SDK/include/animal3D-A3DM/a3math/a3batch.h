@@ -0,0 +1,184 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3batch.h
+	Declarations for batch vector, matrix, quaternion and trig functions, 
+		which apply one operation to whole arrays of items.
+*/
+
+#ifndef __ANIMAL3D_A3DM_BATCH_H
+#define __ANIMAL3D_A3DM_BATCH_H
+
+
+#include "a3vector.h"
+#include "a3matrix.h"
+#include "a3quaternion.h"
+#include "a3trig.h"
+
+
+A3_BEGIN_DECL
+
+
+//-----------------------------------------------------------------------------
+// A3: Batch functions: each reads and writes only items [0, count) of its
+//		arrays and keeps no state, so a large batch may be split into
+//		contiguous ranges processed by separate threads. SIMD builds (see
+//		'a3simd.h') work on four items per iteration, transposed to one
+//		register per component where that saves work; any remainder uses
+//		plain code. Output arrays may be the same as input arrays, but must
+//		not partially overlap them.
+
+// A3: Calculate matrix products of pairs: m_out[i] = mL[i] * mR[i].
+//	param m_out: array of products
+//	param mL: array of left matrices
+//	param mR: array of right matrices
+//	param count: number of items
+//	return: m_out
+A3_INLINE a3mat4 *a3real4x4ProductBatch(a3mat4 *m_out, const a3mat4 *mL, const a3mat4 *mR, const a3count count);
+
+// A3: Calculate matrix products with one left matrix: m_out[i] = mL * mR[i].
+//	param m_out: array of products
+//	param mL: left matrix shared by all products
+//	param mR: array of right matrices
+//	param count: number of items
+//	return: m_out
+A3_INLINE a3mat4 *a3real4x4ProductBatchSharedL(a3mat4 *m_out, const a3real4x4p mL, const a3mat4 *mR, const a3count count);
+
+// A3: Transform vectors by one matrix: v_out[i] = m * v[i].
+//	param v_out: array of transformed vectors
+//	param m: matrix by which to transform vectors
+//	param v: array of input vectors
+//	param count: number of items
+//	return: v_out
+A3_INLINE a3vec4 *a3real4Real4x4ProductBatch(a3vec4 *v_out, const a3real4x4p m, const a3vec4 *v, const a3count count);
+
+// A3: Transform points by one matrix as if their w were 1:
+//		p_out[i] = (m * (p[i], 1)).xyz.
+//	param p_out: array of transformed points
+//	param m: affine matrix by which to transform points
+//	param p: array of input points
+//	param count: number of items
+//	return: p_out
+A3_INLINE a3vec3 *a3real3Real4x4TransformPointBatch(a3vec3 *p_out, const a3real4x4p m, const a3vec3 *p, const a3count count);
+
+// A3: Calculate inverses of affine transforms whose axes are orthogonal
+//		(rotation, scale per axis and translation); batch equivalent of
+//		'a3real4x4TransformInverse'.
+//	param m_out: array of inverse transforms
+//	param m: array of input transforms
+//	param count: number of items
+//	return: m_out
+A3_INLINE a3mat4 *a3real4x4TransformInverseBatch(a3mat4 *m_out, const a3mat4 *m, const a3count count);
+
+// A3: Get unit-length vectors; zero-length vectors stay zero.
+//	param v_out: array of unit vectors
+//	param v: array of input vectors
+//	param count: number of items
+//	return: v_out
+A3_INLINE a3vec3 *a3real3GetUnitBatch(a3vec3 *v_out, const a3vec3 *v, const a3count count);
+A3_INLINE a3vec4 *a3real4GetUnitBatch(a3vec4 *v_out, const a3vec4 *v, const a3count count);
+
+// A3: Normalize vectors in place with fast inverse square roots at the 
+//		current precision (see 'a3sqrtSetPrecision'); zero-length vectors 
+//		stay zero, as do vectors whose squared length is denormal.
+//	param v_inout: array of vectors to normalize
+//	param count: number of items
+//	return: v_inout
+A3_INLINE a3vec3 *a3real3NormalizeBatch(a3vec3 *v_inout, const a3count count);
+A3_INLINE a3vec4 *a3real4NormalizeBatch(a3vec4 *v_inout, const a3count count);
+
+
+// A3: Convert rotations, translations and optional scales to transforms:
+//		m_out[i] = T(translate[i]) * R(q[i]) * S(scale[i]); batch equivalent 
+//		of 'a3quatConvertToMat4Translate' followed by scaling each axis, so 
+//		no trig is involved.
+//	param m_out: array of transforms
+//	param q: array of unit rotation quaternions
+//	param translate: array of translations
+//	param scale: array of scales per axis; null if not scaling
+//	param count: number of items
+//	return: m_out
+A3_INLINE a3mat4 *a3quatConvertToMat4TRSBatch(a3mat4 *m_out, const a3quat *q, const a3vec3 *translate, const a3vec3 *scale, const a3count count);
+
+// A3: Spherical linear interpolation of unit quaternions along the shorter 
+//		arc: q_out[i] = slerp(q0[i], q1[i], param[i]); uses the polynomials 
+//		of the current tier (see 'a3trigSetPolyTier') and normalized lerp 
+//		where inputs are nearly parallel; results are renormalized.
+//	param q_out: array of interpolated quaternions
+//	param q0: array of initial quaternions, result when t=0
+//	param q1: array of goal/end quaternions, result when t=1
+//	param param: array of interpolation parameters (t) in [0, 1]
+//	param count: number of items
+//	return: q_out
+A3_INLINE a3quat *a3quatSlerpBatch(a3quat *q_out, const a3quat *q0, const a3quat *q1, const a3real *param, const a3count count);
+
+// A3: Normalized linear interpolation of unit quaternions along the shorter 
+//		arc: q_out[i] = unit(lerp(q0[i], q1[i], param[i])); cheaper than 
+//		slerp and matches it at both ends and halfway, but angular speed 
+//		is not constant.
+//	param q_out: array of interpolated quaternions
+//	param q0: array of initial quaternions, result when t=0
+//	param q1: array of goal/end quaternions, result when t=1
+//	param param: array of interpolation parameters (t)
+//	param count: number of items
+//	return: q_out
+A3_INLINE a3quat *a3quatNlerpBatch(a3quat *q_out, const a3quat *q0, const a3quat *q1, const a3real *param, const a3count count);
+
+
+// A3: Calculate sine and cosine of angles in radians using the polynomials 
+//		of 'a3trigPoly_sinr_cosr' at the current tier (see 'a3trigSetPolyTier').
+//	param sin_out: array of sines
+//	param cos_out: array of cosines
+//	param x: array of angles in radians
+//	param count: number of items
+//	return: sin_out
+A3_INLINE a3real *a3realSinCosBatch(a3real *sin_out, a3real *cos_out, const a3real *x, const a3count count);
+
+// A3: Calculate inverse sines or cosines in radians using the polynomials 
+//		of 'a3asinrPoly' and 'a3acosrPoly'; inputs are clamped to [-1, +1].
+//	param a_out: array of angles in radians
+//	param x: array of inputs
+//	param count: number of items
+//	return: a_out
+A3_INLINE a3real *a3realAsinBatch(a3real *a_out, const a3real *x, const a3count count);
+A3_INLINE a3real *a3realAcosBatch(a3real *a_out, const a3real *x, const a3count count);
+
+// A3: Calculate inverse tangents of y/x in radians, range [-pi, +pi], using 
+//		the polynomials of 'a3atan2rPoly'.
+//	param a_out: array of angles in radians
+//	param y: array of numerators
+//	param x: array of denominators
+//	param count: number of items
+//	return: a_out
+A3_INLINE a3real *a3realAtan2Batch(a3real *a_out, const a3real *y, const a3real *x, const a3count count);
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_DECL
+
+
+#ifdef A3_OPEN_SOURCE
+#include "_inl/a3batch_impl.inl"
+#endif	// A3_OPEN_SOURCE
+
+#endif	// !__ANIMAL3D_A3DM_BATCH_H
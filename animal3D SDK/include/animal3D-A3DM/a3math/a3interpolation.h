@@ -465,6 +465,141 @@ A3_INLINE a3index a3sampleTableGenerateArcLength(a3real sampleTable_out[], a3rea
 A3_INLINE a3index a3sampleTableGenerateNumSamplesRequired(const a3index numDivisions, const a3count numSubdivisions);
 
 
+// A3: Find index of parameter in table by bisection instead of stepping, 
+//		O(log n); assumes that parameter values increase as index increases; 
+//		parameters outside the table are clamped to its first or last 
+//		interval; index returned is that of 'n1', index-1 is 'n0'.
+//	param paramTable: array of interpolation parameters or other set of input 
+//		values to search (e.g. arc length)
+//	param numSamples: number of elements in table, at least 2
+//	param param: reference interpolation parameter (t) or other input value to 
+//		search for in paramTable
+//	param param_out: optional pointer to value to capture interpolation param, 
+//		in [0, 1]
+//	return: index of goal/end value in table; zero if invalid params
+A3_INLINE a3index a3sampleTableSearchIndex(const a3real paramTable[], const a3count numSamples, const a3real param, a3real *param_out);
+
+// A3: Find index of parameter in table by bisection and approximate value by 
+//		interpolating surrounding samples in table; see above.
+//	param valueTable: array of values acquired using sampling function 
+//	param paramTable: array of increasing parameters matched to values
+//	param numSamples: number of elements in tables, at least 2
+//	param param: reference interpolation parameter (t) or other input value to 
+//		search for or approximate in paramTable
+//	return: approximated value interpolated at t in table
+A3_INLINE a3real a3sampleTableLerpSearch(const a3real valueTable[], const a3real paramTable[], const a3count numSamples, const a3real param);
+
+// A3: Resample a table with increasing parameters into a table of values at 
+//		evenly spaced parameters from first to last tabled parameter, so that 
+//		lookups need no search (see below); e.g. resample the params of an 
+//		arc length table, indexed by arc length, to reparameterize a curve 
+//		by arc length.
+//	param uniformTable_out: array of resampled values; should have 
+//		(numUniformDivisions + 1) elements allocated
+//	param numUniformDivisions: number of evenly spaced intervals
+//	param valueTable: array of values to resample
+//	param paramTable: array of increasing parameters matched to values
+//	param numSamples: number of elements in tables, at least 2
+//	return: number of resampled values (numUniformDivisions + 1); zero if 
+//		invalid params
+A3_INLINE a3index a3sampleTableResampleUniform(a3real uniformTable_out[], const a3count numUniformDivisions, const a3real valueTable[], const a3real paramTable[], const a3count numSamples);
+
+// A3: Approximate value in a uniform table by interpolating the samples 
+//		surrounding the parameter, O(1); parameters outside [paramMin, 
+//		paramMax] are clamped.
+//	param uniformTable: array of values at evenly spaced parameters
+//	param numUniformDivisions: number of intervals in table
+//	param paramMin: parameter of first value
+//	param paramMax: parameter of last value (not equal to paramMin)
+//	param param: reference interpolation parameter (t) or other input value
+//	return: approximated value interpolated at param in table
+A3_INLINE a3real a3sampleTableLerpUniform(const a3real uniformTable[], const a3count numUniformDivisions, const a3real paramMin, const a3real paramMax, const a3real param);
+
+// A3: Approximate values in a uniform table at many parameters; see above.
+//	param value_out: array of approximated values
+//	param uniformTable: array of values at evenly spaced parameters
+//	param numUniformDivisions: number of intervals in table
+//	param paramMin: parameter of first value
+//	param paramMax: parameter of last value (not equal to paramMin)
+//	param param: array of reference parameters
+//	param count: number of parameters
+//	return: value_out
+A3_INLINE a3real *a3sampleTableLerpUniformBatch(a3real value_out[], const a3real uniformTable[], const a3count numUniformDivisions, const a3real paramMin, const a3real paramMax, const a3real param[], const a3count count);
+
+
+//-----------------------------------------------------------------------------
+// A3: Batch curve evaluation: evaluate one curve segment with 3 or 4 channels 
+//		(e.g. positions, or quaternions per component) at many parameters; 
+//		the control values are converted to cubic coefficients once, so each 
+//		parameter costs three multiply-adds per channel, and SIMD builds (see 
+//		'a3simd.h') evaluate four parameters per iteration. Values are packed 
+//		3 or 4 per parameter. Quaternions blended per component are not unit 
+//		length and should be normalized after (see 'a3real4GetUnitBatch'). 
+//		Each function reads and writes only items [0, count) of its arrays, 
+//		so a large batch may be split across threads.
+
+// A3: Batch Catmull-Rom spline interpolation; see 'a3CatmullRom'.
+//	param v_out: array of interpolated values
+//	param nPrev: previous control value (before n0)
+//	param n0: initial control value of curve segment
+//	param n1: goal/end control value of curve segment
+//	param nNext: next control value (after n1)
+//	param param: array of interpolation parameters (t)
+//	param count: number of parameters
+//	return: v_out
+A3_INLINE a3real *a3real3CatmullRomBatch(a3real v_out[], const a3real3p nPrev, const a3real3p n0, const a3real3p n1, const a3real3p nNext, const a3real param[], const a3count count);
+A3_INLINE a3real *a3real4CatmullRomBatch(a3real v_out[], const a3real4p nPrev, const a3real4p n0, const a3real4p n1, const a3real4p nNext, const a3real param[], const a3count count);
+
+// A3: Batch cubic Hermite spline interpolation using control handles; see 
+//		'a3HermiteControl'.
+//	param v_out: array of interpolated values
+//	param n0: initial control value of curve segment
+//	param n1: goal/end control value of curve segment
+//	param nControl0: control handle corresponding to n0
+//	param nControl1: control handle corresponding to n1
+//	param param: array of interpolation parameters (t)
+//	param count: number of parameters
+//	return: v_out
+A3_INLINE a3real *a3real3HermiteControlBatch(a3real v_out[], const a3real3p n0, const a3real3p n1, const a3real3p nControl0, const a3real3p nControl1, const a3real param[], const a3count count);
+A3_INLINE a3real *a3real4HermiteControlBatch(a3real v_out[], const a3real4p n0, const a3real4p n1, const a3real4p nControl0, const a3real4p nControl1, const a3real param[], const a3count count);
+
+// A3: Batch cubic Hermite spline interpolation using control tangents; see 
+//		'a3HermiteTangent'.
+//	param v_out: array of interpolated values
+//	param n0: initial control value of curve segment
+//	param n1: goal/end control value of curve segment
+//	param nTangent0: control tangent corresponding to n0
+//	param nTangent1: control tangent corresponding to n1
+//	param param: array of interpolation parameters (t)
+//	param count: number of parameters
+//	return: v_out
+A3_INLINE a3real *a3real3HermiteTangentBatch(a3real v_out[], const a3real3p n0, const a3real3p n1, const a3real3p nTangent0, const a3real3p nTangent1, const a3real param[], const a3count count);
+A3_INLINE a3real *a3real4HermiteTangentBatch(a3real v_out[], const a3real4p n0, const a3real4p n1, const a3real4p nTangent0, const a3real4p nTangent1, const a3real param[], const a3count count);
+
+// A3: Batch cubic Bezier interpolation; see 'a3Bezier3'.
+//	param v_out: array of interpolated values
+//	param n0: first control value
+//	param n1: second control value
+//	param n2: third control value
+//	param n3: fourth control value
+//	param param: array of interpolation parameters (t)
+//	param count: number of parameters
+//	return: v_out
+A3_INLINE a3real *a3real3Bezier3Batch(a3real v_out[], const a3real3p n0, const a3real3p n1, const a3real3p n2, const a3real3p n3, const a3real param[], const a3count count);
+A3_INLINE a3real *a3real4Bezier3Batch(a3real v_out[], const a3real4p n0, const a3real4p n1, const a3real4p n2, const a3real4p n3, const a3real param[], const a3count count);
+
+// A3: Calculate arc length through 3D samples, e.g. a curve segment evaluated 
+//		at evenly spaced parameters by one of the above; distance between 
+//		samples is the straight-line (Euclidean) distance.
+//	param arclenTable_out: array of accumulated arc lengths at each sample
+//	param autoNormalize: option to normalize arc lengths
+//	param numDivisions: number of intervals between samples; tables should 
+//		have (numDivisions + 1) elements allocated
+//	param sampleTable: array of samples, packed 3 per sample
+//	return: total arc length through samples; zero if invalid params
+A3_INLINE a3real a3calculateArcLengthSamples3(a3real arclenTable_out[], const a3boolean autoNormalize, const a3count numDivisions, const a3real sampleTable[]);
+
+
 //-----------------------------------------------------------------------------
 
 
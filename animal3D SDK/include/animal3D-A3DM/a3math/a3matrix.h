@@ -892,6 +892,15 @@ A3_INLINE a3real4x4r a3real4x4ConcatL(a3real4x4p mL_inout, const a3real4x4p mR);
 //	return: mR_inout
 A3_INLINE a3real4x4r a3real4x4ConcatR(const a3real4x4p mL, a3real4x4p mR_inout);
 
+// A3: Aligned variants of the above for SIMD builds (see 'a3simd.h'): all 
+//		vector and matrix arguments must be 16-byte aligned (declared with 
+//		'A3_SIMD_ALIGN'); same as plain functions in scalar builds.
+//	params and return: same as plain function
+A3_INLINE a3real4r a3real4Real4x4ProductRAligned(a3real4p v_out, const a3real4x4p m, const a3real4p v);
+A3_INLINE a3real4x4r a3real4x4ProductAligned(a3real4x4p m_out, const a3real4x4p mL, const a3real4x4p mR);
+A3_INLINE a3real4x4r a3real4x4GetTransposedAligned(a3real4x4p m_out, const a3real4x4p m);
+A3_INLINE a3real4x4r a3real4x4GetInverseAligned(a3real4x4p m_out, const a3real4x4p m);
+
 
 // A3: Set matrix to represent uniform scale transformation.
 //	param m_out: output transformation matrix
@@ -1045,6 +1054,15 @@ A3_INLINE a3real4x4r a3real4x4TransformInverseIgnoreScale(a3real4x4p m_out, cons
 //	return: m_out
 A3_INLINE a3real4x4r a3real4x4TransformInverseUniformScale(a3real4x4p m_out, const a3real4x4p m);
 
+// A3: Calculate inverse of matrix as general affine transform, whose axes 
+//		may be skewed (e.g. a child of a non-uniformly scaled parent); 
+//		inverts the upper 3x3 and translation, faster than the complete 
+//		inverse.
+//	param m_out: output matrix inverse
+//	param m: matrix of which to calculate inverse
+//	return: m_out
+A3_INLINE a3real4x4r a3real4x4TransformInverseAffine(a3real4x4p m_out, const a3real4x4p m);
+
 // A3: Invert matrix as transform (faster than full 4x4).
 //	param m_inout: matrix to invert and store
 //	return: m_inout
@@ -1062,6 +1080,11 @@ A3_INLINE a3real4x4r a3real4x4TransformInvertIgnoreScale(a3real4x4p m_inout);
 //	return: m_inout
 A3_INLINE a3real4x4r a3real4x4TransformInvertUniformScale(a3real4x4p m_inout);
 
+// A3: Invert matrix as general affine transform, whose axes may be skewed.
+//	param m_inout: matrix to invert and store
+//	return: m_inout
+A3_INLINE a3real4x4r a3real4x4TransformInvertAffine(a3real4x4p m_inout);
+
 
 // A3: Prepare a 3D "look-at" matrix given "center" and "target".
 //	param m_out: matrix to store look-at transform
@@ -1187,6 +1210,7 @@ extern const a3mat4 a3mat4_identity;
 #define a3real2Real2x2Product	a3real2Real2x2ProductR
 #define a3real3Real3x3Product	a3real3Real3x3ProductR
 #define a3real4Real4x4Product	a3real4Real4x4ProductR
+#define a3real4Real4x4ProductAligned	a3real4Real4x4ProductRAligned
 #define a3real2Real2x2Mul		a3real2Real2x2MulR
 #define a3real3Real3x3Mul		a3real3Real3x3MulR
 #define a3real4Real4x4Mul		a3real4Real4x4MulR
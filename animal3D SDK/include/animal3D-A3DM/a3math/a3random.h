@@ -36,6 +36,21 @@
 A3_BEGIN_DECL
 
 
+//-----------------------------------------------------------------------------
+
+// A3: Counter-based random stream (Philox 4x32-10): value n of a stream is a 
+//		pure function of its seed, its stream id and n, so threads or tasks 
+//		can each draw from their own stream, or split one stream's values by 
+//		index, and always get the same results. Streams hold no global state.
+typedef struct a3randstream a3randstream;
+struct a3randstream
+{
+	a3ui32 key[2];		// seed and stream id
+	a3ui32 block[4];	// current block of four values
+	a3ui64 index;		// index of next value
+};
+
+
 //-----------------------------------------------------------------------------
 
 // A3: Get maximum random number.
@@ -94,6 +109,96 @@ A3_INLINE a3real a3randomRange(const a3real nMin, const a3real nMax);
 A3_INLINE a3integer a3randomRangeInt(const a3integer nMin, const a3integer nMax);
 
 
+//-----------------------------------------------------------------------------
+// A3: Counter-based random streams: reentrant, and unaffected by the seed 
+//		of the functions above.
+
+// A3: Calculate one Philox 4x32-10 block: four random integers from a 
+//		128-bit counter and 64-bit key.
+//	param values_out: four random integers
+//	param counter: four-integer counter
+//	param key: two-integer key
+//	return: values_out
+A3_INLINE a3ui32 *a3randomPhilox(a3ui32 values_out[4], const a3ui32 counter[4], const a3ui32 key[2]);
+
+// A3: Initialize random stream; streams with different ids are independent.
+//	param stream_out: stream to initialize, starting at index 0
+//	param seed: seed shared by related streams
+//	param streamID: stream id, e.g. thread, task or object index
+//	return: stream_out
+A3_INLINE a3randstream *a3randomStreamInit(a3randstream *stream_out, const a3ui32 seed, const a3ui32 streamID);
+
+// A3: Get index of the next value a stream will return.
+//	param stream: stream
+//	return: index of next value
+A3_INLINE a3ui64 a3randomStreamGetIndex(const a3randstream *stream);
+
+// A3: Move stream to any index in constant time.
+//	param stream: stream
+//	param index: index of next value
+//	return: old index
+A3_INLINE a3ui64 a3randomStreamSetIndex(a3randstream *stream, const a3ui64 index);
+
+// A3: Get next random integer from stream.
+//	param stream: stream
+//	return: random integer in [0, 2^32)
+A3_INLINE a3ui32 a3randomStreamNextInt(a3randstream *stream);
+
+// A3: Get next random decimal number from stream.
+//	param stream: stream
+//	return: random real number in [0, 1), multiple of 2^-24
+A3_INLINE a3real a3randomStreamNext(a3randstream *stream);
+
+// A3: Get normally-distributed random number from stream (Box-Muller); 
+//		uses two values.
+//	param stream: stream
+//	param mean: mean of distribution
+//	param stdDev: standard deviation of distribution
+//	return: random real number
+A3_INLINE a3real a3randomStreamNormal(a3randstream *stream, const a3real mean, const a3real stdDev);
+
+// A3: Get uniformly-distributed random point in unit disc; uses two values.
+//	param p_out: point in the xy plane
+//	param stream: stream
+//	return: p_out
+A3_INLINE a3real2r a3randomStreamDisc(a3real2p p_out, a3randstream *stream);
+
+// A3: Get uniformly-distributed random unit vector in hemisphere around +z; 
+//		uses two values.
+//	param v_out: unit vector with non-negative z
+//	param stream: stream
+//	return: v_out
+A3_INLINE a3real3r a3randomStreamHemisphere(a3real3p v_out, a3randstream *stream);
+
+// A3: Get cosine-weighted random unit vector in hemisphere around +z, with 
+//		density proportional to z (diffuse sampling); uses two values.
+//	param v_out: unit vector with non-negative z
+//	param stream: stream
+//	return: v_out
+A3_INLINE a3real3r a3randomStreamHemisphereCosine(a3real3p v_out, a3randstream *stream);
+
+
+// A3: Fill array with stream values [first, first + count), without moving 
+//		the stream; fills of any split of a range match one fill of the whole 
+//		range. SIMD builds (see 'a3simd.h') calculate four blocks (16 values) 
+//		per iteration.
+//	param values_out: array of random integers in [0, 2^32)
+//	param stream: stream
+//	param first: index of first value
+//	param count: number of values
+//	return: values_out
+A3_INLINE a3ui32 *a3randomStreamFillInt(a3ui32 *values_out, const a3randstream *stream, const a3ui64 first, const a3count count);
+
+// A3: Fill array with stream values [first, first + count) as decimal 
+//		numbers; value n matches 'a3randomStreamNext' at index n.
+//	param values_out: array of random real numbers in [0, 1)
+//	param stream: stream
+//	param first: index of first value
+//	param count: number of values
+//	return: values_out
+A3_INLINE a3real *a3randomStreamFill(a3real *values_out, const a3randstream *stream, const a3ui64 first, const a3count count);
+
+
 //-----------------------------------------------------------------------------
 
 
@@ -0,0 +1,346 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3simd.h
+	Compile-time selection of the instruction set used by 4D vector and
+		4x4 matrix functions, and the operations they are written with.
+*/
+
+#ifndef __ANIMAL3D_A3DM_SIMD_H
+#define __ANIMAL3D_A3DM_SIMD_H
+
+
+#include "animal3D/a3/a3config.h"
+#include "animal3D/a3/a3macros.h"
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+
+
+//-----------------------------------------------------------------------------
+// A3: Instruction sets for 4D vector and 4x4 matrix functions.
+//	SCALAR: plain element-by-element code
+//	SSE2: x86 128-bit; baseline for all 64-bit x86
+//	SSE41: SSE2 with single-instruction dot products
+//	AVX2: SSE41 with 256-bit matrix products and fused multiply-add
+//	NEON: 64-bit ARM 128-bit
+
+#define A3_SIMD_SCALAR		0
+#define A3_SIMD_SSE2		1
+#define A3_SIMD_SSE41		2
+#define A3_SIMD_AVX2		3
+#define A3_SIMD_NEON		4
+
+
+// A3: Selected instruction set: the best one the compiler targets, unless
+//		'A3_SIMD' is defined first (e.g. as 'A3_SIMD_SCALAR' to compare
+//		results with plain code); always scalar unless real is float.
+//		The Visual Studio projects set no '/arch', so the x64 library and 
+//		demo are SSE2 builds; the SSE4.1, AVX2 and NEON paths are built 
+//		and checked only by 'TEST_MATH_VS.bat'.
+#if (defined A3_REAL_F64 || defined A3_REAL_F128)
+#ifdef A3_SIMD
+#undef A3_SIMD
+#endif	// A3_SIMD
+#define A3_SIMD				A3_SIMD_SCALAR
+#endif	// (defined A3_REAL_F64 || defined A3_REAL_F128)
+
+#ifndef A3_SIMD
+#if (defined __AVX2__)
+#define A3_SIMD				A3_SIMD_AVX2
+#elif (defined __SSE4_1__ || defined __AVX__)
+#define A3_SIMD				A3_SIMD_SSE41
+#elif (defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2) || defined __SSE2__)
+#define A3_SIMD				A3_SIMD_SSE2
+#elif (defined _M_ARM64 || (defined __aarch64__ && defined __ARM_NEON))
+#define A3_SIMD				A3_SIMD_NEON
+#else	// !SIMD
+#define A3_SIMD				A3_SIMD_SCALAR
+#endif	// SIMD
+#endif	// !A3_SIMD
+
+
+// A3: Fused multiply-add with 256-bit products, where the compiler
+//		targets it (MSVC only says AVX2, which always has it).
+#if (A3_SIMD == A3_SIMD_AVX2 && (defined __FMA__ || defined _MSC_VER))
+#define A3_SIMD_FMA
+#endif	// (A3_SIMD == A3_SIMD_AVX2 && (defined __FMA__ || defined _MSC_VER))
+
+
+// A3: Name of selected instruction set, for reports.
+#if (A3_SIMD == A3_SIMD_AVX2)
+#ifdef A3_SIMD_FMA
+#define A3_SIMD_NAME		"AVX2+FMA"
+#else	// !A3_SIMD_FMA
+#define A3_SIMD_NAME		"AVX2"
+#endif	// A3_SIMD_FMA
+#elif (A3_SIMD == A3_SIMD_SSE41)
+#define A3_SIMD_NAME		"SSE4.1"
+#elif (A3_SIMD == A3_SIMD_SSE2)
+#define A3_SIMD_NAME		"SSE2"
+#elif (A3_SIMD == A3_SIMD_NEON)
+#define A3_SIMD_NAME		"NEON"
+#else	// A3_SIMD_SCALAR
+#define A3_SIMD_NAME		"scalar"
+#endif	// A3_SIMD
+
+
+// A3: Prefix for declaring vectors and matrices passed to aligned
+//		variants of functions, e.g. 'A3_SIMD_ALIGN a3mat4 m;'.
+#ifdef _MSC_VER
+#define A3_SIMD_ALIGN		__declspec(align(16))
+#else	// !_MSC_VER
+#define A3_SIMD_ALIGN		__attribute__((aligned(16)))
+#endif	// _MSC_VER
+
+// A3: Check if address may be passed to aligned variants of functions.
+#define a3simdIsAligned(p)	( ((a3address)(p) & 15) == 0 )
+
+
+//-----------------------------------------------------------------------------
+// A3: Four-float operations shared by the instruction sets, used to write
+//		each function once; SSE41 and AVX2 build on SSE2.
+//	a3simd4: type holding four floats
+//	a3simd4Load, a3simd4LoadAligned: load four floats from address
+//	a3simd4LoadAs: load aligned if constant flag is set
+//	a3simd4Store, a3simd4StoreAligned, a3simd4StoreAs: store four floats
+//	a3simd4Splat: all four set to one float
+//	a3simd4Add, a3simd4Sub, a3simd4Mul: per-element arithmetic
+//	a3simd4MulAdd: per-element a*b + c
+//	a3simd4Div, a3simd4Sqrt: per-element quotient and square root
+//	a3simd4SqrtInverseEstimate: per-element hardware reciprocal square root 
+//		estimate, at least 11 bits (NEON refines its 8-bit estimate once)
+//	a3simd4SqrtInverseStep: one Newton-Raphson step refining estimate y of 
+//		the reciprocal square root of a, roughly doubling correct bits
+//	a3simd4MaskPositive: elements of v where s is positive, zero elsewhere
+//	a3simd4Abs, a3simd4Min, a3simd4Max: per-element magnitude and extremes
+//	a3simd4Round: per-element nearest integer, ties to even
+//	a3simd4Less, a3simd4Greater: per-element comparison as all-bits mask
+//	a3simd4And, a3simd4Xor: per-element bitwise operations
+//	a3simd4Select: elements of a where mask m is set, b elsewhere
+//	a3simd4BitMask: mask set where the integer nearest v has the constant 
+//		bit set (v must fit in a 32-bit integer)
+//	a3simd4Dot: sum of products, as float
+//	a3simd4First: first element, as float
+//	a3simd4Transpose: transpose four vectors in place
+//	a3simd4Load3x4, a3simd4Store3x4: load or store four packed 3D vectors 
+//		(12 floats) as separate x, y and z vectors
+
+#if (A3_SIMD == A3_SIMD_SSE2 || A3_SIMD == A3_SIMD_SSE41 || A3_SIMD == A3_SIMD_AVX2)
+
+#if (A3_SIMD == A3_SIMD_AVX2)
+#include <immintrin.h>
+#elif (A3_SIMD == A3_SIMD_SSE41)
+#include <smmintrin.h>
+#else	// A3_SIMD_SSE2
+#include <emmintrin.h>
+#endif	// A3_SIMD
+
+typedef __m128						a3simd4;
+#define a3simd4Load(p)				_mm_loadu_ps(p)
+#define a3simd4LoadAligned(p)		_mm_load_ps(p)
+#define a3simd4Store(p,v)			_mm_storeu_ps(p, v)
+#define a3simd4StoreAligned(p,v)	_mm_store_ps(p, v)
+#define a3simd4Splat(s)				_mm_set1_ps(s)
+#define a3simd4Add(a,b)				_mm_add_ps(a, b)
+#define a3simd4Sub(a,b)				_mm_sub_ps(a, b)
+#define a3simd4Mul(a,b)				_mm_mul_ps(a, b)
+#define a3simd4Div(a,b)				_mm_div_ps(a, b)
+#define a3simd4Sqrt(a)				_mm_sqrt_ps(a)
+#define a3simd4SqrtInverseEstimate(a)	_mm_rsqrt_ps(a)
+#define a3simd4SqrtInverseStep(y,a)	_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), y), _mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(_mm_mul_ps(a, y), y)))
+#define a3simd4MaskPositive(v,s)	_mm_and_ps(v, _mm_cmpgt_ps(s, _mm_setzero_ps()))
+#define a3simd4Abs(a)				_mm_andnot_ps(_mm_set1_ps(-0.0f), a)
+#define a3simd4Min(a,b)				_mm_min_ps(a, b)
+#define a3simd4Max(a,b)				_mm_max_ps(a, b)
+#define a3simd4Less(a,b)			_mm_cmplt_ps(a, b)
+#define a3simd4Greater(a,b)			_mm_cmpgt_ps(a, b)
+#define a3simd4And(a,b)				_mm_and_ps(a, b)
+#define a3simd4Xor(a,b)				_mm_xor_ps(a, b)
+#define a3simd4BitMask(v,bit)		_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_cvtps_epi32(v), _mm_set1_epi32(bit)), _mm_set1_epi32(bit)))
+#if (A3_SIMD == A3_SIMD_SSE2)
+#define a3simd4Round(a)				_mm_cvtepi32_ps(_mm_cvtps_epi32(a))
+#define a3simd4Select(m,a,b)		_mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b))
+#else	// !A3_SIMD_SSE2
+#define a3simd4Round(a)				_mm_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)
+#define a3simd4Select(m,a,b)		_mm_blendv_ps(b, a, m)
+#endif	// A3_SIMD_SSE2
+#define a3simd4First(v)				_mm_cvtss_f32(v)
+#define a3simd4Transpose(v0,v1,v2,v3)	_MM_TRANSPOSE4_PS(v0, v1, v2, v3)
+#define a3simd4Load3x4(p,x,y,z) {																\
+		const a3simd4 a3s0 = _mm_loadu_ps(p), a3s1 = _mm_loadu_ps((p) + 4), a3s2 = _mm_loadu_ps((p) + 8);	\
+		const a3simd4 a3xy23 = _mm_shuffle_ps(a3s1, a3s2, _MM_SHUFFLE(2, 1, 3, 2));					\
+		const a3simd4 a3yz01 = _mm_shuffle_ps(a3s0, a3s1, _MM_SHUFFLE(1, 0, 2, 1));					\
+		x = _mm_shuffle_ps(a3s0, a3xy23, _MM_SHUFFLE(2, 0, 3, 0));										\
+		y = _mm_shuffle_ps(a3yz01, a3xy23, _MM_SHUFFLE(3, 1, 2, 0));									\
+		z = _mm_shuffle_ps(a3yz01, a3s2, _MM_SHUFFLE(3, 0, 3, 1));										\
+	}
+#define a3simd4Store3x4(p,x,y,z) {																\
+		const a3simd4 a3xy01 = _mm_unpacklo_ps(x, y), a3xy23 = _mm_unpackhi_ps(x, y);				\
+		const a3simd4 a3zx = _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0));							\
+		const a3simd4 a3yz = _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1));							\
+		const a3simd4 a3zxy = _mm_shuffle_ps(z, a3xy23, _MM_SHUFFLE(3, 2, 3, 2));					\
+		_mm_storeu_ps(p, _mm_shuffle_ps(a3xy01, a3zx, _MM_SHUFFLE(2, 0, 1, 0)));					\
+		_mm_storeu_ps((p) + 4, _mm_shuffle_ps(a3yz, a3xy23, _MM_SHUFFLE(1, 0, 2, 0)));				\
+		_mm_storeu_ps((p) + 8, _mm_shuffle_ps(a3zxy, a3zxy, _MM_SHUFFLE(1, 3, 2, 0)));				\
+	}
+#ifdef A3_SIMD_FMA
+#define a3simd4MulAdd(a,b,c)		_mm_fmadd_ps(a, b, c)
+#else	// !A3_SIMD_FMA
+#define a3simd4MulAdd(a,b,c)		_mm_add_ps(_mm_mul_ps(a, b), c)
+#endif	// A3_SIMD_FMA
+#if (A3_SIMD == A3_SIMD_SSE2)
+#define a3simd4Dot(a,b)				a3simd4DotSSE2(_mm_mul_ps(a, b))
+A3_BEGIN_DECL
+A3_INLINE a3f32 a3simd4DotSSE2(const a3simd4 p)
+{
+	const a3simd4 s = _mm_add_ps(p, _mm_movehl_ps(p, p));
+	return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55)));
+}
+A3_END_DECL
+#else	// !A3_SIMD_SSE2
+#define a3simd4Dot(a,b)				_mm_cvtss_f32(_mm_dp_ps(a, b, 0xff))
+#endif	// A3_SIMD_SSE2
+
+// A3: Four-integer operations on unsigned 32-bit lanes, for integer 
+//		generators and hashes.
+//	a3simd4i: type holding four 32-bit integers
+//	a3simd4iLoad, a3simd4iStore: load and store four integers, unaligned
+//	a3simd4iSplat: all four set to one integer
+//	a3simd4iAdd, a3simd4iXor: per-element wrapping sum and bitwise xor
+//	a3simd4iShiftRight: per-element logical shift by constant
+//	a3simd4iMulHiLo: per-element full 64-bit product of a and b, stored as 
+//		high and low halves in hi and lo
+//	a3simd4iToReal: per-element conversion to float, input below 2^31
+//	a3simd4iAsReal, a3simd4AsInt: reinterpret bits between types
+typedef __m128i						a3simd4i;
+#define a3simd4iLoad(p)				_mm_loadu_si128((__m128i const*)(p))
+#define a3simd4iStore(p,v)			_mm_storeu_si128((__m128i*)(p), v)
+#define a3simd4iSplat(s)			_mm_set1_epi32((a3i32)(s))
+#define a3simd4iAdd(a,b)			_mm_add_epi32(a, b)
+#define a3simd4iXor(a,b)			_mm_xor_si128(a, b)
+#define a3simd4iShiftRight(a,n)		_mm_srli_epi32(a, n)
+#define a3simd4iToReal(a)			_mm_cvtepi32_ps(a)
+#define a3simd4iAsReal(a)			_mm_castsi128_ps(a)
+#define a3simd4AsInt(a)				_mm_castps_si128(a)
+#define a3simd4iMulHiLo(a,b,hi,lo) {														\
+		const __m128i a3p02 = _mm_mul_epu32(a, b);												\
+		const __m128i a3p13 = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));		\
+		lo = _mm_unpacklo_epi32(_mm_shuffle_epi32(a3p02, 0x08), _mm_shuffle_epi32(a3p13, 0x08));	\
+		hi = _mm_unpacklo_epi32(_mm_shuffle_epi32(a3p02, 0x0d), _mm_shuffle_epi32(a3p13, 0x0d));	\
+	}
+
+// A3: Eight-float operations for pairs of 4D vectors (AVX2 only); 
+//		256-bit access is never assumed to be aligned.
+//	a3simd8Load, a3simd8Store: load and store eight floats
+//	a3simd8Splat4: both halves set to four floats
+//	a3simd8Lane: each half set to one of its own elements
+//	a3simd8Mul, a3simd8MulAdd: per-element arithmetic
+#if (A3_SIMD == A3_SIMD_AVX2)
+typedef __m256						a3simd8;
+#define a3simd8Load(p)				_mm256_loadu_ps(p)
+#define a3simd8Store(p,v)			_mm256_storeu_ps(p, v)
+#define a3simd8Splat4(v4)			_mm256_insertf128_ps(_mm256_castps128_ps256(v4), v4, 1)
+#define a3simd8Lane(v,i)			_mm256_permute_ps(v, (i) * 0x55)
+#define a3simd8Mul(a,b)				_mm256_mul_ps(a, b)
+#ifdef A3_SIMD_FMA
+#define a3simd8MulAdd(a,b,c)		_mm256_fmadd_ps(a, b, c)
+#else	// !A3_SIMD_FMA
+#define a3simd8MulAdd(a,b,c)		_mm256_add_ps(_mm256_mul_ps(a, b), c)
+#endif	// A3_SIMD_FMA
+#endif	// A3_SIMD_AVX2
+
+#elif (A3_SIMD == A3_SIMD_NEON)
+
+#include <arm_neon.h>
+
+typedef float32x4_t					a3simd4;
+#define a3simd4Load(p)				vld1q_f32(p)
+#define a3simd4LoadAligned(p)		vld1q_f32(p)
+#define a3simd4Store(p,v)			vst1q_f32(p, v)
+#define a3simd4StoreAligned(p,v)	vst1q_f32(p, v)
+#define a3simd4Splat(s)				vdupq_n_f32(s)
+#define a3simd4Add(a,b)				vaddq_f32(a, b)
+#define a3simd4Sub(a,b)				vsubq_f32(a, b)
+#define a3simd4Mul(a,b)				vmulq_f32(a, b)
+#define a3simd4MulAdd(a,b,c)		vfmaq_f32(c, a, b)
+#define a3simd4Div(a,b)				vdivq_f32(a, b)
+#define a3simd4Sqrt(a)				vsqrtq_f32(a)
+#define a3simd4SqrtInverseEstimate(a)	a3simd4SqrtInverseStep(vrsqrteq_f32(a), a)
+#define a3simd4SqrtInverseStep(y,a)	vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(a, y), y))
+#define a3simd4MaskPositive(v,s)	vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(v), vcgtq_f32(s, vdupq_n_f32(0.0f))))
+#define a3simd4Abs(a)				vabsq_f32(a)
+#define a3simd4Min(a,b)				vminq_f32(a, b)
+#define a3simd4Max(a,b)				vmaxq_f32(a, b)
+#define a3simd4Round(a)				vrndnq_f32(a)
+#define a3simd4Less(a,b)			vreinterpretq_f32_u32(vcltq_f32(a, b))
+#define a3simd4Greater(a,b)			vreinterpretq_f32_u32(vcgtq_f32(a, b))
+#define a3simd4And(a,b)				vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)))
+#define a3simd4Xor(a,b)				vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)))
+#define a3simd4Select(m,a,b)		vbslq_f32(vreinterpretq_u32_f32(m), a, b)
+#define a3simd4BitMask(v,bit)		vreinterpretq_f32_u32(vtstq_s32(vcvtnq_s32_f32(v), vdupq_n_s32(bit)))
+#define a3simd4Dot(a,b)				vaddvq_f32(vmulq_f32(a, b))
+#define a3simd4First(v)				vgetq_lane_f32(v, 0)
+#define a3simd4Load3x4(p,x,y,z) {													\
+		const float32x4x3_t a3xyz = vld3q_f32(p);										\
+		x = a3xyz.val[0];	y = a3xyz.val[1];	z = a3xyz.val[2];								\
+	}
+#define a3simd4Store3x4(p,x,y,z) {													\
+		float32x4x3_t a3xyz;															\
+		a3xyz.val[0] = x;	a3xyz.val[1] = y;	a3xyz.val[2] = z;								\
+		vst3q_f32(p, a3xyz);															\
+	}
+#define a3simd4Transpose(v0,v1,v2,v3) {										\
+		const float32x4x2_t t01 = vtrnq_f32(v0, v1), t23 = vtrnq_f32(v2, v3);	\
+		v0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));		\
+		v1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));		\
+		v2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));	\
+		v3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));	\
+	}
+
+typedef uint32x4_t					a3simd4i;
+#define a3simd4iLoad(p)				vld1q_u32(p)
+#define a3simd4iStore(p,v)			vst1q_u32(p, v)
+#define a3simd4iSplat(s)			vdupq_n_u32(s)
+#define a3simd4iAdd(a,b)			vaddq_u32(a, b)
+#define a3simd4iXor(a,b)			veorq_u32(a, b)
+#define a3simd4iShiftRight(a,n)		vshrq_n_u32(a, n)
+#define a3simd4iToReal(a)			vcvtq_f32_u32(a)
+#define a3simd4iAsReal(a)			vreinterpretq_f32_u32(a)
+#define a3simd4AsInt(a)				vreinterpretq_u32_f32(a)
+#define a3simd4iMulHiLo(a,b,hi,lo) {														\
+		const uint32x4_t a3p01 = vreinterpretq_u32_u64(vmull_u32(vget_low_u32(a), vget_low_u32(b)));		\
+		const uint32x4_t a3p23 = vreinterpretq_u32_u64(vmull_u32(vget_high_u32(a), vget_high_u32(b)));	\
+		lo = vuzp1q_u32(a3p01, a3p23);																\
+		hi = vuzp2q_u32(a3p01, a3p23);																\
+	}
+
+#endif	// A3_SIMD
+
+#if (A3_SIMD != A3_SIMD_SCALAR)
+#define a3simd4LoadAs(p,aligned)	( (aligned) ? a3simd4LoadAligned(p) : a3simd4Load(p) )
+#define a3simd4StoreAs(p,v,aligned)	( (aligned) ? a3simd4StoreAligned(p, v) : a3simd4Store(p, v) )
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+
+
+//-----------------------------------------------------------------------------
+
+
+#endif	// !__ANIMAL3D_A3DM_SIMD_H
@@ -32,6 +32,8 @@
 #include "animal3D/a3/a3types_integer.h"
 #include "animal3D/a3/a3types_real.h"
 
+#include "a3simd.h"
+
 
 A3_BEGIN_DECL
 
@@ -85,6 +87,56 @@ extern a3f64 a3sqrtdInverse(const a3f64 x);
 #define a3sqrtSafeInverse(x)	( (x) != a3real_zero ? a3sqrtInverse(x) : a3real_zero )
 
 
+//-----------------------------------------------------------------------------
+// A3: Fast inverse square root with the hardware estimate (see 'a3simd.h') 
+//		instead of Quake's method, four values per instruction; precision is 
+//		chosen at run time and shared by the batch normalize functions (see 
+//		'a3batch.h'). Scalar builds fall back to Quake's method.
+
+// A3: Precision of fast inverse square roots; each lists the largest 
+//		relative error with SIMD (scalar builds in parentheses).
+enum a3sqrtPrecision
+{
+	a3sqrtPrecision_low,	// 4e-4 (2e-3): estimate only
+	a3sqrtPrecision_medium,	// 3e-7 (5e-6): one Newton-Raphson step; default
+	a3sqrtPrecision_high	// 1e-7: square root and divide
+};
+
+
+// A3: Set the precision used by fast inverse square roots.
+//	param precision: new precision (a3sqrtPrecision)
+//	return: old precision
+A3_INLINE a3index a3sqrtSetPrecision(const a3index precision);
+
+// A3: Get the precision used by fast inverse square roots.
+//	return: precision (a3sqrtPrecision)
+A3_INLINE a3index a3sqrtGetPrecision();
+
+
+// A3: Compute fast inverse square root at the current precision.
+//	param x: number to square root and invert
+//	return: approximate inverse square root of x; zero if x is not positive 
+//		or is too small to be a normal float (denormal)
+A3_INLINE a3f32 a3sqrtfInverseFast(const a3f32 x);
+
+// A3: Compute fast inverse square roots of an array at the current 
+//		precision: x_out[i] = 1 / sqrt(x[i]).
+//	param x_out: array of results; may be the same as x
+//	param x: array of numbers to square root and invert
+//	param count: number of items
+//	return: x_out
+A3_INLINE a3f32 *a3sqrtfInverseFastBatch(a3f32 *x_out, const a3f32 *x, const a3count count);
+
+#if (A3_SIMD != A3_SIMD_SCALAR)
+// A3: Compute fast inverse square roots of four values at the current 
+//		precision, for SIMD code that has its values in registers.
+//	param x: numbers to square root and invert
+//	return: approximate inverse square roots of x; zero where x is not 
+//		positive or is denormal
+A3_INLINE a3simd4 a3sqrtfInverseFast4(const a3simd4 x);
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+
+
 //-----------------------------------------------------------------------------
 
 
@@ -20,7 +20,8 @@
 	By Daniel S. Buckstein
 
 	a3stats.h
-	Declarations for miscellaneous statistical functions.
+	Declarations for miscellaneous statistical functions, selection and 
+		streaming statistics.
 */
 
 #ifndef __ANIMAL3D_A3DM_STATS_H
@@ -35,6 +36,53 @@
 A3_BEGIN_DECL
 
 
+//-----------------------------------------------------------------------------
+
+// A3: Histogram size: each octave (power of two) is split into 2^subBits 
+//		buckets, so a bucket's midpoint is within 2^-(subBits+1) of any value 
+//		in it (3.1%); values from lowest to lowest * 2^octaves are kept.
+enum a3statsHistogramSize
+{
+	a3statsHistogram_subBits = 4,
+	a3statsHistogram_octaves = 24,
+	a3statsHistogram_bucketCount = a3statsHistogram_octaves << a3statsHistogram_subBits,
+};
+
+
+// A3: Running mean and variance of samples added one at a time (Welford).
+typedef struct a3statsRunning a3statsRunning;
+struct a3statsRunning
+{
+	a3count count;				// number of samples
+	a3real mean;				// mean of samples
+	a3real m2;					// sum of squared offsets from mean
+	a3real minimum, maximum;	// smallest and largest samples
+};
+
+// A3: Exponential moving average and variance: each new sample has weight 
+//		alpha and older samples fade by (1 - alpha) per sample.
+typedef struct a3statsAverage a3statsAverage;
+struct a3statsAverage
+{
+	a3real alpha;				// weight of newest sample
+	a3real mean;				// weighted mean
+	a3real variance;			// weighted variance
+	a3count count;				// number of samples
+};
+
+// A3: Log-linear histogram of positive samples for approximate percentiles 
+//		in constant memory (as in HDR histograms); bucket boundaries come 
+//		straight from the bits of a 32-bit float.
+typedef struct a3statsHistogram a3statsHistogram;
+struct a3statsHistogram
+{
+	a3ui32 bucket[a3statsHistogram_bucketCount];	// samples per bucket
+	a3ui32 base;				// key of lowest bucket
+	a3count count;				// number of samples
+	a3real minimum, maximum;	// smallest and largest samples
+};
+
+
 //-----------------------------------------------------------------------------
 // median, mean, variance, standard deviation (with options to return mean)
 
@@ -94,6 +142,42 @@ A3_INLINE a3real a3standardDeviation(const a3real data[], const a3count n, a3rea
 A3_INLINE a3real a3standardDeviationInt(const a3integer data[], const a3count n, a3real *mean_out);
 
 
+// A3: Select k-th smallest value of real data set in O(n) (introselect: 
+//		quickselect with three-way partition, falling back to median of 
+//		medians if partitions stay unbalanced); reorders data so values 
+//		before k are not greater and values after are not less.
+//	param data: array of data values, reordered
+//	param n: number of elements
+//	param k: index of value in sorted order, less than n
+//	return: k-th smallest value
+A3_INLINE a3real a3select(a3real data[], const a3count n, const a3index k);
+
+// A3: Select k-th smallest value of integer data set in O(n); see 
+//		'a3select'.
+//	param data: array of data values, reordered
+//	param n: number of elements
+//	param k: index of value in sorted order, less than n
+//	return: k-th smallest value
+A3_INLINE a3integer a3selectInt(a3integer data[], const a3count n, const a3index k);
+
+// A3: Calculate percentile of unsorted real data set in O(n) using 
+//		'a3select', interpolating between neighbouring ranks; p = 0.5 is the 
+//		median. Reorders data.
+//	param data: array of data values, reordered
+//	param n: number of elements
+//	param p: percentile as a fraction in [0, 1]
+//	return: value below which fraction p of data lies
+A3_INLINE a3real a3percentile(a3real data[], const a3count n, const a3real p);
+
+// A3: Calculate percentile of unsorted integer data set in O(n); see 
+//		'a3percentile'.
+//	param data: array of data values, reordered
+//	param n: number of elements
+//	param p: percentile as a fraction in [0, 1]
+//	return: value below which fraction p of data lies
+A3_INLINE a3real a3percentileInt(a3integer data[], const a3count n, const a3real p);
+
+
 // A3: Calculate factorial of number.
 //	param n: number
 //	return: factorial of n (n!)
@@ -112,6 +196,81 @@ A3_INLINE a3biginteger a3permutations(const a3bigcount n, const a3bigindex k);
 A3_INLINE a3biginteger a3combinations(const a3bigcount n, const a3bigindex k);
 
 
+//-----------------------------------------------------------------------------
+// streaming statistics: constant memory, no sorting
+
+// A3: Reset running statistics.
+//	param stats_out: running statistics to clear
+//	return: stats_out
+A3_INLINE a3statsRunning *a3statsRunningReset(a3statsRunning *stats_out);
+
+// A3: Add sample to running statistics.
+//	param stats: running statistics
+//	param x: sample
+//	return: stats
+A3_INLINE a3statsRunning *a3statsRunningAdd(a3statsRunning *stats, const a3real x);
+
+// A3: Merge running statistics of separate sets of samples, e.g. from 
+//		different threads, as if all samples were added to one.
+//	param stats: running statistics to merge into
+//	param other: running statistics to merge
+//	return: stats
+A3_INLINE a3statsRunning *a3statsRunningMerge(a3statsRunning *stats, const a3statsRunning *other);
+
+// A3: Get variance of running statistics (same as 'a3variance').
+//	param stats: running statistics
+//	return: variance; zero if no samples
+A3_INLINE a3real a3statsRunningVariance(const a3statsRunning *stats);
+
+// A3: Get standard deviation of running statistics.
+//	param stats: running statistics
+//	return: standard deviation; zero if no samples
+A3_INLINE a3real a3statsRunningStandardDeviation(const a3statsRunning *stats);
+
+
+// A3: Initialize exponential moving average.
+//	param avg_out: average to initialize
+//	param alpha: weight of each new sample in (0, 1]; for a half-life of 
+//		h samples, alpha = 1 - 2^(-1/h)
+//	return: avg_out
+A3_INLINE a3statsAverage *a3statsAverageInit(a3statsAverage *avg_out, const a3real alpha);
+
+// A3: Add sample to exponential moving average; first sample sets mean.
+//	param avg: average
+//	param x: sample
+//	return: new mean
+A3_INLINE a3real a3statsAverageAdd(a3statsAverage *avg, const a3real x);
+
+
+// A3: Initialize histogram.
+//	param hist_out: histogram to clear
+//	param lowest: smallest positive value to resolve; smaller samples are 
+//		counted in the lowest bucket, samples above lowest * 2^octaves in 
+//		the highest
+//	return: hist_out
+A3_INLINE a3statsHistogram *a3statsHistogramInit(a3statsHistogram *hist_out, const a3real lowest);
+
+// A3: Add sample to histogram.
+//	param hist: histogram
+//	param x: sample
+//	return: hist
+A3_INLINE a3statsHistogram *a3statsHistogramAdd(a3statsHistogram *hist, const a3real x);
+
+// A3: Merge histograms initialized with the same lowest value.
+//	param hist: histogram to merge into
+//	param other: histogram to merge
+//	return: hist if success; null if lowest values differ
+A3_INLINE a3statsHistogram *a3statsHistogramMerge(a3statsHistogram *hist, const a3statsHistogram *other);
+
+// A3: Get approximate percentile of histogram: midpoint of the bucket 
+//		holding the sample of that rank, kept within smallest and largest 
+//		samples; p = 0 and p = 1 are exact.
+//	param hist: histogram
+//	param p: percentile as a fraction in [0, 1]
+//	return: value below which fraction p of samples lies; zero if none
+A3_INLINE a3real a3statsHistogramPercentile(const a3statsHistogram *hist, const a3real p);
+
+
 //-----------------------------------------------------------------------------
 
 
@@ -47,6 +47,9 @@ A3_BEGIN_DECL
 //		the table should be (samplesPerDegree x 720 + 1) x 3
 //	return: number of values if success
 //	return: 0 if fail
+// Trig functions below work without tables: until tables are set, or after 
+//	they are freed, they evaluate polynomials instead (see 'a3sinrPoly'), so 
+//	a caller that does not want the memory may skip this entirely.
 A3_INLINE a3index a3trigInit(const a3index samplesPerDegree, a3real table_out[]);
 
 // A3: Set pointer to existing table and samples per degree.
@@ -62,7 +65,7 @@ A3_INLINE a3index a3trigInitSetTables(const a3index samplesPerDegree, const a3re
 //	return: number of values required (for pre-allocation)
 A3_INLINE a3index a3trigInitSamplesRequired(const a3index samplesPerDegree);
 
-// A3: Delete trig data tables.
+// A3: Delete trig data tables; trig functions use polynomials after this.
 //	return: 1 if success
 //	return: 0 if fail
 A3_INLINE a3index a3trigFree();
@@ -99,7 +102,8 @@ A3_INLINE a3real a3trigValid_atan(a3real x);
 
 //-----------------------------------------------------------------------------
 // trig and inverse-trig functions
-// compute more precise trig functions by using interpolation
+// compute more precise trig functions by using interpolation; without 
+//	tables these call the polynomial functions below at the current tier
 // sin, cos, tan assume input is [-360, +360] degrees or [-2pi, +2pi] radians, 
 //	return value in [-1, +1] for sin, cos and (-inf, +inf) for tan
 // arcsin assumes input is [-1, +1], 
@@ -303,6 +307,126 @@ A3_INLINE a3real a3trigTaylor_sind_cosd(const a3real x, a3real *sin_out, a3real
 A3_INLINE a3real a3trigTaylor_sinr_cosr(const a3real x, a3real *sin_out, a3real *cos_out);
 
 
+//-----------------------------------------------------------------------------
+// A3: Polynomial trig functions: minimax polynomials after range reduction, 
+//		no tables and no loops over iterations; the same arithmetic runs four 
+//		values at a time in the batch functions (see 'a3batch.h'). 
+//	Sine and cosine accept any input up to about 10^4 radians (tables are 
+//		limited to one turn either way); inverse sine and cosine clamp input 
+//		to [-1, +1]; atan2 returns the full range [-pi, +pi].
+//	Coefficients are fit for single precision, so the high tier does not 
+//		improve when a3real is double.
+
+// A3: Accuracy tiers for polynomial trig functions; each lists the largest 
+//		absolute error of sine and cosine (inverse functions are similar).
+enum a3trigPolyTier
+{
+	a3trigPoly_low,		// 3e-4: fewest terms, close to the tables
+	a3trigPoly_medium,	// 1e-6: default
+	a3trigPoly_high		// 1e-7: single-precision rounding
+};
+
+
+// A3: Set the accuracy tier used by polynomial trig functions, and by table 
+//		functions while no tables are set.
+//	param tier: new tier (a3trigPolyTier)
+//	return: old tier
+A3_INLINE a3index a3trigSetPolyTier(const a3index tier);
+
+// A3: Get the accuracy tier used by polynomial trig functions.
+//	return: tier (a3trigPolyTier)
+A3_INLINE a3index a3trigGetPolyTier();
+
+
+// A3: Calculate sine using a polynomial given radian input.
+//	param x: input to function in radians
+//	return: sin(x), range [-1, +1]
+A3_INLINE a3real a3sinrPoly(const a3real x);
+
+// A3: Calculate cosine using a polynomial given radian input.
+//	param x: input to function in radians
+//	return: cos(x), range [-1, +1]
+A3_INLINE a3real a3cosrPoly(const a3real x);
+
+// A3: Calculate tangent using a polynomial given radian input.
+//	param x: input to function in radians
+//	return: tan(x), range (-inf, +inf)
+A3_INLINE a3real a3tanrPoly(const a3real x);
+
+// A3: Calculate sine using a polynomial given degree input.
+//	param x: input to function in degrees
+//	return: sin(x), range [-1, +1]
+A3_INLINE a3real a3sindPoly(const a3real x);
+
+// A3: Calculate cosine using a polynomial given degree input.
+//	param x: input to function in degrees
+//	return: cos(x), range [-1, +1]
+A3_INLINE a3real a3cosdPoly(const a3real x);
+
+// A3: Calculate tangent using a polynomial given degree input.
+//	param x: input to function in degrees
+//	return: tan(x), range (-inf, +inf)
+A3_INLINE a3real a3tandPoly(const a3real x);
+
+// A3: Calculate sine and cosine using polynomials given radian input; 
+//		shares one range reduction.
+//	param x: input to function in radians
+//	param sin_out: pointer to value to store sine result, range [-1, +1]
+//	param cos_out: pointer to value to store cosine result, range [-1, +1]
+//	return: x (original input for reuse)
+A3_INLINE a3real a3trigPoly_sinr_cosr(const a3real x, a3real *sin_out, a3real *cos_out);
+
+// A3: Calculate sine and cosine using polynomials given degree input.
+//	param x: input to function in degrees
+//	param sin_out: pointer to value to store sine result, range [-1, +1]
+//	param cos_out: pointer to value to store cosine result, range [-1, +1]
+//	return: x (original input for reuse)
+A3_INLINE a3real a3trigPoly_sind_cosd(const a3real x, a3real *sin_out, a3real *cos_out);
+
+// A3: Calculate inverse sine using a polynomial with radian output.
+//	param x: input to function, domain [-1, +1]
+//	return: asin(x) in radians, range [-pi/2, +pi/2]
+A3_INLINE a3real a3asinrPoly(const a3real x);
+
+// A3: Calculate inverse cosine using a polynomial with radian output.
+//	param x: input to function, domain [-1, +1]
+//	return: acos(x) in radians, range [0, +pi]
+A3_INLINE a3real a3acosrPoly(const a3real x);
+
+// A3: Calculate inverse tangent using a polynomial with radian output.
+//	param x: input to function, domain (-inf, +inf)
+//	return: atan(x) in radians, range (-pi/2, +pi/2)
+A3_INLINE a3real a3atanrPoly(const a3real x);
+
+// A3: Calculate inverse tangent of y/x using a polynomial with radian 
+//		output; quadrant follows the signs of y and x.
+//	param y: numerator used to calculate tangent
+//	param x: denominator used to calculate tangent
+//	return: atan2(y, x) in radians, range [-pi, +pi]; 0 if both are 0
+A3_INLINE a3real a3atan2rPoly(const a3real y, const a3real x);
+
+// A3: Calculate inverse sine using a polynomial with degree output.
+//	param x: input to function, domain [-1, +1]
+//	return: asin(x) in degrees, range [-90, +90]
+A3_INLINE a3real a3asindPoly(const a3real x);
+
+// A3: Calculate inverse cosine using a polynomial with degree output.
+//	param x: input to function, domain [-1, +1]
+//	return: acos(x) in degrees, range [0, +180]
+A3_INLINE a3real a3acosdPoly(const a3real x);
+
+// A3: Calculate inverse tangent using a polynomial with degree output.
+//	param x: input to function, domain (-inf, +inf)
+//	return: atan(x) in degrees, range (-90, +90)
+A3_INLINE a3real a3atandPoly(const a3real x);
+
+// A3: Calculate inverse tangent of y/x using a polynomial with degree output.
+//	param y: numerator used to calculate tangent
+//	param x: denominator used to calculate tangent
+//	return: atan2(y, x) in degrees, range [-180, +180]; 0 if both are 0
+A3_INLINE a3real a3atan2dPoly(const a3real y, const a3real x);
+
+
 //-----------------------------------------------------------------------------
 // A3: Other trig-related operations: 
 // compute the error ratio occurring from discrete geometry sampling
@@ -31,6 +31,7 @@
 #include "animal3D/a3/a3macros.h"
 #include "animal3D/a3/a3types_integer.h"
 #include "animal3D/a3/a3types_real.h"
+#include "a3simd.h"
 
 
 A3_BEGIN_DECL
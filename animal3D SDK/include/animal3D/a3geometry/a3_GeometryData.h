@@ -41,6 +41,7 @@ extern "C"
 {
 #else	// !__cplusplus
 	typedef struct a3_GeometryData				a3_GeometryData;
+	typedef struct a3_GeometryDispatcher		a3_GeometryDispatcher;
 	typedef enum a3_GeometryVertexAttributeName	a3_GeometryVertexAttributeName;
 #endif	// __cplusplus
 
@@ -76,6 +77,7 @@ extern "C"
 	//	member data: pointer to raw geometry data; should be null if unused
 	//	member attribData: array of pointers to specific attribute data
 	//	member indexData: pointer to indexing data (may not be used)
+	//	member bounds: bounding box and sphere of positions
 	struct a3_GeometryData
 	{
 		a3_VertexFormatDescriptor vertexFormat[1];
@@ -85,6 +87,24 @@ extern "C"
 		void *data;
 		const void *attribData[a3attrib_geomNameMax];
 		const void *indexData;
+		a3_VertexBounds bounds[1];
+	};
+
+	// A3: Task run by a dispatcher: processes one index of a batch.
+	typedef void(*a3_GeometryTask)(void *args, a3ui32 index);
+
+	// A3: Job dispatcher supplied by the caller, so geometry work can run 
+	//		on threads the caller owns (e.g. a worker pool).
+	//	member run: runs every index of a batch of tasks, on any threads, 
+	//		and returns once all have finished
+	//	member context: passed to run as its first argument
+	//	member taskCount: number of tasks to split a batch into; zero or 
+	//		one keeps work on the calling thread
+	struct a3_GeometryDispatcher
+	{
+		void(*run)(void *context, a3_GeometryTask task, void *args, a3ui32 taskCount);
+		void *context;
+		a3ui32 taskCount;
 	};
 
 
@@ -99,6 +119,19 @@ extern "C"
 	//	return: -1 if invalid params
 	a3ret a3geometryCreateVertexFormat(a3_VertexFormatDescriptor *vertexFormat_out, const a3_GeometryVertexAttributeName *attribNameList, a3ui32 attribNameCount);
 
+	// A3: Create compact vertex format descriptor given a list of geometry 
+	//		attribute names: positions and texture coordinates are 16-bit 
+	//		normalized within the mesh bounds, normals and tangent basis are 
+	//		16-bit octahedral, colors are half-float and blend weights are 
+	//		16-bit normalized; data must be encoded to match (see demo 
+	//		geometry quantizer) and decoded in the vertex shader.
+	//	param vertexFormat_out: the vertex format to be stored
+	//	param attribNameList: non-null array of geometry attribute names
+	//	param attribNameCount: non-zero count of attribute names, less than max
+	//	return: total number of attributes specified if success
+	//	return: -1 if invalid params
+	a3ret a3geometryCreateVertexFormatQuantized(a3_VertexFormatDescriptor *vertexFormat_out, const a3_GeometryVertexAttributeName *attribNameList, a3ui32 attribNameCount);
+
 	// A3: Create index format descriptor given max size of buffer.
 	//	param indexFormat_out: the index format to be stored
 	//	param vertexCount: non-zero max number of vertices referred to; needed 
@@ -153,6 +186,23 @@ extern "C"
 	//	return: -1 if invalid params
 	a3ret a3geometryGetAddressBlendingInd(const void **attribDataPtr_out, const a3_GeometryData *geom);
 
+	// A3: Get the vertex attribute slot that stores a geometry attribute; 
+	//		the two names after the last geometry attribute are the 
+	//		implicit bitangent and blend indices.
+	//	param geomAttribName: geometry attribute name, or 
+	//		a3attrib_geomNameMax + 0 (bitangent) or + 1 (blend indices)
+	//	return: vertex attribute name if success
+	//	return: -1 if invalid params
+	a3ret a3geometryGetVertexAttribName(const a3ui32 geomAttribName);
+
+	// A3: Read the indices of geometry into a 32-bit array.
+	//	param indices_out: non-null array with room for all indices
+	//	param geom: non-null pointer to initialized indexed descriptor
+	//	return: number of indices read if success
+	//	return: 0 if geometry is not indexed
+	//	return: -1 if invalid params
+	a3ret a3geometryGetIndices(a3ui32 *indices_out, const a3_GeometryData *geom);
+
 
 //-----------------------------------------------------------------------------
 
@@ -188,6 +238,47 @@ extern "C"
 	//	return: -1 if invalid params
 	a3ret a3geometryGenerateDrawable(a3_VertexDrawable *drawable_out, const a3_GeometryData *geom, a3_VertexArrayDescriptor *vertexArray, a3_IndexBuffer *indexBuffer, const a3_IndexFormatDescriptor *commonIndexFormat_opt, a3ui32 *vertexBufferOffset_out_opt, a3ui32 *indexBufferOffset_out_opt);
 
+	// A3: Recalculate smooth normals, tangents and bitangents of triangle 
+	//		geometry from positions and texture coordinates: face bases 
+	//		are computed four at a time, each task sums its faces into 
+	//		its own vertex totals and the totals are combined and 
+	//		orthonormalized.
+	//	param geom: non-null pointer to geometry with float tangent basis
+	//	param dispatcher_opt: optional dispatcher to share the work; small 
+	//		meshes use fewer tasks; null runs on the calling thread
+	//	return: number of vertices updated if success
+	//	return: 0 if fail (not triangles, no tangent basis or not float)
+	//	return: -1 if invalid params
+	a3ret a3geometryCalculateTangentBasis(a3_GeometryData *geom, const a3_GeometryDispatcher *dispatcher_opt);
+
+	// A3: Calculate bounding box and sphere of a list of positions; the 
+	//		sphere is centered on the box.
+	//	param bounds_out: non-null pointer to bounds to store
+	//	param positions: non-null array of tightly packed vec3 positions
+	//	param count: number of positions; bounds are zeroed if none
+	//	return: 1 if success
+	//	return: 0 if no positions
+	//	return: -1 if invalid params
+	a3ret a3geometryCalculatePositionBounds(a3_VertexBounds *bounds_out, const a3f32 *positions, const a3ui32 count);
+
+	// A3: Recalculate stored bounds of geometry from its positions; called 
+	//		by the procedural generator and model loader.
+	//	param geom: non-null pointer to initialized geometry
+	//	return: 1 if success
+	//	return: 0 if positions are not float vectors (bounds are kept)
+	//	return: -1 if invalid params
+	a3ret a3geometryCalculateBounds(a3_GeometryData *geom);
+
+	// A3: Transform bounds, e.g. from object space to world space; the box 
+	//		is fitted around the transformed box and the sphere radius is 
+	//		scaled by the largest axis scale.
+	//	param bounds_out: non-null pointer to bounds to store; may be input
+	//	param bounds: non-null pointer to bounds to transform
+	//	param transform: non-null column-major 4x4 affine matrix
+	//	return: 1 if success
+	//	return: -1 if invalid params
+	a3ret a3geometryTransformBounds(a3_VertexBounds *bounds_out, const a3_VertexBounds *bounds, const a3f32 *transform);
+
 
 //-----------------------------------------------------------------------------
 
@@ -42,6 +42,8 @@ extern "C"
 	typedef enum a3_ProceduralGeometryShape				a3_ProceduralGeometryShape;
 	typedef enum a3_ProceduralGeometryFlag				a3_ProceduralGeometryFlag;
 	typedef enum a3_ProceduralGeometryAxis				a3_ProceduralGeometryAxis;
+	typedef struct a3_ProceduralGeometryCacheEntry		a3_ProceduralGeometryCacheEntry;
+	typedef struct a3_ProceduralGeometryCache			a3_ProceduralGeometryCache;
 #endif	// __cplusplus
 
 
@@ -111,6 +113,34 @@ extern "C"
 	};
 
 
+	// A3: Generated shape stored in a procedural geometry cache.
+	//	member geom: descriptor the shape was generated from
+	//	member record: copy of geometry (see 'a3geometryCopyDataToString')
+	//	member size: size of record in bytes
+	struct a3_ProceduralGeometryCacheEntry
+	{
+		a3_ProceduralGeometryDescriptor geom[1];
+		a3byte *record;
+		a3ui32 size;
+	};
+
+	// A3: Cache of generated procedural shapes keyed by whole descriptor 
+	//		(shape, flags, axis and all parameters); zero-initialize.
+	//	member entry: stored shapes, oldest first
+	//	members count, capacity: number of stored shapes and space for them
+	//	member size: total size of stored records in bytes
+	//	member sizeMax: most bytes kept; the oldest shapes are dropped to 
+	//		make room for new ones; zero keeps up to 64 MiB
+	//	members hits, misses: shapes copied from cache and shapes generated
+	struct a3_ProceduralGeometryCache
+	{
+		a3_ProceduralGeometryCacheEntry *entry;
+		a3ui32 count, capacity;
+		a3ui32 size, sizeMax;
+		a3ui32 hits, misses;
+	};
+
+
 //-----------------------------------------------------------------------------
 	// A3: Create descriptors.
 	// NOTE: for all shapes, entering invalid params will not result in the 
@@ -367,6 +397,42 @@ extern "C"
 	//	return: -1 if invalid params
 	a3ret a3proceduralGenerateGeometryData(a3_GeometryData *geomData_out, const a3_ProceduralGeometryDescriptor *geom, const a3f32 *transform_opt);
 
+	// A3: Generate data for a list of procedural shapes, split into tasks 
+	//		run by a dispatcher; largest shapes are handed out first.
+	//	param geomData_out: non-null array of uninitialized geometry data
+	//	param geom: non-null array of initialized procedural shape descriptors
+	//	param count: number of shapes
+	//	param dispatcher_opt: optional pointer to dispatcher running the 
+	//		tasks (at most 8); all shapes are generated on the calling 
+	//		thread if null
+	//	return: number of shapes generated if success
+	//	return: 0 if none generated
+	//	return: -1 if invalid params
+	a3ret a3proceduralGenerateGeometryDataBatch(a3_GeometryData *geomData_out, const a3_ProceduralGeometryDescriptor *geom, const a3ui32 count, const a3_GeometryDispatcher *dispatcher_opt);
+
+	// A3: Generate data for a list of procedural shapes through a cache: 
+	//		shapes generated before are copied from the cache, the rest 
+	//		are generated once each as a batch and stored.
+	//	param cache: non-null pointer to cache
+	//	param geomData_out: non-null array of zero-initialized geometry 
+	//		data; entries already holding data are skipped; released as 
+	//		usual (see 'a3geometryReleaseData')
+	//	param geom: non-null array of initialized procedural shape descriptors
+	//	param count: number of shapes
+	//	param dispatcher_opt: optional pointer to dispatcher generating new 
+	//		shapes (see 'a3proceduralGenerateGeometryDataBatch')
+	//	return: number of shapes stored in outputs if success
+	//	return: 0 if none stored
+	//	return: -1 if invalid params
+	a3ret a3proceduralCacheGenerate(a3_ProceduralGeometryCache *cache, a3_GeometryData *geomData_out, const a3_ProceduralGeometryDescriptor *geom, const a3ui32 count, const a3_GeometryDispatcher *dispatcher_opt);
+
+	// A3: Release all shapes stored in cache; the size limit is kept.
+	//	param cache: non-null pointer to cache
+	//	return: 1 if success
+	//	return: 0 if cache is empty
+	//	return: -1 if invalid params
+	a3ret a3proceduralCacheRelease(a3_ProceduralGeometryCache *cache);
+
 
 //-----------------------------------------------------------------------------
 
@@ -22,3 +22,28 @@
 	Common utilities for vertex shaders.
 */
 
+
+// restore position from quantized vertex format (16-bit normalized within 
+//	mesh bounds); scale and bias are the mesh's dequantization transform, 
+//	with w components 0 and 1
+vec4 dequantizePosition(in vec4 aPositionQuantized, in vec4 uPositionScale, in vec4 uPositionBias)
+{
+	return (aPositionQuantized * uPositionScale + uPositionBias);
+}
+
+// restore texture coordinate from quantized vertex format; transform holds 
+//	scale in xy and bias in zw
+vec2 dequantizeTexcoord(in vec2 aTexcoordQuantized, in vec4 uTexcoordTransform)
+{
+	return (aTexcoordQuantized * uTexcoordTransform.xy + uTexcoordTransform.zw);
+}
+
+// restore unit vector (normal, tangent or bitangent) from 16-bit octahedral 
+//	encoding in quantized vertex format
+vec3 decodeOctahedral(in vec2 aDirectionQuantized)
+{
+	vec3 n = vec3(aDirectionQuantized, 1.0 - abs(aDirectionQuantized.x) - abs(aDirectionQuantized.y));
+	if (n.z < 0.0)
+		n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+	return normalize(n);
+}
@@ -0,0 +1,45 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	passthru_transform_quantized_vs4x.glsl
+	Transform position attribute stored in the quantized vertex format.
+*/
+
+#version 450
+
+layout (location = 0) in vec4 aPosition;
+
+uniform mat4 uMVP;
+uniform vec4 uPositionScale, uPositionBias;
+
+flat out int vVertexID;
+flat out int vInstanceID;
+
+// utilCommon_vs4x
+vec4 dequantizePosition(in vec4 aPositionQuantized, in vec4 uPositionScale, in vec4 uPositionBias);
+
+void main()
+{
+	// restore object-space position within mesh bounds, then transform
+	gl_Position = uMVP * dequantizePosition(aPosition, uPositionScale, uPositionBias);
+
+	vVertexID = gl_VertexID;
+	vInstanceID = gl_InstanceID;
+}
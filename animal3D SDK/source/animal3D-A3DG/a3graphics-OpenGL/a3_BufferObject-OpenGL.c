@@ -35,13 +35,13 @@
 
 inline a3ui16 a3bufferInternalFlag(const a3_BufferObjectType bufferType)
 {
-	static const a3ui16 bufferBindings[] = { GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_UNIFORM_BUFFER, };
+	static const a3ui16 bufferBindings[] = { GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_UNIFORM_BUFFER, GL_PIXEL_UNPACK_BUFFER, };
 	return bufferBindings[bufferType];
 }
 
 inline a3ui16 a3bufferInternalFillHint(const a3_BufferObjectType bufferType)
 {
-	static const a3ui16 bufferFillHint[] = { GL_STATIC_DRAW, GL_STATIC_DRAW, GL_DYNAMIC_DRAW, };
+	static const a3ui16 bufferFillHint[] = { GL_STATIC_DRAW, GL_STATIC_DRAW, GL_DYNAMIC_DRAW, GL_STREAM_DRAW, };
 	return bufferFillHint[bufferType];
 }
 
@@ -208,5 +208,43 @@ a3ret a3bufferDeactivateType(const a3_BufferObjectType bufferType)
 	return 0;
 }
 
+a3ret a3bufferMap(const a3_BufferObject *buffer, const a3ui32 offset, const a3ui32 size, void **data_out)
+{
+	if (buffer && buffer->handle->handle && size && data_out)
+	{
+		if (offset + size <= buffer->size)
+		{
+			// whole buffer is orphaned so the driver never waits on draws 
+			//	still reading the previous contents
+			const a3ui32 invalidate = (offset == 0 && size == buffer->size) ? GL_MAP_INVALIDATE_BUFFER_BIT : GL_MAP_INVALIDATE_RANGE_BIT;
+			glBindBuffer(buffer->internalBinding, buffer->handle->handle);
+			*data_out = glMapBufferRange(buffer->internalBinding, offset, size, GL_MAP_WRITE_BIT | invalidate);
+			glBindBuffer(buffer->internalBinding, 0);
+			if (*data_out)
+				return 1;
+			printf("\n A3 ERROR (BUF %u \'%s\'): \n\t Mapping failed; buffer not mapped.", buffer->handle->handle, buffer->handle->name);
+		}
+		else
+			printf("\n A3 ERROR (BUF %u \'%s\'): \n\t Invalid range; buffer not mapped.", buffer->handle->handle, buffer->handle->name);
+
+		// fail
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3bufferUnmap(const a3_BufferObject *buffer)
+{
+	a3ret result;
+	if (buffer && buffer->handle->handle)
+	{
+		glBindBuffer(buffer->internalBinding, buffer->handle->handle);
+		result = (glUnmapBuffer(buffer->internalBinding) == GL_TRUE);
+		glBindBuffer(buffer->internalBinding, 0);
+		return result;
+	}
+	return -1;
+}
+
 
 //-----------------------------------------------------------------------------
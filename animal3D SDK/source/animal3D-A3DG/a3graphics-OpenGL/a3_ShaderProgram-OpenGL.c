@@ -32,6 +32,11 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if (defined _WINDOWS || defined _WIN32)
+#include <Windows.h>
+#endif	// (defined _WINDOWS || defined _WIN32)
 
 
 //-----------------------------------------------------------------------------
@@ -83,7 +88,72 @@ void a3shaderProgramInternalReleaseFunc(a3i32 count, a3ui32 *handlePtr)
 
 //-----------------------------------------------------------------------------
 
-a3ret a3shaderCreateFromSourceList(a3_Shader *shader_out, const a3byte name_opt[32], const a3_ShaderType type, const a3byte **sourceList, const a3ui32 count)
+// the bundled GLEW predates GL_KHR_parallel_shader_compile, so the KHR 
+//	extension is found in the extension list and its entry point is loaded 
+//	here; its completion status query matches the ARB one
+#ifndef GL_KHR_parallel_shader_compile
+#define GL_KHR_parallel_shader_compile 1
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+typedef void (GLAPIENTRY * PFNGLMAXSHADERCOMPILERTHREADSKHRPROC) (GLuint count);
+#endif	// !GL_KHR_parallel_shader_compile
+
+static PFNGLMAXSHADERCOMPILERTHREADSKHRPROC a3shaderInternalMaxShaderCompilerThreadsKHR;
+
+// parallel compilation extension in use
+enum a3_ShaderInternalParallel
+{
+	a3shaderInternalParallel_none,
+	a3shaderInternalParallel_ARB,
+	a3shaderInternalParallel_KHR,
+};
+
+// check for driver-side parallel compilation; prefers KHR, which has a 
+//	core-style entry point, then ARB
+a3ret a3shaderInternalIsParallel()
+{
+	static a3i32 parallel = -1;
+	a3i32 count, i;
+	const a3byte *name;
+	if (parallel < 0)
+	{
+		parallel = a3shaderInternalParallel_none;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+		for (i = 0; i < count; ++i)
+		{
+			name = (const a3byte *)glGetStringi(GL_EXTENSIONS, i);
+			if (name && !strcmp(name, "GL_KHR_parallel_shader_compile"))
+			{
+#if (defined _WINDOWS || defined _WIN32)
+				a3shaderInternalMaxShaderCompilerThreadsKHR = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)wglGetProcAddress("glMaxShaderCompilerThreadsKHR");
+#endif	// (defined _WINDOWS || defined _WIN32)
+				if (a3shaderInternalMaxShaderCompilerThreadsKHR)
+					parallel = a3shaderInternalParallel_KHR;
+				break;
+			}
+		}
+		if (parallel == a3shaderInternalParallel_none && GLEW_ARB_parallel_shader_compile)
+			parallel = a3shaderInternalParallel_ARB;
+	}
+	return parallel;
+}
+
+// check if shader or program is done working; always done if not parallel
+a3boolean a3shaderInternalIsComplete(const a3boolean isProgram, const a3ui32 handle)
+{
+	a3i32 status = GL_TRUE;
+	if (a3shaderInternalIsParallel())
+	{
+		if (isProgram)
+			glGetProgramiv(handle, GL_COMPLETION_STATUS_ARB, &status);
+		else
+			glGetShaderiv(handle, GL_COMPLETION_STATUS_ARB, &status);
+	}
+	return (status == GL_TRUE);
+}
+
+// create shader; if async, compile is issued but status is not queried
+a3ret a3shaderInternalCreateFromSourceList(a3_Shader *shader_out, const a3byte name_opt[32], const a3_ShaderType type, const a3byte **sourceList, const a3ui32 count, const a3boolean async)
 {
 	static const a3ui16 internalShaderType[] = { GL_VERTEX_SHADER, GL_TESS_CONTROL_SHADER, GL_TESS_EVALUATION_SHADER, GL_GEOMETRY_SHADER, GL_FRAGMENT_SHADER, GL_COMPUTE_SHADER };
 
@@ -126,7 +196,12 @@ a3ret a3shaderCreateFromSourceList(a3_Shader *shader_out, const a3byte name_opt[
 					// attach sources, compile
 					glShaderSource(handle, newCount, valid, 0);
 					glCompileShader(handle);
-					glGetShaderiv(handle, GL_COMPILE_STATUS, &status);
+
+					// async: assume success, errors are reported on link
+					if (async)
+						status = GL_TRUE;
+					else
+						glGetShaderiv(handle, GL_COMPILE_STATUS, &status);
 					if (status)
 					{
 						// finished
@@ -155,6 +230,30 @@ a3ret a3shaderCreateFromSourceList(a3_Shader *shader_out, const a3byte name_opt[
 	return -1;
 }
 
+a3ret a3shaderCreateFromSourceList(a3_Shader *shader_out, const a3byte name_opt[32], const a3_ShaderType type, const a3byte **sourceList, const a3ui32 count)
+{
+	return a3shaderInternalCreateFromSourceList(shader_out, name_opt, type, sourceList, count, 0);
+}
+
+a3ret a3shaderCreateFromSourceListAsync(a3_Shader *shader_out, const a3byte name_opt[32], const a3_ShaderType type, const a3byte **sourceList, const a3ui32 count)
+{
+	return a3shaderInternalCreateFromSourceList(shader_out, name_opt, type, sourceList, count, 1);
+}
+
+a3ret a3shaderParallelCompileEnable(const a3ui32 maxThreads)
+{
+	switch (a3shaderInternalIsParallel())
+	{
+	case a3shaderInternalParallel_KHR:
+		a3shaderInternalMaxShaderCompilerThreadsKHR(maxThreads);
+		return a3shaderInternalParallel_KHR;
+	case a3shaderInternalParallel_ARB:
+		glMaxShaderCompilerThreadsARB(maxThreads);
+		return a3shaderInternalParallel_ARB;
+	}
+	return 0;
+}
+
 
 //-----------------------------------------------------------------------------
 
@@ -289,6 +388,8 @@ a3ret a3shaderProgramLink(a3_ShaderProgram *program)
 				//	- else, print error message
 				//	***DO NOT DELETE PROGRAM!!! we may have a contingency plan!
 
+				// hint that the binary may be retrieved for caching
+				glProgramParameteri(pHandle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 				glLinkProgram(pHandle);
 				glGetProgramiv(pHandle, GL_LINK_STATUS, &status);
 				if (status)
@@ -311,6 +412,75 @@ a3ret a3shaderProgramLink(a3_ShaderProgram *program)
 	return -1;
 }
 
+a3ret a3shaderProgramLinkAsync(a3_ShaderProgram *program)
+{
+	a3ui32 pHandle;
+
+	if (program)
+	{
+		pHandle = program->handle->handle;
+		if (pHandle)
+		{
+			if (!program->linked)
+			{
+				// same as link but status is left for polling
+				glProgramParameteri(pHandle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+				glLinkProgram(pHandle);
+				return 1;
+			}
+			else
+				printf("\n A3 WARNING (PROG %u \'%s\'): \n\t Program already linked; program not re-linked.", pHandle, program->handle->name);
+
+			// fail
+			return 0;
+		}
+	}
+	return -1;
+}
+
+a3ret a3shaderProgramLinkPoll(a3_ShaderProgram *program)
+{
+	a3ui32 pHandle, i;
+	a3i32 status;
+
+	if (program)
+	{
+		pHandle = program->handle->handle;
+		if (pHandle)
+		{
+			if (!program->linked)
+			{
+				// still working
+				if (!a3shaderInternalIsComplete(1, pHandle))
+					return 0;
+
+				glGetProgramiv(pHandle, GL_LINK_STATUS, &status);
+				if (status)
+				{
+					// good
+					program->linked = 1;
+					return 1;
+				}
+
+				// failed: report shaders that did not compile, then program
+				for (i = 0; i < 6; ++i)
+				{
+					if (program->shadersAttached[i])
+					{
+						glGetShaderiv((a3ui16)program->shadersAttached[i], GL_COMPILE_STATUS, &status);
+						if (!status)
+							a3shaderInternalPrintLog(0, 0, (a3ui16)program->shadersAttached[i], program->handle->name);
+					}
+				}
+				a3shaderInternalPrintLog(1, 1, pHandle, program->handle->name);
+			}
+			else
+				return 1;
+		}
+	}
+	return -1;
+}
+
 a3ret a3shaderProgramValidate(a3_ShaderProgram *program)
 {
 	a3ui32 pHandle;
@@ -51,6 +51,12 @@
 #undef _A3_UNICODE_UNDEF
 #endif	// _A3_UNICODE_UNDEF
 
+#if (defined _WINDOWS || defined _WIN32)
+#include <Windows.h>
+#else	// !(defined _WINDOWS || defined _WIN32)
+#include <pthread.h>
+#endif	// (defined _WINDOWS || defined _WIN32)
+
 
 //-----------------------------------------------------------------------------
 
@@ -65,6 +71,31 @@ void a3textureInternalHandleReleaseFunc(a3i32 count, a3ui32 *handlePtr)
 }
 
 
+// image library keeps a single bound image, so decoding from several 
+//	threads at once must be serialized
+#if (defined _WINDOWS || defined _WIN32)
+static SRWLOCK a3textureInternalImageLibraryLock = SRWLOCK_INIT;
+inline void a3textureInternalImageLibraryAcquire()
+{
+	AcquireSRWLockExclusive(&a3textureInternalImageLibraryLock);
+}
+inline void a3textureInternalImageLibraryRelease()
+{
+	ReleaseSRWLockExclusive(&a3textureInternalImageLibraryLock);
+}
+#else	// !(defined _WINDOWS || defined _WIN32)
+static pthread_mutex_t a3textureInternalImageLibraryLock = PTHREAD_MUTEX_INITIALIZER;
+inline void a3textureInternalImageLibraryAcquire()
+{
+	pthread_mutex_lock(&a3textureInternalImageLibraryLock);
+}
+inline void a3textureInternalImageLibraryRelease()
+{
+	pthread_mutex_unlock(&a3textureInternalImageLibraryLock);
+}
+#endif	// (defined _WINDOWS || defined _WIN32)
+
+
 //-----------------------------------------------------------------------------
 
 a3ret a3textureCreatePixelFormatDescriptor(a3_TexturePixelFormatDescriptor *pixelFormat_out, const a3_TexturePixelType pixelType)
@@ -88,6 +119,10 @@ a3ret a3textureCreatePixelFormatDescriptor(a3_TexturePixelFormatDescriptor *pixe
 		{ GL_DEPTH_COMPONENT,	GL_DEPTH_COMPONENT24,	GL_UNSIGNED_INT,	1, 4 },
 		{ GL_DEPTH_COMPONENT,	GL_DEPTH_COMPONENT32,	GL_UNSIGNED_INT,	1, 4 },
 		{ GL_DEPTH_STENCIL,		GL_DEPTH24_STENCIL8,	GL_UNSIGNED_INT_24_8,	1, 4 },
+		{ GL_RGB,	GL_COMPRESSED_RGB_S3TC_DXT1_EXT,	GL_UNSIGNED_BYTE,	3, 1 },
+		{ GL_RGBA,	GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,	GL_UNSIGNED_BYTE,	4, 1 },
+		{ GL_RED,	GL_COMPRESSED_RED_RGTC1,			GL_UNSIGNED_BYTE,	1, 1 },
+		{ GL_RG,	GL_COMPRESSED_RG_RGTC2,				GL_UNSIGNED_BYTE,	2, 1 },
 	};
 
 	if (pixelFormat_out)
@@ -99,6 +134,32 @@ a3ret a3textureCreatePixelFormatDescriptor(a3_TexturePixelFormatDescriptor *pixe
 }
 
 
+a3ret a3textureGetCompressedBlockSize(const a3_TexturePixelFormatDescriptor *pixelFormat)
+{
+	if (pixelFormat)
+	{
+		switch (pixelFormat->internalFormatBits)
+		{
+		case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+		case GL_COMPRESSED_RED_RGTC1:
+			return 8;
+		case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+		case GL_COMPRESSED_RG_RGTC2:
+			return 16;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3textureCompressionSupported()
+{
+	// RGTC is core since 3.0; S3TC is still an extension
+	return (glewIsSupported("GL_EXT_texture_compression_s3tc") && 
+		(GLEW_VERSION_3_0 || glewIsSupported("GL_ARB_texture_compression_rgtc")));
+}
+
+
 //-----------------------------------------------------------------------------
 
 a3ret a3textureInitializeImageLibrary()
@@ -136,6 +197,7 @@ a3ret a3textureCreateFromFile(a3_Texture *texture_out, const a3byte name_opt[32]
 			a3ui32 width, height, channels, bytes;
 
 			// generate IL handle
+			a3textureInternalImageLibraryAcquire();
 			ilHandle = ilGenImage();
 			if (ilHandle)
 			{
@@ -194,6 +256,7 @@ a3ret a3textureCreateFromFile(a3_Texture *texture_out, const a3byte name_opt[32]
 				// delete IL image
 				ilDeleteImage(ilHandle);
 			}
+			a3textureInternalImageLibraryRelease();
 
 			// done
 			return result;
@@ -269,6 +332,144 @@ a3ret a3textureCreateFromData(a3_Texture *texture_out, const a3byte name_opt[32]
 	return -1;
 }
 
+a3ret a3textureCreateFromMipData(a3_Texture *texture_out, const a3byte name_opt[32], const a3_TexturePixelFormatDescriptor *pixelFormat, const a3ui32 width, const a3ui32 height, const a3ui32 levelCount, const void *const *levelData)
+{
+	a3_Texture ret = { 0 };
+	a3ui32 handle, level, levelWidth, levelHeight;
+	a3i32 blockSize;
+
+	// validate
+	if (texture_out && pixelFormat && levelData)
+	{
+		// not in use
+		if (!texture_out->handle->handle)
+		{
+			// validate size
+			if (width && height && levelCount && levelCount <= 32 && (width >> (levelCount - 1) || height >> (levelCount - 1)))
+			{
+				// generate texture
+				glGenTextures(1, &handle);
+				if (handle)
+				{
+					// bind texture and fill each level; small levels may 
+					//	have rows that are not 4-byte aligned; compressed 
+					//	levels are whole blocks, even past the edges
+					blockSize = a3textureGetCompressedBlockSize(pixelFormat);
+					glBindTexture(GL_TEXTURE_2D, handle);
+					glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+					for (level = 0; level < levelCount; ++level)
+					{
+						levelWidth = (width >> level) ? (width >> level) : 1;
+						levelHeight = (height >> level) ? (height >> level) : 1;
+						if (blockSize > 0)
+							glCompressedTexImage2D(GL_TEXTURE_2D, level, pixelFormat->internalFormatBits, levelWidth, levelHeight, 0,
+								((levelWidth + 3) >> 2) * ((levelHeight + 3) >> 2) * blockSize, levelData[level]);
+						else
+							glTexImage2D(GL_TEXTURE_2D, level, pixelFormat->internalFormatBits, levelWidth, levelHeight,
+								0, pixelFormat->internalFormat, pixelFormat->internalDataType, levelData[level]);
+					}
+					glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+					a3textureDefaultSettings();
+					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+					glBindTexture(GL_TEXTURE_2D, 0);
+
+					// done, configure output
+					a3handleCreateHandle(ret.handle, a3textureInternalHandleReleaseFunc, name_opt, handle, 1);
+					ret.width = width;
+					ret.height = height;
+					ret.channels = pixelFormat->channelsPerPixel;
+					ret.bytes = pixelFormat->bytesPerChannel;
+					ret.internalFormat = pixelFormat->internalFormat;
+					ret.internalType = pixelFormat->internalDataType;
+
+					// set output
+					*texture_out = ret;
+					a3textureReference(texture_out);
+					return 1;
+				}
+				else
+					printf("\n A3 ERROR (TEX \'%s\'): \n\t Invalid handle; texture not created.", name_opt);
+			}
+			else
+				printf("\n A3 ERROR (TEX \'%s\'): \n\t Invalid dimensions; texture not created.", name_opt);
+
+			// fail
+			return 0;
+		}
+	}
+	return -1;
+}
+
+a3ret a3textureDecodeFile(void **data_out, a3ui32 *width_out, a3ui32 *height_out, a3_TexturePixelType *pixelType_out, const a3byte *filePath)
+{
+	if (data_out && width_out && height_out && pixelType_out && filePath)
+	{
+		a3i32 result = 0;
+		a3i32 convertFormat, convertType;
+		a3ui32 ilHandle = 0;
+		a3ui32 width, height, channels, bytes, size;
+
+		a3textureInternalImageLibraryAcquire();
+		a3textureInitializeImageLibrary();
+
+		// generate IL handle
+		ilHandle = ilGenImage();
+		if (ilHandle)
+		{
+			ilBindImage(ilHandle);
+			if (ilLoadImage(filePath))
+			{
+				width = ilGetInteger(IL_IMAGE_WIDTH);
+				height = ilGetInteger(IL_IMAGE_HEIGHT);
+				channels = ilGetInteger(IL_IMAGE_CHANNELS);
+				bytes = channels ? ilGetInteger(IL_IMAGE_BYTES_PER_PIXEL) / channels : 0;
+
+				if (width && height && channels && bytes)
+				{
+					// same conversion as loading directly to texture
+					channels = channels >= 3 ? channels <= 4 ? channels : 4 : 3;
+					bytes = bytes >= 1 ? bytes <= 2 ? bytes : 2 : 1;
+					convertFormat = channels == 3 ? IL_RGB : IL_RGBA;
+					convertType = bytes == 1 ? IL_UNSIGNED_BYTE : IL_UNSIGNED_SHORT;
+					ilConvertImage(convertFormat, convertType);
+
+					// copy out of image library
+					size = width * height * channels * bytes;
+					*data_out = malloc(size);
+					if (*data_out)
+					{
+						memcpy(*data_out, ilGetData(), size);
+						*width_out = width;
+						*height_out = height;
+						*pixelType_out = channels == 3
+							? (bytes == 1 ? a3tex_rgb8 : a3tex_rgb16)
+							: (bytes == 1 ? a3tex_rgba8 : a3tex_rgba16);
+						result = 1;
+					}
+				}
+			}
+
+			// delete IL image
+			ilDeleteImage(ilHandle);
+		}
+		a3textureInternalImageLibraryRelease();
+
+		// done
+		return result;
+	}
+	return -1;
+}
+
+a3ret a3textureReleaseDecodedData(void *data)
+{
+	if (data)
+	{
+		free(data);
+		return 1;
+	}
+	return -1;
+}
+
 a3ret a3textureReplaceData(const a3_Texture *texture, const a3ui32 offsetWidth, const a3ui32 offsetHeight, const a3ui32 replaceWidth, const a3ui32 replaceHeight, const void *data_opt, a3boolean dataFlipped)
 {
 	if (texture)
@@ -348,10 +549,10 @@ a3ret a3textureDefaultSettings()
 
 a3ret a3textureChangeFilterMode(const a3_TextureFilterOption filterOption)
 {
-	static const a3ui16 filter[] = { GL_NEAREST, GL_LINEAR, };
-	const a3ui16 option = filter[filterOption];
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, option);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, option);
+	static const a3ui16 filterMag[] = { GL_NEAREST, GL_LINEAR, GL_LINEAR, };
+	static const a3ui16 filterMin[] = { GL_NEAREST, GL_LINEAR, GL_LINEAR_MIPMAP_LINEAR, };
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filterMag[filterOption]);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filterMin[filterOption]);
 	return 1;
 }
 
@@ -37,6 +37,7 @@
 
 void a3shaderInternalReleaseFunc(a3i32 count, a3ui32 *handlePtr);
 void a3shaderProgramInternalReleaseFunc(a3i32 count, a3ui32 *handlePtr);
+a3ret a3shaderInternalCreateFromSourceList(a3_Shader *shader_out, const a3byte name_opt[32], const a3_ShaderType type, const a3byte **sourceList, const a3ui32 count, const a3boolean async);
 
 
 //-----------------------------------------------------------------------------
@@ -55,7 +56,7 @@ const a3byte *a3shaderInternalGetTypeStr(const a3_ShaderType type)
 //-----------------------------------------------------------------------------
 // shader
 
-a3ret a3shaderCreateFromFileList(a3_Shader *shader_out, const a3byte name_opt[32], const a3_ShaderType type, const a3byte **filePathList, const a3ui32 count)
+a3ret a3shaderInternalCreateFromFileList(a3_Shader *shader_out, const a3byte name_opt[32], const a3_ShaderType type, const a3byte **filePathList, const a3ui32 count, const a3boolean async)
 {
 	a3ui32 newCount, i;
 	a3i32 result;
@@ -76,7 +77,7 @@ a3ret a3shaderCreateFromFileList(a3_Shader *shader_out, const a3byte name_opt[32
 		}
 
 		// use sources to load shader
-		result = a3shaderCreateFromSourceList(shader_out, name_opt, type, valid, newCount);
+		result = a3shaderInternalCreateFromSourceList(shader_out, name_opt, type, valid, newCount, async);
 
 		// release file contents
 		for (i = 0, itr = valid; i < newCount; ++i, ++itr)
@@ -93,6 +94,16 @@ a3ret a3shaderCreateFromFileList(a3_Shader *shader_out, const a3byte name_opt[32
 	return -1;
 }
 
+a3ret a3shaderCreateFromFileList(a3_Shader *shader_out, const a3byte name_opt[32], const a3_ShaderType type, const a3byte **filePathList, const a3ui32 count)
+{
+	return a3shaderInternalCreateFromFileList(shader_out, name_opt, type, filePathList, count, 0);
+}
+
+a3ret a3shaderCreateFromFileListAsync(a3_Shader *shader_out, const a3byte name_opt[32], const a3_ShaderType type, const a3byte **filePathList, const a3ui32 count)
+{
+	return a3shaderInternalCreateFromFileList(shader_out, name_opt, type, filePathList, count, 1);
+}
+
 
 a3ret a3shaderHandleUpdateReleaseCallback(a3_Shader *shader)
 {
@@ -0,0 +1,840 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	animal3D-A3DM-Test.c
+	Standalone A3DM test: checks the functions that have SIMD paths (see
+		'a3simd.h') against plain double-precision references, for the
+		instruction set this file and 'animal3D-A3DM.c' are compiled for;
+		built once per instruction set (see 'animal3d_win_test_math.bat'),
+		so every backend is held to the same results as scalar code.
+	Needs only A3DM and the C library; returns the number of failed checks.
+*/
+
+#include "animal3D-A3DM/animal3D-A3DM.h"
+#include "animal3D-A3DM/a3math/a3batch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// square roots are assembly in the A3DM project (x86 only); the C library
+//	versions stand in so every backend, including ARM, links the same ones
+a3f32 a3sqrtf(const a3f32 x)
+{
+	return sqrtf(x);
+}
+
+a3f64 a3sqrtd(const a3f64 x)
+{
+	return sqrt(x);
+}
+
+a3f32 a3sqrtfInverse(const a3f32 x)
+{
+	return 1.0f / sqrtf(x);
+}
+
+a3f64 a3sqrtdInverse(const a3f64 x)
+{
+	return 1.0 / sqrt(x);
+}
+
+
+// test limits
+enum a3_TestSize
+{
+	testSize_item = 67,							// odd, so SIMD remainders run
+	testSize_table = 16,						// curve table divisions
+};
+
+
+// number of failed checks
+static a3ui32 a3test_failCount;
+
+// input generator independent of A3DM's own random functions
+static a3ui32 a3test_seed = 1;
+
+
+// random number in [lo, hi)
+a3real a3test_random(a3real const lo, a3real const hi)
+{
+	a3test_seed = a3test_seed * 1664525u + 1013904223u;
+	return lo + (hi - lo) * (a3real)(a3test_seed >> 8) * (a3real)(1.0 / 16777216.0);
+}
+
+// random unit quaternion
+void a3test_randomQuat(a3real q_out[4])
+{
+	a3f64 x = a3test_random(-1, 1), y = a3test_random(-1, 1), z = a3test_random(-1, 1), w = a3test_random(-1, 1);
+	a3f64 const len = sqrt(x * x + y * y + z * z + w * w);
+	x /= len;
+	y /= len;
+	z /= len;
+	w /= len;
+	q_out[0] = (a3real)x;
+	q_out[1] = (a3real)y;
+	q_out[2] = (a3real)z;
+	q_out[3] = (a3real)w;
+}
+
+// largest difference between result and reference
+a3f64 a3test_diff(a3real const* result, a3f64 const* reference, a3ui32 const count)
+{
+	a3f64 d, diff = 0.0;
+	a3ui32 i;
+	for (i = 0; i < count; ++i)
+	{
+		d = fabs((a3f64)result[i] - reference[i]);
+		if (!(d <= diff))
+			diff = (d == d) ? d : HUGE_VAL;		// NaN always fails
+	}
+	return diff;
+}
+
+// largest difference between two results that should be bitwise equal
+a3f64 a3test_diffExact(void const* result, void const* reference, a3ui32 const size)
+{
+	return memcmp(result, reference, size) ? HUGE_VAL : 0.0;
+}
+
+// record and print one check
+void a3test_check(a3byte const* name, a3f64 const diff, a3f64 const tolerance)
+{
+	a3boolean const pass = (diff <= tolerance);
+	printf("  %-36s %10.3g  (tolerance %8.3g)  %s\n", name, diff, tolerance, pass ? "ok" : "FAIL");
+	if (!pass)
+		++a3test_failCount;
+}
+
+
+// references: matrices are column-major, m[column][row]
+
+// out = mL * mR
+void a3test_refProduct(a3f64 out[16], a3real const mL[4][4], a3real const mR[4][4])
+{
+	a3ui32 c, r, k;
+	for (c = 0; c < 4; ++c)
+		for (r = 0; r < 4; ++r)
+			for (out[c * 4 + r] = 0.0, k = 0; k < 4; ++k)
+				out[c * 4 + r] += (a3f64)mL[k][r] * (a3f64)mR[c][k];
+}
+
+// out = m * v
+void a3test_refTransform(a3f64 out[4], a3real const m[4][4], a3real const v[4])
+{
+	a3ui32 r, k;
+	for (r = 0; r < 4; ++r)
+		for (out[r] = 0.0, k = 0; k < 4; ++k)
+			out[r] += (a3f64)m[k][r] * (a3f64)v[k];
+}
+
+// identity, to compare products of matrices and their inverses
+void a3test_refIdentity(a3f64 out[16])
+{
+	a3ui32 i;
+	for (i = 0; i < 16; ++i)
+		out[i] = (i % 5) ? 0.0 : 1.0;
+}
+
+// transform from rotation, translation and scale: T * R * S
+void a3test_refTRS(a3f64 out[16], a3real const q[4], a3real const t[3], a3real const s[3])
+{
+	a3f64 const x = q[0], y = q[1], z = q[2], w = q[3];
+	a3f64 const r[3][3] = {
+		{ 1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y + w * z), 2.0 * (x * z - w * y) },
+		{ 2.0 * (x * y - w * z), 1.0 - 2.0 * (x * x + z * z), 2.0 * (y * z + w * x) },
+		{ 2.0 * (x * z + w * y), 2.0 * (y * z - w * x), 1.0 - 2.0 * (x * x + y * y) },
+	};
+	a3ui32 c, k;
+	for (c = 0; c < 3; ++c)
+	{
+		for (k = 0; k < 3; ++k)
+			out[c * 4 + k] = r[c][k] * (s ? s[c] : 1.0);
+		out[c * 4 + 3] = 0.0;
+	}
+	for (k = 0; k < 3; ++k)
+		out[12 + k] = t[k];
+	out[15] = 1.0;
+}
+
+// random transform with orthogonal axes: rotation, scale and translation
+void a3test_randomTransform(a3mat4* m_out, a3real q_out[4], a3real t_out[3], a3real s_out[3])
+{
+	a3f64 ref[16];
+	a3ui32 i;
+	a3test_randomQuat(q_out);
+	for (i = 0; i < 3; ++i)
+	{
+		t_out[i] = a3test_random(-10, 10);
+		s_out[i] = a3test_random(0.5f, 2);
+	}
+	a3test_refTRS(ref, q_out, t_out, s_out);
+	for (i = 0; i < 16; ++i)
+		m_out->mm[i] = (a3real)ref[i];
+}
+
+// unit quaternion interpolation along the shorter arc
+void a3test_refSlerp(a3f64 out[4], a3real const q0[4], a3real const q1[4], a3real const t, a3boolean const spherical)
+{
+	a3f64 d = 0.0, len = 0.0, s0, s1, angle, sign;
+	a3ui32 i;
+	for (i = 0; i < 4; ++i)
+		d += (a3f64)q0[i] * (a3f64)q1[i];
+	sign = (d < 0.0) ? -1.0 : 1.0;
+	d = fabs(d);
+	if (spherical && d < 0.9995)
+	{
+		angle = acos(d);
+		s0 = sin((1.0 - t) * angle) / sin(angle);
+		s1 = sin(t * angle) / sin(angle);
+	}
+	else
+	{
+		s0 = 1.0 - t;
+		s1 = t;
+	}
+	for (i = 0; i < 4; ++i)
+	{
+		out[i] = s0 * q0[i] + s1 * sign * q1[i];
+		len += out[i] * out[i];
+	}
+	for (len = sqrt(len), i = 0; i < 4; ++i)
+		out[i] /= len;
+}
+
+// cubic with coefficients c0 + t*(c1 + t*(c2 + t*c3))
+a3f64 a3test_refCubic(a3f64 const c0, a3f64 const c1, a3f64 const c2, a3f64 const c3, a3f64 const t)
+{
+	return c0 + t * (c1 + t * (c2 + t * c3));
+}
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL TESTS
+
+// single matrix and vector functions, plain and aligned
+void a3test_matrix()
+{
+	A3_SIMD_ALIGN a3mat4 mL, mR, out, mAligned;
+	A3_SIMD_ALIGN a3vec4 v, vOut;
+	a3f64 ref[16], diffProduct = 0, diffProductAligned = 0, diffTransform = 0, diffTransformAligned = 0,
+		diffInverse = 0, diffInverseAligned = 0, diffTranspose = 0, d;
+	a3ui32 i, j;
+
+	printf(" matrix:\n");
+	for (i = 0; i < testSize_item; ++i)
+	{
+		for (j = 0; j < 16; ++j)
+		{
+			mL.mm[j] = a3test_random(-2, 2);
+			mR.mm[j] = a3test_random(-2, 2) + ((j % 5) ? 0 : 4);	// well conditioned
+		}
+		for (j = 0; j < 4; ++j)
+			v.v[j] = a3test_random(-2, 2);
+
+		a3test_refProduct(ref, mL.m, mR.m);
+		a3real4x4Product(out.m, mL.m, mR.m);
+		if ((d = a3test_diff(out.mm, ref, 16)) > diffProduct) diffProduct = d;
+		a3real4x4ProductAligned(out.m, mL.m, mR.m);
+		if ((d = a3test_diff(out.mm, ref, 16)) > diffProductAligned) diffProductAligned = d;
+
+		a3test_refTransform(ref, mL.m, v.v);
+		a3real4Real4x4ProductR(vOut.v, mL.m, v.v);
+		if ((d = a3test_diff(vOut.v, ref, 4)) > diffTransform) diffTransform = d;
+		a3real4Real4x4ProductRAligned(vOut.v, mL.m, v.v);
+		if ((d = a3test_diff(vOut.v, ref, 4)) > diffTransformAligned) diffTransformAligned = d;
+
+		for (j = 0; j < 16; ++j)
+			ref[j] = mL.m[j % 4][j / 4];
+		a3real4x4GetTransposedAligned(out.m, mL.m);
+		if ((d = a3test_diff(out.mm, ref, 16)) > diffTranspose) diffTranspose = d;
+
+		// inverse times original is identity
+		a3test_refIdentity(ref);
+		a3real4x4GetInverse(out.m, mR.m);
+		a3real4x4Product(mAligned.m, out.m, mR.m);
+		if ((d = a3test_diff(mAligned.mm, ref, 16)) > diffInverse) diffInverse = d;
+		a3real4x4GetInverseAligned(out.m, mR.m);
+		a3real4x4Product(mAligned.m, out.m, mR.m);
+		if ((d = a3test_diff(mAligned.mm, ref, 16)) > diffInverseAligned) diffInverseAligned = d;
+	}
+	a3test_check("4x4 product", diffProduct, 1e-5);
+	a3test_check("4x4 product aligned", diffProductAligned, 1e-5);
+	a3test_check("4x4 transform vector", diffTransform, 1e-5);
+	a3test_check("4x4 transform vector aligned", diffTransformAligned, 1e-5);
+	a3test_check("4x4 transpose aligned", diffTranspose, 0.0);
+	a3test_check("4x4 inverse", diffInverse, 1e-4);
+	a3test_check("4x4 inverse aligned", diffInverseAligned, 1e-4);
+}
+
+// batch matrix and vector functions, and exact unit vectors
+void a3test_matrixBatch()
+{
+	a3mat4* const mL = (a3mat4*)malloc(sizeof(a3mat4) * testSize_item * 4);
+	a3mat4* const mR = mL + testSize_item;
+	a3mat4* const out = mR + testSize_item;
+	a3mat4* const check = out + testSize_item;
+	a3vec4* const v = (a3vec4*)malloc(sizeof(a3vec4) * testSize_item * 2);
+	a3vec4* const vOut = v + testSize_item;
+	a3vec3* const p = (a3vec3*)malloc(sizeof(a3vec3) * testSize_item * 2);
+	a3vec3* const pOut = p + testSize_item;
+	a3vec3* const u3 = (a3vec3*)malloc(sizeof(a3vec3) * testSize_item);
+	a3vec4* const u4 = (a3vec4*)malloc(sizeof(a3vec4) * testSize_item);
+	a3f64 ref[16], diffProduct = 0, diffShared = 0, diffTransform = 0, diffPoint = 0, diffInverse = 0, 
+		diffUnit3 = 0, diffUnit4 = 0, lenSq, d;
+	a3real q[4], t[3], s[3], point[4];
+	a3ui32 i, j;
+
+	printf(" matrix batch:\n");
+	for (i = 0; i < testSize_item; ++i)
+	{
+		for (j = 0; j < 16; ++j)
+			mR[i].mm[j] = a3test_random(-2, 2);
+		for (j = 0; j < 4; ++j)
+			v[i].v[j] = a3test_random(-2, 2);
+		for (j = 0; j < 3; ++j)
+			p[i].v[j] = a3test_random(-10, 10);
+		a3test_randomTransform(mL + i, q, t, s);
+	}
+
+	a3real4x4ProductBatch(out, mL, mR, testSize_item);
+	for (i = 0; i < testSize_item; ++i)
+	{
+		a3test_refProduct(ref, mL[i].m, mR[i].m);
+		if ((d = a3test_diff(out[i].mm, ref, 16)) > diffProduct) diffProduct = d;
+	}
+	a3real4x4ProductBatchSharedL(out, mL->m, mR, testSize_item);
+	for (i = 0; i < testSize_item; ++i)
+	{
+		a3test_refProduct(ref, mL->m, mR[i].m);
+		if ((d = a3test_diff(out[i].mm, ref, 16)) > diffShared) diffShared = d;
+	}
+	a3real4Real4x4ProductBatch(vOut, mL->m, v, testSize_item);
+	for (i = 0; i < testSize_item; ++i)
+	{
+		a3test_refTransform(ref, mL->m, v[i].v);
+		if ((d = a3test_diff(vOut[i].v, ref, 4)) > diffTransform) diffTransform = d;
+	}
+	a3real3Real4x4TransformPointBatch(pOut, mL->m, p, testSize_item);
+	for (i = 0; i < testSize_item; ++i)
+	{
+		point[0] = p[i].x;
+		point[1] = p[i].y;
+		point[2] = p[i].z;
+		point[3] = 1;
+		a3test_refTransform(ref, mL->m, point);
+		if ((d = a3test_diff(pOut[i].v, ref, 3)) > diffPoint) diffPoint = d;
+	}
+
+	// inverse times original is identity
+	a3real4x4TransformInverseBatch(out, mL, testSize_item);
+	a3test_refIdentity(ref);
+	for (i = 0; i < testSize_item; ++i)
+	{
+		a3real4x4Product(check[i].m, out[i].m, mL[i].m);
+		if ((d = a3test_diff(check[i].mm, ref, 16)) > diffInverse) diffInverse = d;
+	}
+
+	// unit vectors, including zero length, which stays zero
+	v->x = v->y = v->z = v->w = 0.0f;
+	p->x = p->y = p->z = 0.0f;
+	a3real3GetUnitBatch(u3, p, testSize_item);
+	a3real4GetUnitBatch(u4, v, testSize_item);
+	for (i = 0; i < testSize_item; ++i)
+	{
+		lenSq = (a3f64)p[i].x * p[i].x + (a3f64)p[i].y * p[i].y + (a3f64)p[i].z * p[i].z;
+		for (j = 0; j < 3; ++j)
+			ref[j] = (lenSq > 0.0) ? p[i].v[j] / sqrt(lenSq) : 0.0;
+		if ((d = a3test_diff(u3[i].v, ref, 3)) > diffUnit3) diffUnit3 = d;
+		lenSq = (a3f64)v[i].x * v[i].x + (a3f64)v[i].y * v[i].y + (a3f64)v[i].z * v[i].z + (a3f64)v[i].w * v[i].w;
+		for (j = 0; j < 4; ++j)
+			ref[j] = (lenSq > 0.0) ? v[i].v[j] / sqrt(lenSq) : 0.0;
+		if ((d = a3test_diff(u4[i].v, ref, 4)) > diffUnit4) diffUnit4 = d;
+	}
+
+	a3test_check("4x4 product batch", diffProduct, 2e-5);
+	a3test_check("4x4 product batch shared left", diffShared, 2e-5);
+	a3test_check("4x4 transform vector batch", diffTransform, 2e-5);
+	a3test_check("4x4 transform point batch", diffPoint, 5e-5);
+	a3test_check("4x4 transform inverse batch", diffInverse, 1e-5);
+	a3test_check("unit 3D batch", diffUnit3, 1e-6);
+	a3test_check("unit 4D batch", diffUnit4, 1e-6);
+
+	free(u4);
+	free(u3);
+	free(p);
+	free(v);
+	free(mL);
+}
+
+// transform inverses against identity, for the kind of transform each handles
+void a3test_transformInverse()
+{
+	typedef a3real4x4r(*a3test_InverseFunc)(a3real4x4p m_out, const a3real4x4p m);
+	typedef a3real4x4r(*a3test_InvertFunc)(a3real4x4p m_inout);
+	a3test_InverseFunc const inverse[] = { a3real4x4TransformInverseIgnoreScale, a3real4x4TransformInverseUniformScale, a3real4x4TransformInverse, a3real4x4TransformInverseAffine };
+	a3test_InvertFunc const invert[] = { a3real4x4TransformInvertIgnoreScale, a3real4x4TransformInvertUniformScale, a3real4x4TransformInvert, a3real4x4TransformInvertAffine };
+	a3byte const* const kindName[] = { "rigid", "uniform scale", "scale per axis", "skewed" };
+	a3mat4 m, out, check;
+	a3f64 ref[16], diffInverse[4] = { 0 }, diffInvert[4] = { 0 }, d;
+	a3real q[4], t[3], s[3];
+	a3ui32 i, j, k;
+	a3byte name[64];
+
+	printf(" transform inverse:\n");
+	a3test_refIdentity(ref);
+	for (i = 0; i < testSize_item; ++i)
+	{
+		for (k = 0; k < 4; ++k)
+		{
+			// scale to match the kind; skew mixes axes of the upper 3x3
+			a3test_randomTransform(&m, q, t, s);
+			if (k < 2)
+			{
+				s[1] = s[2] = s[0] = (k == 0) ? 1.0f : s[0];
+				a3test_refTRS(ref, q, t, s);
+				for (j = 0; j < 16; ++j)
+					m.mm[j] = (a3real)ref[j];
+				a3test_refIdentity(ref);
+			}
+			else if (k == 3)
+			{
+				for (j = 0; j < 3; ++j)
+					m.m[j][(j + 1) % 3] += a3test_random(-0.5f, 0.5f);
+			}
+
+			inverse[k](out.m, m.m);
+			a3real4x4Product(check.m, out.m, m.m);
+			if ((d = a3test_diff(check.mm, ref, 16)) > diffInverse[k]) diffInverse[k] = d;
+
+			out = m;
+			invert[k](out.m);
+			a3real4x4Product(check.m, out.m, m.m);
+			if ((d = a3test_diff(check.mm, ref, 16)) > diffInvert[k]) diffInvert[k] = d;
+		}
+	}
+	for (k = 0; k < 4; ++k)
+	{
+		sprintf(name, "transform inverse, %s", kindName[k]);
+		a3test_check(name, diffInverse[k], 1e-5);
+		sprintf(name, "transform invert, %s", kindName[k]);
+		a3test_check(name, diffInvert[k], 1e-5);
+	}
+}
+
+// trig batches at each tier
+void a3test_trig()
+{
+	// absolute error bounds of 'a3trigPolyTier', with single-precision
+	//	rounding of the result
+	a3f64 const tolerance[] = { 3e-4, 2e-6, 1e-6 };
+	a3real* const x = (a3real*)malloc(sizeof(a3real) * testSize_item * 5);
+	a3real* const y = x + testSize_item;
+	a3real* const a = y + testSize_item;
+	a3real* const sinOut = a + testSize_item;
+	a3real* const cosOut = sinOut + testSize_item;
+	a3f64 diffSin, diffCos, diffAsin, diffAcos, diffAtan2, ref, xc, d;
+	a3index tier, tierOld = a3trigGetPolyTier();
+	a3ui32 i;
+	a3byte name[64];
+
+	printf(" trig batch:\n");
+	for (tier = a3trigPoly_low; tier <= a3trigPoly_high; ++tier)
+	{
+		a3trigSetPolyTier(tier);
+		diffSin = diffCos = diffAsin = diffAcos = diffAtan2 = 0;
+
+		for (i = 0; i < testSize_item; ++i)
+			x[i] = a3test_random(-20, 20);
+		a3realSinCosBatch(sinOut, cosOut, x, testSize_item);
+		for (i = 0; i < testSize_item; ++i)
+		{
+			if (!((d = fabs(sinOut[i] - sin((a3f64)x[i]))) <= diffSin)) diffSin = (d == d) ? d : HUGE_VAL;
+			if (!((d = fabs(cosOut[i] - cos((a3f64)x[i]))) <= diffCos)) diffCos = (d == d) ? d : HUGE_VAL;
+		}
+
+		// inputs outside [-1, +1] are clamped
+		for (i = 0; i < testSize_item; ++i)
+			x[i] = (i == 0) ? -1.0f : (i == 1) ? +1.0f : (i == 2) ? 0.0f : a3test_random(-1.1f, 1.1f);
+		a3realAsinBatch(sinOut, x, testSize_item);
+		a3realAcosBatch(cosOut, x, testSize_item);
+		for (i = 0; i < testSize_item; ++i)
+		{
+			xc = (x[i] < -1.0f) ? -1.0 : (x[i] > 1.0f) ? 1.0 : (a3f64)x[i];
+			if (!((d = fabs(sinOut[i] - asin(xc))) <= diffAsin)) diffAsin = (d == d) ? d : HUGE_VAL;
+			if (!((d = fabs(cosOut[i] - acos(xc))) <= diffAcos)) diffAcos = (d == d) ? d : HUGE_VAL;
+		}
+
+		// every quadrant and both axes, but not the origin
+		for (i = 0; i < testSize_item; ++i)
+		{
+			x[i] = (i % 8 == 0) ? 0.0f : a3test_random(-5, 5);
+			y[i] = (i % 8 == 1) ? 0.0f : a3test_random(-5, 5);
+		}
+		a3realAtan2Batch(a, y, x, testSize_item);
+		for (i = 0; i < testSize_item; ++i)
+		{
+			ref = atan2((a3f64)y[i], (a3f64)x[i]);
+			d = fabs(a[i] - ref);
+			if (d > 3.14159)
+				d = fabs(d - 6.283185307179586);	// -pi and +pi are the same angle
+			if (!(d <= diffAtan2)) diffAtan2 = (d == d) ? d : HUGE_VAL;
+		}
+
+		sprintf(name, "sin batch, tier %u", (a3ui32)tier);
+		a3test_check(name, diffSin, tolerance[tier] * 2.0);
+		sprintf(name, "cos batch, tier %u", (a3ui32)tier);
+		a3test_check(name, diffCos, tolerance[tier] * 2.0);
+		sprintf(name, "asin batch, tier %u", (a3ui32)tier);
+		a3test_check(name, diffAsin, tolerance[tier] * 2.0);
+		sprintf(name, "acos batch, tier %u", (a3ui32)tier);
+		a3test_check(name, diffAcos, tolerance[tier] * 2.0);
+		sprintf(name, "atan2 batch, tier %u", (a3ui32)tier);
+		a3test_check(name, diffAtan2, tolerance[tier] * 2.0);
+	}
+	a3trigSetPolyTier(tierOld);
+
+	free(x);
+}
+
+// random stream fill against one value at a time
+void a3test_randomStream()
+{
+	a3randstream stream[1];
+	a3real* const values = (a3real*)malloc(sizeof(a3real) * testSize_item * 2);
+	a3real* const valuesRef = values + testSize_item;
+	a3ui32* const ints = (a3ui32*)malloc(sizeof(a3ui32) * testSize_item * 2);
+	a3ui32* const intsRef = ints + testSize_item;
+	a3ui64 const first = 5;		// not a block boundary
+	a3ui32 i;
+
+	printf(" random stream:\n");
+	a3randomStreamInit(stream, 1234, 7);
+	a3randomStreamFill(values, stream, first, testSize_item);
+	a3randomStreamFillInt(ints, stream, first, testSize_item);
+	a3randomStreamSetIndex(stream, first);
+	for (i = 0; i < testSize_item; ++i)
+		valuesRef[i] = a3randomStreamNext(stream);
+	a3randomStreamSetIndex(stream, first);
+	for (i = 0; i < testSize_item; ++i)
+		intsRef[i] = a3randomStreamNextInt(stream);
+
+	a3test_check("stream fill", a3test_diffExact(values, valuesRef, sizeof(a3real) * testSize_item), 0.0);
+	a3test_check("stream fill integers", a3test_diffExact(ints, intsRef, sizeof(a3ui32) * testSize_item), 0.0);
+
+	free(ints);
+	free(values);
+}
+
+// curve and table batches against their polynomials
+void a3test_curve()
+{
+	a3real* const param = (a3real*)malloc(sizeof(a3real) * testSize_item * 5);
+	a3real* const out = param + testSize_item;
+	a3f64* const ref = (a3f64*)malloc(sizeof(a3f64) * testSize_item * 4);
+	a3real table[testSize_table + 1], n[4][4];
+	a3f64 p0, p1, p2, p3, u, diff;
+	a3ui32 i, j, c, channels, k;
+	a3byte name[64];
+	a3byte const* const curveName[] = { "Catmull-Rom", "Hermite control", "Hermite tangent", "Bezier" };
+
+	printf(" curve batch:\n");
+	for (i = 0; i < testSize_item; ++i)
+		param[i] = (i == 0) ? 0.0f : (i == 1) ? 1.0f : a3test_random(0, 1);
+	for (i = 0; i < 4; ++i)
+		for (j = 0; j < 4; ++j)
+			n[i][j] = a3test_random(-2, 2);
+
+	for (k = 0; k < 4; ++k)
+	{
+		for (channels = 3; channels <= 4; ++channels)
+		{
+			switch (k)
+			{
+			case 0:
+				(channels == 3 ? a3real3CatmullRomBatch : a3real4CatmullRomBatch)(out, n[0], n[1], n[2], n[3], param, testSize_item);
+				break;
+			case 1:
+				(channels == 3 ? a3real3HermiteControlBatch : a3real4HermiteControlBatch)(out, n[0], n[1], n[2], n[3], param, testSize_item);
+				break;
+			case 2:
+				(channels == 3 ? a3real3HermiteTangentBatch : a3real4HermiteTangentBatch)(out, n[0], n[1], n[2], n[3], param, testSize_item);
+				break;
+			case 3:
+				(channels == 3 ? a3real3Bezier3Batch : a3real4Bezier3Batch)(out, n[0], n[1], n[2], n[3], param, testSize_item);
+				break;
+			}
+
+			// cubic coefficients of each curve in plain form
+			for (c = 0; c < channels; ++c)
+			{
+				p0 = n[0][c];
+				p1 = n[1][c];
+				p2 = n[2][c];
+				p3 = n[3][c];
+				for (i = 0; i < testSize_item; ++i)
+				{
+					u = param[i];
+					switch (k)
+					{
+					case 0:
+						ref[i * channels + c] = 0.5 * a3test_refCubic(2.0 * p1, p2 - p0, 2.0 * p0 - 5.0 * p1 + 4.0 * p2 - p3, 3.0 * p1 - p0 - 3.0 * p2 + p3, u);
+						break;
+					case 1:	// handles: tangents are handle minus point
+						ref[i * channels + c] = a3test_refCubic(p0, p2 - p0, 3.0 * (p1 - p0) - 2.0 * (p2 - p0) - (p3 - p1), 2.0 * (p0 - p1) + (p2 - p0) + (p3 - p1), u);
+						break;
+					case 2:
+						ref[i * channels + c] = a3test_refCubic(p0, p2, 3.0 * (p1 - p0) - 2.0 * p2 - p3, 2.0 * (p0 - p1) + p2 + p3, u);
+						break;
+					case 3:
+						ref[i * channels + c] = a3test_refCubic(p0, 3.0 * (p1 - p0), 3.0 * (p0 - 2.0 * p1 + p2), p3 - p0 + 3.0 * (p1 - p2), u);
+						break;
+					}
+				}
+			}
+			sprintf(name, "%s %uD batch", curveName[k], channels);
+			a3test_check(name, a3test_diff(out, ref, testSize_item * channels), 2e-5);
+		}
+	}
+
+	// table lookup clamps parameters outside range
+	for (i = 0; i <= testSize_table; ++i)
+		table[i] = a3test_random(-2, 2);
+	for (i = 0; i < testSize_item; ++i)
+		param[i] = (i == 0) ? 2.0f : (i == 1) ? 3.0f : a3test_random(1.5f, 3.5f);
+	a3sampleTableLerpUniformBatch(out, table, testSize_table, 2.0f, 3.0f, param, testSize_item);
+	for (i = 0; i < testSize_item; ++i)
+	{
+		u = ((a3f64)param[i] - 2.0) * testSize_table;
+		u = (u < 0.0) ? 0.0 : (u > testSize_table) ? testSize_table : u;
+		j = (a3ui32)u;
+		if (j == testSize_table)
+			--j;
+		u -= j;
+		ref[i] = table[j] + u * ((a3f64)table[j + 1] - table[j]);
+	}
+	diff = a3test_diff(out, ref, testSize_item);
+	a3test_check("table lerp batch", diff, 1e-5);
+
+	free(ref);
+	free(param);
+}
+
+// quaternion conversion and interpolation batches
+void a3test_quat()
+{
+	// absolute error bounds of 'a3trigPolyTier', with single-precision
+	//	rounding of the result
+	a3f64 const tolerance[] = { 3e-4, 2e-6, 1e-6 };
+	a3quat* const q0 = (a3quat*)malloc(sizeof(a3quat) * testSize_item * 3);
+	a3quat* const q1 = q0 + testSize_item;
+	a3quat* const qOut = q1 + testSize_item;
+	a3vec3* const t = (a3vec3*)malloc(sizeof(a3vec3) * testSize_item * 2);
+	a3vec3* const s = t + testSize_item;
+	a3real* const param = (a3real*)malloc(sizeof(a3real) * testSize_item);
+	a3mat4* const m = (a3mat4*)malloc(sizeof(a3mat4) * testSize_item);
+	a3f64 ref[16], diffTRS = 0, diffTR = 0, diffSlerp, diffNlerp = 0, d;
+	a3index tier, tierOld = a3trigGetPolyTier();
+	a3ui32 i, j;
+	a3byte name[64];
+
+	printf(" quaternion batch:\n");
+	for (i = 0; i < testSize_item; ++i)
+	{
+		a3test_randomQuat(q0[i].q);
+		a3test_randomQuat(q1[i].q);
+		for (j = 0; j < 3; ++j)
+		{
+			t[i].v[j] = a3test_random(-10, 10);
+			s[i].v[j] = a3test_random(0.5f, 2);
+		}
+		param[i] = a3test_random(0, 1);
+
+		// nearly parallel and opposite pairs
+		if (i == 0)
+			q1[i] = q0[i];
+		if (i == 1)
+			for (j = 0; j < 4; ++j)
+				q1[i].q[j] = -q0[i].q[j];
+		if (i == 2)
+			param[i] = 0;
+		if (i == 3)
+			param[i] = 1;
+	}
+
+	a3quatConvertToMat4TRSBatch(m, q0, t, s, testSize_item);
+	for (i = 0; i < testSize_item; ++i)
+	{
+		a3test_refTRS(ref, q0[i].q, t[i].v, s[i].v);
+		if ((d = a3test_diff(m[i].mm, ref, 16)) > diffTRS) diffTRS = d;
+	}
+	a3quatConvertToMat4TRSBatch(m, q0, t, 0, testSize_item);
+	for (i = 0; i < testSize_item; ++i)
+	{
+		a3test_refTRS(ref, q0[i].q, t[i].v, 0);
+		if ((d = a3test_diff(m[i].mm, ref, 16)) > diffTR) diffTR = d;
+	}
+	a3test_check("TRS batch", diffTRS, 2e-6);
+	a3test_check("TR batch, no scale", diffTR, 2e-6);
+
+	a3quatNlerpBatch(qOut, q0, q1, param, testSize_item);
+	for (i = 0; i < testSize_item; ++i)
+	{
+		a3test_refSlerp(ref, q0[i].q, q1[i].q, param[i], a3false);
+		if ((d = a3test_diff(qOut[i].q, ref, 4)) > diffNlerp) diffNlerp = d;
+	}
+	a3test_check("nlerp batch", diffNlerp, 1e-6);
+
+	for (tier = a3trigPoly_low; tier <= a3trigPoly_high; ++tier)
+	{
+		a3trigSetPolyTier(tier);
+		diffSlerp = 0;
+		a3quatSlerpBatch(qOut, q0, q1, param, testSize_item);
+		for (i = 0; i < testSize_item; ++i)
+		{
+			a3test_refSlerp(ref, q0[i].q, q1[i].q, param[i], a3true);
+			if ((d = a3test_diff(qOut[i].q, ref, 4)) > diffSlerp) diffSlerp = d;
+		}
+		sprintf(name, "slerp batch, tier %u", (a3ui32)tier);
+		a3test_check(name, diffSlerp, tolerance[tier] * 4.0);
+	}
+	a3trigSetPolyTier(tierOld);
+
+	free(m);
+	free(param);
+	free(t);
+	free(q0);
+}
+
+// fast unit vectors and inverse square roots at each precision
+void a3test_sqrt()
+{
+	// relative error bounds of 'a3sqrtPrecision', scalar where larger
+	a3f64 const tolerance[] = { 2e-3, 5e-6, 1e-6 };
+	a3vec3* const v3 = (a3vec3*)malloc(sizeof(a3vec3) * testSize_item * 2);
+	a3vec3* const u3 = v3 + testSize_item;
+	a3vec4* const v4 = (a3vec4*)malloc(sizeof(a3vec4) * testSize_item * 2);
+	a3vec4* const u4 = v4 + testSize_item;
+	a3f32* const x = (a3f32*)malloc(sizeof(a3f32) * testSize_item * 3);
+	a3f32* const y = x + testSize_item;
+	a3f32* const z = y + testSize_item;
+	a3f64 ref[4], diffNorm3, diffNorm4, diffFast, diffFastBatch, lenSq, d;
+	a3index precision, precisionOld = a3sqrtGetPrecision();
+	a3ui32 i, j;
+	a3byte name[64];
+
+	printf(" square root:\n");
+	for (i = 0; i < testSize_item; ++i)
+	{
+		// first few: zero, denormal and tiny squared lengths
+		for (j = 0; j < 4; ++j)
+			v4[i].v[j] = a3test_random(-2, 2);
+		if (i < 4)
+			v4[i].x = (i == 0) ? 0.0f : (i == 1) ? 1e-20f : (i == 2) ? 1e-19f : 2e-19f;
+		if (i < 4)
+			v4[i].y = v4[i].z = v4[i].w = 0.0f;
+		v3[i].x = v4[i].x;
+		v3[i].y = v4[i].y;
+		v3[i].z = v4[i].z;
+
+		// inputs from denormal to huge, and negative
+		x[i] = (i == 0) ? 0.0f : (i == 1) ? -1.0f : (i == 2) ? FLT_MIN * 0.5f : (i == 3) ? FLT_MIN * 2.0f :
+			(a3f32)pow(10.0, a3test_random(-30, 30));
+	}
+
+	for (precision = a3sqrtPrecision_low; precision <= a3sqrtPrecision_high; ++precision)
+	{
+		a3sqrtSetPrecision(precision);
+		diffNorm3 = diffNorm4 = diffFast = diffFastBatch = 0;
+
+		// squared lengths too small to be normal floats give zero vectors
+		memcpy(u3, v3, sizeof(a3vec3) * testSize_item);
+		memcpy(u4, v4, sizeof(a3vec4) * testSize_item);
+		a3real3NormalizeBatch(u3, testSize_item);
+		a3real4NormalizeBatch(u4, testSize_item);
+		for (i = 0; i < testSize_item; ++i)
+		{
+			lenSq = (a3f64)v3[i].x * v3[i].x + (a3f64)v3[i].y * v3[i].y + (a3f64)v3[i].z * v3[i].z;
+			for (j = 0; j < 3; ++j)
+				ref[j] = (lenSq > FLT_MIN) ? v3[i].v[j] / sqrt(lenSq) : 0.0;
+			if ((d = a3test_diff(u3[i].v, ref, 3)) > diffNorm3) diffNorm3 = d;
+			lenSq += (a3f64)v4[i].w * v4[i].w;
+			for (j = 0; j < 4; ++j)
+				ref[j] = (lenSq > FLT_MIN) ? v4[i].v[j] / sqrt(lenSq) : 0.0;
+			if ((d = a3test_diff(u4[i].v, ref, 4)) > diffNorm4) diffNorm4 = d;
+		}
+
+		// relative error; zero for inputs that are not positive normal floats
+		a3sqrtfInverseFastBatch(y, x, testSize_item);
+		for (i = 0; i < testSize_item; ++i)
+		{
+			z[i] = a3sqrtfInverseFast(x[i]);
+			ref[0] = (x[i] > FLT_MIN) ? 1.0 / sqrt((a3f64)x[i]) : 0.0;
+			d = (x[i] > FLT_MIN) ? fabs(y[i] / ref[0] - 1.0) : fabs(y[i]);
+			if (!(d <= diffFastBatch)) diffFastBatch = (d == d) ? d : HUGE_VAL;
+			d = (x[i] > FLT_MIN) ? fabs(z[i] / ref[0] - 1.0) : fabs(z[i]);
+			if (!(d <= diffFast)) diffFast = (d == d) ? d : HUGE_VAL;
+		}
+
+		sprintf(name, "normalize 3D batch, precision %u", (a3ui32)precision);
+		a3test_check(name, diffNorm3, tolerance[precision] * 2.0);
+		sprintf(name, "normalize 4D batch, precision %u", (a3ui32)precision);
+		a3test_check(name, diffNorm4, tolerance[precision] * 2.0);
+		sprintf(name, "inverse sqrt fast, precision %u", (a3ui32)precision);
+		a3test_check(name, diffFast, tolerance[precision]);
+		sprintf(name, "inverse sqrt fast batch, precision %u", (a3ui32)precision);
+		a3test_check(name, diffFastBatch, tolerance[precision]);
+	}
+	a3sqrtSetPrecision(precisionOld);
+
+	free(x);
+	free(v4);
+	free(v3);
+}
+
+
+//-----------------------------------------------------------------------------
+
+int main()
+{
+	printf("A3DM test: %s\n", A3_SIMD_NAME);
+
+	a3test_matrix();
+	a3test_matrixBatch();
+	a3test_transformInverse();
+	a3test_trig();
+	a3test_randomStream();
+	a3test_curve();
+	a3test_quat();
+	a3test_sqrt();
+
+	printf("A3DM test: %s: %s (%u failed)\n", A3_SIMD_NAME, a3test_failCount ? "FAIL" : "ok", a3test_failCount);
+	return (int)a3test_failCount;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -41,4 +41,5 @@
 #define A3_GLOBAL
 
 // include all headers and source
-#include "animal3D-A3DM/animal3D-A3DM.h"
\ No newline at end of file
+#include "animal3D-A3DM/animal3D-A3DM.h"
+#include "animal3D-A3DM/a3math/a3batch.h"
\ No newline at end of file
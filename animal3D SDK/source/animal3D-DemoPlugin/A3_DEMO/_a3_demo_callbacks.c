@@ -100,7 +100,11 @@ void a3demo_render(a3_DemoState const* demoState, a3f64 const dt);
 // loading
 void a3demo_loadGeometry(a3_DemoState* demoState);
 void a3demo_loadShaders(a3_DemoState* demoState);
+void a3demo_reloadShaders(a3_DemoState* demoState, a3ui64 const programMask);
+void a3demo_loadShadersPoll(a3_DemoState* demoState);
 void a3demo_loadTextures(a3_DemoState* demoState);
+void a3demo_benchmarkTextures(a3_DemoState* demoState);
+void a3demo_benchmarkGeometry(a3_DemoState* demoState);
 void a3demo_loadFramebuffers(a3_DemoState* demoState);
 void a3demo_loadValidate(a3_DemoState* demoState);
 
@@ -279,6 +283,9 @@ void a3demo_idle(a3_DemoState* demoState, a3f64 const dt)
 		demoState->dt_timer = demoState->timer_display->totalTime - demoState->t_timer;
 		demoState->dt_timer_tot += demoState->dt_timer;
 		demoState->t_timer = demoState->timer_display->totalTime;
+		a3statsRunningAdd(demoState->dt_stats, (a3real)(demoState->dt_timer * 1000.0));
+		a3statsAverageAdd(demoState->dt_average, (a3real)(demoState->dt_timer * 1000.0));
+		a3statsHistogramAdd(demoState->dt_histogram, (a3real)(demoState->dt_timer * 1000.0));
 	}
 	else
 	{
@@ -286,8 +293,24 @@ void a3demo_idle(a3_DemoState* demoState, a3f64 const dt)
 		demoState->dt_timer = demoState->timer_display->totalTime;
 		demoState->dt_timer_tot = 0.0;
 		demoState->t_timer = demoState->timer_display->totalTime;
+
+		// recent average weighs about the last second at 60 Hz; histogram 
+		//	resolves from a microsecond to about 16 seconds
+		a3statsRunningReset(demoState->dt_stats);
+		a3statsAverageInit(demoState->dt_average, (a3real)(1.0 / 60.0));
+		a3statsHistogramInit(demoState->dt_histogram, (a3real)0.001);
 	}
 
+	// rebuild only programs whose shader files changed
+	if (demoState->shaderHotReload)
+		a3demo_reloadShaders(demoState, a3demo_shaderWatchUpdate(demoState->shaderWatch, dt));
+
+	// swap in shader programs that finished compiling
+	a3demo_loadShadersPoll(demoState);
+
+	// upload textures that finished loading
+	a3demo_textureLoaderUpdate(demoState->textureLoader);
+
 	// main idle loop
 	a3demo_input(demoState, dt);
 	a3demo_update(demoState, dt);
@@ -337,7 +360,7 @@ void a3demo_idle(a3_DemoState* demoState, a3f64 const dt)
 A3DYLIBSYMBOL a3_DemoState *a3demoCB_load(a3_DemoState *demoState, a3boolean hotbuild, a3i32 renderAPI)
 {
 	a3ui32 const stateSize = a3demo_getPersistentStateSize();
-	a3ui32 const trigSamplesPerDegree = 4;
+	a3ui32 const trigSamplesPerDegree = 4;	// 0 to skip tables; A3DM trig then uses polynomials
 	
 	// do any re-allocation tasks
 	if (demoState && hotbuild)
@@ -358,6 +381,10 @@ A3DYLIBSYMBOL a3_DemoState *a3demoCB_load(a3_DemoState *demoState, a3boolean hot
 		// call refresh to re-link pointers in case demo state address changed
 		a3demo_loadValidate(demoState);
 		a3demoMode_loadValidate(demoState);
+
+		// restart workers stopped by unload
+		if (demoState->workerPool = (a3_DemoWorkerPool*)calloc(1, sizeof(a3_DemoWorkerPool)))
+			a3demo_workerPoolCreate(demoState->workerPool, 0);
 	}
 
 	// do any initial allocation tasks
@@ -370,6 +397,7 @@ A3DYLIBSYMBOL a3_DemoState *a3demoCB_load(a3_DemoState *demoState, a3boolean hot
 		memset(demoState, 0, stateSize);
 
 		// set up trig table (A3DM)
+		demoState->trigSamplesPerDegree = trigSamplesPerDegree;
 		a3trigInit(trigSamplesPerDegree, demoState->trigTable);
 
 		// text
@@ -380,12 +408,25 @@ A3DYLIBSYMBOL a3_DemoState *a3demoCB_load(a3_DemoState *demoState, a3boolean hot
 		// enable asset streaming between loads
 		//demoState->streaming = a3true;
 
+		// compile shaders in the background
+		demoState->shaderAsync = a3true;
+
+		// recompile shaders when their files are saved
+		demoState->shaderHotReload = a3true;
+
+		// optimize geometry as it is created
+		demoState->geometryOptimize = a3true;
+
 		// create directory for data
 		a3fileStreamMakeDirectory("./data");
 
 		// set default GL state
 		a3demo_setDefaultGraphicsState();
 
+		// start workers first; loading generates geometry on them
+		if (demoState->workerPool = (a3_DemoWorkerPool*)calloc(1, sizeof(a3_DemoWorkerPool)))
+			a3demo_workerPoolCreate(demoState->workerPool, 0);
+
 		// demo modes
 		demoState->demoMode = demoState_modePostProc;
 		a3demoMode_loadValidate(demoState);
@@ -406,7 +447,15 @@ A3DYLIBSYMBOL a3_DemoState *a3demoCB_unload(a3_DemoState *demoState, a3boolean h
 {
 	// release things that need releasing always, whether hotbuilding or not
 	// e.g. kill thread
-	// nothing in this example, but then...
+	// texture and shared workers run code from this library; let them
+	//	finish and stop them
+	if (demoState)
+	{
+		a3demo_textureLoaderWait(demoState->textureLoader);
+		a3demo_workerPoolRelease(demoState->workerPool);
+		free(demoState->workerPool);
+		demoState->workerPool = 0;
+	}
 
 	// release persistent state if not hotbuilding
 	// good idea to release in reverse order that things were loaded...
@@ -593,6 +642,33 @@ A3DYLIBSYMBOL void a3demoCB_keyCharPress(a3_DemoState *demoState, a3i32 asciiKey
 		a3demo_unloadShaders(demoState);
 		a3demo_loadShaders(demoState);
 		break;
+
+
+		// report texture compression speed and quality
+	case 'C':
+		a3demo_benchmarkTextures(demoState);
+		break;
+
+		// report geometry vertex cache efficiency before and after optimizing
+	case 'O':
+		a3demo_benchmarkGeometry(demoState);
+		break;
+
+		// report vector and matrix kernel speed against scalar loops, then 
+		//	batch throughput across threads, then trig paths against libm, 
+		//	then random streams, statistics, curve followers, quaternion 
+		//	transforms and inverse square roots, then skinning kernels
+	case 'M':
+		a3demo_mathReport(1024, 256);
+		a3demo_mathBatchReport(65536, 16, demoState->workerPool);
+		a3demo_mathTrigReport(4096, 256, demoState->trigSamplesPerDegree ? demoState->trigTable : 0, demoState->trigSamplesPerDegree);
+		a3demo_mathRandomReport(65536, 64, demoState->workerPool);
+		a3demo_mathStatsReport(65536, 16);
+		a3demo_mathCurveReport(65536, 16, demoState->workerPool);
+		a3demo_mathQuatReport(65536, 16, demoState->workerPool);
+		a3demo_mathSqrtReport(65536, 16);
+		a3demo_skinReport(65536, 64, 16, demoState->workerPool);
+		break;
 	}
 
 
@@ -0,0 +1,854 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoBVH.c
+	Bounding volume hierarchy implementation.
+*/
+
+#include "../a3_DemoBVH.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// parallel build limits
+enum a3_DemoBVHTask
+{
+	demoBVHTask_max = 32,						// subtrees built by workers
+	demoBVHTask_perThread = 4,					// subtrees per share, for balance
+	demoBVHTask_objectMin = 1024,				// smallest subtree worth a task
+};
+
+// nodes filled by one builder
+typedef struct a3_DemoBVHNodes					a3_DemoBVHNodes;
+struct a3_DemoBVHNodes
+{
+	a3_DemoBVHNode* node;
+	a3ui32 count, capacity;
+};
+
+// data shared by all builders; subtrees at task depth are left for workers
+typedef struct a3_DemoBVHBuild					a3_DemoBVHBuild;
+struct a3_DemoBVHBuild
+{
+	a3f32 const* box;
+	a3f32* centroid;
+	a3ui32* object;
+	a3ui32 taskDepth, taskCount;
+	a3ui32 taskNode[demoBVHTask_max], taskFirst[demoBVHTask_max], taskLast[demoBVHTask_max];
+	a3_DemoBVHNodes taskNodes[demoBVHTask_max];
+};
+
+// one share of tasks, dealt out in turn
+typedef struct a3_DemoBVHWork					a3_DemoBVHWork;
+struct a3_DemoBVHWork
+{
+	a3_DemoBVHBuild* build;
+	a3ui32 first, step;
+};
+
+// make sure an array holds at least the required number of elements
+//	return: 1 if it does; 0 if it could not grow
+inline a3ret a3demo_bvhInternalReserve(void** data, a3ui32* capacity, a3ui32 const required, a3ui32 const size)
+{
+	void* grown;
+	a3ui32 count;
+	if (required > *capacity)
+	{
+		count = *capacity ? *capacity : 64;
+		while (count < required)
+			count *= 2;
+		grown = realloc(*data, (size_t)count * size);
+		if (!grown)
+			return 0;
+		*data = grown;
+		*capacity = count;
+	}
+	return 1;
+}
+
+// add a pair of nodes
+//	return: index of first; -1 if failed
+inline a3i32 a3demo_bvhInternalAddPair(a3_DemoBVHNodes* nodes)
+{
+	if (!a3demo_bvhInternalReserve((void**)&nodes->node, &nodes->capacity, nodes->count + 2, sizeof(a3_DemoBVHNode)))
+		return -1;
+	nodes->count += 2;
+	return (a3i32)(nodes->count - 2);
+}
+
+// half the surface area of a box
+inline a3f32 a3demo_bvhInternalArea(a3f32 const min[3], a3f32 const max[3])
+{
+	a3f32 const x = max[0] - min[0], y = max[1] - min[1], z = max[2] - min[2];
+	return (x * y + y * z + z * x);
+}
+
+// grow box to hold another
+inline void a3demo_bvhInternalGrow(a3f32 min[3], a3f32 max[3], a3f32 const* boxMin, a3f32 const* boxMax)
+{
+	min[0] = boxMin[0] < min[0] ? boxMin[0] : min[0];
+	min[1] = boxMin[1] < min[1] ? boxMin[1] : min[1];
+	min[2] = boxMin[2] < min[2] ? boxMin[2] : min[2];
+	max[0] = boxMax[0] > max[0] ? boxMax[0] : max[0];
+	max[1] = boxMax[1] > max[1] ? boxMax[1] : max[1];
+	max[2] = boxMax[2] > max[2] ? boxMax[2] : max[2];
+}
+
+// empty box that any other grows
+inline void a3demo_bvhInternalEmpty(a3f32 min[3], a3f32 max[3])
+{
+	min[0] = min[1] = min[2] = +3.0e38f;
+	max[0] = max[1] = max[2] = -3.0e38f;
+}
+
+// reorder objects so the one at 'mid' is in its sorted place along axis,
+//	with no greater centroid before it and no smaller after it
+void a3demo_bvhInternalSelect(a3_DemoBVHBuild const* build, a3ui32 const first, a3ui32 const last, a3ui32 const mid, a3ui32 const axis)
+{
+	a3ui32* const object = build->object;
+	a3f32 const* const centroid = build->centroid + axis;
+	a3i32 lo = (a3i32)first, hi = (a3i32)last - 1, i, j;
+	a3ui32 swap;
+	a3f32 pivot;
+	while (lo < hi)
+	{
+		pivot = centroid[object[(lo + hi) / 2] * 3];
+		for (i = lo, j = hi; i <= j; )
+		{
+			while (centroid[object[i] * 3] < pivot)
+				++i;
+			while (centroid[object[j] * 3] > pivot)
+				--j;
+			if (i <= j)
+			{
+				swap = object[i];
+				object[i++] = object[j];
+				object[j--] = swap;
+			}
+		}
+		if ((a3i32)mid <= j)
+			hi = j;
+		else if ((a3i32)mid >= i)
+			lo = i;
+		else
+			break;
+	}
+}
+
+// choose where to split objects: binned surface area heuristic on each
+//	axis, each object costing one and a step down costing one more; deep
+//	or hopeless ranges are split at the median of the widest axis
+//	return: index of first object on the right; 0 to make a leaf
+a3ui32 a3demo_bvhInternalSplit(a3_DemoBVHBuild const* build, a3ui32 const first, a3ui32 const last, a3ui32 const depth,
+	a3f32 const min[3], a3f32 const max[3], a3f32 const cmin[3], a3f32 const cmax[3])
+{
+	a3f32 binMin[demoBVHSize_bin][3], binMax[demoBVHSize_bin][3], rightArea[demoBVHSize_bin];
+	a3ui32 binCount[demoBVHSize_bin], rightCount[demoBVHSize_bin];
+	a3f32 accumMin[3], accumMax[3], extent, scale, areaInv, cost, bestCost;
+	a3ui32 const count = last - first;
+	a3ui32 axis, b, i, o, leftCount, bestAxis = 3, bestBin = 0, mid;
+	a3ui32* const object = build->object;
+
+	if (depth < demoBVHSize_depthSAH)
+	{
+		areaInv = a3demo_bvhInternalArea(min, max);
+		areaInv = areaInv > 0.0f ? 1.0f / areaInv : 1.0f;
+		bestCost = (a3f32)count;
+		for (axis = 0; axis < 3; ++axis)
+		{
+			extent = cmax[axis] - cmin[axis];
+			if (extent <= 0.0f)
+				continue;
+			scale = (a3f32)demoBVHSize_bin / extent;
+
+			// objects into bins by centroid
+			for (b = 0; b < demoBVHSize_bin; ++b)
+			{
+				binCount[b] = 0;
+				a3demo_bvhInternalEmpty(binMin[b], binMax[b]);
+			}
+			for (i = first; i < last; ++i)
+			{
+				o = object[i];
+				b = (a3ui32)((build->centroid[o * 3 + axis] - cmin[axis]) * scale);
+				b = b < demoBVHSize_bin ? b : demoBVHSize_bin - 1;
+				++binCount[b];
+				a3demo_bvhInternalGrow(binMin[b], binMax[b], build->box + o * 6, build->box + o * 6 + 3);
+			}
+
+			// sweep from the right, then from the left evaluating splits
+			a3demo_bvhInternalEmpty(accumMin, accumMax);
+			for (b = demoBVHSize_bin - 1, leftCount = 0; b > 0; --b)
+			{
+				a3demo_bvhInternalGrow(accumMin, accumMax, binMin[b], binMax[b]);
+				leftCount += binCount[b];
+				rightCount[b] = leftCount;
+				rightArea[b] = leftCount ? a3demo_bvhInternalArea(accumMin, accumMax) : 0.0f;
+			}
+			a3demo_bvhInternalEmpty(accumMin, accumMax);
+			for (b = 1, leftCount = 0; b < demoBVHSize_bin; ++b)
+			{
+				a3demo_bvhInternalGrow(accumMin, accumMax, binMin[b - 1], binMax[b - 1]);
+				leftCount += binCount[b - 1];
+				if (!leftCount || !rightCount[b])
+					continue;
+				cost = 1.0f + (a3demo_bvhInternalArea(accumMin, accumMax) * (a3f32)leftCount + rightArea[b] * (a3f32)rightCount[b]) * areaInv;
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestBin = b;
+				}
+			}
+		}
+
+		// partition by bin of best split
+		if (bestAxis < 3)
+		{
+			scale = (a3f32)demoBVHSize_bin / (cmax[bestAxis] - cmin[bestAxis]);
+			for (i = mid = first; i < last; ++i)
+			{
+				o = object[i];
+				b = (a3ui32)((build->centroid[o * 3 + bestAxis] - cmin[bestAxis]) * scale);
+				if (b < bestBin)
+				{
+					object[i] = object[mid];
+					object[mid++] = o;
+				}
+			}
+			return mid;
+		}
+	}
+	if (count <= demoBVHSize_leafMax)
+		return 0;
+
+	// median of widest centroid axis
+	for (axis = 0, i = 1; i < 3; ++i)
+		axis = (cmax[i] - cmin[i]) > (cmax[axis] - cmin[axis]) ? i : axis;
+	mid = first + count / 2;
+	a3demo_bvhInternalSelect(build, first, last, mid, axis);
+	return mid;
+}
+
+// build node over range of objects, then its children; at task depth the
+//	children are left for workers instead
+void a3demo_bvhInternalBuildNode(a3_DemoBVHBuild* build, a3_DemoBVHNodes* nodes,
+	a3ui32 const nodeIndex, a3ui32 const first, a3ui32 const last, a3ui32 const depth)
+{
+	a3f32 min[3], max[3], cmin[3], cmax[3];
+	a3f32 const* c;
+	a3ui32 i, mid;
+	a3i32 child;
+	a3_DemoBVHNode* node;
+
+	a3demo_bvhInternalEmpty(min, max);
+	a3demo_bvhInternalEmpty(cmin, cmax);
+	for (i = first; i < last; ++i)
+	{
+		c = build->centroid + build->object[i] * 3;
+		a3demo_bvhInternalGrow(min, max, build->box + build->object[i] * 6, build->box + build->object[i] * 6 + 3);
+		a3demo_bvhInternalGrow(cmin, cmax, c, c);
+	}
+
+	// leaf if small, if no split helps, or if out of memory
+	mid = (last - first) > demoBVHSize_leaf ? a3demo_bvhInternalSplit(build, first, last, depth, min, max, cmin, cmax) : 0;
+	child = mid ? a3demo_bvhInternalAddPair(nodes) : -1;
+	node = nodes->node + nodeIndex;
+	memcpy(node->min, min, sizeof(min));
+	memcpy(node->max, max, sizeof(max));
+	if (child < 0)
+	{
+		node->count = last - first;
+		node->index = first;
+		return;
+	}
+	node->count = 0;
+	node->index = (a3ui32)child;
+
+	if (depth + 1 == build->taskDepth && build->taskCount + 2 <= demoBVHTask_max
+		&& mid - first >= demoBVHTask_objectMin && last - mid >= demoBVHTask_objectMin)
+	{
+		build->taskNode[build->taskCount] = (a3ui32)child;
+		build->taskFirst[build->taskCount] = first;
+		build->taskLast[build->taskCount] = mid;
+		++build->taskCount;
+		build->taskNode[build->taskCount] = (a3ui32)child + 1;
+		build->taskFirst[build->taskCount] = mid;
+		build->taskLast[build->taskCount] = last;
+		++build->taskCount;
+		return;
+	}
+	a3demo_bvhInternalBuildNode(build, nodes, (a3ui32)child, first, mid, depth + 1);
+	a3demo_bvhInternalBuildNode(build, nodes, (a3ui32)child + 1, mid, last, depth + 1);
+}
+
+// build subtrees of one share of tasks, each into its own nodes
+void a3demo_bvhInternalBuildTasks(void* args, a3ui32 index)
+{
+	a3_DemoBVHWork const* const work = (a3_DemoBVHWork const*)args + index;
+	a3_DemoBVHBuild* const build = work->build;
+	a3_DemoBVHNodes* nodes;
+	a3ui32 i;
+	for (i = work->first; i < build->taskCount; i += work->step)
+	{
+		nodes = build->taskNodes + i;
+		if (a3demo_bvhInternalReserve((void**)&nodes->node, &nodes->capacity, 1, sizeof(a3_DemoBVHNode)))
+		{
+			nodes->count = 1;
+			a3demo_bvhInternalBuildNode(build, nodes, 0, build->taskFirst[i], build->taskLast[i], build->taskDepth);
+		}
+	}
+}
+
+// refit all nodes; children are always after parents
+inline void a3demo_bvhInternalRefit(a3_DemoBVH* bvh)
+{
+	a3_DemoBVHNode* node;
+	a3f32 const* box;
+	a3ui32 i, k;
+	for (i = bvh->nodeCount, node = bvh->node + i - 1; i > 0; --i, --node)
+	{
+		if (node->count)
+		{
+			a3demo_bvhInternalEmpty(node->min, node->max);
+			for (k = 0; k < node->count; ++k)
+			{
+				box = bvh->box + bvh->object[node->index + k] * 6;
+				a3demo_bvhInternalGrow(node->min, node->max, box, box + 3);
+			}
+		}
+		else
+		{
+			memcpy(node->min, bvh->node[node->index].min, sizeof(node->min));
+			memcpy(node->max, bvh->node[node->index].max, sizeof(node->max));
+			a3demo_bvhInternalGrow(node->min, node->max, bvh->node[node->index + 1].min, bvh->node[node->index + 1].max);
+		}
+	}
+}
+
+// box against planes still in mask; planes the box is wholly inside are
+//	removed from the mask
+//	return: 1 if box may be inside; 0 if outside
+inline a3ret a3demo_bvhInternalFrustumBox(a3ui32* mask, a3f32 const planes[6][4], a3f32 const* min, a3f32 const* max)
+{
+	a3f32 c[3], e[3], d, r;
+	a3ui32 k;
+	c[0] = (min[0] + max[0]) * 0.5f;
+	c[1] = (min[1] + max[1]) * 0.5f;
+	c[2] = (min[2] + max[2]) * 0.5f;
+	e[0] = (max[0] - min[0]) * 0.5f;
+	e[1] = (max[1] - min[1]) * 0.5f;
+	e[2] = (max[2] - min[2]) * 0.5f;
+	for (k = 0; k < 6; ++k)
+		if (*mask & (1u << k))
+		{
+			d = planes[k][0] * c[0] + planes[k][1] * c[1] + planes[k][2] * c[2] + planes[k][3];
+			r = fabsf(planes[k][0]) * e[0] + fabsf(planes[k][1]) * e[1] + fabsf(planes[k][2]) * e[2];
+			if (d + r < 0.0f)
+				return 0;
+			if (d - r >= 0.0f)
+				*mask &= ~(1u << k);
+		}
+	return 1;
+}
+
+// box against sphere, by squared distance to nearest point
+inline a3ret a3demo_bvhInternalSphereBox(a3f32 const center[3], a3f32 const radiusSq, a3f32 const* min, a3f32 const* max)
+{
+	a3f32 d, distSq = 0.0f;
+	a3ui32 k;
+	for (k = 0; k < 3; ++k)
+	{
+		d = center[k] < min[k] ? min[k] - center[k] : center[k] > max[k] ? center[k] - max[k] : 0.0f;
+		distSq += d * d;
+	}
+	return (distSq <= radiusSq);
+}
+
+// box against box
+inline a3ret a3demo_bvhInternalBoxBox(a3f32 const* minA, a3f32 const* maxA, a3f32 const* min, a3f32 const* max)
+{
+	return (minA[0] <= max[0] && maxA[0] >= min[0] && minA[1] <= max[1] && maxA[1] >= min[1] && minA[2] <= max[2] && maxA[2] >= min[2]);
+}
+
+// distance along ray to box by slabs
+//	return: entry distance; negative if missed
+inline a3f32 a3demo_bvhInternalRayBox(a3f32 const origin[3], a3f32 const directionInv[3], a3f32 const maxDistance, a3f32 const* min, a3f32 const* max)
+{
+	a3f32 t0, t1, tmin = 0.0f, tmax = maxDistance;
+	a3ui32 k;
+	for (k = 0; k < 3; ++k)
+	{
+		t0 = (min[k] - origin[k]) * directionInv[k];
+		t1 = (max[k] - origin[k]) * directionInv[k];
+		tmin = t0 < t1 ? (t0 > tmin ? t0 : tmin) : (t1 > tmin ? t1 : tmin);
+		tmax = t0 < t1 ? (t1 < tmax ? t1 : tmax) : (t0 < tmax ? t0 : tmax);
+	}
+	return (tmin <= tmax ? tmin : -1.0f);
+}
+
+// store result if there is room
+#define a3demo_bvhInternalResult(result_out, maxCount, count, value)	if (count < maxCount) result_out[count] = value; ++count
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_bvhBuild(a3_DemoBVH* bvh, a3_VertexBounds const* bounds, a3ui32 const count, a3_DemoWorkerPool* pool, a3ui32 threadCount)
+{
+	a3_DemoBVHWork work[demoBVHSize_thread];
+	a3_DemoBVHBuild build[1] = { 0 };
+	a3_DemoBVHNodes top[1];
+	a3_DemoBVHNodes const* sub;
+	a3_DemoBVHNode* node;
+	a3ui32 i, k, base, total, capacity;
+	a3ret result = 0;
+
+	if (bvh && bounds && count)
+	{
+		// object boxes, centroids and order
+		bvh->nodeCount = bvh->objectCount = 0;
+		capacity = bvh->objectCapacity;
+		build->centroid = (a3f32*)malloc(count * 3 * sizeof(a3f32));
+		if (!build->centroid
+			|| !a3demo_bvhInternalReserve((void**)&bvh->object, &capacity, count, sizeof(a3ui32))
+			|| !a3demo_bvhInternalReserve((void**)&bvh->box, &bvh->objectCapacity, count, 6 * sizeof(a3f32)))
+		{
+			free(build->centroid);
+			return 0;
+		}
+		for (i = 0; i < count; ++i)
+		{
+			memcpy(bvh->box + i * 6, bounds[i].min, sizeof(bounds[i].min));
+			memcpy(bvh->box + i * 6 + 3, bounds[i].max, sizeof(bounds[i].max));
+			build->centroid[i * 3 + 0] = (bounds[i].min[0] + bounds[i].max[0]) * 0.5f;
+			build->centroid[i * 3 + 1] = (bounds[i].min[1] + bounds[i].max[1]) * 0.5f;
+			build->centroid[i * 3 + 2] = (bounds[i].min[2] + bounds[i].max[2]) * 0.5f;
+			bvh->object[i] = i;
+		}
+		build->box = bvh->box;
+		build->object = bvh->object;
+
+		// enough subtrees to keep every share busy
+		threadCount = threadCount ? threadCount : 1;
+		threadCount = threadCount < demoBVHSize_thread ? threadCount : demoBVHSize_thread;
+		for (build->taskDepth = 0; threadCount > 1 && (1u << build->taskDepth) < threadCount * demoBVHTask_perThread; ++build->taskDepth);
+		build->taskDepth = threadCount > 1 ? build->taskDepth : (a3ui32)-1;
+
+		// top of tree by caller into hierarchy's own nodes
+		top->node = bvh->node;
+		top->capacity = bvh->nodeCapacity;
+		top->count = 1;
+		if (a3demo_bvhInternalReserve((void**)&top->node, &top->capacity, 1, sizeof(a3_DemoBVHNode)))
+		{
+			a3demo_bvhInternalBuildNode(build, top, 0, 0, count, 0);
+
+			// subtrees by workers and caller, tasks dealt out in turn
+			threadCount = threadCount < build->taskCount ? threadCount : build->taskCount;
+			for (i = 0; i < threadCount; ++i)
+			{
+				work[i].build = build;
+				work[i].first = i;
+				work[i].step = threadCount;
+			}
+			a3demo_workerPoolRun(pool, a3demo_bvhInternalBuildTasks, work, threadCount);
+
+			// append subtrees: each root replaces its placeholder, the rest
+			//	follow the top with child indices moved along
+			for (i = 0, total = top->count; i < build->taskCount; ++i)
+				total += build->taskNodes[i].count ? build->taskNodes[i].count - 1 : 0;
+			result = a3demo_bvhInternalReserve((void**)&top->node, &top->capacity, total, sizeof(a3_DemoBVHNode));
+			for (i = 0; i < build->taskCount; ++i)
+			{
+				sub = build->taskNodes + i;
+				result = result && sub->count;
+				if (result)
+				{
+					base = top->count;
+					memcpy(top->node + base, sub->node + 1, (sub->count - 1) * sizeof(a3_DemoBVHNode));
+					top->node[build->taskNode[i]] = sub->node[0];
+					top->count += sub->count - 1;
+					node = top->node + build->taskNode[i];
+					if (!node->count)
+						node->index += base - 1;
+					for (k = base, node = top->node + base; k < top->count; ++k, ++node)
+						if (!node->count)
+							node->index += base - 1;
+				}
+				free(sub->node);
+			}
+		}
+		bvh->node = top->node;
+		bvh->nodeCapacity = top->capacity;
+		bvh->nodeCount = result ? top->count : 0;
+		bvh->objectCount = result ? count : 0;
+		free(build->centroid);
+		return bvh->nodeCount;
+	}
+	return -1;
+}
+
+a3ret a3demo_bvhRefit(a3_DemoBVH* bvh, a3_VertexBounds const* bounds)
+{
+	a3ui32 i;
+	if (bvh && bounds)
+	{
+		for (i = 0; i < bvh->objectCount; ++i)
+		{
+			memcpy(bvh->box + i * 6, bounds[i].min, sizeof(bounds[i].min));
+			memcpy(bvh->box + i * 6 + 3, bounds[i].max, sizeof(bounds[i].max));
+		}
+		a3demo_bvhInternalRefit(bvh);
+		return bvh->nodeCount;
+	}
+	return -1;
+}
+
+a3ret a3demo_bvhUpdate(a3_DemoBVH* bvh, a3_VertexBounds const* bounds, a3ui32 const count, a3_DemoWorkerPool* pool, a3ui32 threadCount)
+{
+	if (bvh && bounds)
+	{
+		if (bvh->nodeCount && count == bvh->objectCount)
+			return a3demo_bvhRefit(bvh, bounds);
+		return a3demo_bvhBuild(bvh, bounds, count, pool, threadCount);
+	}
+	return -1;
+}
+
+a3ret a3demo_bvhRelease(a3_DemoBVH* bvh)
+{
+	if (bvh)
+	{
+		if (bvh->node || bvh->object || bvh->box)
+		{
+			free(bvh->node);
+			free(bvh->object);
+			free(bvh->box);
+			memset(bvh, 0, sizeof(a3_DemoBVH));
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_bvhQueryFrustum(a3ui32* result_out, a3ui32 const maxCount, a3_DemoBVH const* bvh, a3f32 const planes[6][4])
+{
+	a3ui32 stack[demoBVHSize_stack], stackMask[demoBVHSize_stack];
+	a3ui32 top, mask, objectMask, k, o, count = 0;
+	a3_DemoBVHNode const* node;
+	if (result_out && bvh && planes)
+	{
+		stack[0] = 0;
+		stackMask[0] = 0x3f;
+		for (top = bvh->nodeCount ? 1 : 0; top > 0; )
+		{
+			--top;
+			node = bvh->node + stack[top];
+			mask = stackMask[top];
+			if (!a3demo_bvhInternalFrustumBox(&mask, planes, node->min, node->max))
+				continue;
+			if (node->count)
+			{
+				for (k = 0; k < node->count; ++k)
+				{
+					o = bvh->object[node->index + k];
+					objectMask = mask;
+					if (a3demo_bvhInternalFrustumBox(&objectMask, planes, bvh->box + o * 6, bvh->box + o * 6 + 3))
+					{
+						a3demo_bvhInternalResult(result_out, maxCount, count, o);
+					}
+				}
+			}
+			else
+			{
+				stack[top] = node->index + 1;
+				stackMask[top++] = mask;
+				stack[top] = node->index;
+				stackMask[top++] = mask;
+			}
+		}
+		return count;
+	}
+	return -1;
+}
+
+a3ret a3demo_bvhQuerySphere(a3ui32* result_out, a3ui32 const maxCount, a3_DemoBVH const* bvh, a3f32 const center[3], a3f32 const radius)
+{
+	a3ui32 stack[demoBVHSize_stack];
+	a3ui32 top, k, o, count = 0;
+	a3f32 const radiusSq = radius * radius;
+	a3_DemoBVHNode const* node;
+	if (result_out && bvh && center)
+	{
+		stack[0] = 0;
+		for (top = bvh->nodeCount ? 1 : 0; top > 0; )
+		{
+			node = bvh->node + stack[--top];
+			if (!a3demo_bvhInternalSphereBox(center, radiusSq, node->min, node->max))
+				continue;
+			if (node->count)
+			{
+				for (k = 0; k < node->count; ++k)
+				{
+					o = bvh->object[node->index + k];
+					if (a3demo_bvhInternalSphereBox(center, radiusSq, bvh->box + o * 6, bvh->box + o * 6 + 3))
+					{
+						a3demo_bvhInternalResult(result_out, maxCount, count, o);
+					}
+				}
+			}
+			else
+			{
+				stack[top++] = node->index + 1;
+				stack[top++] = node->index;
+			}
+		}
+		return count;
+	}
+	return -1;
+}
+
+a3ret a3demo_bvhQueryBox(a3ui32* result_out, a3ui32 const maxCount, a3_DemoBVH const* bvh, a3f32 const min[3], a3f32 const max[3])
+{
+	a3ui32 stack[demoBVHSize_stack];
+	a3ui32 top, k, o, count = 0;
+	a3_DemoBVHNode const* node;
+	if (result_out && bvh && min && max)
+	{
+		stack[0] = 0;
+		for (top = bvh->nodeCount ? 1 : 0; top > 0; )
+		{
+			node = bvh->node + stack[--top];
+			if (!a3demo_bvhInternalBoxBox(min, max, node->min, node->max))
+				continue;
+			if (node->count)
+			{
+				for (k = 0; k < node->count; ++k)
+				{
+					o = bvh->object[node->index + k];
+					if (a3demo_bvhInternalBoxBox(min, max, bvh->box + o * 6, bvh->box + o * 6 + 3))
+					{
+						a3demo_bvhInternalResult(result_out, maxCount, count, o);
+					}
+				}
+			}
+			else
+			{
+				stack[top++] = node->index + 1;
+				stack[top++] = node->index;
+			}
+		}
+		return count;
+	}
+	return -1;
+}
+
+a3ret a3demo_bvhQueryRay(a3ui32* hit_out, a3f32* distance_out_opt, a3_DemoBVH const* bvh,
+	a3f32 const origin[3], a3f32 const direction[3], a3f32 const maxDistance)
+{
+	a3ui32 stack[demoBVHSize_stack];
+	a3ui32 top, k, o, hit = (a3ui32)-1;
+	a3f32 directionInv[3], nearest = maxDistance, t, tLeft, tRight;
+	a3_DemoBVHNode const* node;
+	if (hit_out && bvh && origin && direction)
+	{
+		// rays along an axis use a huge inverse instead of infinity
+		for (k = 0; k < 3; ++k)
+			directionInv[k] = direction[k] != 0.0f ? 1.0f / direction[k] : 3.0e38f;
+
+		// nearer child is visited first, farther ones are dropped once
+		//	something nearer is hit
+		stack[0] = 0;
+		for (top = bvh->nodeCount ? 1 : 0; top > 0; )
+		{
+			node = bvh->node + stack[--top];
+			if (a3demo_bvhInternalRayBox(origin, directionInv, nearest, node->min, node->max) < 0.0f)
+				continue;
+			if (node->count)
+			{
+				for (k = 0; k < node->count; ++k)
+				{
+					o = bvh->object[node->index + k];
+					t = a3demo_bvhInternalRayBox(origin, directionInv, nearest, bvh->box + o * 6, bvh->box + o * 6 + 3);
+					if (t >= 0.0f && (t < nearest || hit == (a3ui32)-1))
+					{
+						nearest = t;
+						hit = o;
+					}
+				}
+			}
+			else
+			{
+				tLeft = a3demo_bvhInternalRayBox(origin, directionInv, nearest, bvh->node[node->index].min, bvh->node[node->index].max);
+				tRight = a3demo_bvhInternalRayBox(origin, directionInv, nearest, bvh->node[node->index + 1].min, bvh->node[node->index + 1].max);
+				if (tLeft >= 0.0f && tRight >= 0.0f)
+				{
+					stack[top++] = node->index + (tLeft < tRight);
+					stack[top++] = node->index + (tLeft >= tRight);
+				}
+				else if (tLeft >= 0.0f)
+					stack[top++] = node->index;
+				else if (tRight >= 0.0f)
+					stack[top++] = node->index + 1;
+			}
+		}
+		if (hit != (a3ui32)-1)
+		{
+			*hit_out = hit;
+			if (distance_out_opt)
+				*distance_out_opt = nearest;
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_bvhReport(a3f32 const planes[6][4], a3ui32 const count, a3_DemoWorkerPool* pool, a3ui32 const threadCountMax)
+{
+	enum {
+		queryCount = 1000,
+	};
+	a3_DemoBVH bvh[1] = { 0 };
+	a3_Timer timer[1] = { 0 };
+	a3_VertexBounds* bounds;
+	a3ui32* result;
+	a3f32 side, size, p[3], d[3], distance;
+	a3f64 buildTime = 0.0;
+	a3ui32 i, j, k, seed = 1, threadCount, nodeCount = 0, found, objectMask;
+
+	if (planes && count)
+	{
+		bounds = (a3_VertexBounds*)malloc(count * sizeof(a3_VertexBounds));
+		result = (a3ui32*)malloc(count * sizeof(a3ui32));
+		if (!bounds || !result)
+		{
+			free(bounds);
+			free(result);
+			return 0;
+		}
+
+#define a3demo_bvhInternalRandom()	((a3f32)((seed = seed * 1664525u + 1013904223u) >> 8) * (1.0f / 16777216.0f))
+
+		// boxes up to 2 units across, spread so density does not change
+		side = 4.0f * cbrtf((a3f32)count);
+		for (i = 0; i < count; ++i)
+			for (j = 0; j < 3; ++j)
+			{
+				p[j] = (a3demo_bvhInternalRandom() - 0.5f) * side;
+				size = a3demo_bvhInternalRandom();
+				bounds[i].min[j] = p[j] - size;
+				bounds[i].max[j] = p[j] + size;
+			}
+
+		printf("\n\n  bounding volume hierarchy of %u random objects:", count);
+		for (threadCount = 1; threadCount <= threadCountMax; threadCount <<= 1)
+		{
+			a3demo_bvhRelease(bvh);
+			a3timerStart(timer);
+			nodeCount = a3demo_bvhBuild(bvh, bounds, count, pool, threadCount);
+			a3timerStop(timer);
+			buildTime = threadCount > 1 ? buildTime : timer->currentTick;
+			printf("\n  build, %u thread%s: %9.3lf ms (%.2lfx), %u nodes", threadCount, threadCount > 1 ? "s" : " ",
+				timer->currentTick * 1000.0, buildTime / timer->currentTick, nodeCount);
+		}
+
+		// everything moves a little
+		for (i = 0; i < count; ++i)
+			for (j = 0; j < 3; ++j)
+			{
+				size = a3demo_bvhInternalRandom() - 0.5f;
+				bounds[i].min[j] += size;
+				bounds[i].max[j] += size;
+			}
+		a3timerStart(timer);
+		a3demo_bvhRefit(bvh, bounds);
+		a3timerStop(timer);
+		printf("\n  refit:            %9.3lf ms", timer->currentTick * 1000.0);
+
+		// frustum, checked against every object
+		a3timerStart(timer);
+		found = a3demo_bvhQueryFrustum(result, count, bvh, planes);
+		a3timerStop(timer);
+		printf("\n  frustum:          %9.3lf us, %u found", timer->currentTick * 1000000.0, found);
+		for (i = k = 0; i < count; ++i)
+		{
+			objectMask = 0x3f;
+			k += a3demo_bvhInternalFrustumBox(&objectMask, planes, bounds[i].min, bounds[i].max);
+		}
+		if (k != found)
+			printf(" (every object: %u)", k);
+
+		// spheres and boxes 8 across, rays up to the whole volume
+		a3timerStart(timer);
+		for (i = found = 0; i < queryCount; ++i)
+		{
+			for (j = 0; j < 3; ++j)
+				p[j] = (a3demo_bvhInternalRandom() - 0.5f) * side;
+			found += a3demo_bvhQuerySphere(result, count, bvh, p, 4.0f);
+		}
+		a3timerStop(timer);
+		printf("\n  sphere:           %9.3lf us per query, %.1lf found", timer->currentTick * 1000000.0 / queryCount, (a3f64)found / queryCount);
+
+		a3timerStart(timer);
+		for (i = found = 0; i < queryCount; ++i)
+		{
+			for (j = 0; j < 3; ++j)
+			{
+				p[j] = (a3demo_bvhInternalRandom() - 0.5f) * side - 4.0f;
+				d[j] = p[j] + 8.0f;
+			}
+			found += a3demo_bvhQueryBox(result, count, bvh, p, d);
+		}
+		a3timerStop(timer);
+		printf("\n  box:              %9.3lf us per query, %.1lf found", timer->currentTick * 1000000.0 / queryCount, (a3f64)found / queryCount);
+
+		a3timerStart(timer);
+		for (i = found = 0; i < queryCount; ++i)
+		{
+			for (j = 0; j < 3; ++j)
+			{
+				p[j] = (a3demo_bvhInternalRandom() - 0.5f) * side;
+				d[j] = a3demo_bvhInternalRandom() - 0.5f;
+			}
+			found += a3demo_bvhQueryRay(&k, &distance, bvh, p, d, side * 4.0f);
+		}
+		a3timerStop(timer);
+		printf("\n  ray:              %9.3lf us per query, %u of %u hit", timer->currentTick * 1000000.0 / queryCount, found, queryCount);
+		printf("\n");
+
+#undef a3demo_bvhInternalRandom
+
+		a3demo_bvhRelease(bvh);
+		free(bounds);
+		free(result);
+		return nodeCount;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,266 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoCulling.c
+	Object culling implementation.
+*/
+
+#include "../a3_DemoCulling.h"
+
+#include "animal3D-A3DM/a3math/a3simd.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// vector paths follow the instruction set selected for math, which 
+//	includes the intrinsics headers: four wide on every x86 level, eight 
+//	wide with AVX2
+#if (A3_SIMD == A3_SIMD_SSE2 || A3_SIMD == A3_SIMD_SSE41 || A3_SIMD == A3_SIMD_AVX2)
+#define A3_DEMO_CULL_SSE
+#endif	// (A3_SIMD == A3_SIMD_SSE2 || A3_SIMD == A3_SIMD_SSE41 || A3_SIMD == A3_SIMD_AVX2)
+#if (A3_SIMD == A3_SIMD_AVX2)
+#define A3_DEMO_CULL_AVX
+#endif	// (A3_SIMD == A3_SIMD_AVX2)
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// vector widths available
+enum a3_DemoCullWidth
+{
+	demoCullWidth_scalar = 1,
+	demoCullWidth_sse = 4,
+	demoCullWidth_avx = 8,
+};
+
+// test spheres in range one at a time; sphere is outside if it is 
+//	entirely behind any plane: distance of center < -radius
+inline a3ui32 a3demo_cullInternalSpheresScalar(a3ui32* visible_out, a3ui32 count,
+	a3f32 const* const c[demoCullSphere_max], a3f32 const planes[6][4], a3ui32 const first, a3ui32 const last)
+{
+	a3ui32 i, k, outside;
+	for (i = first; i < last; ++i)
+	{
+		for (k = 0, outside = 0; k < 6 && !outside; ++k)
+			outside = ((planes[k][0] * c[0][i] + planes[k][1] * c[1][i]) + (planes[k][2] * c[2][i] + (planes[k][3] + c[3][i])) < 0.0f);
+		visible_out[count] = i;
+		count += !outside;
+	}
+	return count;
+}
+
+#ifdef A3_DEMO_CULL_SSE
+// four spheres at a time, all six planes; plane terms are splatted once, 
+//	and the sign bits of the distances are the outside mask, so visible 
+//	indices are written without branches
+inline a3ui32 a3demo_cullInternalSpheresSSE(a3ui32* visible_out, a3ui32 count,
+	a3f32 const* const c[demoCullSphere_max], a3f32 const planes[6][4], a3ui32* first, a3ui32 const last)
+{
+	__m128 px[6], py[6], pz[6], pw[6], cx, cy, cz, r, outside;
+	a3ui32 i, k, mask;
+	for (k = 0; k < 6; ++k)
+	{
+		px[k] = _mm_set1_ps(planes[k][0]);
+		py[k] = _mm_set1_ps(planes[k][1]);
+		pz[k] = _mm_set1_ps(planes[k][2]);
+		pw[k] = _mm_set1_ps(planes[k][3]);
+	}
+	for (i = *first; i + demoCullWidth_sse <= last; i += demoCullWidth_sse)
+	{
+		cx = _mm_loadu_ps(c[0] + i);
+		cy = _mm_loadu_ps(c[1] + i);
+		cz = _mm_loadu_ps(c[2] + i);
+		r = _mm_loadu_ps(c[3] + i);
+		outside = _mm_setzero_ps();
+		for (k = 0; k < 6; ++k)
+			outside = _mm_or_ps(outside, _mm_add_ps(_mm_add_ps(_mm_mul_ps(px[k], cx), _mm_mul_ps(py[k], cy)),
+				_mm_add_ps(_mm_mul_ps(pz[k], cz), _mm_add_ps(pw[k], r))));
+		mask = (a3ui32)_mm_movemask_ps(outside);
+		visible_out[count] = i + 0;
+		count += !(mask & 1);
+		visible_out[count] = i + 1;
+		count += !(mask & 2);
+		visible_out[count] = i + 2;
+		count += !(mask & 4);
+		visible_out[count] = i + 3;
+		count += !(mask & 8);
+	}
+	*first = i;
+	return count;
+}
+#endif	// A3_DEMO_CULL_SSE
+
+#ifdef A3_DEMO_CULL_AVX
+// eight spheres at a time, fused where the build has it
+inline a3ui32 a3demo_cullInternalSpheresAVX(a3ui32* visible_out, a3ui32 count,
+	a3f32 const* const c[demoCullSphere_max], a3f32 const planes[6][4], a3ui32* first, a3ui32 const last)
+{
+	__m256 px[6], py[6], pz[6], pw[6], cx, cy, cz, r, outside;
+	a3ui32 i, k, j, mask;
+	for (k = 0; k < 6; ++k)
+	{
+		px[k] = _mm256_set1_ps(planes[k][0]);
+		py[k] = _mm256_set1_ps(planes[k][1]);
+		pz[k] = _mm256_set1_ps(planes[k][2]);
+		pw[k] = _mm256_set1_ps(planes[k][3]);
+	}
+	for (i = *first; i + demoCullWidth_avx <= last; i += demoCullWidth_avx)
+	{
+		cx = _mm256_loadu_ps(c[0] + i);
+		cy = _mm256_loadu_ps(c[1] + i);
+		cz = _mm256_loadu_ps(c[2] + i);
+		r = _mm256_loadu_ps(c[3] + i);
+		outside = _mm256_setzero_ps();
+		for (k = 0; k < 6; ++k)
+#ifdef A3_SIMD_FMA
+			outside = _mm256_or_ps(outside, _mm256_fmadd_ps(px[k], cx,
+				_mm256_fmadd_ps(py[k], cy, _mm256_fmadd_ps(pz[k], cz, _mm256_add_ps(pw[k], r)))));
+#else	// !A3_SIMD_FMA
+			outside = _mm256_or_ps(outside, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px[k], cx), _mm256_mul_ps(py[k], cy)),
+				_mm256_add_ps(_mm256_mul_ps(pz[k], cz), _mm256_add_ps(pw[k], r))));
+#endif	// A3_SIMD_FMA
+		mask = (a3ui32)_mm256_movemask_ps(outside);
+		for (j = 0; j < demoCullWidth_avx; ++j)
+		{
+			visible_out[count] = i + j;
+			count += !((mask >> j) & 1);
+		}
+	}
+	*first = i;
+	return count;
+}
+#endif	// A3_DEMO_CULL_AVX
+
+// cull with at most the given vector width
+inline a3ui32 a3demo_cullInternalSpheres(a3ui32* visible_out, a3_DemoCullSpheres const* spheres, a3f32 const planes[6][4], a3ui32 const width)
+{
+	a3f32 const* const* c = (a3f32 const* const*)spheres->component;
+	a3ui32 count = 0, first = 0;
+#ifdef A3_DEMO_CULL_AVX
+	if (width >= demoCullWidth_avx)
+		count = a3demo_cullInternalSpheresAVX(visible_out, count, c, planes, &first, spheres->count);
+#endif	// A3_DEMO_CULL_AVX
+#ifdef A3_DEMO_CULL_SSE
+	if (width >= demoCullWidth_sse)
+		count = a3demo_cullInternalSpheresSSE(visible_out, count, c, planes, &first, spheres->count);
+#endif	// A3_DEMO_CULL_SSE
+	return a3demo_cullInternalSpheresScalar(visible_out, count, c, planes, first, spheres->count);
+}
+
+
+//-----------------------------------------------------------------------------
+
+void a3demo_cullStoreSphere(a3_DemoCullSpheres* spheres, a3ui32 const index, a3_VertexBounds const* bounds, a3real const* modelMat_opt)
+{
+	a3_VertexBounds world[1];
+	if (spheres && bounds)
+	{
+		if (modelMat_opt)
+			a3geometryTransformBounds(world, bounds, modelMat_opt);
+		else
+			*world = *bounds;
+		spheres->component[demoCullSphere_centerX][index] = world->center[0];
+		spheres->component[demoCullSphere_centerY][index] = world->center[1];
+		spheres->component[demoCullSphere_centerZ][index] = world->center[2];
+		spheres->component[demoCullSphere_radius][index] = world->radius;
+	}
+}
+
+a3ret a3demo_cullSpheres(a3ui32* visible_out, a3_DemoCullStats* stats_out_opt, a3_DemoCullSpheres const* spheres, a3f32 const planes[6][4])
+{
+	a3ui32 count;
+	if (visible_out && spheres && planes)
+	{
+		count = a3demo_cullInternalSpheres(visible_out, spheres, planes, demoCullWidth_avx);
+		if (stats_out_opt)
+		{
+			stats_out_opt->tested = spheres->count;
+			stats_out_opt->culled = spheres->count - count;
+		}
+		return count;
+	}
+	return -1;
+}
+
+a3ret a3demo_cullReport(a3f32 const planes[6][4], a3ui32 const count)
+{
+	a3ui32 const width[] = {
+		demoCullWidth_scalar,
+#ifdef A3_DEMO_CULL_SSE
+		demoCullWidth_sse,
+#endif	// A3_DEMO_CULL_SSE
+#ifdef A3_DEMO_CULL_AVX
+		demoCullWidth_avx,
+#endif	// A3_DEMO_CULL_AVX
+	};
+	a3byte const* widthName[] = { "", "scalar", "", "", "SSE", "", "", "", "AVX" };
+	a3_DemoCullSpheres spheres[1];
+	a3_Timer timer[1] = { 0 };
+	a3ui32* visible;
+	a3f32* data;
+	a3ui32 i, j, seed = 1, rep, repCount, visibleCount = 0, visibleCheck = 0;
+	a3f64 perThousand;
+
+	if (planes && count)
+	{
+		data = (a3f32*)malloc(count * (demoCullSphere_max * sizeof(a3f32) + sizeof(a3ui32)));
+		if (!data)
+			return 0;
+		visible = (a3ui32*)(data + count * demoCullSphere_max);
+		for (i = 0; i < demoCullSphere_max; ++i)
+			spheres->component[i] = data + count * i;
+		spheres->count = count;
+
+		// spheres up to 2 units across, scattered within 100 units of origin
+		for (i = 0; i < count; ++i)
+			for (j = 0; j < demoCullSphere_max; ++j)
+			{
+				seed = seed * 1664525u + 1013904223u;
+				spheres->component[j][i] = j < demoCullSphere_radius
+					? (a3f32)(seed >> 8) * (200.0f / 16777216.0f) - 100.0f
+					: (a3f32)(seed >> 8) * (1.0f / 16777216.0f);
+			}
+
+		// enough repetitions to time reliably
+		repCount = 1 + 4000000 / count;
+		printf("\n\n  object culling of %u random spheres against current view:", count);
+		for (i = 0; i < sizeof(width) / sizeof(*width); ++i)
+		{
+			a3timerStart(timer);
+			for (rep = 0; rep < repCount; ++rep)
+				visibleCount = a3demo_cullInternalSpheres(visible, spheres, planes, width[i]);
+			a3timerStop(timer);
+			perThousand = timer->currentTick * 1000000.0 * 1000.0 / ((a3f64)repCount * (a3f64)count);
+			printf("\n  %-6s %6u visible: %8.3lf us per 1000 objects", widthName[width[i]], visibleCount, perThousand);
+			if (i && visibleCount != visibleCheck)
+				printf(" (scalar found %u)", visibleCheck);
+			visibleCheck = i ? visibleCheck : visibleCount;
+		}
+		printf("\n");
+
+		free(data);
+		return visibleCount;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
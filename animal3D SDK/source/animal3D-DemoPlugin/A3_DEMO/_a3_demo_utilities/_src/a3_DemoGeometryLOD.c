@@ -0,0 +1,565 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoGeometryLOD.c
+	Level-of-detail generation implementation.
+*/
+
+#include "../a3_DemoGeometryLOD.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+// symmetric 4x4 error quadric: upper triangle of plane outer products,
+//	and total weight of planes
+typedef struct a3_TAG_DEMOGEOMETRYQUADRIC {
+	a3f64 a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+	a3f64 w;
+} a3_DemoGeometryQuadric;
+
+// one possible collapse: vertex moves onto target
+typedef struct a3_TAG_DEMOGEOMETRYCOLLAPSE {
+	a3ui32 vertex, target;
+	a3f64 cost;
+} a3_DemoGeometryCollapse;
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// attribute arrays of geometry, including implicit ones
+inline void a3demo_geometryLODInternalAttribData(void const* attribData_out[a3attrib_geomNameMax + 2], a3_GeometryData const* geom)
+{
+	memcpy(attribData_out, geom->attribData, sizeof(geom->attribData));
+	attribData_out[a3attrib_geomNameMax + 0] = attribData_out[a3attrib_geomNameMax + 1] = 0;
+	a3geometryGetAddressBitangent(attribData_out + a3attrib_geomNameMax + 0, geom);
+	a3geometryGetAddressBlendingInd(attribData_out + a3attrib_geomNameMax + 1, geom);
+}
+
+// float attributes of geometry and their strides in floats; attributes 
+//	stored in other types are left out
+inline void a3demo_geometryLODInternalFloatAttribs(a3f32 const* attrib_out[a3attrib_geomNameMax], a3ui32 stride_out[a3attrib_geomNameMax],
+	a3_GeometryData const* geom)
+{
+	a3ui32 i, name, type;
+	for (i = 0; i < a3attrib_geomNameMax; ++i)
+	{
+		name = a3geometryGetVertexAttribName(i);
+		type = geom->vertexFormat->attribType[name];
+		attrib_out[i] = (type >= a3attrib_float && type <= a3attrib_vec4) ? (a3f32 const*)geom->attribData[i] : 0;
+		stride_out[i] = geom->vertexFormat->attribElements[name];
+	}
+}
+
+// add area-weighted plane of triangle to quadric
+inline void a3demo_geometryLODInternalQuadricAdd(a3_DemoGeometryQuadric* q, a3f32 const* p0, a3f32 const* p1, a3f32 const* p2)
+{
+	a3f64 const e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+	a3f64 const e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+	a3f64 n[3] = {
+		e1[1] * e2[2] - e1[2] * e2[1],
+		e1[2] * e2[0] - e1[0] * e2[2],
+		e1[0] * e2[1] - e1[1] * e2[0],
+	};
+	a3f64 const length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+	a3f64 d, w;
+	if (length > 0.0)
+	{
+		n[0] /= length;
+		n[1] /= length;
+		n[2] /= length;
+		d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+		w = length * 0.5;
+		q->a2 += w * n[0] * n[0];
+		q->ab += w * n[0] * n[1];
+		q->ac += w * n[0] * n[2];
+		q->ad += w * n[0] * d;
+		q->b2 += w * n[1] * n[1];
+		q->bc += w * n[1] * n[2];
+		q->bd += w * n[1] * d;
+		q->c2 += w * n[2] * n[2];
+		q->cd += w * n[2] * d;
+		q->d2 += w * d * d;
+		q->w += w;
+	}
+}
+
+// mean squared distance to quadric's planes, weighted by area
+inline a3f64 a3demo_geometryLODInternalQuadricEval(a3_DemoGeometryQuadric const* q, a3f32 const* p)
+{
+	a3f64 const x = p[0], y = p[1], z = p[2];
+	return (q->w > 0.0) ? ((q->a2 * x * x + q->b2 * y * y + q->c2 * z * z + q->d2
+		+ 2.0 * (q->ab * x * y + q->ac * x * z + q->bc * y * z + q->ad * x + q->bd * y + q->cd * z)) / q->w) : 0.0;
+}
+
+// triangle normal (not normalized)
+inline void a3demo_geometryLODInternalNormal(a3f32* n_out, a3f32 const* p0, a3f32 const* p1, a3f32 const* p2)
+{
+	a3f32 const e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+	a3f32 const e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+	n_out[0] = e1[1] * e2[2] - e1[2] * e2[1];
+	n_out[1] = e1[2] * e2[0] - e1[0] * e2[2];
+	n_out[2] = e1[0] * e2[1] - e1[1] * e2[0];
+}
+
+// squared difference of a few floats
+inline a3f64 a3demo_geometryLODInternalDistanceSq(a3f32 const* a, a3f32 const* b, a3ui32 const count)
+{
+	a3f64 d, sum = 0.0;
+	a3ui32 i;
+	for (i = 0; i < count; ++i)
+	{
+		d = a[i] - b[i];
+		sum += d * d;
+	}
+	return sum;
+}
+
+// cost of moving vertex onto target: distance to planes of vertex's
+//	original neighborhood, plus edge length scaled by change of normal, 
+//	texture coordinate and blend weight attributes
+inline a3f64 a3demo_geometryLODInternalCost(a3_DemoGeometryQuadric const* q, a3ui32 const vertex, a3ui32 const target,
+	a3f32 const* const attrib[a3attrib_geomNameMax], a3ui32 const stride[a3attrib_geomNameMax])
+{
+	static a3ui32 const compared[] = { a3attrib_geomNormal, a3attrib_geomTexcoord, a3attrib_geomBlending };
+	a3f32 const* const pv = attrib[a3attrib_geomPosition] + vertex * stride[a3attrib_geomPosition];
+	a3f32 const* const pt = attrib[a3attrib_geomPosition] + target * stride[a3attrib_geomPosition];
+	a3f64 cost = 0.0;
+	a3ui32 i, j;
+	for (i = 0; i < sizeof(compared) / sizeof(*compared); ++i)
+		if (attrib[j = compared[i]])
+			cost += a3demo_geometryLODInternalDistanceSq(attrib[j] + vertex * stride[j], attrib[j] + target * stride[j], stride[j]);
+	cost = cost * a3demo_geometryLODInternalDistanceSq(pv, pt, 3) + a3demo_geometryLODInternalQuadricEval(q, pt);
+	return (cost > 0.0) ? cost : 0.0;
+}
+
+// hash of position bits
+inline a3ui32 a3demo_geometryLODInternalHashPosition(a3f32 const* p)
+{
+	a3ui32 bits[3];
+	memcpy(bits, p, sizeof(bits));
+	return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+}
+
+// hash of undirected edge
+inline a3ui32 a3demo_geometryLODInternalHashEdge(a3ui64 const key)
+{
+	a3ui64 h = key * 0x9E3779B97F4A7C15ull;
+	return (a3ui32)(h >> 32) ^ (a3ui32)h;
+}
+
+// compare collapses by cost
+inline int a3demo_geometryLODInternalCompareCollapse(void const* a, void const* b)
+{
+	a3f64 const lh = ((a3_DemoGeometryCollapse const*)a)->cost, rh = ((a3_DemoGeometryCollapse const*)b)->cost;
+	return (lh > rh) - (lh < rh);
+}
+
+// lock vertices that share a position with another vertex (attribute
+//	seams) or sit on an open border; welding by position first so that
+//	seams do not look like borders
+//	return: 1 if success; 0 if allocation failed
+inline a3ret a3demo_geometryLODInternalLock(a3ubyte* locked_out, a3ui32 const* indices, a3ui32 const indexCount,
+	a3f32 const* positions, a3ui32 const stride, a3ui32 const vertexCount)
+{
+	a3ui32* weld, * table;
+	a3ui64* edgeKey, key;
+	a3ui32* edgeCount;
+	a3ui32 i, j, v, h, a, b, tableSize, edgeTableSize;
+
+	for (tableSize = 1; tableSize < vertexCount * 2; tableSize <<= 1);
+	for (edgeTableSize = 1; edgeTableSize < indexCount * 2; edgeTableSize <<= 1);
+	weld = (a3ui32*)malloc((vertexCount + tableSize + edgeTableSize) * sizeof(a3ui32));
+	edgeKey = (a3ui64*)malloc(edgeTableSize * sizeof(a3ui64));
+	if (!weld || !edgeKey)
+	{
+		free(edgeKey);
+		free(weld);
+		return 0;
+	}
+	table = weld + vertexCount;
+	edgeCount = table + tableSize;
+
+	// weld: first vertex with each position; others sharing it are seams
+	memset(table, 0xff, tableSize * sizeof(a3ui32));
+	memset(locked_out, 0, vertexCount);
+	for (v = 0; v < vertexCount; ++v)
+	{
+		for (h = a3demo_geometryLODInternalHashPosition(positions + v * stride) & (tableSize - 1);
+			table[h] != (a3ui32)-1 && memcmp(positions + table[h] * stride, positions + v * stride, sizeof(a3f32) * 3);
+			h = (h + 1) & (tableSize - 1));
+		if (table[h] == (a3ui32)-1)
+			table[h] = v;
+		else
+			locked_out[v] = locked_out[table[h]] = 1;
+		weld[v] = table[h];
+	}
+	for (v = 0; v < vertexCount; ++v)
+		locked_out[v] |= locked_out[weld[v]];
+
+	// borders: welded edges used by only one triangle
+	memset(edgeKey, 0xff, edgeTableSize * sizeof(a3ui64));
+	memset(edgeCount, 0, edgeTableSize * sizeof(a3ui32));
+	for (i = 0; i < indexCount; ++i)
+	{
+		a = weld[indices[i]];
+		b = weld[indices[i % 3 == 2 ? i - 2 : i + 1]];
+		key = (a < b) ? (((a3ui64)a << 32) | b) : (((a3ui64)b << 32) | a);
+		for (h = a3demo_geometryLODInternalHashEdge(key) & (edgeTableSize - 1);
+			edgeKey[h] != ~0ull && edgeKey[h] != key;
+			h = (h + 1) & (edgeTableSize - 1));
+		edgeKey[h] = key;
+		++edgeCount[h];
+	}
+	for (j = 0; j < edgeTableSize; ++j)
+		if (edgeCount[j] == 1)
+		{
+			weld[(a3ui32)(edgeKey[j] >> 32)] |= 0x80000000u;
+			weld[(a3ui32)edgeKey[j]] |= 0x80000000u;
+		}
+	for (v = 0; v < vertexCount; ++v)
+		if (weld[weld[v] & 0x7fffffffu] & 0x80000000u)
+			locked_out[v] = 1;
+
+	free(edgeKey);
+	free(weld);
+	return 1;
+}
+
+// copy vertices used by indices into new geometry, in order of first use
+//	return: 1 if success; 0 if allocation failed
+inline a3ret a3demo_geometryLODInternalCompact(a3_GeometryData* geom_out, a3_GeometryData const* geom,
+	a3ui32 const* indices, a3ui32 const indexCount)
+{
+	void const* attribSrc[a3attrib_geomNameMax + 2];
+	a3ui32 order[a3attrib_geomNameMax + 2];
+	a3ui32* remap;
+	a3ubyte* dst;
+	a3ubyte const* src;
+	a3ui32 i, j, v, size, count, offset, vertexBytes;
+
+	remap = (a3ui32*)malloc(geom->numVertices * sizeof(a3ui32));
+	if (!remap)
+		return 0;
+	memset(remap, 0xff, geom->numVertices * sizeof(a3ui32));
+	for (i = 0, count = 0; i < indexCount; ++i)
+		if (remap[indices[i]] == (a3ui32)-1)
+			remap[indices[i]] = count++;
+
+	memset(geom_out, 0, sizeof(*geom_out));
+	*geom_out->vertexFormat = *geom->vertexFormat;
+	a3geometryCreateIndexFormat(geom_out->indexFormat, count);
+	geom_out->primType = geom->primType;
+	geom_out->numVertices = count;
+	geom_out->numIndices = indexCount;
+	vertexBytes = a3vertexFormatGetStorageSpaceRequired(geom_out->vertexFormat, count);
+	geom_out->data = malloc(vertexBytes + a3indexFormatGetStorageSpaceRequired(geom_out->indexFormat, indexCount));
+	if (!geom_out->data)
+	{
+		free(remap);
+		return 0;
+	}
+
+	// keep source layout: arrays in the same order, each one shorter
+	a3demo_geometryLODInternalAttribData(attribSrc, geom);
+	for (i = count = 0; i < a3attrib_geomNameMax + 2; ++i)
+		if (attribSrc[i])
+		{
+			for (j = count++; j > 0 && (a3ubyte const*)attribSrc[order[j - 1]] > (a3ubyte const*)attribSrc[i]; --j)
+				order[j] = order[j - 1];
+			order[j] = i;
+		}
+	for (i = 0, offset = 0; i < count; ++i)
+	{
+		src = (a3ubyte const*)attribSrc[order[i]];
+		dst = (a3ubyte*)geom_out->data + offset;
+		size = geom->vertexFormat->attribSize[a3geometryGetVertexAttribName(order[i])];
+		for (v = 0; v < geom->numVertices; ++v)
+			if (remap[v] != (a3ui32)-1)
+				memcpy(dst + remap[v] * size, src + v * size, size);
+		if (order[i] < a3attrib_geomNameMax)
+			geom_out->attribData[order[i]] = dst;
+		offset += size * geom_out->numVertices;
+	}
+
+	// indices after vertices
+	geom_out->indexData = (a3ubyte*)geom_out->data + vertexBytes;
+	dst = (a3ubyte*)geom_out->data + vertexBytes;
+	for (i = 0; i < indexCount; ++i)
+	{
+		v = remap[indices[i]];
+		switch (geom_out->indexFormat->indexSize)
+		{
+		case 1:
+			dst[i] = (a3ubyte)v;
+			break;
+		case 2:
+			((a3ui16*)dst)[i] = (a3ui16)v;
+			break;
+		default:
+			((a3ui32*)dst)[i] = v;
+			break;
+		}
+	}
+
+	free(remap);
+	a3geometryCalculateBounds(geom_out);
+	return 1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_geometrySimplify(a3_GeometryData* geom_out, a3_GeometryData const* geom,
+	a3f32 const ratio, a3f32 const errorLimit, a3f32* error_out_opt)
+{
+	a3_DemoGeometryQuadric* quadric, * q;
+	a3_DemoGeometryCollapse* collapse;
+	a3f32 const* attrib[a3attrib_geomNameMax];
+	a3f32 const* positions, * p0, * p1, * p2, * pb;
+	a3f32 n0[3], n1[3];
+	a3ui32* block, * indices, * remap, * adjacencyStart, * adjacency;
+	a3ubyte* locked, * touched;
+	a3ui32 const* tri;
+	a3f64 limit, error = 0.0;
+	a3ui32 attribStride[a3attrib_geomNameMax];
+	a3ui32 i, j, k, t, a, b, v, stride, indexCount, triangleCount, target, candidateCount, removed, removing, passCollapses;
+	a3ret result;
+
+	if (geom_out && !geom_out->data && geom && geom->data && ratio >= 0.0f)
+	{
+		// float positions, and float attributes whose differences make 
+		//	collapses cost more
+		a3demo_geometryLODInternalFloatAttribs(attrib, attribStride, geom);
+		positions = attrib[a3attrib_geomPosition];
+		stride = attribStride[a3attrib_geomPosition];
+		if (geom->primType != a3prim_triangles || !geom->indexData || geom->numIndices < 3 ||
+			!positions || stride < 3)
+			return 0;
+
+		// indices, remap, adjacency (index count) and adjacency starts
+		indexCount = geom->numIndices - geom->numIndices % 3;
+		block = (a3ui32*)malloc((geom->numIndices * 2 + geom->numVertices * 2 + 1) * sizeof(a3ui32));
+		quadric = (a3_DemoGeometryQuadric*)calloc(geom->numVertices, sizeof(a3_DemoGeometryQuadric));
+		collapse = (a3_DemoGeometryCollapse*)malloc(indexCount * 2 * sizeof(a3_DemoGeometryCollapse));
+		locked = (a3ubyte*)malloc(geom->numVertices * 2);
+		result = (block && quadric && collapse && locked);
+		if (result)
+		{
+			indices = block;
+			adjacency = indices + geom->numIndices;
+			remap = adjacency + geom->numIndices;
+			adjacencyStart = remap + geom->numVertices;
+			touched = locked + geom->numVertices;
+			a3geometryGetIndices(indices, geom);
+			result = a3demo_geometryLODInternalLock(locked, indices, indexCount, positions, stride, geom->numVertices);
+		}
+		if (result)
+		{
+			for (t = 0; t < indexCount; t += 3)
+			{
+				p0 = positions + indices[t + 0] * stride;
+				p1 = positions + indices[t + 1] * stride;
+				p2 = positions + indices[t + 2] * stride;
+				for (i = 0; i < 3; ++i)
+					a3demo_geometryLODInternalQuadricAdd(quadric + indices[t + i], p0, p1, p2);
+			}
+			for (v = 0; v < geom->numVertices; ++v)
+				remap[v] = v;
+
+			triangleCount = indexCount / 3;
+			target = (a3ui32)((a3f32)triangleCount * ratio);
+			limit = (errorLimit > 0.0f) ? ((a3f64)errorLimit * (a3f64)errorLimit) : -1.0;
+
+			// passes of independent collapses until target or nothing left
+			while (triangleCount > target)
+			{
+				// triangles around each vertex
+				memset(adjacencyStart, 0, (geom->numVertices + 1) * sizeof(a3ui32));
+				for (i = 0; i < indexCount; ++i)
+					++adjacencyStart[indices[i] + 1];
+				for (v = 0; v < geom->numVertices; ++v)
+					adjacencyStart[v + 1] += adjacencyStart[v];
+				for (i = 0; i < indexCount; ++i)
+					adjacency[adjacencyStart[indices[i]]++] = i / 3;
+				for (v = geom->numVertices; v > 0; --v)
+					adjacencyStart[v] = adjacencyStart[v - 1];
+				adjacencyStart[0] = 0;
+
+				// cost of moving either end of each edge onto the other
+				for (i = 0, candidateCount = 0; i < indexCount; ++i)
+				{
+					a = indices[i];
+					b = indices[i % 3 == 2 ? i - 2 : i + 1];
+					if (!locked[a])
+					{
+						collapse[candidateCount].vertex = a;
+						collapse[candidateCount].target = b;
+						collapse[candidateCount].cost = a3demo_geometryLODInternalCost(quadric + a, a, b, attrib, attribStride);
+						++candidateCount;
+					}
+					if (!locked[b])
+					{
+						collapse[candidateCount].vertex = b;
+						collapse[candidateCount].target = a;
+						collapse[candidateCount].cost = a3demo_geometryLODInternalCost(quadric + b, b, a, attrib, attribStride);
+						++candidateCount;
+					}
+				}
+				if (!candidateCount)
+					break;
+				qsort(collapse, candidateCount, sizeof(*collapse), a3demo_geometryLODInternalCompareCollapse);
+
+				// take cheapest third of collapses that do not touch each
+				//	other or flip any triangle
+				memset(touched, 0, geom->numVertices);
+				for (j = 0, removed = 0, passCollapses = 0; j < candidateCount && triangleCount - removed > target; ++j)
+				{
+					if (j > candidateCount / 3 && passCollapses)
+						break;
+					if (limit >= 0.0 && collapse[j].cost > limit)
+						break;
+					a = collapse[j].vertex;
+					b = collapse[j].target;
+					if (touched[a] || touched[b])
+						continue;
+					for (k = adjacencyStart[a], removing = 0; k < adjacencyStart[a + 1]; ++k)
+					{
+						tri = indices + adjacency[k] * 3;
+						if (tri[0] == b || tri[1] == b || tri[2] == b)
+						{
+							++removing;
+							continue;
+						}
+						p0 = positions + tri[0] * stride;
+						p1 = positions + tri[1] * stride;
+						p2 = positions + tri[2] * stride;
+						a3demo_geometryLODInternalNormal(n0, p0, p1, p2);
+						pb = positions + b * stride;
+						a3demo_geometryLODInternalNormal(n1, tri[0] == a ? pb : p0, tri[1] == a ? pb : p1, tri[2] == a ? pb : p2);
+						if (n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2] <= 0.0f)
+							break;
+					}
+					if (k < adjacencyStart[a + 1])
+						continue;
+
+					// accept: neighborhood is fixed for the rest of the pass
+					for (k = adjacencyStart[a]; k < adjacencyStart[a + 1]; ++k)
+					{
+						tri = indices + adjacency[k] * 3;
+						touched[tri[0]] = touched[tri[1]] = touched[tri[2]] = 1;
+					}
+					remap[a] = b;
+					q = quadric + b;
+					q->a2 += quadric[a].a2;
+					q->ab += quadric[a].ab;
+					q->ac += quadric[a].ac;
+					q->ad += quadric[a].ad;
+					q->b2 += quadric[a].b2;
+					q->bc += quadric[a].bc;
+					q->bd += quadric[a].bd;
+					q->c2 += quadric[a].c2;
+					q->cd += quadric[a].cd;
+					q->d2 += quadric[a].d2;
+					q->w += quadric[a].w;
+					error = (error > collapse[j].cost) ? error : collapse[j].cost;
+					removed += removing;
+					++passCollapses;
+				}
+				if (!passCollapses)
+					break;
+
+				// apply collapses and drop triangles that became degenerate
+				for (t = 0, i = 0; t < indexCount; t += 3)
+				{
+					a = remap[indices[t + 0]];
+					b = remap[indices[t + 1]];
+					v = remap[indices[t + 2]];
+					if (a != b && b != v && v != a)
+					{
+						indices[i++] = a;
+						indices[i++] = b;
+						indices[i++] = v;
+					}
+				}
+				indexCount = i;
+				triangleCount = indexCount / 3;
+			}
+
+			result = a3demo_geometryLODInternalCompact(geom_out, geom, indices, indexCount);
+			if (error_out_opt)
+				*error_out_opt = (a3f32)sqrt(error);
+		}
+		free(locked);
+		free(collapse);
+		free(quadric);
+		free(block);
+		return result;
+	}
+	return -1;
+}
+
+a3ret a3demo_geometryGenerateLOD(a3_DemoGeometryLOD* lod_out, a3_GeometryData* levels_out, a3_GeometryData const* geom,
+	a3f32 const* ratios, a3ui32 const ratioCount)
+{
+	a3_GeometryData const* source = geom;
+	a3f32 error, ratio;
+	a3ui32 i;
+
+	if (lod_out)
+		memset(lod_out, 0, sizeof(*lod_out));
+	if (lod_out && levels_out && geom && geom->data && ratios && ratioCount < demoGeometryLODMaxCount_level)
+	{
+		lod_out->levelCount = 1;
+		lod_out->triangleCount[0] = geom->numIndices / 3;
+		for (i = 0; i < ratioCount; ++i)
+		{
+			// ratio is of base count, each level starts from the last; error
+			//	is summed since each level only knows the one before it
+			ratio = (source->numIndices >= 3) ? (ratios[i] * (a3f32)geom->numIndices / (a3f32)source->numIndices) : 1.0f;
+			if (a3demo_geometrySimplify(levels_out + i, source, ratio, 0.0f, &error) <= 0)
+				break;
+			lod_out->triangleCount[i + 1] = levels_out[i].numIndices / 3;
+			lod_out->error[i + 1] = lod_out->error[i] + error;
+			++lod_out->levelCount;
+			source = levels_out + i;
+		}
+		return i;
+	}
+	return -1;
+}
+
+a3ui32 a3demo_geometrySelectLOD(a3_DemoGeometryLOD const* lod, a3real const distance, a3real const scale,
+	a3real const projectionScale, a3real const pixelError)
+{
+	a3ui32 level = 0;
+	a3real const pixelsPerUnit = (distance > 0) ? (scale * projectionScale / distance) : 0;
+	if (lod && distance > 0)
+		while (level + 1 < lod->levelCount && lod->error[level + 1] * pixelsPerUnit <= pixelError)
+			++level;
+	return level;
+}
+
+
+//-----------------------------------------------------------------------------
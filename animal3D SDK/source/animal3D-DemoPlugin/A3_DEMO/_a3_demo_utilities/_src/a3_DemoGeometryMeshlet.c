@@ -0,0 +1,461 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoGeometryMeshlet.c
+	Cluster (meshlet) builder and culling implementation.
+*/
+
+#include "../a3_DemoGeometryMeshlet.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// bounding sphere of cluster vertices: start from the farthest pair along
+//	the widest axis, then grow to enclose outliers (Ritter)
+inline void a3demo_geometryMeshletInternalSphere(a3_DemoGeometryMeshlet* meshlet,
+	a3f32 const* position, a3ui32 const* vertex)
+{
+	a3ui32 i, j, lo[3] = { 0 }, hi[3] = { 0 }, axis = 0;
+	a3f32 const* p;
+	a3f32 d[3], span, spanMax = -1.0f, distSq, dist, radius;
+
+	for (i = 0; i < meshlet->vertexCount; ++i)
+	{
+		p = position + vertex[i] * 3;
+		for (j = 0; j < 3; ++j)
+		{
+			if (p[j] < position[vertex[lo[j]] * 3 + j])
+				lo[j] = i;
+			if (p[j] > position[vertex[hi[j]] * 3 + j])
+				hi[j] = i;
+		}
+	}
+	for (j = 0; j < 3; ++j)
+	{
+		for (i = 0, span = 0.0f; i < 3; ++i)
+		{
+			d[i] = position[vertex[hi[j]] * 3 + i] - position[vertex[lo[j]] * 3 + i];
+			span += d[i] * d[i];
+		}
+		if (span > spanMax)
+		{
+			spanMax = span;
+			axis = j;
+		}
+	}
+	for (i = 0; i < 3; ++i)
+		meshlet->center[i] = (position[vertex[hi[axis]] * 3 + i] + position[vertex[lo[axis]] * 3 + i]) * 0.5f;
+	radius = sqrtf(spanMax) * 0.5f;
+
+	for (i = 0; i < meshlet->vertexCount; ++i)
+	{
+		p = position + vertex[i] * 3;
+		for (j = 0, distSq = 0.0f; j < 3; ++j)
+		{
+			d[j] = p[j] - meshlet->center[j];
+			distSq += d[j] * d[j];
+		}
+		if (distSq > radius * radius)
+		{
+			// move center toward point by half of the excess
+			dist = sqrtf(distSq);
+			span = (dist - radius) * 0.5f;
+			for (j = 0; j < 3; ++j)
+				meshlet->center[j] += d[j] / dist * span;
+			radius += span;
+		}
+	}
+	meshlet->radius = radius;
+}
+
+// normal cone of cluster triangles: average direction and the sine of the
+//	widest angle from it; clusters whose triangles face too many ways
+//	(more than 90 degrees from average) get a cutoff that never culls
+inline void a3demo_geometryMeshletInternalCone(a3_DemoGeometryMeshlet* meshlet,
+	a3f32 const* position, a3ui32 const* vertex, a3ubyte const* triangle)
+{
+	a3ui32 i, j, count;
+	a3f32 const* p[3];
+	a3f32 e0[3], e1[3], n[3], axis[3] = { 0.0f }, len, d, dMin = 1.0f;
+	a3f32* normal = (a3f32*)malloc(meshlet->triangleCount * 3 * sizeof(a3f32));
+
+	meshlet->coneAxis[0] = meshlet->coneAxis[1] = 0.0f;
+	meshlet->coneAxis[2] = 1.0f;
+	meshlet->coneCutoff = 1.0f;
+	if (!normal)
+		return;
+
+	for (i = count = 0; i < meshlet->triangleCount; ++i, triangle += 3)
+	{
+		for (j = 0; j < 3; ++j)
+			p[j] = position + vertex[triangle[j]] * 3;
+		for (j = 0; j < 3; ++j)
+		{
+			e0[j] = p[1][j] - p[0][j];
+			e1[j] = p[2][j] - p[0][j];
+		}
+		n[0] = e0[1] * e1[2] - e0[2] * e1[1];
+		n[1] = e0[2] * e1[0] - e0[0] * e1[2];
+		n[2] = e0[0] * e1[1] - e0[1] * e1[0];
+		len = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+		if (len > 0.0f)
+		{
+			for (j = 0; j < 3; ++j)
+			{
+				normal[count * 3 + j] = n[j] / len;
+				axis[j] += n[j] / len;
+			}
+			++count;
+		}
+	}
+
+	len = sqrtf(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+	if (count && len > 0.0f)
+	{
+		for (j = 0; j < 3; ++j)
+			axis[j] /= len;
+		for (i = 0; i < count; ++i)
+		{
+			d = axis[0] * normal[i * 3 + 0] + axis[1] * normal[i * 3 + 1] + axis[2] * normal[i * 3 + 2];
+			if (d < dMin)
+				dMin = d;
+		}
+		for (j = 0; j < 3; ++j)
+			meshlet->coneAxis[j] = axis[j];
+		if (dMin > 0.0f)
+			meshlet->coneCutoff = sqrtf(1.0f - dMin * dMin);
+	}
+	free(normal);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_geometryBuildMeshlets(a3_DemoGeometryMeshlets* meshlets_out, a3_GeometryData const* geom,
+	a3ui32 maxVertices, a3ui32 maxTriangles)
+{
+	a3_DemoGeometryMeshlet* meshlet, * meshletTmp;
+	a3ui32* block, * indices, * adjacencyOffset, * adjacency, * local, * vertexTmp;
+	a3ubyte* used, * triangleTmp;
+	a3ui32 const* tri;
+	a3ui32 i, j, k, v, t, triangleCount, cursor, seed, best, bestNew, newCount;
+	a3ui32 meshletCount, vertexCount, triangleTotal;
+	a3f32 const* position;
+
+	if (meshlets_out && !meshlets_out->meshlet && geom && geom->data)
+	{
+		if (geom->primType != a3prim_triangles || !geom->indexData || geom->numIndices < 3 || geom->numIndices % 3)
+			return 0;
+
+		maxVertices = maxVertices ? maxVertices : demoGeometryMeshletMaxCount_vertex;
+		maxVertices = maxVertices < demoGeometryMeshletMaxCount_vertexLimit ? maxVertices : demoGeometryMeshletMaxCount_vertexLimit;
+		maxVertices = maxVertices >= 3 ? maxVertices : 3;
+		maxTriangles = maxTriangles ? maxTriangles : demoGeometryMeshletMaxCount_triangle;
+		triangleCount = geom->numIndices / 3;
+
+		// working memory: indices, vertex-to-triangle adjacency, local
+		//	vertex map; worst case output tables
+		block = (a3ui32*)malloc((geom->numIndices * 3 + geom->numVertices * 2 + 1) * sizeof(a3ui32));
+		meshletTmp = (a3_DemoGeometryMeshlet*)malloc(triangleCount * sizeof(a3_DemoGeometryMeshlet));
+		used = (a3ubyte*)malloc(triangleCount + geom->numIndices);
+		if (!block || !meshletTmp || !used)
+		{
+			free(block);
+			free(meshletTmp);
+			free(used);
+			return 0;
+		}
+		indices = block;
+		adjacency = indices + geom->numIndices;
+		vertexTmp = adjacency + geom->numIndices;
+		adjacencyOffset = vertexTmp + geom->numIndices;
+		local = adjacencyOffset + geom->numVertices + 1;
+		triangleTmp = used + triangleCount;
+		a3geometryGetIndices(indices, geom);
+		memset(used, 0, triangleCount);
+		memset(local, 0xff, geom->numVertices * sizeof(a3ui32));
+
+		// triangles using each vertex
+		memset(adjacencyOffset, 0, (geom->numVertices + 1) * sizeof(a3ui32));
+		for (i = 0; i < geom->numIndices; ++i)
+			++adjacencyOffset[indices[i] + 1];
+		for (v = 0; v < geom->numVertices; ++v)
+			adjacencyOffset[v + 1] += adjacencyOffset[v];
+		for (i = 0; i < geom->numIndices; ++i)
+			adjacency[adjacencyOffset[indices[i]]++] = i / 3;
+		for (v = geom->numVertices; v > 0; --v)
+			adjacencyOffset[v] = adjacencyOffset[v - 1];
+		adjacencyOffset[0] = 0;
+
+		// grow clusters from seeds
+		meshletCount = vertexCount = triangleTotal = cursor = 0;
+		seed = (a3ui32)-1;
+		while (triangleTotal < triangleCount)
+		{
+			if (seed == (a3ui32)-1)
+			{
+				while (used[cursor])
+					++cursor;
+				seed = cursor;
+			}
+			meshlet = meshletTmp + meshletCount++;
+			meshlet->vertexOffset = vertexCount;
+			meshlet->vertexCount = 0;
+			meshlet->triangleOffset = triangleTotal;
+			meshlet->triangleCount = 0;
+
+			for (best = seed, seed = (a3ui32)-1; best != (a3ui32)-1; )
+			{
+				// add triangle
+				tri = indices + best * 3;
+				used[best] = 1;
+				for (j = 0; j < 3; ++j)
+				{
+					v = tri[j];
+					if (local[v] == (a3ui32)-1)
+					{
+						local[v] = meshlet->vertexCount++;
+						vertexTmp[vertexCount++] = v;
+					}
+					triangleTmp[triangleTotal * 3 + j] = (a3ubyte)local[v];
+				}
+				++meshlet->triangleCount;
+				++triangleTotal;
+
+				// next: unused neighbor adding fewest vertices
+				best = (a3ui32)-1;
+				bestNew = 4;
+				for (i = meshlet->vertexOffset; i < vertexCount && bestNew; ++i)
+				{
+					v = vertexTmp[i];
+					for (k = adjacencyOffset[v]; k < adjacencyOffset[v + 1]; ++k)
+					{
+						t = adjacency[k];
+						if (!used[t])
+						{
+							tri = indices + t * 3;
+							newCount = (local[tri[0]] == (a3ui32)-1) + (local[tri[1]] == (a3ui32)-1) + (local[tri[2]] == (a3ui32)-1);
+							if (newCount < bestNew)
+							{
+								best = t;
+								bestNew = newCount;
+							}
+						}
+					}
+				}
+
+				// cluster full: best neighbor seeds the next one
+				if (best != (a3ui32)-1 && (meshlet->vertexCount + bestNew > maxVertices || meshlet->triangleCount >= maxTriangles))
+				{
+					seed = best;
+					best = (a3ui32)-1;
+				}
+			}
+
+			// clear local map for next cluster
+			for (i = meshlet->vertexOffset; i < vertexCount; ++i)
+				local[vertexTmp[i]] = (a3ui32)-1;
+		}
+
+		// pack tables into one allocation and compute culling data
+		memset(meshlets_out, 0, sizeof(*meshlets_out));
+		meshlets_out->meshlet = (a3_DemoGeometryMeshlet*)malloc(meshletCount * sizeof(a3_DemoGeometryMeshlet)
+			+ vertexCount * sizeof(a3ui32) + triangleTotal * 3);
+		if (meshlets_out->meshlet)
+		{
+			meshlets_out->meshletCount = meshletCount;
+			meshlets_out->vertexCount = vertexCount;
+			meshlets_out->triangleCount = triangleTotal;
+			meshlets_out->vertex = (a3ui32*)(meshlets_out->meshlet + meshletCount);
+			meshlets_out->triangle = (a3ubyte*)(meshlets_out->vertex + vertexCount);
+			memcpy(meshlets_out->meshlet, meshletTmp, meshletCount * sizeof(a3_DemoGeometryMeshlet));
+			memcpy(meshlets_out->vertex, vertexTmp, vertexCount * sizeof(a3ui32));
+			memcpy(meshlets_out->triangle, triangleTmp, triangleTotal * 3);
+
+			position = (a3f32 const*)geom->attribData[a3attrib_geomPosition];
+			for (i = 0, meshlet = meshlets_out->meshlet; i < meshletCount; ++i, ++meshlet)
+			{
+				a3demo_geometryMeshletInternalSphere(meshlet, position, meshlets_out->vertex + meshlet->vertexOffset);
+				a3demo_geometryMeshletInternalCone(meshlet, position, meshlets_out->vertex + meshlet->vertexOffset,
+					meshlets_out->triangle + meshlet->triangleOffset * 3);
+			}
+		}
+		else
+			meshletCount = 0;
+
+		free(block);
+		free(meshletTmp);
+		free(used);
+		return meshletCount;
+	}
+	return -1;
+}
+
+a3ret a3demo_geometryReleaseMeshlets(a3_DemoGeometryMeshlets* meshlets)
+{
+	if (meshlets)
+	{
+		if (meshlets->meshlet)
+		{
+			free(meshlets->meshlet);
+			memset(meshlets, 0, sizeof(*meshlets));
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_geometrySaveMeshletsBinary(a3_DemoGeometryMeshlets const* meshlets, a3_FileStream const* fileStream)
+{
+	FILE* fp;
+	a3ui32 ret = 0;
+	if (meshlets && fileStream && fileStream->stream)
+	{
+		fp = fileStream->stream;
+		ret += (a3ui32)fwrite(&meshlets->meshletCount, 1, sizeof(a3ui32), fp);
+		ret += (a3ui32)fwrite(&meshlets->vertexCount, 1, sizeof(a3ui32), fp);
+		ret += (a3ui32)fwrite(&meshlets->triangleCount, 1, sizeof(a3ui32), fp);
+		if (meshlets->meshlet)
+		{
+			ret += (a3ui32)fwrite(meshlets->meshlet, 1, meshlets->meshletCount * sizeof(a3_DemoGeometryMeshlet), fp);
+			ret += (a3ui32)fwrite(meshlets->vertex, 1, meshlets->vertexCount * sizeof(a3ui32), fp);
+			ret += (a3ui32)fwrite(meshlets->triangle, 1, meshlets->triangleCount * 3, fp);
+		}
+		return ret;
+	}
+	return -1;
+}
+
+a3ret a3demo_geometryLoadMeshletsBinary(a3_DemoGeometryMeshlets* meshlets_out, a3_FileStream const* fileStream)
+{
+	FILE* fp;
+	a3ui32 ret = 0, count[3] = { 0 }, size;
+	if (meshlets_out && !meshlets_out->meshlet && fileStream && fileStream->stream)
+	{
+		fp = fileStream->stream;
+		if (fread(count, 1, sizeof(count), fp) != sizeof(count) || !count[0])
+			return 0;
+		ret += sizeof(count);
+
+		size = count[0] * sizeof(a3_DemoGeometryMeshlet) + count[1] * sizeof(a3ui32) + count[2] * 3;
+		meshlets_out->meshlet = (a3_DemoGeometryMeshlet*)malloc(size);
+		if (!meshlets_out->meshlet)
+			return 0;
+		if (fread(meshlets_out->meshlet, 1, size, fp) != size)
+		{
+			free(meshlets_out->meshlet);
+			meshlets_out->meshlet = 0;
+			return 0;
+		}
+		ret += size;
+		meshlets_out->meshletCount = count[0];
+		meshlets_out->vertexCount = count[1];
+		meshlets_out->triangleCount = count[2];
+		meshlets_out->vertex = (a3ui32*)(meshlets_out->meshlet + count[0]);
+		meshlets_out->triangle = (a3ubyte*)(meshlets_out->vertex + count[1]);
+		return ret;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+void a3demo_geometryMeshletFrustum(a3f32 planes_out[6][4], a3real const* modelViewProjection)
+{
+	// rows of matrix, stored by column
+	a3real const* const m = modelViewProjection;
+	a3ui32 i, j;
+	a3f32 sign, len;
+	for (i = 0; i < 6; ++i)
+	{
+		sign = (i & 1) ? -1.0f : +1.0f;
+		for (j = 0; j < 4; ++j)
+			planes_out[i][j] = (a3f32)(m[j * 4 + 3] + sign * m[j * 4 + i / 2]);
+		len = sqrtf(planes_out[i][0] * planes_out[i][0] + planes_out[i][1] * planes_out[i][1] + planes_out[i][2] * planes_out[i][2]);
+		if (len > 0.0f)
+			for (j = 0; j < 4; ++j)
+				planes_out[i][j] /= len;
+	}
+}
+
+a3ret a3demo_geometryCullMeshlets(a3ui32* visible_out_opt, a3_DemoGeometryMeshletCullStats* stats_out_opt,
+	a3_DemoGeometryMeshlets const* meshlets, a3f32 const planes[6][4], a3real const* eye)
+{
+	a3_DemoGeometryMeshletCullStats stats[1] = { 0 };
+	a3_DemoGeometryMeshlet const* meshlet;
+	a3ui32 i, j, visible = 0;
+	a3f32 d[3], dist;
+	a3boolean culled;
+
+	if (meshlets && planes && eye)
+	{
+		for (i = 0, meshlet = meshlets->meshlet; i < meshlets->meshletCount; ++i, ++meshlet)
+		{
+			// sphere entirely behind any plane
+			for (j = 0, culled = 0; j < 6 && !culled; ++j)
+				culled = (planes[j][0] * meshlet->center[0] + planes[j][1] * meshlet->center[1]
+					+ planes[j][2] * meshlet->center[2] + planes[j][3] < -meshlet->radius);
+			if (culled)
+			{
+				++stats->meshletFrustum;
+				stats->triangleFrustum += meshlet->triangleCount;
+				continue;
+			}
+
+			// every triangle faces away from every point of the sphere
+			for (j = 0, dist = 0.0f; j < 3; ++j)
+			{
+				d[j] = meshlet->center[j] - (a3f32)eye[j];
+				dist += d[j] * d[j];
+			}
+			if (d[0] * meshlet->coneAxis[0] + d[1] * meshlet->coneAxis[1] + d[2] * meshlet->coneAxis[2]
+				>= meshlet->coneCutoff * sqrtf(dist) + meshlet->radius)
+			{
+				++stats->meshletCone;
+				stats->triangleCone += meshlet->triangleCount;
+				continue;
+			}
+
+			if (visible_out_opt)
+				visible_out_opt[visible] = i;
+			++visible;
+		}
+
+		if (stats_out_opt)
+		{
+			stats->meshletCount = meshlets->meshletCount;
+			stats->triangleCount = meshlets->triangleCount;
+			*stats_out_opt = *stats;
+		}
+		return visible;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
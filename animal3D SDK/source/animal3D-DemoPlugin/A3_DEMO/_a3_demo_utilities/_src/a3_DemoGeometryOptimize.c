@@ -0,0 +1,550 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoGeometryOptimize.c
+	Geometry reordering implementation.
+*/
+
+#include "../a3_DemoGeometryOptimize.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+// one cluster of triangles and its overdraw sort key
+typedef struct a3_TAG_DEMOGEOMETRYCLUSTER {
+	a3ui32 start, count;					// range of triangles
+	a3f32 key;								// larger draws first
+} a3_DemoGeometryCluster;
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// check that geometry is indexed triangles
+inline a3boolean a3demo_geometryInternalIndexedTriangles(a3_GeometryData const* geom)
+{
+	return (geom->primType == a3prim_triangles && geom->indexData &&
+		geom->numIndices >= 3 && geom->numIndices % 3 == 0);
+}
+
+// write 32-bit indices back in geometry's index format
+//	(index data belongs to the geometry's own data block)
+inline void a3demo_geometryInternalWriteIndices(a3_GeometryData* geom, a3ui32 const* indices)
+{
+	void* const indexData = (void*)geom->indexData;
+	a3ui32 i;
+	switch (geom->indexFormat->indexSize)
+	{
+	case 1:
+		for (i = 0; i < geom->numIndices; ++i)
+			((a3ubyte*)indexData)[i] = (a3ubyte)indices[i];
+		break;
+	case 2:
+		for (i = 0; i < geom->numIndices; ++i)
+			((a3ui16*)indexData)[i] = (a3ui16)indices[i];
+		break;
+	default:
+		memcpy(indexData, indices, geom->numIndices * sizeof(a3ui32));
+		break;
+	}
+}
+
+// count misses of one triangle in FIFO cache; timestamps count misses so
+//	a vertex is cached if fewer than cacheSize misses happened since
+inline a3ui32 a3demo_geometryInternalCacheTriangle(a3ui32* stamp, a3ui32* time, a3ui32 const* triangle, a3ui32 const cacheSize)
+{
+	a3ui32 i, v, misses = 0;
+	for (i = 0; i < 3; ++i)
+	{
+		v = triangle[i];
+		if (*time - stamp[v] > cacheSize)
+		{
+			stamp[v] = (*time)++;
+			++misses;
+		}
+	}
+	return misses;
+}
+
+// Tipsify: next fanning vertex from candidates emitted by last fan,
+//	preferring the oldest one whose remaining triangles still fit in cache
+inline a3i32 a3demo_geometryInternalTipsifyNext(a3ui32 const* candidate, a3ui32 const candidateCount,
+	a3ui32 const* live, a3ui32 const* stamp, a3ui32 const time, a3ui32 const cacheSize,
+	a3ui32* deadEnd, a3ui32* deadEndCount, a3ui32* cursor, a3ui32 const vertexCount)
+{
+	a3i32 best = -1, priority, bestPriority = -1;
+	a3ui32 i, v;
+	for (i = 0; i < candidateCount; ++i)
+	{
+		v = candidate[i];
+		if (live[v])
+		{
+			priority = (time - stamp[v] + 2 * live[v] <= cacheSize) ? (a3i32)(time - stamp[v]) : 0;
+			if (priority > bestPriority)
+			{
+				bestPriority = priority;
+				best = v;
+			}
+		}
+	}
+
+	// dead end: most recently used vertex with triangles left, then any
+	if (best < 0)
+	{
+		while (*deadEndCount)
+			if (live[v = deadEnd[--(*deadEndCount)]])
+				return v;
+		for (; *cursor < vertexCount; ++(*cursor))
+			if (live[*cursor])
+				return *cursor;
+	}
+	return best;
+}
+
+// compare clusters for sort: larger key first, then original order
+inline int a3demo_geometryInternalCompareCluster(void const* a, void const* b)
+{
+	a3_DemoGeometryCluster const* lh = (a3_DemoGeometryCluster const*)a;
+	a3_DemoGeometryCluster const* rh = (a3_DemoGeometryCluster const*)b;
+	if (lh->key != rh->key)
+		return (lh->key > rh->key) ? -1 : +1;
+	return (lh->start > rh->start) - (lh->start < rh->start);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_geometryAnalyzeVertexCache(a3_DemoGeometryCacheStats* stats_out, a3_GeometryData const* geom, a3ui32 cacheSize)
+{
+	a3ui32* block, * indices, * stamp;
+	a3ui32 i, time;
+
+	if (stats_out && geom && geom->data)
+	{
+		memset(stats_out, 0, sizeof(*stats_out));
+		if (geom->primType != a3prim_triangles)
+			return 0;
+		if (!cacheSize)
+			cacheSize = demoGeometryOptimizeDefault_cacheSize;
+
+		// non-indexed: every vertex is transformed once
+		if (!a3demo_geometryInternalIndexedTriangles(geom))
+		{
+			stats_out->triangleCount = geom->numVertices / 3;
+			stats_out->vertexCount = stats_out->invocations = geom->numVertices;
+		}
+		else
+		{
+			block = (a3ui32*)calloc(geom->numIndices + geom->numVertices, sizeof(a3ui32));
+			if (!block)
+				return 0;
+			indices = block;
+			stamp = indices + geom->numIndices;
+			a3geometryGetIndices(indices, geom);
+
+			// first pass counts distinct vertices; second simulates cache
+			for (i = 0; i < geom->numIndices; ++i)
+				if (!stamp[indices[i]])
+				{
+					stamp[indices[i]] = 1;
+					++stats_out->vertexCount;
+				}
+			memset(stamp, 0, geom->numVertices * sizeof(a3ui32));
+			for (i = 0, time = cacheSize + 1; i < geom->numIndices; i += 3)
+				stats_out->invocations += a3demo_geometryInternalCacheTriangle(stamp, &time, indices + i, cacheSize);
+			stats_out->triangleCount = geom->numIndices / 3;
+			free(block);
+		}
+
+		if (stats_out->triangleCount)
+			stats_out->acmr = (a3f64)stats_out->invocations / (a3f64)stats_out->triangleCount;
+		if (stats_out->vertexCount)
+			stats_out->atvr = (a3f64)stats_out->invocations / (a3f64)stats_out->vertexCount;
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3demo_geometryOptimizeVertexCache(a3_GeometryData* geom, a3ui32 cacheSize)
+{
+	a3ui32* block, * indices, * output, * adjacencyStart, * adjacency, * live, * stamp, * deadEnd;
+	a3ubyte* emitted;
+	a3ui32 const* triangle;
+	a3ui32 i, j, t, v, time, outputCount, fanStart, deadEndCount, cursor;
+	a3i32 fan;
+
+	if (geom && geom->data)
+	{
+		if (!a3demo_geometryInternalIndexedTriangles(geom))
+			return 0;
+		if (!cacheSize)
+			cacheSize = demoGeometryOptimizeDefault_cacheSize;
+
+		// indices, output, adjacency and dead-end stack (index count each),
+		//	then per-vertex adjacency start, live count and stamp
+		block = (a3ui32*)calloc(geom->numIndices * 4 + geom->numVertices * 3 + 1, sizeof(a3ui32));
+		emitted = (a3ubyte*)calloc(geom->numIndices / 3, sizeof(a3ubyte));
+		if (!block || !emitted)
+		{
+			free(emitted);
+			free(block);
+			return 0;
+		}
+		indices = block;
+		output = indices + geom->numIndices;
+		adjacency = output + geom->numIndices;
+		deadEnd = adjacency + geom->numIndices;
+		adjacencyStart = deadEnd + geom->numIndices;
+		live = adjacencyStart + geom->numVertices + 1;
+		stamp = live + geom->numVertices;
+		a3geometryGetIndices(indices, geom);
+
+		// triangles using each vertex
+		for (i = 0; i < geom->numIndices; ++i)
+			++live[indices[i]];
+		for (v = 0; v < geom->numVertices; ++v)
+			adjacencyStart[v + 1] = adjacencyStart[v] + live[v];
+		for (i = 0; i < geom->numIndices; ++i)
+			adjacency[adjacencyStart[indices[i]]++] = i / 3;
+		for (v = geom->numVertices; v > 0; --v)
+			adjacencyStart[v] = adjacencyStart[v - 1];
+		adjacencyStart[0] = 0;
+
+		// emit all live triangles around fanning vertex, then pick the next
+		fan = 0;
+		time = cacheSize + 1;
+		outputCount = deadEndCount = cursor = 0;
+		while (fan >= 0)
+		{
+			fanStart = outputCount;
+			for (j = adjacencyStart[fan]; j < adjacencyStart[fan + 1]; ++j)
+			{
+				t = adjacency[j];
+				if (!emitted[t])
+				{
+					emitted[t] = 1;
+					triangle = indices + t * 3;
+					for (i = 0; i < 3; ++i)
+					{
+						v = triangle[i];
+						output[outputCount++] = deadEnd[deadEndCount++] = v;
+						--live[v];
+						if (time - stamp[v] > cacheSize)
+							stamp[v] = time++;
+					}
+				}
+			}
+			fan = a3demo_geometryInternalTipsifyNext(output + fanStart, outputCount - fanStart,
+				live, stamp, time, cacheSize, deadEnd, &deadEndCount, &cursor, geom->numVertices);
+		}
+
+		a3demo_geometryInternalWriteIndices(geom, output);
+		free(emitted);
+		free(block);
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3demo_geometryOptimizeOverdraw(a3_GeometryData* geom, a3ui32 cacheSize, a3f64 const threshold)
+{
+	a3_DemoGeometryCluster* cluster;
+	a3ui32* block, * indices, * output, * stamp, * clusterStart;
+	a3f32 const* positions, * p0, * p1, * p2;
+	a3f32 e1[3], e2[3], n[3], c[3], clusterNormal[3], clusterCenter[3], meshCenter[3] = { 0.0f }, area, meshArea = 0.0f, length;
+	a3f64 hardAcmr;
+	a3ui32 i, j, t, time, misses, triangleCount, clusterCount, hardEnd, softStart, stride;
+
+	if (geom && geom->data)
+	{
+		if (!a3demo_geometryInternalIndexedTriangles(geom) || !geom->attribData[a3attrib_geomPosition])
+			return 0;
+		if (!cacheSize)
+			cacheSize = demoGeometryOptimizeDefault_cacheSize;
+
+		// indices, output, stamps and cluster starts (worst case one each)
+		triangleCount = geom->numIndices / 3;
+		block = (a3ui32*)calloc(geom->numIndices * 2 + geom->numVertices + triangleCount + 1, sizeof(a3ui32));
+		cluster = (a3_DemoGeometryCluster*)malloc(triangleCount * sizeof(a3_DemoGeometryCluster));
+		if (!block || !cluster)
+		{
+			free(cluster);
+			free(block);
+			return 0;
+		}
+		indices = block;
+		output = indices + geom->numIndices;
+		stamp = output + geom->numIndices;
+		clusterStart = stamp + geom->numVertices;
+		a3geometryGetIndices(indices, geom);
+
+		// hard boundaries: triangles sharing nothing with the cache, where
+		//	the current order already starts over
+		clusterCount = 0;
+		for (t = 0, time = cacheSize + 1; t < triangleCount; ++t)
+			if (a3demo_geometryInternalCacheTriangle(stamp, &time, indices + t * 3, cacheSize) == 3 || !t)
+				clusterStart[clusterCount++] = t;
+		clusterStart[clusterCount] = triangleCount;
+
+		// soft boundaries: within each hard cluster, end a cluster (and flush
+		//	the cache, since clusters move) once its miss rate is close enough
+		//	to the hard cluster's; a threshold at or below 1 rarely splits
+		for (i = 0, j = 0; i < clusterCount; ++i)
+		{
+			hardEnd = clusterStart[i + 1];
+			memset(stamp, 0, geom->numVertices * sizeof(a3ui32));
+			for (t = clusterStart[i], time = cacheSize + 1, misses = 0; t < hardEnd; ++t)
+				misses += a3demo_geometryInternalCacheTriangle(stamp, &time, indices + t * 3, cacheSize);
+			hardAcmr = threshold * (a3f64)misses / (a3f64)(hardEnd - clusterStart[i]);
+			if (threshold <= 1.0)
+				hardAcmr = 0.0;
+
+			memset(stamp, 0, geom->numVertices * sizeof(a3ui32));
+			for (t = softStart = clusterStart[i], time = cacheSize + 1, misses = 0; t < hardEnd; ++t)
+			{
+				misses += a3demo_geometryInternalCacheTriangle(stamp, &time, indices + t * 3, cacheSize);
+				if (t + 1 == hardEnd || (a3f64)misses <= hardAcmr * (a3f64)(t + 1 - softStart))
+				{
+					cluster[j].start = softStart;
+					cluster[j].count = t + 1 - softStart;
+					++j;
+					softStart = t + 1;
+					memset(stamp, 0, geom->numVertices * sizeof(a3ui32));
+					time = cacheSize + 1;
+					misses = 0;
+				}
+			}
+		}
+		clusterCount = j;
+
+		// area-weighted center of whole mesh
+		positions = (a3f32 const*)geom->attribData[a3attrib_geomPosition];
+		stride = geom->vertexFormat->attribElements[a3attrib_position];
+		for (t = 0; t < triangleCount; ++t)
+		{
+			p0 = positions + indices[t * 3 + 0] * stride;
+			p1 = positions + indices[t * 3 + 1] * stride;
+			p2 = positions + indices[t * 3 + 2] * stride;
+			for (i = 0; i < 3; ++i)
+			{
+				e1[i] = p1[i] - p0[i];
+				e2[i] = p2[i] - p0[i];
+			}
+			n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+			n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+			n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+			area = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+			for (i = 0; i < 3; ++i)
+				meshCenter[i] += (p0[i] + p1[i] + p2[i]) * area;
+			meshArea += area;
+		}
+		if (meshArea > 0.0f)
+			for (i = 0; i < 3; ++i)
+				meshCenter[i] /= meshArea * 3.0f;
+
+		// cluster key: how far cluster faces away from the center; clusters
+		//	on the outside facing out are most likely to occlude others
+		for (j = 0; j < clusterCount; ++j)
+		{
+			memset(clusterNormal, 0, sizeof(clusterNormal));
+			memset(clusterCenter, 0, sizeof(clusterCenter));
+			area = 0.0f;
+			for (t = cluster[j].start; t < cluster[j].start + cluster[j].count; ++t)
+			{
+				p0 = positions + indices[t * 3 + 0] * stride;
+				p1 = positions + indices[t * 3 + 1] * stride;
+				p2 = positions + indices[t * 3 + 2] * stride;
+				for (i = 0; i < 3; ++i)
+				{
+					e1[i] = p1[i] - p0[i];
+					e2[i] = p2[i] - p0[i];
+				}
+				n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+				n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+				n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+				length = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+				for (i = 0; i < 3; ++i)
+				{
+					clusterNormal[i] += n[i];
+					clusterCenter[i] += (p0[i] + p1[i] + p2[i]) * length;
+				}
+				area += length;
+			}
+			length = sqrtf(clusterNormal[0] * clusterNormal[0] + clusterNormal[1] * clusterNormal[1] + clusterNormal[2] * clusterNormal[2]);
+			cluster[j].key = 0.0f;
+			if (length > 0.0f && area > 0.0f)
+			{
+				for (i = 0; i < 3; ++i)
+					c[i] = clusterCenter[i] / (area * 3.0f) - meshCenter[i];
+				cluster[j].key = (c[0] * clusterNormal[0] + c[1] * clusterNormal[1] + c[2] * clusterNormal[2]) / length;
+			}
+		}
+
+		// draw clusters in order of key
+		qsort(cluster, clusterCount, sizeof(*cluster), a3demo_geometryInternalCompareCluster);
+		for (j = 0, i = 0; j < clusterCount; ++j)
+		{
+			memcpy(output + i, indices + cluster[j].start * 3, cluster[j].count * 3 * sizeof(a3ui32));
+			i += cluster[j].count * 3;
+		}
+
+		a3demo_geometryInternalWriteIndices(geom, output);
+		free(cluster);
+		free(block);
+		return clusterCount;
+	}
+	return -1;
+}
+
+a3ret a3demo_geometryOptimizeVertexFetch(a3_GeometryData* geom)
+{
+	a3ui32* block, * indices, * remap;
+	a3ubyte* attrib, * reordered;
+	void const* attribData[a3attrib_geomNameMax + 2];
+	a3ui32 i, v, size, next, largest = 0;
+
+	if (geom && geom->data)
+	{
+		if (!geom->indexData || !geom->numIndices)
+			return 0;
+
+		// attribute arrays, including implicit ones, and largest element
+		memcpy(attribData, geom->attribData, sizeof(geom->attribData));
+		a3geometryGetAddressBitangent(attribData + a3attrib_geomNameMax + 0, geom);
+		a3geometryGetAddressBlendingInd(attribData + a3attrib_geomNameMax + 1, geom);
+		for (i = 0; i < a3attrib_geomNameMax + 2; ++i)
+			if (attribData[i] && largest < geom->vertexFormat->attribSize[a3geometryGetVertexAttribName(i)])
+				largest = geom->vertexFormat->attribSize[a3geometryGetVertexAttribName(i)];
+
+		block = (a3ui32*)malloc((geom->numIndices + geom->numVertices) * sizeof(a3ui32));
+		reordered = (a3ubyte*)malloc(geom->numVertices * largest);
+		if (!block || !reordered)
+		{
+			free(reordered);
+			free(block);
+			return 0;
+		}
+		indices = block;
+		remap = indices + geom->numIndices;
+		a3geometryGetIndices(indices, geom);
+
+		// new position of each vertex: order of first use, unused last
+		memset(remap, 0xff, geom->numVertices * sizeof(a3ui32));
+		for (i = 0, next = 0; i < geom->numIndices; ++i)
+			if (remap[indices[i]] == (a3ui32)-1)
+				remap[indices[i]] = next++;
+		for (v = 0; v < geom->numVertices; ++v)
+			if (remap[v] == (a3ui32)-1)
+				remap[v] = next++;
+
+		// move each attribute's elements (data belongs to geometry)
+		for (i = 0; i < a3attrib_geomNameMax + 2; ++i)
+			if (attribData[i])
+			{
+				attrib = (a3ubyte*)attribData[i];
+				size = geom->vertexFormat->attribSize[a3geometryGetVertexAttribName(i)];
+				for (v = 0; v < geom->numVertices; ++v)
+					memcpy(reordered + remap[v] * size, attrib + v * size, size);
+				memcpy(attrib, reordered, geom->numVertices * size);
+			}
+
+		for (i = 0; i < geom->numIndices; ++i)
+			indices[i] = remap[indices[i]];
+		a3demo_geometryInternalWriteIndices(geom, indices);
+
+		free(reordered);
+		free(block);
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3demo_geometryOptimize(a3_GeometryData* geom, a3ui32 const cacheSize, a3f64 const threshold)
+{
+	a3ret result = a3demo_geometryOptimizeVertexCache(geom, cacheSize);
+	if (result > 0)
+	{
+		a3demo_geometryOptimizeOverdraw(geom, cacheSize, threshold);
+		a3demo_geometryOptimizeVertexFetch(geom);
+	}
+	return result;
+}
+
+a3ret a3demo_geometryOptimizeReport(a3_GeometryData const* geom, a3byte const* name, a3ui32 const cacheSize)
+{
+	a3_DemoGeometryCacheStats before[1], afterCache[1], after[1];
+	a3_GeometryData copy[1] = { 0 };
+	a3_Timer timer[1] = { 0 };
+	a3byte* str;
+	a3f64 cacheTime, overdrawTime, fetchTime;
+	a3i32 clusterCount;
+
+	if (geom && geom->data)
+	{
+		if (!a3demo_geometryInternalIndexedTriangles(geom))
+			return 0;
+
+		// work on a copy so the original is untouched
+		str = (a3byte*)malloc(a3geometryGetStringSize(geom));
+		if (!str)
+			return 0;
+		a3geometryCopyDataToString(geom, str);
+		a3geometryCopyStringToData(copy, str);
+		free(str);
+
+		a3demo_geometryAnalyzeVertexCache(before, copy, cacheSize);
+		a3timerStart(timer);
+		a3demo_geometryOptimizeVertexCache(copy, cacheSize);
+		a3timerStop(timer);
+		cacheTime = timer->currentTick;
+		a3demo_geometryAnalyzeVertexCache(afterCache, copy, cacheSize);
+		a3timerStart(timer);
+		clusterCount = a3demo_geometryOptimizeOverdraw(copy, cacheSize, a3demo_geometryOptimizeOverdrawThreshold);
+		a3timerStop(timer);
+		overdrawTime = timer->currentTick;
+		a3timerStart(timer);
+		a3demo_geometryOptimizeVertexFetch(copy);
+		a3timerStop(timer);
+		fetchTime = timer->currentTick;
+		a3demo_geometryAnalyzeVertexCache(after, copy, cacheSize);
+
+		printf("\n\n  geometry optimization: \'%s\' (%u vertices, %u triangles, cache size %u)", name ? name : "",
+			copy->numVertices, before->triangleCount, cacheSize ? cacheSize : demoGeometryOptimizeDefault_cacheSize);
+		printf("\n  original:      ACMR %6.3lf, ATVR %6.3lf, %8u VS invocations",
+			before->acmr, before->atvr, before->invocations);
+		printf("\n  vertex cache:  ACMR %6.3lf, ATVR %6.3lf, %8u VS invocations (%8.3lf ms)",
+			afterCache->acmr, afterCache->atvr, afterCache->invocations, cacheTime * 1000.0);
+		printf("\n  + overdraw:    ACMR %6.3lf, ATVR %6.3lf, %8u VS invocations (%8.3lf ms, %d clusters)",
+			after->acmr, after->atvr, after->invocations, overdrawTime * 1000.0, clusterCount);
+		printf("\n  + fetch order: %8.3lf ms\n", fetchTime * 1000.0);
+
+		a3geometryReleaseData(copy);
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
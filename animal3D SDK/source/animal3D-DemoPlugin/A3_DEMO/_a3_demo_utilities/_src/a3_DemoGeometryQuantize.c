@@ -0,0 +1,424 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoGeometryQuantize.c
+	Vertex attribute quantization implementation.
+*/
+
+#include "../a3_DemoGeometryQuantize.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// 16-bit unsigned normalized value, as read by shader
+inline a3ui16 a3demo_geometryQuantizeInternalUnorm(a3f32 const u)
+{
+	return (a3ui16)(u > 0.0f ? u < 1.0f ? u * 65535.0f + 0.5f : 65535.0f : 0.0f);
+}
+
+inline a3f32 a3demo_geometryQuantizeInternalUnormDecode(a3ui16 const q)
+{
+	return ((a3f32)q / 65535.0f);
+}
+
+// half-float with round to nearest even; subnormals kept
+inline a3ui16 a3demo_geometryQuantizeInternalHalf(a3f32 const f)
+{
+	union { a3f32 f; a3ui32 u; } v;
+	a3ui32 sign, exponent, mantissa, shift, rem, mid, h;
+	v.f = f;
+	sign = (v.u >> 16) & 0x8000;
+	exponent = (v.u >> 23) & 0xff;
+	mantissa = v.u & 0x7fffff;
+
+	// infinity and not-a-number
+	if (exponent == 0xff)
+		return (a3ui16)(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+
+	// too large: infinity
+	if (exponent > 142)
+		return (a3ui16)(sign | 0x7c00);
+
+	// normal: rebias exponent, rounding may carry into it (up to infinity)
+	if (exponent >= 113)
+	{
+		h = ((exponent - 112) << 10) | (mantissa >> 13);
+		rem = mantissa & 0x1fff;
+		if (rem > 0x1000 || (rem == 0x1000 && (h & 1)))
+			++h;
+		return (a3ui16)(sign | h);
+	}
+
+	// subnormal or zero
+	shift = 126 - exponent;
+	if (shift > 24)
+		return (a3ui16)sign;
+	mantissa |= 0x800000;
+	h = mantissa >> shift;
+	rem = mantissa & ((1u << shift) - 1);
+	mid = 1u << (shift - 1);
+	if (rem > mid || (rem == mid && (h & 1)))
+		++h;
+	return (a3ui16)(sign | h);
+}
+
+inline a3f32 a3demo_geometryQuantizeInternalHalfDecode(a3ui16 const h)
+{
+	a3ui32 const exponent = (h >> 10) & 0x1f, mantissa = h & 0x3ff;
+	a3f32 const value = exponent == 0 ? ldexpf((a3f32)mantissa, -24)
+		: exponent == 0x1f ? (mantissa ? NAN : INFINITY)
+		: ldexpf((a3f32)(mantissa | 0x400), (a3i32)exponent - 25);
+	return ((h & 0x8000) ? -value : value);
+}
+
+// unit vector from octahedral projection, decoded as in shader
+inline void a3demo_geometryQuantizeInternalOctDecode(a3f32* n_out, a3i16 const* q)
+{
+	a3f32 x = (a3f32)q[0] / 32767.0f, y = (a3f32)q[1] / 32767.0f, z, t, len;
+	z = 1.0f - fabsf(x) - fabsf(y);
+	if (z < 0.0f)
+	{
+		t = x;
+		x = (1.0f - fabsf(y)) * (t >= 0.0f ? 1.0f : -1.0f);
+		y = (1.0f - fabsf(t)) * (y >= 0.0f ? 1.0f : -1.0f);
+	}
+	len = sqrtf(x * x + y * y + z * z);
+	n_out[0] = x / len;
+	n_out[1] = y / len;
+	n_out[2] = z / len;
+}
+
+// angle in degrees between vectors
+inline a3f64 a3demo_geometryQuantizeInternalAngle(a3f32 const* a, a3f32 const* b)
+{
+	a3f64 const lenSq = ((a3f64)a[0] * a[0] + (a3f64)a[1] * a[1] + (a3f64)a[2] * a[2])
+		* ((a3f64)b[0] * b[0] + (a3f64)b[1] * b[1] + (a3f64)b[2] * b[2]);
+	a3f64 d;
+	if (lenSq <= 0.0)
+		return 0.0;
+	d = ((a3f64)a[0] * b[0] + (a3f64)a[1] * b[1] + (a3f64)a[2] * b[2]) / sqrt(lenSq);
+	return (acos(d < 1.0 ? d > -1.0 ? d : -1.0 : 1.0) * 57.295779513082321);
+}
+
+// octahedral projection of direction into 16-bit signed normalized pair;
+//	of the four nearest codes, keeps the one that decodes closest
+//	return: angle error in degrees
+inline a3f64 a3demo_geometryQuantizeInternalOctEncode(a3i16* q_out, a3f32 const* n)
+{
+	a3f32 const l1 = fabsf(n[0]) + fabsf(n[1]) + fabsf(n[2]);
+	a3f32 u, v, t, d[3];
+	a3f64 angle, best = 360.0;
+	a3i32 i, j, qu, qv;
+	a3i16 q[2];
+
+	q_out[0] = q_out[1] = 0;
+	if (l1 <= 0.0f)
+		return 0.0;
+	u = n[0] / l1;
+	v = n[1] / l1;
+	if (n[2] < 0.0f)
+	{
+		t = u;
+		u = (1.0f - fabsf(v)) * (t >= 0.0f ? 1.0f : -1.0f);
+		v = (1.0f - fabsf(t)) * (v >= 0.0f ? 1.0f : -1.0f);
+	}
+	qu = (a3i32)floorf(u * 32767.0f);
+	qv = (a3i32)floorf(v * 32767.0f);
+	for (j = 0; j <= 1; ++j)
+		for (i = 0; i <= 1; ++i)
+		{
+			q[0] = (a3i16)(qu + i < -32767 ? -32767 : qu + i > 32767 ? 32767 : qu + i);
+			q[1] = (a3i16)(qv + j < -32767 ? -32767 : qv + j > 32767 ? 32767 : qv + j);
+			a3demo_geometryQuantizeInternalOctDecode(d, q);
+			angle = a3demo_geometryQuantizeInternalAngle(d, n);
+			if (angle < best)
+			{
+				best = angle;
+				q_out[0] = q[0];
+				q_out[1] = q[1];
+			}
+		}
+	return best;
+}
+
+// transform mapping values within bounds to [0, 1]; flat axes map to zero
+inline void a3demo_geometryQuantizeInternalBounds(a3f32* scale_out, a3f32* bias_out,
+	a3f32 const* data, a3ui32 const count, a3ui32 const elements)
+{
+	a3f32 lo, hi;
+	a3ui32 i, v;
+	for (i = 0; i < elements; ++i)
+	{
+		lo = hi = count ? data[i] : 0.0f;
+		for (v = 1; v < count; ++v)
+		{
+			if (data[v * elements + i] < lo)
+				lo = data[v * elements + i];
+			if (data[v * elements + i] > hi)
+				hi = data[v * elements + i];
+		}
+		scale_out[i] = hi - lo;
+		bias_out[i] = lo;
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_geometryQuantize(a3_GeometryData* geom_out, a3_DemoGeometryDequantize* dequantize_out, a3_GeometryData const* geom,
+	a3_DemoGeometryDequantize const* bounds_opt, a3_DemoGeometryQuantizeError* error_out_opt)
+{
+	a3_GeometryVertexAttributeName names[a3attrib_geomNameMax];
+	a3_VertexFormatDescriptor floatFormat[1];
+	a3_DemoGeometryDequantize dequantize[1];
+	a3_DemoGeometryQuantizeError error[1] = { 0 };
+	void const* attribSrc[a3attrib_geomNameMax + 2];
+	a3ui32 order[a3attrib_geomNameMax + 2];
+	a3f32 const* src;
+	a3ubyte* dst;
+	a3ui16* qu;
+	a3i16* qs;
+	a3f32 diff, len;
+	a3f64 angle;
+	a3ui32 i, j, k, v, count, offset, vertexBytes, indexBytes, sum, largest;
+	a3_VertexAttributeName name;
+
+	if (geom_out && dequantize_out && geom && geom->data)
+	{
+		// source must be in the float format of its attributes
+		for (i = count = 0; i < a3attrib_geomNameMax; ++i)
+			if (geom->attribData[i] && i != a3attrib_geomPosition)
+				names[count++] = (a3_GeometryVertexAttributeName)i;
+		a3geometryCreateVertexFormat(floatFormat, names, count);
+		if (memcmp(floatFormat, geom->vertexFormat, sizeof(floatFormat)))
+			return 0;
+
+		memset(geom_out, 0, sizeof(*geom_out));
+		a3geometryCreateVertexFormatQuantized(geom_out->vertexFormat, names, count);
+		*geom_out->indexFormat = *geom->indexFormat;
+		geom_out->primType = geom->primType;
+		geom_out->numVertices = geom->numVertices;
+		geom_out->numIndices = geom->numIndices;
+		*geom_out->bounds = *geom->bounds;
+		vertexBytes = a3vertexFormatGetStorageSpaceRequired(geom_out->vertexFormat, geom->numVertices);
+		indexBytes = a3indexFormatGetStorageSpaceRequired(geom->indexFormat, geom->numIndices);
+		geom_out->data = malloc(vertexBytes + indexBytes);
+		if (!geom_out->data)
+			return 0;
+
+		// dequantization transform: from bounds or as given; w decodes to 1
+		if (bounds_opt)
+			*dequantize = *bounds_opt;
+		else
+		{
+			memset(dequantize, 0, sizeof(dequantize));
+			a3demo_geometryQuantizeInternalBounds(dequantize->positionScale, dequantize->positionBias,
+				(a3f32 const*)geom->attribData[a3attrib_geomPosition], geom->numVertices, 3);
+			if (geom->attribData[a3attrib_geomTexcoord])
+				a3demo_geometryQuantizeInternalBounds(dequantize->texcoordTransform, dequantize->texcoordTransform + 2,
+					(a3f32 const*)geom->attribData[a3attrib_geomTexcoord], geom->numVertices, 2);
+		}
+		dequantize->positionScale[3] = 0.0f;
+		dequantize->positionBias[3] = 1.0f;
+
+		// keep source layout: arrays in the same order, each one smaller
+		memcpy(attribSrc, geom->attribData, sizeof(geom->attribData));
+		attribSrc[a3attrib_geomNameMax + 0] = attribSrc[a3attrib_geomNameMax + 1] = 0;
+		a3geometryGetAddressBitangent(attribSrc + a3attrib_geomNameMax + 0, geom);
+		a3geometryGetAddressBlendingInd(attribSrc + a3attrib_geomNameMax + 1, geom);
+		for (i = count = 0; i < a3attrib_geomNameMax + 2; ++i)
+			if (attribSrc[i])
+			{
+				for (j = count++; j > 0 && (a3ubyte const*)attribSrc[order[j - 1]] > (a3ubyte const*)attribSrc[i]; --j)
+					order[j] = order[j - 1];
+				order[j] = i;
+			}
+
+		for (i = 0, offset = 0; i < count; ++i)
+		{
+			k = order[i];
+			name = (a3_VertexAttributeName)a3geometryGetVertexAttribName(k);
+			src = (a3f32 const*)attribSrc[k];
+			dst = (a3ubyte*)geom_out->data + offset;
+			qu = (a3ui16*)dst;
+			qs = (a3i16*)dst;
+			switch (k)
+			{
+			case a3attrib_geomPosition:
+				for (v = 0; v < geom->numVertices; ++v, src += 3, qu += 4)
+				{
+					for (j = 0, len = 0.0f; j < 3; ++j)
+					{
+						qu[j] = a3demo_geometryQuantizeInternalUnorm(dequantize->positionScale[j] > 0.0f
+							? (src[j] - dequantize->positionBias[j]) / dequantize->positionScale[j] : 0.0f);
+						diff = a3demo_geometryQuantizeInternalUnormDecode(qu[j]) * dequantize->positionScale[j]
+							+ dequantize->positionBias[j] - src[j];
+						len += diff * diff;
+					}
+					qu[3] = 65535;
+					len = sqrtf(len);
+					if (len > error->position)
+						error->position = len;
+				}
+				break;
+			case a3attrib_geomTexcoord:
+				for (v = 0; v < geom->numVertices; ++v, src += 2, qu += 2)
+				{
+					for (j = 0, len = 0.0f; j < 2; ++j)
+					{
+						qu[j] = a3demo_geometryQuantizeInternalUnorm(dequantize->texcoordTransform[j] > 0.0f
+							? (src[j] - dequantize->texcoordTransform[j + 2]) / dequantize->texcoordTransform[j] : 0.0f);
+						diff = a3demo_geometryQuantizeInternalUnormDecode(qu[j]) * dequantize->texcoordTransform[j]
+							+ dequantize->texcoordTransform[j + 2] - src[j];
+						len += diff * diff;
+					}
+					len = sqrtf(len);
+					if (len > error->texcoord)
+						error->texcoord = len;
+				}
+				break;
+			case a3attrib_geomNormal:
+			case a3attrib_geomTangent:
+			case a3attrib_geomNameMax + 0:
+				for (v = 0; v < geom->numVertices; ++v, src += 3, qs += 2)
+				{
+					angle = a3demo_geometryQuantizeInternalOctEncode(qs, src);
+					if (k == a3attrib_geomNormal && angle > error->normal)
+						error->normal = (a3f32)angle;
+					else if (k != a3attrib_geomNormal && angle > error->tangent)
+						error->tangent = (a3f32)angle;
+				}
+				break;
+			case a3attrib_geomColor:
+				for (v = 0; v < geom->numVertices * 4; ++v)
+				{
+					qu[v] = a3demo_geometryQuantizeInternalHalf(src[v]);
+					diff = fabsf(a3demo_geometryQuantizeInternalHalfDecode(qu[v]) - src[v]);
+					if (diff > error->color)
+						error->color = diff;
+				}
+				break;
+			case a3attrib_geomBlending:
+				// keep normalized weights summing to one: remainder goes to
+				//	the largest
+				for (v = 0; v < geom->numVertices; ++v, src += 4, qu += 4)
+				{
+					for (j = sum = 0, len = 0.0f; j < 4; ++j)
+					{
+						qu[j] = a3demo_geometryQuantizeInternalUnorm(src[j]);
+						sum += qu[j];
+						len += src[j];
+					}
+					for (j = 1, largest = 0; j < 4; ++j)
+						if (qu[j] > qu[largest])
+							largest = j;
+					if (fabsf(len - 1.0f) < 0.001f && (a3ui32)qu[largest] + 65535 >= sum)
+						qu[largest] = (a3ui16)(qu[largest] + 65535 - sum);
+					for (j = 0; j < 4; ++j)
+					{
+						diff = fabsf(a3demo_geometryQuantizeInternalUnormDecode(qu[j]) - src[j]);
+						if (diff > error->blendWeight)
+							error->blendWeight = diff;
+					}
+				}
+				break;
+			default:
+				memcpy(dst, src, geom->vertexFormat->attribSize[name] * geom->numVertices);
+				break;
+			}
+			if (k < a3attrib_geomNameMax)
+				geom_out->attribData[k] = dst;
+			offset += geom_out->vertexFormat->attribSize[name] * geom->numVertices;
+		}
+
+		// indices unchanged, after vertices
+		if (geom->indexData)
+		{
+			geom_out->indexData = (a3ubyte*)geom_out->data + vertexBytes;
+			memcpy((a3ubyte*)geom_out->data + vertexBytes, geom->indexData, indexBytes);
+		}
+
+		*dequantize_out = *dequantize;
+		if (error_out_opt)
+			*error_out_opt = *error;
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3demo_geometryQuantizeReport(a3_GeometryData const* geom, a3byte const* name)
+{
+	a3_GeometryData quantized[1];
+	a3_DemoGeometryDequantize dequantize[1];
+	a3_DemoGeometryQuantizeError error[1];
+	a3_Timer timer[1] = { 0 };
+	a3f32 extent;
+	a3ui32 sizeBefore, sizeAfter;
+	a3ret status;
+
+	if (geom && geom->data)
+	{
+		a3timerStart(timer);
+		status = a3demo_geometryQuantize(quantized, dequantize, geom, 0, error);
+		a3timerStop(timer);
+		if (status <= 0)
+			return status;
+
+		extent = dequantize->positionScale[0];
+		if (dequantize->positionScale[1] > extent)
+			extent = dequantize->positionScale[1];
+		if (dequantize->positionScale[2] > extent)
+			extent = dequantize->positionScale[2];
+		sizeBefore = a3vertexFormatGetStorageSpaceRequired(geom->vertexFormat, geom->numVertices);
+		sizeAfter = a3vertexFormatGetStorageSpaceRequired(quantized->vertexFormat, quantized->numVertices);
+
+		printf("\n\n  geometry quantization: \'%s\' (%u vertices, %8.3lf ms)", name ? name : "",
+			geom->numVertices, timer->currentTick * 1000.0);
+		printf("\n  vertex size:   %3u -> %3u bytes; vertex buffer %8.1lf -> %8.1lf KiB (%.2lfx smaller)",
+			(a3ui32)geom->vertexFormat->vertexSize, (a3ui32)quantized->vertexFormat->vertexSize,
+			(a3f64)sizeBefore / 1024.0, (a3f64)sizeAfter / 1024.0, (a3f64)sizeBefore / (a3f64)sizeAfter);
+		printf("\n  max position error:      %.3e (%.5lf%% of extent)",
+			error->position, extent > 0.0f ? (a3f64)(error->position / extent) * 100.0 : 0.0);
+		if (geom->attribData[a3attrib_geomNormal])
+			printf("\n  max normal error:        %.5lf degrees", error->normal);
+		if (geom->attribData[a3attrib_geomTangent])
+			printf("\n  max tangent basis error: %.5lf degrees", error->tangent);
+		if (geom->attribData[a3attrib_geomTexcoord])
+			printf("\n  max texcoord error:      %.3e", error->texcoord);
+		if (geom->attribData[a3attrib_geomColor])
+			printf("\n  max color error:         %.3e", error->color);
+		if (geom->attribData[a3attrib_geomBlending])
+			printf("\n  max blend weight error:  %.3e", error->blendWeight);
+		printf("\n");
+
+		a3geometryReleaseData(quantized);
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
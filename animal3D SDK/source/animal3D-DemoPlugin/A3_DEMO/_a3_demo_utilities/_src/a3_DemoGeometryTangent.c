@@ -0,0 +1,211 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoGeometryTangent.c
+	Tangent basis benchmark implementation.
+*/
+
+#include "../a3_DemoGeometryTangent.h"
+
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// duplicate geometry through its string form
+inline a3ret a3demo_geometryTangentInternalCopy(a3_GeometryData* geom_out, a3_GeometryData const* geom)
+{
+	a3ret const size = a3geometryGetStringSize(geom);
+	a3byte* const str = (a3byte*)malloc(size);
+	a3ret status = 0;
+	memset(geom_out, 0, sizeof(*geom_out));
+	if (str)
+	{
+		a3geometryCopyDataToString(geom, str);
+		status = a3geometryCopyStringToData(geom_out, str) > 0;
+		free(str);
+	}
+	return status;
+}
+
+// read triangle corner index
+inline a3ui32 a3demo_geometryTangentInternalIndex(a3_GeometryData const* geom, a3ui32 const i)
+{
+	if (!geom->indexData)
+		return i;
+	switch (geom->indexFormat->indexSize)
+	{
+	case 1:
+		return ((a3ubyte const*)geom->indexData)[i];
+	case 2:
+		return ((a3ui16 const*)geom->indexData)[i];
+	}
+	return ((a3ui32 const*)geom->indexData)[i];
+}
+
+// tangent basis the way the model loader has always accumulated it: 
+//	orthogonalized basis of each face added to its corners in turn, then 
+//	each vector normalized on its own
+inline void a3demo_geometryTangentInternalReference(a3_GeometryData* geom)
+{
+	a3f32 const* const position = (a3f32 const*)geom->attribData[a3attrib_geomPosition];
+	a3f32 const* const texcoord = (a3f32 const*)geom->attribData[a3attrib_geomTexcoord];
+	a3f32* const normal = (a3f32*)geom->attribData[a3attrib_geomNormal];
+	a3f32* const tangent = (a3f32*)geom->attribData[a3attrib_geomTangent];
+	a3f32* bitangent;
+	a3real3 dp1, dp2, t, b, n;
+	a3f32 const* p[3], * tc[3];
+	a3f32 dt1[2], dt2[2], detInv;
+	a3ui32 const count = geom->indexData ? geom->numIndices : geom->numVertices;
+	a3ui32 i, j, k;
+
+	a3geometryGetAddressBitangent((void const**)&bitangent, geom);
+	memset(normal, 0, geom->numVertices * sizeof(a3real3));
+	memset(tangent, 0, geom->numVertices * sizeof(a3real3));
+	memset(bitangent, 0, geom->numVertices * sizeof(a3real3));
+	for (i = 0; i + 2 < count; i += 3)
+	{
+		for (j = 0; j < 3; ++j)
+		{
+			k = a3demo_geometryTangentInternalIndex(geom, i + j);
+			p[j] = position + k * 3;
+			tc[j] = texcoord + k * 2;
+		}
+		a3real3Diff(dp1, p[1], p[0]);
+		a3real3Diff(dp2, p[2], p[0]);
+		dt1[0] = tc[1][0] - tc[0][0];
+		dt1[1] = tc[1][1] - tc[0][1];
+		dt2[0] = tc[2][0] - tc[0][0];
+		dt2[1] = tc[2][1] - tc[0][1];
+		detInv = 1.0f / (dt1[0] * dt2[1] - dt1[1] * dt2[0]);
+		for (j = 0; j < 3; ++j)
+		{
+			t[j] = (dp1[j] * dt2[1] - dp2[j] * dt1[1]) * detInv;
+			b[j] = (dp2[j] * dt1[0] - dp1[j] * dt2[0]) * detInv;
+		}
+		a3real3Cross(n, dp1, dp2);
+		a3real3GramSchmidt2(t, b, n);
+		for (j = 0; j < 3; ++j)
+		{
+			k = a3demo_geometryTangentInternalIndex(geom, i + j) * 3;
+			a3real3Add(tangent + k, t);
+			a3real3Add(bitangent + k, b);
+			a3real3Add(normal + k, n);
+		}
+	}
+	for (i = 0; i < geom->numVertices * 3; i += 3)
+	{
+		a3real3Normalize(tangent + i);
+		a3real3Normalize(bitangent + i);
+		a3real3Normalize(normal + i);
+	}
+}
+
+// largest angle in degrees between matching unit vectors
+inline a3f64 a3demo_geometryTangentInternalAngle(a3f32 const* v0, a3f32 const* v1, a3ui32 const count)
+{
+	a3f64 angle = 0.0, c[3], s, d;
+	a3ui32 i;
+	for (i = 0; i < count * 3; i += 3)
+	{
+		// angle from both sine and cosine stays precise near zero
+		c[0] = (a3f64)v0[i + 1] * v1[i + 2] - (a3f64)v0[i + 2] * v1[i + 1];
+		c[1] = (a3f64)v0[i + 2] * v1[i + 0] - (a3f64)v0[i + 0] * v1[i + 2];
+		c[2] = (a3f64)v0[i + 0] * v1[i + 1] - (a3f64)v0[i + 1] * v1[i + 0];
+		s = sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]);
+		d = (a3f64)v0[i + 0] * v1[i + 0] + (a3f64)v0[i + 1] * v1[i + 1] + (a3f64)v0[i + 2] * v1[i + 2];
+		d = atan2(s, d) * 57.295779513082321;
+		if (d > angle)
+			angle = d;
+	}
+	return angle;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_geometryTangentReport(a3_GeometryData const* geom, a3byte const* name, a3ui32 taskCountMax, a3_DemoWorkerPool* pool)
+{
+	a3_GeometryData reference[1], batched[1];
+	a3_GeometryDispatcher dispatcher[1] = { { a3demo_workerPoolDispatch, pool, 1 } };
+	a3_Timer timer[1] = { 0 };
+	a3f64 referenceTime;
+	a3f32 const* bitangent[2];
+	a3ret status;
+
+	if (geom && geom->data)
+	{
+		if (a3demo_geometryTangentInternalCopy(reference, geom) <= 0)
+			return 0;
+		if (a3demo_geometryTangentInternalCopy(batched, geom) <= 0)
+		{
+			a3geometryReleaseData(reference);
+			return 0;
+		}
+
+		// batched first, which also checks the format
+		status = a3geometryCalculateTangentBasis(batched, 0);
+		if (status > 0)
+		{
+			a3timerStart(timer);
+			a3demo_geometryTangentInternalReference(reference);
+			a3timerStop(timer);
+			referenceTime = timer->currentTick;
+
+			printf("\n\n  tangent basis: \'%s\' (%u vertices, %u triangles)", name ? name : "",
+				geom->numVertices, (geom->indexData ? geom->numIndices : geom->numVertices) / 3);
+			printf("\n  face at a time:     %8.3lf ms", referenceTime * 1000.0);
+			for (dispatcher->taskCount = 1; dispatcher->taskCount <= taskCountMax; dispatcher->taskCount <<= 1)
+			{
+				a3timerStart(timer);
+				a3geometryCalculateTangentBasis(batched, dispatcher);
+				a3timerStop(timer);
+				printf("\n  batched, %u task%s:   %8.3lf ms (%.2lfx)", dispatcher->taskCount, dispatcher->taskCount > 1 ? "s" : " ",
+					timer->currentTick * 1000.0, timer->currentTick > 0.0 ? referenceTime / timer->currentTick : 0.0);
+			}
+
+			// tangent and bitangent differ where the accumulated basis was 
+			//	not orthogonal; normals should agree to rounding
+			a3geometryGetAddressBitangent((void const**)(bitangent + 0), reference);
+			a3geometryGetAddressBitangent((void const**)(bitangent + 1), batched);
+			printf("\n  max normal difference:    %.5lf degrees", a3demo_geometryTangentInternalAngle(
+				(a3f32 const*)reference->attribData[a3attrib_geomNormal], (a3f32 const*)batched->attribData[a3attrib_geomNormal], geom->numVertices));
+			printf("\n  max tangent difference:   %.5lf degrees", a3demo_geometryTangentInternalAngle(
+				(a3f32 const*)reference->attribData[a3attrib_geomTangent], (a3f32 const*)batched->attribData[a3attrib_geomTangent], geom->numVertices));
+			printf("\n  max bitangent difference: %.5lf degrees", a3demo_geometryTangentInternalAngle(
+				bitangent[0], bitangent[1], geom->numVertices));
+			printf("\n");
+		}
+
+		a3geometryReleaseData(reference);
+		a3geometryReleaseData(batched);
+		return (status > 0);
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,252 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMathBatch.c
+	Batch dispatch and benchmark implementation.
+*/
+
+#include "../a3_DemoMathBatch.h"
+
+#include "../a3_DemoMathReport.h"
+#include "animal3D-A3DM/a3math/a3batch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// one thread's range of a dispatched batch
+typedef struct a3_DemoMathWork					a3_DemoMathWork;
+struct a3_DemoMathWork
+{
+	a3_DemoMathBatchFunc func;
+	void const* args;
+	a3ui32 first, count;
+};
+
+// pool task: run one range
+void a3demo_mathInternalBatchWork(void* args, a3ui32 index)
+{
+	a3_DemoMathWork const* const work = (a3_DemoMathWork*)args + index;
+	work->func(work->args, work->first, work->count);
+}
+
+
+// arrays for batch report; each kernel uses some of them
+typedef struct a3_DemoMathBatch					a3_DemoMathBatch;
+struct a3_DemoMathBatch
+{
+	a3mat4 const* mL, * mR;
+	a3mat4* m_out;
+	a3vec3 const* p;
+	a3vec3* p_out;
+	a3mat4 const* shared;
+};
+
+void a3demo_mathInternalBatchProduct(a3_DemoMathBatch const* batch, a3ui32 first, a3ui32 count)
+{
+	a3real4x4ProductBatch(batch->m_out + first, batch->mL + first, batch->mR + first, count);
+}
+
+void a3demo_mathInternalBatchProductSharedL(a3_DemoMathBatch const* batch, a3ui32 first, a3ui32 count)
+{
+	a3real4x4ProductBatchSharedL(batch->m_out + first, batch->shared->m, batch->mR + first, count);
+}
+
+void a3demo_mathInternalBatchTransformInverse(a3_DemoMathBatch const* batch, a3ui32 first, a3ui32 count)
+{
+	a3real4x4TransformInverseBatch(batch->m_out + first, batch->mL + first, count);
+}
+
+void a3demo_mathInternalBatchTransformPoint(a3_DemoMathBatch const* batch, a3ui32 first, a3ui32 count)
+{
+	a3real3Real4x4TransformPointBatch(batch->p_out + first, batch->shared->m, batch->p + first, count);
+}
+
+void a3demo_mathInternalBatchUnit(a3_DemoMathBatch const* batch, a3ui32 first, a3ui32 count)
+{
+	a3real3GetUnitBatch(batch->p_out + first, batch->p + first, count);
+}
+
+// time one batch kernel on each thread count and print throughput
+inline void a3demo_mathInternalBatchTime(a3byte const* name, a3_DemoMathBatchFunc func, a3_DemoMathBatch const* batch, a3_DemoWorkerPool* pool,
+	a3ui32 const count, a3ui32 const passCount, a3f64 const itemTime, a3f32 const* itemResult, a3f32 const* result, a3ui32 const size)
+{
+	a3_Timer timer[1] = { 0 };
+	a3ui32 threadCount, pass;
+	a3f64 const items = (a3f64)count * (a3f64)passCount * 1.0e-6;
+	printf("\n  %-16s per item %8.2lf M/s", name, itemTime > 0.0 ? items / itemTime : 0.0);
+	for (threadCount = 1; threadCount <= demoMathSize_thread; threadCount *= 2)
+	{
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			a3demo_mathBatchDispatch(func, batch, count, pool, threadCount);
+		a3timerStop(timer);
+		printf(" | x%u %8.2lf M/s", threadCount, timer->currentTick > 0.0 ? items / timer->currentTick : 0.0);
+	}
+	printf(" | max diff %.3e", a3demo_mathDiff(itemResult, result, size));
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_mathBatchDispatch(a3_DemoMathBatchFunc func, void const* args, a3ui32 count, a3_DemoWorkerPool* pool, a3ui32 threadCount)
+{
+	a3_DemoMathWork work[demoMathSize_thread];
+	a3ui32 i, first, range;
+
+	if (func && count)
+	{
+		// ranges rounded up to whole groups; fewer threads if items run out
+		threadCount = threadCount ? threadCount : 1;
+		threadCount = threadCount < demoMathSize_thread ? threadCount : demoMathSize_thread;
+		range = (count + threadCount - 1) / threadCount;
+		range = (range + demoMathSize_group - 1) / demoMathSize_group * demoMathSize_group;
+		for (i = 0, first = 0; first < count; ++i, first += range)
+		{
+			work[i].func = func;
+			work[i].args = args;
+			work[i].first = first;
+			work[i].count = count - first < range ? count - first : range;
+		}
+		threadCount = i;
+		a3demo_workerPoolRun(pool, a3demo_mathInternalBatchWork, work, threadCount);
+		return threadCount;
+	}
+	return -1;
+}
+
+
+a3ret a3demo_mathBatchReport(a3ui32 count, a3ui32 passCount, a3_DemoWorkerPool* pool)
+{
+	a3_Timer timer[1] = { 0 };
+	a3_DemoMathBatch batch[1];
+	a3f64 itemTime;
+	a3byte* block;
+	a3size size;
+	a3mat4* mL, * mR, * itemResult, * result, shared[1];
+	a3vec3* p, * pItemResult, * pResult;
+	a3vec4 point, point_out;
+	a3ui32 i, pass;
+
+	if (count && passCount)
+	{
+		// cleared so no kernel pays for first touching its output
+		size = count * (sizeof(a3mat4) * 4 + sizeof(a3vec3) * 3) + 15;
+		block = (a3byte*)malloc(size);
+		if (!block)
+			return 0;
+		memset(block, 0, size);
+		mL = (a3mat4*)(((a3address)block + 15) & ~(a3address)15);
+		mR = mL + count;
+		itemResult = mR + count;
+		result = itemResult + count;
+		p = (a3vec3*)(result + count);
+		pItemResult = p + count;
+		pResult = pItemResult + count;
+
+		// left matrices have orthogonal axes of any length and translation, 
+		//	as in a scene
+		a3demo_mathRandomMatrix(shared->m);
+		for (i = 0; i < count; ++i)
+		{
+			a3demo_mathRandomMatrix(mL[i].m);
+			a3real3GramSchmidt2(mL[i].m[1], mL[i].m[2], mL[i].m[0]);
+			a3real4Set(mL[i].m[3], a3demo_mathRandom(), a3demo_mathRandom(), a3demo_mathRandom(), a3real_one);
+			mL[i].m[0][3] = mL[i].m[1][3] = mL[i].m[2][3] = a3real_zero;
+			a3demo_mathRandomMatrix(mR[i].m);
+			a3real3Set(p[i].v, a3demo_mathRandom(), a3demo_mathRandom(), a3demo_mathRandom());
+		}
+		batch->mL = mL;
+		batch->mR = mR;
+		batch->m_out = result;
+		batch->p = p;
+		batch->p_out = pResult;
+		batch->shared = shared;
+
+		printf("\n\n  batch kernels: %s (%u items, %u passes)", A3_SIMD_NAME, count, passCount);
+
+		// matrix product pairs
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3real4x4Product(itemResult[i].m, mL[i].m, mR[i].m);
+		a3timerStop(timer);
+		itemTime = timer->currentTick;
+		a3demo_mathInternalBatchTime("4x4 product:", (a3_DemoMathBatchFunc)a3demo_mathInternalBatchProduct, batch, pool,
+			count, passCount, itemTime, itemResult->mm, result->mm, count * 16);
+
+		// matrix product with shared left
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3real4x4Product(itemResult[i].m, shared->m, mR[i].m);
+		a3timerStop(timer);
+		itemTime = timer->currentTick;
+		a3demo_mathInternalBatchTime("4x4 shared L:", (a3_DemoMathBatchFunc)a3demo_mathInternalBatchProductSharedL, batch, pool,
+			count, passCount, itemTime, itemResult->mm, result->mm, count * 16);
+
+		// affine inverse
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3real4x4TransformInverse(itemResult[i].m, mL[i].m);
+		a3timerStop(timer);
+		itemTime = timer->currentTick;
+		a3demo_mathInternalBatchTime("affine inverse:", (a3_DemoMathBatchFunc)a3demo_mathInternalBatchTransformInverse, batch, pool,
+			count, passCount, itemTime, itemResult->mm, result->mm, count * 16);
+
+		// point transform, per item through a 4D vector
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+			{
+				a3real4SetReal3W(point.v, p[i].v, a3real_one);
+				a3real4Real4x4Product(point_out.v, shared->m, point.v);
+				a3real3SetReal4(pItemResult[i].v, point_out.v);
+			}
+		a3timerStop(timer);
+		itemTime = timer->currentTick;
+		a3demo_mathInternalBatchTime("point transform:", (a3_DemoMathBatchFunc)a3demo_mathInternalBatchTransformPoint, batch, pool,
+			count, passCount, itemTime, pItemResult->v, pResult->v, count * 3);
+
+		// normalize
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3real3GetUnit(pItemResult[i].v, p[i].v);
+		a3timerStop(timer);
+		itemTime = timer->currentTick;
+		a3demo_mathInternalBatchTime("3D normalize:", (a3_DemoMathBatchFunc)a3demo_mathInternalBatchUnit, batch, pool,
+			count, passCount, itemTime, pItemResult->v, pResult->v, count * 3);
+
+		printf("\n");
+		free(block);
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
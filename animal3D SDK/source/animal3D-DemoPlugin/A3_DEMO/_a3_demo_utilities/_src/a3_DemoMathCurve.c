@@ -0,0 +1,157 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMathCurve.c
+	Curve follower benchmark implementation.
+*/
+
+#include "../a3_DemoMathCurve.h"
+
+#include "../a3_DemoMathReport.h"
+#include "../a3_DemoMathBatch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// arrays for curve report: one rail segment, its arc length table resampled 
+//	to evenly spaced lengths, and each follower's distance along it
+typedef struct a3_DemoMathCurve					a3_DemoMathCurve;
+struct a3_DemoMathCurve
+{
+	a3real const* control;
+	a3real const* uniformTable;
+	a3real const* distance;
+	a3real* param;
+	a3real* position;
+};
+
+void a3demo_mathInternalCurveFollow(a3_DemoMathCurve const* curve, a3ui32 first, a3ui32 count)
+{
+	a3sampleTableLerpUniformBatch(curve->param + first, curve->uniformTable, demoMathSize_curveDivisions, a3real_zero, a3real_one, curve->distance + first, count);
+	a3real3CatmullRomBatch(curve->position + first * 3, curve->control + 0, curve->control + 3, curve->control + 6, curve->control + 9, curve->param + first, count);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_mathCurveReport(a3ui32 count, a3ui32 passCount, a3_DemoWorkerPool* pool)
+{
+	a3_Timer timer[1] = { 0 };
+	a3_DemoMathCurve curve[1];
+	a3randstream stream[1];
+	a3real control[12];
+	a3real sample[(demoMathSize_curveDivisions + 1) * 3];
+	a3real sampleParam[demoMathSize_curveDivisions + 1];
+	a3real arclen[demoMathSize_curveDivisions + 1];
+	a3real uniform[demoMathSize_curveDivisions + 1];
+	a3f64 items, diff;
+	a3real* distance, * param, * itemResult, * result, length, t;
+	a3ui32 i, j, pass, threadCount;
+
+	if (count && passCount)
+	{
+		distance = (a3real*)malloc(count * sizeof(a3real) * 8);
+		if (!distance)
+			return 0;
+		memset(distance, 0, count * sizeof(a3real) * 8);
+		param = distance + count;
+		itemResult = param + count;
+		result = itemResult + count * 3;
+		items = (a3f64)count * (a3f64)passCount * 1.0e-6;
+
+		// random rail segment and follower distances as fractions of its 
+		//	length
+		a3randomStreamInit(stream, 0x5eed, 2);
+		for (j = 0; j < 12; ++j)
+			control[j] = (a3real)20.0 * a3randomStreamNext(stream) - (a3real)10.0;
+		for (i = 0; i < count; ++i)
+			distance[i] = a3randomStreamNext(stream);
+
+		// tables: samples at evenly spaced params, normalized arc length at 
+		//	each, then params at evenly spaced arc lengths
+		for (j = 0; j <= demoMathSize_curveDivisions; ++j)
+			sampleParam[j] = (a3real)j / (a3real)demoMathSize_curveDivisions;
+		a3real3CatmullRomBatch(sample, control + 0, control + 3, control + 6, control + 9, sampleParam, demoMathSize_curveDivisions + 1);
+		length = a3calculateArcLengthSamples3(arclen, a3true, demoMathSize_curveDivisions, sample);
+		a3sampleTableResampleUniform(uniform, demoMathSize_curveDivisions, sampleParam, arclen, demoMathSize_curveDivisions + 1);
+		curve->control = control;
+		curve->uniformTable = uniform;
+		curve->distance = distance;
+		curve->param = param;
+		curve->position = result;
+
+		printf("\n\n  curve followers: %s (%u followers, %u passes, %u divisions, length %.3lf)", A3_SIMD_NAME, count, passCount, demoMathSize_curveDivisions, (a3f64)length);
+
+		// search arc length table from the start, one follower at a time; 
+		//	its results are the reference
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+			{
+				t = a3sampleTableLerpIncrement(sampleParam, arclen, distance[i], 0);
+				for (j = 0; j < 3; ++j)
+					itemResult[i * 3 + j] = a3CatmullRom(control[j], control[3 + j], control[6 + j], control[9 + j], t);
+			}
+		a3timerStop(timer);
+		a3demo_mathPrintRate("increment:", items, timer->currentTick);
+
+		// bisection, one follower at a time
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+			{
+				t = a3sampleTableLerpSearch(sampleParam, arclen, demoMathSize_curveDivisions + 1, distance[i]);
+				for (j = 0; j < 3; ++j)
+					result[i * 3 + j] = a3CatmullRom(control[j], control[3 + j], control[6 + j], control[9 + j], t);
+			}
+		a3timerStop(timer);
+		diff = a3demo_mathDiff(itemResult, result, count * 3);
+		a3demo_mathPrintRate("search:", items, timer->currentTick);
+		printf(" | max diff %.3e", diff);
+
+		// uniform table and batch curve split across threads; differences 
+		//	come from resampling the table
+		printf("\n  %-16s         ", "uniform batch:");
+		for (threadCount = 1; threadCount <= demoMathSize_thread; threadCount *= 2)
+		{
+			memset(result, 0, count * 3 * sizeof(a3real));
+			a3timerStart(timer);
+			for (pass = 0; pass < passCount; ++pass)
+				a3demo_mathBatchDispatch((a3_DemoMathBatchFunc)a3demo_mathInternalCurveFollow, curve, count, pool, threadCount);
+			a3timerStop(timer);
+			diff = a3demo_mathDiff(itemResult, result, count * 3);
+			printf(" | x%u %8.2lf M/s diff %.1e", threadCount, timer->currentTick > 0.0 ? items / timer->currentTick : 0.0, diff);
+		}
+
+		printf("\n");
+		free(distance);
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
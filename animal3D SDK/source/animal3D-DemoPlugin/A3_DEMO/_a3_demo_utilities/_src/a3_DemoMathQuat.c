@@ -0,0 +1,217 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMathQuat.c
+	Rotation benchmark implementation.
+*/
+
+#include "../a3_DemoMathQuat.h"
+
+#include "../a3_DemoMathReport.h"
+#include "../a3_DemoMathBatch.h"
+#include "animal3D-A3DM/a3math/a3batch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// arrays for quaternion report: rotation pairs, translations, scales and 
+//	interpolation parameters
+typedef struct a3_DemoMathQuat					a3_DemoMathQuat;
+struct a3_DemoMathQuat
+{
+	a3quat const* q0;
+	a3quat const* q1;
+	a3vec3 const* translate;
+	a3vec3 const* scale;
+	a3real const* param;
+	a3mat4* transform;
+	a3quat* q_out;
+};
+
+void a3demo_mathInternalQuatTRS(a3_DemoMathQuat const* quat, a3ui32 first, a3ui32 count)
+{
+	a3quatConvertToMat4TRSBatch(quat->transform + first, quat->q0 + first, quat->translate + first, quat->scale + first, count);
+}
+
+void a3demo_mathInternalQuatSlerp(a3_DemoMathQuat const* quat, a3ui32 first, a3ui32 count)
+{
+	a3quatSlerpBatch(quat->q_out + first, quat->q0 + first, quat->q1 + first, quat->param + first, count);
+}
+
+void a3demo_mathInternalQuatNlerp(a3_DemoMathQuat const* quat, a3ui32 first, a3ui32 count)
+{
+	a3quatNlerpBatch(quat->q_out + first, quat->q0 + first, quat->q1 + first, quat->param + first, count);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_mathQuatReport(a3ui32 count, a3ui32 passCount, a3_DemoWorkerPool* pool)
+{
+	a3_Timer timer[1] = { 0 };
+	a3_DemoMathQuat quat[1];
+	a3randstream stream[1];
+	a3f64 items, diff;
+	a3vec3* euler, * translate, * scale;
+	a3quat* q0, * q1, * itemQuat, * result;
+	a3mat4* itemTransform, * transform;
+	a3real* param;
+	a3ui32 i, j, pass, threadCount;
+	size_t const size = sizeof(a3vec3) * 3 + sizeof(a3quat) * 4 + sizeof(a3mat4) * 2 + sizeof(a3real);
+
+	if (count && passCount)
+	{
+		// matrices first so every array stays aligned
+		itemTransform = (a3mat4*)malloc(count * size);
+		if (!itemTransform)
+			return 0;
+		memset(itemTransform, 0, count * size);
+		transform = itemTransform + count;
+		q0 = (a3quat*)(transform + count);
+		q1 = q0 + count;
+		itemQuat = q1 + count;
+		result = itemQuat + count;
+		euler = (a3vec3*)(result + count);
+		translate = euler + count;
+		scale = translate + count;
+		param = (a3real*)(scale + count);
+		items = (a3f64)count * (a3f64)passCount * 1.0e-6;
+
+		// random Euler angles with matching quaternions, second rotations on 
+		//	the same hemisphere, translations, scales and parameters
+		a3randomStreamInit(stream, 0x5eed, 3);
+		for (i = 0; i < count; ++i)
+		{
+			for (j = 0; j < 3; ++j)
+			{
+				euler[i].v[j] = (a3real)360.0 * a3randomStreamNext(stream) - (a3real)180.0;
+				translate[i].v[j] = (a3real)20.0 * a3randomStreamNext(stream) - (a3real)10.0;
+				scale[i].v[j] = (a3real)1.5 * a3randomStreamNext(stream) + a3real_half;
+			}
+			a3quatSetEulerXYZ(q0[i].q, euler[i].x, euler[i].y, euler[i].z);
+			a3quatSetEulerXYZ(q1[i].q,
+				(a3real)360.0 * a3randomStreamNext(stream) - (a3real)180.0,
+				(a3real)360.0 * a3randomStreamNext(stream) - (a3real)180.0,
+				(a3real)360.0 * a3randomStreamNext(stream) - (a3real)180.0);
+			if (a3real4Dot(q0[i].q, q1[i].q) < a3real_zero)
+				a3real4Negate(q1[i].q);
+			param[i] = a3randomStreamNext(stream);
+		}
+		quat->q0 = q0;
+		quat->q1 = q1;
+		quat->translate = translate;
+		quat->scale = scale;
+		quat->param = param;
+		quat->transform = transform;
+		quat->q_out = result;
+
+		printf("\n\n  quaternion transforms: %s (%u items, %u passes)", A3_SIMD_NAME, count, passCount);
+
+		// rebuild from Euler angles one item at a time, as scene objects 
+		//	did; its results are the reference
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+			{
+				a3real4x4SetRotateXYZ(itemTransform[i].m, euler[i].x, euler[i].y, euler[i].z);
+				itemTransform[i].v3.xyz = translate[i];
+				a3real3MulS(itemTransform[i].m[0], scale[i].x);
+				a3real3MulS(itemTransform[i].m[1], scale[i].y);
+				a3real3MulS(itemTransform[i].m[2], scale[i].z);
+			}
+		a3timerStop(timer);
+		a3demo_mathPrintRate("euler:", items, timer->currentTick);
+
+		// quaternion one item at a time
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+			{
+				a3quatConvertToMat4Translate(transform[i].m, q0[i].q, translate[i].v);
+				a3real3MulS(transform[i].m[0], scale[i].x);
+				a3real3MulS(transform[i].m[1], scale[i].y);
+				a3real3MulS(transform[i].m[2], scale[i].z);
+			}
+		a3timerStop(timer);
+		diff = a3demo_mathDiff(itemTransform->mm, transform->mm, count * 16);
+		a3demo_mathPrintRate("quat:", items, timer->currentTick);
+		printf(" | max diff %.3e", diff);
+
+		// quaternion batch split across threads
+		printf("\n  %-16s         ", "TRS batch:");
+		for (threadCount = 1; threadCount <= demoMathSize_thread; threadCount *= 2)
+		{
+			memset(transform, 0, count * sizeof(a3mat4));
+			a3timerStart(timer);
+			for (pass = 0; pass < passCount; ++pass)
+				a3demo_mathBatchDispatch((a3_DemoMathBatchFunc)a3demo_mathInternalQuatTRS, quat, count, pool, threadCount);
+			a3timerStop(timer);
+			diff = a3demo_mathDiff(itemTransform->mm, transform->mm, count * 16);
+			printf(" | x%u %8.2lf M/s diff %.1e", threadCount, timer->currentTick > 0.0 ? items / timer->currentTick : 0.0, diff);
+		}
+
+		// slerp one item at a time; its results are the reference for both 
+		//	batches, so nlerp differences show its angular error
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3quatSlerpUnit(itemQuat[i].q, q0[i].q, q1[i].q, param[i]);
+		a3timerStop(timer);
+		a3demo_mathPrintRate("slerp:", items, timer->currentTick);
+
+		printf("\n  %-16s         ", "slerp batch:");
+		for (threadCount = 1; threadCount <= demoMathSize_thread; threadCount *= 2)
+		{
+			memset(result, 0, count * sizeof(a3quat));
+			a3timerStart(timer);
+			for (pass = 0; pass < passCount; ++pass)
+				a3demo_mathBatchDispatch((a3_DemoMathBatchFunc)a3demo_mathInternalQuatSlerp, quat, count, pool, threadCount);
+			a3timerStop(timer);
+			diff = a3demo_mathDiff(itemQuat->q, result->q, count * 4);
+			printf(" | x%u %8.2lf M/s diff %.1e", threadCount, timer->currentTick > 0.0 ? items / timer->currentTick : 0.0, diff);
+		}
+
+		printf("\n  %-16s         ", "nlerp batch:");
+		for (threadCount = 1; threadCount <= demoMathSize_thread; threadCount *= 2)
+		{
+			memset(result, 0, count * sizeof(a3quat));
+			a3timerStart(timer);
+			for (pass = 0; pass < passCount; ++pass)
+				a3demo_mathBatchDispatch((a3_DemoMathBatchFunc)a3demo_mathInternalQuatNlerp, quat, count, pool, threadCount);
+			a3timerStop(timer);
+			diff = a3demo_mathDiff(itemQuat->q, result->q, count * 4);
+			printf(" | x%u %8.2lf M/s diff %.1e", threadCount, timer->currentTick > 0.0 ? items / timer->currentTick : 0.0, diff);
+		}
+
+		printf("\n");
+		free(itemTransform);
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,174 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMathRandom.c
+	Random benchmark implementation.
+*/
+
+#include "../a3_DemoMathRandom.h"
+
+#include "../a3_DemoMathReport.h"
+#include "../a3_DemoMathBatch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// arrays for random report
+typedef struct a3_DemoMathRandom				a3_DemoMathRandom;
+struct a3_DemoMathRandom
+{
+	a3randstream const* stream;
+	a3real* values;
+};
+
+void a3demo_mathInternalRandomFill(a3_DemoMathRandom const* random, a3ui32 first, a3ui32 count)
+{
+	a3randomStreamFill(random->values + first, random->stream, first, count);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_mathRandomReport(a3ui32 count, a3ui32 passCount, a3_DemoWorkerPool* pool)
+{
+	a3_Timer timer[1] = { 0 };
+	a3_DemoMathRandom random[1];
+	a3randstream stream[1];
+	a3f64 items, sum, sumSq, mean, diff;
+	a3real* itemResult, * result, sample[3];
+	a3size size;
+	a3ui32 i, pass, threadCount;
+
+	if (count && passCount)
+	{
+		size = count * sizeof(a3real) * 2;
+		itemResult = (a3real*)malloc(size);
+		if (!itemResult)
+			return 0;
+		memset(itemResult, 0, size);
+		result = itemResult + count;
+		items = (a3f64)count * (a3f64)passCount * 1.0e-6;
+		a3randomStreamInit(stream, 0x5eed, 0);
+		random->stream = stream;
+		random->values = result;
+
+		printf("\n\n  random numbers: %s (%u values, %u passes)", A3_SIMD_NAME, count, passCount);
+
+		// global generator, one value at a time
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				itemResult[i] = a3randomNormalized();
+		a3timerStop(timer);
+		a3demo_mathPrintRate("global:", items, timer->currentTick);
+
+		// stream, one value at a time; its results are the reference
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+		{
+			a3randomStreamSetIndex(stream, 0);
+			for (i = 0; i < count; ++i)
+				itemResult[i] = a3randomStreamNext(stream);
+		}
+		a3timerStop(timer);
+		a3demo_mathPrintRate("stream next:", items, timer->currentTick);
+
+		// stream fill split across threads; every thread count must give 
+		//	exactly the per-item values
+		printf("\n  %-16s         ", "stream fill:");
+		for (threadCount = 1; threadCount <= demoMathSize_thread; threadCount *= 2)
+		{
+			memset(result, 0, count * sizeof(a3real));
+			a3timerStart(timer);
+			for (pass = 0; pass < passCount; ++pass)
+				a3demo_mathBatchDispatch((a3_DemoMathBatchFunc)a3demo_mathInternalRandomFill, random, count, pool, threadCount);
+			a3timerStop(timer);
+			diff = a3demo_mathDiff(itemResult, result, count);
+			printf(" | x%u %8.2lf M/s diff %.1e", threadCount, timer->currentTick > 0.0 ? items / timer->currentTick : 0.0, diff);
+		}
+
+		// samplers, with a quick check of each distribution
+		sum = sumSq = 0.0;
+		a3randomStreamSetIndex(stream, 0);
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				itemResult[i] = a3randomStreamNormal(stream, a3real_zero, a3real_one);
+		a3timerStop(timer);
+		for (i = 0; i < count; ++i)
+		{
+			sum += (a3f64)itemResult[i];
+			sumSq += (a3f64)itemResult[i] * (a3f64)itemResult[i];
+		}
+		mean = sum / (a3f64)count;
+		a3demo_mathPrintRate("normal:", items, timer->currentTick);
+		printf(" | mean %+.4lf (0) variance %.4lf (1)", mean, sumSq / (a3f64)count - mean * mean);
+
+		sum = 0.0;
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+			{
+				a3randomStreamDisc(sample, stream);
+				sum += (a3f64)a3real2LengthSquared(sample);
+			}
+		a3timerStop(timer);
+		a3demo_mathPrintRate("disc:", items, timer->currentTick);
+		printf(" | mean r^2 %.4lf (0.5)", sum / items * 1.0e-6);
+
+		sum = 0.0;
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+			{
+				a3randomStreamHemisphere(sample, stream);
+				sum += (a3f64)sample[2];
+			}
+		a3timerStop(timer);
+		a3demo_mathPrintRate("hemisphere:", items, timer->currentTick);
+		printf(" | mean z %.4lf (0.5)", sum / items * 1.0e-6);
+
+		sum = 0.0;
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+			{
+				a3randomStreamHemisphereCosine(sample, stream);
+				sum += (a3f64)sample[2];
+			}
+		a3timerStop(timer);
+		a3demo_mathPrintRate("hemisphere cos:", items, timer->currentTick);
+		printf(" | mean z %.4lf (0.6667)", sum / items * 1.0e-6);
+
+		printf("\n");
+		free(itemResult);
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,370 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMathReport.c
+	Math kernel benchmark and shared report utilities implementation.
+*/
+
+#include "../a3_DemoMathReport.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// random transform: rotation and translation, then scale depending on kind: 
+//	0 = none, 1 = uniform, 2 = per axis, 3 = skewed axes
+inline void a3demo_mathInternalRandomTransform(a3real4x4p m_out, a3ui32 const kind)
+{
+	a3real s;
+	a3demo_mathRandomMatrix(m_out);
+	a3real3GramSchmidt2(m_out[1], m_out[2], m_out[0]);
+	a3real3Normalize(m_out[0]);
+	a3real3Normalize(m_out[1]);
+	a3real3Normalize(m_out[2]);
+	m_out[0][3] = m_out[1][3] = m_out[2][3] = a3real_zero;
+	m_out[3][3] = a3real_one;
+	switch (kind)
+	{
+	case 1:
+		s = 1.5f + a3demo_mathRandom() * 0.5f;
+		a3real3MulS(m_out[0], s);
+		a3real3MulS(m_out[1], s);
+		a3real3MulS(m_out[2], s);
+		break;
+	case 2:
+		a3real3MulS(m_out[0], 1.5f + a3demo_mathRandom() * 0.5f);
+		a3real3MulS(m_out[1], 1.5f + a3demo_mathRandom() * 0.5f);
+		a3real3MulS(m_out[2], 1.5f + a3demo_mathRandom() * 0.5f);
+		break;
+	case 3:
+		m_out[0][1] += a3demo_mathRandom() * 0.25f;
+		m_out[1][2] += a3demo_mathRandom() * 0.25f;
+		m_out[2][0] += a3demo_mathRandom() * 0.25f;
+		break;
+	}
+}
+
+
+// print one kernel's results; negative times are skipped
+inline void a3demo_mathInternalPrint(a3byte const* name, a3f64 const referenceTime, a3f64 const time, a3f64 const alignedTime, a3f64 const diff)
+{
+	printf("\n  %-16s scalar %8.3lf ms | A3DM %8.3lf ms (%.2lfx)", name,
+		referenceTime * 1000.0, time * 1000.0, time > 0.0 ? referenceTime / time : 0.0);
+	if (alignedTime >= 0.0)
+		printf(" | aligned %8.3lf ms (%.2lfx)", alignedTime * 1000.0, alignedTime > 0.0 ? referenceTime / alignedTime : 0.0);
+	printf(" | max diff %.3e", diff);
+}
+
+
+// print one transform inverse's results against the general inverse
+inline void a3demo_mathInternalPrintInverse(a3byte const* name, a3f64 const generalTime, a3f64 const time, a3f64 const diff)
+{
+	printf("\n  %-16s general %8.3lf ms | transform %8.3lf ms (%.2lfx) | max diff %.3e", name,
+		generalTime * 1000.0, time * 1000.0, time > 0.0 ? generalTime / time : 0.0, diff);
+}
+
+
+// scalar reference kernels, column-major
+void a3demo_mathInternalProduct(a3real4x4p m_out, const a3real4x4p mL, const a3real4x4p mR)
+{
+	a3ui32 i, j;
+	for (i = 0; i < 4; ++i)
+		for (j = 0; j < 4; ++j)
+			m_out[i][j] = mL[0][j] * mR[i][0] + mL[1][j] * mR[i][1] + mL[2][j] * mR[i][2] + mL[3][j] * mR[i][3];
+}
+
+void a3demo_mathInternalTransform(a3real4p v_out, const a3real4x4p m, const a3real4p v)
+{
+	a3ui32 j;
+	for (j = 0; j < 4; ++j)
+		v_out[j] = m[0][j] * v[0] + m[1][j] * v[1] + m[2][j] * v[2] + m[3][j] * v[3];
+}
+
+void a3demo_mathInternalTranspose(a3real4x4p m_out, const a3real4x4p m)
+{
+	a3ui32 i, j;
+	for (i = 0; i < 4; ++i)
+		for (j = 0; j < 4; ++j)
+			m_out[i][j] = m[j][i];
+}
+
+void a3demo_mathInternalInverse(a3real4x4p m_out, const a3real4x4p m)
+{
+	// adjugate from 2x2 minors of the first two and last two columns
+	const a3f32 s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1], s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2], s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+	const a3f32 s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2], s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3], s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+	const a3f32 c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1], c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2], c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+	const a3f32 c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2], c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3], c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+	const a3f32 dInv = 1.0f / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+	m_out[0][0] = (m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3) * dInv;
+	m_out[0][1] = (-m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3) * dInv;
+	m_out[0][2] = (m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3) * dInv;
+	m_out[0][3] = (-m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3) * dInv;
+	m_out[1][0] = (-m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1) * dInv;
+	m_out[1][1] = (m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1) * dInv;
+	m_out[1][2] = (-m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1) * dInv;
+	m_out[1][3] = (m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1) * dInv;
+	m_out[2][0] = (m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0) * dInv;
+	m_out[2][1] = (-m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0) * dInv;
+	m_out[2][2] = (m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0) * dInv;
+	m_out[2][3] = (-m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0) * dInv;
+	m_out[3][0] = (-m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0) * dInv;
+	m_out[3][1] = (m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0) * dInv;
+	m_out[3][2] = (-m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0) * dInv;
+	m_out[3][3] = (m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0) * dInv;
+}
+
+void a3demo_mathInternalLerp(a3real4p v_out, const a3real4p v0, const a3real4p v1, const a3real param)
+{
+	a3ui32 j;
+	for (j = 0; j < 4; ++j)
+		v_out[j] = v0[j] + (v1[j] - v0[j]) * param;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3f32 a3demo_mathRandom()
+{
+	return (a3f32)rand() / (a3f32)RAND_MAX * 2.0f - 1.0f;
+}
+
+void a3demo_mathRandomMatrix(a3real4x4p m_out)
+{
+	a3ui32 i, j;
+	for (i = 0; i < 4; ++i)
+		for (j = 0; j < 4; ++j)
+			m_out[i][j] = a3demo_mathRandom() + (i == j ? 3.0f : 0.0f);
+}
+
+a3f64 a3demo_mathDiff(a3f32 const* a, a3f32 const* b, a3ui32 count)
+{
+	a3f64 diff = 0.0, d;
+	a3ui32 i;
+	for (i = 0; i < count; ++i)
+	{
+		d = fabs((a3f64)a[i] - (a3f64)b[i]);
+		if (d > diff)
+			diff = d;
+	}
+	return diff;
+}
+
+void a3demo_mathPrintRate(a3byte const* name, a3f64 const items, a3f64 const time)
+{
+	printf("\n  %-16s %8.2lf M/s", name, time > 0.0 ? items / time : 0.0);
+}
+
+
+a3ret a3demo_mathReport(a3ui32 count, a3ui32 passCount)
+{
+	a3_Timer timer[1] = { 0 };
+	a3f64 referenceTime, time, alignedTime;
+	a3byte* block;
+	a3size size;
+	a3mat4* mL, * mR, * reference, * result;
+	a3vec4* v, * vReference, * vResult;
+	a3ui32 i, k, pass;
+	a3byte const* const inverseName[4] = { "rigid inverse:", "uniform inverse:", "axis inverse:", "affine inverse:" };
+
+	if (count && passCount)
+	{
+		// one block, aligned by hand for aligned variants; cleared so no 
+		//	kernel pays for first touching its output
+		size = count * (sizeof(a3mat4) * 4 + sizeof(a3vec4) * 3) + 15;
+		block = (a3byte*)malloc(size);
+		if (!block)
+			return 0;
+		memset(block, 0, size);
+		mL = (a3mat4*)(((a3address)block + 15) & ~(a3address)15);
+		mR = mL + count;
+		reference = mR + count;
+		result = reference + count;
+		v = (a3vec4*)(result + count);
+		vReference = v + count;
+		vResult = vReference + count;
+		for (i = 0; i < count; ++i)
+		{
+			a3demo_mathRandomMatrix(mL[i].m);
+			a3demo_mathRandomMatrix(mR[i].m);
+			a3real4Set(v[i].v, a3demo_mathRandom(), a3demo_mathRandom(), a3demo_mathRandom(), a3demo_mathRandom());
+		}
+
+		printf("\n\n  math kernels: %s (%u inputs, %u passes)", A3_SIMD_NAME, count, passCount);
+
+		// matrix product
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3demo_mathInternalProduct(reference[i].m, mL[i].m, mR[i].m);
+		a3timerStop(timer);
+		referenceTime = timer->currentTick;
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3real4x4ProductAligned(result[i].m, mL[i].m, mR[i].m);
+		a3timerStop(timer);
+		alignedTime = timer->currentTick;
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3real4x4Product(result[i].m, mL[i].m, mR[i].m);
+		a3timerStop(timer);
+		time = timer->currentTick;
+		a3demo_mathInternalPrint("4x4 product:", referenceTime, time, alignedTime,
+			a3demo_mathDiff(reference->mm, result->mm, count * 16));
+
+		// vector transform
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3demo_mathInternalTransform(vReference[i].v, mL[i].m, v[i].v);
+		a3timerStop(timer);
+		referenceTime = timer->currentTick;
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3real4Real4x4ProductAligned(vResult[i].v, mL[i].m, v[i].v);
+		a3timerStop(timer);
+		alignedTime = timer->currentTick;
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3real4Real4x4Product(vResult[i].v, mL[i].m, v[i].v);
+		a3timerStop(timer);
+		time = timer->currentTick;
+		a3demo_mathInternalPrint("4x4 * 4D vector:", referenceTime, time, alignedTime,
+			a3demo_mathDiff(vReference->v, vResult->v, count * 4));
+
+		// transpose
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3demo_mathInternalTranspose(reference[i].m, mL[i].m);
+		a3timerStop(timer);
+		referenceTime = timer->currentTick;
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3real4x4GetTransposedAligned(result[i].m, mL[i].m);
+		a3timerStop(timer);
+		alignedTime = timer->currentTick;
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3real4x4GetTransposed(result[i].m, mL[i].m);
+		a3timerStop(timer);
+		time = timer->currentTick;
+		a3demo_mathInternalPrint("4x4 transpose:", referenceTime, time, alignedTime,
+			a3demo_mathDiff(reference->mm, result->mm, count * 16));
+
+		// inverse
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3demo_mathInternalInverse(reference[i].m, mL[i].m);
+		a3timerStop(timer);
+		referenceTime = timer->currentTick;
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3real4x4GetInverseAligned(result[i].m, mL[i].m);
+		a3timerStop(timer);
+		alignedTime = timer->currentTick;
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3real4x4GetInverse(result[i].m, mL[i].m);
+		a3timerStop(timer);
+		time = timer->currentTick;
+		a3demo_mathInternalPrint("4x4 inverse:", referenceTime, time, alignedTime,
+			a3demo_mathDiff(reference->mm, result->mm, count * 16));
+
+		// transform inverses against the general inverse of the same inputs
+		for (k = 0; k < 4; ++k)
+		{
+			for (i = 0; i < count; ++i)
+				a3demo_mathInternalRandomTransform(mR[i].m, k);
+			a3timerStart(timer);
+			for (pass = 0; pass < passCount; ++pass)
+				for (i = 0; i < count; ++i)
+					a3real4x4GetInverse(reference[i].m, mR[i].m);
+			a3timerStop(timer);
+			referenceTime = timer->currentTick;
+			a3timerStart(timer);
+			switch (k)
+			{
+			case 0:
+				for (pass = 0; pass < passCount; ++pass)
+					for (i = 0; i < count; ++i)
+						a3real4x4TransformInverseIgnoreScale(result[i].m, mR[i].m);
+				break;
+			case 1:
+				for (pass = 0; pass < passCount; ++pass)
+					for (i = 0; i < count; ++i)
+						a3real4x4TransformInverseUniformScale(result[i].m, mR[i].m);
+				break;
+			case 2:
+				for (pass = 0; pass < passCount; ++pass)
+					for (i = 0; i < count; ++i)
+						a3real4x4TransformInverse(result[i].m, mR[i].m);
+				break;
+			case 3:
+				for (pass = 0; pass < passCount; ++pass)
+					for (i = 0; i < count; ++i)
+						a3real4x4TransformInverseAffine(result[i].m, mR[i].m);
+				break;
+			}
+			a3timerStop(timer);
+			time = timer->currentTick;
+			a3demo_mathInternalPrintInverse(inverseName[k], referenceTime, time,
+				a3demo_mathDiff(reference->mm, result->mm, count * 16));
+		}
+
+		// vector interpolation, no aligned variant
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3demo_mathInternalLerp(vReference[i].v, v[i].v, mL[i].m[0], 0.25f);
+		a3timerStop(timer);
+		referenceTime = timer->currentTick;
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3real4Lerp(vResult[i].v, v[i].v, mL[i].m[0], 0.25f);
+		a3timerStop(timer);
+		time = timer->currentTick;
+		a3demo_mathInternalPrint("4D lerp:", referenceTime, time, -1.0,
+			a3demo_mathDiff(vReference->v, vResult->v, count * 4));
+
+		printf("\n");
+		free(block);
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
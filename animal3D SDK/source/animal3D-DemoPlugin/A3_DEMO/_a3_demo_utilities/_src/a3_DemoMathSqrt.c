@@ -0,0 +1,181 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMathSqrt.c
+	Square root benchmark implementation.
+*/
+
+#include "../a3_DemoMathSqrt.h"
+
+#include "../a3_DemoMathReport.h"
+#include "animal3D-A3DM/a3math/a3batch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// largest relative error of inverse square roots
+inline a3f64 a3demo_mathInternalSqrtError(a3f32 const* y, a3f32 const* x, a3ui32 count)
+{
+	a3f64 diff = 0.0, d;
+	a3ui32 i;
+	for (i = 0; i < count; ++i)
+	{
+		d = fabs((a3f64)y[i] * sqrt((a3f64)x[i]) - 1.0);
+		if (d > diff)
+			diff = d;
+	}
+	return diff;
+}
+
+// largest length error of unit vectors
+inline a3f64 a3demo_mathInternalUnitError(a3vec3 const* v, a3ui32 count)
+{
+	a3f64 diff = 0.0, d;
+	a3ui32 i;
+	for (i = 0; i < count; ++i)
+	{
+		d = fabs(sqrt((a3f64)v[i].x * (a3f64)v[i].x + (a3f64)v[i].y * (a3f64)v[i].y + (a3f64)v[i].z * (a3f64)v[i].z) - 1.0);
+		if (d > diff)
+			diff = d;
+	}
+	return diff;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_mathSqrtReport(a3ui32 count, a3ui32 passCount)
+{
+	a3_Timer timer[1] = { 0 };
+	a3f64 items;
+	a3f32* x, * y;
+	a3vec3* v, * unit;
+	a3ui32 i, j, pass, precision;
+	a3index const precisionRestore = a3sqrtGetPrecision();
+	a3byte const* const fastName[3] = { "fast low:", "fast medium:", "fast high:" };
+	a3byte const* const batchName[3] = { "batch low:", "batch medium:", "batch high:" };
+	a3byte const* const normalizeName[3] = { "normalize low:", "normalize med:", "normalize high:" };
+
+	if (count && passCount)
+	{
+		v = (a3vec3*)malloc(count * (sizeof(a3vec3) * 2 + sizeof(a3f32) * 2));
+		if (!v)
+			return 0;
+		memset(v, 0, count * (sizeof(a3vec3) * 2 + sizeof(a3f32) * 2));
+		unit = v + count;
+		x = (a3f32*)(unit + count);
+		y = x + count;
+		items = (a3f64)count * (a3f64)passCount * 1.0e-6;
+
+		// positive inputs across several orders of magnitude, and vectors 
+		//	kept away from zero length
+		for (i = 0; i < count; ++i)
+		{
+			x[i] = a3demo_mathRandom() * 500.0f + 500.001f;
+			for (j = 0; j < 3; ++j)
+				v[i].v[j] = a3demo_mathRandom();
+			v[i].z += v[i].z < 0.0f ? -0.001f : 0.001f;
+		}
+
+		printf("\n\n  inverse square root: %s (%u inputs, %u passes)", A3_SIMD_NAME, count, passCount);
+
+		// precise square root and divide, and Quake's method it replaces
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				y[i] = 1.0f / a3sqrtf(x[i]);
+		a3timerStop(timer);
+		a3demo_mathPrintRate("1 / sqrt:", items, timer->currentTick);
+		printf(" | max error %.3e", a3demo_mathInternalSqrtError(y, x, count));
+
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				y[i] = a3sqrtf0xInverse(x[i]);
+		a3timerStop(timer);
+		a3demo_mathPrintRate("0x5f3759df:", items, timer->currentTick);
+		printf(" | max error %.3e", a3demo_mathInternalSqrtError(y, x, count));
+
+		// fast inverse square root per item and as a batch at each precision
+		for (precision = a3sqrtPrecision_low; precision <= a3sqrtPrecision_high; ++precision)
+		{
+			a3sqrtSetPrecision(precision);
+			a3timerStart(timer);
+			for (pass = 0; pass < passCount; ++pass)
+				for (i = 0; i < count; ++i)
+					y[i] = a3sqrtfInverseFast(x[i]);
+			a3timerStop(timer);
+			a3demo_mathPrintRate(fastName[precision], items, timer->currentTick);
+			printf(" | max error %.3e", a3demo_mathInternalSqrtError(y, x, count));
+
+			a3timerStart(timer);
+			for (pass = 0; pass < passCount; ++pass)
+				a3sqrtfInverseFastBatch(y, x, count);
+			a3timerStop(timer);
+			a3demo_mathPrintRate(batchName[precision], items, timer->currentTick);
+			printf(" | max error %.3e", a3demo_mathInternalSqrtError(y, x, count));
+		}
+
+		// unit vectors per item and with the exact batch, then normalized in 
+		//	place at each precision; errors are length differences from one
+		printf("\n  3D unit vectors");
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < count; ++i)
+				a3real3GetUnit(unit[i].v, v[i].v);
+		a3timerStop(timer);
+		a3demo_mathPrintRate("get unit:", items, timer->currentTick);
+		printf(" | max error %.3e", a3demo_mathInternalUnitError(unit, count));
+
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			a3real3GetUnitBatch(unit, v, count);
+		a3timerStop(timer);
+		a3demo_mathPrintRate("get unit batch:", items, timer->currentTick);
+		printf(" | max error %.3e", a3demo_mathInternalUnitError(unit, count));
+
+		for (precision = a3sqrtPrecision_low; precision <= a3sqrtPrecision_high; ++precision)
+		{
+			a3sqrtSetPrecision(precision);
+			memcpy(unit, v, count * sizeof(a3vec3));
+			a3timerStart(timer);
+			for (pass = 0; pass < passCount; ++pass)
+				a3real3NormalizeBatch(unit, count);
+			a3timerStop(timer);
+			a3demo_mathPrintRate(normalizeName[precision], items, timer->currentTick);
+			printf(" | max error %.3e", a3demo_mathInternalUnitError(unit, count));
+		}
+		a3sqrtSetPrecision(precisionRestore);
+
+		printf("\n");
+		free(v);
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,164 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMathStats.c
+	Statistics benchmark implementation.
+*/
+
+#include "../a3_DemoMathStats.h"
+
+#include "../a3_DemoMathReport.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// ascending order for qsort
+int a3demo_mathInternalCompare(void const* a, void const* b)
+{
+	a3real const x = *(a3real const*)a, y = *(a3real const*)b;
+	return (x > y) - (x < y);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_mathStatsReport(a3ui32 count, a3ui32 passCount)
+{
+	a3_Timer timer[1] = { 0 };
+	a3randstream stream[1];
+	a3statsRunning running[1];
+	a3statsAverage average[1];
+	a3statsHistogram histogram[1];
+	a3real const percentile[3] = { (a3real)0.50, (a3real)0.95, (a3real)0.99 };
+	a3real exact[3], value[3];
+	a3f64 items, mean, variance, d, diff;
+	a3real* data, * work;
+	a3ui32 i, j, pass;
+
+	if (count && passCount)
+	{
+		data = (a3real*)malloc(count * sizeof(a3real) * 2);
+		if (!data)
+			return 0;
+		work = data + count;
+		items = (a3f64)count * (a3f64)passCount * 1.0e-6;
+
+		// frame times around 60 Hz with occasional hitches
+		a3randomStreamInit(stream, 0x5eed, 1);
+		for (i = 0; i < count; ++i)
+		{
+			data[i] = a3randomStreamNormal(stream, (a3real)16.7, (a3real)0.5);
+			if (a3randomStreamNext(stream) < (a3real)0.02)
+				data[i] *= (a3real)3.0;
+		}
+		for (i = 0, mean = 0.0; i < count; ++i)
+			mean += (a3f64)data[i];
+		mean /= (a3f64)count;
+		for (i = 0, variance = 0.0; i < count; ++i)
+			variance += ((a3f64)data[i] - mean) * ((a3f64)data[i] - mean);
+		variance /= (a3f64)count;
+
+		printf("\n\n  statistics: %u frame times, %u passes", count, passCount);
+
+		// sort, then read ranks; reference for all percentiles
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+		{
+			memcpy(work, data, count * sizeof(a3real));
+			qsort(work, count, sizeof(a3real), a3demo_mathInternalCompare);
+		}
+		a3timerStop(timer);
+		for (j = 0; j < 3; ++j)
+		{
+			d = (a3f64)percentile[j] * (a3f64)(count - 1);
+			i = (a3ui32)d;
+			exact[j] = (a3real)((a3f64)work[i] + (i + 1 < count ? (d - (a3f64)i) * (a3f64)(work[i + 1] - work[i]) : 0.0));
+		}
+		a3demo_mathPrintRate("sort:", items, timer->currentTick);
+		printf(" | p50 %.4lf p95 %.4lf p99 %.4lf", (a3f64)exact[0], (a3f64)exact[1], (a3f64)exact[2]);
+
+		// selection on the same copies
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+		{
+			memcpy(work, data, count * sizeof(a3real));
+			for (j = 0; j < 3; ++j)
+				value[j] = a3percentile(work, count, percentile[j]);
+		}
+		a3timerStop(timer);
+		for (j = 0, diff = 0.0; j < 3; ++j)
+			diff = a3maximum(diff, fabs((a3f64)value[j] - (a3f64)exact[j]));
+		a3demo_mathPrintRate("select:", items, timer->currentTick);
+		printf(" | max diff %.3e", diff);
+
+		// streaming accumulators, no copies
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+		{
+			a3statsHistogramInit(histogram, (a3real)0.001);
+			for (i = 0; i < count; ++i)
+				a3statsHistogramAdd(histogram, data[i]);
+		}
+		a3timerStop(timer);
+		for (j = 0, diff = 0.0; j < 3; ++j)
+		{
+			value[j] = a3statsHistogramPercentile(histogram, percentile[j]);
+			diff = a3maximum(diff, fabs((a3f64)value[j] - (a3f64)exact[j]) / (a3f64)exact[j]);
+		}
+		a3demo_mathPrintRate("histogram:", items, timer->currentTick);
+		printf(" | p50 %.4lf p95 %.4lf p99 %.4lf | max relative diff %.3e", (a3f64)value[0], (a3f64)value[1], (a3f64)value[2], diff);
+
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+		{
+			a3statsRunningReset(running);
+			for (i = 0; i < count; ++i)
+				a3statsRunningAdd(running, data[i]);
+		}
+		a3timerStop(timer);
+		a3demo_mathPrintRate("running:", items, timer->currentTick);
+		printf(" | mean diff %.3e | variance diff %.3e", fabs((a3f64)running->mean - mean), fabs((a3f64)a3statsRunningVariance(running) - variance));
+
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+		{
+			a3statsAverageInit(average, (a3real)(1.0 / 60.0));
+			for (i = 0; i < count; ++i)
+				a3statsAverageAdd(average, data[i]);
+		}
+		a3timerStop(timer);
+		a3demo_mathPrintRate("moving average:", items, timer->currentTick);
+		printf(" | last %.4lf", (a3f64)average->mean);
+
+		printf("\n");
+		free(data);
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,253 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMathTrig.c
+	Trig benchmark implementation.
+*/
+
+#include "../a3_DemoMathTrig.h"
+
+#include "../a3_DemoMathReport.h"
+#include "animal3D-A3DM/a3math/a3batch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// arrays for trig report: inputs, double-precision libm references and 
+//	outputs, shared by every path
+typedef struct a3_DemoMathTrig					a3_DemoMathTrig;
+struct a3_DemoMathTrig
+{
+	a3f32 const* angle, * unit, * y, * x;
+	a3f64 const* sinRef, * cosRef, * asinRef, * acosRef, * atan2Ref;
+	a3f32* out0, * out1;
+};
+
+// largest difference from double-precision reference
+inline a3f64 a3demo_mathInternalTrigDiff(a3f32 const* a, a3f64 const* ref, a3ui32 count)
+{
+	a3f64 diff = 0.0, d;
+	a3ui32 i;
+	for (i = 0; i < count; ++i)
+	{
+		d = fabs((a3f64)a[i] - ref[i]);
+		if (d > diff)
+			diff = d;
+	}
+	return diff;
+}
+
+// time one trig path and print throughput and largest error; 
+//	group: 0 = sin and cos, 1 = asin and acos, 2 = atan2
+//	path: 0 = libm, 1 = tables, 2 = polynomials per item, 3 = batch
+//	return: time
+a3f64 a3demo_mathInternalTrigTime(a3byte const* name, a3_DemoMathTrig const* trig, a3ui32 const group, a3ui32 const path,
+	a3ui32 const count, a3ui32 const passCount, a3f64 const libmTime)
+{
+	a3_Timer timer[1] = { 0 };
+	a3f64 const items = (a3f64)count * (a3f64)passCount * 1.0e-6;
+	a3f64 diff = 0.0;
+	a3f32* const out0 = trig->out0, * const out1 = trig->out1;
+	a3ui32 i, pass;
+
+	a3timerStart(timer);
+	for (pass = 0; pass < passCount; ++pass)
+	{
+		switch (group * 4 + path)
+		{
+		case 0:
+			for (i = 0; i < count; ++i)
+			{
+				out0[i] = sinf(trig->angle[i]);
+				out1[i] = cosf(trig->angle[i]);
+			}
+			break;
+		case 1:
+			for (i = 0; i < count; ++i)
+			{
+				out0[i] = a3sinr(trig->angle[i]);
+				out1[i] = a3cosr(trig->angle[i]);
+			}
+			break;
+		case 2:
+			for (i = 0; i < count; ++i)
+				a3trigPoly_sinr_cosr(trig->angle[i], out0 + i, out1 + i);
+			break;
+		case 3:
+			a3realSinCosBatch(out0, out1, trig->angle, count);
+			break;
+		case 4:
+			for (i = 0; i < count; ++i)
+			{
+				out0[i] = asinf(trig->unit[i]);
+				out1[i] = acosf(trig->unit[i]);
+			}
+			break;
+		case 5:
+			for (i = 0; i < count; ++i)
+			{
+				out0[i] = a3asinr(trig->unit[i]);
+				out1[i] = a3acosr(trig->unit[i]);
+			}
+			break;
+		case 6:
+			for (i = 0; i < count; ++i)
+			{
+				out0[i] = a3asinrPoly(trig->unit[i]);
+				out1[i] = a3acosrPoly(trig->unit[i]);
+			}
+			break;
+		case 7:
+			a3realAsinBatch(out0, trig->unit, count);
+			a3realAcosBatch(out1, trig->unit, count);
+			break;
+		case 8:
+			for (i = 0; i < count; ++i)
+				out0[i] = atan2f(trig->y[i], trig->x[i]);
+			break;
+		case 9:
+			for (i = 0; i < count; ++i)
+				out0[i] = a3atan2r(trig->y[i], trig->x[i]);
+			break;
+		case 10:
+			for (i = 0; i < count; ++i)
+				out0[i] = a3atan2rPoly(trig->y[i], trig->x[i]);
+			break;
+		case 11:
+			a3realAtan2Batch(out0, trig->y, trig->x, count);
+			break;
+		}
+	}
+	a3timerStop(timer);
+
+	switch (group)
+	{
+	case 0:
+		diff = a3maximum(a3demo_mathInternalTrigDiff(out0, trig->sinRef, count), a3demo_mathInternalTrigDiff(out1, trig->cosRef, count));
+		break;
+	case 1:
+		diff = a3maximum(a3demo_mathInternalTrigDiff(out0, trig->asinRef, count), a3demo_mathInternalTrigDiff(out1, trig->acosRef, count));
+		break;
+	case 2:
+		diff = a3demo_mathInternalTrigDiff(out0, trig->atan2Ref, count);
+		break;
+	}
+	printf("\n  %-16s %8.3lf ms %8.2lf M/s", name, timer->currentTick * 1000.0, timer->currentTick > 0.0 ? items / timer->currentTick : 0.0);
+	if (libmTime > 0.0)
+		printf(" (%.2lfx libm)", timer->currentTick > 0.0 ? libmTime / timer->currentTick : 0.0);
+	printf(" | max err %.3e", diff);
+	return timer->currentTick;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_mathTrigReport(a3ui32 count, a3ui32 passCount, a3real const* trigTable, a3ui32 samplesPerDegree)
+{
+	a3_DemoMathTrig trig[1];
+	a3f64 libmTime;
+	a3byte* block;
+	a3size size;
+	a3f32* angle, * unit, * y, * x;
+	a3f64* ref;
+	a3ui32 i, group, tier;
+	a3index const tierRestore = a3trigGetPolyTier();
+	a3byte const* const groupName[3] = { "sin, cos", "asin, acos", "atan2" };
+	a3byte const* const polyName[3] = { "poly low:", "poly medium:", "poly high:" };
+	a3byte const* const batchName[3] = { "batch low:", "batch medium:", "batch high:" };
+
+	if (count && passCount)
+	{
+		size = count * (sizeof(a3f32) * 6 + sizeof(a3f64) * 5) + 15;
+		block = (a3byte*)malloc(size);
+		if (!block)
+			return 0;
+		memset(block, 0, size);
+		ref = (a3f64*)(((a3address)block + 15) & ~(a3address)15);
+		angle = (a3f32*)(ref + count * 5);
+		unit = angle + count;
+		y = unit + count;
+		x = y + count;
+		trig->out0 = x + count;
+		trig->out1 = trig->out0 + count;
+
+		// angles cover the domain accepted by the table functions
+		for (i = 0; i < count; ++i)
+		{
+			angle[i] = a3demo_mathRandom() * a3real_twopi;
+			unit[i] = a3demo_mathRandom();
+			y[i] = a3demo_mathRandom();
+			x[i] = a3demo_mathRandom();
+			ref[i] = sin((a3f64)angle[i]);
+			ref[i + count] = cos((a3f64)angle[i]);
+			ref[i + count * 2] = asin((a3f64)unit[i]);
+			ref[i + count * 3] = acos((a3f64)unit[i]);
+			ref[i + count * 4] = atan2((a3f64)y[i], (a3f64)x[i]);
+		}
+		trig->angle = angle;
+		trig->unit = unit;
+		trig->y = y;
+		trig->x = x;
+		trig->sinRef = ref;
+		trig->cosRef = ref + count;
+		trig->asinRef = ref + count * 2;
+		trig->acosRef = ref + count * 3;
+		trig->atan2Ref = ref + count * 4;
+
+		// table functions only use tables if they are set, so set the 
+		//	caller's tables here; without them the table row is skipped
+		if (trigTable)
+			a3trigInitSetTables(samplesPerDegree, trigTable);
+
+		printf("\n\n  trig functions: %s (%u inputs, %u passes, ", A3_SIMD_NAME, count, passCount);
+		if (trigTable)
+			printf("tables at %u samples per degree)", samplesPerDegree);
+		else
+			printf("no tables)");
+		for (group = 0; group < 3; ++group)
+		{
+			printf("\n  %s", groupName[group]);
+			libmTime = a3demo_mathInternalTrigTime("libm:", trig, group, 0, count, passCount, 0.0);
+			if (trigTable)
+				a3demo_mathInternalTrigTime("table:", trig, group, 1, count, passCount, libmTime);
+			for (tier = a3trigPoly_low; tier <= a3trigPoly_high; ++tier)
+			{
+				a3trigSetPolyTier(tier);
+				a3demo_mathInternalTrigTime(polyName[tier], trig, group, 2, count, passCount, libmTime);
+				a3demo_mathInternalTrigTime(batchName[tier], trig, group, 3, count, passCount, libmTime);
+			}
+			a3trigSetPolyTier(tierRestore);
+		}
+
+		printf("\n");
+		free(block);
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,582 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoOcclusion.c
+	Software occlusion culling implementation.
+*/
+
+#include "../a3_DemoOcclusion.h"
+
+#include "animal3D-A3DM/a3math/a3simd.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// row spans follow the instruction set selected for math, which includes
+//	the intrinsics headers: four wide on every x86 level, eight wide with
+//	AVX2
+#if (A3_SIMD == A3_SIMD_SSE2 || A3_SIMD == A3_SIMD_SSE41 || A3_SIMD == A3_SIMD_AVX2)
+#define A3_DEMO_OCCLUSION_SSE
+#endif	// (A3_SIMD == A3_SIMD_SSE2 || A3_SIMD == A3_SIMD_SSE41 || A3_SIMD == A3_SIMD_AVX2)
+#if (A3_SIMD == A3_SIMD_AVX2)
+#define A3_DEMO_OCCLUSION_AVX
+#endif	// (A3_SIMD == A3_SIMD_AVX2)
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// layout of triangle setup: three edge functions and depth plane, each
+//	evaluated as a * x + b * y + c at pixel centers, then pixel bounds
+enum a3_DemoOcclusionTriangle
+{
+	demoOcclusionTriangle_edge0 = 0,
+	demoOcclusionTriangle_edge1 = 3,
+	demoOcclusionTriangle_edge2 = 6,
+	demoOcclusionTriangle_depth = 9,
+	demoOcclusionTriangle_x0 = 12,
+	demoOcclusionTriangle_y0,
+	demoOcclusionTriangle_x1,
+	demoOcclusionTriangle_y1,
+};
+
+// smallest clip w accepted in front of the viewer
+#define a3demo_occlusionInternalNear	0.0001f
+
+// one worker's share of tiles
+typedef struct a3_DemoOcclusionWork					a3_DemoOcclusionWork;
+struct a3_DemoOcclusionWork
+{
+	a3_DemoOcclusionBuffer* buffer;
+	a3ui32 first, step;
+};
+
+// make sure an array holds at least the required number of elements
+//	return: 1 if it does; 0 if it could not grow
+inline a3ret a3demo_occlusionInternalReserve(void** data, a3ui32* capacity, a3ui32 const required, a3ui32 const size)
+{
+	void* grown;
+	a3ui32 count;
+	if (required > *capacity)
+	{
+		count = *capacity ? *capacity : 256;
+		while (count < required)
+			count *= 2;
+		grown = realloc(*data, (size_t)count * size);
+		if (!grown)
+			return 0;
+		*data = grown;
+		*capacity = count;
+	}
+	return 1;
+}
+
+// depth of one row of a triangle within a tile, a single pixel at a time
+inline void a3demo_occlusionInternalRowScalar(a3f32* row, a3f32 const* t, a3ui32 x, a3ui32 const x1,
+	a3f32 const e0, a3f32 const e1, a3f32 const e2, a3f32 const z)
+{
+	a3f32 fx;
+	for (; x <= x1; ++x)
+	{
+		fx = (a3f32)x + 0.5f;
+		if (t[0] * fx + e0 >= 0.0f && t[3] * fx + e1 >= 0.0f && t[6] * fx + e2 >= 0.0f
+			&& t[9] * fx + z < row[x])
+			row[x] = t[9] * fx + z;
+	}
+}
+
+#ifdef A3_DEMO_OCCLUSION_SSE
+// four pixels at a time; covered pixels keep the nearer depth
+inline void a3demo_occlusionInternalRowSSE(a3f32* row, a3f32 const* t, a3ui32 x, a3ui32 const x1,
+	a3f32 const e0, a3f32 const e1, a3f32 const e2, a3f32 const z)
+{
+	__m128 const zero = _mm_setzero_ps(), four = _mm_set1_ps(4.0f);
+	__m128 const a0 = _mm_set1_ps(t[0]), a1 = _mm_set1_ps(t[3]), a2 = _mm_set1_ps(t[6]), az = _mm_set1_ps(t[9]);
+	__m128 const c0 = _mm_set1_ps(e0), c1 = _mm_set1_ps(e1), c2 = _mm_set1_ps(e2), cz = _mm_set1_ps(z);
+	__m128 fx = _mm_add_ps(_mm_set1_ps((a3f32)x), _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f));
+	__m128 inside, depth, stored;
+	for (; x <= x1; x += 4, fx = _mm_add_ps(fx, four))
+	{
+		inside = _mm_and_ps(_mm_and_ps(
+			_mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a0, fx), c0), zero),
+			_mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a1, fx), c1), zero)),
+			_mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a2, fx), c2), zero));
+		if (_mm_movemask_ps(inside))
+		{
+			depth = _mm_add_ps(_mm_mul_ps(az, fx), cz);
+			stored = _mm_loadu_ps(row + x);
+			inside = _mm_and_ps(inside, _mm_cmplt_ps(depth, stored));
+			_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, depth), _mm_andnot_ps(inside, stored)));
+		}
+	}
+}
+#endif	// A3_DEMO_OCCLUSION_SSE
+
+#ifdef A3_DEMO_OCCLUSION_AVX
+// eight pixels at a time
+inline void a3demo_occlusionInternalRowAVX(a3f32* row, a3f32 const* t, a3ui32 x, a3ui32 const x1,
+	a3f32 const e0, a3f32 const e1, a3f32 const e2, a3f32 const z)
+{
+	__m256 const zero = _mm256_setzero_ps(), eight = _mm256_set1_ps(8.0f);
+	__m256 const a0 = _mm256_set1_ps(t[0]), a1 = _mm256_set1_ps(t[3]), a2 = _mm256_set1_ps(t[6]), az = _mm256_set1_ps(t[9]);
+	__m256 const c0 = _mm256_set1_ps(e0), c1 = _mm256_set1_ps(e1), c2 = _mm256_set1_ps(e2), cz = _mm256_set1_ps(z);
+	__m256 fx = _mm256_add_ps(_mm256_set1_ps((a3f32)x), _mm256_set_ps(7.5f, 6.5f, 5.5f, 4.5f, 3.5f, 2.5f, 1.5f, 0.5f));
+	__m256 inside, depth, stored;
+	for (; x <= x1; x += 8, fx = _mm256_add_ps(fx, eight))
+	{
+		inside = _mm256_and_ps(_mm256_and_ps(
+			_mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(a0, fx), c0), zero, _CMP_GE_OQ),
+			_mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(a1, fx), c1), zero, _CMP_GE_OQ)),
+			_mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(a2, fx), c2), zero, _CMP_GE_OQ));
+		if (_mm256_movemask_ps(inside))
+		{
+			depth = _mm256_add_ps(_mm256_mul_ps(az, fx), cz);
+			stored = _mm256_loadu_ps(row + x);
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(depth, stored, _CMP_LT_OQ));
+			_mm256_storeu_ps(row + x, _mm256_blendv_ps(stored, depth, inside));
+		}
+	}
+}
+#endif	// A3_DEMO_OCCLUSION_AVX
+
+// one row with the widest vector instructions available
+inline void a3demo_occlusionInternalRow(a3f32* row, a3f32 const* t, a3ui32 const x0, a3ui32 const x1,
+	a3f32 const e0, a3f32 const e1, a3f32 const e2, a3f32 const z)
+{
+#if (defined A3_DEMO_OCCLUSION_AVX)
+	a3demo_occlusionInternalRowAVX(row, t, x0 & ~7u, x1, e0, e1, e2, z);
+#elif (defined A3_DEMO_OCCLUSION_SSE)
+	a3demo_occlusionInternalRowSSE(row, t, x0 & ~3u, x1, e0, e1, e2, z);
+#else	// !A3_DEMO_OCCLUSION_SSE
+	a3demo_occlusionInternalRowScalar(row, t, x0, x1, e0, e1, e2, z);
+#endif	// A3_DEMO_OCCLUSION_AVX
+}
+
+// pool task: rasterize triangles binned to each tile of a share; rows
+//	start at a multiple of the vector width, which always stays inside the
+//	tile, and pixels outside the triangle fail the edge tests
+void a3demo_occlusionInternalRasterizeTiles(void* args, a3ui32 index)
+{
+	a3_DemoOcclusionWork const* const work = (a3_DemoOcclusionWork*)args + index;
+	a3_DemoOcclusionBuffer* const buffer = work->buffer;
+	a3ui32 const tileCount = buffer->tileCountX * buffer->tileCountY;
+	a3ui32 tile, k, x0, y0, x1, y1, tx, ty, y;
+	a3f32 const* t;
+	a3f32* row;
+	a3f32 fy;
+
+	for (tile = work->first; tile < tileCount; tile += work->step)
+	{
+		tx = (tile % buffer->tileCountX) * demoOcclusionSize_tile;
+		ty = (tile / buffer->tileCountX) * demoOcclusionSize_tile;
+		for (k = buffer->binOffset[tile]; k < buffer->binOffset[tile + 1]; ++k)
+		{
+			t = buffer->triangle + buffer->binIndex[k] * demoOcclusionSize_triangle;
+			x0 = (a3ui32)t[demoOcclusionTriangle_x0];
+			y0 = (a3ui32)t[demoOcclusionTriangle_y0];
+			x1 = (a3ui32)t[demoOcclusionTriangle_x1];
+			y1 = (a3ui32)t[demoOcclusionTriangle_y1];
+			x0 = x0 > tx ? x0 : tx;
+			y0 = y0 > ty ? y0 : ty;
+			x1 = x1 < tx + demoOcclusionSize_tile - 1 ? x1 : tx + demoOcclusionSize_tile - 1;
+			y1 = y1 < ty + demoOcclusionSize_tile - 1 ? y1 : ty + demoOcclusionSize_tile - 1;
+			for (y = y0; y <= y1; ++y)
+			{
+				fy = (a3f32)y + 0.5f;
+				row = buffer->level[0] + y * buffer->width;
+				a3demo_occlusionInternalRow(row, t, x0, x1,
+					t[1] * fy + t[2], t[4] * fy + t[5], t[7] * fy + t[8], t[10] * fy + t[11]);
+			}
+		}
+	}
+}
+
+// farthest depth of each 2x2 block of the level below; odd edges repeat
+//	the last texel
+inline void a3demo_occlusionInternalBuildLevels(a3_DemoOcclusionBuffer* buffer)
+{
+	a3ui32 l, x, y, x0, x1, y0, y1, w, h, wPrev, hPrev;
+	a3f32 const* prev;
+	a3f32* next;
+	a3f32 d0, d1;
+	for (l = 1; l < buffer->levelCount; ++l)
+	{
+		prev = buffer->level[l - 1];
+		next = buffer->level[l];
+		wPrev = buffer->levelWidth[l - 1];
+		hPrev = buffer->levelHeight[l - 1];
+		w = buffer->levelWidth[l];
+		h = buffer->levelHeight[l];
+		for (y = 0; y < h; ++y)
+		{
+			y0 = y * 2 * wPrev;
+			y1 = (y * 2 + 1 < hPrev ? y * 2 + 1 : y * 2) * wPrev;
+			for (x = 0; x < w; ++x)
+			{
+				x0 = x * 2;
+				x1 = x * 2 + 1 < wPrev ? x * 2 + 1 : x * 2;
+				d0 = prev[y0 + x0] > prev[y0 + x1] ? prev[y0 + x0] : prev[y0 + x1];
+				d1 = prev[y1 + x0] > prev[y1 + x1] ? prev[y1 + x0] : prev[y1 + x1];
+				next[y * w + x] = d0 > d1 ? d0 : d1;
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_occlusionBuildOccluder(a3_DemoOccluderMesh* occluder_out, a3_GeometryData const* geom)
+{
+	if (occluder_out && !occluder_out->position && geom && geom->data)
+	{
+		if (geom->primType != a3prim_triangles || !geom->indexData || geom->numIndices < 3 || geom->numIndices % 3
+			|| !geom->attribData[a3attrib_geomPosition])
+			return 0;
+
+		occluder_out->position = (a3f32*)malloc(geom->numVertices * 3 * sizeof(a3f32) + geom->numIndices * sizeof(a3ui32));
+		if (occluder_out->position)
+		{
+			occluder_out->vertexCount = geom->numVertices;
+			occluder_out->triangleCount = geom->numIndices / 3;
+			occluder_out->index = (a3ui32*)(occluder_out->position + geom->numVertices * 3);
+			memcpy(occluder_out->position, geom->attribData[a3attrib_geomPosition], geom->numVertices * 3 * sizeof(a3f32));
+			a3geometryGetIndices(occluder_out->index, geom);
+			return occluder_out->triangleCount;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_occlusionReleaseOccluder(a3_DemoOccluderMesh* occluder)
+{
+	if (occluder)
+	{
+		if (occluder->position)
+		{
+			free(occluder->position);
+			memset(occluder, 0, sizeof(a3_DemoOccluderMesh));
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_occlusionCreate(a3_DemoOcclusionBuffer* buffer_out, a3ui32 width, a3ui32 height)
+{
+	a3ui32 l, total;
+	if (buffer_out && !buffer_out->level[0] && width && height)
+	{
+		memset(buffer_out, 0, sizeof(a3_DemoOcclusionBuffer));
+		buffer_out->tileCountX = (width + demoOcclusionSize_tile - 1) / demoOcclusionSize_tile;
+		buffer_out->tileCountY = (height + demoOcclusionSize_tile - 1) / demoOcclusionSize_tile;
+		buffer_out->width = width = buffer_out->tileCountX * demoOcclusionSize_tile;
+		buffer_out->height = height = buffer_out->tileCountY * demoOcclusionSize_tile;
+
+		// halve until a single texel or out of levels
+		for (l = total = 0; l < demoOcclusionSize_level; ++l)
+		{
+			buffer_out->levelWidth[l] = width;
+			buffer_out->levelHeight[l] = height;
+			total += width * height;
+			buffer_out->levelCount = l + 1;
+			if (width == 1 && height == 1)
+				break;
+			width = (width + 1) / 2;
+			height = (height + 1) / 2;
+		}
+
+		// levels, then tile bin offsets
+		buffer_out->level[0] = (a3f32*)malloc(total * sizeof(a3f32) + (buffer_out->tileCountX * buffer_out->tileCountY + 1) * sizeof(a3ui32));
+		if (buffer_out->level[0])
+		{
+			for (l = 1; l < buffer_out->levelCount; ++l)
+				buffer_out->level[l] = buffer_out->level[l - 1] + buffer_out->levelWidth[l - 1] * buffer_out->levelHeight[l - 1];
+			buffer_out->binOffset = (a3ui32*)(buffer_out->level[0] + total);
+			for (l = 0; l < total; ++l)
+				buffer_out->level[0][l] = 1.0f;
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_occlusionRelease(a3_DemoOcclusionBuffer* buffer)
+{
+	if (buffer)
+	{
+		if (buffer->level[0])
+		{
+			free(buffer->level[0]);
+			free(buffer->triangle);
+			free(buffer->clip);
+			free(buffer->binIndex);
+			memset(buffer, 0, sizeof(a3_DemoOcclusionBuffer));
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_occlusionClear(a3_DemoOcclusionBuffer* buffer)
+{
+	if (buffer)
+	{
+		buffer->triangleCount = 0;
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3demo_occlusionAddOccluder(a3_DemoOcclusionBuffer* buffer, a3_DemoOccluderMesh const* occluder, a3real const* modelViewProjection)
+{
+	a3real const* const m = modelViewProjection;
+	a3f32 const* p, * c[3];
+	a3f32 sx[3], sy[3], sz[3], area, areaInv, dz1, dz2, x0, y0, x1, y1, halfW, halfH, maxX, maxY;
+	a3f32* clip, * t;
+	a3ui32 i, k, added = 0;
+
+	if (buffer && buffer->level[0] && occluder && modelViewProjection)
+	{
+		if (!occluder->triangleCount)
+			return 0;
+		halfW = (a3f32)buffer->width * 0.5f;
+		halfH = (a3f32)buffer->height * 0.5f;
+		maxX = (a3f32)buffer->width - 1.0f;
+		maxY = (a3f32)buffer->height - 1.0f;
+		if (!a3demo_occlusionInternalReserve((void**)&buffer->clip, &buffer->clipCapacity, occluder->vertexCount * 4, sizeof(a3f32))
+			|| !a3demo_occlusionInternalReserve((void**)&buffer->triangle, &buffer->triangleCapacity,
+				(buffer->triangleCount + occluder->triangleCount) * demoOcclusionSize_triangle, sizeof(a3f32)))
+			return 0;
+
+		// clip-space vertices
+		for (i = 0, p = occluder->position, clip = buffer->clip; i < occluder->vertexCount; ++i, p += 3, clip += 4)
+		{
+			clip[0] = (a3f32)(m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12]);
+			clip[1] = (a3f32)(m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13]);
+			clip[2] = (a3f32)(m[2] * p[0] + m[6] * p[1] + m[10] * p[2] + m[14]);
+			clip[3] = (a3f32)(m[3] * p[0] + m[7] * p[1] + m[11] * p[2] + m[15]);
+		}
+
+		t = buffer->triangle + buffer->triangleCount * demoOcclusionSize_triangle;
+		for (i = 0; i < occluder->triangleCount; ++i)
+		{
+			c[0] = buffer->clip + occluder->index[i * 3 + 0] * 4;
+			c[1] = buffer->clip + occluder->index[i * 3 + 1] * 4;
+			c[2] = buffer->clip + occluder->index[i * 3 + 2] * 4;
+			if (c[0][3] < a3demo_occlusionInternalNear || c[1][3] < a3demo_occlusionInternalNear || c[2][3] < a3demo_occlusionInternalNear)
+				continue;
+
+			// pixel coordinates and normalized depth
+			for (k = 0; k < 3; ++k)
+			{
+				sx[k] = (c[k][0] / c[k][3] + 1.0f) * halfW;
+				sy[k] = (c[k][1] / c[k][3] + 1.0f) * halfH;
+				sz[k] = c[k][2] / c[k][3];
+			}
+
+			// counter-clockwise triangles face the viewer
+			area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sx[2] - sx[0]) * (sy[1] - sy[0]);
+			if (area <= 0.0f)
+				continue;
+
+			// pixel centers covered by bounds
+			x0 = ceilf((sx[0] < sx[1] ? (sx[0] < sx[2] ? sx[0] : sx[2]) : (sx[1] < sx[2] ? sx[1] : sx[2])) - 0.5f);
+			y0 = ceilf((sy[0] < sy[1] ? (sy[0] < sy[2] ? sy[0] : sy[2]) : (sy[1] < sy[2] ? sy[1] : sy[2])) - 0.5f);
+			x1 = floorf((sx[0] > sx[1] ? (sx[0] > sx[2] ? sx[0] : sx[2]) : (sx[1] > sx[2] ? sx[1] : sx[2])) - 0.5f);
+			y1 = floorf((sy[0] > sy[1] ? (sy[0] > sy[2] ? sy[0] : sy[2]) : (sy[1] > sy[2] ? sy[1] : sy[2])) - 0.5f);
+			x0 = x0 > 0.0f ? x0 : 0.0f;
+			y0 = y0 > 0.0f ? y0 : 0.0f;
+			x1 = x1 < maxX ? x1 : maxX;
+			y1 = y1 < maxY ? y1 : maxY;
+			if (x0 > x1 || y0 > y1)
+				continue;
+
+			// edge functions, positive inside
+			for (k = 0; k < 3; ++k)
+			{
+				t[k * 3 + 0] = sy[(k + 1) % 3] - sy[(k + 2) % 3];
+				t[k * 3 + 1] = sx[(k + 2) % 3] - sx[(k + 1) % 3];
+				t[k * 3 + 2] = sx[(k + 1) % 3] * sy[(k + 2) % 3] - sx[(k + 2) % 3] * sy[(k + 1) % 3];
+			}
+
+			// depth plane through all three vertices
+			areaInv = 1.0f / area;
+			dz1 = sz[1] - sz[0];
+			dz2 = sz[2] - sz[0];
+			t[demoOcclusionTriangle_depth + 0] = (dz1 * (sy[2] - sy[0]) - dz2 * (sy[1] - sy[0])) * areaInv;
+			t[demoOcclusionTriangle_depth + 1] = (dz2 * (sx[1] - sx[0]) - dz1 * (sx[2] - sx[0])) * areaInv;
+			t[demoOcclusionTriangle_depth + 2] = sz[0] - t[demoOcclusionTriangle_depth + 0] * sx[0] - t[demoOcclusionTriangle_depth + 1] * sy[0];
+
+			t[demoOcclusionTriangle_x0] = x0;
+			t[demoOcclusionTriangle_y0] = y0;
+			t[demoOcclusionTriangle_x1] = x1;
+			t[demoOcclusionTriangle_y1] = y1;
+			t += demoOcclusionSize_triangle;
+			++added;
+		}
+		buffer->triangleCount += added;
+		return added;
+	}
+	return -1;
+}
+
+a3ret a3demo_occlusionRasterize(a3_DemoOcclusionBuffer* buffer, a3_DemoWorkerPool* pool, a3ui32 threadCount)
+{
+	a3_DemoOcclusionWork work[demoOcclusionSize_thread];
+	a3ui32 const tileCount = buffer ? buffer->tileCountX * buffer->tileCountY : 0;
+	a3ui32 i, tx, ty, tx0, ty0, tx1, ty1;
+	a3f32 const* t;
+
+	if (buffer && buffer->level[0])
+	{
+		for (i = 0; i < buffer->width * buffer->height; ++i)
+			buffer->level[0][i] = 1.0f;
+
+		// count triangles in each tile, then offsets, then fill; offsets
+		//	are advanced while filling and shifted back after
+		memset(buffer->binOffset, 0, (tileCount + 1) * sizeof(a3ui32));
+		for (i = 0, t = buffer->triangle; i < buffer->triangleCount; ++i, t += demoOcclusionSize_triangle)
+		{
+			tx0 = (a3ui32)t[demoOcclusionTriangle_x0] / demoOcclusionSize_tile;
+			ty0 = (a3ui32)t[demoOcclusionTriangle_y0] / demoOcclusionSize_tile;
+			tx1 = (a3ui32)t[demoOcclusionTriangle_x1] / demoOcclusionSize_tile;
+			ty1 = (a3ui32)t[demoOcclusionTriangle_y1] / demoOcclusionSize_tile;
+			for (ty = ty0; ty <= ty1; ++ty)
+				for (tx = tx0; tx <= tx1; ++tx)
+					++buffer->binOffset[ty * buffer->tileCountX + tx + 1];
+		}
+		for (i = 0; i < tileCount; ++i)
+			buffer->binOffset[i + 1] += buffer->binOffset[i];
+		if (!a3demo_occlusionInternalReserve((void**)&buffer->binIndex, &buffer->binCapacity, buffer->binOffset[tileCount], sizeof(a3ui32)))
+			return 0;
+		for (i = 0, t = buffer->triangle; i < buffer->triangleCount; ++i, t += demoOcclusionSize_triangle)
+		{
+			tx0 = (a3ui32)t[demoOcclusionTriangle_x0] / demoOcclusionSize_tile;
+			ty0 = (a3ui32)t[demoOcclusionTriangle_y0] / demoOcclusionSize_tile;
+			tx1 = (a3ui32)t[demoOcclusionTriangle_x1] / demoOcclusionSize_tile;
+			ty1 = (a3ui32)t[demoOcclusionTriangle_y1] / demoOcclusionSize_tile;
+			for (ty = ty0; ty <= ty1; ++ty)
+				for (tx = tx0; tx <= tx1; ++tx)
+					buffer->binIndex[buffer->binOffset[ty * buffer->tileCountX + tx]++] = i;
+		}
+		for (i = tileCount; i > 0; --i)
+			buffer->binOffset[i] = buffer->binOffset[i - 1];
+		buffer->binOffset[0] = 0;
+
+		// tiles are dealt out in turn so each share gets some of the
+		//	busy middle of the screen; the caller helps run shares
+		threadCount = threadCount ? threadCount : 1;
+		threadCount = threadCount < demoOcclusionSize_thread ? threadCount : demoOcclusionSize_thread;
+		threadCount = threadCount < tileCount ? threadCount : tileCount;
+		for (i = 0; i < threadCount; ++i)
+		{
+			work[i].buffer = buffer;
+			work[i].first = i;
+			work[i].step = threadCount;
+		}
+		a3demo_workerPoolRun(pool, a3demo_occlusionInternalRasterizeTiles, work, threadCount);
+
+		a3demo_occlusionInternalBuildLevels(buffer);
+		return buffer->triangleCount;
+	}
+	return -1;
+}
+
+a3ret a3demo_occlusionTestBounds(a3_DemoOcclusionBuffer const* buffer, a3_VertexBounds const* bounds, a3real const* modelViewProjection)
+{
+	a3real const* const m = modelViewProjection;
+	a3f32 const* depth;
+	a3f32 p[3], x, y, z, w, xMin = 0.0f, yMin = 0.0f, zMin = 0.0f, xMax = 0.0f, yMax = 0.0f;
+	a3i32 x0, y0, x1, y1, i, j, l;
+
+	if (buffer && buffer->level[0] && bounds && modelViewProjection)
+	{
+		// screen rectangle and nearest depth of corners; any corner near
+		//	or behind the viewer means the box is too close to hide
+		for (i = 0; i < 8; ++i)
+		{
+			p[0] = (i & 1) ? bounds->max[0] : bounds->min[0];
+			p[1] = (i & 2) ? bounds->max[1] : bounds->min[1];
+			p[2] = (i & 4) ? bounds->max[2] : bounds->min[2];
+			w = (a3f32)(m[3] * p[0] + m[7] * p[1] + m[11] * p[2] + m[15]);
+			if (w < a3demo_occlusionInternalNear)
+				return 1;
+			w = 1.0f / w;
+			x = (a3f32)(m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12]) * w;
+			y = (a3f32)(m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13]) * w;
+			z = (a3f32)(m[2] * p[0] + m[6] * p[1] + m[10] * p[2] + m[14]) * w;
+			if (!i)
+			{
+				xMin = xMax = x;
+				yMin = yMax = y;
+				zMin = z;
+			}
+			else
+			{
+				xMin = x < xMin ? x : xMin;
+				xMax = x > xMax ? x : xMax;
+				yMin = y < yMin ? y : yMin;
+				yMax = y > yMax ? y : yMax;
+				zMin = z < zMin ? z : zMin;
+			}
+		}
+
+		// off screen is for the frustum to decide
+		if (xMax < -1.0f || xMin > 1.0f || yMax < -1.0f || yMin > 1.0f || zMin > 1.0f)
+			return 1;
+		xMin = xMin > -1.0f ? xMin : -1.0f;
+		yMin = yMin > -1.0f ? yMin : -1.0f;
+		xMax = xMax < 1.0f ? xMax : 1.0f;
+		yMax = yMax < 1.0f ? yMax : 1.0f;
+		x0 = (a3i32)((xMin + 1.0f) * 0.5f * (a3f32)buffer->width);
+		y0 = (a3i32)((yMin + 1.0f) * 0.5f * (a3f32)buffer->height);
+		x1 = (a3i32)((xMax + 1.0f) * 0.5f * (a3f32)buffer->width);
+		y1 = (a3i32)((yMax + 1.0f) * 0.5f * (a3f32)buffer->height);
+		x1 = x1 < (a3i32)buffer->width ? x1 : (a3i32)buffer->width - 1;
+		y1 = y1 < (a3i32)buffer->height ? y1 : (a3i32)buffer->height - 1;
+
+		// coarsest level where the rectangle spans a few texels
+		for (l = 0; (x1 - x0 >= 4 || y1 - y0 >= 4) && l + 1 < (a3i32)buffer->levelCount; ++l)
+		{
+			x0 >>= 1;
+			y0 >>= 1;
+			x1 >>= 1;
+			y1 >>= 1;
+		}
+
+		// hidden if everything drawn there is nearer than the box
+		depth = buffer->level[l];
+		for (j = y0; j <= y1; ++j)
+			for (i = x0; i <= x1; ++i)
+				if (depth[j * buffer->levelWidth[l] + i] >= zMin)
+					return 1;
+		return 0;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -26,13 +26,18 @@
 
 #include "../a3_DemoRenderUtils.h"
 
+#include "animal3D-A3DM/a3math/a3batch.h"
+
 
 //-----------------------------------------------------------------------------
 // GENERAL UTILITIES
 
 inline void a3demo_applyRotation_internal(a3_SceneObjectComponent const* sceneObject, a3boolean const useZYX)
 {
-	if (useZYX)
+	if (sceneObject->dataPtr->rotateMode == a3rotate_quaternion)
+		a3quatConvertToMat4(sceneObject->modelMatrixStackPtr->modelMat.m,
+			sceneObject->dataPtr->rotation.q);
+	else if (useZYX)
 		a3real4x4SetRotateZYX(sceneObject->modelMatrixStackPtr->modelMat.m,
 			sceneObject->dataPtr->euler.x, sceneObject->dataPtr->euler.y, sceneObject->dataPtr->euler.z);
 	else
@@ -108,8 +113,10 @@ extern inline void a3demo_resetSceneObjectData(a3_SceneObjectData* sceneObjectDa
 {
 	sceneObjectData->position = a3vec4_w;
 	sceneObjectData->euler = a3vec4_zero;
+	sceneObjectData->rotation = a3quat_identity;
 	sceneObjectData->scale = a3vec3_one;
 	sceneObjectData->scaleMode = a3scale_disable;
+	sceneObjectData->rotateMode = a3rotate_euler;
 }
 
 extern inline void a3demo_resetProjectorData(a3_ProjectorData* projectorData)
@@ -212,6 +219,47 @@ extern inline void a3demo_updateSceneObject(a3_SceneObjectComponent const* scene
 	a3demo_applyScaleAndInvert_internal(sceneObject);
 }
 
+void a3demo_updateSceneObjectArray(a3_SceneObjectComponent const* sceneObjectArray, a3ui32 const count, const a3boolean useZYX)
+{
+	// gather quaternion objects in groups, convert, then scatter
+	enum { groupSize = 16 };
+	a3quat rotation[groupSize];
+	a3vec3 translate[groupSize];
+	a3mat4 modelMat[groupSize];
+	a3_SceneObjectComponent const* sceneObject[groupSize];
+	a3ui32 i, j, n;
+
+	for (i = n = 0; i < count; ++i, ++sceneObjectArray)
+	{
+		if (sceneObjectArray->dataPtr->rotateMode == a3rotate_quaternion)
+		{
+			sceneObject[n] = sceneObjectArray;
+			rotation[n] = sceneObjectArray->dataPtr->rotation;
+			translate[n] = sceneObjectArray->dataPtr->position.xyz;
+			if (++n == groupSize)
+			{
+				a3quatConvertToMat4TRSBatch(modelMat, rotation, translate, 0, n);
+				for (j = 0; j < n; ++j)
+				{
+					sceneObject[j]->modelMatrixStackPtr->modelMat = modelMat[j];
+					a3demo_applyScaleAndInvert_internal(sceneObject[j]);
+				}
+				n = 0;
+			}
+		}
+		else
+			a3demo_updateSceneObject(sceneObjectArray, useZYX);
+	}
+
+	// remainder
+	a3quatConvertToMat4TRSBatch(modelMat, rotation, translate, 0, n);
+	for (j = 0; j < n; ++j)
+	{
+		sceneObject[j]->modelMatrixStackPtr->modelMat = modelMat[j];
+		a3demo_applyScaleAndInvert_internal(sceneObject[j]);
+	}
+}
+
 extern inline void a3demo_updateProjector(a3_ProjectorComponent const* projector)
 {
 	if (projector->dataPtr->perspective)
@@ -272,6 +320,52 @@ extern inline void a3demo_updateSceneObjectStack(a3_SceneObjectComponent const*
 		sceneObject->modelMatrixStackPtr->modelViewMat.m);
 }
 
+void a3demo_updateSceneObjectStackArray(a3_SceneObjectComponent const* sceneObjectArray, a3ui32 const count, a3_ProjectorComponent const* projector_active)
+{
+	// gather model matrices in groups, take products together, then scatter
+	enum { groupSize = 16 };
+	a3mat4 modelMat[groupSize], modelMatInverse[groupSize], projectorModelMat[groupSize];
+	a3mat4 modelViewMat[groupSize], modelViewMatInverse[groupSize], modelViewProjectionMat[groupSize];
+	a3_ModelMatrixStack* modelMatrixStack;
+	a3ui32 i, j, n;
+
+	for (j = 0; j < groupSize; ++j)
+		projectorModelMat[j] = projector_active->sceneObjectPtr->modelMatrixStackPtr->modelMat;
+
+	for (i = 0; i < count; i += n)
+	{
+		n = count - i < groupSize ? count - i : groupSize;
+		for (j = 0; j < n; ++j)
+		{
+			modelMat[j] = sceneObjectArray[i + j].modelMatrixStackPtr->modelMat;
+			modelMatInverse[j] = sceneObjectArray[i + j].modelMatrixStackPtr->modelMatInverse;
+		}
+
+		// model-view = V_proj * M = M_proj^-1 * M
+		a3real4x4ProductBatchSharedL(modelViewMat,
+			projector_active->sceneObjectPtr->modelMatrixStackPtr->modelMatInverse.m, modelMat, n);
+
+		// model-view inverse = M^-1 * V_proj^-1 = M^-1 * M_proj
+		a3real4x4ProductBatch(modelViewMatInverse, modelMatInverse, projectorModelMat, n);
+
+		// model-view-projection = P_proj * (MV)
+		a3real4x4ProductBatchSharedL(modelViewProjectionMat,
+			projector_active->projectorMatrixStackPtr->projectionMat.m, modelViewMat, n);
+
+		for (j = 0; j < n; ++j)
+		{
+			modelMatrixStack = sceneObjectArray[i + j].modelMatrixStackPtr;
+			modelMatrixStack->modelViewMat = modelViewMat[j];
+			modelMatrixStack->modelViewMatInverse = modelViewMatInverse[j];
+			modelMatrixStack->modelViewProjectionMat = modelViewProjectionMat[j];
+
+			// inverse-transposes
+			a3demo_quickTransposedZeroBottomRow(modelMatrixStack->modelMatInverseTranspose.m, modelMatInverse[j].m);
+			a3demo_quickTransposedZeroBottomRow(modelMatrixStack->modelViewMatInverseTranspose.m, modelViewMatInverse[j].m);
+		}
+	}
+}
+
 extern inline void a3demo_updateProjectorBiasMats(a3_ProjectorComponent const* projector, a3mat4 const bias, a3mat4 const biasInv)
 {
 	// projection-bias
@@ -0,0 +1,307 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoShaderCache.c
+	Shader program binary cache implementation.
+*/
+
+#include "../a3_DemoShaderCache.h"
+
+
+//-----------------------------------------------------------------------------
+
+// OpenGL
+#ifdef _WIN32
+#include <gl/glew.h>
+#include <Windows.h>
+#include <GL/GL.h>
+#else	// !_WIN32
+#include <OpenGL/gl3.h>
+#endif	// _WIN32
+
+#include <stdio.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+// bump to invalidate every existing binary (e.g. cache layout changes)
+#define A3_DEMO_SHADER_CACHE_VERSION	1
+
+// index file listing which binary belongs to which program
+#define A3_DEMO_SHADER_CACHE_INDEX		"index.txt"
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+inline void a3demo_shaderCacheInternalFilePath(a3byte* path_out, a3_DemoShaderCache const* cache, a3ui64 const key)
+{
+	sprintf(path_out, "%s/%016llx.bin", cache->directory, (unsigned long long)key);
+}
+
+inline void a3demo_shaderCacheInternalIndexPath(a3byte* path_out, a3_DemoShaderCache const* cache)
+{
+	sprintf(path_out, "%s/"A3_DEMO_SHADER_CACHE_INDEX, cache->directory);
+}
+
+inline a3_DemoShaderCacheEntry* a3demo_shaderCacheInternalFind(a3_DemoShaderCache* cache, a3byte const* name)
+{
+	a3ui32 i;
+	for (i = 0; i < cache->entryCount; ++i)
+		if (!strncmp(cache->entry[i].name, name, sizeof(cache->entry[i].name)))
+			return (cache->entry + i);
+	return 0;
+}
+
+inline a3_DemoShaderCacheEntry* a3demo_shaderCacheInternalFindOrAdd(a3_DemoShaderCache* cache, a3byte const* name)
+{
+	a3_DemoShaderCacheEntry* entry = a3demo_shaderCacheInternalFind(cache, name);
+	if (!entry && cache->entryCount < demoShaderCacheMaxCount_entry)
+	{
+		entry = cache->entry + cache->entryCount++;
+		memset(entry, 0, sizeof(*entry));
+		strncpy(entry->name, name, sizeof(entry->name) - 1);
+	}
+	return entry;
+}
+
+inline void a3demo_shaderCacheInternalEvict(a3_DemoShaderCache const* cache, a3ui64 const key)
+{
+	a3byte path[demoShaderCacheMaxCount_pathLen + 32];
+	a3demo_shaderCacheInternalFilePath(path, cache, key);
+	remove(path);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ui64 a3demo_shaderCacheHash(a3ui64 hash, void const* data, a3ui32 const size)
+{
+	a3ubyte const* itr = (a3ubyte const*)data, * const end = itr + size;
+	while (itr < end)
+	{
+		hash ^= *(itr++);
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+a3ui64 a3demo_shaderCacheHashString(a3ui64 hash, a3byte const* str)
+{
+	if (str)
+		hash = a3demo_shaderCacheHash(hash, str, (a3ui32)strlen(str));
+	return a3demo_shaderCacheHash(hash, "", 1);
+}
+
+a3ui64 a3demo_shaderCacheHashFileList(a3ui64 hash, a3byte const* const* filePathList, a3ui32 const count)
+{
+	a3_Stream fs[1] = { 0 };
+	a3ui32 i;
+	if (filePathList)
+	{
+		for (i = 0; i < count; ++i)
+		{
+			if (filePathList[i] && *filePathList[i] && a3streamLoadContents(fs, filePathList[i]) > 0)
+			{
+				hash = a3demo_shaderCacheHash(hash, fs->contents, fs->length);
+				a3streamReleaseContents(fs);
+			}
+			hash = a3demo_shaderCacheHashString(hash, filePathList[i]);
+		}
+	}
+	return hash;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_shaderCacheOpen(a3_DemoShaderCache* cache, a3byte const* directory)
+{
+	a3byte path[demoShaderCacheMaxCount_pathLen + 32];
+	a3_DemoShaderCacheEntry* entry;
+	unsigned long long key;
+	a3i32 formatCount = 0;
+	a3i32 const version = A3_DEMO_SHADER_CACHE_VERSION;
+	FILE* fp;
+
+	if (cache && directory && *directory && strlen(directory) < demoShaderCacheMaxCount_pathLen)
+	{
+		memset(cache, 0, sizeof(*cache));
+		strcpy(cache->directory, directory);
+		a3fileStreamMakeDirectory(directory);
+
+		// platform key: a binary is only valid for the exact driver that made it
+		cache->platformKey = a3demo_shaderCacheHash(a3demo_shaderCacheHashSeed, &version, sizeof(version));
+		cache->platformKey = a3demo_shaderCacheHashString(cache->platformKey, (a3byte const*)glGetString(GL_VENDOR));
+		cache->platformKey = a3demo_shaderCacheHashString(cache->platformKey, (a3byte const*)glGetString(GL_RENDERER));
+		cache->platformKey = a3demo_shaderCacheHashString(cache->platformKey, (a3byte const*)glGetString(GL_VERSION));
+		cache->platformKey = a3demo_shaderCacheHashString(cache->platformKey, (a3byte const*)glGetString(GL_SHADING_LANGUAGE_VERSION));
+
+		// driver must expose at least one binary format
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+		cache->supported = (formatCount > 0);
+
+		// read index
+		a3demo_shaderCacheInternalIndexPath(path, cache);
+		fp = fopen(path, "r");
+		if (fp)
+		{
+			while (cache->entryCount < demoShaderCacheMaxCount_entry &&
+				fscanf(fp, "%llx %127s", &key, path) == 2)
+			{
+				entry = a3demo_shaderCacheInternalFindOrAdd(cache, path);
+				if (entry)
+					entry->key = (a3ui64)key;
+			}
+			fclose(fp);
+		}
+		return cache->supported;
+	}
+	return -1;
+}
+
+a3ui64 a3demo_shaderCacheProgramKey(a3_DemoShaderCache const* cache, a3byte const* programName, a3ui64 const sourceKey)
+{
+	a3ui64 key = cache ? cache->platformKey : a3demo_shaderCacheHashSeed;
+	key = a3demo_shaderCacheHashString(key, programName);
+	key = a3demo_shaderCacheHash(key, &sourceKey, sizeof(sourceKey));
+	return key;
+}
+
+a3ret a3demo_shaderCacheLoadProgram(a3_DemoShaderCache* cache, a3_ShaderProgram* program, a3ui64 const key)
+{
+	a3byte path[demoShaderCacheMaxCount_pathLen + 32];
+	a3_DemoShaderCacheEntry* entry;
+	a3ret result = 0;
+
+	if (cache && program && program->handle->handle && !program->linked)
+	{
+		entry = a3demo_shaderCacheInternalFindOrAdd(cache, program->handle->name);
+		if (entry)
+		{
+			entry->used = a3true;
+			if (entry->key && entry->key != key)
+			{
+				// sources or driver changed: old binary can never be used again
+				a3demo_shaderCacheInternalEvict(cache, entry->key);
+				entry->key = 0;
+			}
+			else if (entry->key && cache->supported)
+			{
+				a3demo_shaderCacheInternalFilePath(path, cache, key);
+				result = a3shaderProgramLoadBinary(program, path);
+				if (result <= 0)
+				{
+					// driver rejected binary; program is still usable for a normal link
+					a3demo_shaderCacheInternalEvict(cache, entry->key);
+					entry->key = 0;
+					result = 0;
+				}
+			}
+		}
+		return result;
+	}
+	return -1;
+}
+
+a3ret a3demo_shaderCacheStoreProgram(a3_DemoShaderCache* cache, a3_ShaderProgram const* program, a3ui64 const key)
+{
+	a3byte path[demoShaderCacheMaxCount_pathLen + 32];
+	a3_DemoShaderCacheEntry* entry;
+
+	if (cache && program && program->handle->handle && program->linked)
+	{
+		entry = a3demo_shaderCacheInternalFindOrAdd(cache, program->handle->name);
+		if (entry && cache->supported)
+		{
+			if (entry->key && entry->key != key)
+				a3demo_shaderCacheInternalEvict(cache, entry->key);
+			a3demo_shaderCacheInternalFilePath(path, cache, key);
+			entry->used = a3true;
+			entry->key = (a3shaderProgramSaveBinary(program, path) > 0) ? key : 0;
+			return (entry->key != 0);
+		}
+		return 0;
+	}
+	return -1;
+}
+
+void a3demo_shaderCacheRecordTime(a3_DemoShaderCache* cache, a3_ShaderProgram const* program, a3boolean const hit, a3f64 const seconds)
+{
+	if (cache && program)
+	{
+		if (hit)
+		{
+			++cache->hitCount;
+			cache->hitTime += seconds;
+		}
+		else
+		{
+			++cache->missCount;
+			cache->missTime += seconds;
+		}
+		printf("\n  %-32s %s %8.3lf ms", program->handle->name, (hit ? "cache hit" : "compiled "), seconds * 1000.0);
+	}
+}
+
+a3ret a3demo_shaderCacheClose(a3_DemoShaderCache* cache)
+{
+	a3byte path[demoShaderCacheMaxCount_pathLen + 32];
+	a3_DemoShaderCacheEntry* entry;
+	a3ui32 i, evicted = 0;
+	FILE* fp;
+
+	if (cache && *cache->directory)
+	{
+		// evict programs that were not requested during this load
+		a3demo_shaderCacheInternalIndexPath(path, cache);
+		fp = fopen(path, "w");
+		for (i = 0, entry = cache->entry; i < cache->entryCount; ++i, ++entry)
+		{
+			if (entry->used && entry->key)
+			{
+				if (fp)
+					fprintf(fp, "%016llx %s\n", (unsigned long long)entry->key, entry->name);
+			}
+			else if (entry->key)
+			{
+				a3demo_shaderCacheInternalEvict(cache, entry->key);
+				++evicted;
+			}
+		}
+		if (fp)
+			fclose(fp);
+		*cache->directory = 0;
+
+		// summary
+		printf("\n\n  shader cache: %u hit (%.3lf ms), %u compiled (%.3lf ms), %u evicted",
+			cache->hitCount, cache->hitTime * 1000.0, cache->missCount, cache->missTime * 1000.0, evicted);
+		if (cache->hitCount && cache->missCount)
+			printf("\n  shader cache: average %.3lf ms per hit vs. %.3lf ms per compile",
+				cache->hitTime * 1000.0 / (a3f64)cache->hitCount, cache->missTime * 1000.0 / (a3f64)cache->missCount);
+		printf("\n");
+		return evicted;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
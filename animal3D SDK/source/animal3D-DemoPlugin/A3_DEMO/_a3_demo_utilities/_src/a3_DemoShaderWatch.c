@@ -0,0 +1,231 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoShaderWatch.c
+	Shader source file watcher implementation.
+*/
+
+#include "../a3_DemoShaderWatch.h"
+
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif	// __linux__
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// read modification stamp of a file
+//	return: non-zero if stamp changed since last read
+inline a3boolean a3demo_shaderWatchInternalStamp(a3_DemoShaderWatchFile* file)
+{
+	a3i64 time = 0, size = -1;
+	a3boolean changed;
+#ifdef _WIN32
+	struct _stat64 info[1];
+	if (_stat64(file->path, info) == 0)
+#else	// !_WIN32
+	struct stat info[1];
+	if (stat(file->path, info) == 0)
+#endif	// _WIN32
+	{
+		time = (a3i64)info->st_mtime;
+		size = (a3i64)info->st_size;
+	}
+	changed = (time != file->time || size != file->size);
+	file->time = time;
+	file->size = size;
+	return changed;
+}
+
+// find or add the directory containing a file
+inline a3i32 a3demo_shaderWatchInternalDirectory(a3_DemoShaderWatch* watch, a3byte const* directory, a3ui32 const length)
+{
+	a3ui32 i;
+	for (i = 0; i < watch->directoryCount; ++i)
+		if (strlen(watch->directory[i]) == length && !strncmp(watch->directory[i], directory, length))
+			return i;
+	if (watch->directoryCount < demoShaderWatchMaxCount_directory)
+	{
+		strncpy(watch->directory[i], directory, length);
+		watch->directory[i][length] = 0;
+		return watch->directoryCount++;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_shaderWatchInit(a3_DemoShaderWatch* watch, a3f64 const pollInterval)
+{
+	if (watch)
+	{
+		memset(watch, 0, sizeof(*watch));
+		watch->notify = -1;
+		watch->pollInterval = pollInterval;
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3demo_shaderWatchAddDependency(a3_DemoShaderWatch* watch, a3byte const* filePath, a3ui32 const dependentIndex)
+{
+	a3_DemoShaderWatchFile* file;
+	a3byte const* name;
+	a3i32 directory;
+	a3ui32 i;
+
+	if (watch && filePath && *filePath && dependentIndex < demoShaderWatchMaxCount_dependent &&
+		strlen(filePath) < demoShaderWatchMaxCount_pathLen)
+	{
+		// already known: just add dependent
+		for (i = 0, file = watch->file; i < watch->fileCount; ++i, ++file)
+			if (!strcmp(file->path, filePath))
+			{
+				file->dependents |= 1ull << dependentIndex;
+				return 1;
+			}
+
+		if (watch->fileCount < demoShaderWatchMaxCount_file)
+		{
+			// split path into directory and name
+			name = strrchr(filePath, '/');
+			if (!name)
+				name = strrchr(filePath, '\\');
+			name = name ? (name + 1) : filePath;
+			directory = (name > filePath)
+				? a3demo_shaderWatchInternalDirectory(watch, filePath, (a3ui32)(name - filePath))
+				: a3demo_shaderWatchInternalDirectory(watch, "./", 2);
+			if (directory >= 0)
+			{
+				file = watch->file + watch->fileCount++;
+				strcpy(file->path, filePath);
+				file->nameOffset = (a3ui32)(name - filePath);
+				file->directory = directory;
+				file->dependents = 1ull << dependentIndex;
+				return 1;
+			}
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_shaderWatchStart(a3_DemoShaderWatch* watch)
+{
+	a3ui32 i;
+	if (watch)
+	{
+		// stamps are the polling fallback's reference
+		for (i = 0; i < watch->fileCount; ++i)
+			a3demo_shaderWatchInternalStamp(watch->file + i);
+
+#ifdef __linux__
+		// watch directories instead of files so that editors replacing
+		//	files on save (write then rename) are still seen
+		watch->notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		for (i = 0; i < watch->directoryCount && watch->notify >= 0; ++i)
+		{
+			watch->directoryWatch[i] = inotify_add_watch(watch->notify, watch->directory[i], IN_CLOSE_WRITE | IN_MOVED_TO);
+			if (watch->directoryWatch[i] < 0)
+			{
+				close(watch->notify);
+				watch->notify = -1;
+			}
+		}
+#endif	// __linux__
+
+		return (watch->notify >= 0);
+	}
+	return -1;
+}
+
+a3ui64 a3demo_shaderWatchUpdate(a3_DemoShaderWatch* watch, a3f64 const dt)
+{
+	a3_DemoShaderWatchFile* file;
+	a3ui64 changed = 0;
+	a3ui32 i;
+
+#ifdef __linux__
+	union {
+		struct inotify_event event[1];
+		a3byte raw[4096];
+	} buffer;
+	struct inotify_event const* event;
+	a3byte const* itr, * end;
+	ssize_t length;
+
+	if (watch && watch->notify >= 0)
+	{
+		// drain queued events; each names a file in a watched directory
+		while ((length = read(watch->notify, buffer.raw, sizeof(buffer.raw))) > 0)
+		{
+			for (itr = buffer.raw, end = itr + length; itr < end; itr += sizeof(struct inotify_event) + event->len)
+			{
+				event = (struct inotify_event const*)itr;
+				if (event->len)
+					for (i = 0, file = watch->file; i < watch->fileCount; ++i, ++file)
+						if (watch->directoryWatch[file->directory] == event->wd && !strcmp(file->path + file->nameOffset, event->name))
+						{
+							a3demo_shaderWatchInternalStamp(file);
+							changed |= file->dependents;
+						}
+			}
+		}
+		return changed;
+	}
+#endif	// __linux__
+
+	if (watch && watch->fileCount)
+	{
+		// poll file stamps at a fixed interval
+		watch->pollTime += dt;
+		if (watch->pollTime >= watch->pollInterval)
+		{
+			watch->pollTime = 0.0;
+			for (i = 0, file = watch->file; i < watch->fileCount; ++i, ++file)
+				if (a3demo_shaderWatchInternalStamp(file))
+					changed |= file->dependents;
+		}
+	}
+	return changed;
+}
+
+a3ret a3demo_shaderWatchRelease(a3_DemoShaderWatch* watch)
+{
+	if (watch)
+	{
+#ifdef __linux__
+		if (watch->notify >= 0)
+			close(watch->notify);
+#endif	// __linux__
+		return a3demo_shaderWatchInit(watch, watch->pollInterval);
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
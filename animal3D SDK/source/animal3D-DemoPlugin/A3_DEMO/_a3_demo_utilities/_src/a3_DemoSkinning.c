@@ -0,0 +1,520 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoSkinning.c
+	CPU skinning kernels and benchmark implementation.
+*/
+
+#include "../a3_DemoSkinning.h"
+#include "../a3_DemoMathBatch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// one vertex with blended matrix; bones without weight are skipped
+void a3demo_skinInternalLinearVertex(a3_DemoSkin const* skin, a3ui32 const i)
+{
+	a3f32 const* const w = skin->weight + i * 4;
+	a3i32 const* const b = skin->index + i * 4;
+	a3f32 const* const p = skin->position + i * 3;
+	a3f32 const* n, * m;
+	a3f32 c[12], * p_out, * n_out, len;
+	a3ui32 j, k;
+
+	// only the top three rows matter for rigid bones
+	for (m = skin->skinMatrix[b[0]].mm, k = 0; k < 4; ++k)
+	{
+		c[k * 3 + 0] = m[k * 4 + 0] * w[0];
+		c[k * 3 + 1] = m[k * 4 + 1] * w[0];
+		c[k * 3 + 2] = m[k * 4 + 2] * w[0];
+	}
+	for (j = 1; j < 4; ++j)
+		if (w[j] != 0.0f)
+			for (m = skin->skinMatrix[b[j]].mm, k = 0; k < 4; ++k)
+			{
+				c[k * 3 + 0] += m[k * 4 + 0] * w[j];
+				c[k * 3 + 1] += m[k * 4 + 1] * w[j];
+				c[k * 3 + 2] += m[k * 4 + 2] * w[j];
+			}
+
+	p_out = skin->position_out + i * 3;
+	p_out[0] = c[0] * p[0] + c[3] * p[1] + c[6] * p[2] + c[9];
+	p_out[1] = c[1] * p[0] + c[4] * p[1] + c[7] * p[2] + c[10];
+	p_out[2] = c[2] * p[0] + c[5] * p[1] + c[8] * p[2] + c[11];
+	if (skin->normal)
+	{
+		n = skin->normal + i * 3;
+		n_out = skin->normal_out + i * 3;
+		n_out[0] = c[0] * n[0] + c[3] * n[1] + c[6] * n[2];
+		n_out[1] = c[1] * n[0] + c[4] * n[1] + c[7] * n[2];
+		n_out[2] = c[2] * n[0] + c[5] * n[1] + c[8] * n[2];
+		len = n_out[0] * n_out[0] + n_out[1] * n_out[1] + n_out[2] * n_out[2];
+		len = len > 0.0f ? 1.0f / sqrtf(len) : 0.0f;
+		n_out[0] *= len;
+		n_out[1] *= len;
+		n_out[2] *= len;
+	}
+}
+
+// one vertex with blended dual quaternion; each bone's sign is matched to
+//	the first bone's so blending takes the short way around
+void a3demo_skinInternalDualQuatVertex(a3_DemoSkin const* skin, a3ui32 const i)
+{
+	a3f32 const* const w = skin->weight + i * 4;
+	a3i32 const* const b = skin->index + i * 4;
+	a3f32 const* const p = skin->position + i * 3;
+	a3f32 const* const q0 = skin->skinDualQuat[b[0]].QQ;
+	a3f32 const* n, * q;
+	a3f32 r[4], d[4], t[3], c[3], s, * p_out, * n_out;
+	a3ui32 j, k;
+
+	for (k = 0; k < 4; ++k)
+	{
+		r[k] = q0[k] * w[0];
+		d[k] = q0[k + 4] * w[0];
+	}
+	for (j = 1; j < 4; ++j)
+		if (w[j] != 0.0f)
+		{
+			q = skin->skinDualQuat[b[j]].QQ;
+			s = (q0[0] * q[0] + q0[1] * q[1] + q0[2] * q[2] + q0[3] * q[3]) < 0.0f ? -w[j] : w[j];
+			for (k = 0; k < 4; ++k)
+			{
+				r[k] += q[k] * s;
+				d[k] += q[k + 4] * s;
+			}
+		}
+
+	// normalize both parts by length of real part
+	s = 1.0f / sqrtf(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3]);
+	for (k = 0; k < 4; ++k)
+	{
+		r[k] *= s;
+		d[k] *= s;
+	}
+
+	// half translation: r.w d - d.w r + r x d
+	t[0] = r[3] * d[0] - d[3] * r[0] + r[1] * d[2] - r[2] * d[1];
+	t[1] = r[3] * d[1] - d[3] * r[1] + r[2] * d[0] - r[0] * d[2];
+	t[2] = r[3] * d[2] - d[3] * r[2] + r[0] * d[1] - r[1] * d[0];
+
+	// rotation: v + 2 r x (r x v + r.w v)
+	p_out = skin->position_out + i * 3;
+	c[0] = r[3] * p[0] + r[1] * p[2] - r[2] * p[1];
+	c[1] = r[3] * p[1] + r[2] * p[0] - r[0] * p[2];
+	c[2] = r[3] * p[2] + r[0] * p[1] - r[1] * p[0];
+	p_out[0] = p[0] + 2.0f * (t[0] + r[1] * c[2] - r[2] * c[1]);
+	p_out[1] = p[1] + 2.0f * (t[1] + r[2] * c[0] - r[0] * c[2]);
+	p_out[2] = p[2] + 2.0f * (t[2] + r[0] * c[1] - r[1] * c[0]);
+	if (skin->normal)
+	{
+		n = skin->normal + i * 3;
+		n_out = skin->normal_out + i * 3;
+		c[0] = r[3] * n[0] + r[1] * n[2] - r[2] * n[1];
+		c[1] = r[3] * n[1] + r[2] * n[0] - r[0] * n[2];
+		c[2] = r[3] * n[2] + r[0] * n[1] - r[1] * n[0];
+		n_out[0] = n[0] + 2.0f * (r[1] * c[2] - r[2] * c[1]);
+		n_out[1] = n[1] + 2.0f * (r[2] * c[0] - r[0] * c[2]);
+		n_out[2] = n[2] + 2.0f * (r[0] * c[1] - r[1] * c[0]);
+	}
+}
+
+
+#if (A3_SIMD != A3_SIMD_SCALAR)
+// cross product of vectors split into x, y and z registers
+inline void a3demo_skinInternalCross(a3simd4* x_out, a3simd4* y_out, a3simd4* z_out,
+	a3simd4 const ax, a3simd4 const ay, a3simd4 const az, a3simd4 const bx, a3simd4 const by, a3simd4 const bz)
+{
+	*x_out = a3simd4Sub(a3simd4Mul(ay, bz), a3simd4Mul(az, by));
+	*y_out = a3simd4Sub(a3simd4Mul(az, bx), a3simd4Mul(ax, bz));
+	*z_out = a3simd4Sub(a3simd4Mul(ax, by), a3simd4Mul(ay, bx));
+}
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+
+
+// arguments for dispatch
+typedef struct a3_DemoSkinDispatch				a3_DemoSkinDispatch;
+struct a3_DemoSkinDispatch
+{
+	a3_DemoSkin const* skin;
+	a3_DemoSkinMode mode;
+};
+
+void a3demo_skinInternalDispatch(a3_DemoSkinDispatch const* job, a3ui32 first, a3ui32 count)
+{
+	if (job->mode == demoSkin_dualQuat)
+		a3demo_skinDualQuat(job->skin, first, count);
+	else
+		a3demo_skinLinear(job->skin, first, count);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_skinInit(a3_DemoSkin* skin_out, a3_GeometryData const* geom)
+{
+	a3ubyte const* attribSize;
+	if (skin_out && geom && geom->attribData[a3attrib_geomPosition])
+	{
+		// float data only; quantized copies keep their blending elsewhere
+		attribSize = geom->vertexFormat->attribSize;
+		memset(skin_out, 0, sizeof(*skin_out));
+		if (!geom->attribData[a3attrib_geomBlending] || attribSize[a3attrib_position] != 12 ||
+			attribSize[a3attrib_blendWeights] != 16 || attribSize[a3attrib_blendIndices] != 16)
+			return 0;
+
+		// indices follow all weights
+		skin_out->position = (a3f32 const*)geom->attribData[a3attrib_geomPosition];
+		skin_out->weight = (a3f32 const*)geom->attribData[a3attrib_geomBlending];
+		skin_out->index = (a3i32 const*)(skin_out->weight + geom->numVertices * 4);
+		if (geom->attribData[a3attrib_geomNormal] && attribSize[a3attrib_normal] == 12)
+			skin_out->normal = (a3f32 const*)geom->attribData[a3attrib_geomNormal];
+		skin_out->vertexCount = geom->numVertices;
+		return 1;
+	}
+	return -1;
+}
+
+void a3demo_skinLinear(a3_DemoSkin const* skin, a3ui32 first, a3ui32 count)
+{
+	a3ui32 const end = first + count;
+	a3ui32 i = first;
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	a3simd4 const one = a3simd4Splat(1.0f);
+	a3simd4 c0, c1, c2, c3, s, len, pv[4], nv[4];
+	a3f32 const* w, * p, * n, * m;
+	a3i32 const* b;
+	a3ui32 j, k;
+
+	// blend each vertex's columns in lanes, then transpose four results so
+	//	they can be stored as packed vectors
+	for (; i + 4 <= end; i += 4)
+	{
+		for (j = 0; j < 4; ++j)
+		{
+			w = skin->weight + (i + j) * 4;
+			b = skin->index + (i + j) * 4;
+			m = skin->skinMatrix[b[0]].mm;
+			s = a3simd4Splat(w[0]);
+			c0 = a3simd4Mul(a3simd4Load(m), s);
+			c1 = a3simd4Mul(a3simd4Load(m + 4), s);
+			c2 = a3simd4Mul(a3simd4Load(m + 8), s);
+			c3 = a3simd4Mul(a3simd4Load(m + 12), s);
+			for (k = 1; k < 4; ++k)
+				if (w[k] != 0.0f)
+				{
+					m = skin->skinMatrix[b[k]].mm;
+					s = a3simd4Splat(w[k]);
+					c0 = a3simd4MulAdd(a3simd4Load(m), s, c0);
+					c1 = a3simd4MulAdd(a3simd4Load(m + 4), s, c1);
+					c2 = a3simd4MulAdd(a3simd4Load(m + 8), s, c2);
+					c3 = a3simd4MulAdd(a3simd4Load(m + 12), s, c3);
+				}
+			p = skin->position + (i + j) * 3;
+			pv[j] = a3simd4MulAdd(c0, a3simd4Splat(p[0]), a3simd4MulAdd(c1, a3simd4Splat(p[1]), a3simd4MulAdd(c2, a3simd4Splat(p[2]), c3)));
+			if (skin->normal)
+			{
+				n = skin->normal + (i + j) * 3;
+				nv[j] = a3simd4MulAdd(c0, a3simd4Splat(n[0]), a3simd4MulAdd(c1, a3simd4Splat(n[1]), a3simd4Mul(c2, a3simd4Splat(n[2]))));
+			}
+		}
+		a3simd4Transpose(pv[0], pv[1], pv[2], pv[3]);
+		a3simd4Store3x4(skin->position_out + i * 3, pv[0], pv[1], pv[2]);
+		if (skin->normal)
+		{
+			a3simd4Transpose(nv[0], nv[1], nv[2], nv[3]);
+			len = a3simd4Sqrt(a3simd4MulAdd(nv[0], nv[0], a3simd4MulAdd(nv[1], nv[1], a3simd4Mul(nv[2], nv[2]))));
+			len = a3simd4MaskPositive(a3simd4Div(one, len), len);
+			a3simd4Store3x4(skin->normal_out + i * 3, a3simd4Mul(nv[0], len), a3simd4Mul(nv[1], len), a3simd4Mul(nv[2], len));
+		}
+	}
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+	for (; i < end; ++i)
+		a3demo_skinInternalLinearVertex(skin, i);
+}
+
+void a3demo_skinDualQuat(a3_DemoSkin const* skin, a3ui32 first, a3ui32 count)
+{
+	a3ui32 const end = first + count;
+	a3ui32 i = first;
+#if (A3_SIMD != A3_SIMD_SCALAR)
+	a3simd4 const one = a3simd4Splat(1.0f), two = a3simd4Splat(2.0f);
+	a3simd4 r0, q, s, len, rv[4], dv[4], tx, ty, tz, cx, cy, cz, ex, ey, ez, vx, vy, vz;
+	a3f32 const* w;
+	a3i32 const* b;
+	a3ui32 j, k;
+
+	// blend each vertex's real and dual parts in lanes, then transpose four
+	//	vertices so the rest runs one vertex per lane
+	for (; i + 4 <= end; i += 4)
+	{
+		for (j = 0; j < 4; ++j)
+		{
+			w = skin->weight + (i + j) * 4;
+			b = skin->index + (i + j) * 4;
+			r0 = a3simd4Load(skin->skinDualQuat[b[0]].QQ);
+			s = a3simd4Splat(w[0]);
+			rv[j] = a3simd4Mul(r0, s);
+			dv[j] = a3simd4Mul(a3simd4Load(skin->skinDualQuat[b[0]].QQ + 4), s);
+			for (k = 1; k < 4; ++k)
+				if (w[k] != 0.0f)
+				{
+					q = a3simd4Load(skin->skinDualQuat[b[k]].QQ);
+					s = a3simd4Splat(a3simd4Dot(r0, q) < 0.0f ? -w[k] : w[k]);
+					rv[j] = a3simd4MulAdd(q, s, rv[j]);
+					dv[j] = a3simd4MulAdd(a3simd4Load(skin->skinDualQuat[b[k]].QQ + 4), s, dv[j]);
+				}
+		}
+		a3simd4Transpose(rv[0], rv[1], rv[2], rv[3]);
+		a3simd4Transpose(dv[0], dv[1], dv[2], dv[3]);
+		len = a3simd4Sqrt(a3simd4MulAdd(rv[0], rv[0], a3simd4MulAdd(rv[1], rv[1], a3simd4MulAdd(rv[2], rv[2], a3simd4Mul(rv[3], rv[3])))));
+		s = a3simd4Div(one, len);
+		for (k = 0; k < 4; ++k)
+		{
+			rv[k] = a3simd4Mul(rv[k], s);
+			dv[k] = a3simd4Mul(dv[k], s);
+		}
+
+		// half translation: r.w d - d.w r + r x d
+		a3demo_skinInternalCross(&tx, &ty, &tz, rv[0], rv[1], rv[2], dv[0], dv[1], dv[2]);
+		tx = a3simd4Add(tx, a3simd4Sub(a3simd4Mul(rv[3], dv[0]), a3simd4Mul(dv[3], rv[0])));
+		ty = a3simd4Add(ty, a3simd4Sub(a3simd4Mul(rv[3], dv[1]), a3simd4Mul(dv[3], rv[1])));
+		tz = a3simd4Add(tz, a3simd4Sub(a3simd4Mul(rv[3], dv[2]), a3simd4Mul(dv[3], rv[2])));
+
+		// rotation: v + 2 r x (r x v + r.w v)
+		a3simd4Load3x4(skin->position + i * 3, vx, vy, vz);
+		a3demo_skinInternalCross(&cx, &cy, &cz, rv[0], rv[1], rv[2], vx, vy, vz);
+		cx = a3simd4MulAdd(rv[3], vx, cx);
+		cy = a3simd4MulAdd(rv[3], vy, cy);
+		cz = a3simd4MulAdd(rv[3], vz, cz);
+		a3demo_skinInternalCross(&ex, &ey, &ez, rv[0], rv[1], rv[2], cx, cy, cz);
+		a3simd4Store3x4(skin->position_out + i * 3,
+			a3simd4MulAdd(two, a3simd4Add(tx, ex), vx),
+			a3simd4MulAdd(two, a3simd4Add(ty, ey), vy),
+			a3simd4MulAdd(two, a3simd4Add(tz, ez), vz));
+		if (skin->normal)
+		{
+			a3simd4Load3x4(skin->normal + i * 3, vx, vy, vz);
+			a3demo_skinInternalCross(&cx, &cy, &cz, rv[0], rv[1], rv[2], vx, vy, vz);
+			cx = a3simd4MulAdd(rv[3], vx, cx);
+			cy = a3simd4MulAdd(rv[3], vy, cy);
+			cz = a3simd4MulAdd(rv[3], vz, cz);
+			a3demo_skinInternalCross(&ex, &ey, &ez, rv[0], rv[1], rv[2], cx, cy, cz);
+			a3simd4Store3x4(skin->normal_out + i * 3,
+				a3simd4MulAdd(two, ex, vx),
+				a3simd4MulAdd(two, ey, vy),
+				a3simd4MulAdd(two, ez, vz));
+		}
+	}
+#endif	// (A3_SIMD != A3_SIMD_SCALAR)
+	for (; i < end; ++i)
+		a3demo_skinInternalDualQuatVertex(skin, i);
+}
+
+a3ret a3demo_skin(a3_DemoSkin const* skin, a3_DemoSkinMode const mode, a3_DemoWorkerPool* pool, a3ui32 threadCount)
+{
+	a3_DemoSkinDispatch job[1];
+	if (skin)
+	{
+		job->skin = skin;
+		job->mode = mode;
+		return a3demo_mathBatchDispatch((a3_DemoMathBatchFunc)a3demo_skinInternalDispatch, job, skin->vertexCount, pool, threadCount);
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// uniform random float in [-1, 1]
+inline a3f32 a3demo_skinInternalRandom()
+{
+	return ((a3f32)rand() / (a3f32)RAND_MAX * 2.0f - 1.0f);
+}
+
+// largest difference between skinned positions and normals
+inline a3f64 a3demo_skinInternalDiff(a3f32 const* a, a3f32 const* b, a3ui32 count)
+{
+	a3f64 diff = 0.0, d;
+	a3ui32 i;
+	for (i = 0; i < count; ++i)
+	{
+		d = fabs((a3f64)a[i] - (a3f64)b[i]);
+		if (d > diff)
+			diff = d;
+	}
+	return diff;
+}
+
+// time one kernel on each thread count, print vertices per second overall
+//	and per thread
+void a3demo_skinInternalTime(a3byte const* name, a3_DemoSkin const* skin, a3_DemoSkinMode const mode, a3_DemoWorkerPool* pool,
+	a3ui32 const passCount, a3f32 const* itemResult)
+{
+	a3_Timer timer[1] = { 0 };
+	a3_DemoSkin job[1] = { *skin };
+	a3f64 const items = (a3f64)skin->vertexCount * (a3f64)passCount * 1.0e-6;
+	a3f64 rate;
+	a3ui32 threadCount, pass;
+
+	printf("\n  %-16s", name);
+	for (threadCount = 1; threadCount <= demoMathSize_thread; threadCount *= 2)
+	{
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			a3demo_skin(job, mode, pool, threadCount);
+		a3timerStop(timer);
+		rate = timer->currentTick > 0.0 ? items / timer->currentTick : 0.0;
+		printf(" | x%u %7.2lf M/s (%6.2lf)", threadCount, rate, rate / (a3f64)threadCount);
+	}
+	printf(" | max diff %.3e", a3demo_skinInternalDiff(itemResult, skin->position_out, skin->vertexCount * 6));
+}
+
+a3ret a3demo_skinReport(a3ui32 vertexCount, a3ui32 boneCount, a3ui32 passCount, a3_DemoWorkerPool* pool)
+{
+	a3_Timer timer[1] = { 0 };
+	a3_DemoSkin skin[1];
+	a3mat4* skinMatrix, blend, term;
+	a3dualquat* skinDualQuat, blendQ, termQ;
+	a3real4 axis, point, point_out;
+	a3f32* position, * weight, * itemResult, * result, sum;
+	a3i32* index;
+	a3byte* block;
+	a3size size;
+	a3f64 items;
+	a3ui32 i, j, pass;
+
+	if (vertexCount && boneCount && passCount)
+	{
+		// normals follow positions in each array
+		size = vertexCount * (sizeof(a3f32) * (6 + 4 + 6 + 6) + sizeof(a3i32) * 4) + boneCount * (sizeof(a3mat4) + sizeof(a3dualquat)) + 15;
+		block = (a3byte*)malloc(size);
+		if (!block)
+			return 0;
+		memset(block, 0, size);
+		skinMatrix = (a3mat4*)(((a3address)block + 15) & ~(a3address)15);
+		skinDualQuat = (a3dualquat*)(skinMatrix + boneCount);
+		position = (a3f32*)(skinDualQuat + boneCount);
+		weight = position + vertexCount * 6;
+		itemResult = weight + vertexCount * 4;
+		result = itemResult + vertexCount * 6;
+		index = (a3i32*)(result + vertexCount * 6);
+
+		// rigid bones, as dual quaternions and the matching matrices
+		for (i = 0; i < boneCount; ++i)
+		{
+			a3real3Set(axis, a3demo_skinInternalRandom(), a3demo_skinInternalRandom(), a3demo_skinInternalRandom() + a3real_two);
+			a3real3Normalize(axis);
+			a3real3Set(point, a3demo_skinInternalRandom(), a3demo_skinInternalRandom(), a3demo_skinInternalRandom());
+			a3dualquatSetAxisAngleTranslate(skinDualQuat[i].Q, axis, a3demo_skinInternalRandom() * (a3real)90.0, point);
+			a3dualquatConvertToMat4IgnoreScale(skinMatrix[i].m, skinDualQuat[i].Q);
+		}
+
+		// vertices with one to four bones, weights summing to one
+		for (i = 0; i < vertexCount; ++i)
+		{
+			a3real3Set(position + i * 3, a3demo_skinInternalRandom(), a3demo_skinInternalRandom(), a3demo_skinInternalRandom());
+			a3real3Set(position + (vertexCount + i) * 3, a3demo_skinInternalRandom(), a3demo_skinInternalRandom(), a3demo_skinInternalRandom() + a3real_two);
+			a3real3Normalize(position + (vertexCount + i) * 3);
+			for (j = 0, sum = 0.0f; j < 4; ++j)
+			{
+				index[i * 4 + j] = rand() % boneCount;
+				weight[i * 4 + j] = (j == 0 || rand() % 3) ? a3demo_skinInternalRandom() + 1.5f : 0.0f;
+				sum += weight[i * 4 + j];
+			}
+			for (j = 0; j < 4; ++j)
+				weight[i * 4 + j] /= sum;
+		}
+
+		memset(skin, 0, sizeof(*skin));
+		skin->position = position;
+		skin->normal = position + vertexCount * 3;
+		skin->weight = weight;
+		skin->index = index;
+		skin->skinMatrix = skinMatrix;
+		skin->skinDualQuat = skinDualQuat;
+		skin->position_out = result;
+		skin->normal_out = result + vertexCount * 3;
+		skin->vertexCount = vertexCount;
+		items = (a3f64)vertexCount * (a3f64)passCount * 1.0e-6;
+
+		printf("\n\n  skinning: %s (%u vertices, %u bones, %u passes; M vertices/s, per thread in parentheses)", A3_SIMD_NAME, vertexCount, boneCount, passCount);
+
+		// linear blend per vertex with A3DM matrix functions
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < vertexCount; ++i)
+			{
+				a3real4x4ProductS(blend.m, skinMatrix[index[i * 4]].m, weight[i * 4]);
+				for (j = 1; j < 4; ++j)
+					if (weight[i * 4 + j] != 0.0f)
+						a3real4x4Add(blend.m, a3real4x4ProductS(term.m, skinMatrix[index[i * 4 + j]].m, weight[i * 4 + j]));
+				a3real4SetReal3W(point, position + i * 3, a3real_one);
+				a3real4Real4x4Product(point_out, blend.m, point);
+				a3real3SetReal4(itemResult + i * 3, point_out);
+				a3real4SetReal3W(point, position + (vertexCount + i) * 3, a3real_zero);
+				a3real4Real4x4Product(point_out, blend.m, point);
+				a3real3GetUnit(itemResult + (vertexCount + i) * 3, point_out);
+			}
+		a3timerStop(timer);
+		printf("\n  %-16s | x1 %7.2lf M/s", "LBS per vertex:", timer->currentTick > 0.0 ? items / timer->currentTick : 0.0);
+
+		a3demo_skinInternalTime("LBS batch:", skin, demoSkin_linear, pool, passCount, itemResult);
+
+		// dual quaternion blend per vertex with A3DM dual quaternion functions
+		a3timerStart(timer);
+		for (pass = 0; pass < passCount; ++pass)
+			for (i = 0; i < vertexCount; ++i)
+			{
+				a3dualquatProductS(blendQ.Q, skinDualQuat[index[i * 4]].Q, weight[i * 4]);
+				for (j = 1; j < 4; ++j)
+					if (weight[i * 4 + j] != 0.0f)
+					{
+						a3dualquatProductS(termQ.Q, skinDualQuat[index[i * 4 + j]].Q,
+							a3real4Dot(skinDualQuat[index[i * 4]].QQ, skinDualQuat[index[i * 4 + j]].QQ) < a3real_zero ? -weight[i * 4 + j] : weight[i * 4 + j]);
+						a3dualquatAdd(blendQ.Q, termQ.Q);
+					}
+				a3dualquatNormalize(blendQ.Q);
+				a3dualquatVec3GetTransformedIgnoreScale(itemResult + i * 3, position + i * 3, blendQ.Q);
+				a3dualquatVec3GetTransformedIgnoreScale(point, position + (vertexCount + i) * 3, blendQ.Q);
+				a3real3Set(point_out, a3real_zero, a3real_zero, a3real_zero);
+				a3dualquatVec3GetTransformedIgnoreScale(axis, point_out, blendQ.Q);
+				a3real3Diff(itemResult + (vertexCount + i) * 3, point, axis);
+			}
+		a3timerStop(timer);
+		printf("\n  %-16s | x1 %7.2lf M/s", "DQS per vertex:", timer->currentTick > 0.0 ? items / timer->currentTick : 0.0);
+
+		a3demo_skinInternalTime("DQS batch:", skin, demoSkin_dualQuat, pool, passCount, itemResult);
+
+		printf("\n");
+		free(block);
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,642 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoTextureCompress.c
+	Block-compression encoder implementation.
+*/
+
+#include "../a3_DemoTextureCompress.h"
+
+#include "animal3D-A3DM/a3math/a3simd.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// integer SSE2 paths follow the instruction set selected for math, which
+//	includes the intrinsics header; every x86 level has SSE2
+#if (A3_SIMD == A3_SIMD_SSE2 || A3_SIMD == A3_SIMD_SSE41 || A3_SIMD == A3_SIMD_AVX2)
+#define A3_DEMO_TEXTURE_COMPRESS_SSE2
+#endif	// (A3_SIMD == A3_SIMD_SSE2 || A3_SIMD == A3_SIMD_SSE41 || A3_SIMD == A3_SIMD_AVX2)
+
+
+//-----------------------------------------------------------------------------
+
+// range of rows compressed by one task
+typedef struct a3_TAG_DEMOTEXTURECOMPRESSJOB {
+	void* blocks;
+	a3_TexturePixelType compressedType;
+	a3ubyte const* pixels;
+	a3ui32 width, height, channels;
+	a3ui32 blockRowStart, blockRowEnd;
+} a3_DemoTextureCompressJob;
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// bytes per 4x4 block
+inline a3ui32 a3demo_textureCompressInternalBlockSize(a3_TexturePixelType const compressedType)
+{
+	switch (compressedType)
+	{
+	case a3tex_bc1:
+	case a3tex_bc4:
+		return 8;
+	case a3tex_bc3:
+	case a3tex_bc5:
+		return 16;
+	default:
+		return 0;
+	}
+}
+
+// gather a 4x4 block as rgba; pixels past the edges repeat the last
+//	row or column, missing color channels are zero and alpha is opaque
+inline void a3demo_textureCompressInternalFetch(a3ubyte block_out[16][4], a3ubyte const* pixels, a3ui32 const width, a3ui32 const height, a3ui32 const channels, a3ui32 const blockX, a3ui32 const blockY)
+{
+	a3ubyte const* src;
+	a3ui32 x, y, c, px, py;
+	for (y = 0; y < 4; ++y)
+	{
+		py = (blockY << 2) + y;
+		py = (py < height) ? py : (height - 1);
+		for (x = 0; x < 4; ++x)
+		{
+			px = (blockX << 2) + x;
+			px = (px < width) ? px : (width - 1);
+			src = pixels + (py * width + px) * channels;
+			for (c = 0; c < channels; ++c)
+				block_out[(y << 2) + x][c] = src[c];
+			for (; c < 4; ++c)
+				block_out[(y << 2) + x][c] = (c < 3) ? 0 : 255;
+		}
+	}
+}
+
+// quantize color to 5:6:5
+inline a3ui16 a3demo_textureCompressInternalPack565(a3ubyte const color[4])
+{
+	return (a3ui16)((((color[0] * 31 + 127) / 255) << 11) | (((color[1] * 63 + 127) / 255) << 5) | ((color[2] * 31 + 127) / 255));
+}
+
+// expand 5:6:5 color to 8 bits per channel
+inline void a3demo_textureCompressInternalUnpack565(a3ubyte color_out[4], a3ui16 const color)
+{
+	a3ui32 const r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+	color_out[0] = (a3ubyte)((r << 3) | (r >> 2));
+	color_out[1] = (a3ubyte)((g << 2) | (g >> 4));
+	color_out[2] = (a3ubyte)((b << 3) | (b >> 2));
+	color_out[3] = 255;
+}
+
+// encode color block (BC1 layout, always 4-color mode)
+inline void a3demo_textureCompressInternalEncodeColor(a3ubyte* block_out, a3ubyte const block[16][4])
+{
+	// end point index of each step along the axis from first to second
+	static a3ubyte const indexMap[4] = { 0, 2, 3, 1 };
+	a3ubyte lo[4], hi[4], e0[4], e1[4], swap;
+	a3i32 d[3], centre[3], cov[2] = { 0 }, inset, t[16];
+	a3f32 scale;
+	a3ui16 c0, c1, c;
+	a3ui32 i, indices = 0;
+
+	// bounding box of colors
+#ifdef A3_DEMO_TEXTURE_COMPRESS_SSE2
+	__m128i const p0 = _mm_loadu_si128((__m128i const*)block[0]), p1 = _mm_loadu_si128((__m128i const*)block[4]),
+		p2 = _mm_loadu_si128((__m128i const*)block[8]), p3 = _mm_loadu_si128((__m128i const*)block[12]);
+	__m128i mn = _mm_min_epu8(_mm_min_epu8(p0, p1), _mm_min_epu8(p2, p3)), mx = _mm_max_epu8(_mm_max_epu8(p0, p1), _mm_max_epu8(p2, p3));
+	a3i32 packed;
+	mn = _mm_min_epu8(mn, _mm_shuffle_epi32(mn, _MM_SHUFFLE(2, 3, 0, 1)));
+	mn = _mm_min_epu8(mn, _mm_shuffle_epi32(mn, _MM_SHUFFLE(1, 0, 3, 2)));
+	mx = _mm_max_epu8(mx, _mm_shuffle_epi32(mx, _MM_SHUFFLE(2, 3, 0, 1)));
+	mx = _mm_max_epu8(mx, _mm_shuffle_epi32(mx, _MM_SHUFFLE(1, 0, 3, 2)));
+	packed = _mm_cvtsi128_si32(mn);
+	memcpy(lo, &packed, sizeof(lo));
+	packed = _mm_cvtsi128_si32(mx);
+	memcpy(hi, &packed, sizeof(hi));
+#else	// !A3_DEMO_TEXTURE_COMPRESS_SSE2
+	memcpy(lo, block[0], sizeof(lo));
+	memcpy(hi, block[0], sizeof(hi));
+	for (i = 1; i < 16; ++i)
+		for (c = 0; c < 3; ++c)
+		{
+			lo[c] = (block[i][c] < lo[c]) ? block[i][c] : lo[c];
+			hi[c] = (block[i][c] > hi[c]) ? block[i][c] : hi[c];
+		}
+#endif	// A3_DEMO_TEXTURE_COMPRESS_SSE2
+
+	// colors lie along one diagonal of the box: flip red and blue extents
+	//	if they vary against green
+	for (i = 0; i < 3; ++i)
+		centre[i] = (lo[i] + hi[i] + 1) >> 1;
+	for (i = 0; i < 16; ++i)
+	{
+		cov[0] += (block[i][0] - centre[0]) * (block[i][1] - centre[1]);
+		cov[1] += (block[i][2] - centre[2]) * (block[i][1] - centre[1]);
+	}
+	if (cov[0] < 0)
+	{
+		swap = lo[0];
+		lo[0] = hi[0];
+		hi[0] = swap;
+	}
+	if (cov[1] < 0)
+	{
+		swap = lo[2];
+		lo[2] = hi[2];
+		hi[2] = swap;
+	}
+
+	// pull end points in slightly so they are not spent on outliers
+	for (i = 0; i < 3; ++i)
+	{
+		inset = ((a3i32)hi[i] - (a3i32)lo[i]) / 16;
+		lo[i] = (a3ubyte)(lo[i] + inset);
+		hi[i] = (a3ubyte)(hi[i] - inset);
+	}
+
+	// first end point must be greater for 4-color mode
+	c0 = a3demo_textureCompressInternalPack565(hi);
+	c1 = a3demo_textureCompressInternalPack565(lo);
+	if (c0 < c1)
+	{
+		c = c0;
+		c0 = c1;
+		c1 = c;
+	}
+	a3demo_textureCompressInternalUnpack565(e0, c0);
+	a3demo_textureCompressInternalUnpack565(e1, c1);
+
+	if (c0 != c1)
+	{
+		// project each color onto the axis between end points: 0 at the
+		//	first, 3 at the second, then round to the nearest step
+		d[0] = e1[0] - e0[0];
+		d[1] = e1[1] - e0[1];
+		d[2] = e1[2] - e0[2];
+		scale = 3.0f / (a3f32)(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+#ifdef A3_DEMO_TEXTURE_COMPRESS_SSE2
+		{
+			__m128i const zero = _mm_setzero_si128();
+			__m128i const base = _mm_set_epi16(0, e0[2], e0[1], e0[0], 0, e0[2], e0[1], e0[0]);
+			__m128i const axis = _mm_set_epi16(0, (a3i16)d[2], (a3i16)d[1], (a3i16)d[0], 0, (a3i16)d[2], (a3i16)d[1], (a3i16)d[0]);
+			__m128 const s = _mm_set1_ps(scale), half = _mm_set1_ps(0.5f), limit = _mm_set1_ps(3.0f), zerof = _mm_setzero_ps();
+			__m128i p, dotLo, dotHi, dot;
+			__m128 f;
+			for (i = 0; i < 16; i += 4)
+			{
+				// two pixels per register as 16-bit channels; multiply-add
+				//	leaves red+green and blue+alpha sums for each pixel
+				p = _mm_loadu_si128((__m128i const*)block[i]);
+				dotLo = _mm_madd_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(p, zero), base), axis);
+				dotHi = _mm_madd_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(p, zero), base), axis);
+				dot = _mm_add_epi32(
+					_mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(dotLo), _mm_castsi128_ps(dotHi), _MM_SHUFFLE(2, 0, 2, 0))),
+					_mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(dotLo), _mm_castsi128_ps(dotHi), _MM_SHUFFLE(3, 1, 3, 1))));
+				f = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(dot), s), half);
+				f = _mm_min_ps(_mm_max_ps(f, zerof), limit);
+				_mm_storeu_si128((__m128i*)(t + i), _mm_cvttps_epi32(f));
+			}
+		}
+#else	// !A3_DEMO_TEXTURE_COMPRESS_SSE2
+		for (i = 0; i < 16; ++i)
+		{
+			a3f32 const f = (a3f32)((block[i][0] - e0[0]) * d[0] + (block[i][1] - e0[1]) * d[1] + (block[i][2] - e0[2]) * d[2]) * scale + 0.5f;
+			t[i] = (f > 0.0f) ? (f < 3.0f) ? (a3i32)f : 3 : 0;
+		}
+#endif	// A3_DEMO_TEXTURE_COMPRESS_SSE2
+		for (i = 0; i < 16; ++i)
+			indices |= (a3ui32)indexMap[t[i]] << (i << 1);
+	}
+
+	// little-endian end points then indices
+	block_out[0] = (a3ubyte)(c0);
+	block_out[1] = (a3ubyte)(c0 >> 8);
+	block_out[2] = (a3ubyte)(c1);
+	block_out[3] = (a3ubyte)(c1 >> 8);
+	block_out[4] = (a3ubyte)(indices);
+	block_out[5] = (a3ubyte)(indices >> 8);
+	block_out[6] = (a3ubyte)(indices >> 16);
+	block_out[7] = (a3ubyte)(indices >> 24);
+}
+
+// encode one channel of a block (BC4 layout, always 8-value mode)
+inline void a3demo_textureCompressInternalEncodeSingle(a3ubyte* block_out, a3ubyte const block[16][4], a3ui32 const channel)
+{
+	// end point index of each step from maximum to minimum
+	static a3ubyte const indexMap[8] = { 0, 2, 3, 4, 5, 6, 7, 1 };
+	a3ubyte v[16];
+	a3ui32 i, a0, a1;
+	a3i32 t[16];
+	a3ui64 indices = 0;
+
+	for (i = 0; i < 16; ++i)
+		v[i] = block[i][channel];
+
+#ifdef A3_DEMO_TEXTURE_COMPRESS_SSE2
+	{
+		__m128i const zero = _mm_setzero_si128(), values = _mm_loadu_si128((__m128i const*)v);
+		__m128i mn = values, mx = values, top, lo, hi;
+		__m128 const half = _mm_set1_ps(0.5f), limit = _mm_set1_ps(7.0f);
+		__m128 s;
+
+		// range of values
+		mn = _mm_min_epu8(mn, _mm_srli_si128(mn, 8));
+		mn = _mm_min_epu8(mn, _mm_srli_si128(mn, 4));
+		mn = _mm_min_epu8(mn, _mm_srli_si128(mn, 2));
+		mn = _mm_min_epu8(mn, _mm_srli_si128(mn, 1));
+		mx = _mm_max_epu8(mx, _mm_srli_si128(mx, 8));
+		mx = _mm_max_epu8(mx, _mm_srli_si128(mx, 4));
+		mx = _mm_max_epu8(mx, _mm_srli_si128(mx, 2));
+		mx = _mm_max_epu8(mx, _mm_srli_si128(mx, 1));
+		a1 = (a3ui32)_mm_cvtsi128_si32(mn) & 0xff;
+		a0 = (a3ui32)_mm_cvtsi128_si32(mx) & 0xff;
+
+		// steps down from maximum, 8 values per register as 16-bit, then
+		//	4 per register as float to scale and round
+		if (a0 > a1)
+		{
+			s = _mm_set1_ps(7.0f / (a3f32)(a0 - a1));
+			top = _mm_set1_epi16((a3i16)a0);
+			lo = _mm_sub_epi16(top, _mm_unpacklo_epi8(values, zero));
+			hi = _mm_sub_epi16(top, _mm_unpackhi_epi8(values, zero));
+			_mm_storeu_si128((__m128i*)(t + 0), _mm_cvttps_epi32(_mm_min_ps(_mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), s), half), limit)));
+			_mm_storeu_si128((__m128i*)(t + 4), _mm_cvttps_epi32(_mm_min_ps(_mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), s), half), limit)));
+			_mm_storeu_si128((__m128i*)(t + 8), _mm_cvttps_epi32(_mm_min_ps(_mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), s), half), limit)));
+			_mm_storeu_si128((__m128i*)(t + 12), _mm_cvttps_epi32(_mm_min_ps(_mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), s), half), limit)));
+		}
+	}
+#else	// !A3_DEMO_TEXTURE_COMPRESS_SSE2
+	a0 = a1 = v[0];
+	for (i = 1; i < 16; ++i)
+	{
+		a1 = (v[i] < a1) ? v[i] : a1;
+		a0 = (v[i] > a0) ? v[i] : a0;
+	}
+	if (a0 > a1)
+		for (i = 0; i < 16; ++i)
+		{
+			a3f32 const f = (a3f32)(a0 - v[i]) * 7.0f / (a3f32)(a0 - a1) + 0.5f;
+			t[i] = (f < 7.0f) ? (a3i32)f : 7;
+		}
+#endif	// A3_DEMO_TEXTURE_COMPRESS_SSE2
+
+	if (a0 > a1)
+		for (i = 0; i < 16; ++i)
+			indices |= (a3ui64)indexMap[t[i]] << (i * 3);
+
+	// end points then 48 bits of indices
+	block_out[0] = (a3ubyte)a0;
+	block_out[1] = (a3ubyte)a1;
+	for (i = 0; i < 6; ++i)
+		block_out[2 + i] = (a3ubyte)(indices >> (i << 3));
+}
+
+// decode color block (BC1 layout)
+inline void a3demo_textureCompressInternalDecodeColor(a3ubyte block_out[16][4], a3ubyte const* block)
+{
+	a3ubyte palette[4][4];
+	a3ui16 const c0 = (a3ui16)(block[0] | (block[1] << 8)), c1 = (a3ui16)(block[2] | (block[3] << 8));
+	a3ui32 const indices = (a3ui32)block[4] | ((a3ui32)block[5] << 8) | ((a3ui32)block[6] << 16) | ((a3ui32)block[7] << 24);
+	a3ui32 i, c;
+
+	a3demo_textureCompressInternalUnpack565(palette[0], c0);
+	a3demo_textureCompressInternalUnpack565(palette[1], c1);
+	for (c = 0; c < 3; ++c)
+	{
+		if (c0 > c1)
+		{
+			palette[2][c] = (a3ubyte)((palette[0][c] * 2 + palette[1][c] + 1) / 3);
+			palette[3][c] = (a3ubyte)((palette[0][c] + palette[1][c] * 2 + 1) / 3);
+		}
+		else
+		{
+			palette[2][c] = (a3ubyte)((palette[0][c] + palette[1][c] + 1) >> 1);
+			palette[3][c] = 0;
+		}
+	}
+	for (i = 0; i < 16; ++i)
+		memcpy(block_out[i], palette[(indices >> (i << 1)) & 3], 3);
+}
+
+// decode one channel of a block (BC4 layout)
+inline void a3demo_textureCompressInternalDecodeSingle(a3ubyte block_out[16][4], a3ubyte const* block, a3ui32 const channel)
+{
+	a3ubyte palette[8];
+	a3ui32 const a0 = block[0], a1 = block[1];
+	a3ui64 indices = 0;
+	a3ui32 i;
+
+	palette[0] = (a3ubyte)a0;
+	palette[1] = (a3ubyte)a1;
+	if (a0 > a1)
+		for (i = 1; i < 7; ++i)
+			palette[i + 1] = (a3ubyte)(((7 - i) * a0 + i * a1 + 3) / 7);
+	else
+	{
+		for (i = 1; i < 5; ++i)
+			palette[i + 1] = (a3ubyte)(((5 - i) * a0 + i * a1 + 2) / 5);
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+	for (i = 0; i < 6; ++i)
+		indices |= (a3ui64)block[2 + i] << (i << 3);
+	for (i = 0; i < 16; ++i)
+		block_out[i][channel] = palette[(indices >> (i * 3)) & 7];
+}
+
+// worker task for one share of rows
+void a3demo_textureCompressInternalTask(void* args, a3ui32 index)
+{
+	a3_DemoTextureCompressJob const* const job = (a3_DemoTextureCompressJob const*)args + index;
+	a3demo_textureCompressRows(job->blocks, job->compressedType, job->pixels,
+		job->width, job->height, job->channels, job->blockRowStart, job->blockRowEnd);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_textureCompressType(a3_DemoTextureCompression const compression, a3ui32 const channels)
+{
+	switch (compression)
+	{
+	case demoTextureCompression_color:
+		return (channels >= 4) ? a3tex_bc3 : a3tex_bc1;
+	case demoTextureCompression_single:
+		return a3tex_bc4;
+	case demoTextureCompression_normal:
+		return a3tex_bc5;
+	default:
+		return -1;
+	}
+}
+
+a3ui32 a3demo_textureCompressChannels(a3_TexturePixelType const compressedType)
+{
+	switch (compressedType)
+	{
+	case a3tex_bc1:
+		return 3;
+	case a3tex_bc3:
+		return 4;
+	case a3tex_bc4:
+		return 1;
+	case a3tex_bc5:
+		return 2;
+	default:
+		return 0;
+	}
+}
+
+a3ui32 a3demo_textureCompressSize(a3_TexturePixelType const compressedType, a3ui32 const width, a3ui32 const height)
+{
+	return ((width + 3) >> 2) * ((height + 3) >> 2) * a3demo_textureCompressInternalBlockSize(compressedType);
+}
+
+a3ret a3demo_textureCompressRows(void* blocks_out, a3_TexturePixelType const compressedType, a3ubyte const* pixels,
+	a3ui32 const width, a3ui32 const height, a3ui32 const channels, a3ui32 const blockRowStart, a3ui32 const blockRowEnd)
+{
+	a3ubyte block[16][4];
+	a3ubyte* out;
+	a3ui32 const blockSize = a3demo_textureCompressInternalBlockSize(compressedType);
+	a3ui32 const blocksX = (width + 3) >> 2, blocksY = (height + 3) >> 2;
+	a3ui32 const rowEnd = (blockRowEnd < blocksY) ? blockRowEnd : blocksY;
+	a3ui32 x, y;
+
+	if (blocks_out && pixels && blockSize && width && height && channels && channels <= 4)
+	{
+		out = (a3ubyte*)blocks_out + blockRowStart * blocksX * blockSize;
+		for (y = blockRowStart; y < rowEnd; ++y)
+			for (x = 0; x < blocksX; ++x, out += blockSize)
+			{
+				a3demo_textureCompressInternalFetch(block, pixels, width, height, channels, x, y);
+				switch (compressedType)
+				{
+				case a3tex_bc1:
+					a3demo_textureCompressInternalEncodeColor(out, block);
+					break;
+				case a3tex_bc3:
+					a3demo_textureCompressInternalEncodeSingle(out, block, 3);
+					a3demo_textureCompressInternalEncodeColor(out + 8, block);
+					break;
+				case a3tex_bc4:
+					a3demo_textureCompressInternalEncodeSingle(out, block, 0);
+					break;
+				case a3tex_bc5:
+					a3demo_textureCompressInternalEncodeSingle(out, block, 0);
+					a3demo_textureCompressInternalEncodeSingle(out + 8, block, 1);
+					break;
+				default:
+					break;
+				}
+			}
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3demo_textureCompress(void* blocks_out, a3_TexturePixelType const compressedType, a3ubyte const* pixels,
+	a3ui32 const width, a3ui32 const height, a3ui32 const channels, a3_DemoWorkerPool* pool, a3ui32 const threadCount)
+{
+	a3_DemoTextureCompressJob job[demoTextureCompressMaxCount_thread];
+	a3ui32 const blockRows = (height + 3) >> 2;
+	a3ui32 i, count;
+
+	if (blocks_out && pixels && a3demo_textureCompressInternalBlockSize(compressedType) && width && height && channels && channels <= 4)
+	{
+		// split rows evenly into one share per thread
+		count = (threadCount > 1) ? threadCount : 1;
+		count = (count < demoTextureCompressMaxCount_thread) ? count : demoTextureCompressMaxCount_thread;
+		count = (count < blockRows) ? count : blockRows;
+		for (i = 0; i < count; ++i)
+		{
+			job[i].blocks = blocks_out;
+			job[i].compressedType = compressedType;
+			job[i].pixels = pixels;
+			job[i].width = width;
+			job[i].height = height;
+			job[i].channels = channels;
+			job[i].blockRowStart = blockRows * i / count;
+			job[i].blockRowEnd = blockRows * (i + 1) / count;
+		}
+		a3demo_workerPoolRun(pool, a3demo_textureCompressInternalTask, job, count);
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3demo_textureDecompress(a3ubyte* pixels_inout, a3ui32 const channels, a3_TexturePixelType const compressedType,
+	void const* blocks, a3ui32 const width, a3ui32 const height)
+{
+	a3ubyte block[16][4];
+	a3ubyte* dst;
+	a3ubyte const* in = (a3ubyte const*)blocks;
+	a3ui32 const blockSize = a3demo_textureCompressInternalBlockSize(compressedType);
+	a3ui32 const stored = a3demo_textureCompressChannels(compressedType);
+	a3ui32 const written = (stored < channels) ? stored : channels;
+	a3ui32 const blocksX = (width + 3) >> 2, blocksY = (height + 3) >> 2;
+	a3ui32 x, y, i, px, py;
+
+	if (pixels_inout && blocks && blockSize && width && height && channels && channels <= 4)
+	{
+		for (y = 0; y < blocksY; ++y)
+			for (x = 0; x < blocksX; ++x, in += blockSize)
+			{
+				switch (compressedType)
+				{
+				case a3tex_bc1:
+					a3demo_textureCompressInternalDecodeColor(block, in);
+					break;
+				case a3tex_bc3:
+					a3demo_textureCompressInternalDecodeSingle(block, in, 3);
+					a3demo_textureCompressInternalDecodeColor(block, in + 8);
+					break;
+				case a3tex_bc4:
+					a3demo_textureCompressInternalDecodeSingle(block, in, 0);
+					break;
+				case a3tex_bc5:
+					a3demo_textureCompressInternalDecodeSingle(block, in, 0);
+					a3demo_textureCompressInternalDecodeSingle(block, in + 8, 1);
+					break;
+				default:
+					break;
+				}
+
+				// write pixels inside the image
+				for (i = 0; i < 16; ++i)
+				{
+					px = (x << 2) + (i & 3);
+					py = (y << 2) + (i >> 2);
+					if (px < width && py < height)
+					{
+						dst = pixels_inout + (py * width + px) * channels;
+						memcpy(dst, block[i], written);
+					}
+				}
+			}
+		return 1;
+	}
+	return -1;
+}
+
+a3f64 a3demo_texturePSNR(a3ubyte const* pixels, a3ubyte const* reference, a3ui32 const width, a3ui32 const height,
+	a3ui32 const channels, a3ui32 const channelsCompared)
+{
+	a3f64 error = 0.0, diff;
+	a3ui32 const count = width * height;
+	a3ui32 i, c;
+
+	if (pixels && reference && count && channelsCompared && channelsCompared <= channels)
+	{
+		for (i = 0; i < count; ++i, pixels += channels, reference += channels)
+			for (c = 0; c < channelsCompared; ++c)
+			{
+				diff = (a3f64)pixels[c] - (a3f64)reference[c];
+				error += diff * diff;
+			}
+		error /= (a3f64)count * (a3f64)channelsCompared;
+		if (error > 0.0)
+			return (10.0 * log10(255.0 * 255.0 / error));
+		return 99.0;
+	}
+	return 0.0;
+}
+
+void a3demo_textureCompressNarrow(void* data, a3ui32 const channelCount)
+{
+	a3ui16 const* src = (a3ui16 const*)data;
+	a3ubyte* dst = (a3ubyte*)data;
+	a3ui32 i;
+
+	// each 8-bit value is written at or before the 16-bit value it came from
+	if (data)
+		for (i = 0; i < channelCount; ++i)
+			dst[i] = (a3ubyte)(src[i] >> 8);
+}
+
+a3ret a3demo_textureCompressBenchmark(a3byte const* filePath, a3_DemoWorkerPool* pool)
+{
+	static a3_TexturePixelType const compressedType[] = { a3tex_bc1, a3tex_bc3, a3tex_bc4, a3tex_bc5 };
+	static a3byte const* const compressedName[] = { "BC1", "BC3", "BC4", "BC5" };
+	a3_TexturePixelFormatDescriptor pixelFormat[1];
+	a3_TexturePixelType pixelType;
+	a3_Timer timer[1] = { 0 };
+	a3ubyte* pixels, * decoded;
+	void* data = 0, * blocks;
+	a3f64 megapixels, psnr;
+	a3ui32 width, height, channels, compared, size, source, i, threadCount;
+
+	if (filePath)
+	{
+		a3textureInitializeImageLibrary();
+		if (a3textureDecodeFile(&data, &width, &height, &pixelType, filePath) > 0)
+		{
+			// encoder takes 8-bit channels
+			a3textureCreatePixelFormatDescriptor(pixelFormat, pixelType);
+			channels = pixelFormat->channelsPerPixel;
+			if (pixelFormat->bytesPerChannel == 2)
+				a3demo_textureCompressNarrow(data, width * height * channels);
+			pixels = (a3ubyte*)data;
+			source = width * height * channels;
+			megapixels = (a3f64)(width * height) / 1000000.0;
+
+			decoded = (a3ubyte*)malloc(source);
+			blocks = malloc(a3demo_textureCompressSize(a3tex_bc3, width, height));
+			if (decoded && blocks)
+			{
+				printf("\n\n  texture compression: \'%s\' (%u x %u, %u channels)", filePath, width, height, channels);
+				for (i = 0; i < sizeof(compressedType) / sizeof(*compressedType); ++i)
+				{
+					// throughput with more and more threads
+					for (threadCount = 1; threadCount <= demoTextureCompressMaxCount_thread; threadCount <<= 1)
+					{
+						a3timerStart(timer);
+						a3demo_textureCompress(blocks, compressedType[i], pixels, width, height, channels, pool, threadCount);
+						a3timerStop(timer);
+						printf("\n  %s, %u thread(s): %8.3lf ms, %8.2lf MP/s", compressedName[i], threadCount,
+							timer->currentTick * 1000.0, (timer->currentTick > 0.0) ? (megapixels / timer->currentTick) : 0.0);
+					}
+
+					// quality of channels stored by format
+					size = a3demo_textureCompressSize(compressedType[i], width, height);
+					compared = a3demo_textureCompressChannels(compressedType[i]);
+					compared = (compared < channels) ? compared : channels;
+					memcpy(decoded, pixels, source);
+					a3demo_textureDecompress(decoded, channels, compressedType[i], blocks, width, height);
+					psnr = a3demo_texturePSNR(decoded, pixels, width, height, channels, compared);
+					printf("\n  %s: PSNR %.2lf dB over %u channel(s); %u -> %u bytes (%.1lf : 1)", compressedName[i], psnr, compared,
+						source, size, (a3f64)source / (a3f64)size);
+				}
+				printf("\n");
+			}
+			free(blocks);
+			free(decoded);
+			a3textureReleaseDecodedData(data);
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
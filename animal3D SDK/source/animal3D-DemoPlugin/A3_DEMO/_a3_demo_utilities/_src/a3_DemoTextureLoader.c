@@ -0,0 +1,614 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoTextureLoader.c
+	Background texture loading implementation.
+*/
+
+#include "../a3_DemoTextureLoader.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else	// !_WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif	// _WIN32
+
+
+//-----------------------------------------------------------------------------
+
+// bump when cooked file layout changes
+#define A3_DEMO_TEXTURE_FILE_VERSION	2
+
+// level data alignment in cooked file
+#define A3_DEMO_TEXTURE_FILE_ALIGN		16
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// read modification stamp of source image
+inline a3boolean a3demo_textureInternalStamp(a3i64* time_out, a3i64* size_out, a3byte const* filePath)
+{
+#ifdef _WIN32
+	struct _stat64 info[1];
+	if (_stat64(filePath, info) == 0)
+#else	// !_WIN32
+	struct stat info[1];
+	if (stat(filePath, info) == 0)
+#endif	// _WIN32
+	{
+		*time_out = (a3i64)info->st_mtime;
+		*size_out = (a3i64)info->st_size;
+		return a3true;
+	}
+	*time_out = *size_out = 0;
+	return a3false;
+}
+
+// 64-bit FNV-1a hash of a string, naming cooked files
+inline a3ui64 a3demo_textureInternalHashString(a3byte const* str)
+{
+	a3ui64 hash = 0xcbf29ce484222325ull;
+	while (*str)
+	{
+		hash ^= (a3ubyte)*(str++);
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+// path of cooked file for a source image
+inline void a3demo_textureInternalCookedPath(a3byte* path_out, a3byte const* directory, a3byte const* filePath)
+{
+	sprintf(path_out, "%s/%016llx.a3tex", directory,
+		(unsigned long long)a3demo_textureInternalHashString(filePath));
+}
+
+// average 2x2 blocks of one level into the next (edges clamp)
+inline void a3demo_textureInternalDownsample(void* dst, void const* src, a3ui32 const srcWidth, a3ui32 const srcHeight, a3ui32 const channels, a3ui32 const bytes)
+{
+	a3ui32 const dstWidth = (srcWidth > 1) ? (srcWidth >> 1) : 1, dstHeight = (srcHeight > 1) ? (srcHeight >> 1) : 1;
+	a3ui32 x, y, c, x0, x1, y0, y1;
+	for (y = 0; y < dstHeight; ++y)
+	{
+		y0 = (y << 1) * srcWidth;
+		y1 = (((y << 1) + 1 < srcHeight) ? (y << 1) + 1 : (srcHeight - 1)) * srcWidth;
+		for (x = 0; x < dstWidth; ++x)
+		{
+			x0 = (x << 1);
+			x1 = ((x << 1) + 1 < srcWidth) ? (x << 1) + 1 : (srcWidth - 1);
+			if (bytes == 1)
+			{
+				a3ubyte const* s = (a3ubyte const*)src;
+				a3ubyte* d = (a3ubyte*)dst + (y * dstWidth + x) * channels;
+				for (c = 0; c < channels; ++c)
+					d[c] = (a3ubyte)((s[(y0 + x0) * channels + c] + s[(y0 + x1) * channels + c] +
+						s[(y1 + x0) * channels + c] + s[(y1 + x1) * channels + c] + 2) >> 2);
+			}
+			else
+			{
+				a3ui16 const* s = (a3ui16 const*)src;
+				a3ui16* d = (a3ui16*)dst + (y * dstWidth + x) * channels;
+				for (c = 0; c < channels; ++c)
+					d[c] = (a3ui16)((s[(y0 + x0) * channels + c] + s[(y0 + x1) * channels + c] +
+						s[(y1 + x0) * channels + c] + s[(y1 + x1) * channels + c] + 2) >> 2);
+			}
+		}
+	}
+}
+
+// allocate cooked file with header filled in and room for a full mip chain
+//	return: allocated file contents (data zeroed); null if failed
+inline a3_DemoTextureFileHeader* a3demo_textureInternalLayout(a3ui32* fileSize_out, a3_TexturePixelType const pixelType, a3ui32 const width, a3ui32 const height)
+{
+	a3_DemoTextureFileHeader header[1] = { 0 }, * file;
+	a3_TexturePixelFormatDescriptor pixelFormat[1];
+	a3ui32 const pixelSize = a3textureCreatePixelFormatDescriptor(pixelFormat, pixelType) >= 0 ? pixelFormat->channelsPerPixel * pixelFormat->bytesPerChannel : 0;
+	a3ui32 fileSize, levelWidth, levelHeight, i;
+
+	// compressed levels are whole 4x4 blocks
+	fileSize = (sizeof(a3_DemoTextureFileHeader) + A3_DEMO_TEXTURE_FILE_ALIGN - 1) & ~(A3_DEMO_TEXTURE_FILE_ALIGN - 1);
+	for (i = 0; i < demoTextureLoaderMaxCount_level; ++i)
+	{
+		levelWidth = (width >> i) ? (width >> i) : 1;
+		levelHeight = (height >> i) ? (height >> i) : 1;
+		header->levelOffset[i] = fileSize;
+		header->levelSize[i] = a3demo_textureCompressChannels(pixelType)
+			? a3demo_textureCompressSize(pixelType, levelWidth, levelHeight)
+			: levelWidth * levelHeight * pixelSize;
+		fileSize += (header->levelSize[i] + A3_DEMO_TEXTURE_FILE_ALIGN - 1) & ~(A3_DEMO_TEXTURE_FILE_ALIGN - 1);
+		header->levelCount = i + 1;
+		if (levelWidth <= 1 && levelHeight <= 1)
+			break;
+	}
+	memcpy(header->identifier, a3demo_textureFileIdentifier, sizeof(header->identifier));
+	header->version = A3_DEMO_TEXTURE_FILE_VERSION;
+	header->pixelType = pixelType;
+	header->width = width;
+	header->height = height;
+
+	file = (a3_DemoTextureFileHeader*)calloc(1, fileSize);
+	if (file)
+	{
+		*file = *header;
+		*fileSize_out = fileSize;
+	}
+	return file;
+}
+
+// decode source and build cooked file contents in memory
+//	return: allocated file contents; null if decode failed
+inline a3_DemoTextureFileHeader* a3demo_textureInternalCook(a3ui32* fileSize_out, a3byte const* sourcePath, a3_DemoTextureCompression const compression)
+{
+	a3_DemoTextureFileHeader* file = 0, * compressed;
+	a3_TexturePixelFormatDescriptor pixelFormat[1];
+	a3_TexturePixelType pixelType;
+	a3ubyte* level;
+	void* data = 0;
+	a3ret compressedType = -1;
+	a3ui32 width, height, fileSize = 0, i;
+
+	if (a3textureDecodeFile(&data, &width, &height, &pixelType, sourcePath) > 0)
+	{
+		a3textureCreatePixelFormatDescriptor(pixelFormat, pixelType);
+
+		// encoder takes 8-bit channels; compression loses more than this
+		compressedType = a3demo_textureCompressType(compression, pixelFormat->channelsPerPixel);
+		if (compressedType >= 0 && pixelFormat->bytesPerChannel == 2)
+		{
+			a3demo_textureCompressNarrow(data, width * height * pixelFormat->channelsPerPixel);
+			pixelType = (pixelFormat->channelsPerPixel == 3) ? a3tex_rgb8 : a3tex_rgba8;
+			a3textureCreatePixelFormatDescriptor(pixelFormat, pixelType);
+		}
+
+		// decoded data is already bottom row first; copy base and reduce
+		file = a3demo_textureInternalLayout(&fileSize, pixelType, width, height);
+		if (file)
+		{
+			level = (a3ubyte*)file;
+			memcpy(level + file->levelOffset[0], data, file->levelSize[0]);
+			for (i = 1; i < file->levelCount; ++i)
+				a3demo_textureInternalDownsample(level + file->levelOffset[i], level + file->levelOffset[i - 1],
+					(width >> (i - 1)) ? (width >> (i - 1)) : 1, (height >> (i - 1)) ? (height >> (i - 1)) : 1,
+					pixelFormat->channelsPerPixel, pixelFormat->bytesPerChannel);
+
+			// compress every level; this already runs on a loader worker, 
+			//	so each texture is compressed by that thread alone
+			if (compressedType >= 0)
+			{
+				compressed = a3demo_textureInternalLayout(&fileSize, (a3_TexturePixelType)compressedType, width, height);
+				if (compressed)
+					for (i = 0; i < compressed->levelCount; ++i)
+						a3demo_textureCompress((a3ubyte*)compressed + compressed->levelOffset[i], (a3_TexturePixelType)compressedType,
+							level + file->levelOffset[i], (width >> i) ? (width >> i) : 1, (height >> i) ? (height >> i) : 1,
+							pixelFormat->channelsPerPixel, 0, 1);
+				free(file);
+				file = compressed;
+			}
+		}
+		if (file)
+		{
+			file->compression = compression;
+			a3demo_textureInternalStamp(&file->sourceTime, &file->sourceSize, sourcePath);
+			*fileSize_out = fileSize;
+		}
+		a3textureReleaseDecodedData(data);
+	}
+	return file;
+}
+
+// check that cooked file contents are intact and match source: every 
+//	level must hold exactly the bytes its dimensions need and lie inside 
+//	the file after the one before it, since upload copies the whole chain
+inline a3boolean a3demo_textureInternalValidate(a3_DemoTextureFileHeader const* file, a3ui32 const fileSize, a3i64 const sourceTime, a3i64 const sourceSize, a3_DemoTextureCompression const compression)
+{
+	a3_TexturePixelFormatDescriptor pixelFormat[1];
+	a3ui64 levelSize;
+	a3ui32 pixelSize = 0, levelWidth, levelHeight, end, i;
+	if (!file || fileSize < sizeof(a3_DemoTextureFileHeader) ||
+		memcmp(file->identifier, a3demo_textureFileIdentifier, sizeof(file->identifier)) ||
+		file->version != A3_DEMO_TEXTURE_FILE_VERSION || file->compression != (a3ui32)compression ||
+		(file->pixelType > a3tex_rgba32F && !a3demo_textureCompressChannels((a3_TexturePixelType)file->pixelType)) ||
+		file->sourceTime != sourceTime || file->sourceSize != sourceSize ||
+		!file->width || !file->height || !file->levelCount || file->levelCount > demoTextureLoaderMaxCount_level)
+		return a3false;
+	if (!a3demo_textureCompressChannels((a3_TexturePixelType)file->pixelType))
+	{
+		if (a3textureCreatePixelFormatDescriptor(pixelFormat, (a3_TexturePixelType)file->pixelType) < 0)
+			return a3false;
+		pixelSize = pixelFormat->channelsPerPixel * pixelFormat->bytesPerChannel;
+	}
+	for (i = 0, end = sizeof(a3_DemoTextureFileHeader); i < file->levelCount; ++i)
+	{
+		levelWidth = (file->width >> i) ? (file->width >> i) : 1;
+		levelHeight = (file->height >> i) ? (file->height >> i) : 1;
+		levelSize = pixelSize
+			? (a3ui64)levelWidth * (a3ui64)levelHeight * (a3ui64)pixelSize
+			: (a3ui64)a3demo_textureCompressSize((a3_TexturePixelType)file->pixelType, levelWidth, levelHeight);
+		if (file->levelSize[i] != levelSize || file->levelOffset[i] < end ||
+			file->levelOffset[i] > fileSize || file->levelSize[i] > fileSize - file->levelOffset[i])
+			return a3false;
+		end = file->levelOffset[i] + file->levelSize[i];
+	}
+	return a3true;
+}
+
+// map cooked file into memory (read-only)
+inline a3boolean a3demo_textureInternalMap(a3_DemoTextureRequest* request, a3byte const* path)
+{
+#ifdef _WIN32
+	HANDLE mapping = 0;
+	HANDLE const handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, 0);
+	DWORD size;
+	if (handle != INVALID_HANDLE_VALUE)
+	{
+		size = GetFileSize(handle, 0);
+		if (size && size != INVALID_FILE_SIZE)
+			mapping = CreateFileMappingA(handle, 0, PAGE_READONLY, 0, 0, 0);
+		CloseHandle(handle);
+		if (mapping)
+		{
+			request->file = (a3_DemoTextureFileHeader const*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			if (request->file)
+			{
+				request->fileMapping = mapping;
+				request->fileSize = (a3ui32)size;
+				return a3true;
+			}
+			CloseHandle(mapping);
+		}
+	}
+#else	// !_WIN32
+	struct stat info[1];
+	void* view;
+	a3i32 const handle = open(path, O_RDONLY);
+	if (handle >= 0)
+	{
+		if (fstat(handle, info) == 0 && info->st_size > 0)
+		{
+			view = mmap(0, (size_t)info->st_size, PROT_READ, MAP_PRIVATE, handle, 0);
+			if (view != MAP_FAILED)
+			{
+				request->file = (a3_DemoTextureFileHeader const*)view;
+				request->fileMapping = view;
+				request->fileSize = (a3ui32)info->st_size;
+				close(handle);
+				return a3true;
+			}
+		}
+		close(handle);
+	}
+#endif	// _WIN32
+	return a3false;
+}
+
+// release cooked file contents, mapped or allocated
+inline void a3demo_textureInternalUnmap(a3_DemoTextureRequest* request)
+{
+	if (request->fileMapping)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(request->file);
+		CloseHandle(request->fileMapping);
+#else	// !_WIN32
+		munmap(request->fileMapping, request->fileSize);
+#endif	// _WIN32
+	}
+	else if (request->file)
+		free((void*)request->file);
+	request->file = 0;
+	request->fileMapping = 0;
+	request->fileSize = 0;
+}
+
+// worker: map cooked file, cooking it first if missing or stale
+inline void a3demo_textureInternalProcess(a3_DemoTextureLoader const* loader, a3_DemoTextureRequest* request)
+{
+	a3byte cookedPath[demoTextureLoaderMaxCount_pathLen + 32];
+	a3_DemoTextureFileHeader* file;
+	a3_Timer timer[1] = { 0 };
+	a3i64 sourceTime, sourceSize;
+	a3ui32 fileSize = 0;
+	FILE* fp;
+
+	a3timerStart(timer);
+	a3demo_textureInternalCookedPath(cookedPath, loader->directory, request->filePath);
+	a3demo_textureInternalStamp(&sourceTime, &sourceSize, request->filePath);
+
+	if (!a3demo_textureInternalMap(request, cookedPath) ||
+		!a3demo_textureInternalValidate(request->file, request->fileSize, sourceTime, sourceSize, request->compression))
+	{
+		// cache miss: cook and keep the cooked data for upload
+		a3demo_textureInternalUnmap(request);
+		file = a3demo_textureInternalCook(&fileSize, request->filePath, request->compression);
+		if (file)
+		{
+			fp = fopen(cookedPath, "wb");
+			if (fp)
+			{
+				fwrite(file, 1, fileSize, fp);
+				fclose(fp);
+			}
+			request->file = file;
+			request->fileSize = fileSize;
+			request->cooked = a3true;
+		}
+	}
+
+	// publish: every write above is visible before the new state
+	a3timerStop(timer);
+	request->workTime = timer->currentTick;
+	a3demo_atomicStore(&request->state, request->file ? demoTextureRequest_ready : demoTextureRequest_failed);
+}
+
+// worker task: one request each, claimed in request order
+void a3demo_textureInternalTask(void* args, a3ui32 index)
+{
+	a3_DemoTextureLoader* const loader = (a3_DemoTextureLoader*)args;
+	if (!a3demo_atomicLoad(&loader->abort))
+		a3demo_textureInternalProcess(loader, loader->request + index);
+}
+
+// upload one ready request through the pixel buffer
+//	return: bytes uploaded
+inline a3ui32 a3demo_textureInternalUpload(a3_DemoTextureLoader* loader, a3_DemoTextureRequest* request)
+{
+	a3_DemoTextureFileHeader const* const file = request->file;
+	a3_TexturePixelFormatDescriptor pixelFormat[1];
+	a3ubyte const* const data = (a3ubyte const*)file + file->levelOffset[0];
+	void const* levelData[demoTextureLoaderMaxCount_level];
+	a3ui32 const size = file->levelOffset[file->levelCount - 1] + file->levelSize[file->levelCount - 1] - file->levelOffset[0];
+	a3boolean staged = a3false;
+	void* staging;
+	a3ui32 i;
+
+	// grow staging buffer if needed, then copy whole mip chain into it
+	if (loader->pixelBuffer->size < size)
+	{
+		a3bufferRelease(loader->pixelBuffer);
+		a3bufferCreate(loader->pixelBuffer, "pbo:texture-upload", a3buffer_pixelUnpack, size, 0);
+	}
+	if (a3bufferMap(loader->pixelBuffer, 0, loader->pixelBuffer->size, &staging) > 0)
+	{
+		memcpy(staging, data, size);
+		staged = (a3bufferUnmap(loader->pixelBuffer) > 0);
+	}
+
+	// level pointers are offsets while the pixel buffer is active;
+	//	without it, upload straight from the cooked data
+	for (i = 0; i < file->levelCount; ++i)
+		levelData[i] = staged ? (void const*)(size_t)(file->levelOffset[i] - file->levelOffset[0]) : (void const*)((a3ubyte const*)file + file->levelOffset[i]);
+	if (staged)
+		a3bufferActivate(loader->pixelBuffer);
+	a3textureCreatePixelFormatDescriptor(pixelFormat, (a3_TexturePixelType)file->pixelType);
+	a3textureCreateFromMipData(request->texture, request->name, pixelFormat, file->width, file->height, file->levelCount, levelData);
+	if (staged)
+		a3bufferDeactivateType(a3buffer_pixelUnpack);
+
+	// settings
+	a3textureActivate(request->texture, a3tex_unit00);
+	a3textureChangeFilterMode(request->filter);
+	a3textureChangeRepeatMode(request->repeatH, request->repeatV);
+	a3textureDeactivate(a3tex_unit00);
+
+	a3demo_textureInternalUnmap(request);
+	return size;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3demo_textureCook(a3byte const* sourcePath, a3byte const* cookedPath, a3_DemoTextureCompression const compression)
+{
+	a3_DemoTextureFileHeader* file;
+	a3ui32 fileSize = 0;
+	a3ret result = 0;
+	FILE* fp;
+
+	if (sourcePath && cookedPath)
+	{
+		file = a3demo_textureInternalCook(&fileSize, sourcePath, compression);
+		if (file)
+		{
+			fp = fopen(cookedPath, "wb");
+			if (fp)
+			{
+				result = (fwrite(file, 1, fileSize, fp) == fileSize);
+				fclose(fp);
+			}
+			free(file);
+		}
+		return result;
+	}
+	return -1;
+}
+
+a3ret a3demo_textureLoaderInit(a3_DemoTextureLoader* loader, a3byte const* directory, a3ui32 const uploadBudget)
+{
+	if (loader && directory && *directory && strlen(directory) < demoTextureLoaderMaxCount_pathLen)
+	{
+		memset(loader, 0, sizeof(*loader));
+		strcpy(loader->directory, directory);
+		loader->uploadBudget = uploadBudget;
+		loader->compressionSupported = (a3textureCompressionSupported() > 0);
+		a3fileStreamMakeDirectory(directory);
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3demo_textureLoaderRequest(a3_DemoTextureLoader* loader, a3_Texture* texture, a3byte const* name, a3byte const* filePath,
+	a3_TextureFilterOption const filter, a3_TextureRepeatOption const repeatH, a3_TextureRepeatOption const repeatV,
+	a3_DemoTextureCompression const compression)
+{
+	a3_DemoTextureRequest* request;
+	if (loader && !loader->workerCount && texture && filePath && strlen(filePath) < demoTextureLoaderMaxCount_pathLen)
+	{
+		if (loader->requestCount < demoTextureLoaderMaxCount_request)
+		{
+			request = loader->request + loader->requestCount++;
+			memset(request, 0, sizeof(*request));
+			request->texture = texture;
+			if (name)
+				strncpy(request->name, name, sizeof(request->name) - 1);
+			strcpy(request->filePath, filePath);
+			request->filter = filter;
+			request->repeatH = repeatH;
+			request->repeatV = repeatV;
+			request->compression = loader->compressionSupported ? compression : demoTextureCompression_none;
+			request->state = demoTextureRequest_queued;
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+a3ret a3demo_textureLoaderStart(a3_DemoTextureLoader* loader, a3ui32 workerCount)
+{
+	if (loader && !loader->workerCount)
+	{
+		if (!workerCount)
+			workerCount = a3demo_workerPoolProcessorCount();
+		if (workerCount > demoTextureLoaderMaxCount_worker)
+			workerCount = demoTextureLoaderMaxCount_worker;
+		if (workerCount > loader->requestCount)
+			workerCount = loader->requestCount;
+
+		// image library must be initialized on this thread
+		a3textureInitializeImageLibrary();
+		a3timerStart(loader->timer);
+
+		// caller does not help: requests are processed while it draws; 
+		//	if no thread could be launched, they are processed now
+		if (workerCount)
+		{
+			if (a3demo_workerPoolCreate(loader->workerPool, workerCount) > 0)
+				a3demo_workerPoolBegin(loader->workerPool, a3demo_textureInternalTask, loader, loader->requestCount);
+			else
+				a3demo_workerPoolRun(0, a3demo_textureInternalTask, loader, loader->requestCount);
+			workerCount = loader->workerPool->threadCount ? loader->workerPool->threadCount : 1;
+		}
+		loader->workerCount = workerCount;
+		return workerCount;
+	}
+	return -1;
+}
+
+a3ret a3demo_textureLoaderUpdate(a3_DemoTextureLoader* loader)
+{
+	a3_DemoTextureRequest* request;
+	a3f64 workTime = 0.0;
+	a3ui32 i, budget, size, count = 0, cooked = 0;
+	a3i32 state;
+
+	if (loader)
+	{
+		if (loader->workerCount && loader->uploadCount + loader->failCount < loader->requestCount)
+		{
+			// upload in request order as textures become ready; always
+			//	allow at least one so a large texture cannot stall
+			for (i = 0, budget = loader->uploadBudget, request = loader->request;
+				i < loader->requestCount; ++i, ++request)
+			{
+				state = a3demo_atomicLoad(&request->state);
+				if (state == demoTextureRequest_ready)
+				{
+					size = request->file->levelOffset[request->file->levelCount - 1] + request->file->levelSize[request->file->levelCount - 1] - request->file->levelOffset[0];
+					if (count && size > budget)
+						continue;
+					size = a3demo_textureInternalUpload(loader, request);
+					loader->uploadSize += size;
+					budget = (size < budget) ? (budget - size) : 0;
+					request->state = demoTextureRequest_done;
+					++loader->uploadCount;
+					++count;
+				}
+				else if (state == demoTextureRequest_failed)
+				{
+					printf("\n A3 ERROR (TEX \'%s\'): \n\t Could not load \'%s\'.", request->name, request->filePath);
+					request->state = demoTextureRequest_done;
+					++loader->failCount;
+				}
+			}
+
+			// summary
+			if (loader->uploadCount + loader->failCount == loader->requestCount)
+			{
+				a3timerStop(loader->timer);
+				for (i = 0, request = loader->request; i < loader->requestCount; ++i, ++request)
+				{
+					workTime += request->workTime;
+					cooked += request->cooked;
+				}
+				printf("\n\n  textures: %u loaded (%u cooked, %u cached), %u failed; %u workers",
+					loader->uploadCount, cooked, loader->uploadCount - cooked, loader->failCount, loader->workerCount);
+				printf("\n  textures: all visible after %.3lf ms; %.3lf ms of worker time; %.1lf MB uploaded \n",
+					loader->timer->currentTick * 1000.0, workTime * 1000.0, (a3f64)loader->uploadSize / 1048576.0);
+				a3demo_textureLoaderWait(loader);
+				a3bufferRelease(loader->pixelBuffer);
+			}
+		}
+		return count;
+	}
+	return -1;
+}
+
+a3ret a3demo_textureLoaderWait(a3_DemoTextureLoader* loader)
+{
+	if (loader)
+	{
+		// joins on the batch of requests, then on the threads; nothing 
+		//	to do if already waited
+		a3demo_workerPoolRelease(loader->workerPool);
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3demo_textureLoaderRelease(a3_DemoTextureLoader* loader)
+{
+	a3ui32 i;
+	if (loader)
+	{
+		a3demo_atomicStore(&loader->abort, a3true);
+		a3demo_textureLoaderWait(loader);
+		for (i = 0; i < loader->requestCount; ++i)
+			a3demo_textureInternalUnmap(loader->request + i);
+		a3bufferRelease(loader->pixelBuffer);
+		loader->requestCount = loader->workerCount = 0;
+		loader->uploadCount = loader->failCount = 0;
+		loader->uploadSize = 0;
+		loader->abort = a3false;
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,322 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoWorkerPool.c
+	Persistent worker thread implementation.
+*/
+
+#include "../a3_DemoWorkerPool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else	// !_WIN32
+#include <pthread.h>
+#include <unistd.h>
+#endif	// _WIN32
+
+
+//-----------------------------------------------------------------------------
+// INTERNAL UTILITIES
+
+// threads are native rather than a3_Thread: a3_Thread clears its own
+//	handle when its function returns, so it can be neither joined nor
+//	closed reliably
+typedef struct a3_DemoWorkerPoolPlatform
+{
+#ifdef _WIN32
+	HANDLE thread[demoWorkerPoolMaxCount_thread];
+	SRWLOCK lock;
+	CONDITION_VARIABLE work, done;			// batch begun; worker left batch
+#else	// !_WIN32
+	pthread_t thread[demoWorkerPoolMaxCount_thread];
+	pthread_mutex_t lock;
+	pthread_cond_t work, done;
+#endif	// _WIN32
+} a3_DemoWorkerPoolPlatform;
+
+#ifdef _WIN32
+#define a3demo_workerPoolInternalLock(p)		AcquireSRWLockExclusive(&(p)->lock)
+#define a3demo_workerPoolInternalUnlock(p)		ReleaseSRWLockExclusive(&(p)->lock)
+#define a3demo_workerPoolInternalWait(p, c)		SleepConditionVariableSRW(&(p)->c, &(p)->lock, INFINITE, 0)
+#define a3demo_workerPoolInternalWake(p, c)		WakeAllConditionVariable(&(p)->c)
+#else	// !_WIN32
+#define a3demo_workerPoolInternalLock(p)		pthread_mutex_lock(&(p)->lock)
+#define a3demo_workerPoolInternalUnlock(p)		pthread_mutex_unlock(&(p)->lock)
+#define a3demo_workerPoolInternalWait(p, c)		pthread_cond_wait(&(p)->c, &(p)->lock)
+#define a3demo_workerPoolInternalWake(p, c)		pthread_cond_broadcast(&(p)->c)
+#endif	// _WIN32
+
+
+// claim and run tasks of a batch until none are left
+//	return: number of tasks run
+inline a3ui32 a3demo_workerPoolInternalWork(a3_DemoWorkerPool* pool, a3_DemoWorkerTask const task, void* args, a3ui32 const taskCount)
+{
+	a3ui32 index, count = 0;
+	while ((index = (a3ui32)(a3demo_atomicAdd(&pool->next, 1) - 1)) < taskCount)
+	{
+		task(args, index);
+		a3demo_atomicAdd(&pool->remaining, -1);
+		++count;
+	}
+	return count;
+}
+
+// wait under lock until no batch is in flight
+inline void a3demo_workerPoolInternalIdle(a3_DemoWorkerPool* pool, a3_DemoWorkerPoolPlatform* platform)
+{
+	while (a3demo_atomicLoad(&pool->remaining) || pool->active)
+		a3demo_workerPoolInternalWait(platform, done);
+}
+
+// worker thread: sleep until a batch begins, take part in it, repeat
+#ifdef _WIN32
+DWORD WINAPI a3demo_workerPoolInternalThread(LPVOID args)
+#else	// !_WIN32
+void* a3demo_workerPoolInternalThread(void* args)
+#endif	// _WIN32
+{
+	a3_DemoWorkerPool* const pool = (a3_DemoWorkerPool*)args;
+	a3_DemoWorkerPoolPlatform* const platform = (a3_DemoWorkerPoolPlatform*)pool->platform;
+	a3_DemoWorkerTask task;
+	void* taskArgs;
+	a3ui32 taskCount, batch = 0;
+
+	a3demo_workerPoolInternalLock(platform);
+	for (;;)
+	{
+		while (!pool->quit && pool->batch == batch)
+			a3demo_workerPoolInternalWait(platform, work);
+		if (pool->quit)
+			break;
+
+		// copy batch while holding lock; it cannot change until this
+		//	worker leaves, since the next one waits for active workers
+		batch = pool->batch;
+		task = pool->task;
+		taskArgs = pool->args;
+		taskCount = pool->taskCount;
+		++pool->active;
+		a3demo_workerPoolInternalUnlock(platform);
+
+		a3demo_workerPoolInternalWork(pool, task, taskArgs, taskCount);
+
+		a3demo_workerPoolInternalLock(platform);
+		if (--pool->active == 0)
+			a3demo_workerPoolInternalWake(platform, done);
+	}
+	a3demo_workerPoolInternalUnlock(platform);
+	return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ui32 a3demo_workerPoolProcessorCount()
+{
+#ifdef _WIN32
+	SYSTEM_INFO info[1];
+	GetSystemInfo(info);
+	return (a3ui32)info->dwNumberOfProcessors;
+#else	// !_WIN32
+	long const count = sysconf(_SC_NPROCESSORS_ONLN);
+	return (count > 0) ? (a3ui32)count : 1;
+#endif	// _WIN32
+}
+
+a3ret a3demo_workerPoolCreate(a3_DemoWorkerPool* pool, a3ui32 threadCount)
+{
+	a3_DemoWorkerPoolPlatform* platform;
+	a3ui32 i;
+
+	if (pool && !pool->platform)
+	{
+		if (!threadCount)
+			threadCount = a3demo_workerPoolProcessorCount() - 1;
+		if (threadCount > demoWorkerPoolMaxCount_thread)
+			threadCount = demoWorkerPoolMaxCount_thread;
+
+		platform = (a3_DemoWorkerPoolPlatform*)calloc(1, sizeof(a3_DemoWorkerPoolPlatform));
+		if (!platform)
+			return -1;
+		memset(pool, 0, sizeof(*pool));
+		pool->platform = platform;
+#ifdef _WIN32
+		InitializeSRWLock(&platform->lock);
+		InitializeConditionVariable(&platform->work);
+		InitializeConditionVariable(&platform->done);
+		for (i = 0; i < threadCount; ++i)
+			if (!(platform->thread[i] = CreateThread(0, 0, a3demo_workerPoolInternalThread, pool, 0, 0)))
+				break;
+#else	// !_WIN32
+		pthread_mutex_init(&platform->lock, 0);
+		pthread_cond_init(&platform->work, 0);
+		pthread_cond_init(&platform->done, 0);
+		for (i = 0; i < threadCount; ++i)
+			if (pthread_create(platform->thread + i, 0, a3demo_workerPoolInternalThread, pool) != 0)
+				break;
+#endif	// _WIN32
+		pool->threadCount = i;
+		return i;
+	}
+	return -1;
+}
+
+a3ret a3demo_workerPoolBegin(a3_DemoWorkerPool* pool, a3_DemoWorkerTask const task, void* args, a3ui32 const taskCount)
+{
+	a3_DemoWorkerPoolPlatform* platform;
+	if (pool && pool->platform && task)
+	{
+		platform = (a3_DemoWorkerPoolPlatform*)pool->platform;
+		a3demo_workerPoolInternalLock(platform);
+		a3demo_workerPoolInternalIdle(pool, platform);
+		pool->task = task;
+		pool->args = args;
+		pool->taskCount = taskCount;
+		pool->next = 0;
+		pool->remaining = (a3i32)taskCount;
+		++pool->batch;
+		a3demo_workerPoolInternalWake(platform, work);
+		a3demo_workerPoolInternalUnlock(platform);
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3demo_workerPoolEnd(a3_DemoWorkerPool* pool, a3boolean const help)
+{
+	a3_DemoWorkerPoolPlatform* platform;
+	a3ui32 count = 0;
+	if (pool && pool->platform)
+	{
+		platform = (a3_DemoWorkerPoolPlatform*)pool->platform;
+		if (help || !pool->threadCount)
+			count = a3demo_workerPoolInternalWork(pool, pool->task, pool->args, pool->taskCount);
+		a3demo_workerPoolInternalLock(platform);
+		a3demo_workerPoolInternalIdle(pool, platform);
+		a3demo_workerPoolInternalUnlock(platform);
+		return count;
+	}
+	return -1;
+}
+
+a3ret a3demo_workerPoolRun(a3_DemoWorkerPool* pool, a3_DemoWorkerTask const task, void* args, a3ui32 const taskCount)
+{
+	a3ui32 i;
+	if (task)
+	{
+		// one task or no workers: nothing to hand out
+		if (!pool || !pool->platform || !pool->threadCount || taskCount <= 1)
+		{
+			for (i = 0; i < taskCount; ++i)
+				task(args, i);
+			return taskCount;
+		}
+		a3demo_workerPoolBegin(pool, task, args, taskCount);
+		return a3demo_workerPoolEnd(pool, a3true);
+	}
+	return -1;
+}
+
+void a3demo_workerPoolDispatch(void* pool, a3_DemoWorkerTask const task, void* args, a3ui32 const taskCount)
+{
+	a3demo_workerPoolRun((a3_DemoWorkerPool*)pool, task, args, taskCount);
+}
+
+a3ret a3demo_workerPoolIsDone(a3_DemoWorkerPool const* pool)
+{
+	if (pool)
+		return (a3demo_atomicLoad(&pool->remaining) == 0);
+	return -1;
+}
+
+a3ret a3demo_workerPoolRelease(a3_DemoWorkerPool* pool)
+{
+	a3_DemoWorkerPoolPlatform* platform;
+	a3ui32 i;
+	if (pool)
+	{
+		platform = (a3_DemoWorkerPoolPlatform*)pool->platform;
+		if (platform)
+		{
+			// unclaimed tasks still run: callers that want to stop early
+			//	tell their tasks to return, not the pool
+			a3demo_workerPoolInternalLock(platform);
+			if (!pool->threadCount)
+				a3demo_workerPoolInternalWork(pool, pool->task, pool->args, pool->taskCount);
+			a3demo_workerPoolInternalIdle(pool, platform);
+			pool->quit = a3true;
+			a3demo_workerPoolInternalWake(platform, work);
+			a3demo_workerPoolInternalUnlock(platform);
+
+#ifdef _WIN32
+			for (i = 0; i < pool->threadCount; ++i)
+			{
+				WaitForSingleObject(platform->thread[i], INFINITE);
+				CloseHandle(platform->thread[i]);
+			}
+#else	// !_WIN32
+			for (i = 0; i < pool->threadCount; ++i)
+				pthread_join(platform->thread[i], 0);
+			pthread_cond_destroy(&platform->done);
+			pthread_cond_destroy(&platform->work);
+			pthread_mutex_destroy(&platform->lock);
+#endif	// _WIN32
+			free(platform);
+			memset(pool, 0, sizeof(*pool));
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+
+a3i32 a3demo_atomicLoad(a3i32 volatile const* value)
+{
+#ifdef _WIN32
+	return (a3i32)InterlockedCompareExchange((LONG volatile*)value, 0, 0);
+#else	// !_WIN32
+	return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif	// _WIN32
+}
+
+void a3demo_atomicStore(a3i32 volatile* value, a3i32 const newValue)
+{
+#ifdef _WIN32
+	InterlockedExchange((LONG volatile*)value, (LONG)newValue);
+#else	// !_WIN32
+	__atomic_store_n(value, newValue, __ATOMIC_RELEASE);
+#endif	// _WIN32
+}
+
+a3i32 a3demo_atomicAdd(a3i32 volatile* value, a3i32 const delta)
+{
+#ifdef _WIN32
+	return (a3i32)InterlockedExchangeAdd((LONG volatile*)value, (LONG)delta) + delta;
+#else	// !_WIN32
+	return __atomic_add_fetch(value, delta, __ATOMIC_ACQ_REL);
+#endif	// _WIN32
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,150 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoBVH.h
+	Bounding volume hierarchy over object world bounds: built top-down by
+		surface area heuristic, subtrees in parallel, into a flat array of
+		nodes with sibling pairs side by side; refit in place when objects
+		only move, and queried by frustum, sphere, box or ray.
+*/
+
+#ifndef __ANIMAL3D_DEMOBVH_H
+#define __ANIMAL3D_DEMOBVH_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DG/animal3D-A3DG.h"
+
+#include "a3_DemoWorkerPool.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef struct a3_DemoBVHNode							a3_DemoBVHNode;
+typedef struct a3_DemoBVH								a3_DemoBVH;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// build limits
+enum a3_DemoBVHSize
+{
+	demoBVHSize_leaf = 4,						// objects per leaf, if splitting helps
+	demoBVHSize_leafMax = 16,					// objects per leaf, always
+	demoBVHSize_bin = 16,						// split candidates per axis
+	demoBVHSize_depthSAH = 48,					// deeper nodes split at median
+	demoBVHSize_stack = 128,					// traversal stack
+	demoBVHSize_thread = 8,						// shares of subtrees built at once
+};
+
+// one node, half a cache line; children are a pair, right after left
+struct a3_DemoBVHNode
+{
+	a3f32 min[3];
+	a3ui32 count;								// objects in leaf; 0 if inner
+	a3f32 max[3];
+	a3ui32 index;								// first object of leaf in object
+												//	list, or left child if inner
+};
+
+// hierarchy and the object bounds it was built from
+struct a3_DemoBVH
+{
+	a3_DemoBVHNode* node;						// root first; parents always
+												//	before their children
+	a3ui32* object;								// object indices, leaf by leaf
+	a3f32* box;									// min and max of each object
+	a3ui32 nodeCount, nodeCapacity;
+	a3ui32 objectCount, objectCapacity;
+};
+
+
+//-----------------------------------------------------------------------------
+
+// build hierarchy over world bounds, replacing any previous one
+//	bounds: world-space bounds of each object (see 'a3geometryTransformBounds')
+//	pool: workers that help the caller; null to build on caller only
+//	threadCount: number of shares subtrees are dealt into, so the most
+//		threads, including the caller, that can work at once
+//	return: number of nodes; 0 if failed; -1 if invalid
+a3ret a3demo_bvhBuild(a3_DemoBVH* bvh, a3_VertexBounds const* bounds, a3ui32 const count, a3_DemoWorkerPool* pool, a3ui32 threadCount);
+
+// update bounds of the same objects and refit nodes from leaves up; the
+//	tree keeps its shape, so it loosens if objects move far
+//	return: number of nodes; -1 if invalid
+a3ret a3demo_bvhRefit(a3_DemoBVH* bvh, a3_VertexBounds const* bounds);
+
+// refit if the object count is unchanged, otherwise rebuild
+//	return: number of nodes; 0 if failed; -1 if invalid
+a3ret a3demo_bvhUpdate(a3_DemoBVH* bvh, a3_VertexBounds const* bounds, a3ui32 const count, a3_DemoWorkerPool* pool, a3ui32 threadCount);
+
+// release hierarchy
+//	return: 1 if released; 0 if not built; -1 if invalid
+a3ret a3demo_bvhRelease(a3_DemoBVH* bvh);
+
+// objects whose bounds may be inside frustum planes (see
+//	'a3demo_geometryMeshletFrustum'; pass view-projection for world space)
+//	result_out: receives object indices, at most 'maxCount'
+//	return: number of objects found, which may be more than written;
+//		-1 if invalid
+a3ret a3demo_bvhQueryFrustum(a3ui32* result_out, a3ui32 const maxCount, a3_DemoBVH const* bvh, a3f32 const planes[6][4]);
+
+// objects whose bounds touch sphere
+//	return: number of objects found; -1 if invalid
+a3ret a3demo_bvhQuerySphere(a3ui32* result_out, a3ui32 const maxCount, a3_DemoBVH const* bvh, a3f32 const center[3], a3f32 const radius);
+
+// objects whose bounds overlap box
+//	return: number of objects found; -1 if invalid
+a3ret a3demo_bvhQueryBox(a3ui32* result_out, a3ui32 const maxCount, a3_DemoBVH const* bvh, a3f32 const min[3], a3f32 const max[3]);
+
+// nearest object whose bounds are hit by ray
+//	hit_out: receives object index
+//	distance_out_opt: receives distance along direction to bounds
+//	maxDistance: farthest hit accepted
+//	return: 1 if hit; 0 if not; -1 if invalid
+a3ret a3demo_bvhQueryRay(a3ui32* hit_out, a3f32* distance_out_opt, a3_DemoBVH const* bvh,
+	a3f32 const origin[3], a3f32 const direction[3], a3f32 const maxDistance);
+
+// time building, refitting and querying hierarchies of random objects
+//	planes: frustum for timing frustum queries
+//	count: number of objects to generate
+//	pool: workers that help build; null to build on caller only
+//	threadCountMax: most threads to build with
+//	return: number of nodes; 0 if failed; -1 if invalid
+a3ret a3demo_bvhReport(a3f32 const planes[6][4], a3ui32 const count, a3_DemoWorkerPool* pool, a3ui32 const threadCountMax);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOBVH_H
@@ -0,0 +1,107 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoCulling.h
+	Object visibility culling: world-space bounding spheres of scene 
+		objects are kept component by component and tested against frustum
+		planes four or eight at a time, producing a compact list of objects
+		to draw for each pass.
+*/
+
+#ifndef __ANIMAL3D_DEMOCULLING_H
+#define __ANIMAL3D_DEMOCULLING_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DG/animal3D-A3DG.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef struct a3_DemoCullSpheres						a3_DemoCullSpheres;
+typedef struct a3_DemoCullStats							a3_DemoCullStats;
+typedef enum a3_DemoCullSphereComponent				a3_DemoCullSphereComponent;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// components of world-space sphere, each kept in its own array
+enum a3_DemoCullSphereComponent
+{
+	demoCullSphere_centerX,
+	demoCullSphere_centerY,
+	demoCullSphere_centerZ,
+	demoCullSphere_radius,
+
+	demoCullSphere_max
+};
+
+// spheres to be culled; arrays are provided by the user
+struct a3_DemoCullSpheres
+{
+	a3f32* component[demoCullSphere_max];	// one array per component
+	a3ui32 count;							// number of spheres in use
+};
+
+// results of culling one pass
+struct a3_DemoCullStats
+{
+	a3ui32 tested, culled;
+};
+
+
+//-----------------------------------------------------------------------------
+
+// transform object-space bounds to world space and store their sphere
+//	index: which sphere to write; count is not changed
+//	modelMat_opt: object's model matrix; null if bounds are in world space
+void a3demo_cullStoreSphere(a3_DemoCullSpheres* spheres, a3ui32 const index, a3_VertexBounds const* bounds, a3real const* modelMat_opt);
+
+// test spheres against normalized frustum planes (see 
+//	'a3demo_geometryMeshletFrustum'; pass view-projection for world-space 
+//	planes) using the widest vector instructions the build selects
+//	visible_out: receives indices of spheres that may be visible; must 
+//		hold as many entries as there are spheres
+//	return: number of spheres visible; -1 if invalid
+a3ret a3demo_cullSpheres(a3ui32* visible_out, a3_DemoCullStats* stats_out_opt, a3_DemoCullSpheres const* spheres, a3f32 const planes[6][4]);
+
+// time culling of random spheres against planes at each vector width
+//	count: number of spheres to generate
+//	return: number of spheres visible; 0 if failed; -1 if invalid
+a3ret a3demo_cullReport(a3f32 const planes[6][4], a3ui32 const count);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOCULLING_H
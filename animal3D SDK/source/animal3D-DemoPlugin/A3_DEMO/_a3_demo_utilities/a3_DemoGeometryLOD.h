@@ -0,0 +1,108 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoGeometryLOD.h
+	Level-of-detail generation for indexed triangle geometry: edges are
+		collapsed in order of quadric error onto existing vertices, so
+		normals, texture coordinates and skin weights are kept as-is;
+		levels are selected at runtime by their projected error.
+*/
+
+#ifndef __ANIMAL3D_DEMOGEOMETRYLOD_H
+#define __ANIMAL3D_DEMOGEOMETRYLOD_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DG/animal3D-A3DG.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef struct a3_DemoGeometryLOD						a3_DemoGeometryLOD;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// level of detail limits
+enum a3_DemoGeometryLODMaxCount
+{
+	demoGeometryLODMaxCount_level = 8,		// including base level
+};
+
+// default projected error, in pixels, allowed when selecting a level
+#define a3demo_geometryLODPixelError	1.0f
+
+// description of a chain of levels, base level first
+struct a3_DemoGeometryLOD
+{
+	a3ui32 levelCount;
+	a3ui32 triangleCount[demoGeometryLODMaxCount_level];
+	a3f32 error[demoGeometryLODMaxCount_level];	// object-space distance
+};
+
+
+//-----------------------------------------------------------------------------
+
+// simplify geometry by collapsing edges until a fraction of its triangles
+//	remain or the error limit is reached; the result holds only the source
+//	vertices still in use; vertices shared by several attribute sets (UV or
+//	normal seams) and vertices on open borders are never removed
+//	ratio: fraction of triangles to keep
+//	errorLimit: largest object-space error allowed; zero for no limit
+//	error_out_opt: object-space error of result
+//	return: 1 if success; 0 if not indexed triangles or failed; -1 if invalid
+a3ret a3demo_geometrySimplify(a3_GeometryData* geom_out, a3_GeometryData const* geom,
+	a3f32 const ratio, a3f32 const errorLimit, a3f32* error_out_opt);
+
+// generate a chain of levels, each simplified from the one before
+//	levels_out: receives one simplified geometry per ratio
+//	ratios: decreasing fractions of the source triangle count
+//	return: number of levels generated, excluding base; -1 if invalid
+//		(description is cleared either way)
+a3ret a3demo_geometryGenerateLOD(a3_DemoGeometryLOD* lod_out, a3_GeometryData* levels_out, a3_GeometryData const* geom,
+	a3f32 const* ratios, a3ui32 const ratioCount);
+
+// select the coarsest level whose error projects to at most some pixels
+//	distance: view distance to object
+//	scale: object scale
+//	projectionScale: pixels per unit at unit distance (half of viewport
+//		height times the projection's vertical scale)
+//	return: level index; 0 for base
+a3ui32 a3demo_geometrySelectLOD(a3_DemoGeometryLOD const* lod, a3real const distance, a3real const scale,
+	a3real const projectionScale, a3real const pixelError);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOGEOMETRYLOD_H
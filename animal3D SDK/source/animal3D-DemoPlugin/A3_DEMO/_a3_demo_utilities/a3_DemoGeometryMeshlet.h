@@ -0,0 +1,134 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoGeometryMeshlet.h
+	Cluster (meshlet) tables for indexed triangle geometry: triangles are
+		grouped into small connected clusters, each with its own vertex
+		list, bounding sphere and normal cone, so that whole clusters can
+		be rejected outside the view frustum or facing away from the viewer.
+*/
+
+#ifndef __ANIMAL3D_DEMOGEOMETRYMESHLET_H
+#define __ANIMAL3D_DEMOGEOMETRYMESHLET_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DG/animal3D-A3DG.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef struct a3_DemoGeometryMeshlet					a3_DemoGeometryMeshlet;
+typedef struct a3_DemoGeometryMeshlets					a3_DemoGeometryMeshlets;
+typedef struct a3_DemoGeometryMeshletCullStats			a3_DemoGeometryMeshletCullStats;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// cluster limits; defaults suit mesh shader output limits
+enum a3_DemoGeometryMeshletMaxCount
+{
+	demoGeometryMeshletMaxCount_vertex = 64,	// unique vertices per cluster
+	demoGeometryMeshletMaxCount_triangle = 124,	// triangles per cluster
+	demoGeometryMeshletMaxCount_vertexLimit = 256,	// local indices are bytes
+};
+
+// one cluster: ranges in the shared tables and culling data
+struct a3_DemoGeometryMeshlet
+{
+	a3ui32 vertexOffset, vertexCount;		// range in vertex table
+	a3ui32 triangleOffset, triangleCount;	// range in triangle table
+	a3f32 center[3], radius;				// bounding sphere
+	a3f32 coneAxis[3], coneCutoff;			// normal cone; see culling
+};
+
+// clusters of one geometry with shared tables, in one allocation
+struct a3_DemoGeometryMeshlets
+{
+	a3ui32 meshletCount, vertexCount, triangleCount;
+	a3_DemoGeometryMeshlet* meshlet;		// clusters
+	a3ui32* vertex;							// geometry vertex index per entry
+	a3ubyte* triangle;						// three cluster-local vertices
+											//	per triangle
+};
+
+// results of culling clusters
+struct a3_DemoGeometryMeshletCullStats
+{
+	a3ui32 meshletCount, triangleCount;		// total
+	a3ui32 meshletFrustum, triangleFrustum;	// rejected outside frustum
+	a3ui32 meshletCone, triangleCone;		// rejected facing away
+};
+
+
+//-----------------------------------------------------------------------------
+
+// group triangles into connected clusters, adding triangles that bring the
+//	fewest new vertices; index order is used for seeds, so optimizing for
+//	vertex cache first gives tighter clusters
+//	maxVertices, maxTriangles: cluster limits; zero for defaults
+//	return: number of clusters; 0 if not indexed triangles or failed;
+//		-1 if invalid
+a3ret a3demo_geometryBuildMeshlets(a3_DemoGeometryMeshlets* meshlets_out, a3_GeometryData const* geom,
+	a3ui32 maxVertices, a3ui32 maxTriangles);
+
+// release cluster tables
+//	return: 1 if released; 0 if not built; -1 if invalid
+a3ret a3demo_geometryReleaseMeshlets(a3_DemoGeometryMeshlets* meshlets);
+
+// write cluster tables to file stream
+//	return: bytes written; -1 if invalid
+a3ret a3demo_geometrySaveMeshletsBinary(a3_DemoGeometryMeshlets const* meshlets, a3_FileStream const* fileStream);
+
+// read cluster tables from file stream
+//	return: bytes read; 0 if stream holds no tables; -1 if invalid
+a3ret a3demo_geometryLoadMeshletsBinary(a3_DemoGeometryMeshlets* meshlets_out, a3_FileStream const* fileStream);
+
+// extract normalized object-space frustum planes (left, right, bottom,
+//	top, near, far) from a column-major model-view-projection matrix;
+//	points inside satisfy dot(plane.xyz, p) + plane.w >= 0
+void a3demo_geometryMeshletFrustum(a3f32 planes_out[6][4], a3real const* modelViewProjection);
+
+// cull clusters against frustum and normal cones
+//	visible_out_opt: indices of clusters to draw
+//	planes: object-space frustum
+//	eye: object-space viewer position
+//	return: number of clusters visible; -1 if invalid
+a3ret a3demo_geometryCullMeshlets(a3ui32* visible_out_opt, a3_DemoGeometryMeshletCullStats* stats_out_opt,
+	a3_DemoGeometryMeshlets const* meshlets, a3f32 const planes[6][4], a3real const* eye);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOGEOMETRYMESHLET_H
@@ -0,0 +1,117 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoGeometryOptimize.h
+	Index and vertex reordering for indexed triangle geometry: triangles
+		are reordered for the post-transform vertex cache (Tipsify),
+		clustered and sorted to reduce overdraw, then vertices are
+		reordered to match first use so fetches are sequential.
+*/
+
+#ifndef __ANIMAL3D_DEMOGEOMETRYOPTIMIZE_H
+#define __ANIMAL3D_DEMOGEOMETRYOPTIMIZE_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DG/animal3D-A3DG.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef struct a3_DemoGeometryCacheStats				a3_DemoGeometryCacheStats;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// optimizer defaults
+enum a3_DemoGeometryOptimizeDefault
+{
+	demoGeometryOptimizeDefault_cacheSize = 16,	// FIFO entries simulated
+};
+
+// default ratio of cluster to mesh cache miss rate allowed when splitting
+//	triangles into clusters for overdraw; higher gives more, smaller clusters
+#define a3demo_geometryOptimizeOverdrawThreshold	1.05
+
+// vertex cache efficiency of some geometry, simulating a FIFO cache
+struct a3_DemoGeometryCacheStats
+{
+	a3ui32 triangleCount;					// triangles drawn
+	a3ui32 vertexCount;						// distinct vertices referenced
+	a3ui32 invocations;						// vertex shader invocations (misses)
+	a3f64 acmr;								// average cache miss ratio:
+											//	invocations per triangle (0.5 to 3)
+	a3f64 atvr;								// average transform to vertex ratio:
+											//	invocations per vertex (1 is ideal)
+};
+
+
+//-----------------------------------------------------------------------------
+
+// simulate drawing geometry through a FIFO post-transform cache
+//	cacheSize: entries in cache; zero for default
+//	return: 1 if success; 0 if not triangles; -1 if invalid
+a3ret a3demo_geometryAnalyzeVertexCache(a3_DemoGeometryCacheStats* stats_out, a3_GeometryData const* geom, a3ui32 cacheSize);
+
+// reorder triangles to reuse transformed vertices (Tipsify)
+//	cacheSize: entries in target cache; zero for default
+//	return: 1 if success; 0 if not indexed triangles; -1 if invalid
+a3ret a3demo_geometryOptimizeVertexCache(a3_GeometryData* geom, a3ui32 cacheSize);
+
+// split cache-ordered triangles into clusters at cache flushes and where
+//	the local miss rate allows, then draw outward-facing clusters first so
+//	they occlude the rest; call after optimizing for vertex cache
+//	cacheSize: entries in target cache; zero for default
+//	threshold: allowed cluster miss rate relative to the mesh's;
+//		values at or below 1 keep the order as-is
+//	return: number of clusters; 0 if not indexed triangles; -1 if invalid
+a3ret a3demo_geometryOptimizeOverdraw(a3_GeometryData* geom, a3ui32 cacheSize, a3f64 const threshold);
+
+// reorder vertex attributes in order of first use by indices, so that
+//	vertices are fetched sequentially; unused vertices move to the end
+//	return: 1 if success; 0 if not indexed; -1 if invalid
+a3ret a3demo_geometryOptimizeVertexFetch(a3_GeometryData* geom);
+
+// run all of the above in order
+//	return: 1 if success; 0 if not indexed triangles; -1 if invalid
+a3ret a3demo_geometryOptimize(a3_GeometryData* geom, a3ui32 const cacheSize, a3f64 const threshold);
+
+// optimize a copy of geometry and print cache efficiency before and after
+//	return: 1 if success; 0 if not indexed triangles; -1 if invalid
+a3ret a3demo_geometryOptimizeReport(a3_GeometryData const* geom, a3byte const* name, a3ui32 const cacheSize);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOGEOMETRYOPTIMIZE_H
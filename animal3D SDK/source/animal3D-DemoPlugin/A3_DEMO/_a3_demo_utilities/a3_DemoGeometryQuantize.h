@@ -0,0 +1,100 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoGeometryQuantize.h
+	Vertex attribute quantization: float geometry is encoded into the
+		compact vertex format (16-bit positions and texture coordinates
+		within the mesh bounds, 16-bit octahedral normal and tangent
+		basis, half-float colors, 16-bit blend weights); vertex shaders
+		restore attributes using the utilities in 'utilCommon_vs4x'.
+*/
+
+#ifndef __ANIMAL3D_DEMOGEOMETRYQUANTIZE_H
+#define __ANIMAL3D_DEMOGEOMETRYQUANTIZE_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DG/animal3D-A3DG.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef struct a3_DemoGeometryDequantize				a3_DemoGeometryDequantize;
+typedef struct a3_DemoGeometryQuantizeError				a3_DemoGeometryQuantizeError;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// per-mesh transform restoring quantized attributes, laid out as uniforms:
+//	position = attribute * positionScale + positionBias (w becomes 1)
+//	texcoord = attribute * texcoordTransform.xy + texcoordTransform.zw
+struct a3_DemoGeometryDequantize
+{
+	a3f32 positionScale[4];
+	a3f32 positionBias[4];
+	a3f32 texcoordTransform[4];
+};
+
+// largest difference between source and decoded attributes
+struct a3_DemoGeometryQuantizeError
+{
+	a3f32 position;							// object-space distance
+	a3f32 normal;							// angle in degrees
+	a3f32 tangent;							// angle in degrees, tangent or bitangent
+	a3f32 texcoord;							// texture-space distance
+	a3f32 color;							// largest component difference
+	a3f32 blendWeight;						// largest weight difference
+};
+
+
+//-----------------------------------------------------------------------------
+
+// encode float geometry into the quantized vertex format; indices are kept
+//	dequantize_out: receives transform to pass to shaders
+//	bounds_opt: transform to encode with instead of this mesh's bounds, so
+//		that related meshes (e.g. levels of detail) can share uniforms;
+//		values outside are clamped
+//	error_out_opt: largest error of each attribute after decoding
+//	return: 1 if success; 0 if not float format or failed; -1 if invalid
+a3ret a3demo_geometryQuantize(a3_GeometryData* geom_out, a3_DemoGeometryDequantize* dequantize_out, a3_GeometryData const* geom,
+	a3_DemoGeometryDequantize const* bounds_opt, a3_DemoGeometryQuantizeError* error_out_opt);
+
+// quantize a copy of geometry and print sizes and largest errors
+//	return: 1 if success; 0 if not float format; -1 if invalid
+a3ret a3demo_geometryQuantizeReport(a3_GeometryData const* geom, a3byte const* name);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOGEOMETRYQUANTIZE_H
@@ -0,0 +1,67 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoGeometryTangent.h
+	Tangent basis benchmark: compares the batched, threaded tangent basis
+		generator in the geometry library against the face-at-a-time
+		accumulation it replaces, for speed and agreement.
+*/
+
+#ifndef __ANIMAL3D_DEMOGEOMETRYTANGENT_H
+#define __ANIMAL3D_DEMOGEOMETRYTANGENT_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+
+#include "a3_DemoWorkerPool.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// recalculate the tangent basis of copies of geometry, once face at a time
+//	and once batched for each task count up to the limit (doubling), then
+//	print times and largest angle between results
+//	taskCountMax: largest number of tasks to try; at least 1
+//	pool: workers that run the tasks; null to run them all on caller
+//	return: 1 if success; 0 if geometry has no float tangent basis;
+//		-1 if invalid
+a3ret a3demo_geometryTangentReport(a3_GeometryData const* geom, a3byte const* name, a3ui32 taskCountMax, a3_DemoWorkerPool* pool);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOGEOMETRYTANGENT_H
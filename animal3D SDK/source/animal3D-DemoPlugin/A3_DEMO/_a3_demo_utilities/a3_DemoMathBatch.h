@@ -0,0 +1,94 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMathBatch.h
+	Batch dispatch: splits A3DM batch functions into ranges run by
+		worker threads; also measures their throughput.
+*/
+
+#ifndef __ANIMAL3D_DEMOMATHBATCH_H
+#define __ANIMAL3D_DEMOMATHBATCH_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+#include "a3_DemoWorkerPool.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// dispatch limits
+enum a3_DemoMathBatchSize
+{
+	demoMathSize_thread = 8,					// ranges, so threads including caller
+	demoMathSize_group = 4,						// items per range multiple
+};
+
+
+// batch function run by dispatch: processes items [first, first + count) of 
+//	the arrays described by args
+typedef void(*a3_DemoMathBatchFunc)(void const* args, a3ui32 first, a3ui32 count);
+
+
+//-----------------------------------------------------------------------------
+
+// split a batch into one contiguous range per thread, each a multiple of 
+//	the SIMD group size except the last, so no two threads write the same 
+//	item; pool workers and caller run the ranges, and caller waits for all
+//	func: batch function
+//	args: arrays passed to each call of func
+//	count: number of items
+//	pool: workers that help the caller; null to run on caller only
+//	threadCount: ranges, at most demoMathSize_thread; the most threads, 
+//		including caller, that can work at once
+//	return: number of ranges run if success; -1 if invalid
+a3ret a3demo_mathBatchDispatch(a3_DemoMathBatchFunc func, void const* args, a3ui32 count, a3_DemoWorkerPool* pool, a3ui32 threadCount);
+
+// run A3DM batch functions over one large array of random transforms, 
+//	first as per-item calls, then through dispatch on 1, 2, 4 and 8 threads,
+//	and print throughput and largest difference from per-item results
+//	count: number of items per kernel; large enough to amortize threads
+//	passCount: number of times each kernel runs over all items
+//	pool: workers for dispatch; null to run on caller only
+//	return: 1 if success; 0 if allocation failed; -1 if invalid
+a3ret a3demo_mathBatchReport(a3ui32 count, a3ui32 passCount, a3_DemoWorkerPool* pool);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOMATHBATCH_H
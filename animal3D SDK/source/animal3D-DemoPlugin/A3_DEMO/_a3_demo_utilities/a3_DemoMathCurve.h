@@ -0,0 +1,76 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMathCurve.h
+	Curve follower benchmark: compares arc length lookups for followers
+		of a rail.
+*/
+
+#ifndef __ANIMAL3D_DEMOMATHCURVE_H
+#define __ANIMAL3D_DEMOMATHCURVE_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+#include "a3_DemoWorkerPool.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// curve report limits
+enum a3_DemoMathCurveSize
+{
+	demoMathSize_curveDivisions = 256,			// intervals in curve tables
+};
+
+
+// place followers at random distances along a Catmull-Rom rail segment, 
+//	first by stepping through its arc length table from the start, then by 
+//	bisection, then with a table resampled to evenly spaced arc lengths and 
+//	batch curve evaluation through dispatch on 1, 2, 4 and 8 threads; print 
+//	throughput and largest difference from stepping results
+//	count: number of followers
+//	passCount: number of times each path places all followers
+//	pool: workers for dispatch; null to run on caller only
+//	return: 1 if success; 0 if allocation failed; -1 if invalid
+a3ret a3demo_mathCurveReport(a3ui32 count, a3ui32 passCount, a3_DemoWorkerPool* pool);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOMATHCURVE_H
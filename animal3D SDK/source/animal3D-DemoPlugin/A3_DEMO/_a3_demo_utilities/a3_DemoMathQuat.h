@@ -0,0 +1,69 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMathQuat.h
+	Rotation benchmark: compares Euler and quaternion transforms and
+		quaternion interpolation.
+*/
+
+#ifndef __ANIMAL3D_DEMOMATHQUAT_H
+#define __ANIMAL3D_DEMOMATHQUAT_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+#include "a3_DemoWorkerPool.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// build random scaled transforms from Euler angles per item, then from 
+//	matching quaternions per item and as a batch through dispatch on 1, 2, 
+//	4 and 8 threads; then slerp random rotation pairs per item, and with 
+//	slerp and nlerp batches through dispatch; print throughput and largest 
+//	difference from Euler and per-item slerp results
+//	count: number of transforms and rotation pairs
+//	passCount: number of times each path runs over all items
+//	pool: workers for dispatch; null to run on caller only
+//	return: 1 if success; 0 if allocation failed; -1 if invalid
+a3ret a3demo_mathQuatReport(a3ui32 count, a3ui32 passCount, a3_DemoWorkerPool* pool);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOMATHQUAT_H
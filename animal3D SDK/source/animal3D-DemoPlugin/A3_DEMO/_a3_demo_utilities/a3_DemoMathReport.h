@@ -0,0 +1,82 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMathReport.h
+	Math kernel benchmark: times the A3DM vector and matrix functions,
+		built for the instruction set selected in 'a3simd.h', against
+		plain scalar loops, and checks that their results agree; also
+		random inputs, comparisons and printing shared by math reports.
+*/
+
+#ifndef __ANIMAL3D_DEMOMATHREPORT_H
+#define __ANIMAL3D_DEMOMATHREPORT_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// random value in [-1, 1]
+a3f32 a3demo_mathRandom();
+
+// random matrix, diagonally dominant so it is safely invertible
+void a3demo_mathRandomMatrix(a3real4x4p m_out);
+
+// largest element difference between float arrays
+a3f64 a3demo_mathDiff(a3f32 const* a, a3f32 const* b, a3ui32 count);
+
+// print throughput of one path in millions of items per second
+void a3demo_mathPrintRate(a3byte const* name, a3f64 const items, a3f64 const time);
+
+
+// run each kernel over arrays of random well-conditioned inputs, once with
+//	scalar loops and once with A3DM (plain and aligned variants where they
+//	exist), then print times and largest difference from scalar results; 
+//	also time each transform inverse (rigid, uniform scale, scale per axis, 
+//	skewed) against the general inverse of matching transforms
+//	count: number of inputs per kernel; a count small enough to stay in 
+//		cache measures arithmetic rather than memory
+//	passCount: number of times each kernel runs over all inputs
+//	return: 1 if success; 0 if allocation failed; -1 if invalid
+a3ret a3demo_mathReport(a3ui32 count, a3ui32 passCount);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOMATHREPORT_H
@@ -0,0 +1,66 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMathSqrt.h
+	Square root benchmark: compares fast inverse square roots and batch
+		normalization.
+*/
+
+#ifndef __ANIMAL3D_DEMOMATHSQRT_H
+#define __ANIMAL3D_DEMOMATHSQRT_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// take inverse square roots of random inputs with square root and divide, 
+//	Quake's method, and the fast hardware path per item and as a batch at 
+//	each precision; then make random 3D vectors unit length per item, with 
+//	the exact batch and with batch normalize at each precision; print 
+//	throughput and largest relative error; restores the precision
+//	count: number of inputs and vectors
+//	passCount: number of times each path runs over all inputs
+//	return: 1 if success; 0 if allocation failed; -1 if invalid
+a3ret a3demo_mathSqrtReport(a3ui32 count, a3ui32 passCount);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOMATHSQRT_H
@@ -0,0 +1,65 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMathStats.h
+	Statistics benchmark: compares sorting, selection and streaming
+		statistics of frame times.
+*/
+
+#ifndef __ANIMAL3D_DEMOMATHSTATS_H
+#define __ANIMAL3D_DEMOMATHSTATS_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// get 50th, 95th and 99th percentiles of random frame times by sorting, by 
+//	selection and with a streaming histogram, and mean and variance with 
+//	running statistics; print throughput and difference from sorted and 
+//	double-precision results
+//	count: number of frame times
+//	passCount: number of times each path runs over all frame times
+//	return: 1 if success; 0 if allocation failed; -1 if invalid
+a3ret a3demo_mathStatsReport(a3ui32 count, a3ui32 passCount);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOMATHSTATS_H
@@ -0,0 +1,66 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMathTrig.h
+	Trig benchmark: compares A3DM trig tables and polynomials with libm.
+*/
+
+#ifndef __ANIMAL3D_DEMOMATHTRIG_H
+#define __ANIMAL3D_DEMOMATHTRIG_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// run libm, A3DM trig tables, and A3DM polynomials per item and as batches 
+//	at each accuracy tier over random inputs, then print throughput and 
+//	largest error from double-precision libm results; restores the tier
+//	count: number of inputs per function
+//	passCount: number of times each function runs over all inputs
+//	trigTable: tables built by a3trigInit, set before timing them; null to 
+//		skip tables
+//	samplesPerDegree: samples per degree the tables were built with
+//	return: 1 if success; 0 if allocation failed; -1 if invalid
+a3ret a3demo_mathTrigReport(a3ui32 count, a3ui32 passCount, a3real const* trigTable, a3ui32 samplesPerDegree);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOMATHTRIG_H
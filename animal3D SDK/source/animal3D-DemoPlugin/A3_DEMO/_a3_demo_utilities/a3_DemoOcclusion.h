@@ -0,0 +1,154 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoOcclusion.h
+	Software occlusion culling: simplified occluder meshes are rasterized
+		into a small depth-only buffer, split into tiles that worker threads
+		fill several pixels at a time; object bounding boxes are then tested
+		against a hierarchy of farthest depths built from the buffer.
+*/
+
+#ifndef __ANIMAL3D_DEMOOCCLUSION_H
+#define __ANIMAL3D_DEMOOCCLUSION_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DG/animal3D-A3DG.h"
+
+#include "a3_DemoWorkerPool.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef struct a3_DemoOccluderMesh						a3_DemoOccluderMesh;
+typedef struct a3_DemoOcclusionBuffer					a3_DemoOcclusionBuffer;
+typedef struct a3_DemoOcclusionStats					a3_DemoOcclusionStats;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// buffer limits
+enum a3_DemoOcclusionSize
+{
+	demoOcclusionSize_tile = 32,				// tile width and height in pixels
+	demoOcclusionSize_level = 12,				// depth hierarchy levels
+	demoOcclusionSize_thread = 8,				// shares of tiles
+	demoOcclusionSize_triangle = 16,			// floats of setup per triangle
+};
+
+// occluder: positions and triangle indices only, in one allocation
+struct a3_DemoOccluderMesh
+{
+	a3ui32 vertexCount, triangleCount;
+	a3f32* position;							// three per vertex
+	a3ui32* index;								// three per triangle
+};
+
+// depth-only buffer; depth is normalized device z, cleared to far (+1);
+//	rows start at the bottom of the screen
+struct a3_DemoOcclusionBuffer
+{
+	a3ui32 width, height;						// multiples of tile size
+	a3ui32 tileCountX, tileCountY, levelCount;
+	a3f32* level[demoOcclusionSize_level];		// depth, then farthest depth
+												//	of each 2x2 below it
+	a3ui32 levelWidth[demoOcclusionSize_level], levelHeight[demoOcclusionSize_level];
+
+	// triangles set up for rasterizing and their tile bins
+	a3f32* triangle;
+	a3f32* clip;								// transformed occluder vertices
+	a3ui32* binIndex;							// triangles, tile by tile
+	a3ui32* binOffset;							// first of each tile, and end
+	a3ui32 triangleCount, triangleCapacity, clipCapacity, binCapacity;
+};
+
+// results of one frame
+struct a3_DemoOcclusionStats
+{
+	a3ui32 occluderCount, triangleCount;		// occluder triangles submitted
+	a3ui32 triangleDrawn;						// in front of viewer and facing it
+	a3ui32 tested, occluded;					// objects tested and hidden
+	a3f64 rasterTime;							// seconds to rasterize
+};
+
+
+//-----------------------------------------------------------------------------
+
+// copy positions and indices of indexed triangle geometry as an occluder;
+//	the geometry should lie inside the object it stands for
+//	return: number of triangles; 0 if not indexed triangles or failed;
+//		-1 if invalid
+a3ret a3demo_occlusionBuildOccluder(a3_DemoOccluderMesh* occluder_out, a3_GeometryData const* geom);
+
+// release occluder
+//	return: 1 if released; 0 if not built; -1 if invalid
+a3ret a3demo_occlusionReleaseOccluder(a3_DemoOccluderMesh* occluder);
+
+// allocate buffer and depth hierarchy
+//	width, height: rounded up to whole tiles
+//	return: 1 if created; 0 if failed; -1 if invalid
+a3ret a3demo_occlusionCreate(a3_DemoOcclusionBuffer* buffer_out, a3ui32 width, a3ui32 height);
+
+// release buffer
+//	return: 1 if released; 0 if not created; -1 if invalid
+a3ret a3demo_occlusionRelease(a3_DemoOcclusionBuffer* buffer);
+
+// remove all triangles to start a new frame
+//	return: 1 if cleared; -1 if invalid
+a3ret a3demo_occlusionClear(a3_DemoOcclusionBuffer* buffer);
+
+// transform occluder and set up its triangles for rasterizing; triangles
+//	facing away, off screen or crossing the near plane are skipped, which
+//	can only let objects through, never hide them wrongly
+//	modelViewProjection: occluder's column-major clip transform
+//	return: number of triangles added; -1 if invalid
+a3ret a3demo_occlusionAddOccluder(a3_DemoOcclusionBuffer* buffer, a3_DemoOccluderMesh const* occluder, a3real const* modelViewProjection);
+
+// bin triangles to tiles, rasterize tiles on worker threads and build
+//	depth hierarchy
+//	pool: workers that help the caller; null to rasterize on caller only
+//	threadCount: number of shares tiles are dealt into, so the most
+//		threads, including the caller, that can work at once
+//	return: number of triangles rasterized; -1 if invalid
+a3ret a3demo_occlusionRasterize(a3_DemoOcclusionBuffer* buffer, a3_DemoWorkerPool* pool, a3ui32 threadCount);
+
+// test object-space bounding box against depth hierarchy
+//	modelViewProjection: object's column-major clip transform
+//	return: 1 if box may be visible; 0 if hidden; -1 if invalid
+a3ret a3demo_occlusionTestBounds(a3_DemoOcclusionBuffer const* buffer, a3_VertexBounds const* bounds, a3real const* modelViewProjection);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOOCCLUSION_H
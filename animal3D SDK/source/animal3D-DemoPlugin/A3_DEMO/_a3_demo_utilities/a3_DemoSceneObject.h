@@ -40,6 +40,7 @@ typedef struct a3_ModelMatrixStack						a3_ModelMatrixStack;
 typedef struct a3_ProjectorMatrixStack					a3_ProjectorMatrixStack;
 
 typedef enum a3_ScaleMode								a3_ScaleMode;
+typedef enum a3_RotateMode								a3_RotateMode;
 typedef struct a3_SceneObjectData						a3_SceneObjectData;
 typedef struct a3_PointLightData						a3_PointLightData;
 typedef struct a3_ProjectorData							a3_ProjectorData;
@@ -85,13 +86,22 @@ enum a3_ScaleMode
 	a3scale_nonuniform,
 };
 
+// named rotation modes
+enum a3_RotateMode
+{
+	a3rotate_euler,
+	a3rotate_quaternion,
+};
+
 // scene object descriptor
 struct a3_SceneObjectData
 {
 	a3vec4 position;		// scene position for direct control
 	a3vec4 euler;			// euler angles for direct rotation control
+	a3quat rotation;		// unit quaternion rotation, used instead of euler if enabled
 	a3vec3 scale;			// scale (not accounted for in update, use separate utilities)
 	a3_ScaleMode scaleMode;	// 0 = off; 1 = uniform; other = non-uniform (nightmare)
+	a3_RotateMode rotateMode;	// 0 = euler (trig every update); 1 = quaternion (no trig)
 };
 struct a3_SceneObjectComponent
 {
@@ -164,6 +174,11 @@ inline void a3demo_moveProjectorSceneObject(a3_ProjectorComponent const* project
 // update model matrix and inverse only using object's transformation data
 inline void a3demo_updateSceneObject(a3_SceneObjectComponent const* sceneObject, const a3boolean useZYX);
 
+// update model matrices and inverses of consecutive scene objects; those 
+//	using quaternion rotation are converted together by the A3DM batch
+//	(see 'a3quatConvertToMat4TRSBatch'), the rest one at a time as above
+void a3demo_updateSceneObjectArray(a3_SceneObjectComponent const* sceneObjectArray, a3ui32 const count, const a3boolean useZYX);
+
 // update projection and inverse matrices only
 inline void a3demo_updateProjector(a3_ProjectorComponent const* projector);
 
@@ -174,6 +189,10 @@ inline void a3demo_updateProjectorViewMats(a3_ProjectorComponent const* projecto
 // update scene object's full stack given scene object with updated model matrices and reference projector with updated projection matrix
 inline void a3demo_updateSceneObjectStack(a3_SceneObjectComponent const* sceneObject, a3_ProjectorComponent const* projector_active);
 
+// update full stacks of consecutive scene objects as above; products are 
+//	taken together by the A3DM batch (see 'a3real4x4ProductBatch')
+void a3demo_updateSceneObjectStackArray(a3_SceneObjectComponent const* sceneObjectArray, a3ui32 const count, a3_ProjectorComponent const* projector_active);
+
 // update projection bias matrices given projector with updated projection and view-projection matrices
 inline void a3demo_updateProjectorBiasMats(a3_ProjectorComponent const* projector, a3mat4 const bias, a3mat4 const biasInv);
 
@@ -0,0 +1,129 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoShaderCache.h
+	Hashed shader program binary cache for demo state; programs whose
+		sources, stages and driver have not changed are loaded from disk
+		instead of being compiled and linked again.
+*/
+
+#ifndef __ANIMAL3D_DEMOSHADERCACHE_H
+#define __ANIMAL3D_DEMOSHADERCACHE_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/a3/a3macros.h"
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DG/animal3D-A3DG.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef struct a3_DemoShaderCacheEntry					a3_DemoShaderCacheEntry;
+typedef struct a3_DemoShaderCache						a3_DemoShaderCache;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// cache limits
+enum a3_DemoShaderCacheMaxCount
+{
+	demoShaderCacheMaxCount_entry = 64,
+	demoShaderCacheMaxCount_pathLen = 128,
+};
+
+// record of one cached program binary
+struct a3_DemoShaderCacheEntry
+{
+	a3ui64 key;								// hash of everything the binary depends on
+	a3byte name[32];						// program name (one binary per name)
+	a3boolean used;							// touched during the current load
+};
+
+// cache state for one load pass
+struct a3_DemoShaderCache
+{
+	a3byte directory[demoShaderCacheMaxCount_pathLen];	// where binaries are kept
+	a3ui64 platformKey;						// hash of GL vendor, renderer and version
+	a3ui32 entryCount;						// number of entries in index
+	a3_DemoShaderCacheEntry entry[demoShaderCacheMaxCount_entry];
+
+	a3ui32 hitCount, missCount;				// programs loaded vs. compiled
+	a3f64 hitTime, missTime;				// total seconds spent on each path
+	a3boolean supported;					// driver exposes program binary formats
+};
+
+
+//-----------------------------------------------------------------------------
+
+// hash seed for cache keys
+#define a3demo_shaderCacheHashSeed	0xcbf29ce484222325ull
+
+// accumulate bytes into a running hash (64-bit FNV-1a)
+a3ui64 a3demo_shaderCacheHash(a3ui64 hash, void const* data, a3ui32 const size);
+
+// accumulate a null-terminated string into a running hash
+a3ui64 a3demo_shaderCacheHashString(a3ui64 hash, a3byte const* str);
+
+// accumulate the contents of a list of files into a running hash
+//	(missing files hash their path so the key still changes when they appear)
+a3ui64 a3demo_shaderCacheHashFileList(a3ui64 hash, a3byte const* const* filePathList, a3ui32 const count);
+
+// open cache in directory: reads index and hashes current GL platform
+//	return: 1 if cache usable; 0 if driver cannot save binaries; -1 if invalid
+a3ret a3demo_shaderCacheOpen(a3_DemoShaderCache* cache, a3byte const* directory);
+
+// combine a program's source key with the platform key
+a3ui64 a3demo_shaderCacheProgramKey(a3_DemoShaderCache const* cache, a3byte const* programName, a3ui64 const sourceKey);
+
+// try to load a created but unlinked program from the cache
+//	a stale binary stored under the same program name is evicted
+//	return: 1 if loaded and linked; 0 if miss (compile as usual); -1 if invalid
+a3ret a3demo_shaderCacheLoadProgram(a3_DemoShaderCache* cache, a3_ShaderProgram* program, a3ui64 const key);
+
+// store a freshly linked program in the cache
+//	return: 1 if stored; 0 if failed; -1 if invalid
+a3ret a3demo_shaderCacheStoreProgram(a3_DemoShaderCache* cache, a3_ShaderProgram const* program, a3ui64 const key);
+
+// record time spent producing a program (loaded or compiled)
+void a3demo_shaderCacheRecordTime(a3_DemoShaderCache* cache, a3_ShaderProgram const* program, a3boolean const hit, a3f64 const seconds);
+
+// close cache: evicts binaries of programs that no longer exist, writes
+//	index, prints summary and marks cache closed
+//	return: number of entries evicted; -1 if invalid
+a3ret a3demo_shaderCacheClose(a3_DemoShaderCache* cache);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOSHADERCACHE_H
@@ -86,6 +86,12 @@ struct a3_DemoStateShaderProgram
 			uColor0,					// color (used in whatever context is needed)
 			uColor;						// color (used in whatever context is needed)
 
+		a3i32
+			// quantized vertex format handles (see 'a3_DemoGeometryQuantize.h')
+			uPositionScale,				// position dequantization scale (w is 0)
+			uPositionBias,				// position dequantization bias (w is 1)
+			uTexcoordTransform;			// texcoord dequantization scale (xy) and bias (zw)
+
 		a3i32
 			// common texture handles
 			uTex_dm, uTex_sm,			// named texture map handles for basic shading
@@ -0,0 +1,114 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoShaderWatch.h
+	Shader source file watcher for demo state; maps each source file to the
+		programs that depend on it so only those are rebuilt when it changes.
+		Uses inotify on Linux and polls file times everywhere else.
+*/
+
+#ifndef __ANIMAL3D_DEMOSHADERWATCH_H
+#define __ANIMAL3D_DEMOSHADERWATCH_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef struct a3_DemoShaderWatchFile					a3_DemoShaderWatchFile;
+typedef struct a3_DemoShaderWatch						a3_DemoShaderWatch;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// watcher limits
+enum a3_DemoShaderWatchMaxCount
+{
+	demoShaderWatchMaxCount_file = 64,
+	demoShaderWatchMaxCount_directory = 16,
+	demoShaderWatchMaxCount_dependent = 64,	// bits in dependent mask
+	demoShaderWatchMaxCount_pathLen = 128,
+};
+
+// one watched source file
+struct a3_DemoShaderWatchFile
+{
+	a3byte path[demoShaderWatchMaxCount_pathLen];	// path as passed to loader
+	a3ui32 nameOffset;						// start of file name in path
+	a3ui32 directory;						// index of containing directory
+	a3i64 time, size;						// last known modification stamp
+	a3ui64 dependents;						// mask of programs using this file
+};
+
+// watcher state
+struct a3_DemoShaderWatch
+{
+	a3ui32 fileCount, directoryCount;
+	a3_DemoShaderWatchFile file[demoShaderWatchMaxCount_file];
+	a3byte directory[demoShaderWatchMaxCount_directory][demoShaderWatchMaxCount_pathLen];
+	a3i32 directoryWatch[demoShaderWatchMaxCount_directory];
+
+	a3i32 notify;							// inotify descriptor; -1 if polling
+	a3f64 pollInterval, pollTime;			// seconds between polls and since last
+};
+
+
+//-----------------------------------------------------------------------------
+
+// reset watcher and its dependency map
+//	pollInterval: seconds between file time checks when polling
+//	return: 1 if success; -1 if invalid
+a3ret a3demo_shaderWatchInit(a3_DemoShaderWatch* watch, a3f64 const pollInterval);
+
+// record that a dependent (program index) uses a source file
+//	return: 1 if added; 0 if out of space; -1 if invalid
+a3ret a3demo_shaderWatchAddDependency(a3_DemoShaderWatch* watch, a3byte const* filePath, a3ui32 const dependentIndex);
+
+// begin watching every file in the dependency map
+//	return: 1 if using change notifications; 0 if polling; -1 if invalid
+a3ret a3demo_shaderWatchStart(a3_DemoShaderWatch* watch);
+
+// check for changes since the last update
+//	return: mask of dependents whose files changed; 0 if none or invalid
+a3ui64 a3demo_shaderWatchUpdate(a3_DemoShaderWatch* watch, a3f64 const dt);
+
+// stop watching and clear dependency map
+//	return: 1 if success; -1 if invalid
+a3ret a3demo_shaderWatchRelease(a3_DemoShaderWatch* watch);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOSHADERWATCH_H
@@ -0,0 +1,118 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoSkinning.h
+	CPU skinning: deforms vertices by up to four weighted bones each, with
+		linear blend (LBS) or dual quaternion (DQS) skinning, split across
+		threads; also a throughput benchmark.
+*/
+
+#ifndef __ANIMAL3D_DEMOSKINNING_H
+#define __ANIMAL3D_DEMOSKINNING_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DG/animal3D-A3DG.h"
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+#include "a3_DemoWorkerPool.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef struct a3_DemoSkin					a3_DemoSkin;
+typedef enum a3_DemoSkinMode				a3_DemoSkinMode;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// skinning methods
+enum a3_DemoSkinMode
+{
+	demoSkin_linear,							// blend bone matrices (LBS)
+	demoSkin_dualQuat,							// blend bone dual quaternions (DQS)
+};
+
+
+// skinning job: bind pose, bones and output; every array is indexed by
+//	vertex except the bones
+struct a3_DemoSkin
+{
+	a3f32 const* position;						// bind pose positions, 3 each
+	a3f32 const* normal;						// bind pose normals, 3 each; null to skip
+	a3f32 const* weight;						// blend weights, 4 each, sum of 1
+	a3i32 const* index;							// blend indices, 4 each
+	a3mat4 const* skinMatrix;					// per bone, pose * inverse bind pose (LBS)
+	a3dualquat const* skinDualQuat;				// per bone, same transform as unit dual quaternion (DQS)
+	a3f32* position_out;						// skinned positions, 3 each
+	a3f32* normal_out;							// skinned normals, 3 each
+	a3ui32 vertexCount;
+};
+
+
+//-----------------------------------------------------------------------------
+
+// set skinning job's bind pose from geometry's position, normal and
+//	blending data; bones and output are left for the caller
+//	return: 1 if success; 0 if geometry has no blending data; -1 if invalid
+a3ret a3demo_skinInit(a3_DemoSkin* skin_out, a3_GeometryData const* geom);
+
+// skin vertices [first, first + count) of job; SIMD builds blend each
+//	vertex's bones across lanes and transform four vertices at a time;
+//	batch functions for dispatch (see 'a3demo_mathBatchDispatch')
+void a3demo_skinLinear(a3_DemoSkin const* skin, a3ui32 first, a3ui32 count);
+void a3demo_skinDualQuat(a3_DemoSkin const* skin, a3ui32 first, a3ui32 count);
+
+// skin all vertices of job, split across threads
+//	pool: workers that help the caller; null to run on caller only
+//	threadCount: ranges; the most threads, including caller, at once
+//	return: number of ranges run if success; -1 if invalid
+a3ret a3demo_skin(a3_DemoSkin const* skin, a3_DemoSkinMode const mode, a3_DemoWorkerPool* pool, a3ui32 threadCount);
+
+
+// skin random vertices by random bones, once per vertex with A3DM matrix
+//	and dual quaternion functions, then with each kernel through dispatch
+//	on 1, 2, 4 and 8 threads; print vertices per second, per second per
+//	thread and largest difference from per-vertex results
+//	vertexCount: number of vertices
+//	boneCount: number of bones
+//	passCount: number of times each kernel runs over all vertices
+//	pool: workers for dispatch; null to run on caller only
+//	return: 1 if success; 0 if allocation failed; -1 if invalid
+a3ret a3demo_skinReport(a3ui32 vertexCount, a3ui32 boneCount, a3ui32 passCount, a3_DemoWorkerPool* pool);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOSKINNING_H
@@ -0,0 +1,126 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoTextureCompress.h
+	Block-compression encoder for cooked textures (BC1, BC3, BC4, BC5);
+		encodes 8-bit images in 4x4 blocks, using SSE2 where available,
+		optionally splitting rows of blocks across worker threads.
+*/
+
+#ifndef __ANIMAL3D_DEMOTEXTURECOMPRESS_H
+#define __ANIMAL3D_DEMOTEXTURECOMPRESS_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DG/animal3D-A3DG.h"
+
+#include "a3_DemoWorkerPool.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef enum a3_DemoTextureCompression					a3_DemoTextureCompression;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// encoder limits
+enum a3_DemoTextureCompressMaxCount
+{
+	demoTextureCompressMaxCount_thread = 8,
+};
+
+// compression applied to a texture when it is cooked
+enum a3_DemoTextureCompression
+{
+	demoTextureCompression_none,			// keep decoded format
+	demoTextureCompression_color,			// BC1, or BC3 if source has alpha
+	demoTextureCompression_single,			// BC4 from red (e.g. height maps)
+	demoTextureCompression_normal,			// BC5 from red and green; blue dropped
+};
+
+
+//-----------------------------------------------------------------------------
+
+// get pixel type produced by compressing source with some channel count
+//	return: compressed pixel type; -1 if none or invalid
+a3ret a3demo_textureCompressType(a3_DemoTextureCompression const compression, a3ui32 const channels);
+
+// get number of source channels stored by a compressed pixel type
+//	return: channel count; 0 if not a compressed type
+a3ui32 a3demo_textureCompressChannels(a3_TexturePixelType const compressedType);
+
+// get size of a compressed image (whole blocks, even past the edges)
+//	return: bytes; 0 if not a compressed type
+a3ui32 a3demo_textureCompressSize(a3_TexturePixelType const compressedType, a3ui32 const width, a3ui32 const height);
+
+// convert 16-bit channels to 8-bit in place (encoder takes 8-bit data)
+void a3demo_textureCompressNarrow(void* data, a3ui32 const channelCount);
+
+// compress some rows of blocks of an 8-bit image (bottom row first)
+//	blockRowStart, blockRowEnd: range of block rows; rows are 4 pixels
+//	return: 1 if success; -1 if invalid
+a3ret a3demo_textureCompressRows(void* blocks_out, a3_TexturePixelType const compressedType, a3ubyte const* pixels,
+	a3ui32 const width, a3ui32 const height, a3ui32 const channels, a3ui32 const blockRowStart, a3ui32 const blockRowEnd);
+
+// compress a whole 8-bit image, splitting block rows across threads
+//	pool: workers that help the caller; null to compress on caller only
+//	threadCount: number of shares rows are dealt into, so the most 
+//		threads, including the caller, that can work at once
+//	return: 1 if success; -1 if invalid
+a3ret a3demo_textureCompress(void* blocks_out, a3_TexturePixelType const compressedType, a3ubyte const* pixels,
+	a3ui32 const width, a3ui32 const height, a3ui32 const channels, a3_DemoWorkerPool* pool, a3ui32 const threadCount);
+
+// decompress into an 8-bit image; only channels stored by the compressed
+//	type are written, others are left as they were
+//	return: 1 if success; -1 if invalid
+a3ret a3demo_textureDecompress(a3ubyte* pixels_inout, a3ui32 const channels, a3_TexturePixelType const compressedType,
+	void const* blocks, a3ui32 const width, a3ui32 const height);
+
+// peak signal-to-noise ratio between two 8-bit images over the first few
+//	channels of each pixel
+//	return: ratio in decibels; 99 if identical; 0 if invalid
+a3f64 a3demo_texturePSNR(a3ubyte const* pixels, a3ubyte const* reference, a3ui32 const width, a3ui32 const height,
+	a3ui32 const channels, a3ui32 const channelsCompared);
+
+// decode an image and report encode throughput and quality of each format
+//	split into 1, 2, 4 and 8 shares
+//	pool: workers that help the caller; null to compress on caller only
+//	return: 1 if success; 0 if decode failed; -1 if invalid
+a3ret a3demo_textureCompressBenchmark(a3byte const* filePath, a3_DemoWorkerPool* pool);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOTEXTURECOMPRESS_H
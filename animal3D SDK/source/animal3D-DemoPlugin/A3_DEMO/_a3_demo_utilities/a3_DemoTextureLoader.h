@@ -0,0 +1,179 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoTextureLoader.h
+	Background texture loading for demo state: source images are cooked
+		once into a GPU-ready file (pre-flipped, pre-mipped, optionally 
+		block-compressed), cooked files are memory-mapped by worker threads and uploaded a few at a time
+		through a pixel buffer so textures appear while the demo runs.
+*/
+
+#ifndef __ANIMAL3D_DEMOTEXTURELOADER_H
+#define __ANIMAL3D_DEMOTEXTURELOADER_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/a3/a3macros.h"
+#include "animal3D/animal3D.h"
+#include "animal3D-A3DG/animal3D-A3DG.h"
+
+#include "a3_DemoTextureCompress.h"
+#include "a3_DemoWorkerPool.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef struct a3_DemoTextureFileHeader					a3_DemoTextureFileHeader;
+typedef struct a3_DemoTextureRequest					a3_DemoTextureRequest;
+typedef struct a3_DemoTextureLoader						a3_DemoTextureLoader;
+typedef enum a3_DemoTextureRequestState					a3_DemoTextureRequestState;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// loader limits
+enum a3_DemoTextureLoaderMaxCount
+{
+	demoTextureLoaderMaxCount_request = 32,
+	demoTextureLoaderMaxCount_worker = 8,
+	demoTextureLoaderMaxCount_level = 16,
+	demoTextureLoaderMaxCount_pathLen = 128,
+};
+
+// progress of one request
+enum a3_DemoTextureRequestState
+{
+	demoTextureRequest_queued,				// waiting for worker
+	demoTextureRequest_ready,				// cooked data available to upload
+	demoTextureRequest_failed,				// source could not be decoded
+	demoTextureRequest_done,				// uploaded or failure reported
+};
+
+// cooked texture file header, followed by level data (largest level first,
+//	bottom row first, ready to upload as-is); laid out like KTX2:
+//	identifier, format, dimensions, then an index of levels
+struct a3_DemoTextureFileHeader
+{
+	a3byte identifier[12];					// see a3demo_textureFileIdentifier
+	a3ui32 version;							// layout version
+	a3ui32 pixelType;						// a3_TexturePixelType of all levels
+	a3ui32 compression;						// a3_DemoTextureCompression requested
+	a3ui32 width, height, levelCount;		// base level size and level count
+	a3i64 sourceTime, sourceSize;			// stamp of source image when cooked
+	a3ui32 levelOffset[demoTextureLoaderMaxCount_level];	// from start of file
+	a3ui32 levelSize[demoTextureLoaderMaxCount_level];		// in bytes
+};
+
+// one texture to load and the settings to apply once uploaded
+struct a3_DemoTextureRequest
+{
+	a3_Texture* texture;					// destination (uninitialized)
+	a3byte name[32];						// texture name
+	a3byte filePath[demoTextureLoaderMaxCount_pathLen];		// source image
+	a3_TextureFilterOption filter;
+	a3_TextureRepeatOption repeatH, repeatV;
+	a3_DemoTextureCompression compression;	// applied when cooked
+
+	// written by worker, read by main thread once state is ready; state 
+	//	is written last with an atomic store and read with an atomic load
+	a3_DemoTextureFileHeader const* file;	// cooked file contents
+	void* fileMapping;						// mapping; null if allocated
+	a3ui32 fileSize;						// bytes of cooked file
+	a3f64 workTime;							// seconds spent by worker
+	a3boolean cooked;						// cooked this load (cache miss)
+	a3i32 volatile state;					// a3_DemoTextureRequestState
+};
+
+// loader state
+struct a3_DemoTextureLoader
+{
+	a3byte directory[demoTextureLoaderMaxCount_pathLen];	// cooked files
+	a3ui32 requestCount, workerCount;
+	a3ui32 uploadCount, failCount;			// requests finished
+	a3ui32 uploadBudget;					// bytes uploaded per update
+	a3ui32 uploadSize;						// bytes uploaded so far
+	a3boolean compressionSupported;			// driver samples compressed types
+	a3_DemoTextureRequest request[demoTextureLoaderMaxCount_request];
+	a3_DemoWorkerPool workerPool[1];		// one task per request
+	a3_BufferObject pixelBuffer[1];			// staging for uploads
+	a3_Timer timer[1];						// time since start
+	a3i32 volatile abort;					// workers skip remaining requests
+};
+
+
+//-----------------------------------------------------------------------------
+
+// identifier at start of every cooked texture file
+#define a3demo_textureFileIdentifier	"\xAB" "A3TEX 01" "\xBB" "\n"
+
+// cook an image: decode source, generate mips, compress and write cooked 
+//	file (offline cooker; workers call this for sources without a valid file)
+//	return: 1 if written; 0 if failed; -1 if invalid
+a3ret a3demo_textureCook(a3byte const* sourcePath, a3byte const* cookedPath, a3_DemoTextureCompression const compression);
+
+// initialize loader
+//	directory: where cooked files are kept
+//	uploadBudget: bytes to upload per update (at least one texture)
+//	return: 1 if success; -1 if invalid
+a3ret a3demo_textureLoaderInit(a3_DemoTextureLoader* loader, a3byte const* directory, a3ui32 const uploadBudget);
+
+// add a texture to load; settings are applied after upload
+//	compression: ignored if the driver cannot sample compressed textures
+//	return: 1 if added; 0 if full; -1 if invalid or already started
+a3ret a3demo_textureLoaderRequest(a3_DemoTextureLoader* loader, a3_Texture* texture, a3byte const* name, a3byte const* filePath,
+	a3_TextureFilterOption const filter, a3_TextureRepeatOption const repeatH, a3_TextureRepeatOption const repeatV,
+	a3_DemoTextureCompression const compression);
+
+// launch workers
+//	workerCount: number of threads; zero to use one per processor
+//	return: number of workers launched; -1 if invalid
+a3ret a3demo_textureLoaderStart(a3_DemoTextureLoader* loader, a3ui32 workerCount);
+
+// upload textures that are ready, within budget; call every frame
+//	return: number of textures uploaded; -1 if invalid
+a3ret a3demo_textureLoaderUpdate(a3_DemoTextureLoader* loader);
+
+// wait until every request is processed, then stop workers and join 
+//	their threads (e.g. before demo library is swapped); uploads continue 
+//	in later updates
+//	return: 1 if success; -1 if invalid
+a3ret a3demo_textureLoaderWait(a3_DemoTextureLoader* loader);
+
+// stop workers and release everything not yet uploaded
+//	return: 1 if success; -1 if invalid
+a3ret a3demo_textureLoaderRelease(a3_DemoTextureLoader* loader);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOTEXTURELOADER_H
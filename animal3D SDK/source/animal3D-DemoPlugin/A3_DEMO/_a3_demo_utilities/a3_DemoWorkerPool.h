@@ -0,0 +1,140 @@
+/*
+	Copyright 2011-2021 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoWorkerPool.h
+	Persistent worker threads: created once, woken for each batch of
+		tasks, which they claim with an atomic counter; the caller joins
+		on the batch rather than on threads. Also atomic utilities for
+		handing data between threads.
+*/
+
+#ifndef __ANIMAL3D_DEMOWORKERPOOL_H
+#define __ANIMAL3D_DEMOWORKERPOOL_H
+
+
+//-----------------------------------------------------------------------------
+// animal3D framework includes
+
+#include "animal3D/a3/a3macros.h"
+#include "animal3D/animal3D.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef struct a3_DemoWorkerPool				a3_DemoWorkerPool;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// pool limits
+enum a3_DemoWorkerPoolMaxCount
+{
+	demoWorkerPoolMaxCount_thread = 16,
+};
+
+
+// task run by workers: processes task index of a batch of args
+typedef void(*a3_DemoWorkerTask)(void* args, a3ui32 index);
+
+
+// pool state; batch fields are written under the pool's lock, task
+//	counters with atomic operations
+struct a3_DemoWorkerPool
+{
+	void* platform;							// threads, lock and conditions
+	a3ui32 threadCount;						// workers, not counting callers
+
+	// current batch
+	a3_DemoWorkerTask task;
+	void* args;
+	a3ui32 taskCount;
+	a3ui32 batch;							// raised to wake workers
+	a3ui32 active;							// workers inside current batch
+	a3boolean quit;
+
+	// next task to claim and tasks not yet finished
+	a3i32 volatile next, remaining;
+};
+
+
+//-----------------------------------------------------------------------------
+
+// number of processors available for workers
+a3ui32 a3demo_workerPoolProcessorCount();
+
+// create pool and launch its threads, which sleep until a batch begins
+//	threadCount: number of workers; zero for one per processor less one,
+//		since callers help with batches they run
+//	return: number of workers launched; -1 if invalid or already created
+a3ret a3demo_workerPoolCreate(a3_DemoWorkerPool* pool, a3ui32 threadCount);
+
+// hand out a batch of tasks to workers and return without waiting; waits
+//	for the previous batch first, so only one is in flight
+//	return: 1 if begun; -1 if invalid
+a3ret a3demo_workerPoolBegin(a3_DemoWorkerPool* pool, a3_DemoWorkerTask const task, void* args, a3ui32 const taskCount);
+
+// join current batch: optionally run unclaimed tasks on the caller, then
+//	wait until every task has finished and every worker has left it
+//	help: caller runs tasks too; always true if the pool has no workers
+//	return: number of tasks run by caller; -1 if invalid
+a3ret a3demo_workerPoolEnd(a3_DemoWorkerPool* pool, a3boolean const help);
+
+// run a batch of tasks on workers and caller and wait for all of them
+//	pool: null to run every task on caller
+//	return: number of tasks run by caller; -1 if invalid
+a3ret a3demo_workerPoolRun(a3_DemoWorkerPool* pool, a3_DemoWorkerTask const task, void* args, a3ui32 const taskCount);
+
+// run a batch as above, for library code that takes a dispatcher callback
+//	and an untyped context (e.g. geometry dispatchers)
+void a3demo_workerPoolDispatch(void* pool, a3_DemoWorkerTask const task, void* args, a3ui32 const taskCount);
+
+// check whether every task of the current batch has finished
+//	return: 1 if done; 0 if not; -1 if invalid
+a3ret a3demo_workerPoolIsDone(a3_DemoWorkerPool const* pool);
+
+// wait for the current batch, stop workers, join and close their threads
+//	return: 1 if released; 0 if not created; -1 if invalid
+a3ret a3demo_workerPoolRelease(a3_DemoWorkerPool* pool);
+
+
+// read a value written by another thread; later reads cannot move before it
+a3i32 a3demo_atomicLoad(a3i32 volatile const* value);
+
+// write a value for another thread; earlier writes cannot move after it
+void a3demo_atomicStore(a3i32 volatile* value, a3i32 const newValue);
+
+// add to a value and return the result
+a3i32 a3demo_atomicAdd(a3i32 volatile* value, a3i32 const delta);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOWORKERPOOL_H
@@ -42,10 +42,17 @@ typedef struct a3_DemoState a3_DemoState;
 // main demo mode callback
 void a3intro_input_keyCharPress(a3_DemoState const* demoState, a3_DemoMode0_Intro* demoMode, a3i32 const asciiKey, a3i32 const state)
 {
+	void a3intro_reportMeshletCulling(a3_DemoState const* demoState, a3_DemoMode0_Intro const* demoMode);
+
 	switch (asciiKey)
 	{
 		// toggle render program
 		a3demoCtrlCasesLoop(demoMode->renderMode, intro_renderMode_max, 'k', 'j');
+
+		// report cluster culling from current view
+	case 'L':
+		a3intro_reportMeshletCulling(demoState, demoMode);
+		break;
 	}
 }
 
@@ -35,6 +35,8 @@
 
 #include "../_a3_demo_utilities/a3_DemoRenderUtils.h"
 
+#include <stdio.h>
+
 
 // OpenGL
 #ifdef _WIN32
@@ -67,6 +69,75 @@ void a3intro_render_controls(a3_DemoState const* demoState, a3_DemoMode0_Intro c
 	// lighting modes
 	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"    Rendering mode (%u / %u) ('j' | 'k'): %s", renderMode + 1, intro_renderMode_max, renderModeName[renderMode]);
+	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"    Cluster culling report: 'L' (results in console) ");
+}
+
+
+//-----------------------------------------------------------------------------
+
+// report clusters of each scene object rejected outside the main camera's 
+//	frustum or facing away from it
+void a3intro_reportMeshletCulling(a3_DemoState const* demoState, a3_DemoMode0_Intro const* demoMode)
+{
+	// drawables and names as in scene pass
+	const a3_VertexDrawable* drawable[] = {
+		0,								// root
+		0,								// camera
+		demoState->draw_unit_box,		// skybox
+		demoState->draw_unit_sphere,	// objects
+		demoState->draw_unit_cylinder,
+		demoState->draw_unit_capsule,
+		demoState->draw_unit_torus,
+		demoState->draw_unit_cone,
+		demoState->draw_teapot,
+		demoState->draw_unit_plane_z,
+	};
+	const a3byte* name[] = {
+		"root", "camera", "skybox", "sphere", "cylinder", "capsule", "torus", "cone", "teapot", "ground",
+	};
+
+	const a3_SceneObjectComponent* currentSceneObject, * endSceneObject;
+	a3_DemoGeometryMeshletCullStats stats[1], total[1] = { 0 };
+	a3_Timer timer[1] = { 0 };
+	a3f32 planes[6][4];
+	a3f64 cullTime = 0.0;
+	a3mat4 projectionMat = demoMode->projector->projectorMatrixStackPtr->projectionMat;
+	a3mat4 modelViewMat;
+	a3ui32 j;
+
+	// same teapot level as drawn
+	modelViewMat = demoMode->obj_teapot->modelMatrixStackPtr->modelViewMat;
+	drawable[demoMode->obj_teapot->sceneHierarchyIndex] = demoState->draw_teapot + a3demo_geometrySelectLOD(demoState->teapotLOD,
+		a3real3Length(modelViewMat.v3.v), a3real3Length(modelViewMat.v0.v),
+		projectionMat.m11 * (a3real)demoState->frameHeight * a3real_half, a3demo_geometryLODPixelError);
+
+	printf("\n\n  cluster culling from main camera (up to %u vertices, %u triangles per cluster):",
+		demoGeometryMeshletMaxCount_vertex, demoGeometryMeshletMaxCount_triangle);
+	for (currentSceneObject = demoMode->obj_sphere, endSceneObject = demoMode->obj_ground;
+		currentSceneObject <= endSceneObject; ++currentSceneObject)
+	{
+		j = currentSceneObject->sceneHierarchyIndex;
+		a3timerStart(timer);
+		a3demo_geometryMeshletFrustum(planes, currentSceneObject->modelMatrixStackPtr->modelViewProjectionMat.mm);
+		a3demo_geometryCullMeshlets(0, stats, demoState->meshlets + (drawable[j] - demoState->drawable),
+			planes, currentSceneObject->modelMatrixStackPtr->modelViewMatInverse.v3.v);
+		a3timerStop(timer);
+		cullTime += timer->currentTick;
+
+		printf("\n  %-8s %4u clusters, %6u triangles: %5.1lf%% outside frustum, %5.1lf%% back-facing",
+			name[j], stats->meshletCount, stats->triangleCount,
+			stats->triangleCount ? (a3f64)stats->triangleFrustum * 100.0 / (a3f64)stats->triangleCount : 0.0,
+			stats->triangleCount ? (a3f64)stats->triangleCone * 100.0 / (a3f64)stats->triangleCount : 0.0);
+		total->meshletCount += stats->meshletCount;
+		total->triangleCount += stats->triangleCount;
+		total->triangleFrustum += stats->triangleFrustum;
+		total->triangleCone += stats->triangleCone;
+	}
+	printf("\n  scene    %4u clusters, %6u triangles: %5.1lf%% rejected (%8.3lf ms)\n",
+		total->meshletCount, total->triangleCount,
+		total->triangleCount ? (a3f64)(total->triangleFrustum + total->triangleCone) * 100.0 / (a3f64)total->triangleCount : 0.0,
+		cullTime * 1000.0);
 }
 
 
@@ -172,6 +243,12 @@ void a3intro_render(a3_DemoState const* demoState, a3_DemoMode0_Intro const* dem
 	a3mat4 viewProjectionMat = activeCamera->projectorMatrixStackPtr->viewProjectionMat;
 	a3mat4 modelMat, modelViewMat, modelViewProjectionMat, atlasMat;
 
+	// coarser teapot where the difference would not be seen
+	modelViewMat = demoMode->obj_teapot->modelMatrixStackPtr->modelViewMat;
+	drawable[demoMode->obj_teapot->sceneHierarchyIndex] = demoState->draw_teapot + a3demo_geometrySelectLOD(demoState->teapotLOD,
+		a3real3Length(modelViewMat.v3.v), a3real3Length(modelViewMat.v0.v),
+		projectionMat.m11 * (a3real)demoState->frameHeight * a3real_half, a3demo_geometryLODPixelError);
+
 
 	//-------------------------------------------------------------------------
 	// 1) SCENE PASS: render scene with desired shader
@@ -257,6 +334,22 @@ void a3intro_render(a3_DemoState const* demoState, a3_DemoMode0_Intro const* dem
 			a3shaderUniformSendFloat(a3unif_vec4, currentDemoProgram->uColor, 1, rgba4[i].v);
 			break;
 		}
+
+		// full-detail teapot in solid color is drawn from its quantized 
+		//	copy, whose program restores positions from the mesh bounds
+		if (renderMode == intro_renderModeSolid && drawable[j] == demoState->draw_teapot && demoState->draw_teapot_quantized->count)
+		{
+			a3shaderProgramActivate(demoState->prog_drawColorUnif_quantized->program);
+			a3shaderUniformSendFloatMat(a3unif_mat4, 0, demoState->prog_drawColorUnif_quantized->uMVP, 1, modelViewProjectionMat.mm);
+			a3shaderUniformSendFloat(a3unif_vec4, demoState->prog_drawColorUnif_quantized->uColor, 1, rgba4[i].v);
+			a3shaderUniformSendFloat(a3unif_vec4, demoState->prog_drawColorUnif_quantized->uPositionScale, 1, demoState->teapotDequantize->positionScale);
+			a3shaderUniformSendFloat(a3unif_vec4, demoState->prog_drawColorUnif_quantized->uPositionBias, 1, demoState->teapotDequantize->positionBias);
+			a3shaderUniformSendInt(a3unif_single, demoState->prog_drawColorUnif_quantized->uIndex, 1, &j);
+			a3vertexDrawableActivateAndRender(demoState->draw_teapot_quantized);
+			a3shaderProgramActivate(currentDemoProgram->program);
+			continue;
+		}
+
 		a3shaderUniformSendInt(a3unif_single, currentDemoProgram->uIndex, 1, &j);
 		a3vertexDrawableActivateAndRender(drawable[j]);
 	}
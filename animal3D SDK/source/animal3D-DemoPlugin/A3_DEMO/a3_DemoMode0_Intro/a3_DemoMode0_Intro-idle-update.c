@@ -70,26 +70,10 @@ void a3intro_update_scene(a3_DemoState* demoState, a3_DemoMode0_Intro* demoMode,
 	a3demo_update_defaultAnimation((dt * 15.0), demoMode->obj_sphere,
 		(a3ui32)(demoMode->obj_ground - demoMode->obj_sphere), 2, demoState->updateAnimation);
 
-	a3demo_updateSceneObject(demoMode->obj_sphere, 0);
-	a3demo_updateSceneObjectStack(demoMode->obj_sphere, projector);
-
-	a3demo_updateSceneObject(demoMode->obj_cylinder, 0);
-	a3demo_updateSceneObjectStack(demoMode->obj_cylinder, projector);
-
-	a3demo_updateSceneObject(demoMode->obj_capsule, 0);
-	a3demo_updateSceneObjectStack(demoMode->obj_capsule, projector);
-
-	a3demo_updateSceneObject(demoMode->obj_torus, 0);
-	a3demo_updateSceneObjectStack(demoMode->obj_torus, projector);
-
-	a3demo_updateSceneObject(demoMode->obj_cone, 0);
-	a3demo_updateSceneObjectStack(demoMode->obj_cone, projector);
-
-	a3demo_updateSceneObject(demoMode->obj_teapot, 0);
-	a3demo_updateSceneObjectStack(demoMode->obj_teapot, projector);
-
-	a3demo_updateSceneObject(demoMode->obj_ground, 0);
-	a3demo_updateSceneObjectStack(demoMode->obj_ground, projector);
+	a3demo_updateSceneObjectArray(demoMode->obj_sphere,
+		(a3ui32)(demoMode->obj_ground - demoMode->obj_sphere) + 1, 0);
+	a3demo_updateSceneObjectStackArray(demoMode->obj_sphere,
+		(a3ui32)(demoMode->obj_ground - demoMode->obj_sphere) + 1, projector);
 }
 
 void a3intro_update(a3_DemoState* demoState, a3_DemoMode0_Intro* demoMode, a3f64 const dt)
@@ -159,6 +159,7 @@ void a3intro_load(a3_DemoState const* demoState, a3_DemoMode0_Intro* demoMode)
 	sceneObjectData->position.z = +a3real_four;
 	sceneObjectData->scale.x = a3real_two;
 	sceneObjectData->scaleMode = a3scale_uniform;
+	sceneObjectData->rotateMode = a3rotate_quaternion;
 
 	sceneObject = demoMode->obj_cylinder;
 	sceneObjectData = sceneObject->dataPtr;
@@ -173,6 +174,7 @@ void a3intro_load(a3_DemoState const* demoState, a3_DemoMode0_Intro* demoMode)
 	sceneObjectData->scale.y = a3real_onehalf;
 	sceneObjectData->scale.z = a3real_onehalf;
 	sceneObjectData->scaleMode = a3scale_nonuniform;
+	sceneObjectData->rotateMode = a3rotate_quaternion;
 
 	sceneObject = demoMode->obj_capsule;
 	sceneObjectData = sceneObject->dataPtr;
@@ -185,6 +187,7 @@ void a3intro_load(a3_DemoState const* demoState, a3_DemoMode0_Intro* demoMode)
 	sceneObjectData->position.z = +a3real_four;
 	sceneObjectData->scale.x = a3real_two;
 	sceneObjectData->scaleMode = a3scale_uniform;
+	sceneObjectData->rotateMode = a3rotate_quaternion;
 
 	sceneObject = demoMode->obj_torus;
 	sceneObjectData = sceneObject->dataPtr;
@@ -197,6 +200,7 @@ void a3intro_load(a3_DemoState const* demoState, a3_DemoMode0_Intro* demoMode)
 	sceneObjectData->position.z = +a3real_four;
 	sceneObjectData->scale.x = a3real_two;
 	sceneObjectData->scaleMode = a3scale_uniform;
+	sceneObjectData->rotateMode = a3rotate_quaternion;
 
 	sceneObject = demoMode->obj_cone;
 	sceneObjectData = sceneObject->dataPtr;
@@ -211,6 +215,7 @@ void a3intro_load(a3_DemoState const* demoState, a3_DemoMode0_Intro* demoMode)
 	sceneObjectData->scale.y = a3real_two;
 	sceneObjectData->scale.z = a3real_two;
 	sceneObjectData->scaleMode = a3scale_nonuniform;
+	sceneObjectData->rotateMode = a3rotate_quaternion;
 
 	sceneObject = demoMode->obj_teapot;
 	sceneObjectData = sceneObject->dataPtr;
@@ -223,6 +228,7 @@ void a3intro_load(a3_DemoState const* demoState, a3_DemoMode0_Intro* demoMode)
 	sceneObjectData->position.z = +a3real_four;
 	sceneObjectData->scale.x = a3real_one;
 	sceneObjectData->scaleMode = a3scale_uniform;
+	sceneObjectData->rotateMode = a3rotate_quaternion;
 
 	sceneObject = demoMode->obj_ground;
 	sceneObjectData = sceneObject->dataPtr;
@@ -235,6 +241,7 @@ void a3intro_load(a3_DemoState const* demoState, a3_DemoMode0_Intro* demoMode)
 	sceneObjectData->scale.y = a3real_fortyfive;
 	sceneObjectData->scale.z = a3real_epsilon;
 	sceneObjectData->scaleMode = a3scale_nonuniform;
+	sceneObjectData->rotateMode = a3rotate_quaternion;
 
 
 	// set up projectors
@@ -33,6 +33,9 @@
 //-----------------------------------------------------------------------------
 
 #include "_a3_demo_utilities/a3_DemoSceneObject.h"
+#include "_a3_demo_utilities/a3_DemoCulling.h"
+#include "_a3_demo_utilities/a3_DemoOcclusion.h"
+#include "_a3_demo_utilities/a3_DemoBVH.h"
 
 #include "_animation/a3_Hierarchy.h"
 
@@ -47,6 +50,7 @@ typedef struct a3_DemoMode1_PostProc						a3_DemoMode1_PostProc;
 typedef enum a3_DemoMode1_PostProc_RenderMode				a3_DemoMode1_PostProc_RenderMode;
 typedef enum a3_DemoMode1_PostProc_RenderPass				a3_DemoMode1_PostProc_RenderPass;
 typedef enum a3_DemoMode1_PostProc_RenderTarget				a3_DemoMode1_PostProc_RenderTarget;
+typedef enum a3_DemoMode1_PostProc_CullPass					a3_DemoMode1_PostProc_CullPass;
 #endif	// __cplusplus
 
 
@@ -100,6 +104,16 @@ enum a3_DemoMode1_PostProc_RenderTarget
 };
 
 
+// passes that draw scene objects, each culled against its projector
+enum a3_DemoMode1_PostProc_CullPass
+{
+	postproc_cullPassShadow,			// light's frustum
+	postproc_cullPassScene,				// camera's frustum
+
+	postproc_cullPass_max
+};
+
+
 // maximum unique objects
 enum a3_DemoMode1_PostProc_ObjectMaxCount
 {
@@ -109,6 +123,15 @@ enum a3_DemoMode1_PostProc_ObjectMaxCount
 };
 
 
+// software occlusion buffer settings
+enum a3_DemoMode1_PostProc_OcclusionSetting
+{
+	postprocOcclusion_width = 256,		// depth buffer size
+	postprocOcclusion_height = 128,
+	postprocOcclusion_threadOptions = 4,	// 1, 2, 4 or 8 threads
+};
+
+
 //-----------------------------------------------------------------------------
 
 // demo mode for basic shading
@@ -170,6 +193,24 @@ struct a3_DemoMode1_PostProc
 		};
 	};
 	a3_PointLightData pointLightData[postprocMaxCount_pointLight];
+
+	// object culling: for each pass, objects that may be visible, as 
+	//	offsets from the first drawn object (sphere)
+	a3boolean cullObjects;
+	a3ui32 visibleObjectCount[postproc_cullPass_max];
+	a3ui32 visibleObject[postproc_cullPass_max][postprocMaxCount_sceneObject];
+	a3_DemoCullStats cullStats[postproc_cullPass_max];
+
+	// occlusion culling of scene pass: objects left after the frustum 
+	//	are drawn as occluders into a small depth buffer, then each is 
+	//	tested against it and removed from the list if hidden
+	a3boolean occludeObjects;
+	a3ui32 occlusionThreadOption;		// thread count is 1 << option
+	a3_DemoOcclusionBuffer occlusionBuffer[1];
+	a3_DemoOcclusionStats occlusionStats;
+
+	// spatial index of drawn objects' world bounds, refit every frame
+	a3_DemoBVH sceneTree[1];
 };
 
 
@@ -42,6 +42,9 @@ typedef struct a3_DemoState a3_DemoState;
 // main demo mode callback
 void a3postproc_input_keyCharPress(a3_DemoState const* demoState, a3_DemoMode1_PostProc* demoMode, a3i32 const asciiKey, a3i32 const state)
 {
+	void a3postproc_reportCulling(a3_DemoState const* demoState, a3_DemoMode1_PostProc* demoMode);
+	void a3postproc_reportSpatialIndex(a3_DemoState const* demoState, a3_DemoMode1_PostProc const* demoMode);
+
 	switch (asciiKey)
 	{
 		// toggle render program
@@ -51,6 +54,23 @@ void a3postproc_input_keyCharPress(a3_DemoState const* demoState, a3_DemoMode1_P
 		// toggle render target
 		a3demoCtrlCasesLoop(demoMode->renderTarget[demoMode->renderPass],
 			demoMode->renderTargetCount[demoMode->renderPass], 'M', 'N');
+
+		// toggle object culling
+		a3demoCtrlCaseToggle(demoMode->cullObjects, 'l');
+
+		// toggle occlusion culling and change its thread count
+		a3demoCtrlCaseToggle(demoMode->occludeObjects, 'o');
+		a3demoCtrlCaseIncLoop(demoMode->occlusionThreadOption, postprocOcclusion_threadOptions, 'u');
+
+		// report object culling and its speed
+	case 'L':
+		a3postproc_reportCulling(demoState, demoMode);
+		break;
+
+		// report spatial index queries and its speed
+	case 'V':
+		a3postproc_reportSpatialIndex(demoState, demoMode);
+		break;
 	}
 }
 
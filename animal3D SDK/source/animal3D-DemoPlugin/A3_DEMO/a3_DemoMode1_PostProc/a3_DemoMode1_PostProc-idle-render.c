@@ -35,6 +35,8 @@
 
 #include "../_a3_demo_utilities/a3_DemoRenderUtils.h"
 
+#include <stdio.h>
+
 
 // OpenGL
 #ifdef _WIN32
@@ -114,6 +116,88 @@ void a3postproc_render_controls(a3_DemoState const* demoState, a3_DemoMode1_Post
 		"    Render pass (%u / %u) ('J' | 'K'): %s", renderPass + 1, postproc_renderPass_max, renderPassName[renderPass]);
 	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"        Render target (%u / %u) ('N' | 'M'): %s", renderTarget + 1, renderTargetCount, renderTargetName[renderPass][renderTarget]);
+
+	// culling
+	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"    Object culling ('l'): %s; shadow %u / %u culled, scene %u / %u culled", demoMode->cullObjects ? "ON" : "OFF",
+		demoMode->cullStats[postproc_cullPassShadow].culled, demoMode->cullStats[postproc_cullPassShadow].tested,
+		demoMode->cullStats[postproc_cullPassScene].culled, demoMode->cullStats[postproc_cullPassScene].tested);
+	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"    Occlusion culling ('o'): %s; %u / %u hidden by %u occluders in %.3lf ms (%u threads ('u'))", demoMode->occludeObjects ? "ON" : "OFF",
+		demoMode->occlusionStats.occluded, demoMode->occlusionStats.tested, demoMode->occlusionStats.occluderCount,
+		demoMode->occlusionStats.rasterTime * 1000.0, 1u << demoMode->occlusionThreadOption);
+	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"    Object culling report: 'L' (results in console) ");
+	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"    Spatial index report: 'V' (results in console) ");
+}
+
+
+// report object culling of each pass and time culling many objects 
+//	against the main camera; this frame's occluders are rasterized again 
+//	with each thread count to time the occlusion buffer
+void a3postproc_reportCulling(a3_DemoState const* demoState, a3_DemoMode1_PostProc* demoMode)
+{
+	a3byte const* passName[postproc_cullPass_max] = {
+		"shadow", "scene",
+	};
+	a3ui32 const count[] = {
+		1024, 16384, 262144,
+	};
+	a3_DemoOcclusionStats const* const occlusionStats = &demoMode->occlusionStats;
+	a3_Timer timer[1] = { 0 };
+	a3f32 planes[6][4];
+	a3ui32 i, rep, repCount = 100;
+
+	printf("\n\n  object culling per pass (%s):", demoMode->cullObjects ? "on" : "off");
+	for (i = 0; i < postproc_cullPass_max; ++i)
+		printf("\n  %-6s %2u tested, %2u culled, %2u drawn", passName[i],
+			demoMode->cullStats[i].tested, demoMode->cullStats[i].culled, demoMode->visibleObjectCount[i]);
+
+	a3demo_geometryMeshletFrustum(planes, demoMode->proj_camera_main->projectorMatrixStackPtr->viewProjectionMat.mm);
+	for (i = 0; i < sizeof(count) / sizeof(*count); ++i)
+		a3demo_cullReport(planes, count[i]);
+
+	printf("\n\n  occlusion culling of scene pass (%s), %ux%u buffer:", demoMode->occludeObjects ? "on" : "off",
+		demoMode->occlusionBuffer->width, demoMode->occlusionBuffer->height);
+	printf("\n  %u occluders, %u triangles, %u rasterized; %u / %u objects hidden",
+		occlusionStats->occluderCount, occlusionStats->triangleCount, occlusionStats->triangleDrawn,
+		occlusionStats->occluded, occlusionStats->tested);
+	if (demoMode->occludeObjects)
+		for (i = 0; i < postprocOcclusion_threadOptions; ++i)
+		{
+			a3timerStart(timer);
+			for (rep = 0; rep < repCount; ++rep)
+				a3demo_occlusionRasterize(demoMode->occlusionBuffer, demoState->workerPool, 1 << i);
+			a3timerStop(timer);
+			printf("\n  rasterize, %u thread%s: %8.3lf us per frame", 1u << i, i ? "s" : " ",
+				timer->currentTick * 1000000.0 / (a3f64)repCount);
+		}
+	printf("\n");
+}
+
+
+// report what the scene's spatial index finds from the main camera and 
+//	time building and querying indices of many objects
+void a3postproc_reportSpatialIndex(a3_DemoState const* demoState, a3_DemoMode1_PostProc const* demoMode)
+{
+	a3ui32 const count[] = {
+		10000, 100000, 1000000,
+	};
+	a3ui32 found[postprocMaxCount_sceneObject];
+	a3f32 planes[6][4];
+	a3ui32 i, foundCount;
+
+	a3demo_geometryMeshletFrustum(planes, demoMode->proj_camera_main->projectorMatrixStackPtr->viewProjectionMat.mm);
+	foundCount = a3demo_bvhQueryFrustum(found, postprocMaxCount_sceneObject, demoMode->sceneTree, planes);
+	printf("\n\n  scene spatial index: %u objects, %u nodes; %u in camera frustum (culling found %u):",
+		demoMode->sceneTree->objectCount, demoMode->sceneTree->nodeCount, foundCount,
+		demoMode->cullStats[postproc_cullPassScene].tested - demoMode->cullStats[postproc_cullPassScene].culled);
+	for (i = 0; i < foundCount && i < postprocMaxCount_sceneObject; ++i)
+		printf(" %u", found[i]);
+
+	for (i = 0; i < sizeof(count) / sizeof(*count); ++i)
+		a3demo_bvhReport(planes, count[i], demoState->workerPool, demoBVHSize_thread);
 }
 
 
@@ -263,6 +347,12 @@ void a3postproc_render(a3_DemoState const* demoState, a3_DemoMode1_PostProc cons
 	// pixel size and effect axis
 	//a3vec2 pixelSize = a3vec2_one;
 
+	// coarser teapot where the difference would not be seen
+	modelViewMat = demoMode->obj_teapot->modelMatrixStackPtr->modelViewMat;
+	drawable[demoMode->obj_teapot->sceneHierarchyIndex] = demoState->draw_teapot + a3demo_geometrySelectLOD(demoState->teapotLOD,
+		a3real3Length(modelViewMat.v3.v), a3real3Length(modelViewMat.v0.v),
+		projectionMat.m11 * (a3real)demoState->frameHeight * a3real_half, a3demo_geometryLODPixelError);
+
 
 	//-------------------------------------------------------------------------
 	// 0) SHADOW PASS: render scene from light's perspective
@@ -283,10 +373,11 @@ void a3postproc_render(a3_DemoState const* demoState, a3_DemoMode1_PostProc cons
 	glDisable(GL_BLEND);
 
 	// shadow capture on inverted geometry
+	// only objects in the light's frustum
 	glCullFace(GL_FRONT);
-	for (currentSceneObject = demoMode->obj_sphere, endSceneObject = demoMode->obj_ground;
-		currentSceneObject <= endSceneObject; ++currentSceneObject)
+	for (i = 0; i < demoMode->visibleObjectCount[postproc_cullPassShadow]; ++i)
 	{
+		currentSceneObject = demoMode->obj_sphere + demoMode->visibleObject[postproc_cullPassShadow][i];
 		j = currentSceneObject->sceneHierarchyIndex;
 
 		// calculate and send MVP from light's perspective
@@ -360,9 +451,10 @@ void a3postproc_render(a3_DemoState const* demoState, a3_DemoMode1_PostProc cons
 	glDisable(GL_BLEND);
 
 	// forward shading algorithms
-	for (currentSceneObject = demoMode->obj_sphere, endSceneObject = demoMode->obj_ground;
-		currentSceneObject <= endSceneObject; ++currentSceneObject)
+	// only objects in the camera's frustum
+	for (i = 0; i < demoMode->visibleObjectCount[postproc_cullPassScene]; ++i)
 	{
+		currentSceneObject = demoMode->obj_sphere + demoMode->visibleObject[postproc_cullPassScene][i];
 		j = currentSceneObject->sceneHierarchyIndex;
 		
 		// activate texture maps
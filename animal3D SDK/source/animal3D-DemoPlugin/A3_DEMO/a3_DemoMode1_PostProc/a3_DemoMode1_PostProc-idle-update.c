@@ -35,6 +35,8 @@
 
 #include "../_a3_demo_utilities/a3_DemoMacros.h"
 
+#include <string.h>
+
 
 //-----------------------------------------------------------------------------
 // UPDATE
@@ -50,6 +52,103 @@ void a3postproc_update_graphics(a3_DemoState* demoState, a3_DemoMode1_PostProc*
 	//...*/
 }
 
+void a3postproc_update_culling(a3_DemoState const* demoState, a3_DemoMode1_PostProc* demoMode)
+{
+	// drawables of objects from sphere to ground, for bounds
+	const a3_VertexDrawable* drawable[] = {
+		demoState->draw_unit_sphere,
+		demoState->draw_unit_cylinder,
+		demoState->draw_unit_capsule,
+		demoState->draw_unit_torus,
+		demoState->draw_unit_cone,
+		demoState->draw_teapot,
+		demoState->draw_unit_plane_z,
+	};
+
+	// projector whose frustum each pass is culled against
+	const a3_ProjectorComponent* projector[postproc_cullPass_max] = {
+		demoMode->proj_light_main,
+		demoMode->proj_camera_main,
+	};
+
+	const a3_SceneObjectComponent* currentSceneObject;
+	const a3_DemoOccluderMesh* occluder;
+	a3_DemoOcclusionStats* const occlusionStats = &demoMode->occlusionStats;
+	a3ui32* const visible = demoMode->visibleObject[postproc_cullPassScene];
+	a3f32 sphereData[demoCullSphere_max][postprocMaxCount_sceneObject];
+	a3_VertexBounds worldBounds[postprocMaxCount_sceneObject];
+	a3_DemoCullSpheres spheres[1];
+	a3_Timer timer[1] = { 0 };
+	a3f32 planes[6][4];
+	a3ui32 i, j, count;
+
+	// world-space bounds and their spheres
+	for (i = 0; i < demoCullSphere_max; ++i)
+		spheres->component[i] = sphereData[i];
+	spheres->count = (a3ui32)(demoMode->obj_ground - demoMode->obj_sphere) + 1;
+	for (i = 0, currentSceneObject = demoMode->obj_sphere; i < spheres->count; ++i, ++currentSceneObject)
+	{
+		a3geometryTransformBounds(worldBounds + i, drawable[i]->bounds, currentSceneObject->modelMatrixStackPtr->modelMat.mm);
+		a3demo_cullStoreSphere(spheres, i, worldBounds + i, 0);
+	}
+
+	// objects only move, so the spatial index is built once and refit
+	a3demo_bvhUpdate(demoMode->sceneTree, worldBounds, spheres->count, demoState->workerPool, 1);
+
+	// visible list for each pass; world-space planes from view-projection
+	for (j = 0; j < postproc_cullPass_max; ++j)
+	{
+		if (demoMode->cullObjects)
+		{
+			a3demo_geometryMeshletFrustum(planes, projector[j]->projectorMatrixStackPtr->viewProjectionMat.mm);
+			demoMode->visibleObjectCount[j] = a3demo_cullSpheres(demoMode->visibleObject[j], demoMode->cullStats + j, spheres, planes);
+		}
+		else
+		{
+			for (i = 0; i < spheres->count; ++i)
+				demoMode->visibleObject[j][i] = i;
+			demoMode->visibleObjectCount[j] = demoMode->cullStats[j].tested = spheres->count;
+			demoMode->cullStats[j].culled = 0;
+		}
+	}
+
+	// occlusion of scene pass: draw objects left in view as occluders, 
+	//	then keep only those not hidden behind them (an object cannot 
+	//	hide itself, its occluder lies inside its bounds)
+	memset(occlusionStats, 0, sizeof(a3_DemoOcclusionStats));
+	if (demoMode->occludeObjects)
+	{
+		a3timerStart(timer);
+		a3demo_occlusionClear(demoMode->occlusionBuffer);
+		for (i = 0; i < demoMode->visibleObjectCount[postproc_cullPassScene]; ++i)
+		{
+			occluder = demoState->occluders + (drawable[visible[i]] - demoState->drawable);
+			if (occluder->triangleCount)
+			{
+				currentSceneObject = demoMode->obj_sphere + visible[i];
+				occlusionStats->triangleCount += occluder->triangleCount;
+				occlusionStats->occluderCount += 1;
+				a3demo_occlusionAddOccluder(demoMode->occlusionBuffer, occluder,
+					currentSceneObject->modelMatrixStackPtr->modelViewProjectionMat.mm);
+			}
+		}
+		occlusionStats->triangleDrawn = a3demo_occlusionRasterize(demoMode->occlusionBuffer, demoState->workerPool, 1 << demoMode->occlusionThreadOption);
+		a3timerStop(timer);
+		occlusionStats->rasterTime = timer->currentTick;
+
+		for (i = count = 0; i < demoMode->visibleObjectCount[postproc_cullPassScene]; ++i)
+		{
+			currentSceneObject = demoMode->obj_sphere + visible[i];
+			visible[count] = visible[i];
+			count += a3demo_occlusionTestBounds(demoMode->occlusionBuffer, drawable[visible[i]]->bounds,
+				currentSceneObject->modelMatrixStackPtr->modelViewProjectionMat.mm) != 0;
+		}
+		occlusionStats->tested = demoMode->visibleObjectCount[postproc_cullPassScene];
+		occlusionStats->occluded = occlusionStats->tested - count;
+		demoMode->visibleObjectCount[postproc_cullPassScene] = count;
+	}
+}
+
 void a3postproc_update_scene(a3_DemoState* demoState, a3_DemoMode1_PostProc* demoMode, a3f64 const dt)
 {
 	void a3demo_update_defaultAnimation(a3f64 const dt, a3_SceneObjectComponent const* sceneObjectArray,
@@ -97,26 +196,10 @@ void a3postproc_update_scene(a3_DemoState* demoState, a3_DemoMode1_PostProc* dem
 	a3demo_update_defaultAnimation((dt * 15.0), demoMode->obj_sphere,
 		(a3ui32)(demoMode->obj_ground - demoMode->obj_sphere), 2, demoState->updateAnimation);
 
-	a3demo_updateSceneObject(demoMode->obj_sphere, 0);
-	a3demo_updateSceneObjectStack(demoMode->obj_sphere, projector);
-
-	a3demo_updateSceneObject(demoMode->obj_cylinder, 0);
-	a3demo_updateSceneObjectStack(demoMode->obj_cylinder, projector);
-
-	a3demo_updateSceneObject(demoMode->obj_capsule, 0);
-	a3demo_updateSceneObjectStack(demoMode->obj_capsule, projector);
-
-	a3demo_updateSceneObject(demoMode->obj_torus, 0);
-	a3demo_updateSceneObjectStack(demoMode->obj_torus, projector);
-
-	a3demo_updateSceneObject(demoMode->obj_cone, 0);
-	a3demo_updateSceneObjectStack(demoMode->obj_cone, projector);
-
-	a3demo_updateSceneObject(demoMode->obj_teapot, 0);
-	a3demo_updateSceneObjectStack(demoMode->obj_teapot, projector);
-
-	a3demo_updateSceneObject(demoMode->obj_ground, 0);
-	a3demo_updateSceneObjectStack(demoMode->obj_ground, projector);
+	a3demo_updateSceneObjectArray(demoMode->obj_sphere,
+		(a3ui32)(demoMode->obj_ground - demoMode->obj_sphere) + 1, 0);
+	a3demo_updateSceneObjectStackArray(demoMode->obj_sphere,
+		(a3ui32)(demoMode->obj_ground - demoMode->obj_sphere) + 1, projector);
 
 	// update light positions
 	for (i = 0, pointLightData = demoMode->pointLightData;
@@ -127,6 +210,9 @@ void a3postproc_update_scene(a3_DemoState* demoState, a3_DemoMode1_PostProc* dem
 			projector->sceneObjectPtr->modelMatrixStackPtr->modelMatInverse.m,
 			pointLightData->worldPos.v);
 	}
+
+	// cull objects for shadow and scene passes
+	a3postproc_update_culling(demoState, demoMode);
 }
 
 void a3postproc_update(a3_DemoState* demoState, a3_DemoMode1_PostProc* demoMode, a3f64 const dt)
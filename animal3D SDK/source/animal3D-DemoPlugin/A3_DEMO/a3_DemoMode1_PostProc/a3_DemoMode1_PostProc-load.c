@@ -191,6 +191,7 @@ void a3postproc_load(a3_DemoState const* demoState, a3_DemoMode1_PostProc* demoM
 	sceneObjectData->position.z = +a3real_four;
 	sceneObjectData->scale.x = a3real_two;
 	sceneObjectData->scaleMode = a3scale_uniform;
+	sceneObjectData->rotateMode = a3rotate_quaternion;
 
 	sceneObject = demoMode->obj_cylinder;
 	sceneObjectData = sceneObject->dataPtr;
@@ -205,6 +206,7 @@ void a3postproc_load(a3_DemoState const* demoState, a3_DemoMode1_PostProc* demoM
 	sceneObjectData->scale.y = a3real_onehalf;
 	sceneObjectData->scale.z = a3real_onehalf;
 	sceneObjectData->scaleMode = a3scale_nonuniform;
+	sceneObjectData->rotateMode = a3rotate_quaternion;
 
 	sceneObject = demoMode->obj_capsule;
 	sceneObjectData = sceneObject->dataPtr;
@@ -217,6 +219,7 @@ void a3postproc_load(a3_DemoState const* demoState, a3_DemoMode1_PostProc* demoM
 	sceneObjectData->position.z = +a3real_four;
 	sceneObjectData->scale.x = a3real_two;
 	sceneObjectData->scaleMode = a3scale_uniform;
+	sceneObjectData->rotateMode = a3rotate_quaternion;
 
 	sceneObject = demoMode->obj_torus;
 	sceneObjectData = sceneObject->dataPtr;
@@ -229,6 +232,7 @@ void a3postproc_load(a3_DemoState const* demoState, a3_DemoMode1_PostProc* demoM
 	sceneObjectData->position.z = +a3real_four;
 	sceneObjectData->scale.x = a3real_two;
 	sceneObjectData->scaleMode = a3scale_uniform;
+	sceneObjectData->rotateMode = a3rotate_quaternion;
 
 	sceneObject = demoMode->obj_cone;
 	sceneObjectData = sceneObject->dataPtr;
@@ -243,6 +247,7 @@ void a3postproc_load(a3_DemoState const* demoState, a3_DemoMode1_PostProc* demoM
 	sceneObjectData->scale.y = a3real_two;
 	sceneObjectData->scale.z = a3real_two;
 	sceneObjectData->scaleMode = a3scale_nonuniform;
+	sceneObjectData->rotateMode = a3rotate_quaternion;
 
 	sceneObject = demoMode->obj_teapot;
 	sceneObjectData = sceneObject->dataPtr;
@@ -255,6 +260,7 @@ void a3postproc_load(a3_DemoState const* demoState, a3_DemoMode1_PostProc* demoM
 	sceneObjectData->position.z = +a3real_two + a3real_half;
 	sceneObjectData->scale.x = a3real_one;
 	sceneObjectData->scaleMode = a3scale_uniform;
+	sceneObjectData->rotateMode = a3rotate_quaternion;
 
 	sceneObject = demoMode->obj_ground;
 	sceneObjectData = sceneObject->dataPtr;
@@ -267,6 +273,7 @@ void a3postproc_load(a3_DemoState const* demoState, a3_DemoMode1_PostProc* demoM
 	sceneObjectData->scale.y = a3real_fortyfive;
 	sceneObjectData->scale.z = a3real_epsilon;
 	sceneObjectData->scaleMode = a3scale_nonuniform;
+	sceneObjectData->rotateMode = a3rotate_quaternion;
 
 
 	// set up projectors
@@ -324,6 +331,10 @@ void a3postproc_load(a3_DemoState const* demoState, a3_DemoMode1_PostProc* demoM
 
 
 	// other options
+	demoMode->cullObjects = a3true;
+	demoMode->occludeObjects = a3true;
+	demoMode->occlusionThreadOption = 1;
+	a3demo_occlusionCreate(demoMode->occlusionBuffer, postprocOcclusion_width, postprocOcclusion_height);
 	demoMode->renderMode = postproc_renderModePhongSM;
 	demoMode->renderPass = postproc_renderPassScene;
 	demoMode->renderTarget[postproc_renderPassShadow] = postproc_renderTargetShadowDepth;
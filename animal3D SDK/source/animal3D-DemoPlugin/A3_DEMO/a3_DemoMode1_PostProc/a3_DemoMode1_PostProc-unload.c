@@ -40,6 +40,12 @@ void a3postproc_unload(a3_DemoState const* demoState, a3_DemoMode1_PostProc* dem
 {
 	// release scene hierarchy
 	a3hierarchyRelease(demoMode->hierarchy_scene);
+
+	// release occlusion buffer
+	a3demo_occlusionRelease(demoMode->occlusionBuffer);
+
+	// release spatial index
+	a3demo_bvhRelease(demoMode->sceneTree);
 }
 
 
@@ -41,6 +41,27 @@
 
 #include "_a3_demo_utilities/a3_DemoSceneObject.h"
 #include "_a3_demo_utilities/a3_DemoShaderProgram.h"
+#include "_a3_demo_utilities/a3_DemoShaderCache.h"
+#include "_a3_demo_utilities/a3_DemoShaderWatch.h"
+#include "_a3_demo_utilities/a3_DemoWorkerPool.h"
+#include "_a3_demo_utilities/a3_DemoTextureLoader.h"
+#include "_a3_demo_utilities/a3_DemoGeometryOptimize.h"
+#include "_a3_demo_utilities/a3_DemoGeometryLOD.h"
+#include "_a3_demo_utilities/a3_DemoGeometryQuantize.h"
+#include "_a3_demo_utilities/a3_DemoGeometryMeshlet.h"
+#include "_a3_demo_utilities/a3_DemoGeometryTangent.h"
+#include "_a3_demo_utilities/a3_DemoCulling.h"
+#include "_a3_demo_utilities/a3_DemoOcclusion.h"
+#include "_a3_demo_utilities/a3_DemoBVH.h"
+#include "_a3_demo_utilities/a3_DemoMathReport.h"
+#include "_a3_demo_utilities/a3_DemoMathBatch.h"
+#include "_a3_demo_utilities/a3_DemoMathTrig.h"
+#include "_a3_demo_utilities/a3_DemoMathRandom.h"
+#include "_a3_demo_utilities/a3_DemoMathStats.h"
+#include "_a3_demo_utilities/a3_DemoMathCurve.h"
+#include "_a3_demo_utilities/a3_DemoMathQuat.h"
+#include "_a3_demo_utilities/a3_DemoMathSqrt.h"
+#include "_a3_demo_utilities/a3_DemoSkinning.h"
 
 #include "a3_DemoMode0_Intro.h"
 #include "a3_DemoMode1_PostProc.h"
@@ -97,10 +118,10 @@ enum a3_DemoState_TextDisplayName
 //	more than enough memory to hold extra objects
 enum a3_DemoState_ObjectMaxCount
 {
-	demoStateMaxCount_timer = 1,
+	demoStateMaxCount_timer = 2,
 
 	demoStateMaxCount_drawDataBuffer = 1,
-	demoStateMaxCount_vertexArray = 4,
+	demoStateMaxCount_vertexArray = 8,
 	demoStateMaxCount_drawable = 16,
 
 	demoStateMaxCount_shaderProgram = 32,
@@ -140,6 +161,15 @@ struct a3_DemoState
 	// asset streaming between loads enabled (careful!)
 	a3boolean streaming;
 
+	// compile and link shader programs without blocking (fallback drawn)
+	a3boolean shaderAsync;
+
+	// rebuild programs whose shader files change on disk
+	a3boolean shaderHotReload;
+
+	// reorder geometry for vertex cache, overdraw and fetch when created
+	a3boolean geometryOptimize;
+
 	// window and full-frame dimensions
 	a3ui32 windowWidth, windowHeight;
 	a3real windowWidthInv, windowHeightInv, windowAspect;
@@ -164,11 +194,17 @@ struct a3_DemoState
 
 	// pointer to fast trig table
 	a3f32 trigTable[4096 * 4];
+	a3ui32 trigSamplesPerDegree;	// 0 if tables are skipped
 
 	// more accurate time tracking
 	a3f64 t_timer, dt_timer, dt_timer_tot;
 	a3i64 n_timer;
 
+	// frame time statistics in milliseconds
+	a3statsRunning dt_stats[1];
+	a3statsAverage dt_average[1];
+	a3statsHistogram dt_histogram[1];
+
 
 	//-------------------------------------------------------------------------
 	// scene variables and objects
@@ -202,7 +238,8 @@ struct a3_DemoState
 		a3_Timer timer[demoStateMaxCount_timer];
 		struct {
 			a3_Timer
-				timer_display[1];						// render FPS timer
+				timer_display[1],						// render FPS timer
+				timer_shaderLoad[1];					// time since shader load started
 		};
 	};
 
@@ -226,6 +263,8 @@ struct a3_DemoState
 			a3_VertexArrayDescriptor
 				vao_position_color[1],						// VAO for vertex format with position and color
 				vao_position[1];							// VAO for vertex format with only position
+			a3_VertexArrayDescriptor
+				vao_tangentbasis_texcoord_quantized[1];		// VAO for quantized vertex format with complete tangent basis, with texcoords
 		};
 	};
 
@@ -245,10 +284,29 @@ struct a3_DemoState
 				draw_unit_cone[1],							// unit cone (radius = height = 1)
 				draw_unit_plane_z[1];						// unit plane (width = height = 1) with Z normal
 			a3_VertexDrawable
-				draw_teapot[1];								// can't not have a Utah teapot
+				draw_teapot[1],								// can't not have a Utah teapot
+				draw_teapot_lod[3];							// simplified teapots (follow base)
+			a3_VertexDrawable
+				draw_teapot_quantized[1];					// full teapot in quantized vertex format
 		};
 	};
 
+	// teapot detail levels, selected by projected error
+	a3_DemoGeometryLOD teapotLOD[1];
+
+	// transform restoring quantized teapot attributes in shaders
+	a3_DemoGeometryDequantize teapotDequantize[1];
+
+	// cluster tables for culling, one per drawable (same index)
+	a3_DemoGeometryMeshlets meshlets[demoStateMaxCount_drawable];
+
+	// simplified occluders for software occlusion culling, one per 
+	//	drawable (same index); only shapes that can hide others
+	a3_DemoOccluderMesh occluders[demoStateMaxCount_drawable];
+
+	// generated procedural shapes, by descriptor
+	a3_ProceduralGeometryCache geometryCache[1];
+
 
 	// shader programs and uniforms
 	union {
@@ -261,7 +319,8 @@ struct a3_DemoState
 				prog_drawColorAttrib_instanced[1],			// draw color attribute with instancing
 				prog_drawColorUnif_instanced[1],			// draw uniform color with instancing
 				prog_drawColorAttrib[1],					// draw color attribute
-				prog_drawColorUnif[1];						// draw uniform color
+				prog_drawColorUnif[1],						// draw uniform color
+				prog_drawColorUnif_quantized[1];			// draw uniform color with quantized positions
 			a3_DemoStateShaderProgram
 				prog_drawPhong_instanced[1],				// draw Phong shading model with instancing
 				prog_drawLambert_instanced[1],				// draw Lambert shading model with instancing
@@ -281,6 +340,20 @@ struct a3_DemoState
 		};
 	};
 
+	// shader programs still compiling asynchronously, matching the list 
+	//	above; if one has a valid handle, the program above is a managed 
+	//	stand-in (the fallback) until this one is ready
+	a3_DemoStateShaderProgram shaderProgramPending[demoStateMaxCount_shaderProgram];
+	a3ui64 shaderProgramPendingKey[demoStateMaxCount_shaderProgram];
+	a3_Timer shaderProgramPendingTimer[demoStateMaxCount_shaderProgram];	// running since submit
+	a3ui32 shaderProgramPendingCount;
+
+	// program binary cache, open while programs are loading
+	a3_DemoShaderCache shaderCache[1];
+
+	// shader source files and the programs that depend on them
+	a3_DemoShaderWatch shaderWatch[1];
+
 	// uniform buffers
 	union {
 		a3_UniformBuffer uniformBuffer[demoStateMaxCount_uniformBuffer];
@@ -318,6 +391,13 @@ struct a3_DemoState
 		};
 	};
 
+	// textures still loading in the background
+	a3_DemoTextureLoader textureLoader[1];
+
+	// workers shared by per-frame batches; stopped on every unload, since
+	//	they run code from this library, and started again on load
+	a3_DemoWorkerPool* workerPool;
+
 
 	// ****TO-DO:
 	//	-> uncomment framebuffers
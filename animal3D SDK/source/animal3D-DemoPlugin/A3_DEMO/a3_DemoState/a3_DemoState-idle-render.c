@@ -82,6 +82,12 @@ void a3demo_render_controls_global(a3_DemoState const* demoState,
 			"Toggle text display:        't' (toggle) | 'T' (alloc/dealloc) ");
 		a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 			"Reload all shader programs: 'P' ****CHECK CONSOLE FOR ERRORS!**** ");
+		a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+			"Texture compression report: 'C' (results in console) ");
+		a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+			"Geometry optimization, quantization and tangent report: 'O' (results in console) ");
+		a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+			"Vector and matrix kernel report: 'M' (results in console) ");
 	}
 }
 
@@ -171,6 +177,10 @@ void a3demo_render_data(const a3_DemoState* demoState,
 		"dt_render = %07.4lf ms", (demoState->dt_timer) * 1000.0);//demoState->timer_display->previousTick * 1000.0);
 	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"t_render = %07.4lf s | n_render = %lu", demoState->timer_display->totalTime, demoState->n_timer);//demoState->timer_display->totalTime, demoState->timer_display->ticks);
+	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"dt_render mean = %07.4lf ms | sd = %07.4lf ms | recent = %07.4lf ms", (a3f64)demoState->dt_stats->mean, (a3f64)a3statsRunningStandardDeviation(demoState->dt_stats), (a3f64)demoState->dt_average->mean);
+	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"dt_render p50 = %07.4lf ms | p95 = %07.4lf ms | p99 = %07.4lf ms | max = %07.4lf ms", (a3f64)a3statsHistogramPercentile(demoState->dt_histogram, (a3real)0.50), (a3f64)a3statsHistogramPercentile(demoState->dt_histogram, (a3real)0.95), (a3f64)a3statsHistogramPercentile(demoState->dt_histogram, (a3real)0.99), (a3f64)demoState->dt_histogram->maximum);
 
 	// global/input-dependent controls
 	textOffset = -0.6f;
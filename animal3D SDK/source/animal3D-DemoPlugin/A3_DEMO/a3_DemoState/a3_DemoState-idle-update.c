@@ -52,13 +52,26 @@ void a3demo_update_defaultAnimation(a3f64 const dt, a3_SceneObjectComponent cons
 	a3ui32 const count, a3ui32 const axis, a3boolean const updateAnimation)
 {
 	a3real const dr = (a3real)(dt * (a3f64)updateAnimation);
+	a3quat dq;
+	a3vec3 dqAxis = a3vec3_zero;
 	a3ui32 i;
 
+	// one delta rotation shared by quaternion objects, so trig is per call
+	dqAxis.v[axis] = a3real_one;
+	a3quatSetAxisAngle(dq.q, dqAxis.v, dr);
+
 	// do simple animation
 	for (i = 0; i < count; ++i, ++sceneObjectArray)
 	{
-		sceneObjectArray->dataPtr->euler.v[axis] =
-			a3trigValid_sind(sceneObjectArray->dataPtr->euler.v[axis] + dr);
+		if (sceneObjectArray->dataPtr->rotateMode == a3rotate_quaternion)
+		{
+			// renormalize so error does not accumulate
+			a3quatConcatL(sceneObjectArray->dataPtr->rotation.q, dq.q);
+			a3real4Normalize(sceneObjectArray->dataPtr->rotation.q);
+		}
+		else
+			sceneObjectArray->dataPtr->euler.v[axis] =
+				a3trigValid_sind(sceneObjectArray->dataPtr->euler.v[axis] + dr);
 	}
 }
 
@@ -46,6 +46,7 @@
 #ifdef A3_USER_ENABLE_SHADER_DECODING
 // override shader loading function name before including
 #define a3shaderCreateFromFileList a3shaderCreateFromFileListEncoded
+#define a3shaderCreateFromFileListAsync a3shaderCreateFromFileListEncoded
 #endif	// A3_USER_ENABLE_SHADER_DECODING
 
 
@@ -74,12 +75,18 @@
 #define A3_DEMO_FS		A3_DEMO_GLSL"4x/fs/"
 #define A3_DEMO_CS		A3_DEMO_GLSL"4x/cs/"
 
+// define data directories
+#define A3_DEMO_SHADER_CACHE_DIR	"./data/shader_cache"
+#define A3_DEMO_TEXTURE_CACHE_DIR	"./data/texture_cache"
+
 
 //-----------------------------------------------------------------------------
 
 #include "../a3_DemoState.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 
 //-----------------------------------------------------------------------------
@@ -181,16 +188,48 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 
 
 	// file streaming (if requested)
+	// (optimized geometry is kept in its own stream; names change when 
+	//	the geometry record does, so older streams are regenerated)
 	a3_FileStream fileStream[1] = { 0 };
-	const a3byte *const geometryStream = "./data/gpro_base_geom.dat";
+	const a3byte *const geometryStream = demoState->geometryOptimize
+		? "./data/gpro_base_geom_opt_b.dat" : "./data/gpro_base_geom_b.dat";
 
 	// geometry data
 	a3_GeometryData displayShapesData[2] = { 0 };
 	a3_GeometryData proceduralShapesData[7] = { 0 };
 	a3_GeometryData loadedModelsData[1] = { 0 };
+	a3_GeometryData teapotLODData[a3demoArrayLen(demoState->draw_teapot_lod)] = { 0 };
+	a3_GeometryData teapotQuantizedData[1] = { 0 };
+	const a3f32 teapotLODRatio[a3demoArrayLen(teapotLODData)] = { 0.5f, 0.25f, 0.125f };
 	const a3ui32 displayShapesCount = a3demoArrayLen(displayShapesData);
 	const a3ui32 proceduralShapesCount = a3demoArrayLen(proceduralShapesData);
 	const a3ui32 loadedModelsCount = a3demoArrayLen(loadedModelsData);
+	const a3ui32 teapotLODCount = a3demoArrayLen(teapotLODData);
+
+	// procedural shapes are generated in batches of this many tasks on 
+	//	the worker pool, and kept in the state's cache so repeated shapes 
+	//	are copied
+	a3_GeometryDispatcher geometryDispatcher[1] = { { a3demo_workerPoolDispatch, demoState->workerPool, 4 } };
+
+	// cluster tables and the drawables they are kept with
+	a3_DemoGeometryMeshlets proceduralShapesMeshlets[a3demoArrayLen(proceduralShapesData)] = { 0 };
+	a3_DemoGeometryMeshlets loadedModelsMeshlets[a3demoArrayLen(loadedModelsData)] = { 0 };
+	a3_VertexDrawable const* const proceduralShapesDrawable[a3demoArrayLen(proceduralShapesData)] = {
+		demoState->draw_unit_plane_z, demoState->draw_unit_box, demoState->draw_unit_sphere, demoState->draw_unit_cylinder,
+		demoState->draw_unit_capsule, demoState->draw_unit_torus, demoState->draw_unit_cone,
+	};
+	a3_VertexDrawable const* const loadedModelsDrawable[a3demoArrayLen(loadedModelsData)] = {
+		demoState->draw_teapot,
+	};
+
+	// coarse occluders and the drawables they stand in for
+	a3_ProceduralGeometryDescriptor occluderShapes[5] = { a3geomShape_none };
+	a3_GeometryData occluderData[a3demoArrayLen(occluderShapes)] = { 0 };
+	a3_VertexDrawable const* const occluderDrawable[a3demoArrayLen(occluderShapes)] = {
+		demoState->draw_unit_sphere, demoState->draw_unit_cylinder, demoState->draw_unit_capsule,
+		demoState->draw_unit_cone, demoState->draw_unit_plane_z,
+	};
+	const a3ui32 occluderCount = a3demoArrayLen(occluderShapes);
 
 	// common index format
 	a3_IndexFormatDescriptor sceneCommonIndexFormat[1] = { 0 };
@@ -215,6 +254,12 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 		for (i = 0; i < loadedModelsCount; ++i)
 			a3fileStreamReadObject(fileStream, loadedModelsData + i, (a3_FileStreamReadFunc)a3geometryLoadDataBinary);
 
+		// cluster tables (older streams have none; built below)
+		for (i = 0; i < proceduralShapesCount; ++i)
+			a3fileStreamReadObject(fileStream, proceduralShapesMeshlets + i, (a3_FileStreamReadFunc)a3demo_geometryLoadMeshletsBinary);
+		for (i = 0; i < loadedModelsCount; ++i)
+			a3fileStreamReadObject(fileStream, loadedModelsMeshlets + i, (a3_FileStreamReadFunc)a3demo_geometryLoadMeshletsBinary);
+
 		// done
 		a3fileStreamClose(fileStream);
 	}
@@ -232,9 +277,9 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 		//	(axes, grid)
 		a3proceduralCreateDescriptorAxes(displayShapes + 0, a3geomFlag_wireframe, 0.0f, 1);
 		a3proceduralCreateDescriptorPlane(displayShapes + 1, a3geomFlag_wireframe, a3geomAxis_default, 20.0f, 20.0f, 20, 20);
+		a3proceduralCacheGenerate(demoState->geometryCache, displayShapesData, displayShapes, displayShapesCount, geometryDispatcher);
 		for (i = 0; i < displayShapesCount; ++i)
 		{
-			a3proceduralGenerateGeometryData(displayShapesData + i, displayShapes + i, 0);
 			a3fileStreamWriteObject(fileStream, displayShapesData + i, (a3_FileStreamWriteFunc)a3geometrySaveDataBinary);
 		}
 
@@ -246,9 +291,11 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 		a3proceduralCreateDescriptorCapsule(proceduralShapes + 4, a3geomFlag_texcoords_normals, a3geomAxis_x, 1.0f, 1.0f, 32, 12, 4);
 		a3proceduralCreateDescriptorTorus(proceduralShapes + 5, a3geomFlag_texcoords_normals, a3geomAxis_x, 1.0f, 0.25f, 32, 24);
 		a3proceduralCreateDescriptorCone(proceduralShapes + 6, a3geomFlag_texcoords_normals, a3geomAxis_x, 1.0f, 1.0, 32, 1, 1);
+		a3proceduralCacheGenerate(demoState->geometryCache, proceduralShapesData, proceduralShapes, proceduralShapesCount, geometryDispatcher);
 		for (i = 0; i < proceduralShapesCount; ++i)
 		{
-			a3proceduralGenerateGeometryData(proceduralShapesData + i, proceduralShapes + i, 0);
+			if (demoState->geometryOptimize)
+				a3demo_geometryOptimize(proceduralShapesData + i, 0, a3demo_geometryOptimizeOverdrawThreshold);
 			a3fileStreamWriteObject(fileStream, proceduralShapesData + i, (a3_FileStreamWriteFunc)a3geometrySaveDataBinary);
 		}
 
@@ -256,13 +303,65 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 		for (i = 0; i < loadedModelsCount; ++i)
 		{
 			a3modelLoadOBJ(loadedModelsData + i, loadedShapes[i].modelFilePath, loadedShapes[i].flag, loadedShapes[i].transform);
+			if (demoState->geometryOptimize)
+				a3demo_geometryOptimize(loadedModelsData + i, 0, a3demo_geometryOptimizeOverdrawThreshold);
 			a3fileStreamWriteObject(fileStream, loadedModelsData + i, (a3_FileStreamWriteFunc)a3geometrySaveDataBinary);
 		}
 
+		// cluster tables for culling, after any reordering
+		for (i = 0; i < proceduralShapesCount; ++i)
+		{
+			a3demo_geometryBuildMeshlets(proceduralShapesMeshlets + i, proceduralShapesData + i, 0, 0);
+			a3fileStreamWriteObject(fileStream, proceduralShapesMeshlets + i, (a3_FileStreamWriteFunc)a3demo_geometrySaveMeshletsBinary);
+		}
+		for (i = 0; i < loadedModelsCount; ++i)
+		{
+			a3demo_geometryBuildMeshlets(loadedModelsMeshlets + i, loadedModelsData + i, 0, 0);
+			a3fileStreamWriteObject(fileStream, loadedModelsMeshlets + i, (a3_FileStreamWriteFunc)a3demo_geometrySaveMeshletsBinary);
+		}
+
 		// done
 		a3fileStreamClose(fileStream);
 	}
 
+	// cluster tables missing from stream
+	for (i = 0; i < proceduralShapesCount; ++i)
+		if (!proceduralShapesMeshlets[i].meshlet)
+			a3demo_geometryBuildMeshlets(proceduralShapesMeshlets + i, proceduralShapesData + i, 0, 0);
+	for (i = 0; i < loadedModelsCount; ++i)
+		if (!loadedModelsMeshlets[i].meshlet)
+			a3demo_geometryBuildMeshlets(loadedModelsMeshlets + i, loadedModelsData + i, 0, 0);
+
+
+	// teapot detail levels, simplified whether loaded or streamed
+	a3demo_geometryGenerateLOD(demoState->teapotLOD, teapotLODData, loadedModelsData + 0, teapotLODRatio, teapotLODCount);
+	if (demoState->geometryOptimize)
+		for (i = 0; i + 1 < demoState->teapotLOD->levelCount; ++i)
+			a3demo_geometryOptimize(teapotLODData + i, 0, a3demo_geometryOptimizeOverdrawThreshold);
+	for (i = 0; i + 1 < demoState->teapotLOD->levelCount; ++i)
+		a3demo_geometryBuildMeshlets(demoState->meshlets + (demoState->draw_teapot_lod + i - demoState->drawable), teapotLODData + i, 0, 0);
+
+	// compact copy of full teapot for the solid color pass, which restores 
+	//	positions from the quantized format in its vertex shader
+	a3demo_geometryQuantize(teapotQuantizedData, demoState->teapotDequantize, loadedModelsData + 0, 0, 0);
+
+
+	// occluders: positions only, keeping every fourth slice and ring of 
+	//	the shapes drawn, so each is inscribed in its shape and cannot hide 
+	//	anything the real shape would not; torus and teapot are not convex 
+	//	and are left out
+	a3proceduralCreateDescriptorSphere(occluderShapes + 0, a3geomFlag_vanilla, a3geomAxis_default, 1.0f, 8, 6);
+	a3proceduralCreateDescriptorCylinder(occluderShapes + 1, a3geomFlag_vanilla, a3geomAxis_x, 1.0f, 1.0f, 8, 1, 1);
+	a3proceduralCreateDescriptorCapsule(occluderShapes + 2, a3geomFlag_vanilla, a3geomAxis_x, 1.0f, 1.0f, 8, 3, 1);
+	a3proceduralCreateDescriptorCone(occluderShapes + 3, a3geomFlag_vanilla, a3geomAxis_x, 1.0f, 1.0, 8, 1, 1);
+	a3proceduralCreateDescriptorPlane(occluderShapes + 4, a3geomFlag_vanilla, a3geomAxis_default, 1.0f, 1.0f, 1, 1);
+	a3proceduralCacheGenerate(demoState->geometryCache, occluderData, occluderShapes, occluderCount, geometryDispatcher);
+	for (i = 0; i < occluderCount; ++i)
+	{
+		a3demo_occlusionBuildOccluder(demoState->occluders + (occluderDrawable[i] - demoState->drawable), occluderData + i);
+		a3geometryReleaseData(occluderData + i);
+	}
+
 
 	// GPU data upload process: 
 	//	- determine storage requirements
@@ -287,6 +386,13 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 		sharedVertexStorage += a3geometryGetVertexBufferSize(loadedModelsData + i);
 		numVerts += loadedModelsData[i].numVertices;
 	}
+	for (i = 0; i < teapotLODCount; ++i)
+	{
+		sharedVertexStorage += a3geometryGetVertexBufferSize(teapotLODData + i);
+		numVerts += teapotLODData[i].numVertices;
+	}
+	sharedVertexStorage += a3geometryGetVertexBufferSize(teapotQuantizedData);
+	numVerts += teapotQuantizedData->numVertices;
 
 
 	// common index format required for shapes that share vertex formats
@@ -298,6 +404,9 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 		sharedIndexStorage += a3indexFormatGetStorageSpaceRequired(sceneCommonIndexFormat, proceduralShapesData[i].numIndices);
 	for (i = 0; i < loadedModelsCount; ++i)
 		sharedIndexStorage += a3indexFormatGetStorageSpaceRequired(sceneCommonIndexFormat, loadedModelsData[i].numIndices);
+	for (i = 0; i < teapotLODCount; ++i)
+		sharedIndexStorage += a3indexFormatGetStorageSpaceRequired(sceneCommonIndexFormat, teapotLODData[i].numIndices);
+	sharedIndexStorage += a3indexFormatGetStorageSpaceRequired(sceneCommonIndexFormat, teapotQuantizedData->numIndices);
 
 	// create shared buffer
 	vbo_ibo = demoState->vbo_staticSceneObjectDrawBuffer;
@@ -341,6 +450,26 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 	a3geometryGenerateVertexArray(vao, "vao:tb+tc", loadedModelsData + 0, vbo_ibo, sharedVertexStorage);
 	currentDrawable = demoState->draw_teapot;
 	sharedVertexStorage += a3geometryGenerateDrawable(currentDrawable, loadedModelsData + 0, vao, vbo_ibo, sceneCommonIndexFormat, 0, 0);
+	for (i = 0; i + 1 < demoState->teapotLOD->levelCount; ++i)
+	{
+		currentDrawable = demoState->draw_teapot_lod + i;
+		sharedVertexStorage += a3geometryGenerateDrawable(currentDrawable, teapotLODData + i, vao, vbo_ibo, sceneCommonIndexFormat, 0, 0);
+	}
+
+	// quantized teapot: same attributes in compact types
+	if (teapotQuantizedData->data)
+	{
+		vao = demoState->vao_tangentbasis_texcoord_quantized;
+		a3geometryGenerateVertexArray(vao, "vao:tb+tc:quant", teapotQuantizedData, vbo_ibo, sharedVertexStorage);
+		currentDrawable = demoState->draw_teapot_quantized;
+		sharedVertexStorage += a3geometryGenerateDrawable(currentDrawable, teapotQuantizedData, vao, vbo_ibo, sceneCommonIndexFormat, 0, 0);
+	}
+
+	// cluster tables are kept alongside their drawables
+	for (i = 0; i < proceduralShapesCount; ++i)
+		demoState->meshlets[proceduralShapesDrawable[i] - demoState->drawable] = proceduralShapesMeshlets[i];
+	for (i = 0; i < loadedModelsCount; ++i)
+		demoState->meshlets[loadedModelsDrawable[i] - demoState->drawable] = loadedModelsMeshlets[i];
 
 
 	// release data when done
@@ -350,6 +479,9 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 		a3geometryReleaseData(proceduralShapesData + i);
 	for (i = 0; i < loadedModelsCount; ++i)
 		a3geometryReleaseData(loadedModelsData + i);
+	for (i = 0; i < teapotLODCount; ++i)
+		a3geometryReleaseData(teapotLODData + i);
+	a3geometryReleaseData(teapotQuantizedData);
 
 
 	// dummy
@@ -357,31 +489,18 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 }
 
 
-// utility to load shaders
-void a3demo_loadShaders(a3_DemoState *demoState)
+// prepare uniforms algorithmically instead of manually for a program
+// get uniform and uniform block locations and set default values for all 
+//	programs that have a uniform that will either never change or is
+//	consistent for all programs
+void a3demo_initShaderProgramUniforms_internal(a3_DemoState const* demoState, a3_DemoStateShaderProgram* currentDemoProg)
 {
-	// structure to help with shader management
-	typedef struct a3_TAG_DEMOSTATESHADER {
-		a3_Shader shader[1];
-		a3byte shaderName[32];
-
-		a3_ShaderType shaderType;
-		a3ui32 srcCount;
-		const a3byte* filePath[8];	// max number of source files per shader
-	} a3_DemoStateShader;
-
-	// direct to demo programs
-	a3_DemoStateShaderProgram *currentDemoProg;
-	a3i32 flag;
-	a3ui32 i;
-
-	// maximum uniform buffer size
-	const a3ui32 uBlockSzMax = a3shaderUniformBlockMaxSize();
-
 	// some default uniform values
 	const a3f32 defaultFloat[] = { 0.0f, 0.0f, 0.0f, 1.0f };
 	const a3f64 defaultDouble[] = { 0.0, 0.0, 0.0, 1.0 };
 	const a3i32 defaultInt[] = { 0, 0, 0, 1 };
+	const a3f32 defaultPositionScale[] = { 1.0f, 1.0f, 1.0f, 0.0f };
+	const a3f32 defaultTexcoordTransform[] = { 1.0f, 1.0f, 0.0f, 0.0f };
 	const a3i32 defaultTexUnits[] = {
 		a3tex_unit00, a3tex_unit01, a3tex_unit02, a3tex_unit03,
 		a3tex_unit04, a3tex_unit05, a3tex_unit06, a3tex_unit07,
@@ -397,6 +516,146 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 		0.0f, 0.0f, 0.0f, 1.0f
 	};
 
+	// activate program
+	a3shaderProgramActivate(currentDemoProg->program);
+
+	// common VS
+	a3demo_setUniformDefaultMat4(currentDemoProg, uMVP);
+	a3demo_setUniformDefaultMat4(currentDemoProg, uMV);
+	a3demo_setUniformDefaultMat4(currentDemoProg, uP);
+	a3demo_setUniformDefaultMat4(currentDemoProg, uP_inv);
+	a3demo_setUniformDefaultMat4(currentDemoProg, uPB);
+	a3demo_setUniformDefaultMat4(currentDemoProg, uPB_inv);
+	a3demo_setUniformDefaultMat4(currentDemoProg, uMV_nrm);
+	a3demo_setUniformDefaultMat4(currentDemoProg, uMVPB);
+	a3demo_setUniformDefaultMat4(currentDemoProg, uMVPB_other);
+	a3demo_setUniformDefaultMat4(currentDemoProg, uAtlas);
+
+	// common texture
+	a3demo_setUniformDefaultInteger(currentDemoProg, uTex_dm, defaultTexUnits + 0);
+	a3demo_setUniformDefaultInteger(currentDemoProg, uTex_sm, defaultTexUnits + 1);
+	a3demo_setUniformDefaultInteger(currentDemoProg, uTex_nm, defaultTexUnits + 2);
+	a3demo_setUniformDefaultInteger(currentDemoProg, uTex_hm, defaultTexUnits + 3);
+	a3demo_setUniformDefaultInteger(currentDemoProg, uTex_ramp_dm, defaultTexUnits + 4);
+	a3demo_setUniformDefaultInteger(currentDemoProg, uTex_ramp_sm, defaultTexUnits + 5);
+	a3demo_setUniformDefaultInteger(currentDemoProg, uTex_shadow, defaultTexUnits + 6);
+	a3demo_setUniformDefaultInteger(currentDemoProg, uTex_project, defaultTexUnits + 7);
+	a3demo_setUniformDefaultInteger(currentDemoProg, uImage00, defaultTexUnits + 0);
+	a3demo_setUniformDefaultInteger(currentDemoProg, uImage01, defaultTexUnits + 1);
+	a3demo_setUniformDefaultInteger(currentDemoProg, uImage02, defaultTexUnits + 2);
+	a3demo_setUniformDefaultInteger(currentDemoProg, uImage03, defaultTexUnits + 3);
+	a3demo_setUniformDefaultInteger(currentDemoProg, uImage04, defaultTexUnits + 4);
+	a3demo_setUniformDefaultInteger(currentDemoProg, uImage05, defaultTexUnits + 5);
+	a3demo_setUniformDefaultInteger(currentDemoProg, uImage06, defaultTexUnits + 6);
+	a3demo_setUniformDefaultInteger(currentDemoProg, uImage07, defaultTexUnits + 7);
+
+	// common general
+	a3demo_setUniformDefaultInteger(currentDemoProg, uIndex, defaultInt);
+	a3demo_setUniformDefaultInteger(currentDemoProg, uCount, defaultInt);
+	a3demo_setUniformDefaultDouble(currentDemoProg, uAxis, defaultDouble);
+	a3demo_setUniformDefaultDouble(currentDemoProg, uSize, defaultDouble);
+	a3demo_setUniformDefaultDouble(currentDemoProg, uFlag, defaultDouble);
+	a3demo_setUniformDefaultDouble(currentDemoProg, uTime, defaultDouble);
+	a3demo_setUniformDefaultVec4(currentDemoProg, uColor0, a3vec4_one.v);
+	a3demo_setUniformDefaultVec4(currentDemoProg, uColor, a3vec4_one.v);
+
+	// quantized vertex format
+	a3demo_setUniformDefaultVec4(currentDemoProg, uPositionScale, defaultPositionScale);
+	a3demo_setUniformDefaultVec4(currentDemoProg, uPositionBias, defaultFloat);
+	a3demo_setUniformDefaultVec4(currentDemoProg, uTexcoordTransform, defaultTexcoordTransform);
+
+	// transformation uniform blocks
+	a3demo_setUniformDefaultBlock(currentDemoProg, ubTransformStack, demoProg_blockTransformStack);
+	a3demo_setUniformDefaultBlock(currentDemoProg, ubTransformBlend, demoProg_blockTransformBlend);
+	a3demo_setUniformDefaultBlock(currentDemoProg, ubTransformMVP, demoProg_blockTransformStack);
+	a3demo_setUniformDefaultBlock(currentDemoProg, ubTransformMVPB, demoProg_blockTransformBlend);
+
+	// lighting and shading uniform blocks
+	a3demo_setUniformDefaultBlock(currentDemoProg, ubMaterial, demoProg_blockMaterial);
+	a3demo_setUniformDefaultBlock(currentDemoProg, ubLight, demoProg_blockLight);
+
+	// additional pre-configuration for some programs whose uniforms will not change
+	// e.g. post-processing effects must transform unit FSQ to true FSQ
+	if (currentDemoProg >= demoState->prog_postBright &&
+		currentDemoProg <= demoState->prog_postBlend)
+		a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProg->uMVP, 1, fsq.mm);
+}
+
+// make a program a managed stand-in for another program
+// DO NOT RELEASE THE SOURCE WHILE STAND-INS EXIST; stand-ins do not own it
+inline void a3demo_initShaderProgramStandIn_internal(a3_DemoStateShaderProgram* demoProg_out, a3_DemoStateShaderProgram const* demoProg)
+{
+	*demoProg_out = *demoProg;
+	a3handleSetReleaseFunc(demoProg_out->program->handle, 0);
+}
+
+// program drawn in place of programs still compiling
+inline a3_DemoStateShaderProgram* a3demo_getFallbackShaderProgram_internal(a3_DemoState* demoState)
+{
+	return demoState->prog_drawColorUnif;
+}
+
+// make programs that are still compiling stand-ins for the fallback; only 
+//	slots drawing with the old fallback (or nothing, on full load) are 
+//	re-pointed, live programs waiting on a rebuild are left alone
+inline void a3demo_initShaderProgramStandIns_internal(a3_DemoState* demoState, a3ui32 const oldFallbackHandle)
+{
+	a3_DemoStateShaderProgram const* fallbackDemoProg = a3demo_getFallbackShaderProgram_internal(demoState);
+	a3ui32 i;
+	for (i = 0; i < demoStateMaxCount_shaderProgram; ++i)
+		if (demoState->shaderProgramPending[i].program->handle->handle && 
+			demoState->shaderProgram[i].program->handle->handle == oldFallbackHandle &&
+			demoState->shaderProgram + i != fallbackDemoProg)
+			a3demo_initShaderProgramStandIn_internal(demoState->shaderProgram + i, fallbackDemoProg);
+}
+
+// swap a finished pending program in over the live one, which is released
+//	(stand-ins release nothing), and prepare it for drawing
+inline void a3demo_swapShaderProgram_internal(a3_DemoState* demoState, a3ui32 const index)
+{
+	a3_DemoStateShaderProgram* const currentDemoProg = demoState->shaderProgram + index;
+	a3_DemoStateShaderProgram* const pendingDemoProg = demoState->shaderProgramPending + index;
+	a3ui32 const oldHandle = currentDemoProg->program->handle->handle;
+	a3i32 flag;
+
+	a3shaderProgramRelease(currentDemoProg->program);
+	*currentDemoProg = *pendingDemoProg;
+	memset(pendingDemoProg, 0, sizeof(*pendingDemoProg));
+
+	flag = a3shaderProgramValidate(currentDemoProg->program);
+	if (flag == 0)
+		printf("\n ^^^^ PROGRAM %u '%s' FAILED TO VALIDATE \n\n", index, currentDemoProg->program->handle->name);
+	a3demo_initShaderProgramUniforms_internal(demoState, currentDemoProg);
+
+	// new fallback: stand-ins must not keep the released one
+	if (currentDemoProg == a3demo_getFallbackShaderProgram_internal(demoState))
+		a3demo_initShaderProgramStandIns_internal(demoState, oldHandle);
+}
+
+
+// utility to load all shaders, or only those in mask when reloading
+void a3demo_loadShaders_internal(a3_DemoState *demoState, a3ui64 const reloadMask)
+{
+	// structure to help with shader management
+	typedef struct a3_TAG_DEMOSTATESHADER {
+		a3_Shader shader[1];
+		a3byte shaderName[32];
+
+		a3_ShaderType shaderType;
+		a3ui32 srcCount;
+		const a3byte* filePath[8];	// max number of source files per shader
+
+		a3ui64 sourceKey;			// hash of stage and source contents (cache)
+	} a3_DemoStateShader;
+
+	// direct to demo programs
+	a3_DemoStateShaderProgram *currentDemoProg;
+	a3i32 flag;
+	a3ui32 i;
+
+	// maximum uniform buffer size
+	const a3ui32 uBlockSzMax = a3shaderUniformBlockMaxSize();
+
 
 	// list of all unique shaders
 	// this is a good idea to avoid multi-loading 
@@ -409,7 +668,8 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 				passthru_transform_vs[1],
 				passColor_transform_vs[1],
 				passthru_transform_instanced_vs[1],
-				passColor_transform_instanced_vs[1];
+				passColor_transform_instanced_vs[1],
+				passthru_transform_quantized_vs[1];
 			// 00-common
 			a3_DemoStateShader
 				passTexcoord_transform_vs[1],
@@ -455,11 +715,15 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 			{ { { 0 },	"shdr-vs:pass-col-trans",			a3shader_vertex  ,	1,{ A3_DEMO_VS"passColor_transform_vs4x.glsl" } } },
 			{ { { 0 },	"shdr-vs:passthru-trans-inst",		a3shader_vertex  ,	1,{ A3_DEMO_VS"passthru_transform_instanced_vs4x.glsl" } } },
 			{ { { 0 },	"shdr-vs:pass-col-trans-inst",		a3shader_vertex  ,	1,{ A3_DEMO_VS"passColor_transform_instanced_vs4x.glsl" } } },
+			{ { { 0 },	"shdr-vs:passthru-trans-quant",		a3shader_vertex  ,	2,{ A3_DEMO_VS"passthru_transform_quantized_vs4x.glsl",
+																					A3_DEMO_VS"00-common/utilCommon_vs4x.glsl",} } },
 			// 00-common
 			{ { { 0 },	"shdr-vs:pass-tex-trans",			a3shader_vertex  ,	1,{ A3_DEMO_VS"00-common/passTexcoord_transform_vs4x.glsl" } } },
-			{ { { 0 },	"shdr-vs:pass-tb-trans",			a3shader_vertex  ,	1,{ A3_DEMO_VS"00-common/passTangentBasis_transform_vs4x.glsl" } } },
+			{ { { 0 },	"shdr-vs:pass-tb-trans",			a3shader_vertex  ,	2,{ A3_DEMO_VS"00-common/passTangentBasis_transform_vs4x.glsl",
+																					A3_DEMO_VS"00-common/utilCommon_vs4x.glsl",} } },
 			{ { { 0 },	"shdr-vs:pass-tex-trans-inst",		a3shader_vertex  ,	1,{ A3_DEMO_VS"00-common/passTexcoord_transform_instanced_vs4x.glsl" } } },
-			{ { { 0 },	"shdr-vs:pass-tb-trans-inst",		a3shader_vertex  ,	1,{ A3_DEMO_VS"00-common/passTangentBasis_transform_instanced_vs4x.glsl" } } },
+			{ { { 0 },	"shdr-vs:pass-tb-trans-inst",		a3shader_vertex  ,	2,{ A3_DEMO_VS"00-common/passTangentBasis_transform_instanced_vs4x.glsl",
+																					A3_DEMO_VS"00-common/utilCommon_vs4x.glsl",} } },
 			// 01-pipeline
 			{ { { 0 },	"shdr-vs:pass-tb-sc-trans",			a3shader_vertex  ,	1,{ A3_DEMO_VS"01-pipeline/passTangentBasis_shadowCoord_transform_vs4x.glsl" } } }, // ****DECODE
 			{ { { 0 },	"shdr-vs:pass-tb-sc-trans-inst",	a3shader_vertex  ,	1,{ A3_DEMO_VS"01-pipeline/passTangentBasis_shadowCoord_transform_instanced_vs4x.glsl" } } },
@@ -491,129 +755,118 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 	const a3ui32 numUniqueShaders = sizeof(shaderList) / sizeof(a3_DemoStateShader);
 
 
-	printf("\n\n---------------- LOAD SHADERS STARTED  ---------------- \n");
+	// list of all programs and the shaders that make them up
+	// shaders are only compiled if a program using them misses the cache
+	struct {
+		a3_DemoStateShaderProgram* demoProg;
+		a3byte programName[32];
+		a3_DemoStateShader* shader[4];	// max number of stages per program
+	} const programList[] = {
+		// base programs: 
+		// transform-only program
+		{ demoState->prog_transform,					"prog:transform",				{ shaderList.passthru_transform_vs, } },
+		// transform-only program with instancing
+		{ demoState->prog_transform_instanced,			"prog:transform-inst",			{ shaderList.passthru_transform_instanced_vs, } },
+		// uniform color program
+		{ demoState->prog_drawColorUnif,				"prog:draw-col-unif",			{ shaderList.passthru_transform_vs, shaderList.drawColorUnif_fs, } },
+		// color attrib program
+		{ demoState->prog_drawColorAttrib,				"prog:draw-col-attr",			{ shaderList.passColor_transform_vs, shaderList.drawColorAttrib_fs, } },
+		// uniform color program with instancing
+		{ demoState->prog_drawColorUnif_instanced,		"prog:draw-col-unif-inst",		{ shaderList.passthru_transform_instanced_vs, shaderList.drawColorUnif_fs, } },
+		// color attrib program with instancing
+		{ demoState->prog_drawColorAttrib_instanced,	"prog:draw-col-attr-inst",		{ shaderList.passColor_transform_instanced_vs, shaderList.drawColorAttrib_fs, } },
+		// uniform color program for quantized vertex format
+		{ demoState->prog_drawColorUnif_quantized,		"prog:draw-col-unif-quant",		{ shaderList.passthru_transform_quantized_vs, shaderList.drawColorUnif_fs, } },
+
+		// 00-common programs: 
+		// texturing
+		{ demoState->prog_drawTexture,					"prog:draw-tex",				{ shaderList.passTexcoord_transform_vs, shaderList.drawTexture_fs, } },
+		// texturing with instancing
+		{ demoState->prog_drawTexture_instanced,		"prog:draw-tex-inst",			{ shaderList.passTexcoord_transform_instanced_vs, shaderList.drawTexture_fs, } },
+		// Lambert
+		{ demoState->prog_drawLambert,					"prog:draw-Lambert",			{ shaderList.passTangentBasis_transform_vs, shaderList.drawLambert_fs, } },
+		// Lambert with instancing
+		{ demoState->prog_drawLambert_instanced,		"prog:draw-Lambert-inst",		{ shaderList.passTangentBasis_transform_instanced_vs, shaderList.drawLambert_fs, } },
+		// Phong
+		{ demoState->prog_drawPhong,					"prog:draw-Phong",				{ shaderList.passTangentBasis_transform_vs, shaderList.drawPhong_fs, } },
+		// Phong with instancing
+		{ demoState->prog_drawPhong_instanced,			"prog:draw-Phong-inst",			{ shaderList.passTangentBasis_transform_instanced_vs, shaderList.drawPhong_fs, } },
+
+		// tangent basis
+		{ demoState->prog_drawTangentBasis,				"prog:draw-tb",					{ shaderList.passTangentBasis_transform_vs, shaderList.drawTangentBasis_gs, shaderList.drawColorAttrib_fs, } },
+		// tangent basis with instancing
+		{ demoState->prog_drawTangentBasis_instanced,	"prog:draw-tb-inst",			{ shaderList.passTangentBasis_transform_instanced_vs, shaderList.drawTangentBasis_gs, shaderList.drawColorAttrib_fs, } },
+
+		// 01-pipeline programs: 
+		// Phong shading with shadow mapping
+		{ demoState->prog_drawPhong_shadow,				"prog:draw-Phong-shadow",		{ shaderList.passTangentBasis_shadowCoord_transform_vs, shaderList.drawPhong_shadow_fs, } },
+		// Phong shading with shadow mapping, instanced
+		{ demoState->prog_drawPhong_shadow_instanced,	"prog:draw-Phong-shadow-inst",	{ shaderList.passTangentBasis_shadowCoord_transform_instanced_vs, shaderList.drawPhong_shadow_fs, } },
+		// bright pass
+		{ demoState->prog_postBright,					"prog:post-bright",				{ shaderList.passTexcoord_transform_vs, shaderList.postBright_fs, } },
+		// blurring
+		{ demoState->prog_postBlur,						"prog:post-blur",				{ shaderList.passTexcoord_transform_vs, shaderList.postBlur_fs, } },
+		// blending
+		{ demoState->prog_postBlend,					"prog:post-blend",				{ shaderList.passTexcoord_transform_vs, shaderList.postBlend_fs, } },
+	};
+	const a3ui32 numPrograms = sizeof(programList) / sizeof(*programList);
+
+	// fallback drawn in place of programs still compiling asynchronously
+	a3_DemoStateShaderProgram *const fallbackDemoProg = a3demo_getFallbackShaderProgram_internal(demoState);
+
+	// program timing and cache keys
+	a3_Timer programTimer[1] = { 0 };
+	a3ui64 programKey;
+	a3ui32 j, k, programIndex;
+	a3boolean async;
 
 
-	// load unique shaders: 
-	//	- load file contents
-	//	- create and compile shader object
-	//	- release file contents
+	if (reloadMask)
+		printf("\n\n---------------- RELOAD SHADERS STARTED  ---------------- \n");
+	else
+		printf("\n\n---------------- LOAD SHADERS STARTED  ---------------- \n");
+
+
+	// open cache and hash unique shaders: 
+	//	- stage type
+	//	- contents of every source file (shared utility files included)
+	// a reload while programs are pending keeps the cache already open; 
+	//	otherwise every existing binary is kept since most are unaffected
+	if (!reloadMask || !demoState->shaderProgramPendingCount)
+	{
+		a3demo_shaderCacheOpen(demoState->shaderCache, A3_DEMO_SHADER_CACHE_DIR);
+		for (i = 0; reloadMask && i < demoState->shaderCache->entryCount; ++i)
+			demoState->shaderCache->entry[i].used = a3true;
+	}
 	for (i = 0; i < numUniqueShaders; ++i)
 	{
 		shaderPtr = shaderListPtr + i;
-		flag = a3shaderCreateFromFileList(shaderPtr->shader,
-			shaderPtr->shaderName, shaderPtr->shaderType,
-			shaderPtr->filePath, shaderPtr->srcCount);
-		if (flag == 0)
-			printf("\n ^^^^ SHADER %u '%s' FAILED TO COMPILE \n\n", i, shaderPtr->shader->handle->name);
+		shaderPtr->sourceKey = a3demo_shaderCacheHash(a3demo_shaderCacheHashSeed, &shaderPtr->shaderType, sizeof(shaderPtr->shaderType));
+		shaderPtr->sourceKey = a3demo_shaderCacheHashFileList(shaderPtr->sourceKey, shaderPtr->filePath, shaderPtr->srcCount);
 	}
+	a3timerStart(demoState->timer_shaderLoad);
 
+	// asynchronous mode: let the driver compile on its own threads
+	if (demoState->shaderAsync && !reloadMask)
+	{
+		flag = a3shaderParallelCompileEnable(0xFFFFFFFF);
+		printf("\n  parallel shader compile %s \n", (flag == 2) ? "enabled (KHR)" : (flag == 1) ? "enabled (ARB)" : "not supported; programs finish in order");
+	}
 
-	// setup programs: 
-	//	- create program object
-	//	- attach shader objects
-
-	// base programs: 
-	// transform-only program
-	currentDemoProg = demoState->prog_transform;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:transform");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passthru_transform_vs->shader);
-	// transform-only program with instancing
-	currentDemoProg = demoState->prog_transform_instanced;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:transform-inst");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passthru_transform_instanced_vs->shader);
-	// uniform color program
-	currentDemoProg = demoState->prog_drawColorUnif;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-col-unif");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passthru_transform_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawColorUnif_fs->shader);
-	// color attrib program
-	currentDemoProg = demoState->prog_drawColorAttrib;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-col-attr");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passColor_transform_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawColorAttrib_fs->shader);
-	// uniform color program with instancing
-	currentDemoProg = demoState->prog_drawColorUnif_instanced;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-col-unif-inst");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passthru_transform_instanced_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawColorUnif_fs->shader);
-	// color attrib program with instancing
-	currentDemoProg = demoState->prog_drawColorAttrib_instanced;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-col-attr-inst");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passColor_transform_instanced_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawColorAttrib_fs->shader);
-
-	// 00-common programs: 
-	// texturing
-	currentDemoProg = demoState->prog_drawTexture;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-tex");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTexcoord_transform_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawTexture_fs->shader);
-	// texturing with instancing
-	currentDemoProg = demoState->prog_drawTexture_instanced;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-tex-inst");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTexcoord_transform_instanced_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawTexture_fs->shader);
-	// Lambert
-	currentDemoProg = demoState->prog_drawLambert;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-Lambert");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTangentBasis_transform_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawLambert_fs->shader);
-	// Lambert with instancing
-	currentDemoProg = demoState->prog_drawLambert_instanced;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-Lambert-inst");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTangentBasis_transform_instanced_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawLambert_fs->shader);
-	// Phong
-	currentDemoProg = demoState->prog_drawPhong;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-Phong");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTangentBasis_transform_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawPhong_fs->shader);
-	// Phong with instancing
-	currentDemoProg = demoState->prog_drawPhong_instanced;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-Phong-inst");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTangentBasis_transform_instanced_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawPhong_fs->shader);
-
-	// tangent basis
-	currentDemoProg = demoState->prog_drawTangentBasis;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-tb");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTangentBasis_transform_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawTangentBasis_gs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawColorAttrib_fs->shader);
-	// tangent basis with instancing
-	currentDemoProg = demoState->prog_drawTangentBasis_instanced;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-tb-inst");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTangentBasis_transform_instanced_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawTangentBasis_gs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawColorAttrib_fs->shader);
-
-	// 01-pipeline programs: 
-	// Phong shading with shadow mapping
-	currentDemoProg = demoState->prog_drawPhong_shadow;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-Phong-shadow");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTangentBasis_shadowCoord_transform_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawPhong_shadow_fs->shader);
-	// Phong shading with shadow mapping, instanced
-	currentDemoProg = demoState->prog_drawPhong_shadow_instanced;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-Phong-shadow-inst");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTangentBasis_shadowCoord_transform_instanced_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawPhong_shadow_fs->shader);
-	// bright pass
-	currentDemoProg = demoState->prog_postBright;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:post-bright");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTexcoord_transform_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.postBright_fs->shader);
-	// blurring
-	currentDemoProg = demoState->prog_postBlur;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:post-blur");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTexcoord_transform_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.postBlur_fs->shader);
-	// blending
-	currentDemoProg = demoState->prog_postBlend;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:post-blend");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTexcoord_transform_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.postBlend_fs->shader);
+	// full load: map every source file to the programs built from it
+	if (!reloadMask)
+	{
+		a3demo_shaderWatchInit(demoState->shaderWatch, 0.25);
+		for (i = 0; i < numPrograms; ++i)
+		{
+			programIndex = (a3ui32)(programList[i].demoProg - demoState->shaderProgram);
+			for (j = 0; j < a3demoArrayLen(programList[i].shader) && (shaderPtr = programList[i].shader[j]); ++j)
+				for (k = 0; k < shaderPtr->srcCount; ++k)
+					a3demo_shaderWatchAddDependency(demoState->shaderWatch, shaderPtr->filePath[k], programIndex);
+		}
+		printf("\n  watching %u shader files for changes (%s) \n", demoState->shaderWatch->fileCount,
+			(a3demo_shaderWatchStart(demoState->shaderWatch) > 0) ? "notify" : "polling");
+	}
 
 
 	// activate a primitive for validation
@@ -621,13 +874,101 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 	// good idea to activate the drawable with the most attributes
 	a3vertexDrawableActivate(demoState->draw_axes);
 
-	// link and validate all programs
-	for (i = 0; i < demoStateMaxCount_shaderProgram; ++i)
+	// setup programs: 
+	//	- create program object
+	//	- try to load binary from cache
+	//	- on miss, compile unique shaders not yet compiled, attach, link 
+	//		and store binary in cache
+	//	- in async mode, compile and link are only issued here; the program 
+	//		is parked as pending and finished in a3demo_loadShadersPoll
+	//	- reloaded programs are always parked so the live program keeps 
+	//		drawing until the new one links successfully
+	//	- validate
+	for (i = 0; i < numPrograms; ++i)
 	{
-		currentDemoProg = demoState->shaderProgram + i;
-		flag = a3shaderProgramLink(currentDemoProg->program);
-		if (flag == 0)
-			printf("\n ^^^^ PROGRAM %u '%s' FAILED TO LINK \n\n", i, currentDemoProg->program->handle->name);
+		currentDemoProg = programList[i].demoProg;
+		programIndex = (a3ui32)(currentDemoProg - demoState->shaderProgram);
+		if (reloadMask)
+		{
+			if (!(reloadMask & (1ull << programIndex)))
+				continue;
+
+			// build directly into pending slot, replacing an unfinished build
+			if (demoState->shaderProgramPending[programIndex].program->handle->handle)
+			{
+				a3shaderProgramRelease(demoState->shaderProgramPending[programIndex].program);
+				--demoState->shaderProgramPendingCount;
+			}
+			currentDemoProg = demoState->shaderProgramPending + programIndex;
+			memset(currentDemoProg, 0, sizeof(*currentDemoProg));
+		}
+		async = (demoState->shaderAsync && currentDemoProg != fallbackDemoProg) || reloadMask;
+		a3timerStart(programTimer);
+		a3shaderProgramCreate(currentDemoProg->program, programList[i].programName);
+
+		// program key combines all of its shaders' keys
+		for (j = 0, programKey = a3demo_shaderCacheHashSeed;
+			j < a3demoArrayLen(programList[i].shader) && programList[i].shader[j]; ++j)
+			programKey = a3demo_shaderCacheHash(programKey, &programList[i].shader[j]->sourceKey, sizeof(programKey));
+		programKey = a3demo_shaderCacheProgramKey(demoState->shaderCache, programList[i].programName, programKey);
+
+		flag = a3demo_shaderCacheLoadProgram(demoState->shaderCache, currentDemoProg->program, programKey);
+		if (flag <= 0)
+		{
+			for (j = 0; j < a3demoArrayLen(programList[i].shader) && (shaderPtr = programList[i].shader[j]); ++j)
+			{
+				// load unique shader on first use: 
+				//	- load file contents
+				//	- create and compile shader object
+				//	- release file contents
+				if (!shaderPtr->shader->compiled)
+				{
+					flag = async
+						? a3shaderCreateFromFileListAsync(shaderPtr->shader,
+							shaderPtr->shaderName, shaderPtr->shaderType,
+							shaderPtr->filePath, shaderPtr->srcCount)
+						: a3shaderCreateFromFileList(shaderPtr->shader,
+							shaderPtr->shaderName, shaderPtr->shaderType,
+							shaderPtr->filePath, shaderPtr->srcCount);
+					if (flag == 0)
+						printf("\n ^^^^ SHADER %u '%s' FAILED TO COMPILE \n\n", (a3ui32)(shaderPtr - shaderListPtr), shaderPtr->shaderName);
+				}
+				a3shaderProgramAttachShader(currentDemoProg->program, shaderPtr->shader);
+			}
+
+			if (async)
+			{
+				// issue link and park program until it is ready
+				a3shaderProgramLinkAsync(currentDemoProg->program);
+				demoState->shaderProgramPending[programIndex] = *currentDemoProg;
+				demoState->shaderProgramPendingKey[programIndex] = programKey;
+				demoState->shaderProgramPendingTimer[programIndex] = *programTimer;
+				++demoState->shaderProgramPendingCount;
+				if (!reloadMask)
+					memset(currentDemoProg, 0, sizeof(*currentDemoProg));
+				continue;
+			}
+
+			flag = a3shaderProgramLink(currentDemoProg->program);
+			if (flag == 0)
+				printf("\n ^^^^ PROGRAM %u '%s' FAILED TO LINK \n\n", i, currentDemoProg->program->handle->name);
+			else
+				a3demo_shaderCacheStoreProgram(demoState->shaderCache, currentDemoProg->program, programKey);
+			a3timerStop(programTimer);
+			a3demo_shaderCacheRecordTime(demoState->shaderCache, currentDemoProg->program, a3false, programTimer->currentTick);
+		}
+		else
+		{
+			a3timerStop(programTimer);
+			a3demo_shaderCacheRecordTime(demoState->shaderCache, currentDemoProg->program, a3true, programTimer->currentTick);
+
+			// reloaded program is ready: swap it in now
+			if (reloadMask)
+			{
+				a3demo_swapShaderProgram_internal(demoState, programIndex);
+				continue;
+			}
+		}
 
 		flag = a3shaderProgramValidate(currentDemoProg->program);
 		if (flag == 0)
@@ -635,93 +976,50 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 	}
 
 	// if linking fails, contingency plan goes here
-	// otherwise, release shaders
+	// otherwise, release shaders that were compiled
+	// (pending links keep their attached shaders alive)
 	for (i = 0; i < numUniqueShaders; ++i)
 	{
 		shaderPtr = shaderListPtr + i;
-		a3shaderRelease(shaderPtr->shader);
+		if (shaderPtr->shader->compiled)
+			a3shaderRelease(shaderPtr->shader);
 	}
 
 
-	// prepare uniforms algorithmically instead of manually for all programs
-	// get uniform and uniform block locations and set default values for all 
-	//	programs that have a uniform that will either never change or is
-	//	consistent for all programs
-	for (i = 0; i < demoStateMaxCount_shaderProgram; ++i)
+	// full load only: live programs and uniform buffers are new
+	if (!reloadMask)
 	{
-		// activate program
-		currentDemoProg = demoState->shaderProgram + i;
-		a3shaderProgramActivate(currentDemoProg->program);
-
-		// common VS
-		a3demo_setUniformDefaultMat4(currentDemoProg, uMVP);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uMV);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uP);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uP_inv);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uPB);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uPB_inv);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uMV_nrm);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uMVPB);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uMVPB_other);
-		a3demo_setUniformDefaultMat4(currentDemoProg, uAtlas);
-
-		// common texture
-		a3demo_setUniformDefaultInteger(currentDemoProg, uTex_dm, defaultTexUnits + 0);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uTex_sm, defaultTexUnits + 1);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uTex_nm, defaultTexUnits + 2);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uTex_hm, defaultTexUnits + 3);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uTex_ramp_dm, defaultTexUnits + 4);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uTex_ramp_sm, defaultTexUnits + 5);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uTex_shadow, defaultTexUnits + 6);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uTex_project, defaultTexUnits + 7);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uImage00, defaultTexUnits + 0);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uImage01, defaultTexUnits + 1);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uImage02, defaultTexUnits + 2);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uImage03, defaultTexUnits + 3);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uImage04, defaultTexUnits + 4);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uImage05, defaultTexUnits + 5);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uImage06, defaultTexUnits + 6);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uImage07, defaultTexUnits + 7);
-
-		// common general
-		a3demo_setUniformDefaultInteger(currentDemoProg, uIndex, defaultInt);
-		a3demo_setUniformDefaultInteger(currentDemoProg, uCount, defaultInt);
-		a3demo_setUniformDefaultDouble(currentDemoProg, uAxis, defaultDouble);
-		a3demo_setUniformDefaultDouble(currentDemoProg, uSize, defaultDouble);
-		a3demo_setUniformDefaultDouble(currentDemoProg, uFlag, defaultDouble);
-		a3demo_setUniformDefaultDouble(currentDemoProg, uTime, defaultDouble);
-		a3demo_setUniformDefaultVec4(currentDemoProg, uColor0, a3vec4_one.v);
-		a3demo_setUniformDefaultVec4(currentDemoProg, uColor, a3vec4_one.v);
-
-		// transformation uniform blocks
-		a3demo_setUniformDefaultBlock(currentDemoProg, ubTransformStack, demoProg_blockTransformStack);
-		a3demo_setUniformDefaultBlock(currentDemoProg, ubTransformBlend, demoProg_blockTransformBlend);
-		a3demo_setUniformDefaultBlock(currentDemoProg, ubTransformMVP, demoProg_blockTransformStack);
-		a3demo_setUniformDefaultBlock(currentDemoProg, ubTransformMVPB, demoProg_blockTransformBlend);
-
-		// lighting and shading uniform blocks
-		a3demo_setUniformDefaultBlock(currentDemoProg, ubMaterial, demoProg_blockMaterial);
-		a3demo_setUniformDefaultBlock(currentDemoProg, ubLight, demoProg_blockLight);
-	}
+		// prepare uniforms for all programs that are ready
+		for (i = 0; i < demoStateMaxCount_shaderProgram; ++i)
+		{
+			currentDemoProg = demoState->shaderProgram + i;
+			if (currentDemoProg->program->handle->handle)
+				a3demo_initShaderProgramUniforms_internal(demoState, currentDemoProg);
+		}
 
+		// programs still compiling draw with the fallback until they are swapped in
+		a3demo_initShaderProgramStandIns_internal(demoState, 0);
 
-	// additional pre-configuration for some programs whose uniforms will not change
-	// e.g. post-processing effects must transform unit FSQ to true FSQ
-	for (currentDemoProg = demoState->prog_postBright;
-		currentDemoProg <= demoState->prog_postBlend;
-		++currentDemoProg)
-	{
-		a3shaderProgramActivate(currentDemoProg->program);
-		a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProg->uMVP, 1, fsq.mm);
+		// allocate uniform buffers
+		a3bufferCreate(demoState->ubo_light, "ubo:light", a3buffer_uniform, a3index_countMaxShort, 0);
+		a3bufferCreate(demoState->ubo_transform, "ubo:transform", a3buffer_uniform, a3index_countMaxShort, 0);
 	}
 
-
-	// allocate uniform buffers
-	a3bufferCreate(demoState->ubo_light, "ubo:light", a3buffer_uniform, a3index_countMaxShort, 0);
-	a3bufferCreate(demoState->ubo_transform, "ubo:transform", a3buffer_uniform, a3index_countMaxShort, 0);
+	// nothing pending: done with cache
+	if (!demoState->shaderProgramPendingCount)
+	{
+		a3timerStop(demoState->timer_shaderLoad);
+		a3demo_shaderCacheClose(demoState->shaderCache);
+		printf("\n  all programs ready after %.3lf ms \n", demoState->timer_shaderLoad->currentTick * 1000.0);
+	}
+	else
+		printf("\n  %u programs compiling asynchronously \n", demoState->shaderProgramPendingCount);
 
 
-	printf("\n\n---------------- LOAD SHADERS FINISHED ---------------- \n");
+	if (reloadMask)
+		printf("\n\n---------------- RELOAD SHADERS FINISHED ---------------- \n");
+	else
+		printf("\n\n---------------- LOAD SHADERS FINISHED ---------------- \n");
 
 	//done
 	a3shaderProgramDeactivate();
@@ -729,11 +1027,85 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 }
 
 
+// utility to load shaders
+void a3demo_loadShaders(a3_DemoState* demoState)
+{
+	a3demo_loadShaders_internal(demoState, 0);
+}
+
+
+// utility to rebuild only some programs after their sources changed
+//	programMask: bit per index into shader program list
+//	each program is swapped in once it links; on failure the old one stays
+void a3demo_reloadShaders(a3_DemoState* demoState, a3ui64 const programMask)
+{
+	if (programMask)
+		a3demo_loadShaders_internal(demoState, programMask);
+}
+
+
+// utility to finish loading programs compiled asynchronously
+//	each program is swapped in over its stand-in only if its link succeeded
+void a3demo_loadShadersPoll(a3_DemoState* demoState)
+{
+	a3_DemoStateShaderProgram* pendingDemoProg;
+	a3i32 flag;
+	a3ui32 i;
+
+	if (demoState->shaderProgramPendingCount)
+	{
+		a3vertexDrawableActivate(demoState->draw_axes);
+		a3timerStop(demoState->timer_shaderLoad);
+
+		for (i = 0; i < demoStateMaxCount_shaderProgram; ++i)
+		{
+			pendingDemoProg = demoState->shaderProgramPending + i;
+			if (pendingDemoProg->program->handle->handle)
+			{
+				// still working
+				flag = a3shaderProgramLinkPoll(pendingDemoProg->program);
+				if (flag == 0)
+					continue;
+
+				if (flag > 0)
+				{
+					// release stand-in or old program and take ownership of finished program
+					// time from this program's own submit, not the batch's
+					a3timerStop(demoState->shaderProgramPendingTimer + i);
+					a3demo_shaderCacheStoreProgram(demoState->shaderCache, pendingDemoProg->program, demoState->shaderProgramPendingKey[i]);
+					a3demo_shaderCacheRecordTime(demoState->shaderCache, pendingDemoProg->program, a3false, demoState->shaderProgramPendingTimer[i].currentTick);
+					a3demo_swapShaderProgram_internal(demoState, i);
+				}
+				else
+				{
+					// stand-in or old program stays
+					printf("\n ^^^^ PROGRAM %u '%s' FAILED TO LINK \n\n", i, pendingDemoProg->program->handle->name);
+					a3shaderProgramRelease(pendingDemoProg->program);
+					memset(pendingDemoProg, 0, sizeof(*pendingDemoProg));
+				}
+				--demoState->shaderProgramPendingCount;
+			}
+		}
+
+		// all done
+		if (!demoState->shaderProgramPendingCount)
+		{
+			a3demo_shaderCacheClose(demoState->shaderCache);
+			printf("\n  all programs ready after %.3lf ms \n", demoState->timer_shaderLoad->currentTick * 1000.0);
+		}
+
+		a3shaderProgramDeactivate();
+		a3vertexDrawableDeactivate();
+	}
+}
+
+
 // utility to load textures
+//	textures are cooked, decoded and mapped by workers, then uploaded a few 
+//	per frame in a3demo_idle; each appears as soon as it is uploaded
 void a3demo_loadTextures(a3_DemoState* demoState)
 {	
 	// indexing
-	a3_Texture* tex;
 	a3ui32 i;
 
 	// structure for texture loading
@@ -741,6 +1113,9 @@ void a3demo_loadTextures(a3_DemoState* demoState)
 		a3_Texture* texture;
 		a3byte textureName[32];
 		const a3byte* filePath;
+		a3_TextureFilterOption filter;
+		a3_TextureRepeatOption repeatH, repeatV;
+		a3_DemoTextureCompression compression;
 	} a3_DemoStateTexture;
 
 	// texture objects
@@ -769,66 +1144,167 @@ void a3demo_loadTextures(a3_DemoState* demoState)
 		};
 	} textureList = {
 		{
-			{ demoState->tex_earth_dm,		"tex:earth-dm",		A3_DEMO_TEX"earth/2k/earth_dm_2k.png" },
-			{ demoState->tex_earth_sm,		"tex:earth-sm",		A3_DEMO_TEX"earth/2k/earth_sm_2k.png" },
-			{ demoState->tex_earth_nm,		"tex:earth-nm",		A3_DEMO_TEX"earth/2k/earth_nm_2k.png" },
-			{ demoState->tex_earth_hm,		"tex:earth-hm",		A3_DEMO_TEX"earth/2k/earth_hm_2k.png" },
-			{ demoState->tex_mars_dm,		"tex:mars-dm",		A3_DEMO_TEX"mars/1k/mars_1k_dm.png" },
-			{ demoState->tex_mars_sm,		"tex:mars-sm",		A3_DEMO_TEX"mars/1k/mars_1k_sm.png" },
-			{ demoState->tex_mars_nm,		"tex:mars-nm",		A3_DEMO_TEX"mars/1k/mars_1k_nm.png" },
-			{ demoState->tex_mars_hm,		"tex:mars-hm",		A3_DEMO_TEX"mars/1k/mars_1k_hm.png" },
-			{ demoState->tex_stone_dm,		"tex:stone-dm",		A3_DEMO_TEX"stone/stone_dm.png" },
-			{ demoState->tex_stone_nm,		"tex:stone-nm",		A3_DEMO_TEX"stone/stone_nm.png" },
-			{ demoState->tex_stone_hm,		"tex:stone-hm",		A3_DEMO_TEX"stone/stone_hm.png" },
-			{ demoState->tex_sun_dm,		"tex:sun-dm",		A3_DEMO_TEX"sun/1k/sun_dm.png" },
-
-			{ demoState->tex_skybox_clouds,	"tex:sky-clouds",	A3_DEMO_TEX"bg/sky_clouds.png" },
-			{ demoState->tex_skybox_water,	"tex:sky-water",	A3_DEMO_TEX"bg/sky_water.png" },
-			{ demoState->tex_ramp_dm,		"tex:ramp-dm",		A3_DEMO_TEX"sprite/celRamp_dm.png" },
-			{ demoState->tex_ramp_sm,		"tex:ramp-sm",		A3_DEMO_TEX"sprite/celRamp_sm.png" },
-			{ demoState->tex_testsprite,	"tex:testsprite",	A3_DEMO_TEX"sprite/spriteTest8x8.png" },
-			{ demoState->tex_checker,		"tex:checker",		A3_DEMO_TEX"sprite/checker.png" },
+			// materials: blend pixels and mip levels, repeat horizontal, clamp vertical; 
+			//	normal maps keep red and green only (blue is rebuilt when sampled)
+			{ demoState->tex_earth_dm,		"tex:earth-dm",		A3_DEMO_TEX"earth/2k/earth_dm_2k.png",		a3tex_filterLinearMipmap,	a3tex_repeatNormal,	a3tex_repeatClamp,	demoTextureCompression_color },
+			{ demoState->tex_earth_sm,		"tex:earth-sm",		A3_DEMO_TEX"earth/2k/earth_sm_2k.png",		a3tex_filterLinearMipmap,	a3tex_repeatNormal,	a3tex_repeatClamp,	demoTextureCompression_color },
+			{ demoState->tex_earth_nm,		"tex:earth-nm",		A3_DEMO_TEX"earth/2k/earth_nm_2k.png",		a3tex_filterLinearMipmap,	a3tex_repeatNormal,	a3tex_repeatClamp,	demoTextureCompression_normal },
+			{ demoState->tex_earth_hm,		"tex:earth-hm",		A3_DEMO_TEX"earth/2k/earth_hm_2k.png",		a3tex_filterLinearMipmap,	a3tex_repeatNormal,	a3tex_repeatClamp,	demoTextureCompression_single },
+			{ demoState->tex_mars_dm,		"tex:mars-dm",		A3_DEMO_TEX"mars/1k/mars_1k_dm.png",		a3tex_filterLinearMipmap,	a3tex_repeatNormal,	a3tex_repeatClamp,	demoTextureCompression_color },
+			{ demoState->tex_mars_sm,		"tex:mars-sm",		A3_DEMO_TEX"mars/1k/mars_1k_sm.png",		a3tex_filterLinearMipmap,	a3tex_repeatNormal,	a3tex_repeatClamp,	demoTextureCompression_color },
+			{ demoState->tex_mars_nm,		"tex:mars-nm",		A3_DEMO_TEX"mars/1k/mars_1k_nm.png",		a3tex_filterLinearMipmap,	a3tex_repeatNormal,	a3tex_repeatClamp,	demoTextureCompression_normal },
+			{ demoState->tex_mars_hm,		"tex:mars-hm",		A3_DEMO_TEX"mars/1k/mars_1k_hm.png",		a3tex_filterLinearMipmap,	a3tex_repeatNormal,	a3tex_repeatClamp,	demoTextureCompression_single },
+			{ demoState->tex_stone_dm,		"tex:stone-dm",		A3_DEMO_TEX"stone/stone_dm.png",			a3tex_filterLinearMipmap,	a3tex_repeatNormal,	a3tex_repeatClamp,	demoTextureCompression_color },
+			{ demoState->tex_stone_nm,		"tex:stone-nm",		A3_DEMO_TEX"stone/stone_nm.png",			a3tex_filterLinearMipmap,	a3tex_repeatNormal,	a3tex_repeatClamp,	demoTextureCompression_normal },
+			{ demoState->tex_stone_hm,		"tex:stone-hm",		A3_DEMO_TEX"stone/stone_hm.png",			a3tex_filterLinearMipmap,	a3tex_repeatNormal,	a3tex_repeatClamp,	demoTextureCompression_single },
+			{ demoState->tex_sun_dm,		"tex:sun-dm",		A3_DEMO_TEX"sun/1k/sun_dm.png",				a3tex_filterLinearMipmap,	a3tex_repeatNormal,	a3tex_repeatClamp,	demoTextureCompression_color },
+
+			// skyboxes: same as materials
+			{ demoState->tex_skybox_clouds,	"tex:sky-clouds",	A3_DEMO_TEX"bg/sky_clouds.png",				a3tex_filterLinearMipmap,	a3tex_repeatNormal,	a3tex_repeatClamp,	demoTextureCompression_color },
+			{ demoState->tex_skybox_water,	"tex:sky-water",	A3_DEMO_TEX"bg/sky_water.png",				a3tex_filterLinearMipmap,	a3tex_repeatNormal,	a3tex_repeatClamp,	demoTextureCompression_color },
+			// ramps: lookup tables, so no mips or compression; clamp both axes
+			{ demoState->tex_ramp_dm,		"tex:ramp-dm",		A3_DEMO_TEX"sprite/celRamp_dm.png",			a3tex_filterLinear,			a3tex_repeatClamp,	a3tex_repeatClamp,	demoTextureCompression_none },
+			{ demoState->tex_ramp_sm,		"tex:ramp-sm",		A3_DEMO_TEX"sprite/celRamp_sm.png",			a3tex_filterLinear,			a3tex_repeatClamp,	a3tex_repeatClamp,	demoTextureCompression_none },
+			// sprites: default settings, uncompressed to keep exact pixels
+			{ demoState->tex_testsprite,	"tex:testsprite",	A3_DEMO_TEX"sprite/spriteTest8x8.png",		a3tex_filterNearest,		a3tex_repeatNormal,	a3tex_repeatNormal,	demoTextureCompression_none },
+			{ demoState->tex_checker,		"tex:checker",		A3_DEMO_TEX"sprite/checker.png",			a3tex_filterNearest,		a3tex_repeatNormal,	a3tex_repeatNormal,	demoTextureCompression_none },
 		}
 	};
 	const a3ui32 numTextures = sizeof(textureList) / sizeof(a3_DemoStateTexture);
 	a3_DemoStateTexture* const textureListPtr = (a3_DemoStateTexture*)(&textureList), * texturePtr;
 
-	// load all textures
+	// queue all textures, 16 MB uploaded per frame at most
+	a3demo_textureLoaderInit(demoState->textureLoader, A3_DEMO_TEXTURE_CACHE_DIR, 16 << 20);
 	for (i = 0; i < numTextures; ++i)
 	{
 		texturePtr = textureListPtr + i;
-		a3textureCreateFromFile(texturePtr->texture, texturePtr->textureName, texturePtr->filePath);
-		a3textureActivate(texturePtr->texture, a3tex_unit00);
-		a3textureDefaultSettings();
+		a3demo_textureLoaderRequest(demoState->textureLoader, texturePtr->texture, texturePtr->textureName, texturePtr->filePath,
+			texturePtr->filter, texturePtr->repeatH, texturePtr->repeatV, texturePtr->compression);
+	}
+
+	// one worker per processor
+	a3demo_textureLoaderStart(demoState->textureLoader, 0);
+}
+
+
+// utility to report texture compression speed and quality
+void a3demo_benchmarkTextures(a3_DemoState* demoState)
+{
+	a3demo_textureCompressBenchmark(A3_DEMO_TEX"mars/1k/mars_1k_dm.png", demoState->workerPool);
+	a3demo_textureCompressBenchmark(A3_DEMO_TEX"mars/1k/mars_1k_nm.png", demoState->workerPool);
+}
+
+
+// time generating a set of procedural shapes one at a time, in batches 
+//	split into more tasks on the worker pool each pass, and as copies from 
+//	a filled cache
+void a3demo_benchmarkProceduralGeometry_internal(a3_ProceduralGeometryDescriptor const* shape, a3ui32 const count, a3ui32 taskCountMax, a3_DemoWorkerPool* pool)
+{
+	a3_ProceduralGeometryCache cache[1] = { 0 };
+	a3_GeometryData* const geom = (a3_GeometryData*)calloc(count, sizeof(a3_GeometryData));
+	a3_GeometryDispatcher dispatcher[1] = { { a3demo_workerPoolDispatch, pool, 1 } };
+	a3_Timer timer[1] = { 0 };
+	a3f64 referenceTime;
+	a3ui32 vertexCount, i;
+
+	if (!geom)
+		return;
+
+	a3timerStart(timer);
+	for (i = 0; i < count; ++i)
+		a3proceduralGenerateGeometryData(geom + i, shape + i, 0);
+	a3timerStop(timer);
+	referenceTime = timer->currentTick;
+	for (i = vertexCount = 0; i < count; ++i)
+	{
+		vertexCount += geom[i].numVertices;
+		a3geometryReleaseData(geom + i);
 	}
 
-	// change settings on a per-texture or per-type basis
-	// materials
-	tex = demoState->tex_earth_dm;
-	for (i = 0; i < 16; ++i, ++tex)
+	printf("\n\n  procedural geometry: %u shapes (%u vertices)", count, vertexCount);
+	printf("\n  one at a time:      %8.3lf ms", referenceTime * 1000.0);
+	for (dispatcher->taskCount = 1; dispatcher->taskCount <= taskCountMax; dispatcher->taskCount <<= 1)
 	{
-		a3textureActivate(tex, a3tex_unit00);
-		a3textureChangeFilterMode(a3tex_filterLinear); // linear pixel blending
-		a3textureChangeRepeatMode(a3tex_repeatNormal, a3tex_repeatClamp); // repeat horizontal, clamp vertical
+		a3timerStart(timer);
+		a3proceduralGenerateGeometryDataBatch(geom, shape, count, dispatcher);
+		a3timerStop(timer);
+		printf("\n  batched, %u task%s:   %8.3lf ms (%.2lfx)", dispatcher->taskCount, dispatcher->taskCount > 1 ? "s" : " ",
+			timer->currentTick * 1000.0, timer->currentTick > 0.0 ? referenceTime / timer->currentTick : 0.0);
+		for (i = 0; i < count; ++i)
+			a3geometryReleaseData(geom + i);
 	}
-	// skyboxes
-	tex = demoState->tex_skybox_clouds;
-	for (i = 0; i < 2; ++i, ++tex)
+
+	// first pass fills the cache, second only copies
+	dispatcher->taskCount = taskCountMax;
+	a3proceduralCacheGenerate(cache, geom, shape, count, dispatcher);
+	for (i = 0; i < count; ++i)
+		a3geometryReleaseData(geom + i);
+	a3timerStart(timer);
+	a3proceduralCacheGenerate(cache, geom, shape, count, dispatcher);
+	a3timerStop(timer);
+	printf("\n  cached copies:      %8.3lf ms (%.2lfx; %u entries, %u hits)", timer->currentTick * 1000.0,
+		timer->currentTick > 0.0 ? referenceTime / timer->currentTick : 0.0, cache->count, cache->hits);
+	printf("\n");
+	for (i = 0; i < count; ++i)
+		a3geometryReleaseData(geom + i);
+
+	a3proceduralCacheRelease(cache);
+	free(geom);
+}
+
+
+// utility to report vertex cache efficiency of geometry before and after 
+//	optimizing, vertex size and precision after quantizing, and tangent 
+//	basis speed: the loaded teapot and dense procedural shapes standing in 
+//	for large imported meshes; then procedural generation speed
+void a3demo_benchmarkGeometry(a3_DemoState* demoState)
+{
+	static const a3mat4 downscale20x_y2z_x2y = {
+		 0.00f, +0.05f,  0.00f,  0.00f,
+		 0.00f,  0.00f, +0.05f,  0.00f,
+		+0.05f,  0.00f,  0.00f,  0.00f,
+		 0.00f,  0.00f,  0.00f, +1.00f,
+	};
+	a3_ProceduralGeometryDescriptor shape[8] = { a3geomShape_none };
+	a3_GeometryData geom[1] = { 0 };
+	a3ui32 cacheSize;
+
+	if (a3modelLoadOBJ(geom, A3_DEMO_OBJ"teapot/teapot.obj", a3model_calculateVertexTangents, downscale20x_y2z_x2y.mm) > 0)
 	{
-		a3textureActivate(tex, a3tex_unit00);
-		a3textureChangeFilterMode(a3tex_filterLinear); // linear pixel blending
+		for (cacheSize = 8; cacheSize <= 32; cacheSize <<= 1)
+			a3demo_geometryOptimizeReport(geom, "teapot", cacheSize);
+		a3demo_geometryQuantizeReport(geom, "teapot");
+		a3demo_geometryTangentReport(geom, "teapot", 8, demoState->workerPool);
+		a3geometryReleaseData(geom);
 	}
-	// ramps
-	tex = demoState->tex_ramp_dm;
-	for (i = 0; i < 2; ++i, ++tex)
+
+	a3proceduralCreateDescriptorSphere(shape, a3geomFlag_tangents, a3geomAxis_default, 1.0f, 255, 192);
+	if (a3proceduralCacheGenerate(demoState->geometryCache, geom, shape, 1, 0) > 0)
 	{
-		a3textureActivate(tex, a3tex_unit00);
-		a3textureChangeRepeatMode(a3tex_repeatClamp, a3tex_repeatClamp); // clamp both axes
+		a3demo_geometryOptimizeReport(geom, "sphere 255x192", 0);
+		a3demo_geometryQuantizeReport(geom, "sphere 255x192");
+		a3demo_geometryTangentReport(geom, "sphere 255x192", 8, demoState->workerPool);
+		a3geometryReleaseData(geom);
 	}
 
+	a3proceduralCreateDescriptorTorus(shape, a3geomFlag_tangents, a3geomAxis_x, 1.0f, 0.25f, 255, 192);
+	if (a3proceduralCacheGenerate(demoState->geometryCache, geom, shape, 1, 0) > 0)
+	{
+		a3demo_geometryOptimizeReport(geom, "torus 255x192", 0);
+		a3demo_geometryQuantizeReport(geom, "torus 255x192");
+		a3demo_geometryTangentReport(geom, "torus 255x192", 8, demoState->workerPool);
+		a3geometryReleaseData(geom);
+	}
 
-	// done
-	a3textureDeactivate(a3tex_unit00);
+	// a scene's worth of dense shapes, some repeated
+	a3proceduralCreateDescriptorSphere(shape + 1, a3geomFlag_tangents, a3geomAxis_default, 1.0f, 255, 192);
+	a3proceduralCreateDescriptorCapsule(shape + 2, a3geomFlag_tangents, a3geomAxis_x, 1.0f, 1.0f, 128, 64, 16);
+	a3proceduralCreateDescriptorCylinder(shape + 3, a3geomFlag_tangents, a3geomAxis_x, 1.0f, 1.0f, 128, 16, 16);
+	a3proceduralCreateDescriptorCone(shape + 4, a3geomFlag_tangents, a3geomAxis_x, 1.0f, 1.0f, 128, 16, 16);
+	a3proceduralCreateDescriptorSphere(shape + 5, a3geomFlag_texcoords_normals, a3geomAxis_default, 1.0f, 128, 96);
+	shape[6] = shape[0];
+	shape[7] = shape[1];
+	a3demo_benchmarkProceduralGeometry_internal(shape, a3demoArrayLen(shape), 8, demoState->workerPool);
 }
 
 
@@ -925,6 +1401,8 @@ void a3demo_loadValidate(a3_DemoState* demoState)
 		* const endVAO = currentVAO + demoStateMaxCount_vertexArray;
 	a3_DemoStateShaderProgram* currentProg = demoState->shaderProgram,
 		* const endProg = currentProg + demoStateMaxCount_shaderProgram;
+	a3_DemoStateShaderProgram* currentPending = demoState->shaderProgramPending;
+	a3_DemoStateShaderProgram const* fallbackProg = a3demo_getFallbackShaderProgram_internal(demoState);
 	a3_UniformBuffer* currentUBO = demoState->uniformBuffer,
 		* const endUBO = currentUBO + demoStateMaxCount_uniformBuffer;
 	a3_Texture* currentTex = demoState->texture,
@@ -940,11 +1418,20 @@ void a3demo_loadValidate(a3_DemoState* demoState)
 	while (currentVAO < endVAO)
 		a3vertexArrayHandleUpdateReleaseCallback(currentVAO++);
 	while (currentProg < endProg)
-		a3shaderProgramHandleUpdateReleaseCallback((currentProg++)->program);
+	{
+		// stand-ins for pending programs must never release the fallback
+		if (currentPending->program->handle->handle)
+			a3shaderProgramHandleUpdateReleaseCallback(currentPending->program);
+		if (currentProg == fallbackProg || currentProg->program->handle->handle != fallbackProg->program->handle->handle)
+			a3shaderProgramHandleUpdateReleaseCallback(currentProg->program);
+		++currentProg;
+		++currentPending;
+	}
 	while (currentUBO < endUBO)
 		a3bufferHandleUpdateReleaseCallback(currentUBO++);
 	while (currentTex < endTex)
 		a3textureHandleUpdateReleaseCallback(currentTex++);
+	a3bufferHandleUpdateReleaseCallback(demoState->textureLoader->pixelBuffer);
 	// ****TO-DO:
 	//	-> uncomment framebuffer update
 /*	while (currentFBO < endFBO)
@@ -974,6 +1461,13 @@ void a3demo_loadValidate(a3_DemoState* demoState)
 	currentVAO = demoState->vao_tangentbasis_texcoord;
 	currentVAO->vertexBuffer = currentBuff;
 	a3_refreshDrawable_internal(demoState->draw_teapot, currentVAO, currentBuff);
+	a3_refreshDrawable_internal(demoState->draw_teapot_lod + 0, currentVAO, currentBuff);
+	a3_refreshDrawable_internal(demoState->draw_teapot_lod + 1, currentVAO, currentBuff);
+	a3_refreshDrawable_internal(demoState->draw_teapot_lod + 2, currentVAO, currentBuff);
+
+	currentVAO = demoState->vao_tangentbasis_texcoord_quantized;
+	currentVAO->vertexBuffer = currentBuff;
+	a3_refreshDrawable_internal(demoState->draw_teapot_quantized, currentVAO, currentBuff);
 
 	a3demo_initDummyDrawable_internal(demoState);
 }
@@ -49,6 +49,10 @@ void a3demo_unloadGeometry(a3_DemoState* demoState)
 		* const endVAO = currentVAO + demoStateMaxCount_vertexArray;
 	a3_VertexDrawable* currentDraw = demoState->drawable,
 		* const endDraw = currentDraw + demoStateMaxCount_drawable;
+	a3_DemoGeometryMeshlets* currentMeshlets = demoState->meshlets,
+		* const endMeshlets = currentMeshlets + demoStateMaxCount_drawable;
+	a3_DemoOccluderMesh* currentOccluder = demoState->occluders,
+		* const endOccluder = currentOccluder + demoStateMaxCount_drawable;
 
 	while (currentBuff < endBuff)
 		a3bufferRelease(currentBuff++);
@@ -56,6 +60,11 @@ void a3demo_unloadGeometry(a3_DemoState* demoState)
 		a3vertexArrayReleaseDescriptor(currentVAO++);
 	while (currentDraw < endDraw)
 		a3vertexDrawableRelease(currentDraw++);
+	while (currentMeshlets < endMeshlets)
+		a3demo_geometryReleaseMeshlets(currentMeshlets++);
+	while (currentOccluder < endOccluder)
+		a3demo_occlusionReleaseOccluder(currentOccluder++);
+	a3proceduralCacheRelease(demoState->geometryCache);
 }
 
 // utility to unload shaders
@@ -63,13 +72,27 @@ void a3demo_unloadShaders(a3_DemoState* demoState)
 {
 	a3_DemoStateShaderProgram* currentProg = demoState->shaderProgram,
 		* const endProg = currentProg + demoStateMaxCount_shaderProgram;
+	a3_DemoStateShaderProgram* currentPending = demoState->shaderProgramPending,
+		* const endPending = currentPending + demoStateMaxCount_shaderProgram;
 	a3_UniformBuffer* currentUBO = demoState->uniformBuffer,
 		* const endUBO = currentUBO + demoStateMaxCount_uniformBuffer;
 
 	while (currentProg < endProg)
 		a3shaderProgramRelease((currentProg++)->program);
+	while (currentPending < endPending)
+		a3shaderProgramRelease((currentPending++)->program);
 	while (currentUBO < endUBO)
 		a3bufferRelease(currentUBO++);
+
+	// programs still compiling were abandoned
+	if (demoState->shaderProgramPendingCount)
+	{
+		demoState->shaderProgramPendingCount = 0;
+		a3demo_shaderCacheClose(demoState->shaderCache);
+	}
+
+	// dependency map is rebuilt by the next full load
+	a3demo_shaderWatchRelease(demoState->shaderWatch);
 }
 
 
@@ -79,6 +102,9 @@ void a3demo_unloadTextures(a3_DemoState* demoState)
 	a3_Texture* currentTex = demoState->texture,
 		* const endTex = currentTex + demoStateMaxCount_texture;
 
+	// stop loading textures that are not ready yet
+	a3demo_textureLoaderRelease(demoState->textureLoader);
+
 	while (currentTex < endTex)
 		a3textureRelease(currentTex++);
 }
@@ -111,6 +111,7 @@ a3ret a3proceduralInternalGenerateCapsule(a3_GeometryData *geomData, const a3_Pr
 	a3f32 *attribItr = positions, *attribItr2 = positions, *attribItr3 = positions, *pPtr = positions, *tcPtr = texcoords;
 	a3ubyte *indexItr = indices;
 	a3ui32 i = 0, j = 0, k = 0;
+	a3f32 ringData[ringMax * 2], *const ring = a3proceduralInternalCreateRing(ringData, 0.0f, slices);
 	a3boolean valid = 0;
 
 
@@ -137,19 +138,19 @@ a3ret a3proceduralInternalGenerateCapsule(a3_GeometryData *geomData, const a3_Pr
 		for (i = 1, elev = 180.0f - deltaElev; i <= stacksEnd; elev = 180.0f - deltaElev*(a3f32)(++i))
 		{
 			a3trigTaylor_sind_cosd(elev, ringRadius, ringDepth);
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius * *ringRadius, 0.0f, 0.0f, radius * *ringDepth - halfLen, 0.0f, slices, vElems, 1, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius * *ringRadius, 0.0f, 0.0f, radius * *ringDepth - halfLen, slices, vElems, 1, 0);
 		}
 
 		// center: cylinder
 		for (j = 1, lenElev = deltaLen - halfLen; j <= subdivsL; lenElev = deltaLen*(a3f32)(++j) - halfLen)
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius, 0.0f, 0.0f, lenElev, 0.0f, slices, vElems, 1, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius, 0.0f, 0.0f, lenElev, slices, vElems, 1, 0);
 
 		// front half, just continue where back half left off
 		// add half body length to z offset
 		for (j = 1; j < stacksEnd; elev = 180.0f - deltaElev*(a3f32)(++i), ++j)
 		{
 			a3trigTaylor_sind_cosd(elev, ringRadius, ringDepth);
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius * *ringRadius, 0.0f, 0.0f, radius * *ringDepth + halfLen, 0.0f, slices, vElems, 1, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius * *ringRadius, 0.0f, 0.0f, radius * *ringDepth + halfLen, slices, vElems, 1, 0);
 		}
 
 		// cap: create one point at the pole per slice
@@ -372,18 +373,18 @@ a3ret a3proceduralInternalGenerateCapsule(a3_GeometryData *geomData, const a3_Pr
 		for (i = 1, elev = 180.0f - deltaElev; i <= stacksEnd; elev = 180.0f - deltaElev*(a3f32)(++i))
 		{
 			a3trigTaylor_sind_cosd(elev, ringRadius, ringDepth);
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius * *ringRadius, 0.0f, 0.0f, radius * *ringDepth - halfLen, 0.0f, slices, vElems, 0, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius * *ringRadius, 0.0f, 0.0f, radius * *ringDepth - halfLen, slices, vElems, 0, 0);
 		}
 
 		// center
 		for (j = 1, lenElev = deltaLen - halfLen; j <= subdivsL; lenElev = deltaLen*(a3f32)(++j) - halfLen)
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius, 0.0f, 0.0f, lenElev, 0.0f, slices, vElems, 0, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius, 0.0f, 0.0f, lenElev, slices, vElems, 0, 0);
 
 		// front part, where back left off
 		for (j = 1; j < stacksEnd; elev = 180.0f - deltaElev*(a3f32)(++i), ++j)
 		{
 			a3trigTaylor_sind_cosd(elev, ringRadius, ringDepth);
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius * *ringRadius, 0.0f, 0.0f, radius * *ringDepth + halfLen, 0.0f, slices, vElems, 0, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius * *ringRadius, 0.0f, 0.0f, radius * *ringDepth + halfLen, slices, vElems, 0, 0);
 		}
 
 		// add exactly one vertex for each cap
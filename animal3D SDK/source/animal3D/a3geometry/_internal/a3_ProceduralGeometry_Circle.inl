@@ -31,45 +31,70 @@
 // utility to generate circle vertices (this will be super useful later when 
 //	the 3D round objects need a billion circles)
 
-inline a3f32 *a3proceduralInternalCreateCircle(a3f32 *position, const a3f32 radius, const a3f32 xOffset, const a3f32 yOffset, const a3f32 zOffset, const a3f32 angleOffset, const a3ui32 slices, const a3ui32 attribElems, const a3boolean repeatFirst, const a3i32 flipVertical)
+// unit circle for a number of slices: all cosines, then all sines starting
+//	at 'ringMax', each with the first repeated at the end; shapes made of
+//	many circles calculate this once and scale it for every ring
+inline a3f32 *a3proceduralInternalCreateRing(a3f32 *ring, const a3f32 angleOffset, const a3ui32 slices)
 {
-	// fill positions array algorithmically
 	a3f32 theta, deltaTheta = a3real_threesixty / (a3f32)slices;
-	const a3f32 verticalSign = flipVertical ? -1.0f : +1.0f;
 	a3ui32 i;
+	for (i = 0, theta = angleOffset; i < slices; theta = angleOffset + deltaTheta * (a3f32)(++i))
+		a3trigTaylor_sind_cosd(theta, ring + ringMax + i, ring + i);
+	ring[i] = ring[0];
+	ring[ringMax + i] = ring[ringMax];
+	return ring;
+}
 
-	// first
-//	position[0] = xOffset + radius;
-//	position[1] = yOffset;
-//	position[2] = zOffset;
-//	position += attribElems;
+// scale and offset unit circle into vertices; four positions at a time
+//	where available
+inline a3f32 *a3proceduralInternalCreateCircleRing(a3f32 *position, const a3f32 *ring, const a3f32 radius, const a3f32 xOffset, const a3f32 yOffset, const a3f32 zOffset, const a3ui32 slices, const a3ui32 attribElems, const a3boolean repeatFirst, const a3i32 flipVertical)
+{
+	const a3f32 verticalSign = flipVertical ? -1.0f : +1.0f;
+	const a3f32 *const ringSin = ring + ringMax;
+	const a3ui32 count = repeatFirst ? slices + 1 : slices;
+	a3ui32 i = 0;
 
-	// create a circle
-//	for (i = 1, theta = deltaTheta; i < slices; theta = deltaTheta * (a3f32)(++i), position += attribElems)
-	for (i = 0, theta = angleOffset; i < slices; theta = angleOffset + deltaTheta * (a3f32)(++i), position += attribElems)
+#ifdef A3_PROCEDURAL_SSE
+	if (attribElems == vElems)
 	{
-		a3trigTaylor_sind_cosd(theta, position + 1, position);
-		position[0] = xOffset + radius*position[0];
-		position[1] = yOffset + radius*position[1] * verticalSign;
-		position[2] = zOffset;
+		// interleave x, y and z of four vertices into three registers
+		const __m128 r = _mm_set1_ps(radius), sign = _mm_set1_ps(verticalSign);
+		const __m128 x0 = _mm_set1_ps(xOffset), y0 = _mm_set1_ps(yOffset), z = _mm_set1_ps(zOffset);
+		__m128 x, y, xy01, xy23;
+		for (; i + 4 <= count; i += 4, position += vElems * 4)
+		{
+			x = _mm_add_ps(x0, _mm_mul_ps(r, _mm_loadu_ps(ring + i)));
+			y = _mm_add_ps(y0, _mm_mul_ps(_mm_mul_ps(r, _mm_loadu_ps(ringSin + i)), sign));
+			xy01 = _mm_unpacklo_ps(x, y);
+			xy23 = _mm_unpackhi_ps(x, y);
+			_mm_storeu_ps(position + 0, _mm_shuffle_ps(xy01, _mm_shuffle_ps(z, xy01, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 1, 1, 0)));
+			_mm_storeu_ps(position + 4, _mm_shuffle_ps(_mm_shuffle_ps(xy01, z, _MM_SHUFFLE(0, 0, 3, 3)), xy23, _MM_SHUFFLE(1, 0, 2, 0)));
+			_mm_storeu_ps(position + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, xy23, _MM_SHUFFLE(3, 2, 0, 0)), _mm_shuffle_ps(xy23, z, _MM_SHUFFLE(0, 0, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+		}
 	}
+#endif	// A3_PROCEDURAL_SSE
 
-	// repeat
-	if (repeatFirst)
+	// remainder, or everything for texture coordinates
+	for (; i < count; ++i, position += attribElems)
 	{
-		a3trigTaylor_sind_cosd(angleOffset, position + 1, position);
-		position[0] = xOffset + radius*position[0];
-		position[1] = yOffset + radius*position[1] * verticalSign;
-	//	position[0] = xOffset + radius;
-	//	position[1] = yOffset;
-		position[2] = zOffset;
-		position += attribElems;
+		position[0] = xOffset + radius*ring[i];
+		position[1] = yOffset + radius*ringSin[i] * verticalSign;
+		if (attribElems > 2)
+			position[2] = zOffset;
 	}
 
 	// done, return where we end off
 	return position;
 }
 
+inline a3f32 *a3proceduralInternalCreateCircle(a3f32 *position, const a3f32 radius, const a3f32 xOffset, const a3f32 yOffset, const a3f32 zOffset, const a3f32 angleOffset, const a3ui32 slices, const a3ui32 attribElems, const a3boolean repeatFirst, const a3i32 flipVertical)
+{
+	// single circle: calculate unit circle and scale it
+	a3f32 ring[ringMax * 2];
+	a3proceduralInternalCreateRing(ring, angleOffset, slices);
+	return a3proceduralInternalCreateCircleRing(position, ring, radius, xOffset, yOffset, zOffset, slices, attribElems, repeatFirst, flipVertical);
+}
+
 
 // circle indices
 inline a3ubyte *a3proceduralInternalStoreRingIndices(a3ubyte *index, const a3ui32 indexSize, const a3ui32 slices, const a3ui32 ringIndex, const a3i32 firstIsLast)
@@ -259,6 +284,7 @@ void a3proceduralInternalCircleGenerateAlgorithm(a3f32 *positions_out, a3f32 *te
 	a3f32 deltaRadius = 1.0f;
 	a3f32 r = 1.0f;
 	a3ui32 i = 0, j = 0, k = 0;
+	a3f32 ringData[ringMax * 2], *const ring = a3proceduralInternalCreateRing(ringData, 0.0f, slices);
 
 
 	//-------------------------------------------------------------------------
@@ -268,7 +294,7 @@ void a3proceduralInternalCircleGenerateAlgorithm(a3f32 *positions_out, a3f32 *te
 	// repeat last because it is a closed triangle fan
 	// final vertex is center
 	for (i = 0, r = radius, deltaRadius = r / (a3f32)subdivsBase; i < subdivsBase; ++i, r = radius - deltaRadius*(a3f32)i)
-		positions_out = a3proceduralInternalCreateCircle(positions_out, r, xOffset, yOffset, zOffset, 0.0f, slices, vElems, 0, flipVertical);
+		positions_out = a3proceduralInternalCreateCircleRing(positions_out, ring, r, xOffset, yOffset, zOffset, slices, vElems, 0, flipVertical);
 
 	// add center if solid or using subdivisions
 	if (isSolid || subdivsBase > 1)
@@ -307,7 +333,7 @@ void a3proceduralInternalCircleGenerateAlgorithm(a3f32 *positions_out, a3f32 *te
 			// offset the whole thing by half a unit, radius is half
 			// center vertex is half-half
 			for (i = 0, r = uvRadius, deltaRadius = r / (a3f32)subdivsBase; i < subdivsBase; ++i, r = uvRadius - deltaRadius*(a3f32)i)
-				texcoords_out = a3proceduralInternalCreateCircle(texcoords_out, r, uOffset, vOffset, 0.0f, 0.0f, slices, tElems, 0, 0);
+				texcoords_out = a3proceduralInternalCreateCircleRing(texcoords_out, ring, r, uOffset, vOffset, 0.0f, slices, tElems, 0, 0);
 			texcoords_out[0] = uOffset;
 			texcoords_out[1] = vOffset;
 			texcoords_out += tElems;
@@ -112,6 +112,7 @@ a3ret a3proceduralInternalGenerateCone(a3_GeometryData *geomData, const a3_Proce
 	a3f32 *attribItr = positions, *attribItr2 = positions, *attribItr3 = positions, *pPtr = positions, *tcPtr = texcoords;
 	a3ubyte *indexItr = indices;
 	a3ui32 i = 0, j = 0, k = 0;
+	a3f32 ringData[ringMax * 2], *const ring = a3proceduralInternalCreateRing(ringData, 0.0f, slices);
 	a3i32 indexDelta = 0;
 	a3i64 valid = 0;
 
@@ -146,11 +147,11 @@ a3ret a3proceduralInternalGenerateCone(a3_GeometryData *geomData, const a3_Proce
 		attribItr = positions + baseVertsOffset;
 
 		// body: rings, extra around base for different attributes
-		attribItr = a3proceduralInternalCreateCircle(attribItr, radius, 0.0f, 0.0f, 0.0f, 0.0f, slices, vElems, 1, 0);
+		attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius, 0.0f, 0.0f, 0.0f, slices, vElems, 1, 0);
 		for (i = 1, elev = deltaLen; i < subdivsL; elev = deltaLen*(a3f32)(++i))
 		{
 			ringRadius = (length - elev) / length;
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius * ringRadius, 0.0f, 0.0f, elev, 0.0f, slices, vElems, 1, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius * ringRadius, 0.0f, 0.0f, elev, slices, vElems, 1, 0);
 		}
 	
 		// cap: create one point at the pole per slice
@@ -332,7 +333,7 @@ a3ret a3proceduralInternalGenerateCone(a3_GeometryData *geomData, const a3_Proce
 		for (i = 1, elev = deltaLen; i < subdivsL; elev = deltaLen*(a3f32)(++i))
 		{
 			ringRadius = (length - elev) / length;
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius * ringRadius, 0.0f, 0.0f, elev, 0.0f, slices, vElems, 0, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius * ringRadius, 0.0f, 0.0f, elev, slices, vElems, 0, 0);
 		}
 
 		// add exactly one vertex for cap
@@ -115,6 +115,7 @@ a3ret a3proceduralInternalGenerateCylinder(a3_GeometryData *geomData, const a3_P
 	a3f32 *attribItr = positions, *attribItr2 = positions, *attribItr3 = positions, *pPtr = positions, *tcPtr = texcoords;
 	a3ubyte *indexItr = indices;
 	a3ui32 i = 0, j = 0, k = 0;
+	a3f32 ringData[ringMax * 2], *const ring = a3proceduralInternalCreateRing(ringData, 0.0f, slices);
 	a3i32 indexDelta = 0;
 	a3i64 valid = 0;
 
@@ -165,7 +166,7 @@ a3ret a3proceduralInternalGenerateCylinder(a3_GeometryData *geomData, const a3_P
 
 		// body: rings, extra around bases for different attributes
 		for (i = 0, elev = -halfLength; i <= subdivsL; elev = deltaLen*(a3f32)(++i) - halfLength)
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius, 0.0f, 0.0f, elev, 0.0f, slices, vElems, 1, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius, 0.0f, 0.0f, elev, slices, vElems, 1, 0);
 
 		// offset again
 		attribItr += baseVertsOffset;
@@ -328,7 +329,7 @@ a3ret a3proceduralInternalGenerateCylinder(a3_GeometryData *geomData, const a3_P
 
 		// body, no extra rings
 		for (i = 1, elev = deltaLen - halfLength; i < subdivsL; elev = deltaLen*(a3f32)(++i) - halfLength)
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius, 0.0f, 0.0f, elev, 0.0f, slices, vElems, 0, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius, 0.0f, 0.0f, elev, slices, vElems, 0, 0);
 
 		// offset
 		attribItr += baseVertsOffset;
@@ -107,6 +107,7 @@ a3ret a3proceduralInternalGenerateDiamond(a3_GeometryData *geomData, const a3_Pr
 	a3f32 *attribItr = positions, *attribItr2 = positions, *attribItr3 = positions, *pPtr = positions, *tcPtr = texcoords;
 	a3ubyte *indexItr = indices;
 	a3ui32 i = 0, j = 0, k = 0;
+	a3f32 ringData[ringMax * 2], *const ring = a3proceduralInternalCreateRing(ringData, 0.0f, slices);
 	a3boolean valid = 0;
 
 
@@ -124,13 +125,13 @@ a3ret a3proceduralInternalGenerateDiamond(a3_GeometryData *geomData, const a3_Pr
 		for (i = 1, elev = deltaLen - halfLength; i <= subdivsPerHalfL; elev = deltaLen*(a3f32)(++i) - halfLength)
 		{
 			ringRadius = (halfLength + elev) / halfLength;
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius * ringRadius, 0.0f, 0.0f, elev, 0.0f, slices, vElems, 1, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius * ringRadius, 0.0f, 0.0f, elev, slices, vElems, 1, 0);
 		}
 		pPtr = attribItr;	// save for later
 		for (i = 0, elev = 0.0f; i < subdivsPerHalfL; elev = deltaLen*(a3f32)(++i))
 		{
 			ringRadius = (halfLength - elev) / halfLength;
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius * ringRadius, 0.0f, 0.0f, elev, 0.0f, slices, vElems, 1, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius * ringRadius, 0.0f, 0.0f, elev, slices, vElems, 1, 0);
 		}
 
 		// cap: create one point at the pole per slice
@@ -342,12 +343,12 @@ a3ret a3proceduralInternalGenerateDiamond(a3_GeometryData *geomData, const a3_Pr
 		for (i = 1, elev = deltaLen - halfLength; i < subdivsPerHalfL; elev = deltaLen*(a3f32)(++i) - halfLength)
 		{
 			ringRadius = (halfLength + elev) / halfLength;
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius * ringRadius, 0.0f, 0.0f, elev, 0.0f, slices, vElems, 0, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius * ringRadius, 0.0f, 0.0f, elev, slices, vElems, 0, 0);
 		}
 		for (i = 0, elev = 0.0f; i < subdivsPerHalfL; elev = deltaLen*(a3f32)(++i))
 		{
 			ringRadius = (halfLength - elev) / halfLength;
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius * ringRadius, 0.0f, 0.0f, elev, 0.0f, slices, vElems, 0, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius * ringRadius, 0.0f, 0.0f, elev, slices, vElems, 0, 0);
 		}
 
 		// add exactly one vertex for each cap
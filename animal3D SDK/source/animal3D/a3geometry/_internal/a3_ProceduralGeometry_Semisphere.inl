@@ -119,6 +119,7 @@ a3ret a3proceduralInternalGenerateSemisphere(a3_GeometryData *geomData, const a3
 	a3f32 *attribItr = positions, *attribItr2 = positions, *attribItr3 = positions, *pPtr = positions, *tcPtr = texcoords;
 	a3ubyte *indexItr = indices;
 	a3ui32 i = 0, j = 0, k = 0;
+	a3f32 ringData[ringMax * 2], *const ring = a3proceduralInternalCreateRing(ringData, 0.0f, slices);
 	a3i32 indexDelta = 0;
 	a3boolean valid = 0;
 
@@ -156,11 +157,11 @@ a3ret a3proceduralInternalGenerateSemisphere(a3_GeometryData *geomData, const a3
 		// body: a bunch of rings, circle can be generated using 
 		//	procedural circle algorithm
 		// need an additional one at the bottom because it has different attributes
-		attribItr = a3proceduralInternalCreateCircle(attribItr, radius, 0.0f, 0.0f, 0.0f, 0.0f, slices, vElems, 1, 0);
+		attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius, 0.0f, 0.0f, 0.0f, slices, vElems, 1, 0);
 		for (i = 1, elev = 90.0f - deltaElev; i < stacks; elev = 90.0f - deltaElev*(a3f32)(++i))
 		{
 			a3trigTaylor_sind_cosd(elev, ringRadius, ringDepth);
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius * *ringRadius, 0.0f, 0.0f, radius * *ringDepth, 0.0f, slices, vElems, 1, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius * *ringRadius, 0.0f, 0.0f, radius * *ringDepth, slices, vElems, 1, 0);
 		}
 
 		// cap: create one point at the pole per slice
@@ -326,7 +327,7 @@ a3ret a3proceduralInternalGenerateSemisphere(a3_GeometryData *geomData, const a3
 		for (i = 1, elev = 90.0f - deltaElev; i < stacks; elev = 90.0f - deltaElev*(a3f32)(++i))
 		{
 			a3trigTaylor_sind_cosd(elev, ringRadius, ringDepth);
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius * *ringRadius, 0.0f, 0.0f, radius * *ringDepth, 0.0f, slices, vElems, 0, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius * *ringRadius, 0.0f, 0.0f, radius * *ringDepth, slices, vElems, 0, 0);
 		}
 
 		// cap: one lonely vertex
@@ -113,6 +113,7 @@ a3ret a3proceduralInternalGenerateSphere(a3_GeometryData *geomData, const a3_Pro
 	a3f32 *attribItr = positions, *attribItr2 = positions, *attribItr3 = positions, *pPtr = positions, *tcPtr = texcoords;
 	a3ubyte *indexItr = indices;
 	a3ui32 i = 0, j = 0, k = 0;
+	a3f32 ringData[ringMax * 2], *const ring = a3proceduralInternalCreateRing(ringData, 0.0f, slices);
 	a3boolean valid = 0;
 
 
@@ -140,7 +141,7 @@ a3ret a3proceduralInternalGenerateSphere(a3_GeometryData *geomData, const a3_Pro
 		for (i = 1, elev = 180.0f - deltaElev; i < stacks; elev = 180.0f - deltaElev*(a3f32)(++i))
 		{
 			a3trigTaylor_sind_cosd(elev, ringRadius, ringDepth);
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius * *ringRadius, 0.0f, 0.0f, radius * *ringDepth, 0.0f, slices, vElems, 1, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius * *ringRadius, 0.0f, 0.0f, radius * *ringDepth, slices, vElems, 1, 0);
 		}
 
 		// cap: create one point at the pole per slice
@@ -318,7 +319,7 @@ a3ret a3proceduralInternalGenerateSphere(a3_GeometryData *geomData, const a3_Pro
 		for (i = 1, elev = 180.0f - deltaElev; i < stacks; elev = 180.0f - deltaElev*(a3f32)(++i))
 		{
 			a3trigTaylor_sind_cosd(elev, ringRadius, ringDepth);
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radius * *ringRadius, 0.0f, 0.0f, radius * *ringDepth, 0.0f, slices, vElems, 0, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radius * *ringRadius, 0.0f, 0.0f, radius * *ringDepth, slices, vElems, 0, 0);
 		}
 
 		// add exactly one vertex for each cap
@@ -107,6 +107,7 @@ a3ret a3proceduralInternalGenerateTorus(a3_GeometryData *geomData, const a3_Proc
 	a3f32 *attribItr = positions, *attribItr2 = positions, *attribItr3 = positions, *pPtr = positions, *tcPtr = texcoords;
 	a3ubyte *indexItr = indices;
 	a3ui32 i = 0, j = 0, k = 0;
+	a3f32 ringData[ringMax * 2], *const ring = a3proceduralInternalCreateRing(ringData, 0.0f, slices);
 	a3boolean valid = 0;
 
 
@@ -124,14 +125,14 @@ a3ret a3proceduralInternalGenerateTorus(a3_GeometryData *geomData, const a3_Proc
 		a3f32 elev = 0.0f, ringRadius[1], ringDepth[1];
 		
 		// inner-most circle
-		attribItr = a3proceduralInternalCreateCircle(attribItr, radiusMajor - radiusMinor, 0.0f, 0.0f, 0.0f, 0.0f, slices, vElems, 1, 0);
+		attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radiusMajor - radiusMinor, 0.0f, 0.0f, 0.0f, slices, vElems, 1, 0);
 		for (i = 1, elev = deltaElev; i < subdivsR; elev = deltaElev*(a3f32)(++i))
 		{
 			a3trigTaylor_sind_cosd(elev, ringDepth, ringRadius);
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radiusMajor - radiusMinor * *ringRadius, 0.0f, 0.0f, -radiusMinor * *ringDepth, 0.0f, slices, vElems, 1, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radiusMajor - radiusMinor * *ringRadius, 0.0f, 0.0f, -radiusMinor * *ringDepth, slices, vElems, 1, 0);
 		}
 		// inner-most again
-		attribItr = a3proceduralInternalCreateCircle(attribItr, radiusMajor - radiusMinor, 0.0f, 0.0f, 0.0f, 0.0f, slices, vElems, 1, 0);
+		attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radiusMajor - radiusMinor, 0.0f, 0.0f, 0.0f, slices, vElems, 1, 0);
 
 		// done, transform AT THE END because current state used for normals
 		assert(valid = attribItr == texcoords);
@@ -192,10 +193,9 @@ a3ret a3proceduralInternalGenerateTorus(a3_GeometryData *geomData, const a3_Proc
 			attribItr = attribItr2 = normals, pPtr = positions;
 			for (i = (slices+1)*vElems, j = 0; j <= slices; ++j, attribItr = normals + j*vElems, pPtr = positions + j*vElems)
 			{
-				// calculate core
-				a3trigTaylor_sind_cosd(deltaAzim*(a3f32)j, corePos + 1, corePos);
-				corePos[0] *= radiusMajor;
-				corePos[1] *= radiusMajor;
+				// calculate core from ring
+				corePos[0] = ring[j] * radiusMajor;
+				corePos[1] = ring[ringMax + j] * radiusMajor;
 				for (k = 0; k <= subdivsR; ++k, attribItr += i, pPtr += i, attribItr2 += vElems)
 				{
 					deltaPos[0] = pPtr[0] - corePos[0];
@@ -265,11 +265,11 @@ a3ret a3proceduralInternalGenerateTorus(a3_GeometryData *geomData, const a3_Proc
 		a3f32 elev = 0.0f, ringRadius[1], ringDepth[1];
 
 		// inner-most circle
-		attribItr = a3proceduralInternalCreateCircle(attribItr, radiusMajor - radiusMinor, 0.0f, 0.0f, 0.0f, 0.0f, slices, vElems, 0, 0);
+		attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radiusMajor - radiusMinor, 0.0f, 0.0f, 0.0f, slices, vElems, 0, 0);
 		for (i = 1, elev = deltaElev; i < subdivsR; elev = deltaElev*(a3f32)(++i))
 		{
 			a3trigTaylor_sind_cosd(elev, ringDepth, ringRadius);
-			attribItr = a3proceduralInternalCreateCircle(attribItr, radiusMajor - radiusMinor * *ringRadius, 0.0f, 0.0f, -radiusMinor * *ringDepth, 0.0f, slices, vElems, 0, 0);
+			attribItr = a3proceduralInternalCreateCircleRing(attribItr, ring, radiusMajor - radiusMinor * *ringRadius, 0.0f, 0.0f, -radiusMinor * *ringDepth, slices, vElems, 0, 0);
 		}
 
 		// done, transform AT THE END because current state used for normals
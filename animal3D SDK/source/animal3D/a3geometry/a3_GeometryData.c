@@ -27,29 +27,42 @@
 #include "animal3D/a3geometry/a3_GeometryData.h"
 
 #include "animal3D-A3DM/a3math/a3vector.h"
+#include "animal3D-A3DM/a3math/a3sqrt.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+// tangent batches use four-wide vectors wherever the math library uses 
+//	x86 SIMD, so they can share its fast inverse square root
+#if (A3_SIMD == A3_SIMD_SSE2 || A3_SIMD == A3_SIMD_SSE41 || A3_SIMD == A3_SIMD_AVX2)
+#define A3_GEOMETRY_SSE
+#include <xmmintrin.h>
+#endif	// (A3_SIMD == A3_SIMD_SSE2 || A3_SIMD == A3_SIMD_SSE41 || A3_SIMD == A3_SIMD_AVX2)
+
 
 //-----------------------------------------------------------------------------
 
-a3ret a3geometryCreateVertexFormat(a3_VertexFormatDescriptor *vertexFormat_out, const a3_GeometryVertexAttributeName *attribNameList, a3ui32 attribNameCount)
+// vertex attribute slot of each geometry attribute, followed by the 
+//	implicit bitangent and blend indices
+static const a3_VertexAttributeName a3geometryInternalAttribName[a3attrib_geomNameMax + 2] = {
+	a3attrib_position,
+	a3attrib_normal,
+	a3attrib_color,
+	a3attrib_texcoord,
+	a3attrib_tangent,
+	a3attrib_blendWeights,
+	a3attrib_bitangent,
+	a3attrib_blendIndices,
+};
+
+
+//-----------------------------------------------------------------------------
+
+// select attributes from a fixed table of geometry attribute types
+a3ret a3geometryInternalCreateVertexFormat(a3_VertexFormatDescriptor *vertexFormat_out, const a3_GeometryVertexAttributeName *attribNameList, a3ui32 attribNameCount, const a3_VertexAttributeDescriptor *fixedAttribs)
 {
 	static const a3ui16 secondaryAttribOffset = 2;
-	static const a3_VertexAttributeDescriptor fixedAttribs[] = {
-		// 6 explicit
-		{ a3attrib_position,		a3attrib_vec3	},
-		{ a3attrib_normal,			a3attrib_vec3	},
-		{ a3attrib_color,			a3attrib_vec4	},
-		{ a3attrib_texcoord,		a3attrib_vec2	},
-		{ a3attrib_tangent,			a3attrib_vec3	},
-		{ a3attrib_blendWeights,	a3attrib_vec4	},
-		// 2 implicit
-		{ a3attrib_bitangent,		a3attrib_vec3	},
-		{ a3attrib_blendIndices,	a3attrib_ivec4	},
-	};
 
 	// prepare list of actual attributes
 	const a3_VertexAttributeDescriptor *attribOrdered[8] = { 0 };
@@ -114,6 +127,40 @@ a3ret a3geometryCreateVertexFormat(a3_VertexFormatDescriptor *vertexFormat_out,
 	return -1;
 }
 
+a3ret a3geometryCreateVertexFormat(a3_VertexFormatDescriptor *vertexFormat_out, const a3_GeometryVertexAttributeName *attribNameList, a3ui32 attribNameCount)
+{
+	static const a3_VertexAttributeDescriptor fixedAttribs[] = {
+		// 6 explicit
+		{ a3attrib_position,		a3attrib_vec3	},
+		{ a3attrib_normal,			a3attrib_vec3	},
+		{ a3attrib_color,			a3attrib_vec4	},
+		{ a3attrib_texcoord,		a3attrib_vec2	},
+		{ a3attrib_tangent,			a3attrib_vec3	},
+		{ a3attrib_blendWeights,	a3attrib_vec4	},
+		// 2 implicit
+		{ a3attrib_bitangent,		a3attrib_vec3	},
+		{ a3attrib_blendIndices,	a3attrib_ivec4	},
+	};
+	return a3geometryInternalCreateVertexFormat(vertexFormat_out, attribNameList, attribNameCount, fixedAttribs);
+}
+
+a3ret a3geometryCreateVertexFormatQuantized(a3_VertexFormatDescriptor *vertexFormat_out, const a3_GeometryVertexAttributeName *attribNameList, a3ui32 attribNameCount)
+{
+	static const a3_VertexAttributeDescriptor fixedAttribs[] = {
+		// 6 explicit
+		{ a3attrib_position,		a3attrib_unvec4	},	// xyz in bounds, w unused
+		{ a3attrib_normal,			a3attrib_snvec2	},	// octahedral
+		{ a3attrib_color,			a3attrib_hvec4	},
+		{ a3attrib_texcoord,		a3attrib_unvec2	},	// in bounds
+		{ a3attrib_tangent,			a3attrib_snvec2	},	// octahedral
+		{ a3attrib_blendWeights,	a3attrib_unvec4	},
+		// 2 implicit
+		{ a3attrib_bitangent,		a3attrib_snvec2	},	// octahedral
+		{ a3attrib_blendIndices,	a3attrib_ivec4	},
+	};
+	return a3geometryInternalCreateVertexFormat(vertexFormat_out, attribNameList, attribNameCount, fixedAttribs);
+}
+
 a3ret a3geometryCreateIndexFormat(a3_IndexFormatDescriptor *indexFormat_out, const a3ui32 vertexCount)
 {
 	const a3_IndexType indexType = (vertexCount ? vertexCount < a3index_countMaxByte ? a3index_byte : vertexCount < a3index_countMaxShort ? a3index_short : a3index_int : a3index_disable);
@@ -123,19 +170,44 @@ a3ret a3geometryCreateIndexFormat(a3_IndexFormatDescriptor *indexFormat_out, con
 
 //-----------------------------------------------------------------------------
 
-a3ret a3geometryGenerateDrawable(a3_VertexDrawable *drawable_out, const a3_GeometryData *geom, a3_VertexArrayDescriptor *vertexArray, a3_IndexBuffer *indexBuffer, const a3_IndexFormatDescriptor *commonIndexFormat_opt, a3ui32 *vertexBufferOffset_out_opt, a3ui32 *indexBufferOffset_out_opt)
+a3ret a3geometryGetVertexAttribName(const a3ui32 geomAttribName)
 {
-	static const a3_VertexAttributeName fixedAttribName[] = {
-		a3attrib_position,
-		a3attrib_normal,
-		a3attrib_color,
-		a3attrib_texcoord,
-		a3attrib_tangent,
-		a3attrib_blendWeights,
-		a3attrib_bitangent,
-		a3attrib_blendIndices,
-	};
+	if (geomAttribName < a3attrib_geomNameMax + 2)
+		return a3geometryInternalAttribName[geomAttribName];
+	return -1;
+}
+
+a3ret a3geometryGetIndices(a3ui32 *indices_out, const a3_GeometryData *geom)
+{
+	a3ui32 i;
+	if (indices_out && geom && geom->data)
+	{
+		if (!geom->indexData || !geom->numIndices)
+			return 0;
+		switch (geom->indexFormat->indexSize)
+		{
+		case 1:
+			for (i = 0; i < geom->numIndices; ++i)
+				indices_out[i] = ((const a3ubyte *)geom->indexData)[i];
+			break;
+		case 2:
+			for (i = 0; i < geom->numIndices; ++i)
+				indices_out[i] = ((const a3ui16 *)geom->indexData)[i];
+			break;
+		default:
+			memcpy(indices_out, geom->indexData, geom->numIndices * sizeof(a3ui32));
+			break;
+		}
+		return geom->numIndices;
+	}
+	return -1;
+}
+
 
+//-----------------------------------------------------------------------------
+
+a3ret a3geometryGenerateDrawable(a3_VertexDrawable *drawable_out, const a3_GeometryData *geom, a3_VertexArrayDescriptor *vertexArray, a3_IndexBuffer *indexBuffer, const a3_IndexFormatDescriptor *commonIndexFormat_opt, a3ui32 *vertexBufferOffset_out_opt, a3ui32 *indexBufferOffset_out_opt)
+{
 	// create geometry attribute list
 	// attribute data to store
 	a3_VertexAttributeDataDescriptor attribData[a3attrib_geomNameMax + 2] = { 0 }, *attribDataPtr = attribData;
@@ -170,7 +242,7 @@ a3ret a3geometryGenerateDrawable(a3_VertexDrawable *drawable_out, const a3_Geome
 			for (i = 0; i < a3attrib_geomNameMax; ++i)
 				if (geom->attribData[i])
 				{
-					attribData[numAttribs].name = fixedAttribName[i];
+					attribData[numAttribs].name = a3geometryInternalAttribName[i];
 					attribData[numAttribs].data = geom->attribData[i];
 					++numAttribs;
 				}
@@ -178,20 +250,20 @@ a3ret a3geometryGenerateDrawable(a3_VertexDrawable *drawable_out, const a3_Geome
 			// if tangents are enabled, get data
 			if (geom->attribData[a3attrib_geomTangent])
 			{
-				attribData[numAttribs].name = fixedName = fixedAttribName[a3attrib_geomTangent + 2];
+				attribData[numAttribs].name = fixedName = a3geometryInternalAttribName[a3attrib_geomTangent + 2];
 				attribData[numAttribs].data
-					= (a3f32 *)(geom->attribData[a3attrib_geomTangent])
-					+ geom->vertexFormat->attribElements[fixedName] * geom->numVertices;
+					= (a3ubyte *)(geom->attribData[a3attrib_geomTangent])
+					+ geom->vertexFormat->attribSize[a3geometryInternalAttribName[a3attrib_geomTangent]] * geom->numVertices;
 				++numAttribs;
 			}
 
 			// if blend weights are enabled, them too
 			if (geom->attribData[a3attrib_geomBlending])
 			{
-				attribData[numAttribs].name = fixedName = fixedAttribName[a3attrib_geomBlending + 2];
+				attribData[numAttribs].name = fixedName = a3geometryInternalAttribName[a3attrib_geomBlending + 2];
 				attribData[numAttribs].data
-					= (a3f32 *)(geom->attribData[a3attrib_geomBlending])
-					+ geom->vertexFormat->attribElements[fixedName] * geom->numVertices;
+					= (a3ubyte *)(geom->attribData[a3attrib_geomBlending])
+					+ geom->vertexFormat->attribSize[a3geometryInternalAttribName[a3attrib_geomBlending]] * geom->numVertices;
 				++numAttribs;
 			}
 
@@ -217,6 +289,9 @@ a3ret a3geometryGenerateDrawable(a3_VertexDrawable *drawable_out, const a3_Geome
 				a3vertexDrawableCreate(drawable_out, vertexArray, geom->primType, i, geom->numVertices);
 			}
 
+			// drawable keeps bounds for culling
+			*drawable_out->bounds = *geom->bounds;
+
 			// done
 			return ret;
 		}
@@ -266,6 +341,9 @@ a3ret a3geometrySaveDataBinary(const a3_GeometryData *geom, const a3_FileStream
 					offset[i] = geom->attribData[i] ? (a3i32)((a3byte *)(geom->attribData[i]) - (a3byte *)(geom->data)) : -1;
 				offset[i] = geom->indexData ? (a3i32)((a3byte *)(geom->indexData) - (a3byte *)(geom->data)) : -1;
 				ret += (a3ui32)fwrite(offset, 1, sizeof(a3i32) * (a3attrib_geomNameMax + 1), fp);
+
+				// write bounds
+				ret += (a3ui32)fwrite(geom->bounds, 1, sizeof(a3_VertexBounds), fp);
 			}
 			return ret;
 		}
@@ -314,6 +392,9 @@ a3ret a3geometryLoadDataBinary(a3_GeometryData *geom_out, const a3_FileStream *f
 				for (i = 0; i < a3attrib_geomNameMax; ++i)
 					geom_out->attribData[i] = (offset[i] >= 0) ? ((a3byte *)(geom_out->data) + offset[i]) : 0;
 				geom_out->indexData = (offset[i] >= 0) ? ((a3byte *)(geom_out->data) + offset[i]) : 0;
+
+				// read bounds
+				ret += (a3ui32)fread(geom_out->bounds, 1, sizeof(a3_VertexBounds), fp);
 			}
 			return ret;
 		}
@@ -354,6 +435,9 @@ a3ret a3geometryCopyDataToString(const a3_GeometryData *geom, a3byte *str)
 			offset[i] = geom->indexData ? (a3i32)((a3byte *)(geom->indexData) - (a3byte *)(geom->data)) : -1;
 			str = (a3byte *)((a3i32 *)memcpy(str, offset, sizeof(offset)) + a3attrib_geomNameMax + 1);
 
+			// write bounds
+			str = (a3byte *)((a3_VertexBounds *)memcpy(str, geom->bounds, sizeof(geom->bounds)) + 1);
+
 			// done
 			return (a3i32)(str - start);
 		}
@@ -401,6 +485,10 @@ a3ret a3geometryCopyStringToData(a3_GeometryData *geom_out, const a3byte *str)
 				geom_out->attribData[i] = (offset[i] >= 0) ? ((a3byte *)(geom_out->data) + offset[i]) : 0;
 			geom_out->indexData = (offset[i] >= 0) ? ((a3byte *)(geom_out->data) + offset[i]) : 0;
 
+			// read bounds
+			memcpy(geom_out->bounds, str, sizeof(geom_out->bounds));
+			str += sizeof(geom_out->bounds);
+
 			// done
 			return (a3i32)(str - start);
 		}
@@ -419,6 +507,7 @@ a3ret a3geometryGetStringSize(const a3_GeometryData *geom)
 			+ sizeof(geom->numVertices)
 			+ sizeof(geom->numIndices)
 			+ sizeof(a3i32) * (a3attrib_geomNameMax + 1)
+			+ sizeof(geom->bounds)
 			+ a3vertexFormatGetStorageSpaceRequired(geom->vertexFormat, geom->numVertices)
 			+ a3indexFormatGetStorageSpaceRequired(geom->indexFormat, geom->numIndices);
 		return size;
@@ -518,6 +607,615 @@ extern inline a3ubyte *a3proceduralInternalStoreIndex(a3ubyte *index, const a3ui
 }
 
 
+//-----------------------------------------------------------------------------
+// batched tangent basis: face bases are computed four at a time, each 
+//	task sums its faces into its own copy of the vertex bases so no two 
+//	tasks write the same memory, then the copies are reduced per vertex
+
+// work sharing limits
+enum a3_GeometryTangentBatchLimit
+{
+	a3geometryTangentBatch_width = 4,			// lanes per batch
+	a3geometryTangentBatch_taskMax = 8,			// tasks sharing a pass
+	a3geometryTangentBatch_faceMin = 16384,		// faces per task worth dispatching
+};
+
+// basis components; batches hold one array per component, sums hold 
+//	all components of a vertex together
+enum a3_GeometryTangentBatchComponent
+{
+	a3geometryTangentBatch_tx, a3geometryTangentBatch_ty, a3geometryTangentBatch_tz,
+	a3geometryTangentBatch_bx, a3geometryTangentBatch_by, a3geometryTangentBatch_bz,
+	a3geometryTangentBatch_nx, a3geometryTangentBatch_ny, a3geometryTangentBatch_nz,
+	a3geometryTangentBatch_basis,
+};
+
+// shared data and one task's range
+typedef struct a3_GeometryTangentBatchWork	a3_GeometryTangentBatchWork;
+struct a3_GeometryTangentBatchWork
+{
+	a3f32 *tangent_out, *bitangent_out, *normal_out;
+	a3ui32 stride;
+	const a3f32 *positions, *texcoords;
+	const a3ui32 *positionIndex, *texcoordIndex;
+	a3f32 *partial;
+	const a3f32 *partials;
+	a3ui32 partialCount, vertexCount;
+	a3ui32 first, last;
+};
+
+
+// un-normalized orthogonal tangent basis of four faces; same result as 
+//	the single face version, except degenerate texture coordinates or 
+//	areas give zero vectors instead of undefined ones
+//	p, t: corner positions (xyz) and texture coordinates (xy) of each face
+extern inline void a3geometryInternalTangentBatchFace(a3f32 basis_out[a3geometryTangentBatch_basis][a3geometryTangentBatch_width], const a3f32 *p[3][a3geometryTangentBatch_width], const a3f32 *t[3][a3geometryTangentBatch_width])
+{
+#ifdef A3_GEOMETRY_SSE
+	// build lanes directly from the corners
+#define A3_GEOMETRY_SSE_GATHER(v, i, c)	_mm_set_ps(v[i][3][c], v[i][2][c], v[i][1][c], v[i][0][c])
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 p0x = A3_GEOMETRY_SSE_GATHER(p, 0, 0), p0y = A3_GEOMETRY_SSE_GATHER(p, 0, 1), p0z = A3_GEOMETRY_SSE_GATHER(p, 0, 2);
+	const __m128 dp1x = _mm_sub_ps(A3_GEOMETRY_SSE_GATHER(p, 1, 0), p0x), dp1y = _mm_sub_ps(A3_GEOMETRY_SSE_GATHER(p, 1, 1), p0y), dp1z = _mm_sub_ps(A3_GEOMETRY_SSE_GATHER(p, 1, 2), p0z);
+	const __m128 dp2x = _mm_sub_ps(A3_GEOMETRY_SSE_GATHER(p, 2, 0), p0x), dp2y = _mm_sub_ps(A3_GEOMETRY_SSE_GATHER(p, 2, 1), p0y), dp2z = _mm_sub_ps(A3_GEOMETRY_SSE_GATHER(p, 2, 2), p0z);
+	const __m128 t0x = A3_GEOMETRY_SSE_GATHER(t, 0, 0), t0y = A3_GEOMETRY_SSE_GATHER(t, 0, 1);
+	const __m128 dt1x = _mm_sub_ps(A3_GEOMETRY_SSE_GATHER(t, 1, 0), t0x), dt1y = _mm_sub_ps(A3_GEOMETRY_SSE_GATHER(t, 1, 1), t0y);
+	const __m128 dt2x = _mm_sub_ps(A3_GEOMETRY_SSE_GATHER(t, 2, 0), t0x), dt2y = _mm_sub_ps(A3_GEOMETRY_SSE_GATHER(t, 2, 1), t0y);
+#undef A3_GEOMETRY_SSE_GATHER
+	const __m128 det = _mm_sub_ps(_mm_mul_ps(dt1x, dt2y), _mm_mul_ps(dt1y, dt2x));
+	const __m128 detInv = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), det), _mm_cmpneq_ps(det, zero));
+	__m128 tx, ty, tz, bx, by, bz, nx, ny, nz, lenSq, k0, k1;
+
+	// tangent and bitangent from texture coordinate matrix inverse
+	tx = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(dp1x, dt2y), _mm_mul_ps(dp2x, dt1y)), detInv);
+	ty = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(dp1y, dt2y), _mm_mul_ps(dp2y, dt1y)), detInv);
+	tz = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(dp1z, dt2y), _mm_mul_ps(dp2z, dt1y)), detInv);
+	bx = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(dp2x, dt1x), _mm_mul_ps(dp1x, dt2x)), detInv);
+	by = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(dp2y, dt1x), _mm_mul_ps(dp1y, dt2x)), detInv);
+	bz = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(dp2z, dt1x), _mm_mul_ps(dp1z, dt2x)), detInv);
+
+	// normal: cross product of deltas
+	nx = _mm_sub_ps(_mm_mul_ps(dp1y, dp2z), _mm_mul_ps(dp1z, dp2y));
+	ny = _mm_sub_ps(_mm_mul_ps(dp1z, dp2x), _mm_mul_ps(dp1x, dp2z));
+	nz = _mm_sub_ps(_mm_mul_ps(dp1x, dp2y), _mm_mul_ps(dp1y, dp2x));
+
+	// Gram-Schmidt: remove normal from tangent, then normal and new 
+	//	tangent from bitangent
+	lenSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), _mm_mul_ps(nz, nz));
+	k0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, nx), _mm_mul_ps(ty, ny)), _mm_mul_ps(tz, nz));
+	k0 = _mm_and_ps(_mm_div_ps(k0, lenSq), _mm_cmpgt_ps(lenSq, zero));
+	k1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(bx, nx), _mm_mul_ps(by, ny)), _mm_mul_ps(bz, nz));
+	k1 = _mm_and_ps(_mm_div_ps(k1, lenSq), _mm_cmpgt_ps(lenSq, zero));
+	tx = _mm_sub_ps(tx, _mm_mul_ps(nx, k0));
+	ty = _mm_sub_ps(ty, _mm_mul_ps(ny, k0));
+	tz = _mm_sub_ps(tz, _mm_mul_ps(nz, k0));
+	lenSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, tx), _mm_mul_ps(ty, ty)), _mm_mul_ps(tz, tz));
+	k0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(bx, tx), _mm_mul_ps(by, ty)), _mm_mul_ps(bz, tz));
+	k0 = _mm_and_ps(_mm_div_ps(k0, lenSq), _mm_cmpgt_ps(lenSq, zero));
+	bx = _mm_sub_ps(bx, _mm_add_ps(_mm_mul_ps(nx, k1), _mm_mul_ps(tx, k0)));
+	by = _mm_sub_ps(by, _mm_add_ps(_mm_mul_ps(ny, k1), _mm_mul_ps(ty, k0)));
+	bz = _mm_sub_ps(bz, _mm_add_ps(_mm_mul_ps(nz, k1), _mm_mul_ps(tz, k0)));
+
+	_mm_storeu_ps(basis_out[a3geometryTangentBatch_tx], tx);
+	_mm_storeu_ps(basis_out[a3geometryTangentBatch_ty], ty);
+	_mm_storeu_ps(basis_out[a3geometryTangentBatch_tz], tz);
+	_mm_storeu_ps(basis_out[a3geometryTangentBatch_bx], bx);
+	_mm_storeu_ps(basis_out[a3geometryTangentBatch_by], by);
+	_mm_storeu_ps(basis_out[a3geometryTangentBatch_bz], bz);
+	_mm_storeu_ps(basis_out[a3geometryTangentBatch_nx], nx);
+	_mm_storeu_ps(basis_out[a3geometryTangentBatch_ny], ny);
+	_mm_storeu_ps(basis_out[a3geometryTangentBatch_nz], nz);
+#else	// !A3_GEOMETRY_SSE
+	a3f32 tangent[3], bitangent[3], normal[3], det, lenSq, k0, k1;
+	a3ui32 j, lane;
+	for (lane = 0; lane < a3geometryTangentBatch_width; ++lane)
+	{
+		// guard degenerate texture coordinates
+		det = (t[1][lane][0] - t[0][lane][0]) * (t[2][lane][1] - t[0][lane][1]) - (t[1][lane][1] - t[0][lane][1]) * (t[2][lane][0] - t[0][lane][0]);
+		if (det != 0.0f)
+			a3proceduralInternalCalculateTangentBasis(tangent, bitangent, normal, p[0][lane], p[1][lane], p[2][lane], t[0][lane], t[1][lane], t[2][lane]);
+		else
+		{
+			a3proceduralInternalCalculateNormal(normal, p[0][lane], p[1][lane], p[2][lane]);
+			tangent[0] = tangent[1] = tangent[2] = bitangent[0] = bitangent[1] = bitangent[2] = 0.0f;
+		}
+
+		// guard degenerate area and tangent
+		lenSq = a3real3LengthSquared(normal);
+		k0 = lenSq > 0.0f ? a3real3Dot(tangent, normal) / lenSq : 0.0f;
+		k1 = lenSq > 0.0f ? a3real3Dot(bitangent, normal) / lenSq : 0.0f;
+		for (j = 0; j < 3; ++j)
+			tangent[j] -= normal[j] * k0;
+		lenSq = a3real3LengthSquared(tangent);
+		k0 = lenSq > 0.0f ? a3real3Dot(bitangent, tangent) / lenSq : 0.0f;
+		for (j = 0; j < 3; ++j)
+		{
+			bitangent[j] -= normal[j] * k1 + tangent[j] * k0;
+			basis_out[a3geometryTangentBatch_tx + j][lane] = tangent[j];
+			basis_out[a3geometryTangentBatch_bx + j][lane] = bitangent[j];
+			basis_out[a3geometryTangentBatch_nx + j][lane] = normal[j];
+		}
+	}
+#endif	// A3_GEOMETRY_SSE
+}
+
+// orthonormalize four accumulated vertex bases in place: unit normal, 
+//	tangent perpendicular to normal, bitangent perpendicular to both; zero 
+//	vectors stay zero; lengths use the fast inverse square root at its 
+//	current precision
+//	v: tangent, bitangent and normal of each vertex
+extern inline void a3geometryInternalTangentBatchOrtho(a3f32 *v[3][a3geometryTangentBatch_width])
+{
+#ifdef A3_GEOMETRY_SSE
+#define A3_GEOMETRY_SSE_GATHER(i, c)	_mm_set_ps(v[i][3][c], v[i][2][c], v[i][1][c], v[i][0][c])
+#define A3_GEOMETRY_SSE_SCATTER(i, c, x)	_mm_storeu_ps(lanes, x); v[i][0][c] = lanes[0]; v[i][1][c] = lanes[1]; v[i][2][c] = lanes[2]; v[i][3][c] = lanes[3]
+	__m128 tx = A3_GEOMETRY_SSE_GATHER(0, 0), ty = A3_GEOMETRY_SSE_GATHER(0, 1), tz = A3_GEOMETRY_SSE_GATHER(0, 2);
+	__m128 bx = A3_GEOMETRY_SSE_GATHER(1, 0), by = A3_GEOMETRY_SSE_GATHER(1, 1), bz = A3_GEOMETRY_SSE_GATHER(1, 2);
+	__m128 nx = A3_GEOMETRY_SSE_GATHER(2, 0), ny = A3_GEOMETRY_SSE_GATHER(2, 1), nz = A3_GEOMETRY_SSE_GATHER(2, 2);
+	__m128 lenSq, k0, k1;
+	a3f32 lanes[a3geometryTangentBatch_width];
+
+	// unit normal
+	lenSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), _mm_mul_ps(nz, nz));
+	k0 = a3sqrtfInverseFast4(lenSq);
+	nx = _mm_mul_ps(nx, k0);
+	ny = _mm_mul_ps(ny, k0);
+	nz = _mm_mul_ps(nz, k0);
+
+	// unit tangent
+	k0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, nx), _mm_mul_ps(ty, ny)), _mm_mul_ps(tz, nz));
+	tx = _mm_sub_ps(tx, _mm_mul_ps(nx, k0));
+	ty = _mm_sub_ps(ty, _mm_mul_ps(ny, k0));
+	tz = _mm_sub_ps(tz, _mm_mul_ps(nz, k0));
+	lenSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, tx), _mm_mul_ps(ty, ty)), _mm_mul_ps(tz, tz));
+	k0 = a3sqrtfInverseFast4(lenSq);
+	tx = _mm_mul_ps(tx, k0);
+	ty = _mm_mul_ps(ty, k0);
+	tz = _mm_mul_ps(tz, k0);
+
+	// unit bitangent
+	k0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(bx, nx), _mm_mul_ps(by, ny)), _mm_mul_ps(bz, nz));
+	k1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(bx, tx), _mm_mul_ps(by, ty)), _mm_mul_ps(bz, tz));
+	bx = _mm_sub_ps(bx, _mm_add_ps(_mm_mul_ps(nx, k0), _mm_mul_ps(tx, k1)));
+	by = _mm_sub_ps(by, _mm_add_ps(_mm_mul_ps(ny, k0), _mm_mul_ps(ty, k1)));
+	bz = _mm_sub_ps(bz, _mm_add_ps(_mm_mul_ps(nz, k0), _mm_mul_ps(tz, k1)));
+	lenSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(bx, bx), _mm_mul_ps(by, by)), _mm_mul_ps(bz, bz));
+	k0 = a3sqrtfInverseFast4(lenSq);
+	bx = _mm_mul_ps(bx, k0);
+	by = _mm_mul_ps(by, k0);
+	bz = _mm_mul_ps(bz, k0);
+
+	A3_GEOMETRY_SSE_SCATTER(0, 0, tx);
+	A3_GEOMETRY_SSE_SCATTER(0, 1, ty);
+	A3_GEOMETRY_SSE_SCATTER(0, 2, tz);
+	A3_GEOMETRY_SSE_SCATTER(1, 0, bx);
+	A3_GEOMETRY_SSE_SCATTER(1, 1, by);
+	A3_GEOMETRY_SSE_SCATTER(1, 2, bz);
+	A3_GEOMETRY_SSE_SCATTER(2, 0, nx);
+	A3_GEOMETRY_SSE_SCATTER(2, 1, ny);
+	A3_GEOMETRY_SSE_SCATTER(2, 2, nz);
+#undef A3_GEOMETRY_SSE_GATHER
+#undef A3_GEOMETRY_SSE_SCATTER
+#else	// !A3_GEOMETRY_SSE
+	a3f32 *tangent, *bitangent, *normal, lenSq, k0, k1;
+	a3ui32 j, lane;
+	for (lane = 0; lane < a3geometryTangentBatch_width; ++lane)
+	{
+		tangent = v[0][lane];
+		bitangent = v[1][lane];
+		normal = v[2][lane];
+
+		lenSq = a3real3LengthSquared(normal);
+		k0 = a3sqrtfInverseFast(lenSq);
+		a3real3MulS(normal, k0);
+
+		k0 = a3real3Dot(tangent, normal);
+		for (j = 0; j < 3; ++j)
+			tangent[j] -= normal[j] * k0;
+		lenSq = a3real3LengthSquared(tangent);
+		k0 = a3sqrtfInverseFast(lenSq);
+		a3real3MulS(tangent, k0);
+
+		k0 = a3real3Dot(bitangent, normal);
+		k1 = a3real3Dot(bitangent, tangent);
+		for (j = 0; j < 3; ++j)
+			bitangent[j] -= normal[j] * k0 + tangent[j] * k1;
+		lenSq = a3real3LengthSquared(bitangent);
+		k0 = a3sqrtfInverseFast(lenSq);
+		a3real3MulS(bitangent, k0);
+	}
+#endif	// A3_GEOMETRY_SSE
+}
+
+
+// face pass: gather corners of four faces at a time, padding the last 
+//	batch with a zero face, and add bases to this task's own vertex sums; 
+//	the first task sums straight into the outputs
+void a3geometryInternalTangentBatchFaces(void *args, a3ui32 index)
+{
+	static const a3f32 zero[3] = { 0.0f };
+	a3_GeometryTangentBatchWork *const work = (a3_GeometryTangentBatchWork *)args + index;
+	a3f32 basis[a3geometryTangentBatch_basis][a3geometryTangentBatch_width];
+	const a3f32 *p[3][a3geometryTangentBatch_width], *t[3][a3geometryTangentBatch_width];
+	a3f32 *sum;
+	a3ui32 face, count, lane, corner, j, k;
+
+	if (work->partial)
+		memset(work->partial, 0, work->vertexCount * a3geometryTangentBatch_basis * sizeof(a3f32));
+	else
+		for (j = 0; j < work->vertexCount * work->stride; j += work->stride)
+			for (k = 0; k < 3; ++k)
+				work->tangent_out[j + k] = work->bitangent_out[j + k] = work->normal_out[j + k] = 0.0f;
+	for (face = work->first; face < work->last; face += count)
+	{
+		count = work->last - face;
+		count = count < a3geometryTangentBatch_width ? count : a3geometryTangentBatch_width;
+		for (lane = 0; lane < a3geometryTangentBatch_width; ++lane)
+			for (corner = 0; corner < 3; ++corner)
+			{
+				j = (face + lane) * 3 + corner;
+				p[corner][lane] = lane < count ? work->positions + work->positionIndex[j] * 3 : zero;
+				t[corner][lane] = lane < count && work->texcoords ? work->texcoords + work->texcoordIndex[j] * 2 : zero;
+			}
+		a3geometryInternalTangentBatchFace(basis, p, t);
+		for (lane = 0; lane < count; ++lane)
+			for (corner = 0; corner < 3; ++corner)
+			{
+				j = work->positionIndex[(face + lane) * 3 + corner];
+				if (work->partial)
+				{
+					sum = work->partial + j * a3geometryTangentBatch_basis;
+					for (k = 0; k < a3geometryTangentBatch_basis; ++k)
+						sum[k] += basis[k][lane];
+				}
+				else for (j *= work->stride, k = 0; k < 3; ++k)
+				{
+					work->tangent_out[j + k] += basis[a3geometryTangentBatch_tx + k][lane];
+					work->bitangent_out[j + k] += basis[a3geometryTangentBatch_bx + k][lane];
+					work->normal_out[j + k] += basis[a3geometryTangentBatch_nx + k][lane];
+				}
+			}
+	}
+}
+
+// vertex pass: add the sums of the other tasks to the outputs, then 
+//	orthonormalize four vertices at a time, padding the last batch
+void a3geometryInternalTangentBatchVertices(void *args, a3ui32 index)
+{
+	a3_GeometryTangentBatchWork *const work = (a3_GeometryTangentBatchWork *)args + index;
+	a3f32 pad[3][3], *v[3][a3geometryTangentBatch_width];
+	const a3f32 *sum;
+	a3ui32 vertex, count, lane, j, k;
+	for (vertex = work->first; vertex < work->last; vertex += count)
+	{
+		count = work->last - vertex;
+		count = count < a3geometryTangentBatch_width ? count : a3geometryTangentBatch_width;
+		memset(pad, 0, sizeof(pad));
+		for (lane = 0; lane < a3geometryTangentBatch_width; ++lane)
+		{
+			j = (vertex + lane) * work->stride;
+			v[0][lane] = lane < count ? work->tangent_out + j : pad[0];
+			v[1][lane] = lane < count ? work->bitangent_out + j : pad[1];
+			v[2][lane] = lane < count ? work->normal_out + j : pad[2];
+		}
+		for (k = 0; k < work->partialCount; ++k)
+			for (lane = 0, sum = work->partials + (k * work->vertexCount + vertex) * a3geometryTangentBatch_basis; lane < count; ++lane)
+				for (j = 0; j < a3geometryTangentBatch_basis; ++j)
+					v[j / 3][lane][j % 3] += *(sum++);
+		a3geometryInternalTangentBatchOrtho(v);
+	}
+}
+
+// run pass over ranges split between tasks, on the dispatcher if there 
+//	is more than one
+void a3geometryInternalTangentBatchRun(a3_GeometryTangentBatchWork *work, a3_GeometryTask pass, a3ui32 taskCount, a3ui32 total, const a3_GeometryDispatcher *dispatcher)
+{
+	const a3ui32 share = (total / taskCount + a3geometryTangentBatch_width - 1) & ~(a3ui32)(a3geometryTangentBatch_width - 1);
+	a3ui32 i;
+	for (i = 0; i < taskCount; ++i)
+	{
+		work[i].first = share * i < total ? share * i : total;
+		work[i].last = share * (i + 1) < total && i + 1 < taskCount ? share * (i + 1) : total;
+	}
+	if (taskCount > 1)
+		dispatcher->run(dispatcher->context, pass, work, taskCount);
+	else
+		pass(work, 0);
+}
+
+// smooth tangent basis for indexed triangles: positions and texture 
+//	coordinates are indexed separately per corner, outputs are per position
+//	and may be interleaved (stride in floats); the dispatcher is optional
+a3ret a3geometryInternalCalculateTangentBasisBatch(a3f32 *tangent_out, a3f32 *bitangent_out, a3f32 *normal_out, const a3ui32 stride, const a3f32 *positions, const a3f32 *texcoords, const a3ui32 *positionIndex, const a3ui32 *texcoordIndex, const a3ui32 vertexCount, const a3ui32 faceCount, const a3_GeometryDispatcher *dispatcher)
+{
+	a3_GeometryTangentBatchWork work[a3geometryTangentBatch_taskMax];
+	a3f32 *partials;
+	a3ui32 i, taskCount;
+
+	if (tangent_out && bitangent_out && normal_out && positions && positionIndex && (texcoordIndex || !texcoords) && vertexCount && faceCount)
+	{
+		// fewer tasks for small meshes
+		taskCount = dispatcher && dispatcher->run ? dispatcher->taskCount : 1;
+		taskCount = taskCount < faceCount / a3geometryTangentBatch_faceMin ? taskCount : faceCount / a3geometryTangentBatch_faceMin;
+		taskCount = taskCount < a3geometryTangentBatch_taskMax ? taskCount : a3geometryTangentBatch_taskMax;
+		taskCount = taskCount ? taskCount : 1;
+
+		// one set of vertex sums per extra task
+		partials = 0;
+		if (taskCount > 1)
+		{
+			partials = (a3f32 *)malloc((taskCount - 1) * vertexCount * a3geometryTangentBatch_basis * sizeof(a3f32));
+			if (!partials)
+				return 0;
+		}
+
+		work->tangent_out = tangent_out;
+		work->bitangent_out = bitangent_out;
+		work->normal_out = normal_out;
+		work->stride = stride;
+		work->positions = positions;
+		work->texcoords = texcoords;
+		work->positionIndex = positionIndex;
+		work->texcoordIndex = texcoordIndex;
+		work->partials = partials;
+		work->partial = 0;
+		work->partialCount = taskCount - 1;
+		work->vertexCount = vertexCount;
+		for (i = 1; i < taskCount; ++i)
+		{
+			work[i] = *work;
+			work[i].partial = partials + (i - 1) * vertexCount * a3geometryTangentBatch_basis;
+		}
+
+		// face bases summed per task, then reduced per vertex
+		a3geometryInternalTangentBatchRun(work, a3geometryInternalTangentBatchFaces, taskCount, faceCount, dispatcher);
+		a3geometryInternalTangentBatchRun(work, a3geometryInternalTangentBatchVertices, taskCount, vertexCount, dispatcher);
+
+		free(partials);
+		return vertexCount;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3geometryCalculateTangentBasis(a3_GeometryData *geom, const a3_GeometryDispatcher *dispatcher_opt)
+{
+	const a3_VertexFormatDescriptor *vertexFormat;
+	const void *bitangents = 0;
+	a3ui32 *indices;
+	a3ui32 i, count;
+	a3ret ret;
+
+	if (geom && geom->data)
+	{
+		// float tangent basis of triangles
+		vertexFormat = geom->vertexFormat;
+		if (geom->primType != a3prim_triangles || geom->numVertices < 3 ||
+			!geom->attribData[a3attrib_geomTangent] || !geom->attribData[a3attrib_geomTexcoord] ||
+			vertexFormat->attribType[a3attrib_position] != a3attrib_vec3 ||
+			vertexFormat->attribType[a3attrib_normal] != a3attrib_vec3 ||
+			vertexFormat->attribType[a3attrib_texcoord] != a3attrib_vec2 ||
+			vertexFormat->attribType[a3attrib_tangent] != a3attrib_vec3 ||
+			vertexFormat->attribType[a3attrib_bitangent] != a3attrib_vec3)
+			return 0;
+
+		// without indices, every three vertices form a face
+		count = geom->indexData ? geom->numIndices : geom->numVertices;
+		if (count % 3 || !(indices = (a3ui32 *)malloc(count * sizeof(a3ui32))))
+			return 0;
+		if (!geom->indexData)
+			for (i = 0; i < geom->numVertices; ++i)
+				indices[i] = i;
+		else
+			a3geometryGetIndices(indices, geom);
+
+		// attribute data is owned by the geometry
+		a3geometryGetAddressBitangent(&bitangents, geom);
+		ret = a3geometryInternalCalculateTangentBasisBatch((a3f32 *)geom->attribData[a3attrib_geomTangent], (a3f32 *)bitangents, (a3f32 *)geom->attribData[a3attrib_geomNormal], 3,
+			(const a3f32 *)geom->attribData[a3attrib_geomPosition], (const a3f32 *)geom->attribData[a3attrib_geomTexcoord], indices, indices, geom->numVertices, count / 3, dispatcher_opt);
+		free(indices);
+		return ret;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3ret a3geometryCalculatePositionBounds(a3_VertexBounds *bounds_out, const a3f32 *positions, const a3ui32 count)
+{
+	a3f32 bmin[3], bmax[3], d[3], dd, ddmax = 0.0f;
+	a3ui32 i = 0, j;
+
+	if (bounds_out && positions)
+	{
+		memset(bounds_out, 0, sizeof(a3_VertexBounds));
+		if (!count)
+			return 0;
+
+		bmin[0] = bmax[0] = positions[0];
+		bmin[1] = bmax[1] = positions[1];
+		bmin[2] = bmax[2] = positions[2];
+
+#ifdef A3_GEOMETRY_SSE
+		// four positions (three registers) at a time, shuffled to x, y, z
+		if (count >= 4)
+		{
+			__m128 a, b, c, u, v, x, y, z, x0, y0, z0, x1, y1, z1, rr, r;
+			a3f32 lanes[4];
+
+#define A3_GEOMETRY_SSE_LOAD(p)	a = _mm_loadu_ps(p); b = _mm_loadu_ps(p + 4); c = _mm_loadu_ps(p + 8);	\
+			u = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 3, 2));		\
+			x = _mm_shuffle_ps(a, u, _MM_SHUFFLE(3, 0, 3, 0));		\
+			u = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));		\
+			v = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));		\
+			y = _mm_shuffle_ps(u, v, _MM_SHUFFLE(2, 0, 2, 0));		\
+			u = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));		\
+			v = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));		\
+			z = _mm_shuffle_ps(u, v, _MM_SHUFFLE(2, 0, 2, 0))
+#define A3_GEOMETRY_SSE_REDUCE(out, m, op)	_mm_storeu_ps(lanes, m);	\
+			out = lanes[0] op lanes[1] ? lanes[0] : lanes[1];	\
+			out = out op lanes[2] ? out : lanes[2];				\
+			out = out op lanes[3] ? out : lanes[3]
+
+			// box: lane-wise min and max, reduced at the end
+			x0 = x1 = _mm_set1_ps(bmin[0]);
+			y0 = y1 = _mm_set1_ps(bmin[1]);
+			z0 = z1 = _mm_set1_ps(bmin[2]);
+			for (i = 0; i + 4 <= count; i += 4)
+			{
+				A3_GEOMETRY_SSE_LOAD(positions + i * 3);
+				x0 = _mm_min_ps(x0, x);
+				x1 = _mm_max_ps(x1, x);
+				y0 = _mm_min_ps(y0, y);
+				y1 = _mm_max_ps(y1, y);
+				z0 = _mm_min_ps(z0, z);
+				z1 = _mm_max_ps(z1, z);
+			}
+			A3_GEOMETRY_SSE_REDUCE(bmin[0], x0, <);
+			A3_GEOMETRY_SSE_REDUCE(bmax[0], x1, >);
+			A3_GEOMETRY_SSE_REDUCE(bmin[1], y0, <);
+			A3_GEOMETRY_SSE_REDUCE(bmax[1], y1, >);
+			A3_GEOMETRY_SSE_REDUCE(bmin[2], z0, <);
+			A3_GEOMETRY_SSE_REDUCE(bmax[2], z1, >);
+			for (j = i * 3; i < count; ++i, j += 3)
+			{
+				if (bmin[0] > positions[j + 0]) bmin[0] = positions[j + 0];
+				if (bmax[0] < positions[j + 0]) bmax[0] = positions[j + 0];
+				if (bmin[1] > positions[j + 1]) bmin[1] = positions[j + 1];
+				if (bmax[1] < positions[j + 1]) bmax[1] = positions[j + 1];
+				if (bmin[2] > positions[j + 2]) bmin[2] = positions[j + 2];
+				if (bmax[2] < positions[j + 2]) bmax[2] = positions[j + 2];
+			}
+
+			// sphere: farthest squared distance from box center
+			x0 = _mm_set1_ps((bmin[0] + bmax[0]) * 0.5f);
+			y0 = _mm_set1_ps((bmin[1] + bmax[1]) * 0.5f);
+			z0 = _mm_set1_ps((bmin[2] + bmax[2]) * 0.5f);
+			rr = _mm_setzero_ps();
+			for (i = 0; i + 4 <= count; i += 4)
+			{
+				A3_GEOMETRY_SSE_LOAD(positions + i * 3);
+				x = _mm_sub_ps(x, x0);
+				y = _mm_sub_ps(y, y0);
+				z = _mm_sub_ps(z, z0);
+				r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+				rr = _mm_max_ps(rr, r);
+			}
+			A3_GEOMETRY_SSE_REDUCE(ddmax, rr, >);
+
+#undef A3_GEOMETRY_SSE_LOAD
+#undef A3_GEOMETRY_SSE_REDUCE
+			bounds_out->center[0] = (bmin[0] + bmax[0]) * 0.5f;
+			bounds_out->center[1] = (bmin[1] + bmax[1]) * 0.5f;
+			bounds_out->center[2] = (bmin[2] + bmax[2]) * 0.5f;
+			for (j = i * 3; i < count; ++i, j += 3)
+			{
+				d[0] = positions[j + 0] - bounds_out->center[0];
+				d[1] = positions[j + 1] - bounds_out->center[1];
+				d[2] = positions[j + 2] - bounds_out->center[2];
+				dd = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+				if (ddmax < dd)
+					ddmax = dd;
+			}
+		}
+		else
+#endif	// A3_GEOMETRY_SSE
+		{
+			// box
+			for (i = 1, j = 3; i < count; ++i, j += 3)
+			{
+				if (bmin[0] > positions[j + 0]) bmin[0] = positions[j + 0];
+				if (bmax[0] < positions[j + 0]) bmax[0] = positions[j + 0];
+				if (bmin[1] > positions[j + 1]) bmin[1] = positions[j + 1];
+				if (bmax[1] < positions[j + 1]) bmax[1] = positions[j + 1];
+				if (bmin[2] > positions[j + 2]) bmin[2] = positions[j + 2];
+				if (bmax[2] < positions[j + 2]) bmax[2] = positions[j + 2];
+			}
+
+			// sphere
+			bounds_out->center[0] = (bmin[0] + bmax[0]) * 0.5f;
+			bounds_out->center[1] = (bmin[1] + bmax[1]) * 0.5f;
+			bounds_out->center[2] = (bmin[2] + bmax[2]) * 0.5f;
+			for (i = 0, j = 0; i < count; ++i, j += 3)
+			{
+				d[0] = positions[j + 0] - bounds_out->center[0];
+				d[1] = positions[j + 1] - bounds_out->center[1];
+				d[2] = positions[j + 2] - bounds_out->center[2];
+				dd = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+				if (ddmax < dd)
+					ddmax = dd;
+			}
+		}
+
+		bounds_out->min[0] = bmin[0];
+		bounds_out->min[1] = bmin[1];
+		bounds_out->min[2] = bmin[2];
+		bounds_out->max[0] = bmax[0];
+		bounds_out->max[1] = bmax[1];
+		bounds_out->max[2] = bmax[2];
+		bounds_out->radius = a3sqrtf(ddmax);
+		return 1;
+	}
+	return -1;
+}
+
+a3ret a3geometryCalculateBounds(a3_GeometryData *geom)
+{
+	if (geom && geom->data)
+	{
+		if (!geom->attribData[a3attrib_geomPosition] ||
+			geom->vertexFormat->attribType[a3attrib_position] != a3attrib_vec3)
+			return 0;
+		return a3geometryCalculatePositionBounds(geom->bounds, (const a3f32 *)geom->attribData[a3attrib_geomPosition], geom->numVertices);
+	}
+	return -1;
+}
+
+a3ret a3geometryTransformBounds(a3_VertexBounds *bounds_out, const a3_VertexBounds *bounds, const a3f32 *transform)
+{
+	const a3f32 *m = transform;
+	a3_VertexBounds ret;
+	a3f32 c[3], e[3], s, w, smax = 0.0f;
+	a3ui32 i;
+
+	if (bounds_out && bounds && transform)
+	{
+		// box: transform center, extents grow by absolute matrix
+		for (i = 0; i < 3; ++i)
+		{
+			c[i] = (bounds->min[i] + bounds->max[i]) * 0.5f;
+			e[i] = (bounds->max[i] - bounds->min[i]) * 0.5f;
+		}
+		for (i = 0; i < 3; ++i)
+		{
+			s = m[i + 0] * c[0] + m[i + 4] * c[1] + m[i + 8] * c[2] + m[i + 12];
+			w = (m[i + 0] < 0.0f ? -m[i + 0] : m[i + 0]) * e[0]
+				+ (m[i + 4] < 0.0f ? -m[i + 4] : m[i + 4]) * e[1]
+				+ (m[i + 8] < 0.0f ? -m[i + 8] : m[i + 8]) * e[2];
+			ret.min[i] = s - w;
+			ret.max[i] = s + w;
+			ret.center[i] = m[i + 0] * bounds->center[0] + m[i + 4] * bounds->center[1] + m[i + 8] * bounds->center[2] + m[i + 12];
+		}
+
+		// sphere: radius scales by longest basis vector
+		for (i = 0; i < 12; i += 4)
+		{
+			s = m[i + 0] * m[i + 0] + m[i + 1] * m[i + 1] + m[i + 2] * m[i + 2];
+			if (smax < s)
+				smax = s;
+		}
+		ret.radius = bounds->radius * a3sqrtf(smax);
+
+		*bounds_out = ret;
+		return 1;
+	}
+	return -1;
+}
+
+
 //-----------------------------------------------------------------------------
 // CUT FROM HEADER
 
@@ -28,6 +28,7 @@
 
 #include "animal3D-A3DM/a3math/a3sqrt.h"
 #include "animal3D-A3DM/a3math/a3vector.h"
+#include "animal3D-A3DM/a3math/a3batch.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -55,6 +56,8 @@ inline void a3proceduralInternalCalculateTangentBasisOrtho(a3f32 *tangent_out, a
 
 inline a3ubyte *a3proceduralInternalStoreIndex(a3ubyte *index, const a3ui32 indexSize, const a3ui32 i);
 
+a3ret a3geometryInternalCalculateTangentBasisBatch(a3f32 *tangent_out, a3f32 *bitangent_out, a3f32 *normal_out, const a3ui32 stride, const a3f32 *positions, const a3f32 *texcoords, const a3ui32 *positionIndex, const a3ui32 *texcoordIndex, const a3ui32 vertexCount, const a3ui32 faceCount, const a3_GeometryDispatcher *dispatcher);
+
 
 //-----------------------------------------------------------------------------
 
@@ -827,32 +830,22 @@ a3ret a3modelInternalStore(a3_GeometryData *geom, const a3_ModelLoadDataOBJ *obj
 			// tangent basis
 			if (calcFaceTangents)
 			{
-				// calculate tangent
-				a3proceduralInternalCalculateTangentBasisOrtho(faceTangent, faceBitangent, faceNormal,
-					faceVertexPtr[0]->vertexBasis->position, faceVertexPtr[1]->vertexBasis->position, faceVertexPtr[2]->vertexBasis->position, 
-					faceVertexPtr[0]->texcoord, faceVertexPtr[1]->texcoord, faceVertexPtr[2]->texcoord);
+				// vertex tangents are calculated in batches once all 
+				//	faces are known (below)
+				if (!calcVertTangents)
+				{
+					// calculate tangent
+					a3proceduralInternalCalculateTangentBasisOrtho(faceTangent, faceBitangent, faceNormal,
+						faceVertexPtr[0]->vertexBasis->position, faceVertexPtr[1]->vertexBasis->position, faceVertexPtr[2]->vertexBasis->position, 
+						faceVertexPtr[0]->texcoord, faceVertexPtr[1]->texcoord, faceVertexPtr[2]->texcoord);
 
-				// same principle as normals
-				if (calcVertTangents)
-					for (j = 0; j < 3; ++j)
-					{
-						faceVertexPtr[j]->vertexBasis->tangent[0] += faceTangent[0];
-						faceVertexPtr[j]->vertexBasis->tangent[1] += faceTangent[1];
-						faceVertexPtr[j]->vertexBasis->tangent[2] += faceTangent[2];
-						faceVertexPtr[j]->vertexBasis->bitangent[0] += faceBitangent[0];
-						faceVertexPtr[j]->vertexBasis->bitangent[1] += faceBitangent[1];
-						faceVertexPtr[j]->vertexBasis->bitangent[2] += faceBitangent[2];
-						faceVertexPtr[j]->vertexBasis->normal[0] += faceNormal[0];
-						faceVertexPtr[j]->vertexBasis->normal[1] += faceNormal[1];
-						faceVertexPtr[j]->vertexBasis->normal[2] += faceNormal[2];
-					}
-				else
 					for (j = 0; j < 3; ++j)
 					{
 						memcpy(faceVertexPtr[j]->faceBasis->tangent, faceTangent, normalSize);
 						memcpy(faceVertexPtr[j]->faceBasis->bitangent, faceBitangent, normalSize);
 						memcpy(faceVertexPtr[j]->faceBasis->normal, faceNormal, normalSize);
 					}
+				}
 			}
 			else
 			{
@@ -877,6 +870,27 @@ a3ret a3modelInternalStore(a3_GeometryData *geom, const a3_ModelLoadDataOBJ *obj
 	}
 
 
+	// smooth tangent basis per position: face bases in batches, gathered 
+	//	to positions and orthonormalized, using as many threads as allowed
+	if (calcVertTangents)
+	{
+		a3ui32 *const positionIndex = (a3ui32 *)malloc(numIndices * 2 * sizeof(a3ui32));
+		a3ui32 *const texcoordIndex = positionIndex + numIndices;
+		if (positionIndex)
+		{
+			for (i = 0, rawIndexItr = indexData; i < numIndices; ++i, ++rawIndexItr)
+			{
+				vertexItr = vertexData + *rawIndexItr;
+				positionIndex[i] = vertexItr->vertex.v;
+				texcoordIndex[i] = vertexItr->vertex.vt;
+			}
+			a3geometryInternalCalculateTangentBasisBatch(basisData->tangent, basisData->bitangent, basisData->normal, sizeof(a3_VertexTangentBasisOBJ) / sizeof(a3f32), 
+				obj->positions, useTexcoords ? obj->texcoords : 0, positionIndex, texcoordIndex, obj->numPositions, obj->numFaces, 0);
+			free(positionIndex);
+		}
+	}
+
+
 	//-------------------------------------------------------------------------
 	// enable everything indicated in vertex format
 	if (useTexcoords)
@@ -928,19 +942,19 @@ a3ret a3modelInternalStore(a3_GeometryData *geom, const a3_ModelLoadDataOBJ *obj
 		}
 		if (useNormals || calcFaceNormals)
 		{
-			// do final normal calculation here
+			// copy basis, normalized together after the loop
 			actualNormalPtr = calcVertNormals ? vertexItr->vertexBasis->normal : vertexItr->faceBasis->normal;
-			a3real3GetUnit(normalItr, actualNormalPtr);
+			memcpy(normalItr, actualNormalPtr, normalSize);
 			normalItr += normalComponents;
 
 			if (calcFaceTangents)
 			{
 				actualTangentPtr = calcVertTangents ? vertexItr->vertexBasis->tangent : vertexItr->faceBasis->tangent;
-				a3real3GetUnit(tangentItr, actualTangentPtr);
+				memcpy(tangentItr, actualTangentPtr, normalSize);
 				tangentItr += tangentComponents;
 
 				actualBitangentPtr = calcVertTangents ? vertexItr->vertexBasis->bitangent : vertexItr->faceBasis->bitangent;
-				a3real3GetUnit(bitangentItr, actualBitangentPtr);
+				memcpy(bitangentItr, actualBitangentPtr, normalSize);
 				bitangentItr += tangentComponents;
 			}
 		}
@@ -960,6 +974,15 @@ a3ret a3modelInternalStore(a3_GeometryData *geom, const a3_ModelLoadDataOBJ *obj
 		}
 	}
 
+	// final basis calculation: normalize each array of 3D vectors
+	if (normalComponents)
+		a3real3NormalizeBatch((a3vec3 *)normalStart, numVerticesUnique);
+	if (tangentComponents)
+	{
+		a3real3NormalizeBatch((a3vec3 *)tangentStart, numVerticesUnique);
+		a3real3NormalizeBatch((a3vec3 *)bitangentStart, numVerticesUnique);
+	}
+
 	// store indices
 	for (i = 0, j = geom->indexFormat->indexSize, rawIndexItr = indexData; i < numIndices; ++i, ++rawIndexItr)
 		indexItr = a3proceduralInternalStoreIndex(indexItr, j, *rawIndexItr);
@@ -984,6 +1007,7 @@ a3ret a3modelInternalStore(a3_GeometryData *geom, const a3_ModelLoadDataOBJ *obj
 	geom->numVertices = numVerticesUnique;
 	geom->numIndices = numIndices;
 	geom->primType = a3prim_triangles;
+	a3geometryCalculateBounds(geom);
 
 
 	//-------------------------------------------------------------------------
@@ -27,11 +27,17 @@
 #include "animal3D/a3geometry/a3_ProceduralGeometry.h"
 
 #include "animal3D-A3DM/a3math/a3vector.h"
+#include "animal3D-A3DM/a3math/a3simd.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+// rings of round shapes are written four vertices at a time on x86
+#if (A3_SIMD == A3_SIMD_SSE2 || A3_SIMD == A3_SIMD_SSE41 || A3_SIMD == A3_SIMD_AVX2)
+#define A3_PROCEDURAL_SSE
+#endif	// (A3_SIMD == A3_SIMD_SSE2 || A3_SIMD == A3_SIMD_SSE41 || A3_SIMD == A3_SIMD_AVX2)
+
 #ifndef NDEBUG
 #include <assert.h>
 #else	// NDEBUG
@@ -56,6 +62,7 @@ enum a3_ProceduralGeometryConstInternal
 {
 	tElems = 2,
 	vElems = 3,
+	ringMax = 260,	// most slices plus repeat, rounded up to four
 };
 
 
@@ -269,12 +276,259 @@ a3ret a3proceduralGenerateGeometryData(a3_GeometryData *geomData_out, const a3_P
 			const a3i32 result = a3proceduralInternalGenerateData(geomData_out, geom);
 			if (result && transform_opt)
 				a3proceduralInternalFreezeTransform(geomData_out, transform_opt);
+			if (result > 0)
+				a3geometryCalculateBounds(geomData_out);
 			return result;
 		}
 	return -1;
 }
 
 
+//-----------------------------------------------------------------------------
+// batches and cache
+
+enum a3_ProceduralGeometryBatchLimit
+{
+	a3proceduralBatch_taskMax = 8,				// tasks a batch is split into
+	a3proceduralCache_capacityMin = 16,			// first allocation of entries
+	a3proceduralCache_sizeDefault = 64 << 20,	// bytes kept if no limit set
+};
+
+// shared list and one task's share of it
+typedef struct a3_ProceduralGeometryBatchWork	a3_ProceduralGeometryBatchWork;
+struct a3_ProceduralGeometryBatchWork
+{
+	a3_GeometryData *geomData_out;
+	const a3_ProceduralGeometryDescriptor *geom;
+	const a3ui32 *order;
+	a3ui32 count, first, step, generated;
+};
+
+
+// rough amount of work in a shape: product of its subdivisions
+inline a3ui32 a3proceduralInternalBatchCost(const a3_ProceduralGeometryDescriptor *geom)
+{
+	return ((a3ui32)geom->bParams[0] + 1) * ((a3ui32)geom->bParams[1] + 1) * ((a3ui32)geom->bParams[2] + 1);
+}
+
+// generate every 'step'th shape in order, starting at 'first'
+void a3proceduralInternalBatchGenerate(void *args, a3ui32 index)
+{
+	a3_ProceduralGeometryBatchWork *const work = (a3_ProceduralGeometryBatchWork *)args + index;
+	a3ui32 i, j;
+	for (i = work->first, work->generated = 0; i < work->count; i += work->step)
+	{
+		j = work->order[i];
+		if (a3proceduralGenerateGeometryData(work->geomData_out + j, work->geom + j, 0) > 0)
+			++work->generated;
+	}
+}
+
+// descriptors are equal if shape, flags, axis and all parameters are
+inline a3boolean a3proceduralInternalCacheMatch(const a3_ProceduralGeometryDescriptor *geom0, const a3_ProceduralGeometryDescriptor *geom1)
+{
+	return (geom0->shape == geom1->shape
+		&& !memcmp(geom0->bParams, geom1->bParams, sizeof(geom0->bParams))
+		&& !memcmp(geom0->fParams, geom1->fParams, sizeof(geom0->fParams)));
+}
+
+inline const a3_ProceduralGeometryCacheEntry *a3proceduralInternalCacheFind(const a3_ProceduralGeometryCache *cache, const a3_ProceduralGeometryDescriptor *geom)
+{
+	const a3_ProceduralGeometryCacheEntry *entry = cache->entry, *const end = entry + cache->count;
+	for (; entry < end; ++entry)
+		if (a3proceduralInternalCacheMatch(entry->geom, geom))
+			return entry;
+	return 0;
+}
+
+// store copy of generated shape; oldest shapes are dropped to stay 
+//	within the size limit, and shapes larger than the limit are not stored
+inline a3ret a3proceduralInternalCacheStore(a3_ProceduralGeometryCache *cache, const a3_ProceduralGeometryDescriptor *geom, const a3_GeometryData *geomData)
+{
+	a3_ProceduralGeometryCacheEntry *entry;
+	const a3i32 size = a3geometryGetStringSize(geomData);
+	const a3ui32 sizeMax = cache->sizeMax ? cache->sizeMax : a3proceduralCache_sizeDefault;
+	a3ui32 capacity, dropped;
+	if (size > 0 && (a3ui32)size <= sizeMax)
+	{
+		for (dropped = 0; cache->size > sizeMax - (a3ui32)size; ++dropped)
+		{
+			cache->size -= cache->entry[dropped].size;
+			free(cache->entry[dropped].record);
+		}
+		if (dropped)
+		{
+			cache->count -= dropped;
+			memmove(cache->entry, cache->entry + dropped, cache->count * sizeof(a3_ProceduralGeometryCacheEntry));
+		}
+		if (cache->count == cache->capacity)
+		{
+			capacity = cache->capacity ? cache->capacity * 2 : a3proceduralCache_capacityMin;
+			entry = (a3_ProceduralGeometryCacheEntry *)realloc(cache->entry, capacity * sizeof(a3_ProceduralGeometryCacheEntry));
+			if (!entry)
+				return 0;
+			cache->entry = entry;
+			cache->capacity = capacity;
+		}
+		entry = cache->entry + cache->count;
+		entry->record = (a3byte *)malloc(size);
+		if (entry->record)
+		{
+			a3geometryCopyDataToString(geomData, entry->record);
+			*entry->geom = *geom;
+			entry->size = size;
+			cache->size += size;
+			++cache->count;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+
+a3ret a3proceduralGenerateGeometryDataBatch(a3_GeometryData *geomData_out, const a3_ProceduralGeometryDescriptor *geom, const a3ui32 count, const a3_GeometryDispatcher *dispatcher_opt)
+{
+	a3_ProceduralGeometryBatchWork work[a3proceduralBatch_taskMax];
+	a3ui32 *order;
+	a3ui32 i, j, cost, generated, taskCount;
+
+	if (geomData_out && geom)
+	{
+		order = count ? (a3ui32 *)malloc(count * sizeof(a3ui32)) : 0;
+		if (!order)
+			return 0;
+
+		// largest first, so the last shapes handed out are the cheapest
+		for (i = 0; i < count; ++i)
+		{
+			cost = a3proceduralInternalBatchCost(geom + i);
+			for (j = i; j > 0 && a3proceduralInternalBatchCost(geom + order[j - 1]) < cost; --j)
+				order[j] = order[j - 1];
+			order[j] = i;
+		}
+
+		// shapes dealt out in turn; no task without a shape
+		taskCount = dispatcher_opt && dispatcher_opt->run ? dispatcher_opt->taskCount : 1;
+		taskCount = taskCount < a3proceduralBatch_taskMax ? taskCount : a3proceduralBatch_taskMax;
+		taskCount = taskCount < count ? taskCount : count;
+		taskCount = taskCount ? taskCount : 1;
+		for (i = 0; i < taskCount; ++i)
+		{
+			work[i].geomData_out = geomData_out;
+			work[i].geom = geom;
+			work[i].order = order;
+			work[i].count = count;
+			work[i].first = i;
+			work[i].step = taskCount;
+		}
+		if (taskCount > 1)
+			dispatcher_opt->run(dispatcher_opt->context, a3proceduralInternalBatchGenerate, work, taskCount);
+		else
+			a3proceduralInternalBatchGenerate(work, 0);
+
+		for (i = generated = 0; i < taskCount; ++i)
+			generated += work[i].generated;
+		free(order);
+		return generated;
+	}
+	return -1;
+}
+
+a3ret a3proceduralCacheGenerate(a3_ProceduralGeometryCache *cache, a3_GeometryData *geomData_out, const a3_ProceduralGeometryDescriptor *geom, const a3ui32 count, const a3_GeometryDispatcher *dispatcher_opt)
+{
+	const a3_ProceduralGeometryCacheEntry *entry;
+	a3_ProceduralGeometryDescriptor *missGeom;
+	a3_GeometryData *missData;
+	a3ui32 i, j, missCount, stored;
+
+	if (cache && geomData_out && geom)
+	{
+		// descriptors not found, each once, and space for their data
+		missGeom = count ? (a3_ProceduralGeometryDescriptor *)malloc(count * (sizeof(a3_ProceduralGeometryDescriptor) + sizeof(a3_GeometryData))) : 0;
+		if (!missGeom)
+			return 0;
+		missData = (a3_GeometryData *)(missGeom + count);
+		memset(missData, 0, count * sizeof(a3_GeometryData));
+
+		// copy stored shapes and collect the rest
+		for (i = stored = missCount = 0; i < count; ++i)
+			if (!geomData_out[i].data && geom[i].shape)
+			{
+				entry = a3proceduralInternalCacheFind(cache, geom + i);
+				if (entry)
+				{
+					a3geometryCopyStringToData(geomData_out + i, entry->record);
+					++cache->hits;
+					++stored;
+				}
+				else
+				{
+					for (j = 0; j < missCount && !a3proceduralInternalCacheMatch(missGeom + j, geom + i); ++j);
+					if (j == missCount)
+						missGeom[missCount++] = geom[i];
+				}
+			}
+
+		// generate new shapes together, then store each and copy it out 
+		//	to every output that asked for it before the next is stored 
+		//	(storing may drop older shapes)
+		if (missCount)
+		{
+			a3proceduralGenerateGeometryDataBatch(missData, missGeom, missCount, dispatcher_opt);
+			for (j = 0; j < missCount; ++j)
+				if (missData[j].data)
+				{
+					++cache->misses;
+					entry = a3proceduralInternalCacheStore(cache, missGeom + j, missData + j) > 0 ? cache->entry + cache->count - 1 : 0;
+					for (i = 0; i < count; ++i)
+						if (!geomData_out[i].data && geom[i].shape && a3proceduralInternalCacheMatch(missGeom + j, geom + i))
+						{
+							if (entry)
+							{
+								a3geometryCopyStringToData(geomData_out + i, entry->record);
+								++stored;
+							}
+							else if (missData[j].data)
+							{
+								// could not be stored: hand over the only copy
+								geomData_out[i] = missData[j];
+								memset(missData + j, 0, sizeof(a3_GeometryData));
+								++stored;
+							}
+						}
+					a3geometryReleaseData(missData + j);
+				}
+		}
+
+		free(missGeom);
+		return stored;
+	}
+	return -1;
+}
+
+a3ret a3proceduralCacheRelease(a3_ProceduralGeometryCache *cache)
+{
+	a3ui32 i;
+	if (cache)
+	{
+		if (cache->entry)
+		{
+			for (i = 0; i < cache->count; ++i)
+				free(cache->entry[i].record);
+			free(cache->entry);
+
+			// limit is kept for the next use
+			cache->entry = 0;
+			cache->count = cache->capacity = cache->size = 0;
+			cache->hits = cache->misses = 0;
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+
 //-----------------------------------------------------------------------------
 // internal function prototypes
 
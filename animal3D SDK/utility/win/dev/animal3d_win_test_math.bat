@@ -0,0 +1,75 @@
+:: Math Test (internal, build and run A3DM test once per instruction set)
+:: By Daniel S. Buckstein
+@echo off
+setlocal
+
+:: locate C++ tools of latest Visual Studio
+set "vswhere=C:\Program Files (x86)\Microsoft Visual Studio\Installer\vswhere.exe"
+for /f "usebackq tokens=*" %%i in (`"%vswhere%" -latest -find VC\Auxiliary\Build\vcvarsall.bat`) do (
+	set "vcvarsall=%%i"
+)
+if not defined vcvarsall (
+	echo A3: TEST_MATH: Visual Studio C++ tools not found
+	exit /b 1
+)
+
+set "testsrc=%ANIMAL3D_SDK%source\animal3D-A3DM-Test\animal3D-A3DM-Test.c"
+set "testlib=%ANIMAL3D_SDK%source\animal3D-A3DM\animal3D-A3DM.c"
+set "testinc=%ANIMAL3D_SDK%include"
+set "testdir=%ANIMAL3D_SDK%build\animal3D-A3DM-Test\"
+set "testfail=0"
+
+:: builds for other processors are compiled but not run
+set "testhost=x64"
+if /i "%PROCESSOR_ARCHITECTURE%"=="ARM64" set "testhost=arm64"
+
+:: one build per instruction set (see 'a3simd.h'); AVX2 runs only on
+::	processors that have it
+call :test x64 SCALAR 0
+call :test x64 SSE2 1
+call :test x64 SSE41 2
+call :test x64 AVX2 3 /arch:AVX2
+call :test arm64 NEON 4
+
+if %testfail%==0 (
+	echo A3: TEST_MATH: all builds passed
+) else (
+	echo A3: TEST_MATH: %testfail% builds failed
+)
+endlocal & exit /b %testfail%
+
+
+:: build and run one test
+::	%1: target platform
+::	%2: build name
+::	%3: instruction set (A3_SIMD)
+::	%4: extra compiler options
+:test
+setlocal
+set "outdir=%testdir%%~2\"
+if /i "%~1"=="%testhost%" (
+	set "vcarch=%~1"
+) else (
+	set "vcarch=%testhost%_%~1"
+)
+call "%vcvarsall%" %vcarch% >nul
+if errorlevel 1 (
+	echo A3: TEST_MATH: %~2: no %vcarch% tools, skipped
+	endlocal & exit /b 0
+)
+if not exist "%outdir%" mkdir "%outdir%"
+cl /nologo /O2 /W3 /D_CRT_SECURE_NO_WARNINGS /DA3_SIMD=%~3 %~4 /I"%testinc%" "%testlib%" "%testsrc%" /Fo"%outdir%" /Fe"%outdir%animal3D-A3DM-Test.exe" >"%outdir%build.log"
+if errorlevel 1 (
+	type "%outdir%build.log"
+	echo A3: TEST_MATH: %~2: build failed
+	endlocal & set /a testfail+=1 & exit /b 1
+)
+if /i not "%~1"=="%testhost%" (
+	echo A3: TEST_MATH: %~2: built for %~1, not run
+	endlocal & exit /b 0
+)
+"%outdir%animal3D-A3DM-Test.exe"
+if errorlevel 1 (
+	endlocal & set /a testfail+=1 & exit /b 1
+)
+endlocal & exit /b 0